@@ -63,6 +63,7 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
 
 using namespace std;
@@ -89,6 +90,7 @@ typedef struct configuration {
    bool UseCA;
    vector<GSatID> ExSV;
    GSatID SVonly;
+   int nThreads;       // number of threads running the DC, 0 means one per processor
       // output files
    string LogFile,OutFile;
    ofstream oflog,ofout;
@@ -118,6 +120,7 @@ typedef struct configuration {
 
 DFConfig config;                 // for DiscFix
 GDCconfiguration GDConfig;       // the discontinuity corrector configuration
+GDCbatch *GDCPool;               // threads that run the discontinuity corrector
 
 // data used in program
 
@@ -151,6 +154,7 @@ int ProcessOneSatOneEpoch(GSatID, DayTime, unsigned short&,
    throw(Exception);
 
 void ProcessSatPass(int index) throw(Exception);
+void ProcessSatPasses(const vector<int>& indexes) throw(Exception);
 int AfterReadingFiles(void) throw(Exception);
 void WriteToRINEXfile(void) throw(Exception);
 void WriteRINEXheader(void) throw(Exception);
@@ -184,6 +188,9 @@ int main(int argc, char **argv)
       iret = GetCommandLine(argc, argv);
       if(iret) return iret;
 
+         // start the threads that will run the DC
+      GDCPool = new GDCbatch(config.nThreads);
+
          // configure SatPass
       {
          obstypes.push_back(L1);    // DiscFix requires these 4 observables only
@@ -236,6 +243,7 @@ int main(int argc, char **argv)
       SatToCurrentIndexMap.clear();
       SPList.clear();
       SPIndexList.clear();
+      delete GDCPool;
 
       totaltime = clock()-totaltime;
       config.oflog << PrgmName << " timing: " << fixed << setprecision(3)
@@ -477,14 +485,19 @@ int ProcessOneEntireEpoch(RinexObsData& roe) throw(Exception)
       config.LastEpoch = CurrEpoch;
 
          // check times looking for passes that ought to be processed
+      vector<int> ready;
       for(i=0; i<SPList.size(); i++) {
          if(SPList[i].status() > 1)
             continue;                          // already processed
          if(SPList[i].includesTime(CurrEpoch))
             continue;                          // don't process yet
 
-         ProcessSatPass(i);                    // ok, process this pass
-         if(!orfstr) SPList[i].status() = 99;    // status == 99 means 'written out'
+         ready.push_back(i);                   // ok, process this pass
+      }
+      if(ready.size() > 0) {
+         ProcessSatPasses(ready);
+         for(i=0; i<ready.size(); i++)
+            if(!orfstr) SPList[ready[i]].status() = 99; // status == 99 means 'written out'
       }
 
       // try writing more data to output RINEX file
@@ -574,42 +587,67 @@ int ProcessOneSatOneEpoch(GSatID sat, DayTime tt, unsigned short& flag,
 //------------------------------------------------------------------------------------
 // Process the pass (call DC); if there is an output file, try writing to it.
 void ProcessSatPass(int in) throw(Exception)
+{
+   ProcessSatPasses(vector<int>(1,in));
+}
+
+//------------------------------------------------------------------------------------
+// Process several passes, calling DC on all of them at once; the output is the
+// same as that of calling ProcessSatPass() on each in turn.
+void ProcessSatPasses(const vector<int>& indexes) throw(Exception)
 {
    try {
-      config.oflog << "Proc " << SPList[in]
-         << " at " << CurrEpoch.printf(config.format) << endl;
-      //SPList[in].dump(config.oflog,"RAW");      // temp
-
-      // remove this SatPass from the SatToCurrentIndexMap map
-      SatToCurrentIndexMap.erase(SPList[in].getSat());
-
-      // --------- call DC on this pass -------------------
-      string msg;
-      vector<string> EditCmds;
-      int iret = DiscontinuityCorrector(SPList[in], GDConfig, EditCmds, msg);
-      if(iret != 0) {
-         SPList[in].status() = 100;         // status == 100 means 'failed'
-         config.oflog << "GDC failed for SatPass " << in << " : "
-            << (iret == -1 ? "Polynomial fit to GF data was singular" :
-               (iret == -2 ? "Premature end" :     // never used
-               (iret == -3 ? "Time interval DT not set" :
-               (iret == -4 ? "No data found" :
-               (iret == -5 ? "Required obs types (L1,L2,P1/C1,P2) not found" :
-                             "Unknown"))))) << endl;
-         return;
+      int i,k,in;
+      vector<string> procMsgs;
+      for(k=0; k<indexes.size(); k++) {
+         in = indexes[k];
+         ostringstream oss;
+         oss.copyfmt(config.oflog);
+         oss << "Proc " << SPList[in]
+            << " at " << CurrEpoch.printf(config.format);
+         procMsgs.push_back(oss.str());
+         //SPList[in].dump(config.oflog,"RAW");      // temp
+
+         // remove this SatPass from the SatToCurrentIndexMap map
+         SatToCurrentIndexMap.erase(SPList[in].getSat());
       }
-      SPList[in].status() = 2;              // status == 2 means 'processed'.
 
-      // --------- output editing commands ----------------
-      for(int i=0; i<EditCmds.size(); i++)
-         config.ofout << EditCmds[i] << endl;
+      // --------- call DC on these passes ----------------
+      vector<GDCbatch::Result> results;
+      GDCPool->correct(SPList, indexes, GDConfig, results, false);
+
+      for(k=0; k<indexes.size(); k++) {
+         in = indexes[k];
+         config.oflog << procMsgs[k] << endl;
+         config.oflog << results[k].debugOutput;
+
+         string msg(results[k].retMsg);
+         vector<string>& EditCmds(results[k].EditCmds);
+         int iret = results[k].iret;
+         if(iret != 0) {
+            SPList[in].status() = 100;         // status == 100 means 'failed'
+            config.oflog << "GDC failed for SatPass " << in << " : "
+               << (iret == -1 ? "Polynomial fit to GF data was singular" :
+                  (iret == -2 ? "Premature end" :     // never used
+                  (iret == -3 ? "Time interval DT not set" :
+                  (iret == -4 ? "No data found" :
+                  (iret == -5 ? "Required obs types (L1,L2,P1/C1,P2) not found" :
+                                "Unknown"))))) << endl;
+            continue;
+         }
+         SPList[in].status() = 2;              // status == 2 means 'processed'.
 
-      // --------- smooth pseudorange and debias phase ----
-      if(config.smooth) {
-         SPList[in].smooth(config.smoothPR,config.smoothPH,msg);
-         config.oflog << msg << endl;
-         SPList[in].status() = 3;           // status == 3 means 'smoothed'.
-      }
+         // --------- output editing commands ----------------
+         for(i=0; i<EditCmds.size(); i++)
+            config.ofout << EditCmds[i] << endl;
+
+         // --------- smooth pseudorange and debias phase ----
+         if(config.smooth) {
+            SPList[in].smooth(config.smoothPR,config.smoothPH,msg);
+            config.oflog << msg << endl;
+            SPList[in].status() = 3;           // status == 3 means 'smoothed'.
+         }
+      }  // end loop over passes
 
       // status ==   0 means 'new'
       // status ==   1 means 'still being filled', so status MUST be set to >1 here
@@ -642,12 +680,14 @@ int AfterReadingFiles(void) throw(Exception)
             << config.estdt[0] << " seconds." << endl;
 
       // process all the passes that have not been processed yet
-      for(int i=0; i<SPList.size(); i++) {
-         if(SPList[i].status() <= 1) {
-            ProcessSatPass(i);
+      vector<int> ready;
+      for(int i=0; i<SPList.size(); i++)
+         if(SPList[i].status() <= 1) ready.push_back(i);
+      if(ready.size() > 0) {
+         ProcessSatPasses(ready);
+         for(int i=0; i<ready.size(); i++)
             if(!orfstr)                         // not writing out to RINEX
-               SPList[i].status() = 99;         // status == 99 means 'written out'
-         }
+               SPList[ready[i]].status() = 99;  // status == 99 means 'written out'
       }
 
       // write out all the (processed) data that has not already been written
@@ -829,31 +869,33 @@ void WriteRINEXdata(DayTime& WriteEpoch, const DayTime targetTime) throw(Excepti
 
                	// build the RINEX data object
                	RinexObsData::RinexDatum rd;
+               	int kP1 = SPList[in].getIndex(P1), kP2 = SPList[in].getIndex(P2);
+               	int kL1 = SPList[in].getIndex(L1), kL2 = SPList[in].getIndex(L2);
 
-               	rd.lli = SPList[in].LLI(SPIndexList[in],P1);
-               	rd.ssi = SPList[in].SSI(SPIndexList[in],P1);
-               	rd.data = SPList[in].data(SPIndexList[in],P1);
+               	rd.lli = SPList[in].LLI(n,kP1);
+               	rd.ssi = SPList[in].SSI(n,kP1);
+               	rd.data = SPList[in].data(n,kP1);
                	if(UsingCA)
                   	roe.obs[sat][RinexObsHeader::C1] = rd;
                	else
                   	roe.obs[sat][RinexObsHeader::P1] = rd;
 
-               	rd.lli = SPList[in].LLI(SPIndexList[in],P2);
-               	rd.ssi = SPList[in].SSI(SPIndexList[in],P2);
-               	rd.data = SPList[in].data(SPIndexList[in],P2);
+               	rd.lli = SPList[in].LLI(n,kP2);
+               	rd.ssi = SPList[in].SSI(n,kP2);
+               	rd.data = SPList[in].data(n,kP2);
                	roe.obs[sat][RinexObsHeader::P2] = rd;
 
                	//rd.lli = asInt(asString<char>(str[4]));
                   // TD ought to set the low bit
 						rd.lli = (flag & SatPass::LL1) != 0 ? 1 : 0;
-               	rd.ssi = SPList[in].SSI(SPIndexList[in],L1);
-               	rd.data = SPList[in].data(SPIndexList[in],L1);
+               	rd.ssi = SPList[in].SSI(n,kL1);
+               	rd.data = SPList[in].data(n,kL1);
                	roe.obs[sat][RinexObsHeader::L1] = rd;
 
                	//rd.lli = asInt(asString<char>(str[6]));
 						rd.lli = (flag & SatPass::LL2) != 0 ? 1 : 0;
-               	rd.ssi = SPList[in].SSI(SPIndexList[in],L2);
-               	rd.data = SPList[in].data(SPIndexList[in],L2);
+               	rd.ssi = SPList[in].SSI(n,kL2);
+               	rd.data = SPList[in].data(n,kL2);
                	roe.obs[sat][RinexObsHeader::L2] = rd;
 
                	config.oflog << "Out "
@@ -863,10 +905,10 @@ void WriteRINEXdata(DayTime& WriteEpoch, const DayTime targetTime) throw(Excepti
                	   << " " << flag
                	   << " " << setw(3) << SPList[in].getCount(SPIndexList[in])
                	   << fixed << setprecision(3)
-               	   << " " << setw(13) << SPList[in].data(SPIndexList[in],P1)
-               	   << " " << setw(13) << SPList[in].data(SPIndexList[in],P2)
-               	   << " " << setw(13) << SPList[in].data(SPIndexList[in],L1)
-               	   << " " << setw(13) << SPList[in].data(SPIndexList[in],L2)
+               	   << " " << setw(13) << SPList[in].data(n,kP1)
+               	   << " " << setw(13) << SPList[in].data(n,kP2)
+               	   << " " << setw(13) << SPList[in].data(n,kL1)
+               	   << " " << setw(13) << SPList[in].data(n,kL2)
                	   << endl;
 					}
 
@@ -965,6 +1007,7 @@ int GetCommandLine(int argc, char **argv) throw(Exception)
    for(i=0; i<9; i++) config.ndt[i]=-1;
 
    config.Directory = string(".");
+   config.nThreads = 0;
 
       // -------------------------------------------------
       // required options
@@ -1024,6 +1067,11 @@ int GetCommandLine(int argc, char **argv) throw(Exception)
    
    CommandOption dashXsat(CommandOption::hasArgument, CommandOption::stdType,
       0,"exSat"," --exSat <sat>       Exclude satellite(s) [e.g. --exSat G22]");
+
+   CommandOption dashThreads(CommandOption::hasArgument, CommandOption::stdType,
+      0,"threads"," --threads <n>       Number of threads running the DC, 0 for one "
+      "per processor (" + asString(config.nThreads) + ")");
+   dashThreads.setMaxCount(1);
    
    CommandOptionNoArg dashSmoothPR(0,"smoothPR",
    "# Smoothing: [NB smoothed " "pseudorange and debiased phase are not identical.]\n"
@@ -1270,6 +1318,11 @@ int GetCommandLine(int argc, char **argv) throw(Exception)
       config.SVonly = p;
       if(help) cout << "Process only satellite : " << p << endl;
    }
+   if(dashThreads.getCount()) {
+      values = dashThreads.getValue();
+      config.nThreads = asInt(values[0]);
+      if(help) cout << "Number of DC threads is " << config.nThreads << endl;
+   }
    if(dashFormat.getCount()) {
       values = dashFormat.getValue();
       config.format = values[0];
@@ -1429,6 +1482,8 @@ int GetCommandLine(int argc, char **argv) throw(Exception)
    }
    if(config.SVonly.id > 0)
       config.oflog << " Process only satellite : " << config.SVonly << endl;
+   config.oflog << " Number of DC threads is " << config.nThreads
+      << (config.nThreads == 0 ? " (one per processor)" : "") << endl;
    config.oflog << " Log file is " << config.LogFile << endl;
    config.oflog << " Out file is " << config.OutFile << endl;
    config.oflog << " Output times in this format " << config.format << endl;
@@ -44,6 +44,10 @@
 #include "WGS84Geoid.hpp"
 #include "Position.hpp"
 
+#include "IonexStream.hpp"
+#include "IonexHeader.hpp"
+#include "IonexData.hpp"
+
 #include "VTECMap.hpp"
 #include "RinexUtilities.hpp"
 
@@ -78,6 +82,7 @@ string KnownPos;         // string holding position x,y,z or l,l,h
 bool KnownLLH;           // if true, KnownPos is l,l,h
 bool GridOut;            // if true, write grid to file 'basename.LL'
 bool GnuplotFormat;      // if true, write grid in format for gnuplot
+string IonexFile;        // if not empty, write VTEC maps to this IONEX file
    // excluded satellites
 vector<RinexSatID> ExSV;
    // ephemeris
@@ -93,6 +98,8 @@ WGS84Geoid WGS84;
 DayTime BegTime,EndTime;
    // processing
 double IonoHt,overallBias;
+double MaxDistance;      // km, 0 means use all data at each grid point
+int NumThreads;          // 0 means one per processor
 DayTime EarliestTime;
 VTECMap vtecmap;
 MUFMap mufmap;
@@ -102,6 +109,10 @@ map<string,map<RinexSatID,double> > BiasMap;
    // Data structures for all receivers
 vector<Station> Stations;
 RinexObsStream *instream; // array of streams, parallel to Stations
+   // IONEX output; maps are written as they are computed
+IonexStream ionexstrm;
+IonexHeader ionexhead;
+int NumIonexMaps;
 
 //------------------------------------------------------------------------------------
 // prototypes
@@ -114,6 +125,9 @@ void ProcessObsAndComputeMap(void) throw(Exception);
 void OutputGridToFile(VTECMap& vmap, string filename) throw(Exception);
 void OutputMapToFile(VTECMap& vtmap, string filename, DayTime t, int n)
    throw(Exception);
+int OpenIonexFile(VTECMap& vmap) throw(Exception);
+void OutputMapToIonex(VTECMap& vmap, DayTime t) throw(Exception);
+void CloseIonexFile(void) throw(Exception);
 void AddStation(string& filename) throw(Exception);
 int ProcessHeader(Station& S) throw(Exception);
 int ReadNextObs(Station& S) throw(Exception);
@@ -158,6 +172,10 @@ try {
    if(doVTECmap) {
       vtecmap.MakeGrid(refSite);
       if(GridOut) OutputGridToFile(vtecmap, BaseName+string(".LL"));
+      if(!IonexFile.empty()) {
+         iret = OpenIonexFile(vtecmap);
+         if(iret) goto quit;
+      }
    }
    if(doMUFmap) {
       mufmap.MakeGrid(refSite);
@@ -174,6 +192,7 @@ try {
 
       // process the all the observation data
    ProcessObsAndComputeMap();
+   if(doVTECmap && !IonexFile.empty()) CloseIonexFile();
 
 quit:
       // compute run time
@@ -221,6 +240,9 @@ void ConfigureAndDefaults(void)
    KnownPos = string("");
    GridOut = false;
    GnuplotFormat = false;
+   IonexFile = string("");
+   MaxDistance = 0.0;
+   NumThreads = 0;
 }
 
 //------------------------------------------------------------------------------------
@@ -344,6 +366,16 @@ try {
    CommandOptionNoArg dashLinearFit(
       0, "LinearFit", " --LinearFit          Linear fit type");
 
+   CommandOption dashMaxDist(CommandOption::hasArgument, CommandOption::stdType,
+      0,"MaxDistance", " --MaxDistance <km>   Fit each grid point to data within"
+      " this distance only (all)");
+   dashMaxDist.setMaxCount(1);
+
+   CommandOption dashThreads(CommandOption::hasArgument, CommandOption::stdType,
+      0,"Threads", " --Threads <n>        Number of threads computing the maps"
+      " (1 per processor)");
+   dashThreads.setMaxCount(1);
+
    CommandOption dashIonoHt(CommandOption::hasArgument, CommandOption::stdType,
       0,"IonoHeight", " --IonoHeight <n>     Ionosphere height (km)");
    dashIonoHt.setMaxCount(1);
@@ -361,6 +393,11 @@ try {
    CommandOptionNoArg dashOutGrid(
       0, "OutputGrid", " --OutputGrid         Output the grid to file <basename.LL>");
 
+   CommandOption dashIonex(CommandOption::hasArgument, CommandOption::stdType,
+      0,"IONEX", " --IONEX <file>       Write the VTEC maps to one IONEX file"
+      " (not to <basename>.nnnn)");
+   dashIonex.setMaxCount(1);
+
    CommandOptionNoArg dashGnuOut(
       0, "GnuplotOutput", " --GnuplotOutput      Write the grid file for gnuplot"
       " (default: for Matlab)");
@@ -715,6 +752,22 @@ try {
       GnuplotFormat = true;
       if(help) cout << "Output grid in gnuplot format" << endl;
    }
+   if(dashIonex.getCount()) {
+      values = dashIonex.getValue();
+      IonexFile = values[0];
+      if(help) cout << "Output VTEC maps to IONEX file " << IonexFile << endl;
+   }
+   if(dashMaxDist.getCount()) {
+      values = dashMaxDist.getValue();
+      MaxDistance = asDouble(values[0]);
+      if(help) cout << "Maximum distance of data from grid points (km) is "
+         << MaxDistance << endl;
+   }
+   if(dashThreads.getCount()) {
+      values = dashThreads.getValue();
+      NumThreads = asInt(values[0]);
+      if(help) cout << "Number of threads is " << NumThreads << endl;
+   }
    if(dashFlatFit.getCount()) {
       typefit = VTECMap::Constant;
       if(help) cout << "Set fit type to FLAT" << endl;
@@ -810,9 +863,18 @@ try {
          oflog << "  Do not input sat+rx biases" << endl;
       oflog << "  Decorrelation error rate (TECU/1000km) is " << DecorrelError
          << endl;
+      if(MaxDistance > 0)
+         oflog << "  Maximum distance of data from grid points (km) is "
+            << MaxDistance << endl;
+      else
+         oflog << "  Use all data at each grid point" << endl;
+      oflog << "  Number of threads is " << NumThreads
+         << (NumThreads == 0 ? " (one per processor)" : "") << endl;
       oflog << "  Ionosphere height = " << IonoHt << " km" << endl;
       oflog << "  Add overall bias = " << overallBias << " TECU" << endl;
       oflog << "  Base name for output files is " << BaseName << endl;
+      if(!IonexFile.empty())
+         oflog << "  Output VTEC maps to IONEX file " << IonexFile << endl;
       cout << (GridOut ? "O":"Do NOT o") << "utput grid in file named " <<
          BaseName << ".LL" << endl;
       if(GridOut) cout << "Output grid in " << (GnuplotFormat ? "gnuplot" : "Matlab")
@@ -1013,6 +1075,8 @@ try {
    vtecmap.BeginLon = BeginLon;
    vtecmap.DeltaLon = DeltaLon;
    vtecmap.NumLon = NumLon;
+   vtecmap.MaxDistance = MaxDistance;
+   vtecmap.NumThreads = NumThreads;
    if(doMUFmap) mufmap.CopyInputData(vtecmap);
    if(doF0F2map) f0f2map.CopyInputData(vtecmap);
 
@@ -1137,7 +1201,10 @@ try {
             // compute the map(s)
          if(doVTECmap) {
             vtecmap.ComputeMap(EarliestTime,AllObs,overallBias);
-            OutputMapToFile(vtecmap,BaseName,EarliestTime,nepochs);
+            if(!IonexFile.empty())
+               OutputMapToIonex(vtecmap,EarliestTime);
+            else
+               OutputMapToFile(vtecmap,BaseName,EarliestTime,nepochs);
          }
          if(doMUFmap) {
             mufmap.ComputeMap(EarliestTime,AllObs,overallBias);
@@ -1214,6 +1281,143 @@ catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(
 catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 }
 
+//------------------------------------------------------------------------------------
+// Open the IONEX file and set up its header. The header is written with the
+// first map, and written again, with the number of maps and the last epoch, by
+// CloseIonexFile; its records have fixed length, so it fits in the same place.
+// Return 0 ok, -1 if the grid cannot be written as IONEX or the file cannot be
+// opened.
+int OpenIonexFile(VTECMap& vmap) throw(Exception)
+{
+try {
+   if(vmap.gridtype != VTECMap::UniformLatLon) {
+      cerr << "Error: IONEX output requires a grid uniform in lat and lon\n";
+      oflog << "Error: IONEX output requires a grid uniform in lat and lon\n";
+      return -1;
+   }
+   ionexstrm.open(IonexFile.c_str(),ios::out);
+   if(!ionexstrm) {
+      cerr << "Failed to open IONEX output file " << IonexFile << endl;
+      oflog << "Failed to open IONEX output file " << IonexFile << endl;
+      return -1;
+   }
+   ionexstrm.exceptions(ios::failbit);
+
+   DayTime now;
+   now.setLocalTime();
+   ionexhead.clear();
+   ionexhead.version = 1.0;
+   ionexhead.fileType = string("IONOSPHERE MAPS");
+   ionexhead.system = string("GPS");
+   ionexhead.fileProgram = string("TECMaps");
+   ionexhead.fileAgency = string("");
+   ionexhead.date = now.printf("%04Y/%02m/%02d %02H:%02M");
+   ionexhead.commentList.push_back(Title1.substr(0,60));
+   ionexhead.commentList.push_back(Title2.substr(0,60));
+   ionexhead.interval = 0;
+   ionexhead.numMaps = 0;
+   ionexhead.mappingFunction = string("COSZ");
+   ionexhead.elevation = vmap.MinElevation;
+   ionexhead.observablesUsed = string("TEC from Rinex SR or VR");
+   ionexhead.numStations = Stations.size();
+   ionexhead.numSVs = 0;
+   ionexhead.baseRadius = WGS84.a()/1000.0;
+   ionexhead.mapDims = 2;
+   ionexhead.hgt[0] = ionexhead.hgt[1] = vmap.IonoHeight/1000.0;
+   ionexhead.hgt[2] = 0.0;
+      // grid[k], k = i*NumLat+j, is at latitude j and longitude i
+   ionexhead.lat[0] = vmap.grid[0].LLR[0];
+   ionexhead.lat[1] = vmap.grid[vmap.NumLat-1].LLR[0];
+   ionexhead.lat[2] = vmap.DeltaLat;
+   ionexhead.lon[0] = vmap.grid[0].LLR[1];
+   if(ionexhead.lon[0] > 180.0) ionexhead.lon[0] -= 360.0;
+   ionexhead.lon[1] = ionexhead.lon[0] + (vmap.NumLon-1) * vmap.DeltaLon;
+   ionexhead.lon[2] = vmap.DeltaLon;
+   ionexhead.exponent = -1;
+   ionexhead.auxDataFlag = false;
+   ionexhead.valid = true;
+   NumIonexMaps = 0;
+
+      // IONEX writes the grid with one decimal
+   if(ABS(10*vmap.DeltaLat - int(10*vmap.DeltaLat+0.5)) > 1.e-6 ||
+      ABS(10*vmap.DeltaLon - int(10*vmap.DeltaLon+0.5)) > 1.e-6)
+      oflog << "Warning: IONEX grid spacing is written to 0.1 degree only\n";
+
+   return 0;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// output a VTEC map to the IONEX file
+void OutputMapToIonex(VTECMap& vmap, DayTime t) throw(Exception)
+{
+try {
+   int i,j;
+
+   if(NumIonexMaps == 0) {
+      ionexhead.firstEpoch = ionexhead.lastEpoch = t;
+      ionexstrm << ionexhead;
+   }
+   else if(NumIonexMaps == 1)
+      ionexhead.interval = int(t - ionexhead.firstEpoch + 0.5);
+   ionexhead.lastEpoch = t;
+   NumIonexMaps++;
+
+   IonexData iod;
+   iod.mapID = NumIonexMaps;
+   iod.dim[0] = vmap.NumLat;
+   iod.dim[1] = vmap.NumLon;
+   iod.dim[2] = 1;
+   iod.time = t;
+   iod.type = IonexData::TEC;
+   iod.exponent = ionexhead.exponent;
+   for(i=0; i<3; i++) {
+      iod.lat[i] = ionexhead.lat[i];
+      iod.lon[i] = ionexhead.lon[i];
+      iod.hgt[i] = ionexhead.hgt[i];
+   }
+      // IONEX data run over longitude within latitude
+   iod.data = Vector<double>(vmap.NumLat*vmap.NumLon);
+   for(j=0; j<vmap.NumLat; j++)
+      for(i=0; i<vmap.NumLon; i++)
+         iod.data[j*vmap.NumLon+i] = vmap.grid[i*vmap.NumLat+j].value;
+   iod.valid = true;
+
+   ionexstrm << iod;
+   ionexstrm.flush();
+
+   oflog << "Output map at epoch "
+      << t.printf("%Y/%m/%d %H:%M:%6.3f=%F/%10.3g")
+      << " to IONEX file " << IonexFile << endl;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// rewrite the IONEX header with the final number of maps, and close the file
+void CloseIonexFile(void) throw(Exception)
+{
+try {
+   if(NumIonexMaps > 0) {
+      ionexhead.numMaps = NumIonexMaps;
+      ionexstrm.seekp(0);
+      ionexstrm << ionexhead;
+      ionexstrm.seekp(0,ios::end);
+      ionexstrm << string(60,' ') << leftJustify(IonexData::endOfFile,20) << endl;
+   }
+   ionexstrm.close();
+   oflog << "Wrote " << NumIonexMaps << " maps to IONEX file " << IonexFile << endl;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
 //------------------------------------------------------------------------------------
 void AddStation(string& name) throw(Exception)
 {
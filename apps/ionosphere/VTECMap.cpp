@@ -41,6 +41,43 @@
 using namespace gpstk;
 using namespace std;
 
+//------------------------------------------------------------------------------------
+namespace
+{
+      // Compute the grid values in tiles of TileSize x TileSize grid points.
+   const int TileSize = 8;
+
+   class GridTileTask : public ThreadPoolTask
+   {
+   public:
+      GridTileTask(VTECMap& m, DayTime& t, double b)
+         : vmap(m), epoch(t), bias(b)
+      {
+         ntlat = (vmap.NumLat + TileSize - 1) / TileSize;
+         ntlon = (vmap.NumLon + TileSize - 1) / TileSize;
+      }
+
+      size_t numTiles() const
+      { return size_t(ntlat) * ntlon; }
+
+      void process(size_t t)
+      {
+         int i0 = TileSize * int(t / ntlat), j0 = TileSize * int(t % ntlat);
+         int i1 = min(i0 + TileSize, vmap.NumLon);
+         int j1 = min(j0 + TileSize, vmap.NumLat);
+         for(int i=i0; i<i1; i++)
+            for(int j=j0; j<j1; j++)
+               vmap.ComputeGridNode(i * vmap.NumLat + j, epoch, bias);
+      }
+
+   private:
+      VTECMap& vmap;
+      DayTime& epoch;
+      double bias;
+      int ntlat,ntlon;
+   };
+}
+
 //------------------------------------------------------------------------------------
 const double VTECMap::VTECErrorMultipath = 4.0;
 const double VTECMap::VTECErrorSat = 0.9;
@@ -61,6 +98,8 @@ void VTECMap::CopyInputData(VTECMap &right)
    BeginLon = right.BeginLon;
    DeltaLon = right.DeltaLon;
    NumLon = right.NumLon;
+   MaxDistance = right.MaxDistance;
+   NumThreads = right.NumThreads;
    RefStation = right.RefStation;
 }
 
@@ -76,6 +115,8 @@ void VTECMap::SetDefaults()
    DeltaLat = 0.25;
    DeltaLon = 1.0;
    NumLat = NumLon = 40;
+   MaxDistance = 0.0;
+   NumThreads = 0;
    IonoHeight = 350. * 1000.0;       // 350km in meters
 }
 
@@ -183,7 +224,7 @@ void VTECMap::OutputGrid(ostream& os)
 //------------------------------------------------------------------------------------
 void VTECMap::ComputeMap(DayTime& epoch, vector<ObsData>& data, double bias)
 {
-   int i,j,k,n;
+   int k,n;
       // first compute the average value
    n = 0;
    ave = 0.0;
@@ -192,64 +233,124 @@ void VTECMap::ComputeMap(DayTime& epoch, vector<ObsData>& data, double bias)
       ave *= double(n-1)/double(n);
       ave += data[k].VTEC/double(n);
    }
-      // now compute the value at each grid point
-   for(i=0; i<NumLon; i++) {
-      for(j=0; j<NumLat; j++) {
-         k = i * NumLat + j;
-         ComputeGridValue(grid[k],data,bias);
-      }
+      // save what the grid points need from the data, computing it only once
+   n = data.size();
+   obsLat.resize(n); obsSinLat.resize(n); obsCosLat.resize(n);
+   obsLon.resize(n); obsSinLon.resize(n); obsCosLon.resize(n);
+   obsVTEC.resize(n); obsErr2.resize(n);
+   for(k=0; k<n; k++) {
+      obsLat[k] = data[k].latitude * DEG_TO_RAD;
+      obsSinLat[k] = sin(obsLat[k]);
+      obsCosLat[k] = cos(obsLat[k]);
+      obsLon[k] = data[k].longitude * DEG_TO_RAD;
+      obsSinLon[k] = sin(obsLon[k]);
+      obsCosLon[k] = cos(obsLon[k]);
+      obsVTEC[k] = data[k].VTEC;
+      obsErr2[k] = data[k].VTECerror * data[k].VTECerror;
+   }
+      // index them, with cells about half the search radius
+   if(MaxDistance > 0.0) {
+      double radius = MaxDistance / (1.852 * 60) * DEG_TO_RAD;
+      index.build(obsLat, obsLon, max(radius/2, 0.25*DEG_TO_RAD));
    }
+      // now compute the value at each grid point
+   if(!pool) pool = new ThreadPool(NumThreads);
+   GridTileTask task(*this, epoch, bias);
+   pool->run(task, task.numTiles());
+}
+
+//------------------------------------------------------------------------------------
+void VTECMap::ComputeGridNode(int k, DayTime& epoch, double bias)
+{
+   ComputeGridValue(grid[k], bias);
 }
 
 //------------------------------------------------------------------------------------
-// Compute the grid values. Called by ComputeMap.
-void VTECMap::ComputeGridValue(GridData& gridpt, vector<ObsData>& data, double bias)
+// Compute the grid values. Called by ComputeGridNode.
+void VTECMap::ComputeGridValue(GridData& gridpt, double bias)
 {
    double gridLat = gridpt.LLR.getGeocentricLatitude() * DEG_TO_RAD;
    double gridLon = gridpt.LLR.longitude();
    if(gridLon > 180.0) gridLon -= 360.0;
    gridLon *= DEG_TO_RAD;
 
-   double destLat, destLon,dLat,dLon;
-   double sg,cg,sd,dist,range,bear,d;
-   vector<double> vtec,xtmp,ytmp,sigma;
+   int i,k,n;
+   double dLon,sg,cg,sgl,cgl,cd,sd,dist,range,d,x,y,z,w;
+   double decor = Decorrelation/1000;
+   vector<int> nearby;
+
+   sg = sin(gridLat);
+   cg = cos(gridLat);
+   sgl = sin(gridLon);
+   cgl = cos(gridLon);
+
+      // find the data that may be within MaxDistance
+   if(MaxDistance > 0.0) {
+      index.find(gridLat, gridLon,
+                 MaxDistance / (1.852 * 60) * DEG_TO_RAD, nearby);
+      n = nearby.size();
+   }
+   else n = obsVTEC.size();
 
-      // loop over all data
-   for(int k=0; k<data.size(); k++) {
-      //if(data[k].elevation < MinElevation) continue;   // here?
-      destLat = data[k].latitude * DEG_TO_RAD;
-      destLon = data[k].longitude * DEG_TO_RAD;
+      // chi squared fit: sums of data weighted by 1/sigma^2
+   double s,sx,sy,sz,sxx,sxy,syy,sxz,syz;
+   s = sx = sy = sz = sxx = sxy = syy = sxz = syz = 0.0;
+
+   for(i=0; i<n; i++) {
+      k = (MaxDistance > 0.0 ? nearby[i] : i);
       // compute distance in the plane from grid to dest(data)
-      dLon = destLon - gridLon;
-      sg = sin(gridLat);
-      cg = cos(gridLat);
-      sd = sin(destLat);
-      d = sg*sd + cg*cos(destLat)*cos(dLon);
+      dLon = obsLon[k] - gridLon;
+      cd = obsCosLon[k]*cgl + obsSinLon[k]*sgl;   // cos(dLon)
+      d = sg*obsSinLat[k] + cg*obsCosLat[k]*cd;
+      if(d > 1.0) d = 1.0;                  // roundoff, at the grid point
       dist = acos(d);
       // TD what is range? where does the 1.852 come from?
       // TD what are the units of range? assume km, then Decorrelation = TECU/1000km
       // decor error = range * Decorrelation
       range = 1.852 * 60 * dist * RAD_TO_DEG;   // 1.852 * distance in min of arc
-      if(ABS(dist) < 0.01) dist = 0.01;
-      d = (sd - sg*cos(dist)) / sin(dist)*cg;   // d = cos(bearing)
+      if(MaxDistance > 0.0 && range > MaxDistance) continue;
+      // cos(dist) is d, and sin(dist) is sqrt(1-d^2), unless dist is tiny
+      if(ABS(dist) < 0.01) { cd = cos(0.01); sd = sin(0.01); }
+      else { cd = d; sd = SQRT(1.0 - d*d); }
+      d = (obsSinLat[k] - sg*cd) / sd*cg;   // d = cos(bearing)
       if(ABS(d) > 1) {
          if(d > 0) d = 1.0;
          else d = -1.0;
       }
-      bear = acos(d);
-      if(dLon > 0) bear = TWO_PI - bear;
+      // x = range*cos(bearing), y = range*sin(bearing),
+      // where bearing = acos(d), or 2pi-acos(d) if dLon > 0
+      x = range * d;
+      y = range * SQRT(1.0 - d*d);
+      if(dLon > 0) y = -y;
 
-      vtec.push_back(data[k].VTEC);
-      xtmp.push_back(range * d);       // this is probably slow
-      ytmp.push_back(range * sin(bear));
       // sigma = RSS(measurement error, term ~ range = decorrelation)
-      d = data[k].VTECerror * data[k].VTECerror
-         + range * range * (Decorrelation/1000) * (Decorrelation/1000);
-      sigma.push_back(SQRT(d));
+      w = 1.0 / (obsErr2[k] + range * range * decor * decor);
+      z = (obsVTEC[k] - ave) * w;
+      s += w;
+      sz += z;
+      if(fittype == Linear) {
+         sx += x * w;
+         sy += y * w;
+         sxx += x * x * w;
+         sxy += x * y * w;
+         syy += y * y * w;
+         sxz += x * z;
+         syz += y * z;
+      }
+   }  // end loop over data
 
-   }  // end loop over all data
+      // with no data in range, use the average
+   if(s == 0.0)
+      d = ave;
+   else if(fittype == Linear) {
+      double delta = sxy*(s*sxy-2*sx*sy) + sxx*sy*sy + syy*(sx*sx-s*sxx);
+      d = ave + ( sxz*(sx*syy-sxy*sy) + syz*(sxx*sy-sx*sxy)
+                + sz*(sxy*sxy-sxx*syy) )/delta;
+   }
+   else
+      d = ave + sz/s;
 
-   d = ChiSqPlane(vtec,xtmp,ytmp,sigma) + bias;
+   d += bias;
    if(d < 0) {
       //std::cout << "Negative TEC " << d << std::endl;
       //if(d < -0.5) output warning: negative TEC set to 0
@@ -259,65 +360,6 @@ void VTECMap::ComputeGridValue(GridData& gridpt, vector<ObsData>& data, double b
    gridpt.value = d;
 }
 
-//------------------------------------------------------------------------------------
-// Chi squared calculation ... TD
-// z is VTEC
-double VTECMap::ChiSqPlane(vector<double>& z, vector<double>& x, vector<double>& y,
-   vector<double>& sigma)
-{
-   int k;
-
-   double invSigma,XinvSigma,YinvSigma,ZinvSigma;
-   double s,sx,sy,sz,sxx,sxy,syy,sxz,syz;
-
-   invSigma = 1.0/(sigma[0]*sigma[0]);
-   s = invSigma;
-   ZinvSigma = (z[0]-ave) * invSigma;
-   sz = ZinvSigma;
-   if(fittype == Linear) {
-      XinvSigma = x[0] * invSigma;
-      sx = XinvSigma;
-      YinvSigma = y[0] * invSigma;
-      sy = YinvSigma;
-      sxx = x[0] * XinvSigma;
-      sxy = x[0] * YinvSigma;
-      syy = y[0] * YinvSigma;
-      sxz = x[0] * ZinvSigma;
-      syz = y[0] * ZinvSigma;
-   }
-
-   double invS2,XinvS2,YinvS2,ZinvS2;
-   for(k=1; k<z.size(); k++) {
-      // constant and linear
-      invS2 = 1.0 / (sigma[k]*sigma[k]);
-      s += invS2;
-      ZinvS2 = (z[k]-ave) * invS2;
-      sz += ZinvS2;
-      // linear only
-      if(fittype == Linear) {
-         XinvS2 = x[k] * invS2;
-         YinvS2 = y[k] * invS2;
-         sx += XinvS2;
-         sy += YinvS2;
-         sxx += x[k] * XinvS2;
-         sxy += x[k] * YinvS2;
-         syy += y[k] * YinvS2;
-         sxz += x[k] * ZinvS2;
-         syz += y[k] * ZinvS2;
-      }
-   }
-
-   double value;
-   if(fittype == Linear) {
-      double delta = sxy*(s*sxy-2*sx*sy) + sxx*sy*sy + syy*(sx*sx-s*sxx);
-      value = ( sxz*(sx*syy-sxy*sy) + syz*(sxx*sy-sx*sxy)
-            + sz*(sxy*sxy-sxx*syy) )/delta;
-   }
-   else
-      value = (sz/s);
-   return (ave + value);
-}
-
 //------------------------------------------------------------------------------------
 void VTECMap::OutputMap(ostream& os, bool format)
 {
@@ -335,60 +377,52 @@ void VTECMap::OutputMap(ostream& os, bool format)
 }
 
 //------------------------------------------------------------------------------------
-void MUFMap::ComputeMap(DayTime& epoch, vector<ObsData>& data, double bias)
+void MUFMap::ComputeGridNode(int k, DayTime& epoch, double bias)
 {
-   int i,k;
+   int i;
    double lvect1,lvect2,tmp,cosin;;
    GridData center,reflect;
    Position MUFearth;
 
-   for(k=0; k<NumLat*NumLon; k++) {
-         // Comment in the original code is:
-         // "convert the lat/lon from the MUF grid
-         // to XYZ positions on the surface of Earth"
-         // then code uses grid[k].XYZ where MUFearth is here...
-      MUFearth = grid[k].LLR;
-      MUFearth[2] = MUFearth.radiusEarth();
-      MUFearth.transformTo(Position::Cartesian);
-
-      center.XYZ = (MUFearth + RefStation.xyz)*0.5;
-      center.LLR = center.XYZ;
-      center.LLR.transformTo(Position::Geocentric);
-
-      reflect = center;
-      reflect.LLR[2] = reflect.LLR.radiusEarth() + IonoHeight;
-
-      ComputeGridValue(reflect, data, bias);
-
-      reflect.XYZ = reflect.LLR;
-      reflect.XYZ.transformTo(Position::Cartesian);
-
-      lvect1 = lvect2 = 0.0;
-      for(i=0; i<3; i++) {
-         tmp = MUFearth[i] - reflect.XYZ[i];
-         lvect1 += tmp*tmp;
-         tmp = reflect.XYZ[i] - center.XYZ[i];
-         lvect2 += tmp*tmp;
-      }
-      cosin = SQRT(lvect2/lvect1);
-      grid[k].value =
-         VTECtoF0F2(0,reflect.value,epoch,reflect.LLR.longitude()) / cosin;
+      // Comment in the original code is:
+      // "convert the lat/lon from the MUF grid
+      // to XYZ positions on the surface of Earth"
+      // then code uses grid[k].XYZ where MUFearth is here...
+   MUFearth = grid[k].LLR;
+   MUFearth[2] = MUFearth.radiusEarth();
+   MUFearth.transformTo(Position::Cartesian);
+
+   center.XYZ = (MUFearth + RefStation.xyz)*0.5;
+   center.LLR = center.XYZ;
+   center.LLR.transformTo(Position::Geocentric);
+
+   reflect = center;
+   reflect.LLR[2] = reflect.LLR.radiusEarth() + IonoHeight;
+
+   ComputeGridValue(reflect, bias);
+
+   reflect.XYZ = reflect.LLR;
+   reflect.XYZ.transformTo(Position::Cartesian);
+
+   lvect1 = lvect2 = 0.0;
+   for(i=0; i<3; i++) {
+      tmp = MUFearth[i] - reflect.XYZ[i];
+      lvect1 += tmp*tmp;
+      tmp = reflect.XYZ[i] - center.XYZ[i];
+      lvect2 += tmp*tmp;
    }
+   cosin = SQRT(lvect2/lvect1);
+   grid[k].value =
+      VTECtoF0F2(0,reflect.value,epoch,reflect.LLR.longitude()) / cosin;
 }
 
 //------------------------------------------------------------------------------------
 // First cut at foF2 assuming constant slab thickness of 280 km and 
 // TEC = 1.24e10 (foF2)^2 tau / 10^16
-void F0F2Map::ComputeMap(DayTime& epoch, vector<ObsData>& data, double bias)
+void F0F2Map::ComputeGridNode(int k, DayTime& epoch, double bias)
 {
-   int i,j,k;
-   for(i=0; i<NumLon; i++) {
-      for(j=0; j<NumLat; j++) {
-         k = i * NumLat + j;
-         ComputeGridValue(grid[k],data, bias);
-         grid[k].value = VTECtoF0F2(1,grid[k].value,epoch,grid[k].LLR.longitude());
-      }
-   }
+   ComputeGridValue(grid[k], bias);
+   grid[k].value = VTECtoF0F2(1,grid[k].value,epoch,grid[k].LLR.longitude());
 }
 
 //------------------------------------------------------------------------------------
@@ -396,7 +430,6 @@ double VTECMap::VTECtoF0F2(int method, double vtec, DayTime& epoch, double lon)
 {
 try {
    double fof2,tau,dt;
-   static DayTime computeTime=DayTime::BEGINNING_OF_TIME;
    const double con[4]={0.019600827088077529, -1.549245071973630372,
       29.890989537102175433, 237.467144625490760745};
 
@@ -404,15 +437,12 @@ try {
       tau = 280;
    }
    else if(method == 1) {
-      if(epoch != computeTime) {
-         computeTime = epoch;
-         dt = epoch.hour()+epoch.minute()/60.;
-         dt += (lon - 262.2743352)/15;
-         if(dt > 24) dt -= 24;
-         if(dt <  0) dt += 24;
-         tau = con[0];
-         for(int i=1; i<4; i++) tau = tau * dt + con[i];
-      }
+      dt = epoch.hour()+epoch.minute()/60.;
+      dt += (lon - 262.2743352)/15;
+      if(dt > 24) dt -= 24;
+      if(dt <  0) dt += 24;
+      tau = con[0];
+      for(int i=1; i<4; i++) tau = tau * dt + con[i];
    }
    else {
       throw Exception("VTECtoF0F2 finds unknown method");
@@ -454,6 +484,69 @@ double VTECMap::Obliquity(double el)
    return obq;
 }
 
+//------------------------------------------------------------------------------------
+void PiercePointIndex::build(const vector<double>& lat, const vector<double>& lon,
+   double cellSize)
+{
+   int c,k,n=lat.size();
+   vector<int> pointCell(n);
+
+      // cells tile the sphere exactly, so longitudes wrap around
+   nlat = int(ceil(PI/cellSize));
+   nlon = int(ceil(TWO_PI/cellSize));
+   cellLat = PI/nlat;
+   cellLon = TWO_PI/nlon;
+   cellStart.assign(nlat*nlon+1, 0);
+   cellPoints.resize(n);
+
+      // count the points in each cell, then place them (a counting sort)
+   for(k=0; k<n; k++) {
+      int ilat = int((lat[k] + PI/2) / cellLat);
+      int ilon = int(floor(lon[k] / cellLon)) % nlon;
+      if(ilat < 0) ilat = 0;
+      if(ilat >= nlat) ilat = nlat-1;
+      if(ilon < 0) ilon += nlon;
+      pointCell[k] = c = ilat*nlon + ilon;
+      cellStart[c+1]++;
+   }
+   for(c=0; c<nlat*nlon; c++) cellStart[c+1] += cellStart[c];
+   vector<int> next(cellStart.begin(), cellStart.end()-1);
+   for(k=0; k<n; k++) cellPoints[next[pointCell[k]]++] = k;
+}
+
+//------------------------------------------------------------------------------------
+void PiercePointIndex::find(double lat, double lon, double radius,
+   vector<int>& nearby) const
+{
+   nearby.clear();
+   if(cellPoints.empty()) return;
+
+   int ilat,ilon,ilat0,ilat1,ilon0,ilon1,k;
+   ilat0 = int(floor((lat - radius + PI/2) / cellLat));
+   ilat1 = int(floor((lat + radius + PI/2) / cellLat));
+   if(ilat0 < 0) ilat0 = 0;
+   if(ilat1 >= nlat) ilat1 = nlat-1;
+
+      // longitude half-width of the spherical cap; all of it near a pole
+   ilon0 = 0;
+   ilon1 = nlon-1;
+   if(ABS(lat) + radius < PI/2) {
+      double s = sin(radius)/cos(lat);
+      double dlon = (s < 1.0 ? asin(s) : PI);
+      int i0 = int(floor((lon - dlon) / cellLon));
+      int i1 = int(floor((lon + dlon) / cellLon));
+      if(i1 - i0 < nlon-1) { ilon0 = i0; ilon1 = i1; }
+   }
+
+   for(ilat=ilat0; ilat<=ilat1; ilat++) {
+      for(ilon=ilon0; ilon<=ilon1; ilon++) {
+         int c = ilat*nlon + ((ilon % nlon) + nlon) % nlon;
+         for(k=cellStart[c]; k<cellStart[c+1]; k++)
+            nearby.push_back(cellPoints[k]);
+      }
+   }
+}
+
 //------------------------------------------------------------------------------------
 void gpstk::PlaneCoefficients(double cof[3], double p1[3], double p2[3], double p3[3])
    throw(Exception)
@@ -45,6 +45,7 @@
 #include "icd_200_constants.hpp"     // for TWO_PI
 #include "geometry.hpp"              // for DEG_TO_RAD and RAD_TO_DEG
 #include "MiscMath.hpp"              // for RSS
+#include "ThreadPool.hpp"
 
 #include <iostream>
 #include <string>
@@ -95,10 +96,37 @@ public:
    double value;    ///< computed map value at this grid point (TECU?)
 };
 
+//------------------------------------------------------------------------------------
+/// class PiercePointIndex sorts a set of points on the sphere (the ionospheric
+/// pierce points of one epoch) into cells uniform in latitude and longitude, so
+/// that the points near a given location can be found without looking at all of
+/// them. Angles are in radians.
+class PiercePointIndex {
+public:
+      /// Sort the points into cells of about cellSize (radians) in latitude and
+      /// in longitude. Point k is (lat[k],lon[k]); lon may be in any range.
+   void build(const std::vector<double>& lat, const std::vector<double>& lon,
+              double cellSize);
+
+      /// Find the points that may lie within an angle radius of (lat,lon).
+      /// All such points are returned in nearby, along with some that are a bit
+      /// farther; the caller must check the distances.
+   void find(double lat, double lon, double radius, std::vector<int>& nearby) const;
+
+private:
+   double cellLat,cellLon;       ///< cell size (radians)
+   int nlat,nlon;                ///< number of cells in latitude and longitude
+   std::vector<int> cellStart;   ///< points in cell c are cellPoints[cellStart[c]]
+                                 ///< to cellPoints[cellStart[c+1]-1]; c=ilat*nlon+ilon
+   std::vector<int> cellPoints;  ///< point indexes, sorted by cell
+};
+
 //------------------------------------------------------------------------------------
 /// class VTECMap stores and computes a grid in latitude and longitude, then given
 /// VTEC data over a network of ground stations, computes the value of VTEC on
-/// the grid.
+/// the grid. The grid is computed in tiles of neighboring grid points, shared by
+/// the threads of a ThreadPool. If MaxDistance is set, the data are sorted into a
+/// PiercePointIndex and each grid point uses only the data nearby it.
 class VTECMap {
 public:
       /// Supported grid types
@@ -116,10 +144,10 @@ public:
    };
 
       /// default constructor
-   VTECMap() { grid=NULL; SetDefaults(); }
+   VTECMap() { grid=NULL; pool=NULL; SetDefaults(); }
 
       /// destructor
-   virtual ~VTECMap() { if(grid) delete[] grid; }
+   virtual ~VTECMap() { if(grid) delete[] grid; if(pool) delete pool; }
 
       /// copy input data
    void CopyInputData(VTECMap &right);
@@ -142,6 +170,14 @@ public:
       /// @param bias overall bias to add to vertical TEC data
    virtual void ComputeMap(DayTime& epoch, std::vector<ObsData>& data, double bias);
 
+      /// compute the map value at grid point k, using the data passed to
+      /// ComputeMap. Called by ComputeMap, from several threads at once, so
+      /// it must change nothing but grid[k].
+      /// @param k index in grid array
+      /// @param epoch time of interest
+      /// @param bias overall bias to add to vertical TEC data
+   virtual void ComputeGridNode(int k, DayTime& epoch, double bias);
+
       /// write the computed grid values to a file
       /// @param ostream on which to write
       /// @param bool gnuplotFormat if true, output for gnuplot,
@@ -160,6 +196,10 @@ public:
    double BeginLon;           ///< beginning longitude (deg E)
    double DeltaLon;           ///< step in longitude (deg)
    int NumLon;                ///< number of longitude grids
+   double MaxDistance;        ///< ignore data farther than this from a grid
+                              ///< point (km); 0 means use all the data
+   int NumThreads;            ///< number of threads computing the grid;
+                              ///< 0 means one per processor
    Station RefStation;        ///< reference station, input by MakeGrid()
 
       // grid and map data
@@ -202,13 +242,27 @@ protected:
    void reallyMakeGrid(Station& refStation, int factor)
       throw(Exception);
 
-      /// Compute one grid value, using all the data. Add a bias b to all the data.
-      /// Called by ComputeMap.
-   void ComputeGridValue(GridData& gridpt, std::vector<ObsData>& data, double b);
+      /// Compute one grid value, using the data within MaxDistance (all the data
+      /// if MaxDistance is 0), with a chi squared fit of a constant or a plane.
+      /// Add a bias b to the result. Called by ComputeGridNode.
+   void ComputeGridValue(GridData& gridpt, double b);
 
-      /// Chi squared calculation ... TD
-   double ChiSqPlane(std::vector<double>& vtec, std::vector<double>& x,
-     std::vector<double>& y, std::vector<double>& sigma);
+      /// Data of the current epoch, set by ComputeMap: pierce point latitude and
+      /// longitude (radians) with their sines and cosines, VTEC, and VTEC error
+      /// squared
+   std::vector<double> obsLat,obsSinLat,obsCosLat,obsLon,obsSinLon,obsCosLon;
+   std::vector<double> obsVTEC,obsErr2;
+
+      /// Spatial index of the data of the current epoch (used if MaxDistance > 0)
+   PiercePointIndex index;
+
+      /// Threads that compute the grid, created by the first ComputeMap
+   ThreadPool *pool;
+
+private:
+      /// Copying a map is not supported
+   VTECMap(const VTECMap&);
+   VTECMap& operator=(const VTECMap&);
 
 }; // end class VTECMap
 
@@ -220,21 +274,22 @@ public:
    void MakeGrid(Station& refStation) throw(Exception)
          { reallyMakeGrid(refStation,2); }
 
-      /// populate the 2D grid
+      /// compute the MUF at grid point k, from the VTEC at the reflection point
+      /// between the reference station and the grid point.
+      /// @param k index in grid array
       /// @param epoch time of interest
-      /// @param data vector of ObsData structures for all observed data
       /// @param bias overall bias to add to vertical TEC data
-   void ComputeMap(DayTime& epoch, std::vector<ObsData>& data, double bias);
+   void ComputeGridNode(int k, DayTime& epoch, double bias);
 };
 
 /// class MUFMap is a VTECMap that computes F0F2 on the grid points.
 class F0F2Map : public VTECMap {
 public:
-      /// populate the 2D grid
+      /// compute F0F2 at grid point k, from the VTEC there.
+      /// @param k index in grid array
       /// @param epoch time of interest
-      /// @param data vector of ObsData structures for all observed data
       /// @param bias overall bias to add to vertical TEC data
-   void ComputeMap(DayTime& epoch, std::vector<ObsData>& data, double bias);
+   void ComputeGridNode(int k, DayTime& epoch, double bias);
 };
 
 //------------------------------------------------------------------------------------
@@ -0,0 +1,698 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#include <algorithm>
+
+#include "PhaseCleaner.hpp"
+#include "DDEngine.hpp"
+
+using namespace std;
+using namespace gpstk;
+using namespace PhaseResidual;
+
+unsigned DDEngine::debugLevel;
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+DDEngine::DDEngine(
+   const ElevationRangeList& elr,
+   long al, double at, double gt, double nt)
+   : stats(elr), averages(0), rawOutput(NULL),
+     arcOutput(NULL), minArcLen(al), minArcTime(at), maxGapTime(gt),
+     noiseThreshold(nt), prevValid(false)
+{
+   lamda[ObsID::cbL1] = C_GPS_M/L1_FREQ;
+   lamda[ObsID::cbL2] = C_GPS_M/L2_FREQ;
+}
+
+
+//-----------------------------------------------------------------------------
+// Computes the range and doppler double differences of the epoch, as
+// DDEpochMap::compute() does, and adds its phase data to the open arcs.
+//-----------------------------------------------------------------------------
+void DDEngine::addEpoch(
+   const ObsEpoch& rx1,
+   const ObsEpoch& rx2,
+   const SvDoubleMap& pdm)
+{
+   const DayTime& t = rx1.time;
+   const bool useMasterSV = DDEpochMap::useMasterSV;
+   DDEpoch::debugLevel = debugLevel;
+   PhaseResidual::debugLevel = debugLevel;
+
+   // Any arc that hasn't had data for too long is as long as it will get
+   for (ArcMap::iterator i = arcs.begin(); i != arcs.end(); )
+   {
+      if (t - i->second.last > maxGapTime)
+      {
+         closeArcs(i->first, i->second.al);
+         arcs.erase(i++);
+      }
+      else
+         i++;
+   }
+
+   Epoch e;
+   e.t = t;
+   e.valid = false;
+
+   DDEpoch curr;
+   for (ObsEpoch::const_iterator i=rx1.begin(); i != rx1.end(); i++)
+   {
+      const SatID& prn = i->first;
+      const SvObsEpoch& obs = i->second;
+      for(SvObsEpoch::const_iterator j=obs.begin(); j != obs.end(); j++)
+         if (j->first.type == ObsID::otDoppler && 
+             j->first.band == ObsID::cbL1)
+         {
+            curr.rangeRate[prn] = j->second * C_GPS_M/L1_FREQ;
+            break;
+         }
+      SvDoubleMap::const_iterator j = pdm.find(prn);
+      double elev = j == pdm.end() ? 0 : j->second;
+      curr.elevation[prn] = elev;
+      e.elevation.push_back(make_pair(prn, elev));
+   }
+
+   if (useMasterSV)
+   {
+      // Try to keep using the previous master PRN
+      if (prevValid)
+         curr.masterPrn = prevMasterPrn;
+
+      curr.selectMasterPrn(rx1, rx2);
+   }
+
+   curr.doubleDifference(rx1, rx2);
+
+   if (curr.valid)
+   {
+      e.valid = true;
+      e.masterPrn = curr.masterPrn;
+      prevValid = true;
+      prevMasterPrn = curr.masterPrn;
+
+      DDValue v;
+      if (useMasterSV)
+      {
+         for (SvOIDM::const_iterator i = curr.ddSvOIDM.begin();
+              i != curr.ddSvOIDM.end(); i++)
+         {
+            // The master PRN's own double differences are dropped
+            if (i->first == curr.masterPrn)
+               continue;
+            v.sv2 = i->first;
+            for (OIDM::const_iterator j=i->second.begin(); 
+                 j != i->second.end(); j++)
+            {
+               v.oid = j->first;
+               v.dd = j->second;
+               e.dd.push_back(v);
+            }
+         }
+      }
+      else
+      {
+         for (PrOIDM::const_iterator i = curr.ddPrOIDM.begin();
+              i != curr.ddPrOIDM.end(); i++)
+         {
+            v.sv1 = i->first.first;
+            v.sv2 = i->first.second;
+            for (OIDM::const_iterator j=i->second.begin(); 
+                 j != i->second.end(); j++)
+            {
+               v.oid = j->first;
+               v.dd = j->second;
+               e.dd.push_back(v);
+            }
+         }
+      }
+   }
+   else if (debugLevel)
+      cout << "# Invalid DDEpoch" << endl;
+
+   window.push_back(e);
+
+   if (useMasterSV)
+      addPhase(rx1, rx2, curr.elevation);
+   else
+      addPhaseA(rx1, rx2);
+
+   retire();
+}  // end of DDEngine::addEpoch()
+
+
+//-----------------------------------------------------------------------------
+// Adds the phase data of the epoch to the arcs of each SV, selecting a
+// master SV and computing the double difference as PhaseCleaner does.
+//-----------------------------------------------------------------------------
+void DDEngine::addPhase(
+   const ObsEpoch& rx1,
+   const ObsEpoch& rx2,
+   const SvDoubleMap& pdm)
+{
+   const DayTime& t = rx1.time;
+   double clockOffset = rx1.rxClock - rx2.rxClock;
+
+   // SV line-of-sight motion, in meters/second. Only this epoch is kept
+   // but this is what PhaseCleaner::goodMaster wants.
+   PhaseCleaner::PrnTimeDoubleMap rangeRate;
+
+   // The phases from each receiver, in cycles, of each obs type and SV
+   typedef map<SatID, pair<double, double> > SvPhaseMap;
+   map<ObsID, SvPhaseMap> phases;
+
+   for (ObsEpoch::const_iterator pi1=rx1.begin(); pi1 != rx1.end(); pi1++)
+   {
+      const SatID& prn = pi1->first;
+      const SvObsEpoch& rotm1 = pi1->second;
+
+      // Make sure the other receiver saw this SV
+      const ObsEpoch::const_iterator pi2 = rx2.find(prn);
+      if (pi2 == rx2.end())
+         continue;
+      const SvObsEpoch& rotm2 = pi2->second;
+
+      // We need a doppler, and any one will do
+      SvObsEpoch::const_iterator d;
+      for (d = rotm1.begin(); d != rotm1.end(); d++)
+         if (d->first.type == ObsID::otDoppler)
+            break;
+
+      // No doppler, no phase double difference. sorry
+      if (d == rotm1.end())
+         continue;
+
+      double freq = d->first.band == ObsID::cbL2 ? L2_FREQ : L1_FREQ;
+      rangeRate[prn][t] = d->second * C_GPS_M/freq;
+
+      SvObsEpoch::const_iterator phase1;
+      for (phase1 = rotm1.begin(); phase1 != rotm1.end(); phase1++)
+      {
+         const ObsID& rot = phase1->first;
+         if (rot.type != ObsID::otPhase)
+            continue;
+
+         SvObsEpoch::const_iterator phase2 = rotm2.find(rot);
+         if (phase2 == rotm2.end())
+            continue;
+
+         phases[rot][prn] = make_pair(phase1->second, phase2->second);
+      }
+   }
+
+   map<ObsID, SvPhaseMap>::const_iterator i;
+   for (i = phases.begin(); i != phases.end(); i++)
+   {
+      const ObsID& rot = i->first;
+      const SvPhaseMap& svp = i->second;
+      for (SvPhaseMap::const_iterator j = svp.begin(); j != svp.end(); j++)
+      {
+         const SatID& prn = j->first;
+         ArcKey key(rot, SatIdPair(SatID(), prn));
+         ArcList& pral = getArcs(key, t).al;
+
+         if (noMaster.find(key) == noMaster.end())
+         {
+            Arc& arc = pral.back();
+            bool haveMasterObs = 
+               arc.sv1.id > 0 && svp.find(arc.sv1) != svp.end();
+
+            // See if we need a new master...
+            if (!haveMasterObs || pdm.find(arc.sv1)->second < 10)
+            {
+               PhaseCleaner::goodMaster gm = 
+                  for_each(pdm.begin(), pdm.end(),
+                           PhaseCleaner::goodMaster(15, prn, t, rangeRate));
+
+               if (gm.bestPrn.id < 1)
+               {
+                  if (debugLevel)
+                  {
+                     cout << "Could not find a suitable master for prn "
+                          << prn.id << " " << rot.type
+                          << " at " << t
+                          << endl;
+                     SvDoubleMap::const_iterator e;
+                     for (e = pdm.begin(); e != pdm.end(); e++)
+                        cout << " prn: " << e->first.id
+                             << ", elev:" << e->second
+                             << ", rate:" << rangeRate[e->first][t]
+                             << endl;
+                  }
+                  noMaster.insert(key);
+               }
+               else if (svp.find(gm.bestPrn) == svp.end())
+               {
+                  if (debugLevel)
+                     cout << t << " Selected an invalid master: " 
+                          << gm.bestPrn.id << endl;
+                  noMaster.insert(key);
+               }
+               else
+               {
+                  if (debugLevel>1)
+                     cout << t << " prn " << gm.bestPrn.id << " as master." 
+                          << endl;
+
+                  if (arc.sv1.id < 1)
+                     arc.sv1 = gm.bestPrn;
+                  else
+                  {
+                     pral.push_back(Arc());
+                     pral.back().sv1 = gm.bestPrn;
+                     pral.back().sv2 = arc.sv2;
+                     pral.back().obsID = arc.obsID;
+                  }
+               }
+            }
+         }
+
+         Arc& arc = pral.back();
+         Obs& obs = arc[t];
+         obs.phase11 = j->second.first;
+         obs.phase12 = j->second.second;
+
+         if (arc.sv1.id < 1)
+            continue;
+
+         SvPhaseMap::const_iterator k = svp.find(arc.sv1);
+         if (k == svp.end())
+            continue;
+
+         // Now compute the dd for this epoch
+         double masterDiff = k->second.first - k->second.second;
+         double coc = (clockOffset) * (rangeRate[arc.sv1][t]) / lamda[rot.band];
+         masterDiff -= coc;
+
+         double myDiff = obs.phase11 - obs.phase12;
+         coc = clockOffset * rangeRate[prn][t] / lamda[rot.band];
+         myDiff -= coc;
+
+         obs.dd = masterDiff - myDiff;
+      }
+   }
+}  // end of DDEngine::addPhase()
+
+
+//-----------------------------------------------------------------------------
+// Adds the phase data of the epoch to the arcs of each pair of SVs, as
+// PhaseCleanerA does.
+//-----------------------------------------------------------------------------
+void DDEngine::addPhaseA(
+   const ObsEpoch& oe1,
+   const ObsEpoch& oe2)
+{
+   const DayTime& t = oe1.time;
+   double clockOffset = oe1.rxClock - oe2.rxClock;
+
+   // SV line-of-sight motion, in meters/second
+   map<SatID, double> rangeRate;
+
+   // First we need to get a range rates for all SVs
+   for (ObsEpoch::const_iterator i=oe1.begin(); i != oe1.end(); i++)
+   {
+      const SatID& sv = i->first;
+      const SvObsEpoch& soe = i->second;
+
+      // We need a doppler, and any one will do
+      SvObsEpoch::const_iterator d;
+      for (d = soe.begin(); d != soe.end(); d++)
+         if (d->first.type == ObsID::otDoppler)
+            break;
+
+      if (d == soe.end())
+         continue;
+
+      double freq = d->first.band == ObsID::cbL2 ? L2_FREQ : L1_FREQ;
+      rangeRate[sv] = d->second * C_GPS_M/freq;
+   }
+
+   // Loop over all SVs in track on reciever #1
+   for (ObsEpoch::const_iterator pi11=oe1.begin(); pi11 != oe1.end(); pi11++)
+   {
+      const SatID& sv1 = pi11->first;
+      const SvObsEpoch& soe11 = pi11->second; // SV #1, Rx #1
+
+      // Make sure receiver #2 saw SV #1
+      const ObsEpoch::const_iterator pi12 = oe2.find(sv1);
+      if (pi12 == oe2.end())
+         continue;
+      const SvObsEpoch& soe12 = pi12->second; // SV #1, Rx #2
+
+      // Here we loop over all the 'other' SVs in track on receiver #1
+      for (ObsEpoch::const_iterator pi21=pi11; pi21 != oe1.end(); pi21++)
+      {
+         if (pi21 == pi11)
+            continue;
+
+         const SatID& sv2 = pi21->first;
+         const SvObsEpoch& soe21 = pi21->second; // SV #2, Rx #1
+
+         // Make sure receiver #2 saw SV #2 
+         ObsEpoch::const_iterator pi22 = oe2.find(sv2);
+         if (pi22 == oe2.end())
+            continue;
+         const SvObsEpoch& soe22 = pi22->second;  // SV #2, Rx #2
+
+         SatIdPair svPair(sv1, sv2);
+
+         // Now go throgh all phase observations from SV #1, Rx #1
+         SvObsEpoch::const_iterator phase11;
+         for (phase11 = soe11.begin(); phase11 != soe11.end(); phase11++)
+         {
+            const ObsID& rot = phase11->first;
+            if (rot.type != ObsID::otPhase)
+               continue;
+
+            // Make sure that we have phase data from the other three
+            SvObsEpoch::const_iterator phase12 = soe12.find(rot);
+            if (phase12 == soe12.end())
+               continue;
+
+            SvObsEpoch::const_iterator phase21 = soe21.find(rot);
+            if (phase21 == soe21.end())
+               continue;
+
+            SvObsEpoch::const_iterator phase22 = soe22.find(rot);
+            if (phase22 == soe22.end())
+               continue;
+
+            // And we can't compute our clock correction without the
+            // doppler
+            if (rangeRate[sv1] == 0 || rangeRate[sv2] ==0)
+               continue;
+
+            Arc& arc = getArcs(ArcKey(rot, svPair), t).al.back();
+            Obs& obs = arc[t];
+            arc.sv1 = svPair.first;
+            arc.sv2 = svPair.second;
+            obs.phase11 = phase11->second;
+            obs.phase12 = phase12->second;
+            obs.phase21 = phase21->second;
+            obs.phase22 = phase22->second;
+
+            double lamdaInv;
+            if (rot.band == ObsID::cbL1)
+               lamdaInv = L1_FREQ/C_GPS_M;
+            else if (rot.band == ObsID::cbL2)
+               lamdaInv = L2_FREQ/C_GPS_M;
+            else
+               continue;
+
+            // Now compute the dd for this epoch
+            double sd1 = obs.phase11 - obs.phase12;
+            double coc = clockOffset * rangeRate[sv1] * lamdaInv;
+            sd1 -= coc;
+               
+            double sd2 = obs.phase21 - obs.phase22;
+            coc = clockOffset * rangeRate[sv2] * lamdaInv;
+            sd2 -= coc;
+
+            obs.dd = sd1 - sd2;
+         }
+      }
+   }
+}  // end of DDEngine::addPhaseA()
+
+
+//-----------------------------------------------------------------------------
+// Returns the open arcs for the key, starting them at t if there are none.
+//-----------------------------------------------------------------------------
+DDEngine::OpenArcs& DDEngine::getArcs(const ArcKey& key, const DayTime& t)
+{
+   ArcMap::iterator i = arcs.find(key);
+   if (i == arcs.end())
+   {
+      i = arcs.insert(make_pair(key, OpenArcs())).first;
+      i->second.first = t;
+      i->second.al.front().sv2 = key.second.second;
+      i->second.al.front().obsID = key.first;
+   }
+   i->second.last = t;
+   return i->second;
+}
+
+
+//-----------------------------------------------------------------------------
+// Cleans a set of arcs that has no more data coming, finds its cycle slips
+// and puts its double differences into the epochs in the window.
+//-----------------------------------------------------------------------------
+void DDEngine::closeArcs(const ArcKey& key, ArcList& al)
+{
+   const ObsID& rot = key.first;
+
+   al.computeTD();
+   al.splitOnTD(noiseThreshold);
+   al.debiasDD();
+   al.mergeArcs(minArcLen, minArcTime, maxGapTime, noiseThreshold);
+
+   getSlips(key, al);
+
+   if (arcOutput)
+      al.dump(*arcOutput, DDEpochMap::useMasterSV ? debugLevel : 0);
+
+   // remember that the epochs have their values in meters
+   double lamda = this->lamda[rot.band];
+   if (!DDEpochMap::useMasterSV && lamda == 0)
+      return;
+
+   DDValue v;
+   v.sv1 = key.second.first;
+   v.sv2 = key.second.second;
+   v.oid = rot;
+   for (ArcList::const_iterator k = al.begin(); k != al.end(); k++)
+      for (Arc::const_iterator l = k->begin(); l != k->end(); l++)
+      {
+         v.dd = l->second.dd * lamda;
+         findEpoch(l->first).dd.push_back(v);
+      }
+}  // end of DDEngine::closeArcs()
+
+
+//-----------------------------------------------------------------------------
+// Finds the cycle slips in a set of arcs, as PhaseCleaner::getSlips() does.
+//-----------------------------------------------------------------------------
+void DDEngine::getSlips(const ArcKey& key, const ArcList& al)
+{
+   ArcList::const_iterator k;
+   for (k = al.begin(); k != al.end(); k++)
+   {
+      // Make sure to start on a valid arc
+      if (k->size() < minArcLen || k->len() < minArcTime)
+         continue;
+
+      const Arc& arc0 = *k;
+
+      // Find the next valid arc
+      for (k++; k != al.end(); k++)
+         if (k->len() > minArcTime && k->size() > minArcLen)
+            break;
+
+      if (k == al.end())
+         break;
+
+      const Arc& arc1 = *k;
+      --k;
+
+      // If there is a change in the master SV, this can't be considered
+      // a cycle slip
+      if (arc0.sv1 != arc1.sv1)
+         continue;
+
+      // There shouldn't be a change in the target SV
+      if (arc0.sv2 != arc1.sv2)
+      {
+         cout << "Arc: error, multiple SVs in one arc."
+              << " arc0:" << arc0.sv1.id << "-" << arc0.sv2.id
+              << " arc1:" << arc1.sv1.id << "-" << arc1.sv2.id
+              << endl;
+         continue;
+      }
+
+      const DayTime& t1Begin = arc1.begin()->first;
+      const DayTime& t0End   = arc0.rbegin()->first;
+            
+      if (std::abs(t1Begin-t0End) > maxGapTime)
+         continue;
+
+      // If the two arcs have the same bias then there was no slip, just
+      // some garbage between them
+      if (std::abs(arc1.ddBias - arc0.ddBias) < noiseThreshold)
+         continue;
+
+      const Epoch& e = findEpoch(t1Begin);
+      CycleSlipRecord cs;
+      cs.t = t1Begin;
+      cs.cycles = (arc1.ddBias - arc0.ddBias);
+      cs.oid = key.first;
+      cs.sv1 = arc1.sv1;
+      cs.sv2 = arc1.sv2;
+      cs.el1 = elevation(e, arc1.sv1);
+      cs.el2 = elevation(e, arc1.sv2);
+      cs.postCount = arc1.size();
+      cs.preCount = arc0.size();
+      cs.preGap = t1Begin - t0End;
+      rawSlips.push_back(KeySlip(key, cs));
+   }
+}  // end of DDEngine::getSlips()
+
+
+//-----------------------------------------------------------------------------
+// The elevation of the SV in the epoch, 0 if it is unknown.
+//-----------------------------------------------------------------------------
+double DDEngine::elevation(const Epoch& e, const SatID& sv) const
+{
+   for (size_t i=0; i<e.elevation.size(); i++)
+      if (e.elevation[i].first == sv)
+         return e.elevation[i].second;
+   return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// Finds the epoch in the window with the given time.
+//-----------------------------------------------------------------------------
+DDEngine::Epoch& DDEngine::findEpoch(const DayTime& t)
+{
+   size_t lo=0, hi=window.size();
+   while (lo < hi)
+   {
+      size_t mid = (lo+hi)/2;
+      if (window[mid].t < t)
+         lo = mid+1;
+      else
+         hi = mid;
+   }
+
+   if (lo == window.size() || window[lo].t != t)
+   {
+      Exception e("DDEngine: no epoch at " + t.asString());
+      GPSTK_THROW(e);
+   }
+   return window[lo];
+}
+
+
+//-----------------------------------------------------------------------------
+// Finishes the epochs that no open arc reaches back to.
+//-----------------------------------------------------------------------------
+void DDEngine::retire()
+{
+   DayTime first = DayTime::END_OF_TIME;
+   for (ArcMap::const_iterator i = arcs.begin(); i != arcs.end(); i++)
+      if (i->second.first < first)
+         first = i->second.first;
+
+   while (!window.empty() && window.front().t < first)
+   {
+      finishEpoch(window.front());
+      window.pop_front();
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+// Adds an epoch to the statistics and outputs it. Epochs that would not be
+// in a DDEpochMap, with neither a valid range double difference nor any
+// phase double differences, are skipped.
+//-----------------------------------------------------------------------------
+void DDEngine::finishEpoch(const Epoch& e)
+{
+   if (!e.valid && e.dd.empty())
+      return;
+
+   DDEpoch dde;
+   dde.valid = e.valid;
+   dde.masterPrn = e.masterPrn;
+   if (e.valid)
+      for (size_t i=0; i<e.elevation.size(); i++)
+         dde.elevation[e.elevation[i].first] = e.elevation[i].second;
+
+   for (vector<DDValue>::const_iterator i = e.dd.begin(); i != e.dd.end(); i++)
+      if (DDEpochMap::useMasterSV)
+         dde.ddSvOIDM[i->sv2][i->oid] = i->dd;
+      else
+         dde.ddPrOIDM[SatIdPair(i->sv1, i->sv2)][i->oid] = i->dd;
+
+   stats.add(dde);
+
+   if (averages.windowLength)
+      averages.add(e.t, dde);
+
+   if (rawOutput)
+      dde.dump(*rawOutput, e.t);
+}
+
+
+//-----------------------------------------------------------------------------
+// The order PhaseCleaner finds the cycle slips in, once they are sorted
+// by time
+//-----------------------------------------------------------------------------
+bool DDEngine::slipOrder(const KeySlip& l, const KeySlip& r)
+{
+   if (l.second.t != r.second.t)
+      return l.second.t < r.second.t;
+   return l.first < r.first;
+}
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+void DDEngine::finish()
+{
+   for (ArcMap::iterator i = arcs.begin(); i != arcs.end(); i++)
+      closeArcs(i->first, i->second.al);
+   arcs.clear();
+
+   retire();
+
+   sort(rawSlips.begin(), rawSlips.end(), slipOrder);
+   for (size_t i=0; i<rawSlips.size(); i++)
+      slips.push_back(rawSlips[i].second);
+   rawSlips.clear();
+
+   if (debugLevel)
+   {
+      cout << "Raw detected cycle slips" << endl;
+      slips.sort();
+      slips.dump(cout);
+   }
+
+   slips.purgeDuplicates();
+}  // end of DDEngine::finish()
@@ -0,0 +1,172 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#ifndef DDENGINE_HPP
+#define DDENGINE_HPP
+
+#include <deque>
+#include <set>
+#include <vector>
+
+#include "DDEpoch.hpp"
+#include "PhaseResidual.hpp"
+
+// Computes the same double differences, cycle slips and statistics as
+// DDEpochMap::compute() followed by PhaseCleaner (or PhaseCleanerA, when
+// DDEpochMap::useMasterSV is false), but from one epoch at a time
+// instead of from the whole session.
+//
+// The phase data of each obs type and SV (or pair of SVs) is kept only
+// until a gap of more than maxGapTime seconds shows up, at which point it
+// is cleaned just as PhaseCleaner would and its double differences are
+// put back into the epochs they came from. An epoch is done once no open
+// arc reaches back to it; it is then added to the statistics and, if
+// requested, output. So the memory used depends on the length of the
+// passes, not of the session; only the residuals needed for the medians
+// of the statistics accumulate.
+class DDEngine
+{
+public:
+   DDEngine(const ElevationRangeList& elr,
+            long al, double at, double gt, double nt);
+
+   // Adds one epoch of data that both receivers have. pdm is the
+   // elevation of each SV in rx1, as from elevation_map(). The epochs
+   // must be added in time order.
+   void addEpoch(
+      const gpstk::ObsEpoch& rx1,
+      const gpstk::ObsEpoch& rx2,
+      const SvDoubleMap& pdm);
+
+   // Cleans the arcs still open and finishes all the epochs. After this,
+   // slips and stats are complete.
+   void finish();
+
+   // The cycle slips found, with the duplicates purged
+   CycleSlipList slips;
+
+   // The statistics of the epochs that are done
+   DDStats stats;
+
+   // The means over windows of time of the epochs that are done. They are
+   // only computed when averages.windowLength is set.
+   DDAverages averages;
+
+   // If set, the double differences of each epoch are written here, in
+   // the DDEpochMap::dump() format, as the epoch is done.
+   std::ostream* rawOutput;
+
+   // If set, a summary of each set of arcs is written here as it is
+   // cleaned.
+   std::ostream* arcOutput;
+
+   long minArcLen;
+   double minArcTime, maxGapTime;
+   double noiseThreshold;
+
+   static unsigned debugLevel;
+
+private:
+   // One double difference of an epoch. In master SV mode, sv1 is unused
+   // and sv2 is the SV differenced with the master.
+   struct DDValue
+   {
+      gpstk::SatID sv1, sv2;
+      gpstk::ObsID oid;
+      double dd;
+   };
+
+   // What is kept of each epoch until it is done
+   struct Epoch
+   {
+      gpstk::DayTime t;
+      bool valid;              // the range double difference was valid
+      gpstk::SatID masterPrn;
+      std::vector< std::pair<gpstk::SatID, double> > elevation;
+      std::vector<DDValue> dd;
+   };
+
+   // The phase data of one obs type and SV (or SV pair) since its last gap
+   typedef std::pair<gpstk::ObsID, SatIdPair> ArcKey;
+   struct OpenArcs
+   {
+      PhaseResidual::ArcList al;
+      gpstk::DayTime first, last;
+   };
+   typedef std::map<ArcKey, OpenArcs> ArcMap;
+
+   void addPhase(
+      const gpstk::ObsEpoch& rx1,
+      const gpstk::ObsEpoch& rx2,
+      const SvDoubleMap& pdm);
+
+   void addPhaseA(
+      const gpstk::ObsEpoch& rx1,
+      const gpstk::ObsEpoch& rx2);
+
+   OpenArcs& getArcs(const ArcKey& key, const gpstk::DayTime& t);
+
+   void closeArcs(const ArcKey& key, PhaseResidual::ArcList& al);
+
+   void getSlips(const ArcKey& key, const PhaseResidual::ArcList& al);
+
+   double elevation(const Epoch& e, const gpstk::SatID& sv) const;
+
+   Epoch& findEpoch(const gpstk::DayTime& t);
+
+   void retire();
+
+   void finishEpoch(const Epoch& e);
+
+   std::deque<Epoch> window;
+   ArcMap arcs;
+
+   // The obs type/SVs that PhaseCleaner would have given up finding a
+   // master SV for
+   std::set<ArcKey> noMaster;
+
+   typedef std::pair<ArcKey, CycleSlipRecord> KeySlip;
+   static bool slipOrder(const KeySlip& l, const KeySlip& r);
+   std::vector<KeySlip> rawSlips;
+
+   std::map<gpstk::ObsID::CarrierBand, double> lamda;
+   bool prevValid;
+   gpstk::SatID prevMasterPrn;
+};
+
+#endif
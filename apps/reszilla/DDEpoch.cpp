@@ -36,6 +36,7 @@
 //
 //=============================================================================
 
+#include <algorithm>
 #include <limits>
 #include <set>
 #include <list>
@@ -370,128 +371,199 @@ void DDEpochMap::compute(
 
 // ---------------------------------------------------------------------------
 // ---------------------------------------------------------------------------
-void DDEpochMap::dump(std::ostream& s) const
+void DDEpoch::dumpHeader(std::ostream& s)
 {
-   const DDEpochMap& ddem=*this;
-
-   s.setf(ios::fixed, ios::floatfield);
    s << "# time               obs type       SV1 SV2   EL1     EL2"
      << "           ddr(m)  h1h2"
      << endl;
+}
 
-   DDEpochMap::const_iterator ei;
-   for (ei = ddem.begin(); ei != ddem.end(); ei++)
-   {
-      const DayTime& t = ei->first;
-      const DDEpoch& dde = ei->second;
 
-      string time=t.printf("%4Y %3j %02H:%02M:%04.1f");
+// ---------------------------------------------------------------------------
+// ---------------------------------------------------------------------------
+void DDEpoch::dump(std::ostream& s, const DayTime& t) const
+{
+   const DDEpoch& dde=*this;
+   const unsigned debugLevel = DDEpochMap::debugLevel;
+
+   string time=t.printf("%4Y %3j %02H:%02M:%04.1f");
+
+   // The stats and averages may follow on the same stream, so leave its
+   // format as it was found
+   ios::fmtflags oldFlags = s.flags();
+   streamsize oldPrecision = s.precision();
+   s.setf(ios::fixed, ios::floatfield);
       
-      if (useMasterSV)
-      {
-         const SatID& masterPrn = dde.masterPrn;
+   if (DDEpochMap::useMasterSV)
+   {
+      const SatID& masterPrn = dde.masterPrn;
          
-         SvOIDM::const_iterator pi;
-         for (pi = dde.ddSvOIDM.begin(); pi != dde.ddSvOIDM.end(); pi++)
-         {
-            const SatID& prn = pi->first;
-            const OIDM& ddr = pi->second;
-            for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
-            {
-               string rot = StringUtils::asString(ti->first);
-               double dd = ti->second;
-               
-               // don't output single differnce b/w master and itself.
-               // this is excluded from the stats computation as well
-               if (masterPrn.id != prn.id)
-               {
-                  s << left << setw(20) << time << right
-                    << setfill(' ') << setprecision(2)
-                    << " " << left << setw(14) << rot << right
-                    << " " << setw(3) << masterPrn.id
-                    << " " << setw(3) << prn.id
-                    << "   " << setw(5) << dde.elevation[masterPrn] << "  "
-                    << " " << setw(5) << dde.elevation[prn]
-                    << " " << setprecision(6) << setw(14) << dd
-                    << hex
-                    << " " << setw(2) << dde.health[masterPrn] 
-                    << dde.health[prn]
-                    << dec 
-                    << endl;
-               }
-               
-               if (debugLevel && (dde.health[masterPrn] || dde.health[prn]))
-                    cout << "# Unhealthy SV. Master/SV2: " << hex << setw(2) 
-                         << dde.health[masterPrn] << dde.health[prn] << dec 
-                         << endl;    
-            }
-         }
-      }
-      else
+      SvOIDM::const_iterator pi;
+      for (pi = dde.ddSvOIDM.begin(); pi != dde.ddSvOIDM.end(); pi++)
       {
-         PrOIDM::const_iterator pi;
-         for (pi = dde.ddPrOIDM.begin(); pi != dde.ddPrOIDM.end(); pi++)
+         const SatID& prn = pi->first;
+         const OIDM& ddr = pi->second;
+         for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
          {
-            const SatIdPair& pr = pi->first;
-            const SatID& sv1 = pr.first;
-            const SatID& sv2 = pr.second;
-            const OIDM& ddr = pi->second;
-            for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
-            {
-               string rot = StringUtils::asString(ti->first);
-               double dd = ti->second;
+            string rot = StringUtils::asString(ti->first);
+            double dd = ti->second;
                
+            // don't output single differnce b/w master and itself.
+            // this is excluded from the stats computation as well
+            if (masterPrn.id != prn.id)
+            {
                s << left << setw(20) << time << right
                  << setfill(' ') << setprecision(2)
                  << " " << left << setw(14) << rot << right
-                 << " " << setw(3) << sv1.id 
-                 << " " << setw(3) << sv2.id
-                 << "   " << setw(5) << dde.elevation[sv1] << "  "
-                 << " " << setw(5) << dde.elevation[sv2]
+                 << " " << setw(3) << masterPrn.id
+                 << " " << setw(3) << prn.id
+                 << "   " << setw(5) << dde.elevation[masterPrn] << "  "
+                 << " " << setw(5) << dde.elevation[prn]
                  << " " << setprecision(6) << setw(14) << dd
                  << hex
-                 << " " << setw(2) << dde.health[sv1] << dde.health[sv2]
-                 << dec
+                 << " " << setw(2) << dde.health[masterPrn] 
+                 << dde.health[prn]
+                 << dec 
                  << endl;
             }
+               
+            if (debugLevel && (dde.health[masterPrn] || dde.health[prn]))
+               cout << "# Unhealthy SV. Master/SV2: " << hex << setw(2) 
+                    << dde.health[masterPrn] << dde.health[prn] << dec 
+                    << endl;    
          }
       }
    }
+   else
+   {
+      PrOIDM::const_iterator pi;
+      for (pi = dde.ddPrOIDM.begin(); pi != dde.ddPrOIDM.end(); pi++)
+      {
+         const SatIdPair& pr = pi->first;
+         const SatID& sv1 = pr.first;
+         const SatID& sv2 = pr.second;
+         const OIDM& ddr = pi->second;
+         for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
+         {
+            string rot = StringUtils::asString(ti->first);
+            double dd = ti->second;
+               
+            s << left << setw(20) << time << right
+              << setfill(' ') << setprecision(2)
+              << " " << left << setw(14) << rot << right
+              << " " << setw(3) << sv1.id 
+              << " " << setw(3) << sv2.id
+              << "   " << setw(5) << dde.elevation[sv1] << "  "
+              << " " << setw(5) << dde.elevation[sv2]
+              << " " << setprecision(6) << setw(14) << dd
+              << hex
+              << " " << setw(2) << dde.health[sv1] << dde.health[sv2]
+              << dec
+              << endl;
+         }
+      }
+   }
+
+   s.flags(oldFlags);
+   s.precision(oldPrecision);
+}  // end of DDEpoch::dump()
+
+
+// ---------------------------------------------------------------------------
+// ---------------------------------------------------------------------------
+void DDEpochMap::dump(std::ostream& s) const
+{
+   DDEpoch::dumpHeader(s);
+
+   for (const_iterator ei = begin(); ei != end(); ei++)
+      ei->second.dump(s, ei->first);
 }  // end of DDEpochMap::dump()
 
 
 //----------------------------------------------------------------------------
-// Returns a string containing a statistical summary of the double difference
-// residuals for the specified obs type within the given elevation range.
 //----------------------------------------------------------------------------
-string DDEpochMap::computeStats(
-   const ObsID oid,
-   const ElevationRange& er,
+void DDEpochMap::outputStats(
+   ostream& s, 
+   const ElevationRangeList& elr,
    const CycleSlipList& csl,
    const double strip) const
 {
-   float minElevation = er.first;
-   float maxElevation = er.second;
+   if (debugLevel)
+      cout << "# Computing stats" << endl;
 
-   int slips=0;
-   for (CycleSlipList::const_iterator i=csl.begin(); i != csl.end(); i++)
-      if (i->oid == oid && i->el2 >= minElevation && i->el2 <= maxElevation)
-         slips++;
+   DDStats stats(elr);
+   for (const_iterator ei = begin(); ei != end(); ei++)
+      stats.add(ei->second);
+
+   stats.output(s, csl);
+}  // end of DDEpochMap::outputStats()
 
-   // Pull all double difference data in the elevation bin into a list
-   list<double> dd;
-   int zeroCount=0;
-   unsigned long svEpochCount=0;
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+void DDEpochMap::outputAverages(ostream& s) const
+{
+   if (debugLevel)
+      cout << "# Computing averages\n";
+      
+   DDAverages averages(windowLength);
    for (const_iterator ei = begin(); ei != end(); ei++)
+      averages.add(ei->first, ei->second);
+
+   averages.output(s);
+}  // end of DDEpochMap::outputAverages()
+
+
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+DDStats::DDStats(const ElevationRangeList& elr)
+   : bins(elr.begin(), elr.end()), svEpochCount(elr.size(), 0)
+{}
+
+
+//----------------------------------------------------------------------------
+// Pull the double differences of one epoch into the elevation bins they
+// fall into.
+//----------------------------------------------------------------------------
+void DDStats::add(const DDEpoch& dde)
+{
+   const bool useMasterSV = DDEpochMap::useMasterSV;
+
+   // First note what obs types there are
+   if (useMasterSV)
+   {
+      for (SvOIDM::const_iterator pi = dde.ddSvOIDM.begin(); 
+           pi != dde.ddSvOIDM.end(); pi++)
+      {
+         const OIDM& ddr = pi->second;
+         for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
+            if (dd.find(ti->first) == dd.end())
+               dd[ti->first].resize(bins.size());
+      }
+   }
+   else
+   {
+      for (PrOIDM::const_iterator pi = dde.ddPrOIDM.begin(); 
+           pi != dde.ddPrOIDM.end(); pi++)
+      {
+         const OIDM& ddr = pi->second;
+         for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
+            if (dd.find(ti->first) == dd.end())
+               dd[ti->first].resize(bins.size());
+      }
+   }
+
+   for (unsigned bin=0; bin < bins.size(); bin++)
    {
-      const DDEpoch& dde = ei->second;
+      float minElevation = bins[bin].first;
+      float maxElevation = bins[bin].second;
 
       // Determine how many SVs were present in this elevation range
       for (int prn=1; prn <= MAX_PRN; prn++)
       {
          float elev = dde.elevation[SatID(prn,SatID::systemGPS)];
          if (elev>minElevation && elev<maxElevation)
-            svEpochCount++;
+            svEpochCount[bin]++;
       }
 
       if (useMasterSV)
@@ -506,58 +578,65 @@ string DDEpochMap::computeStats(
                 dde.elevation[prn]>maxElevation)
                continue;
 
-            OIDM::const_iterator ddi = ddr.find(oid);
-            if (ddi == ddr.end())
-               zeroCount++;
-            else
-               dd.push_back(ddi->second);
+            for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
+               dd[ti->first][bin].push_back(ti->second);
          }
       }
       else
       {
          PrOIDM::const_iterator pi;
-         SvDoubleMap& elevation = ei->second.elevation;
-         for (pi = ei->second.ddPrOIDM.begin(); 
-              pi != ei->second.ddPrOIDM.end(); pi++)
+         for (pi = dde.ddPrOIDM.begin(); pi != dde.ddPrOIDM.end(); pi++)
          {
             const SatIdPair& pr = pi->first;
             const gpstk::SatID& sv1 = pr.first;
             const gpstk::SatID& sv2 = pr.second;
             const OIDM& ddr = pi->second;
             
-            // Make sure the SVs are in this elevation bin. If we are using
-            // a single master SV, then only the first SV needs to be in this
-            // range since the master SV selection algorigthm tries to only use
-            // SVs that should be 'good'.
-            if (elevation[sv1]<minElevation || elevation[sv1]>maxElevation ||
-                (!useMasterSV && 
-                 (elevation[sv2]<minElevation || elevation[sv2]>maxElevation)))
+            // Make sure both SVs are in this elevation bin.
+            if (dde.elevation[sv1]<minElevation || 
+                dde.elevation[sv1]>maxElevation ||
+                dde.elevation[sv2]<minElevation || 
+                dde.elevation[sv2]>maxElevation)
                continue;
 
-            OIDM::const_iterator ddi = ddr.find(oid);
-            if (ddi == ddr.end())
-               zeroCount++;
-            else
-               dd.push_back(ddi->second);
+            for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
+               dd[ti->first][bin].push_back(ti->second);
          }
       }
    }
+}  // end of DDStats::add()
+
 
-   if (dd.size()<5)
+//----------------------------------------------------------------------------
+// Returns a string containing a statistical summary of the double difference
+// residuals for the specified obs type within the given elevation range.
+//----------------------------------------------------------------------------
+string DDStats::computeStats(
+   const ObsID& oid,
+   unsigned bin,
+   const CycleSlipList& csl) const
+{
+   float minElevation = bins[bin].first;
+   float maxElevation = bins[bin].second;
+
+   int slips=0;
+   for (CycleSlipList::const_iterator i=csl.begin(); i != csl.end(); i++)
+      if (i->oid == oid && i->el2 >= minElevation && i->el2 <= maxElevation)
+         slips++;
+
+   OIDDM::const_iterator oi = dd.find(oid);
+   if (oi == dd.end() || oi->second[bin].size()<5)
       return "";
 
-   dd.sort();
+   vector<double> ddv(oi->second[bin]);
+   sort(ddv.begin(), ddv.end());
    PowerSum f;
-   f.add(dd.begin(), dd.end());
+   for (vector<double>::const_iterator i = ddv.begin(); i != ddv.end(); i++)
+      f.add(*i);
 
    double kurt = f.kurtosis();
-   //double sdev = sqrt(f.variance());
-   //double avg = f.average();
-   //long n = f.size();
 
    double median;
-   vector<double> ddv(dd.size());
-   copy(dd.begin(),dd.end(),ddv.begin());
    double mad = Robust::MedianAbsoluteDeviation(&ddv[0], ddv.size(), median);
 
    ostringstream oss;
@@ -570,7 +649,7 @@ string DDEpochMap::computeStats(
        << "   " << setprecision(3) << setw(10) << median
        << fixed
        << "  " << setw(8) << f.size()
-       << "  " << setw(8) << svEpochCount
+       << "  " << setw(8) << svEpochCount[bin]
        << "  ";
    if (kurt<100)
       oss << setprecision(2) << setw(6) << kurt;
@@ -580,60 +659,24 @@ string DDEpochMap::computeStats(
 
    return oss.str();
 
-}  // end of DDEpochMap::computeStats()
+}  // end of DDStats::computeStats()
 
 
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
-void DDEpochMap::outputStats(
-   ostream& s, 
-   const ElevationRangeList& elr,
-   const CycleSlipList& csl,
-   const double strip) const
+void DDStats::output(ostream& s, const CycleSlipList& csl) const
 {
-   // First figure out what obs types we have to work with
-   if (debugLevel)
-      cout << "# Computing obsSet" << endl;
-
-   set<ObsID> obsSet;
-   for (const_iterator ei = begin(); ei != end(); ei++)
-   {
-      const DDEpoch& dde = ei->second;
-      if (useMasterSV)
-      {
-         for (SvOIDM::const_iterator pi = dde.ddSvOIDM.begin(); 
-              pi != dde.ddSvOIDM.end(); pi++)
-         {
-            const OIDM& ddr = pi->second;
-            for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
-               obsSet.insert(ti->first);
-         }
-      }
-      else
-      {
-         for (PrOIDM::const_iterator pi = dde.ddPrOIDM.begin(); 
-              pi != dde.ddPrOIDM.end(); pi++)
-         {
-            const OIDM& ddr = pi->second;
-            for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
-               obsSet.insert(ti->first);
-         }
-      }
-   }
-
    s << endl
      << ">s  ObsID           elev      noise(mad)    median      # DDE     # SVE    kurt   jumps" << endl
      << ">s -------------    -----     ----------  ----------   -------   -------  ------  -----"
      << endl;
 
    // For convience, group these into L1
-   for (ElevationRangeList::const_iterator i = elr.begin(); 
-        i != elr.end(); i++)
+   for (unsigned bin=0; bin < bins.size(); bin++)
    {
-      for (set<ObsID>::const_iterator j = obsSet.begin(); 
-           j != obsSet.end(); j++)
-         if (j->band == ObsID::cbL1)
-            s << computeStats(*j, *i, csl, strip);
+      for (OIDDM::const_iterator j = dd.begin(); j != dd.end(); j++)
+         if (j->first.band == ObsID::cbL1)
+            s << computeStats(j->first, bin, csl);
       s << endl;
    }
    
@@ -641,146 +684,132 @@ void DDEpochMap::outputStats(
      << endl;
 
    // and L2
-   for (ElevationRangeList::const_iterator i = elr.begin(); 
-        i != elr.end(); i++)
+   for (unsigned bin=0; bin < bins.size(); bin++)
    {
-      for (set<ObsID>::const_iterator j = obsSet.begin(); 
-           j != obsSet.end(); j++)
-         if (j->band == ObsID::cbL2)
-            s << computeStats(*j, *i, csl, strip);
+      for (OIDDM::const_iterator j = dd.begin(); j != dd.end(); j++)
+         if (j->first.band == ObsID::cbL2)
+            s << computeStats(j->first, bin, csl);
       s << endl;
    }
    
    s << ">s --------------------------------------------------------------------------"
      << endl << endl;
      
-}  // end of DDEpochMap::outputStats()
+}  // end of DDStats::output()
 
 
-void DDEpochMap::outputAverages(ostream& s) const
+//----------------------------------------------------------------------------
+//----------------------------------------------------------------------------
+DDAverages::DDAverages(unsigned long len)
+   : windowLength(len), started(false)
+{}
+
+
+void DDAverages::add(const DayTime& t, const DDEpoch& dde)
 {
-   if (debugLevel)
-      cout << "# Computing averages\n";
-      
-   s << "# window end time        obs type    # points    mean ddr(m)\n";
-      
-   // only going to compute averages for range, phase, and doppler
-   gpstk::Stats<double> l1CArange,l1Prange,l1Phase,l1Doppler;
-   gpstk::Stats<double> l2Prange,l2Phase,l2Doppler;
+   if (!started)
+   {
+      windowEndDT = t + windowLength;
+      started = true;
+   }
 
-   gpstk::DayTime windowTempDT;
-   
-   const_iterator ei = begin();
-   const gpstk::DayTime& dataStartDT = ei->first;
-   gpstk::DayTime windowEndDT = dataStartDT + windowLength;
-   
-   for (const_iterator ei = begin(); ei != end(); ei++)
+   if (t >= windowEndDT)
    {
-      const gpstk::DayTime& t = ei->first;
-      const DDEpoch& dde = ei->second;
+      // reset window end time, and start recording data for this new
+      // window
+      windowEndDT = t + windowLength;
+      curr.t = t;
+      windows.push_back(curr);
+      curr = Window();
+      return;
+   }
 
-      // the time for this DDEpoch
-      windowTempDT = t;
-      
-      if (windowTempDT < windowEndDT)
+   // record data for this epoch
+   SvOIDM::const_iterator pi;
+   for (pi = dde.ddSvOIDM.begin(); pi != dde.ddSvOIDM.end(); pi++)
+   {
+      const OIDM& ddr = pi->second;
+      for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
       {
-         // record data for this epoch
-         SvOIDM::const_iterator pi;
-         for (pi = dde.ddSvOIDM.begin(); pi != dde.ddSvOIDM.end(); pi++)
-         {
-            const OIDM& ddr = pi->second;
-            for (OIDM::const_iterator ti = ddr.begin(); ti != ddr.end(); ti++)
-            {
-               gpstk::ObsID obsID = ti->first;
-               double dd          = ti->second;
+         gpstk::ObsID obsID = ti->first;
+         double dd          = ti->second;
               
-               if ((obsID.band == ObsID::cbL1) &&
-                   (obsID.type == ObsID::otRange) &&
-                   (obsID.code == ObsID::tcCA))
-                  l1CArange.Add(dd);
-               else if ((obsID.band == ObsID::cbL1) &&
-                        (obsID.type == ObsID::otRange))
-                  l1Prange.Add(dd);
-               else if ((obsID.band == ObsID::cbL1) &&
-                        (obsID.type == ObsID::otPhase))
-                  l1Phase.Add(dd);
-               else if ((obsID.band == ObsID::cbL1) &&
-                        (obsID.type == ObsID::otDoppler))
-                  l1Doppler.Add(dd);
-               else if ((obsID.band == ObsID::cbL2) &&
-                        (obsID.type == ObsID::otRange))
-                  l2Prange.Add(dd);
-               else if ((obsID.band == ObsID::cbL2) &&
-                        (obsID.type == ObsID::otPhase))
-                  l2Phase.Add(dd);
-               else if ((obsID.band == ObsID::cbL2) &&
-                        (obsID.type == ObsID::otDoppler))   
-                  l2Doppler.Add(dd);
-            }
-         }    
+         if ((obsID.band == ObsID::cbL1) &&
+             (obsID.type == ObsID::otRange) &&
+             (obsID.code == ObsID::tcCA))
+            curr.l1CArange.Add(dd);
+         else if ((obsID.band == ObsID::cbL1) &&
+                  (obsID.type == ObsID::otRange))
+            curr.l1Prange.Add(dd);
+         else if ((obsID.band == ObsID::cbL1) &&
+                  (obsID.type == ObsID::otPhase))
+            curr.l1Phase.Add(dd);
+         else if ((obsID.band == ObsID::cbL1) &&
+                  (obsID.type == ObsID::otDoppler))
+            curr.l1Doppler.Add(dd);
+         else if ((obsID.band == ObsID::cbL2) &&
+                  (obsID.type == ObsID::otRange))
+            curr.l2Prange.Add(dd);
+         else if ((obsID.band == ObsID::cbL2) &&
+                  (obsID.type == ObsID::otPhase))
+            curr.l2Phase.Add(dd);
+         else if ((obsID.band == ObsID::cbL2) &&
+                  (obsID.type == ObsID::otDoppler))   
+            curr.l2Doppler.Add(dd);
       }
-      else
-      {
-         // reset window end time
-         windowEndDT = windowTempDT + windowLength;
-         
-         // compute and output stats for previous window
-         string time = windowTempDT.printf("%4Y %3j %02H:%02M:%04.1f");
+   }    
+}  // end of DDAverages::add()
+
+
+void DDAverages::output(ostream& s) const
+{
+   s << "# window end time        obs type    # points    mean ddr(m)\n";
+
+   list<Window>::const_iterator i;
+   for (i = windows.begin(); i != windows.end(); i++)
+   {
+      string time = i->t.printf("%4Y %3j %02H:%02M:%04.1f");
          
-         s << ">a " << left << setw(20) << time 
-           << setfill(' ') << setprecision(2) << " " << setw(16) 
-           << "L1 C/A range" << setw(6) << l1CArange.N()
-           << " " << right << setprecision(6) << setw(14) 
-           << l1CArange.Average() << endl;
+      s << ">a " << left << setw(20) << time 
+        << setfill(' ') << setprecision(2) << " " << setw(16) 
+        << "L1 C/A range" << setw(6) << i->l1CArange.N()
+        << " " << right << setprecision(6) << setw(14) 
+        << i->l1CArange.Average() << endl;
          
-         s << ">a " << left << setw(20) << time 
-           << setfill(' ') << setprecision(2) << " " << setw(16) 
-           << "L1 P/Y range" << setw(6) << l1Prange.N()
-           << " " <<  right << setprecision(6) << setw(14) 
-           << l1Prange.Average() << endl;
+      s << ">a " << left << setw(20) << time 
+        << setfill(' ') << setprecision(2) << " " << setw(16) 
+        << "L1 P/Y range" << setw(6) << i->l1Prange.N()
+        << " " <<  right << setprecision(6) << setw(14) 
+        << i->l1Prange.Average() << endl;
          
-         s << ">a " << left << setw(20) << time 
-           << setfill(' ') << setprecision(2) << " " << setw(16) 
-           << "L1 P/Y phase" << setw(6) << l1Phase.N()
-           << " " << right << setprecision(6) << setw(14) 
-           << l1Phase.Average() << endl;
+      s << ">a " << left << setw(20) << time 
+        << setfill(' ') << setprecision(2) << " " << setw(16) 
+        << "L1 P/Y phase" << setw(6) << i->l1Phase.N()
+        << " " << right << setprecision(6) << setw(14) 
+        << i->l1Phase.Average() << endl;
          
-         s << ">a " << left << setw(20) << time
-           << setfill(' ') << setprecision(2) << " " << setw(16) 
-           << "L1 P/Y doppl" << setw(6) << l1Doppler.N()
-           << " " << right << setprecision(6) << setw(14) 
-           << l1Doppler.Average() << endl;  
+      s << ">a " << left << setw(20) << time
+        << setfill(' ') << setprecision(2) << " " << setw(16) 
+        << "L1 P/Y doppl" << setw(6) << i->l1Doppler.N()
+        << " " << right << setprecision(6) << setw(14) 
+        << i->l1Doppler.Average() << endl;  
          
-         s << ">a " << left << setw(20) << time
-           << setfill(' ') << setprecision(2) << " "  << setw(16) 
-           << "L2 P/Y range" << setw(6) << l2Prange.N()
-           << " " << right << setprecision(6) << setw(14) 
-           << l2Prange.Average() << endl;
+      s << ">a " << left << setw(20) << time
+        << setfill(' ') << setprecision(2) << " "  << setw(16) 
+        << "L2 P/Y range" << setw(6) << i->l2Prange.N()
+        << " " << right << setprecision(6) << setw(14) 
+        << i->l2Prange.Average() << endl;
          
-         s << ">a " << left << setw(20) << time
-           << setfill(' ') << setprecision(2) << " " << setw(16) 
-           << "L2 P/Y phase" << setw(6) << l2Phase.N()
-           << " " << right << setprecision(6) << setw(14) 
-           << l2Phase.Average() << endl;
+      s << ">a " << left << setw(20) << time
+        << setfill(' ') << setprecision(2) << " " << setw(16) 
+        << "L2 P/Y phase" << setw(6) << i->l2Phase.N()
+        << " " << right << setprecision(6) << setw(14) 
+        << i->l2Phase.Average() << endl;
          
-         s << ">a " << left << setw(20) << time
-           << setfill(' ') << setprecision(2) << " " << setw(16) 
-           << "L2 P/Y doppl" << setw(6) << l2Doppler.N()
-           << " " << right << setprecision(6) << setw(14) 
-           << l2Doppler.Average() << endl;
-               
-
-         // reset objects to clear them and start recording data 
-         // for this new window
-         l1CArange.Reset();
-         l1Prange.Reset();
-         l1Phase.Reset();
-         l1Doppler.Reset();
-         l2Prange.Reset();
-         l2Phase.Reset();
-         l2Doppler.Reset();
-      }
-   
+      s << ">a " << left << setw(20) << time
+        << setfill(' ') << setprecision(2) << " " << setw(16) 
+        << "L2 P/Y doppl" << setw(6) << i->l2Doppler.N()
+        << " " << right << setprecision(6) << setw(14) 
+        << i->l2Doppler.Average() << endl;
    }
-}  // end of DDEpochMap::outputAverages()
-
+}  // end of DDAverages::output()
@@ -39,7 +39,11 @@
 #ifndef DDEPOCH_HPP
 #define DDEPOCH_HPP
 
+#include <list>
+#include <vector>
+
 #include <DayTime.hpp>
+#include <Stats.hpp>
 #include <stl_helpers.hpp>
 #include <icd_200_constants.hpp>
 
@@ -90,6 +94,11 @@ struct DDEpoch
       const gpstk::ObsEpoch& rx1, 
       const gpstk::ObsEpoch& rx2);
 
+   // Outputs the double differences of this epoch, one per line, in the
+   // format described by dumpHeader()
+   void dump(std::ostream& s, const gpstk::DayTime& t) const;
+
+   static void dumpHeader(std::ostream& s);
 };
 
 
@@ -102,14 +111,6 @@ struct DDEpochMap : public std::map<gpstk::DayTime, DDEpoch>
       const gpstk::ObsEpochMap& rx2,
       SvElevationMap& pem);
 
-   // Returns a string containing a statistical summary of the double difference
-   // residuals for the specified obs type within the given elevation range.
-   std::string computeStats(
-      const gpstk::ObsID oid,
-      const ElevationRange& er,
-      const CycleSlipList& csl,
-      const double strip) const;
-
    void outputStats(
       std::ostream& s,
       const ElevationRangeList& elr,
@@ -125,4 +126,61 @@ struct DDEpochMap : public std::map<gpstk::DayTime, DDEpoch>
 };
 
 
+// Accumulates, one epoch at a time, the double difference residuals
+// that go into the statistical summary of DDEpochMap::outputStats().
+// The residuals themselves have to be kept since the summary uses their
+// median.
+struct DDStats
+{
+   DDStats(const ElevationRangeList& elr);
+
+   void add(const DDEpoch& dde);
+
+   // Returns a string containing a statistical summary of the double
+   // difference residuals for the specified obs type within the bin'th
+   // elevation range.
+   std::string computeStats(
+      const gpstk::ObsID& oid,
+      unsigned bin,
+      const CycleSlipList& csl) const;
+
+   void output(std::ostream& s, const CycleSlipList& csl) const;
+
+   std::vector<ElevationRange> bins;
+   std::vector<unsigned long> svEpochCount;
+
+   // The residuals of each obs type, for each elevation bin
+   typedef std::map<gpstk::ObsID, std::vector< std::vector<double> > > OIDDM;
+   OIDDM dd;
+};
+
+
+// Computes the mean double differences over consecutive windows of time,
+// one epoch at a time. A window is closed by the first epoch past its end;
+// that epoch starts the next window but its data is not used.
+struct DDAverages
+{
+   DDAverages(unsigned long len);
+
+   void add(const gpstk::DayTime& t, const DDEpoch& dde);
+
+   // Outputs the means of the windows closed so far
+   void output(std::ostream& s) const;
+
+   // only going to compute averages for range, phase, and doppler
+   struct Window
+   {
+      gpstk::DayTime t;
+      gpstk::Stats<double> l1CArange,l1Prange,l1Phase,l1Doppler;
+      gpstk::Stats<double> l2Prange,l2Phase,l2Doppler;
+   };
+
+   unsigned long windowLength;    // seconds
+   bool started;
+   gpstk::DayTime windowEndDT;
+   Window curr;
+   std::list<Window> windows;
+};
+
+
 #endif
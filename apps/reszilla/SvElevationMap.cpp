@@ -43,30 +43,40 @@ using namespace gpstk;
 
 // ---------------------------------------------------------------------
 // ---------------------------------------------------------------------
+SvDoubleMap elevation_map(const ObsEpoch& oe,
+                          const Triple& ap,
+                          const XvtStore<SatID>& eph)
+{
+   SvDoubleMap pdm;
+
+   ECEF rxpos(ap);
+
+   ObsEpoch::const_iterator oe_itr;
+   for (oe_itr=oe.begin(); oe_itr!=oe.end(); oe_itr++)
+      try
+      {
+         SatID prn = oe_itr->first;
+         Xvt svpos = eph.getXvt(prn, oe.time);
+         pdm[prn] = rxpos.elvAngle(svpos.x);
+      }
+      catch (InvalidRequest& e)
+      {
+      }
+   return pdm;
+}
+
 SvElevationMap elevation_map(const ObsEpochMap& oem,
                              const Triple& ap,
                              const XvtStore<SatID>& eph)
 {
    SvElevationMap pem;
 
-   ECEF rxpos(ap);
-
    ObsEpochMap::const_iterator oem_itr;
    for (oem_itr=oem.begin(); oem_itr!=oem.end(); oem_itr++)
    {
-      const DayTime& t = oem_itr->first;
-      const ObsEpoch& oe = oem_itr->second;
-      ObsEpoch::const_iterator oe_itr;
-      for (oe_itr=oe.begin(); oe_itr!=oe.end(); oe_itr++)
-         try
-         {
-            SatID prn = oe_itr->first;
-            Xvt svpos = eph.getXvt(prn, t);
-            pem[t][prn] = rxpos.elvAngle(svpos.x);
-         }
-         catch (InvalidRequest& e)
-         {
-         }
+      SvDoubleMap pdm = elevation_map(oem_itr->second, ap, eph);
+      if (!pdm.empty())
+         pem[oem_itr->first].swap(pdm);
    }
    return pem;
 }
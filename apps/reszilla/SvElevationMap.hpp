@@ -51,6 +51,12 @@
 typedef std::map<gpstk::SatID, double> SvDoubleMap;
 typedef std::map<gpstk::DayTime, SvDoubleMap > SvElevationMap;
 
+// The elevation of each SV in the epoch, as seen from ap. SVs with no
+// ephemeris are left out.
+SvDoubleMap elevation_map(const gpstk::ObsEpoch& oe,
+                          const gpstk::Triple& ap,
+                          const gpstk::XvtStore<gpstk::SatID>& bce);
+
 SvElevationMap elevation_map(const gpstk::ObsEpochMap& obs,
                              const gpstk::Triple& ap,
                              const gpstk::XvtStore<gpstk::SatID>& bce);
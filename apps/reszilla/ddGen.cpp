@@ -49,6 +49,7 @@
 #include "EphReader.hpp"
 
 #include "DDEpoch.hpp"
+#include "DDEngine.hpp"
 #include "PhaseCleaner.hpp"
 #include "CycleSlipList.hpp"
 #include "SvElevationMap.hpp"
@@ -60,6 +61,95 @@ using namespace gpstk;
 using namespace gpstk::StringUtils;
 
 
+//-----------------------------------------------------------------------------
+// Reads the obs files of one receiver an epoch at a time, estimating the
+// receiver clock offset of each epoch along the way. Epochs without a
+// clock offset are skipped.
+//-----------------------------------------------------------------------------
+class RxObsReader
+{
+public:
+   RxObsReader(const vector<string>& fns,
+               const XvtStore<SatID>& eph,
+               const Triple& antennaPos,
+               const string& ordMode,
+               bool zeroTrop,
+               unsigned long id,
+               int verbose,
+               int debug)
+      : files(fns), fileIndex(0), obsReader(NULL),
+        tm(zeroTrop ? (TropModel*)new ZeroTropModel : new NBTropModel),
+        ordEngine(eph, wod, antennaPos, ordMode, *tm),
+        cm(1.5, 10, ObsClockModel::HEALTHY),
+        msid(id), verboseLevel(verbose)
+   {
+      ordEngine.verboseLevel = verbose;
+      ordEngine.debugLevel = debug;
+   }
+
+   ~RxObsReader()
+   {
+      delete obsReader;
+      delete tm;
+   }
+
+   bool getObsEpoch(ObsEpoch& obs);
+
+private:
+   vector<string> files;
+   size_t fileIndex;
+   ObsReader* obsReader;
+
+   // Just a placeholder
+   gpstk::WxObsData wod;
+   TropModel* tm;
+   OrdEngine ordEngine;
+   EpochClockModel cm;
+   const GPSGeoid gm;
+   unsigned long msid;
+   int verboseLevel;
+};
+
+
+bool RxObsReader::getObsEpoch(ObsEpoch& obs)
+{
+   for (;;)
+   {
+      if (obsReader == NULL)
+      {
+         if (fileIndex == files.size())
+            return false;
+         obsReader = new ObsReader(files[fileIndex++], verboseLevel);
+         obsReader->msid = msid;
+      }
+
+      if (*obsReader)
+         obs = obsReader->getObsEpoch();
+      if (!*obsReader)
+      {
+         delete obsReader;
+         obsReader = NULL;
+         continue;
+      }
+
+      ORDEpoch oe = ordEngine(obs);
+      cm.addEpoch(oe);
+
+      if (cm.isOffsetValid())
+      {
+         // Need to keep clock offset in seconds
+         obs.rxClock = cm.getOffset() / gm.c();
+         return true;
+      }
+
+      if (verboseLevel>2)
+         cout << "# Could not estimate clock for epoch at " << obs.time 
+              << endl;
+   }
+}
+
+
+
 class DDGen : public gpstk::BasicFramework
 {
 public:
@@ -88,7 +178,7 @@ private:
    ObsEpochMap obs1, obs2;
    CommandOptionWithAnyArg obs1FileOption, obs2FileOption, ephFileOption;
    ElevationRangeList elr;
-   bool outputRaw, computeAll, removeUnhealthy, zeroTrop, useNear;
+   bool outputRaw, computeAll, removeUnhealthy, zeroTrop, useNear, stream;
    EphReader healthSrcER;
    
    void readObsFile(const CommandOptionWithAnyArg& obsFileOption,
@@ -96,7 +186,10 @@ private:
                     ObsEpochMap &oem);
    
    void filterObs(const XvtStore<SatID>& eph, ObsEpochMap &oem);
-   
+
+   void filterObs(const XvtStore<SatID>& eph, ObsEpoch &obsEpoch);
+
+   void processStream(const XvtStore<SatID>& eph, int readDebugLevel);
 };
 
 //-----------------------------------------------------------------------------
@@ -107,7 +200,7 @@ DDGen::DDGen() throw()
      ddMode("all"), ordMode("smart"), minArcGap(60), minArcTime(60),
      minArcLen(5), msid(0), window(0), minSNR(20), strip(3.2),
      outputRaw(false), removeUnhealthy(false), computeAll(false),
-     noiseThreshold(0.1),
+     stream(false), noiseThreshold(0.1),
 
      obs1FileOption('1', "obs1", 
                     "Where to get the first receiver's obs data.", true),
@@ -176,7 +269,13 @@ bool DDGen::initialize(int argc, char *argv[]) throw()
       useNearOption('n', "near", "Allow the program to select an ephemeris that "
                     "is not strictly in the future. Only affects the selection of which broadcast "
                     "ephemeris to use. i.e. use a close ephemeris."),
-      zeroTropOption('\0', "zero-trop", "Disables trop corrections.");
+      zeroTropOption('\0', "zero-trop", "Disables trop corrections."),
+      streamOption('\0', "stream", "Compute the double differences an epoch "
+                   "at a time, keeping only the data of the current passes "
+                   "in memory, instead of reading all the obs data first. "
+                   "The obs files must be given in time order. The raw "
+                   "double differences (-r) are output as they are "
+                   "computed, ahead of the statistics.");
 
    if (!BasicFramework::initialize(argc,argv)) 
       return false;
@@ -331,6 +430,8 @@ bool DDGen::initialize(int argc, char *argv[]) throw()
 
    useNear = useNearOption.getCount();
 
+   stream = streamOption.getCount();
+
    return true;
 }
 
@@ -391,6 +492,12 @@ void DDGen::process()
       bce.SearchNear();
    }
 
+   if (stream)
+   {
+      processStream(eph, prevDebugLevel);
+      return;
+   }
+
    ObsEpochMap oem1, oem2;
 
    if (debugLevel || verboseLevel)
@@ -459,63 +566,109 @@ void DDGen::process()
 }
 
 //-----------------------------------------------------------------------------
-// Read a single file of observation data, computing receiver clock offsets along
-// the way.
+// The same as process() but with the data read, and the double differences
+// computed, an epoch at a time.
 //-----------------------------------------------------------------------------
-void DDGen::readObsFile(
-   const CommandOptionWithAnyArg& obsFileOption, 
-   const XvtStore<SatID>& eph,
-   ObsEpochMap &oem)
+void DDGen::processStream(const XvtStore<SatID>& eph, int prevDebugLevel)
 {
-   // Just a placeholder
-   gpstk::WxObsData wod;
+   RxObsReader rx1(obs1FileOption.getValue(), eph, antennaPos, ordMode,
+                   zeroTrop, msid, verboseLevel, debugLevel);
+   RxObsReader rx2(obs2FileOption.getValue(), eph, antennaPos, ordMode,
+                   zeroTrop, msid, verboseLevel, debugLevel);
+   debugLevel = prevDebugLevel;
 
-   TropModel* tm;
-   if (!zeroTrop)
-      tm = new NBTropModel;
-   else
-      tm = new ZeroTropModel;
+   DDEpochMap::debugLevel = debugLevel;
+   DDEpochMap::useMasterSV = !computeAll;
 
-   // Now set up the function object that is used to compute the ords.
-   OrdEngine ordEngine(eph, wod, antennaPos, ordMode, *tm);
-   ordEngine.verboseLevel = verboseLevel;
-   ordEngine.debugLevel = debugLevel;
+   DDEngine dde(elr, minArcLen, minArcTime, minArcGap, noiseThreshold);
+   dde.debugLevel = debugLevel;
 
-   // Set up a simple epoch clock model.
-   EpochClockModel cm(1.5, 10, ObsClockModel::HEALTHY);
-   const GPSGeoid gm;
+   dde.averages.windowLength = window;
 
-   // Walk through each obs file, reading and computing ords along the way.
-   for (int i=0; i<obsFileOption.getCount(); i++)
+   if (outputRaw)
    {
-      string fn = (obsFileOption.getValue())[i];
-      ObsReader obsReader(fn, verboseLevel);
-      obsReader.msid = msid;
+      DDEpoch::dumpHeader(cout);
+      dde.rawOutput = &cout;
+   }
+
+   if (verboseLevel>1)
+      dde.arcOutput = &cout;
 
-      while (obsReader)
+   if (debugLevel || verboseLevel)
+      cout << "# Reading obs from Rx1 and Rx2" << endl;
+
+   if (verboseLevel)
+   {
+      if (removeUnhealthy)
+         cout << "# Filtering obs from unhealthy SVs." << endl;
+      if (minSNR>0)
+         cout << "# Filtering obs with low SNR." << endl;
+   }
+
+   ObsEpoch oe1, oe2;
+   bool more2 = rx2.getObsEpoch(oe2);
+   if (more2)
+      filterObs(*healthSrcER.eph, oe2);
+
+   DayTime prevTime = DayTime::BEGINNING_OF_TIME;
+   while (rx1.getObsEpoch(oe1))
+   {
+      if (oe1.time <= prevTime)
       {
-         ObsEpoch obs(obsReader.getObsEpoch());
-         if (!obsReader)
-            break;
+         if (verboseLevel)
+            cout << "# Skipping out of order epoch at " << oe1.time << endl;
+         continue;
+      }
+      prevTime = oe1.time;
 
-         ORDEpoch oe = ordEngine(obs);
-         
-         cm.addEpoch(oe);
+      filterObs(*healthSrcER.eph, oe1);
 
-         if (cm.isOffsetValid())
-         {
-            // Need to keep clock offset in seconds
-            obs.rxClock = cm.getOffset() / gm.c();
-            oem[obs.time] = obs;
-         }
-         else
-         {
-            if (verboseLevel>2)
-               cout << "# Could not estimate clock for epoch at " << obs.time 
-                    << endl;
-         }
+      while (more2 && oe2.time < oe1.time)
+      {
+         more2 = rx2.getObsEpoch(oe2);
+         if (more2)
+            filterObs(*healthSrcER.eph, oe2);
+      }
+
+      if (!more2 || oe1.time < oe2.time)
+      {
+         if (debugLevel>1)
+            cout << "# Epoch with no data from rx 2" << endl;
+         continue;
       }
+
+      dde.addEpoch(oe1, oe2, elevation_map(oe1, antennaPos, eph));
    }
+   dde.finish();
+
+   if (verboseLevel)
+      dde.slips.dump(cout);
+
+   if (window)
+   {
+      if (verboseLevel)
+         cout << "# Computing averages for windows of " << window << " seconds.\n";
+      dde.averages.output(cout);
+   }
+
+   dde.stats.output(cout, dde.slips);
+}
+
+//-----------------------------------------------------------------------------
+// Read a single file of observation data, computing receiver clock offsets along
+// the way.
+//-----------------------------------------------------------------------------
+void DDGen::readObsFile(
+   const CommandOptionWithAnyArg& obsFileOption, 
+   const XvtStore<SatID>& eph,
+   ObsEpochMap &oem)
+{
+   RxObsReader rx(obsFileOption.getValue(), eph, antennaPos, ordMode,
+                  zeroTrop, msid, verboseLevel, debugLevel);
+
+   ObsEpoch obs;
+   while (rx.getObsEpoch(obs))
+      oem[obs.time] = obs;
 }
 
 void DDGen::filterObs(const XvtStore<SatID>& eph, ObsEpochMap &oem)
@@ -531,57 +684,58 @@ void DDGen::filterObs(const XvtStore<SatID>& eph, ObsEpochMap &oem)
    ObsEpochMap::iterator oemIter;   
 
    for (oemIter=oem.begin(); oemIter!=oem.end(); oemIter++)
-   {
-      const DayTime& t = oemIter->first;
-      ObsEpoch& obsEpoch = oemIter->second;
-      if (removeUnhealthy)
-         try
-         {
-            const GPSEphemerisStore& bce = dynamic_cast<const GPSEphemerisStore&>(eph);
-            for(ObsEpoch::iterator oeIter=obsEpoch.begin(); oeIter!=obsEpoch.end();)
-            {
-               const SatID& svid = oeIter->first;
-               SvObsEpoch& soe = oeIter->second;
-               
-               EngEphemeris ephTemp = bce.findEphemeris(svid, t);
-               short health =  ephTemp.getHealth();
-               if (health != 0)
-                  obsEpoch.erase(oeIter++);
-               else
-                  oeIter++;
-            } // end looping over all SVs in this epoch
-         }
-         catch (gpstk::Exception &exc)
-         { 
-            if (verboseLevel || debugLevel)
-               cout << "# DDGen::filterObs: probably missing eph data"
-                    << endl;
-         }
+      filterObs(eph, oemIter->second);
+}
 
-      if (minSNR > 0)
-         for(ObsEpoch::iterator oeIter=obsEpoch.begin(); oeIter!=obsEpoch.end(); oeIter++)
+void DDGen::filterObs(const XvtStore<SatID>& eph, ObsEpoch &obsEpoch)
+{
+   const DayTime& t = obsEpoch.time;
+   if (removeUnhealthy)
+      try
+      {
+         const GPSEphemerisStore& bce = dynamic_cast<const GPSEphemerisStore&>(eph);
+         for(ObsEpoch::iterator oeIter=obsEpoch.begin(); oeIter!=obsEpoch.end();)
          {
+            const SatID& svid = oeIter->first;
             SvObsEpoch& soe = oeIter->second;
-            
-            // Find all the obs that deserve to die...
-            set<ObsID> killMe;
-            for (SvObsEpoch::iterator oi1 = soe.begin(); oi1 != soe.end(); oi1++)
-            if (oi1->first.type == ObsID::otSNR && oi1->second < minSNR)
-               killMe.insert(oi1->first);
-            
-            // Then terminate them!
-            for (SvObsEpoch::iterator oi1 = soe.begin(); oi1 != soe.end();)
-            {
-               ObsID oid(oi1->first);
-               oid.type = ObsID::otSNR;
-               if (killMe.find(oid) != killMe.end())
-                  soe.erase(oi1++);
-               else
-                  oi1++;
-            }
+               
+            EngEphemeris ephTemp = bce.findEphemeris(svid, t);
+            short health =  ephTemp.getHealth();
+            if (health != 0)
+               obsEpoch.erase(oeIter++);
+            else
+               oeIter++;
          } // end looping over all SVs in this epoch
+      }
+      catch (gpstk::Exception &exc)
+      { 
+         if (verboseLevel || debugLevel)
+            cout << "# DDGen::filterObs: probably missing eph data"
+                 << endl;
+      }
 
-   } // end of looping over all epochs
+   if (minSNR > 0)
+      for(ObsEpoch::iterator oeIter=obsEpoch.begin(); oeIter!=obsEpoch.end(); oeIter++)
+      {
+         SvObsEpoch& soe = oeIter->second;
+            
+         // Find all the obs that deserve to die...
+         set<ObsID> killMe;
+         for (SvObsEpoch::iterator oi1 = soe.begin(); oi1 != soe.end(); oi1++)
+         if (oi1->first.type == ObsID::otSNR && oi1->second < minSNR)
+            killMe.insert(oi1->first);
+            
+         // Then terminate them!
+         for (SvObsEpoch::iterator oi1 = soe.begin(); oi1 != soe.end();)
+         {
+            ObsID oid(oi1->first);
+            oid.type = ObsID::otSNR;
+            if (killMe.find(oid) != killMe.end())
+               soe.erase(oi1++);
+            else
+               oi1++;
+         }
+      } // end looping over all SVs in this epoch
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,249 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2007, The University of Texas at Austin
+//
+//============================================================================
+
+#include <iostream>
+
+#include "AsyncFileWriter.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   AsyncFileWriter::AsyncFileWriter(size_t bs)
+      : debugLevel(0), batchSize(bs), running(false), stopping(false)
+   {
+      pthread_mutex_init(&mutex, NULL);
+      pthread_cond_init(&cond, NULL);
+   }
+
+
+   AsyncFileWriter::~AsyncFileWriter()
+   {
+      stop();
+
+      for (size_t i=0; i<queue.size(); i++)
+         delete queue[i];
+      for (size_t i=0; i<outputs.size(); i++)
+         delete outputs[i];
+
+      pthread_cond_destroy(&cond);
+      pthread_mutex_destroy(&mutex);
+   }
+
+
+   unsigned AsyncFileWriter::addFile(const string& filespec)
+   {
+      outputs.push_back(new Output(filespec));
+      outputs.back()->stream.debugLevel = debugLevel;
+      return outputs.size() - 1;
+   }
+
+
+   bool AsyncFileWriter::start()
+   {
+      if (running)
+         return true;
+
+      stopping = false;
+      running = pthread_create(&thread, NULL, threadMain, this) == 0;
+      return running;
+   }
+
+
+   void AsyncFileWriter::stop()
+   {
+      if (!running)
+         return;
+
+      flush();
+
+      pthread_mutex_lock(&mutex);
+      stopping = true;
+      pthread_cond_signal(&cond);
+      pthread_mutex_unlock(&mutex);
+
+      pthread_join(thread, NULL);
+      running = false;
+   }
+
+
+   void AsyncFileWriter::write(unsigned f, const string& data)
+   {
+      if (data.empty())
+         return;
+
+      Output& o = *outputs[f];
+      if (o.pending.empty())
+         o.pendingTime = DayTime();
+      o.pending += data;
+
+      if (o.pending.size() >= batchSize)
+         handOver(f);
+   }
+
+
+   void AsyncFileWriter::flush()
+   {
+      for (unsigned f=0; f<outputs.size(); f++)
+         handOver(f);
+   }
+
+
+   void AsyncFileWriter::handOver(unsigned f)
+   {
+      Output& o = *outputs[f];
+      if (o.pending.empty())
+         return;
+
+      Batch* b = new Batch;
+      b->file = f;
+      b->time = o.pendingTime;
+      b->data.swap(o.pending);
+
+      pthread_mutex_lock(&mutex);
+      queue.push_back(b);
+      o.queuedTimes.push_back(b->time);
+      o.queued += b->data.size();
+      pthread_cond_signal(&cond);
+      pthread_mutex_unlock(&mutex);
+   }
+
+
+   unsigned long AsyncFileWriter::getQueuedBytes(unsigned f) const
+   {
+      pthread_mutex_lock(&mutex);
+      unsigned long n = outputs[f]->queued;
+      pthread_mutex_unlock(&mutex);
+      return n;
+   }
+
+
+   unsigned long AsyncFileWriter::getWrittenBytes(unsigned f) const
+   {
+      pthread_mutex_lock(&mutex);
+      unsigned long n = outputs[f]->written;
+      pthread_mutex_unlock(&mutex);
+      return n;
+   }
+
+
+   double AsyncFileWriter::getLag(unsigned f) const
+   {
+      const Output& o = *outputs[f];
+      bool have = false;
+      DayTime t;
+
+      pthread_mutex_lock(&mutex);
+      if (!o.queuedTimes.empty())
+      {
+         t = o.queuedTimes.front();
+         have = true;
+      }
+      pthread_mutex_unlock(&mutex);
+
+      if (!have && !o.pending.empty())
+      {
+         t = o.pendingTime;
+         have = true;
+      }
+
+      return have ? DayTime() - t : 0.0;
+   }
+
+
+   string AsyncFileWriter::getCurrentFilename(unsigned f) const
+   {
+      pthread_mutex_lock(&mutex);
+      string fn = outputs[f]->useStdout ? string("<stdout>")
+         : outputs[f]->stream.getCurrentFilename();
+      pthread_mutex_unlock(&mutex);
+      return fn;
+   }
+
+
+   void* AsyncFileWriter::threadMain(void* p)
+   {
+      static_cast<AsyncFileWriter*>(p)->writeBatches();
+      return NULL;
+   }
+
+
+   void AsyncFileWriter::writeBatches()
+   {
+      deque<Batch*> work;
+
+      pthread_mutex_lock(&mutex);
+      for (;;)
+      {
+         while (queue.empty() && !stopping)
+            pthread_cond_wait(&cond, &mutex);
+         if (queue.empty())
+            break;
+
+         work.swap(queue);
+         pthread_mutex_unlock(&mutex);
+
+         for (size_t i=0; i<work.size(); i++)
+         {
+            Batch& b = *work[i];
+            Output& o = *outputs[b.file];
+            if (o.useStdout)
+            {
+               cout.write(b.data.data(), b.data.size());
+               cout.flush();
+               continue;
+            }
+
+            // The name only changes here, the mutex keeps
+            // getCurrentFilename() from seeing it half done.
+            pthread_mutex_lock(&mutex);
+            o.stream.updateFileName(b.time);
+            pthread_mutex_unlock(&mutex);
+
+            o.stream.write(b.data.data(), b.data.size());
+            o.stream.flush();
+            if (!o.stream)
+            {
+               if (debugLevel)
+                  cout << "Error writing " << o.stream.getCurrentFilename()
+                       << endl;
+               o.stream.clear();
+            }
+         }
+
+         pthread_mutex_lock(&mutex);
+         for (size_t i=0; i<work.size(); i++)
+         {
+            Output& o = *outputs[work[i]->file];
+            o.queued -= work[i]->data.size();
+            o.written += work[i]->data.size();
+            o.queuedTimes.pop_front();
+            delete work[i];
+         }
+         work.clear();
+      }
+      pthread_mutex_unlock(&mutex);
+   }
+
+} // end of namespace
@@ -0,0 +1,136 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2007, The University of Texas at Austin
+//
+//============================================================================
+
+#ifndef ASYNCFILEWRITER_HPP
+#define ASYNCFILEWRITER_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <fstream>
+
+#include <pthread.h>
+
+#include <DayTime.hpp>
+#include <TimeNamedFileStream.hpp>
+
+namespace gpstk
+{
+   // Writes data to a set of TimeNamedFileStreams from a thread of its
+   // own, so the caller never waits on the disk. Data is collected per
+   // file and handed to the writer thread in batches, either when a
+   // file's batch is big enough or when flush() is called. A batch goes
+   // to the file named for the time its first byte was added, so files
+   // roll over at most one flush interval late and never in the middle
+   // of a batch.
+   class AsyncFileWriter
+   {
+   public:
+      AsyncFileWriter(size_t batchSize = 65536);
+
+      // Writes out everything still pending, then stops the thread
+      ~AsyncFileWriter();
+
+      // Adds an output and returns its index. The filespec is as for
+      // TimeNamedFileStream; "-" means standard output.
+      unsigned addFile(const std::string& filespec);
+
+      // Bytes to collect per output before handing them over
+      void setBatchSize(size_t bs) { batchSize = bs; }
+
+      // Starts the writer thread. Returns false if it couldn't be started.
+      bool start();
+
+      // Writes out everything still pending and waits for the thread
+      void stop();
+
+      // Queues data for output f
+      void write(unsigned f, const std::string& data);
+
+      // Hands all partial batches to the writer thread
+      void flush();
+
+      // Bytes of output f handed over but not written yet
+      unsigned long getQueuedBytes(unsigned f) const;
+
+      // Bytes of output f written
+      unsigned long getWrittenBytes(unsigned f) const;
+
+      // Seconds since the oldest byte of output f that hasn't been written
+      // was added, zero if there is none.
+      double getLag(unsigned f) const;
+
+      // Name of the file output f is writing to now
+      std::string getCurrentFilename(unsigned f) const;
+
+      int debugLevel;
+
+   private:
+      AsyncFileWriter(const AsyncFileWriter&);
+      AsyncFileWriter& operator=(const AsyncFileWriter&);
+
+      struct Batch
+      {
+         unsigned file;
+         DayTime time;
+         std::string data;
+      };
+
+      struct Output
+      {
+         Output(const std::string& fs)
+            : stream(fs, std::ios::app|std::ios::out),
+              useStdout(fs == "-"), queued(0), written(0)
+         {}
+
+         TimeNamedFileStream<std::ofstream> stream;
+         bool useStdout;
+
+         // The batch being filled, by the caller's thread only
+         std::string pending;
+         DayTime pendingTime;
+
+         // Guarded by the mutex
+         std::deque<DayTime> queuedTimes;
+         unsigned long queued;
+         unsigned long written;
+      };
+
+      static void* threadMain(void* p);
+      void writeBatches();
+      void handOver(unsigned f);
+
+      std::vector<Output*> outputs;
+      size_t batchSize;
+
+      std::deque<Batch*> queue;
+      mutable pthread_mutex_t mutex;
+      pthread_cond_t cond;
+      pthread_t thread;
+      bool running;
+      bool stopping;
+   };
+
+} // end of namespace
+#endif
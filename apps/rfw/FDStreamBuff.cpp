@@ -49,6 +49,21 @@ namespace gpstk
       }
    }
 
+   int FDStreamBuff::setBlocking(bool blocking)
+   {
+      if (!is_open())
+         return -1;
+
+      int flags = fcntl(handle, F_GETFL, 0);
+      if (flags < 0)
+         return -1;
+      if (blocking)
+         flags &= ~O_NONBLOCK;
+      else
+         flags |= O_NONBLOCK;
+      return fcntl(handle, F_SETFL, flags);
+   }
+
    // Write characters to the stream, giving time. Return the number of
    // characters actually written (which is always n, or EOF in case of error).
    int FDStreamBuff::write(const char * buffer, const int n)
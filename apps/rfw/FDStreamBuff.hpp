@@ -55,6 +55,11 @@ namespace gpstk
       
       bool is_open() const { return handle >= 0; }
       void close();
+
+      // Turns O_NONBLOCK on or off. Returns 0, or -1 on error. The
+      // stream functions expect a blocking descriptor; a non-blocking one
+      // is meant to be read directly, i.e. from an epoll loop.
+      int setBlocking(bool blocking);
       virtual FDStreamBuff* setbuf(char* p, const int len);
   
       // We limit this stream to be sequential
@@ -0,0 +1,369 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2007, The University of Texas at Austin
+//
+//============================================================================
+
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <termios.h>
+#include <sys/time.h>
+#include <sys/epoll.h>
+
+#include <StringUtils.hpp>
+#include <DayTime.hpp>
+
+#include "IngestServer.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   namespace
+   {
+      double now()
+      {
+         struct timeval tv;
+         gettimeofday(&tv, NULL);
+         return tv.tv_sec + 1e-6 * tv.tv_usec;
+      }
+
+      const int maxEvents = 256;
+      const size_t readBufferSize = 65536;
+   }
+
+   volatile sig_atomic_t IngestServer::stopRequested = 0;
+
+
+   IngestServer::IngestServer(AsyncFileWriter& w)
+      : flushInterval(1), reportInterval(60), retryInterval(10),
+        debugLevel(0), writer(w), epfd(-1), readBuffer(readBufferSize),
+        lastReport(now())
+   {}
+
+
+   IngestServer::~IngestServer()
+   {
+      for (size_t i=0; i<streams.size(); i++)
+      {
+         delete streams[i]->buff;
+         delete streams[i]->framer;
+         delete streams[i];
+      }
+      if (epfd >= 0)
+         ::close(epfd);
+   }
+
+
+   bool IngestServer::addStream(const string& target,
+                                const string& format,
+                                const string& filespec)
+   {
+      RecordFramer* framer = RecordFramer::create(format);
+      if (framer == NULL)
+      {
+         cerr << "Unknown format " << format << " for " << target << endl;
+         return false;
+      }
+
+      Stream* s = new Stream;
+      s->target = target;
+      s->state = ssClosed;
+      s->port = 0;
+      s->buff = NULL;
+      s->framer = framer;
+      s->output = writer.addFile(filespec);
+      s->retryAt = 0;
+      s->lastData = now();
+      s->bytes = s->connects = 0;
+      s->reportBytes = s->reportRecords = 0;
+
+      if (target.substr(0, 4) == "tcp:")
+      {
+         // The name is only resolved once
+         string host = target.substr(4);
+         s->port = 25;
+         string::size_type i = host.find(":");
+         if (i < host.size())
+         {
+            s->port = StringUtils::asInt(host.substr(i+1));
+            host.erase(i);
+         }
+         s->type = stTCP;
+         s->host = IPaddress(host);
+      }
+      else if (target.substr(0, 4) == "ser:")
+         s->type = stSerial;
+      else
+         s->type = stFile;
+
+      streams.push_back(s);
+      return true;
+   }
+
+
+   bool IngestServer::watch(Stream& s, int op, unsigned events)
+   {
+      struct epoll_event ev;
+      memset(&ev, 0, sizeof(ev));
+      ev.events = events;
+      ev.data.ptr = &s;
+      return epoll_ctl(epfd, op, s.buff->handle, &ev) == 0;
+   }
+
+
+   void IngestServer::open(Stream& s)
+   {
+      if (s.type == stTCP)
+      {
+         TCPStreamBuff* tcp = new TCPStreamBuff();
+         s.buff = tcp;
+         int rc = tcp->startConnect(SocketAddr(s.host, s.port));
+         if (rc < 0)
+         {
+            close(s, string("connect: ") + strerror(errno));
+            return;
+         }
+         if (rc == 1)
+         {
+            s.state = ssConnecting;
+            if (!watch(s, EPOLL_CTL_ADD, EPOLLOUT))
+               close(s, string("epoll: ") + strerror(errno));
+            return;
+         }
+      }
+      else
+      {
+         string fn = s.target;
+         if (s.type == stSerial)
+            fn.erase(0, 4);
+
+         int fd = ::open(fn.c_str(), O_RDONLY | O_NOCTTY | O_NONBLOCK);
+         s.buff = new FDStreamBuff(fd);
+         if (fd < 0)
+         {
+            close(s, string("open: ") + strerror(errno));
+            return;
+         }
+
+         if (s.type == stSerial)
+         {
+            // The same settings as DeviceStream uses
+            struct termios options;
+            memset(&options, 0, sizeof(options));
+            options.c_iflag = IGNBRK;
+            options.c_lflag &= ~(ICANON | ECHO | ECHOE | ISIG);
+            options.c_cflag = CS8 | CSIZE | CREAD | HUPCL | CLOCAL;
+            cfsetispeed(&options, B115200);
+            tcsetattr(fd, TCSANOW, &options);
+         }
+      }
+
+      s.state = ssOpen;
+      if (!watch(s, EPOLL_CTL_ADD, EPOLLIN))
+      {
+         // epoll can't watch regular files; there is no point in retrying
+         string why = string("epoll: ") + strerror(errno);
+         close(s, why);
+         if (s.type == stFile)
+            s.state = ssFailed;
+         return;
+      }
+      connected(s);
+   }
+
+
+   void IngestServer::connected(Stream& s)
+   {
+      s.connects++;
+      s.lastData = now();
+      s.framer->reset();
+      if (debugLevel)
+         cout << "Opened " << s.target << endl;
+   }
+
+
+   void IngestServer::close(Stream& s, const string& why)
+   {
+      if (debugLevel || s.state == ssOpen)
+         cout << "Closing " << s.target << ": " << why << endl;
+
+      // Closing the descriptor removes it from the epoll set
+      delete s.buff;
+      s.buff = NULL;
+      s.state = ssClosed;
+      s.retryAt = now() + retryInterval;
+   }
+
+
+   void IngestServer::read(Stream& s)
+   {
+      ssize_t n = ::read(s.buff->handle, &readBuffer[0], readBuffer.size());
+      if (n < 0)
+      {
+         if (errno != EAGAIN && errno != EINTR)
+            close(s, strerror(errno));
+         return;
+      }
+      if (n == 0)
+      {
+         close(s, "end of stream");
+         return;
+      }
+
+      s.bytes += n;
+      s.lastData = now();
+
+      records.clear();
+      if (s.framer->add(&readBuffer[0], n, records))
+         writer.write(s.output, records);
+   }
+
+
+   bool IngestServer::run()
+   {
+      epfd = epoll_create(streams.size() + 1);
+      if (epfd < 0)
+      {
+         cerr << "epoll_create: " << strerror(errno) << endl;
+         return false;
+      }
+
+      for (size_t i=0; i<streams.size(); i++)
+         open(*streams[i]);
+
+      struct epoll_event events[maxEvents];
+      double t = now();
+      double nextFlush = t + flushInterval;
+      double nextReport = t + reportInterval;
+      lastReport = t;
+
+      while (!stopRequested)
+      {
+         double next = nextFlush;
+         if (reportInterval > 0 && nextReport < next)
+            next = nextReport;
+         for (size_t i=0; i<streams.size(); i++)
+            if (streams[i]->state == ssClosed && streams[i]->retryAt < next)
+               next = streams[i]->retryAt;
+
+         int timeout = int(1000 * (next - now()));
+         if (timeout < 0)
+            timeout = 0;
+
+         int n = epoll_wait(epfd, events, maxEvents, timeout);
+         if (n < 0 && errno != EINTR)
+         {
+            cerr << "epoll_wait: " << strerror(errno) << endl;
+            break;
+         }
+
+         // Level triggered, so one read per stream per pass keeps a busy
+         // stream from starving the others.
+         for (int i=0; i<n; i++)
+         {
+            Stream& s = *static_cast<Stream*>(events[i].data.ptr);
+            if (s.state == ssOpen)
+               read(s);
+            else if (s.state == ssConnecting)
+            {
+               int err = static_cast<TCPStreamBuff*>(s.buff)->finishConnect();
+               if (err)
+                  close(s, string("connect: ") + strerror(err));
+               else if (!watch(s, EPOLL_CTL_MOD, EPOLLIN))
+                  close(s, string("epoll: ") + strerror(errno));
+               else
+               {
+                  s.state = ssOpen;
+                  connected(s);
+               }
+            }
+         }
+
+         t = now();
+         for (size_t i=0; i<streams.size(); i++)
+            if (streams[i]->state == ssClosed && streams[i]->retryAt <= t)
+               open(*streams[i]);
+
+         if (t >= nextFlush)
+         {
+            writer.flush();
+            nextFlush = t + flushInterval;
+         }
+
+         if (reportInterval > 0 && t >= nextReport)
+         {
+            report(cout);
+            nextReport = t + reportInterval;
+         }
+      }
+
+      writer.flush();
+      return true;
+   }
+
+
+   void IngestServer::report(ostream& out)
+   {
+      const char* stateName[] = {"closed", "connecting", "open", "failed"};
+
+      double t = now();
+      double dt = t - lastReport;
+      if (dt <= 0)
+         dt = 1;
+      lastReport = t;
+
+      ostringstream oss;
+      oss << DayTime().printf("%4Y/%03j %02H:%02M:%02S") << " "
+          << streams.size() << " streams" << endl;
+
+      oss << fixed;
+      for (size_t i=0; i<streams.size(); i++)
+      {
+         Stream& s = *streams[i];
+         const unsigned long records = s.framer->records;
+         oss << s.target
+             << " " << stateName[s.state]
+             << " " << setprecision(2)
+             << (s.bytes - s.reportBytes) / dt / 1024 << " kB/s"
+             << " " << setprecision(1)
+             << (records - s.reportRecords) / dt << " rec/s"
+             << " rec:" << records
+             << " skip:" << s.framer->skippedBytes
+             << " conn:" << s.connects
+             << " idle:" << t - s.lastData
+             << " queued:" << writer.getQueuedBytes(s.output)
+             << " lag:" << writer.getLag(s.output)
+             << endl;
+
+         s.reportBytes = s.bytes;
+         s.reportRecords = records;
+      }
+
+      out << oss.str() << flush;
+   }
+
+} // end of namespace
@@ -0,0 +1,124 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2007, The University of Texas at Austin
+//
+//============================================================================
+
+#ifndef INGESTSERVER_HPP
+#define INGESTSERVER_HPP
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <signal.h>
+
+#include "TCPStreamBuff.hpp"
+#include "RecordFramer.hpp"
+#include "AsyncFileWriter.hpp"
+
+namespace gpstk
+{
+   // Reads many receiver streams from one thread with epoll. Each stream
+   // is a tcp connection (tcp:host:port), a serial port (ser:/dev/ttyS0)
+   // or a fifo, as in DeviceStream, and has a RecordFramer and an output
+   // of an AsyncFileWriter. Nothing in the loop waits on a device or on
+   // the disk: tcp connections are made without blocking, and streams
+   // that close or fail are opened again after retryInterval seconds.
+   class IngestServer
+   {
+   public:
+      IngestServer(AsyncFileWriter& writer);
+
+      ~IngestServer();
+
+      // Adds a stream. Returns false if the format isn't known.
+      bool addStream(const std::string& target,
+                     const std::string& format,
+                     const std::string& filespec);
+
+      // Reads until requestStop() is called. Returns false if epoll
+      // couldn't be set up.
+      bool run();
+
+      // Makes run() return; safe to call from a signal handler
+      static void requestStop() { stopRequested = 1; }
+
+      // One line per stream: state, throughput since the last report,
+      // records, bytes skipped, seconds since data was last received
+      // (idle), bytes waiting to be written and how old the oldest of
+      // them is (lag).
+      void report(std::ostream& out);
+
+      double flushInterval;   // seconds between writer flushes
+      double reportInterval;  // seconds between reports, 0 for none
+      double retryInterval;   // seconds before reopening a stream
+      int debugLevel;
+
+   private:
+      IngestServer(const IngestServer&);
+      IngestServer& operator=(const IngestServer&);
+
+      enum StreamType { stTCP, stSerial, stFile };
+      enum StreamState { ssClosed, ssConnecting, ssOpen, ssFailed };
+
+      struct Stream
+      {
+         std::string target;
+         StreamType type;
+         StreamState state;
+
+         IPaddress host;
+         int port;
+
+         FDStreamBuff* buff;
+         RecordFramer* framer;
+         unsigned output;
+
+         double retryAt;
+         double lastData;
+         unsigned long bytes;
+         unsigned long connects;
+
+         // Totals at the last report
+         unsigned long reportBytes;
+         unsigned long reportRecords;
+      };
+
+      void open(Stream& s);
+      void close(Stream& s, const std::string& why);
+      void read(Stream& s);
+      void connected(Stream& s);
+      bool watch(Stream& s, int op, unsigned events);
+
+      AsyncFileWriter& writer;
+      std::vector<Stream*> streams;
+      int epfd;
+
+      std::vector<char> readBuffer;
+      std::string records;
+      double lastReport;
+
+      static volatile sig_atomic_t stopRequested;
+   };
+
+} // end of namespace
+#endif
@@ -0,0 +1,228 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2007, The University of Texas at Austin
+//
+//============================================================================
+
+#include <cstring>
+#include <algorithm>
+
+#include <BinUtils.hpp>
+#include <StringUtils.hpp>
+
+#include "RecordFramer.hpp"
+
+using namespace std;
+
+namespace gpstk
+{
+   namespace
+   {
+      // The MDP header, see MDPHeader.hpp
+      const unsigned mdpHeaderLength = 16;
+      const unsigned mdpMaxLength = 1024;
+
+      const char ashtechPreamble[] = "$PASHR,";
+      const size_t ashtechPreambleLength = 7;
+      const char ashtechTerminator[] = "\015\012$PASHR,";
+      const size_t ashtechTerminatorLength = 9;
+
+      // Longer than this and we give up on finding the end of a message
+      const size_t ashtechMaxLength = 65536;
+
+      // OEM4 32 bit crc, as computed in NovatelData
+      const BinUtils::CRCParam novatelCRC(32, 0x4c11db7, 0, 0,
+                                          true, true, true);
+   }
+
+
+   unsigned RecordFramer::add(const char* data, size_t n, string& out)
+   {
+      buffer.append(data, n);
+
+      unsigned found = 0;
+      while (start < buffer.size())
+      {
+         long r = frame((const unsigned char*)buffer.data() + start,
+                        buffer.size() - start);
+         if (r > 0)
+         {
+            out.append(buffer, start, r);
+            start += r;
+            records++;
+            found++;
+         }
+         else if (r < 0)
+         {
+            start += -r;
+            skippedBytes += -r;
+         }
+         else
+            break;
+      }
+
+      // Only move the leftover down when it's worth it
+      if (start == buffer.size())
+      {
+         buffer.clear();
+         start = 0;
+      }
+      else if (start > 4096 && start > buffer.size()/2)
+      {
+         buffer.erase(0, start);
+         start = 0;
+      }
+
+      return found;
+   }
+
+
+   RecordFramer* RecordFramer::create(const string& format)
+   {
+      string f = StringUtils::lowerCase(format);
+      if (f == "mdp")
+         return new MDPFramer;
+      if (f == "ashtech")
+         return new AshtechFramer;
+      if (f == "novatel")
+         return new NovatelFramer;
+      if (f == "raw")
+         return new RawFramer;
+      return NULL;
+   }
+
+
+   long MDPFramer::frame(const unsigned char* p, size_t n)
+   {
+      if (n < 2)
+         return 0;
+
+      if (p[0] != 0x9c || p[1] != 0x9c)
+      {
+         const void* q = memchr(p+1, 0x9c, n-1);
+         return q ? -((const unsigned char*)q - p) : -long(n);
+      }
+
+      if (n < mdpHeaderLength)
+         return 0;
+
+      // The same sanity checks as MDPHeader::decode()
+      unsigned id = (p[2] << 8) | p[3];
+      unsigned length = (p[4] << 8) | p[5];
+      if (length < mdpHeaderLength || length > mdpMaxLength || id > 1024)
+         return -1;
+
+      if (n < length)
+         return 0;
+
+      // The crc is computed with its own field zeroed
+      unsigned short crc = (p[14] << 8) | p[15];
+      scratch.assign((const char*)p, length);
+      scratch[14] = scratch[15] = 0;
+      const unsigned char* s = (const unsigned char*)scratch.data();
+      if (BinUtils::computeCRC(s, length, BinUtils::CRCCCITT) == crc ||
+          BinUtils::computeCRC(s, length, BinUtils::CRC16) == crc)
+         return length;
+
+      return -1;
+   }
+
+
+   long AshtechFramer::frame(const unsigned char* p, size_t n)
+   {
+      const char* c = (const char*)p;
+
+      if (n < ashtechPreambleLength)
+         return memcmp(c, ashtechPreamble, n) ? -1 : 0;
+
+      if (memcmp(c, ashtechPreamble, ashtechPreambleLength))
+      {
+         const char* q = search(c+1, c+n, ashtechPreamble,
+                                ashtechPreamble + ashtechPreambleLength);
+         if (q < c+n)
+            return -(q - c);
+            // keep what could be the start of a preamble
+         return -long(n - ashtechPreambleLength + 1);
+      }
+
+      const char* q = search(c + ashtechPreambleLength, c+n, ashtechTerminator,
+                             ashtechTerminator + ashtechTerminatorLength);
+      if (q < c+n)
+         return (q - c) + 2;
+
+      if (n > ashtechMaxLength)
+         return -1;
+
+      return 0;
+   }
+
+
+   long NovatelFramer::frame(const unsigned char* p, size_t n)
+   {
+      if (n < 3)
+         return (p[0] == 0xaa && (n < 2 || p[1] == 0x44)) ? 0 : -1;
+
+      if (p[0] != 0xaa || p[1] != 0x44 || (p[2] != 0x11 && p[2] != 0x12))
+      {
+         const void* q = memchr(p+1, 0xaa, n-1);
+         return q ? -((const unsigned char*)q - p) : -long(n);
+      }
+
+      if (p[2] == 0x11)
+      {
+         // OEM2: the length, header included, is at byte 8
+         if (n < 12)
+            return 0;
+         unsigned long size = p[8] | (p[9] << 8) | (p[10] << 16)
+            | ((unsigned long)p[11] << 24);
+         if (size < 12 || size - 12 >= 1024)
+            return -1;
+         if (n < size)
+            return 0;
+
+         unsigned char checksum = p[0] ^ p[1] ^ p[2];
+         for (unsigned long i=4; i<size; i++)
+            checksum ^= p[i];
+         return checksum == p[3] ? long(size) : -1;
+      }
+
+      // OEM4: header length at byte 3, message length at byte 8, and a
+      // 32 bit crc after the message
+      if (n < 10)
+         return 0;
+      unsigned long headerLength = p[3];
+      unsigned long messageLength = p[8] | (p[9] << 8);
+      if (headerLength < 10)
+         return -1;
+      unsigned long size = headerLength + messageLength + 4;
+      if (n < size)
+         return 0;
+
+      const unsigned char* c = p + size - 4;
+      unsigned long crc = c[0] | (c[1] << 8) | (c[2] << 16)
+         | ((unsigned long)c[3] << 24);
+      if (BinUtils::computeCRC(p, size - 4, novatelCRC) == crc)
+         return size;
+
+      return -1;
+   }
+
+} // end of namespace
@@ -0,0 +1,131 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2007, The University of Texas at Austin
+//
+//============================================================================
+
+#ifndef RECORDFRAMER_HPP
+#define RECORDFRAMER_HPP
+
+#include <string>
+
+namespace gpstk
+{
+   // Splits a byte stream into whole receiver records without blocking.
+   // Bytes are handed over as they arrive, in chunks of any size; only
+   // complete records come out, so a consumer never sees half a record.
+   // Bytes that don't belong to a record are dropped and counted. The
+   // framers don't decode anything, they only find the record boundaries
+   // and check the record's own CRC or checksum where it has one.
+   class RecordFramer
+   {
+   public:
+      RecordFramer() : records(0), skippedBytes(0), start(0)
+      {}
+
+      virtual ~RecordFramer()
+      {}
+
+      // Adds n bytes to the framer. The complete records found are
+      // appended to out. Returns the number of records appended.
+      unsigned add(const char* data, size_t n, std::string& out);
+
+      // Bytes received but not yet part of a complete record
+      size_t pending() const { return buffer.size() - start; }
+
+      // Forget any partial record, i.e. after a reconnect
+      void reset() { buffer.clear(); start = 0; }
+
+      virtual std::string getName() const = 0;
+
+      // Returns a new framer for the given format ("mdp", "ashtech",
+      // "novatel" or "raw"), or NULL if the format isn't known.
+      static RecordFramer* create(const std::string& format);
+
+      unsigned long records;       // complete records found
+      unsigned long skippedBytes;  // bytes dropped while looking for sync
+
+   protected:
+      // Looks at the n bytes at p. Returns the length of the complete
+      // record that starts at p, zero if more bytes are needed to tell,
+      // or minus the number of bytes to drop to get closer to the
+      // start of a record.
+      virtual long frame(const unsigned char* p, size_t n) = 0;
+
+   private:
+      std::string buffer;
+      size_t start;       // first unframed byte in buffer
+   };
+
+
+   // Passes every byte through, in the chunks it was received in.
+   class RawFramer : public RecordFramer
+   {
+   public:
+      virtual std::string getName() const { return "raw"; }
+
+   protected:
+      virtual long frame(const unsigned char* p, size_t n)
+      { return n; }
+   };
+
+
+   // MDP messages: 0x9c9c frame word, 16 byte header with the total
+   // length, CCITT (or CRC-16) crc over the whole message.
+   class MDPFramer : public RecordFramer
+   {
+   public:
+      virtual std::string getName() const { return "mdp"; }
+
+   protected:
+      virtual long frame(const unsigned char* p, size_t n);
+
+   private:
+      std::string scratch;
+   };
+
+
+   // Ashtech $PASHR messages. As in AshtechData::readBody(), a message
+   // ends at a CR LF that is followed by the next preamble, so the last
+   // message received is held until the next one starts.
+   class AshtechFramer : public RecordFramer
+   {
+   public:
+      virtual std::string getName() const { return "ashtech"; }
+
+   protected:
+      virtual long frame(const unsigned char* p, size_t n);
+   };
+
+
+   // Novatel binary messages, both OEM2 (0xaa 0x44 0x11, xor checksum)
+   // and OEM4 (0xaa 0x44 0x12, 32 bit crc).
+   class NovatelFramer : public RecordFramer
+   {
+   public:
+      virtual std::string getName() const { return "novatel"; }
+
+   protected:
+      virtual long frame(const unsigned char* p, size_t n);
+   };
+
+} // end of namespace
+#endif
@@ -141,6 +141,42 @@ namespace gpstk
 // Take a file handle (which is supposed to be a listening socket), accept
 // a connection if any, and return a TCPStreamBuff for that connection. On exit, 
 // peeraddr would be an addr of the connected peer.
+   int TCPStreamBuff::startConnect(const SocketAddr target_address)
+   {
+      if (is_open())
+         return 0;
+
+      handle = socket(AF_INET,SOCK_STREAM,0);
+      if (handle < 0)
+         return -1;
+
+      if (setBlocking(false))
+      {
+         close();
+         return -1;
+      }
+
+      if (::connect(handle, (sockaddr *)target_address,
+                    sizeof(target_address)) == 0)
+         return 0;
+      if (errno == EINPROGRESS)
+         return 1;
+
+      close();
+      return -1;
+   }
+
+
+   int TCPStreamBuff::finishConnect()
+   {
+      int err = 0;
+      socklen_t len = sizeof(err);
+      if (::getsockopt(handle, SOL_SOCKET, SO_ERROR, &err, &len))
+         return errno;
+      return err;
+   }
+
+
    int TCPStreamBuff::accept(int listening_socket, SocketAddr& peeraddr)
    {
       // do nothing if we are already connected
@@ -81,6 +81,16 @@ namespace gpstk
 
       int connect(const SocketAddr target_address);
 
+      // Starts connecting without waiting for the peer. Returns 0 if
+      // connected already, 1 if the connection is in progress (the socket
+      // becomes writable when it's done, then call finishConnect()), or
+      // -1 on error. The socket is left non-blocking.
+      int startConnect(const SocketAddr target_address);
+
+      // Returns 0 if the connection started by startConnect() succeeded,
+      // or the errno it failed with.
+      int finishConnect();
+
       // Take a file handle (which is supposed to be a listening socket), 
       // accept a connection if any,  and return the corresponding TCPbuf
       // for that connection. On exit, peeraddr would be an addr of the
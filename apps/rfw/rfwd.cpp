@@ -0,0 +1,241 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2007, The University of Texas at Austin
+//
+//============================================================================
+
+/** @file reads many streams at once and writes each to file(s) with names
+    derived from system time. rfw does the same for a single stream.
+ */
+
+#include <fstream>
+
+#include <signal.h>
+
+#include <StringUtils.hpp>
+#include <BasicFramework.hpp>
+#include <CommandOption.hpp>
+
+#include "IngestServer.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+extern "C" void stopHandler(int)
+{
+   IngestServer::requestStop();
+}
+
+
+class RollingFileDaemon : public gpstk::BasicFramework
+{
+public:
+   RollingFileDaemon(const std::string& applName) throw()
+      : BasicFramework(applName,
+                       "Reads data from many streams at once and writes each "
+                       "one out to a TimeNamedFileStream, whole records at a "
+                       "time."),
+        numStreams(0), server(writer)
+   {}
+
+
+   bool initialize(int argc, char *argv[]) throw()
+   {
+      CommandOptionWithAnyArg inputOpt(
+         'i', "input",
+         "A stream to record, as target[,format[,filespec]]. The target "
+         "can be a serial device (ser:/dev/ttyS0), a tcp port "
+         "(tcp:hostname:port) or a fifo. The format is mdp, ashtech, "
+         "novatel or raw and defaults to the -f value. The filespec "
+         "defaults to one derived from the target, i.e. "
+         "tcp_host_port_%03j_%04Y.raw. Repeat for each stream.");
+
+      CommandOptionWithAnyArg configOpt(
+         'c', "config",
+         "A file with one stream per line, as target format filespec "
+         "separated by spaces. Lines starting with # are ignored.");
+
+      CommandOptionWithAnyArg formatOpt(
+         'f', "format",
+         "The format of the streams that don't give one. The default is "
+         "raw, which writes the bytes as they come.");
+
+      CommandOptionWithNumberArg batchOpt(
+         'b', "batch-size",
+         "Bytes to collect per stream before handing them to the writer "
+         "thread. The default is 65536.");
+
+      CommandOptionWithAnyArg flushOpt(
+         'F', "flush-period",
+         "The longest time (in seconds) data waits before being handed to "
+         "the writer thread. The default is 1 second.");
+
+      CommandOptionWithNumberArg reportOpt(
+         'r', "report-period",
+         "The time (in seconds) between throughput reports. 0 turns them "
+         "off. The default is 60 seconds.");
+
+      CommandOptionWithNumberArg retryOpt(
+         'R', "retry-period",
+         "The time (in seconds) to wait before reopening a stream that "
+         "closed or couldn't be opened. The default is 10 seconds.");
+
+      formatOpt.setMaxCount(1);
+      batchOpt.setMaxCount(1);
+      flushOpt.setMaxCount(1);
+      reportOpt.setMaxCount(1);
+      retryOpt.setMaxCount(1);
+
+      if (!BasicFramework::initialize(argc,argv)) return false;
+
+      if (debugLevel)
+         cout << "debugLevel: " << debugLevel << endl
+              << "verboseLevel: " << verboseLevel << endl;
+
+      string defaultFormat = "raw";
+      if (formatOpt.getCount())
+         defaultFormat = formatOpt.getValue()[0];
+
+      if (batchOpt.getCount())
+         writer.setBatchSize(StringUtils::asInt(batchOpt.getValue()[0]));
+      if (flushOpt.getCount())
+         server.flushInterval = StringUtils::asDouble(flushOpt.getValue()[0]);
+      if (reportOpt.getCount())
+         server.reportInterval =
+            StringUtils::asDouble(reportOpt.getValue()[0]);
+      if (retryOpt.getCount())
+         server.retryInterval = StringUtils::asDouble(retryOpt.getValue()[0]);
+
+      server.debugLevel = debugLevel;
+      writer.debugLevel = debugLevel;
+
+      for (int i=0; i<inputOpt.getCount(); i++)
+      {
+         string spec = inputOpt.getValue()[i];
+         string target = StringUtils::word(spec, 0, ',');
+         string format = StringUtils::word(spec, 1, ',');
+         string filespec = StringUtils::word(spec, 2, ',');
+         if (!addStream(target, format.empty() ? defaultFormat : format,
+                        filespec))
+            return false;
+      }
+
+      for (int i=0; i<configOpt.getCount(); i++)
+      {
+         ifstream config(configOpt.getValue()[i].c_str());
+         if (!config)
+         {
+            cerr << "Could not open " << configOpt.getValue()[i] << endl;
+            return false;
+         }
+
+         string line;
+         while (getline(config, line))
+         {
+            StringUtils::strip(line);
+            if (line.empty() || line[0] == '#')
+               continue;
+            string format = StringUtils::word(line, 1);
+            if (!addStream(StringUtils::word(line, 0),
+                           format.empty() ? defaultFormat : format,
+                           StringUtils::word(line, 2)))
+               return false;
+         }
+      }
+
+      if (numStreams == 0)
+      {
+         cerr << "No streams to record." << endl;
+         return false;
+      }
+
+      return true;
+   }
+
+protected:
+   virtual void spinUp()
+   {
+      signal(SIGINT, stopHandler);
+      signal(SIGTERM, stopHandler);
+      signal(SIGPIPE, SIG_IGN);
+      writer.start();
+   }
+
+   virtual void process()
+   {
+      server.run();
+   }
+
+   virtual void shutDown()
+   {
+      writer.stop();
+      if (server.reportInterval > 0)
+         server.report(cout);
+   }
+
+private:
+   bool addStream(const string& target, const string& format,
+                  string filespec)
+   {
+      if (filespec.empty())
+      {
+         filespec = target;
+         for (size_t i=0; i<filespec.size(); i++)
+            if (filespec[i] == ':' || filespec[i] == '/')
+               filespec[i] = '_';
+         if (filespec[0] == '_')
+            filespec.erase(0, 1);
+         filespec += "_%03j_%04Y.raw";
+      }
+
+      if (debugLevel)
+         cout << "Recording " << target << " (" << format << ") to "
+              << filespec << endl;
+
+      if (!server.addStream(target, format, filespec))
+         return false;
+      numStreams++;
+      return true;
+   }
+
+   unsigned numStreams;
+
+   AsyncFileWriter writer;
+   IngestServer server;
+};
+
+
+int main(int argc, char *argv[])
+{
+   try
+   {
+      RollingFileDaemon rfwd(argv[0]);
+      if (!rfwd.initialize(argc, argv))
+         exit(0);
+      rfwd.run();
+   }
+   catch (gpstk::Exception &exc)
+   { cout << exc << endl; }
+   catch (std::exception &exc)
+   { cout << "Caught std::exception " << exc.what() << endl; }
+   catch (...)
+   { cout << "Caught unknown exception" << endl; }
+}
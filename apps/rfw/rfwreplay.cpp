@@ -0,0 +1,408 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2007, The University of Texas at Austin
+//
+//============================================================================
+
+/** @file replays captured receiver files over tcp, one port per file, so
+    rfw and rfwd can be tested on the loopback interface. Each client that
+    connects gets the file from its beginning.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <cstring>
+
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+
+#include <StringUtils.hpp>
+#include <BasicFramework.hpp>
+#include <CommandOption.hpp>
+
+#include "TCPStreamBuff.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+namespace
+{
+   double now()
+   {
+      struct timeval tv;
+      gettimeofday(&tv, NULL);
+      return tv.tv_sec + 1e-6 * tv.tv_usec;
+   }
+
+   volatile sig_atomic_t stopRequested = 0;
+}
+
+extern "C" void stopHandler(int)
+{
+   stopRequested = 1;
+}
+
+
+class ReplayServer : public gpstk::BasicFramework
+{
+public:
+   ReplayServer(const std::string& applName) throw()
+      : BasicFramework(applName,
+                       "Replays captured files over tcp, at a given rate, "
+                       "to whoever connects. File i is served on port "
+                       "port+i."),
+        basePort(4621), copies(1), rate(0), loop(false), exitWhenDone(false),
+        nextId(0), epfd(-1)
+   {}
+
+
+   ~ReplayServer()
+   {
+      for (size_t i=0; i<clients.size(); i++)
+         delete clients[i];
+      for (size_t i=0; i<listeners.size(); i++)
+         ::close(listeners[i].handle);
+      if (epfd >= 0)
+         ::close(epfd);
+   }
+
+
+   bool initialize(int argc, char *argv[]) throw()
+   {
+      CommandOptionWithNumberArg portOpt(
+         'p', "port",
+         "The first port to listen on. The default is 4621.");
+
+      CommandOptionWithNumberArg copiesOpt(
+         'n', "copies",
+         "Serve each file on this many ports, to test many streams at "
+         "once. The default is 1.");
+
+      CommandOptionWithNumberArg rateOpt(
+         'r', "rate",
+         "Bytes per second to send to each client. The default, 0, sends "
+         "as fast as the client takes them.");
+
+      CommandOptionNoArg loopOpt(
+         'l', "loop",
+         "Start over at the end of the file instead of closing the "
+         "connection.");
+
+      CommandOptionNoArg exitOpt(
+         'x', "exit",
+         "Exit once every port has served its file once.");
+
+      CommandOptionRest filesOpt("Files to replay.");
+
+      portOpt.setMaxCount(1);
+      copiesOpt.setMaxCount(1);
+      rateOpt.setMaxCount(1);
+
+      if (!BasicFramework::initialize(argc,argv)) return false;
+
+      if (portOpt.getCount())
+         basePort = StringUtils::asInt(portOpt.getValue()[0]);
+      if (copiesOpt.getCount())
+         copies = StringUtils::asInt(copiesOpt.getValue()[0]);
+      if (rateOpt.getCount())
+         rate = StringUtils::asDouble(rateOpt.getValue()[0]);
+      loop = loopOpt.getCount() > 0;
+      exitWhenDone = exitOpt.getCount() > 0;
+
+      for (int i=0; i<filesOpt.getCount(); i++)
+      {
+         ifstream in(filesOpt.getValue()[i].c_str(), ios::in|ios::binary);
+         if (!in)
+         {
+            cerr << "Could not open " << filesOpt.getValue()[i] << endl;
+            return false;
+         }
+         ostringstream oss;
+         oss << in.rdbuf();
+         files.push_back(oss.str());
+      }
+
+      if (files.empty())
+      {
+         cerr << "No files to replay." << endl;
+         return false;
+      }
+
+      return true;
+   }
+
+protected:
+   virtual void spinUp()
+   {
+      signal(SIGINT, stopHandler);
+      signal(SIGTERM, stopHandler);
+      signal(SIGPIPE, SIG_IGN);
+
+      epfd = epoll_create(files.size() * copies + 1);
+
+      for (unsigned c=0; c<copies; c++)
+         for (size_t f=0; f<files.size(); f++)
+         {
+            Listener l;
+            l.port = basePort + listeners.size();
+            l.file = f;
+            l.served = 0;
+            l.handle = listen(l.port);
+            if (l.handle < 0)
+               exit(-1);
+            listeners.push_back(l);
+         }
+
+      for (size_t i=0; i<listeners.size(); i++)
+      {
+         struct epoll_event ev;
+         memset(&ev, 0, sizeof(ev));
+         ev.events = EPOLLIN;
+         ev.data.u64 = i;
+         epoll_ctl(epfd, EPOLL_CTL_ADD, listeners[i].handle, &ev);
+      }
+
+      if (verboseLevel)
+         cout << "Serving " << files.size() << " files on ports "
+              << basePort << " to " << basePort + listeners.size() - 1
+              << endl;
+   }
+
+
+   virtual void process()
+   {
+      // Clients are told apart from listeners by the top bit
+      const unsigned long long clientBit = 1ULL << 63;
+      struct epoll_event events[256];
+
+      while (!stopRequested)
+      {
+         if (exitWhenDone && clients.empty() && allServed())
+            break;
+
+         // With a rate, clients are fed on a 50 ms tick
+         int timeout = rate > 0 ? 50 : 1000;
+         int n = epoll_wait(epfd, events, 256, timeout);
+         if (n < 0 && errno != EINTR)
+            break;
+
+         for (int i=0; i<n; i++)
+         {
+            if (events[i].data.u64 & clientBit)
+            {
+               Client* c = findClient(events[i].data.u64 & ~clientBit);
+               if (c)
+                  send(*c);
+            }
+            else
+               accept(events[i].data.u64, clientBit);
+         }
+
+         if (rate > 0)
+            for (size_t i=0; i<clients.size(); i++)
+               send(*clients[i]);
+
+         for (size_t i=0; i<clients.size(); )
+         {
+            if (clients[i]->done)
+            {
+               if (verboseLevel)
+                  cout << "Sent " << clients[i]->sent << " bytes on port "
+                       << listeners[clients[i]->listener].port << endl;
+               delete clients[i];
+               clients.erase(clients.begin() + i);
+            }
+            else
+               i++;
+         }
+      }
+   }
+
+private:
+   struct Listener
+   {
+      int port;
+      int handle;
+      size_t file;
+      unsigned served;
+   };
+
+   struct Client
+   {
+      unsigned long long id;
+      size_t listener;
+      TCPStreamBuff buff;
+      const string* data;
+      size_t offset;
+      unsigned long sent;
+      double start;
+      bool done;
+   };
+
+   int listen(int port)
+   {
+      int s = ::socket(AF_INET, SOCK_STREAM, 0);
+      int value = 1;
+      ::setsockopt(s, SOL_SOCKET, SO_REUSEADDR, (char*)&value, sizeof(value));
+
+      IPaddress any;
+      SocketAddr server(any, port);
+      if (::bind(s, (sockaddr *)server, sizeof(sockaddr)) ||
+          ::listen(s, 5))
+      {
+         cerr << "Couldn't listen on port " << port
+              << " (" << strerror(errno) << ")" << endl;
+         ::close(s);
+         return -1;
+      }
+      return s;
+   }
+
+
+   void accept(size_t l, unsigned long long clientBit)
+   {
+      Client* c = new Client;
+      IPaddress any;
+      SocketAddr peer(any, 0);
+      c->buff.accept(listeners[l].handle, peer);
+      if (!c->buff.is_open())
+      {
+         delete c;
+         return;
+      }
+
+      if (verboseLevel)
+         cout << "Connection from " << peer << " on port "
+              << listeners[l].port << endl;
+
+      c->id = nextId++;
+      c->listener = l;
+      c->data = &files[listeners[l].file];
+      c->offset = 0;
+      c->sent = 0;
+      c->start = now();
+      c->done = false;
+      c->buff.setBlocking(false);
+      listeners[l].served++;
+
+      if (rate <= 0)
+      {
+         struct epoll_event ev;
+         memset(&ev, 0, sizeof(ev));
+         ev.events = EPOLLOUT;
+         ev.data.u64 = c->id | clientBit;
+         epoll_ctl(epfd, EPOLL_CTL_ADD, c->buff.handle, &ev);
+      }
+
+      clients.push_back(c);
+   }
+
+
+   Client* findClient(unsigned long long id)
+   {
+      for (size_t i=0; i<clients.size(); i++)
+         if (clients[i]->id == id)
+            return clients[i];
+      return NULL;
+   }
+
+
+   void send(Client& c)
+   {
+      if (c.done)
+         return;
+
+      size_t n = 65536;
+      if (rate > 0)
+      {
+         double allowed = rate * (now() - c.start) - c.sent;
+         if (allowed < 1)
+            return;
+         if (allowed < n)
+            n = size_t(allowed);
+      }
+
+      if (n > c.data->size() - c.offset)
+         n = c.data->size() - c.offset;
+
+      ssize_t w = ::write(c.buff.handle, c.data->data() + c.offset, n);
+      if (w < 0)
+      {
+         if (errno != EAGAIN && errno != EINTR)
+            c.done = true;
+         return;
+      }
+
+      c.offset += w;
+      c.sent += w;
+      if (c.offset == c.data->size())
+      {
+         if (loop)
+            c.offset = 0;
+         else
+            c.done = true;
+      }
+   }
+
+
+   bool allServed() const
+   {
+      for (size_t i=0; i<listeners.size(); i++)
+         if (listeners[i].served == 0)
+            return false;
+      return true;
+   }
+
+   int basePort;
+   unsigned copies;
+   double rate;
+   bool loop;
+   bool exitWhenDone;
+
+   vector<string> files;
+   vector<Listener> listeners;
+   vector<Client*> clients;
+   unsigned long long nextId;
+   int epfd;
+};
+
+
+int main(int argc, char *argv[])
+{
+   try
+   {
+      ReplayServer rs(argv[0]);
+      if (!rs.initialize(argc, argv))
+         exit(0);
+      rs.run();
+   }
+   catch (gpstk::Exception &exc)
+   { cout << exc << endl; }
+   catch (std::exception &exc)
+   { cout << "Caught std::exception " << exc.what() << endl; }
+   catch (...)
+   { cout << "Caught unknown exception" << endl; }
+}
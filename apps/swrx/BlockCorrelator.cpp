@@ -0,0 +1,171 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+#include <math.h>
+#include <algorithm>
+
+#include "icd_200_constants.hpp"
+
+#include "BlockCorrelator.hpp"
+
+using namespace std;
+
+const unsigned BlockCorrelator::carrierBits;
+const size_t BlockCorrelator::chunkSize;
+
+namespace
+{
+   // cos and sin of one cycle of the carrier
+   struct CarrierTable
+   {
+      enum {size = 1 << BlockCorrelator::carrierBits};
+      float cosine[size];
+      float sine[size];
+
+      CarrierTable()
+      {
+         for (int i=0; i<size; i++)
+         {
+            double a = 2.0 * gpstk::PI * i / size;
+            cosine[i] = cos(a);
+            sine[i] = sin(a);
+         }
+      }
+   };
+
+   const CarrierTable& carrierTable()
+   {
+      static const CarrierTable table;
+      return table;
+   }
+
+   // A phase in cycles as a fraction of a cycle in 32 bits
+   uint32_t fixedPhase(double cycles)
+   {
+      double f = (cycles - floor(cycles)) * 4294967296.0;
+      if (f >= 4294967296.0)
+         return 0;
+      return static_cast<uint32_t>(f);
+   }
+}
+
+
+BlockCorrelator::BlockCorrelator(const vector<unsigned>& delays)
+   : delays(delays), maxDelay(0), primed(false),
+     mI(chunkSize), mQ(chunkSize),
+     sums(delays.size()), inSumSq(0)
+{
+   for (size_t k=0; k<delays.size(); k++)
+      maxDelay = max(maxDelay, delays[k]);
+   codeBuf.resize(maxDelay + chunkSize);
+   carrierTable();
+}
+
+
+void BlockCorrelator::dump() throw()
+{
+   for (size_t k=0; k<sums.size(); k++)
+      sums[k] = complex<double>(0,0);
+   inSumSq = 0;
+}
+
+
+void BlockCorrelator::process(const complex<float>* in, const float* code,
+                              size_t n, double carrierPhase,
+                              double carrierStep)
+   throw()
+{
+   if (n == 0)
+      return;
+
+   // Until there is a history the delayed taps see the first code value
+   if (!primed)
+   {
+      fill(codeBuf.begin(), codeBuf.begin() + maxDelay, code[0]);
+      primed = true;
+   }
+
+   const CarrierTable& ct = carrierTable();
+   const unsigned shift = 32 - carrierBits;
+   const uint32_t half = uint32_t(1) << (shift - 1);
+   uint32_t phase = fixedPhase(carrierPhase);
+   const uint32_t step = fixedPhase(carrierStep);
+
+   while (n > 0)
+   {
+      const size_t m = min(n, chunkSize);
+      float* cb = &codeBuf[maxDelay];
+      copy(code, code + m, cb);
+
+      // Wipe off the carrier, multiplying by its conjugate
+      float power = 0;
+      for (size_t i=0; i<m; i++)
+      {
+         const uint32_t j = (phase + half) >> shift;
+         const float c = ct.cosine[j];
+         const float s = ct.sine[j];
+         const float I = in[i].real();
+         const float Q = in[i].imag();
+         mI[i] = I*c + Q*s;
+         mQ[i] = Q*c - I*s;
+         power += I*I + Q*Q;
+         phase += step;
+      }
+      inSumSq += power;
+
+      // And correlate against each delayed code
+      for (size_t k=0; k<delays.size(); k++)
+      {
+         const float* dc = cb - delays[k];
+         float sI0=0, sI1=0, sI2=0, sI3=0;
+         float sQ0=0, sQ1=0, sQ2=0, sQ3=0;
+         size_t i=0;
+         for (; i+4<=m; i+=4)
+         {
+            sI0 += mI[i]   * dc[i];
+            sI1 += mI[i+1] * dc[i+1];
+            sI2 += mI[i+2] * dc[i+2];
+            sI3 += mI[i+3] * dc[i+3];
+            sQ0 += mQ[i]   * dc[i];
+            sQ1 += mQ[i+1] * dc[i+1];
+            sQ2 += mQ[i+2] * dc[i+2];
+            sQ3 += mQ[i+3] * dc[i+3];
+         }
+         for (; i<m; i++)
+         {
+            sI0 += mI[i] * dc[i];
+            sQ0 += mQ[i] * dc[i];
+         }
+         sums[k] += complex<double>((sI0 + sI1) + (sI2 + sI3),
+                                    (sQ0 + sQ1) + (sQ2 + sQ3));
+      }
+
+      // Keep the end of the code as the history for the next chunk
+      copy(cb + m - maxDelay, cb + m, codeBuf.begin());
+
+      in += m;
+      code += m;
+      n -= m;
+   }
+}
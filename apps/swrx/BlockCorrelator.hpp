@@ -0,0 +1,94 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+#ifndef BLOCKCORRELATOR_HPP
+#define BLOCKCORRELATOR_HPP
+
+#include <cstddef>
+#include <complex>
+#include <vector>
+
+#include <gpstkplatform.h>
+
+//-----------------------------------------------------------------------------
+// A bank of correlators that share one carrier wipe off and work on a block
+// of samples at a time. Each correlator (tap) sees the code delayed by its
+// own number of samples, so early, prompt and late come out of one pass.
+//
+// The carrier comes from a table indexed by a fixed point phase, and the
+// sums are made in float in short runs and then added into double, with
+// the inner loops kept simple enough for the compiler to vectorize them.
+//-----------------------------------------------------------------------------
+class BlockCorrelator
+{
+public:
+   /// param delays the number of samples to delay the code by, one entry
+   /// per tap
+   BlockCorrelator(const std::vector<unsigned>& delays);
+
+   /// Correlate a block of samples.
+   /// param in the samples
+   /// param code the code replica for each sample, +1 or -1
+   /// param n the number of samples
+   /// param carrierPhase the carrier phase for the first sample, in cycles
+   /// param carrierStep the carrier phase change per sample, in cycles
+   void process(const std::complex<float>* in, const float* code,
+                std::size_t n, double carrierPhase, double carrierStep)
+      throw();
+
+   /// Zero the sums. The code history is kept, as the delay line of a
+   /// SimpleCorrelator is.
+   void dump() throw();
+
+   /// The sum for tap k since the last dump
+   std::complex<double> operator[](std::size_t k) const throw()
+   {return sums[k];}
+
+   /// The sum of the power of the input since the last dump
+   double getInSumSq() const throw() {return inSumSq;}
+
+   std::size_t size() const throw() {return delays.size();}
+
+   /// The carrier table has 2^carrierBits entries
+   static const unsigned carrierBits = 12;
+
+private:
+   /// Number of samples done in float before adding into the sums
+   static const std::size_t chunkSize = 1024;
+
+   std::vector<unsigned> delays;
+   unsigned maxDelay;
+
+   // The last maxDelay code values followed by the current chunk
+   std::vector<float> codeBuf;
+   bool primed;
+
+   // The input with the carrier removed
+   std::vector<float> mI, mQ;
+
+   std::vector< std::complex<double> > sums;
+   double inSumSq;
+};
+
+#endif
@@ -138,6 +138,37 @@ void CCReplica::tick() throw()
 }
 
 
+void CCReplica::tick(size_t n, float* code,
+                     double& carrierStart, double& carrierStep) throw()
+{
+   const double codePhaseDelta = chipsPerTick + codeFreqOffset;
+   const double carrierUpdate = cyclesPerTick + carrierFreqOffset;
+   carrierStep = carrierUpdate;
+
+   // The code generator only needs to be asked when the chip changes
+   float chip = getCode() ? 1 : -1;
+   for (size_t i=0; i<n; i++)
+   {
+      localTime += tickSize;
+
+      codePhase += codePhaseDelta;
+      codePhaseOffset += codeFreqOffset;
+      if (codePhase >= 1)
+      {
+         wrapCode();
+         chip = getCode() ? 1 : -1;
+      }
+      code[i] = chip;
+
+      carrierPhase += carrierUpdate;
+      carrierPhaseOffset += carrierFreqOffset;
+      wrapCarrier();
+      if (i==0)
+         carrierStart = carrierPhase;
+   }
+}
+
+
 void CCReplica::wrapCode()
 {
    if (codePhase<1)
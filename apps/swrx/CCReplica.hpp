@@ -25,6 +25,7 @@
 #ifndef CCREPLICA_HPP
 #define CCREPLICA_HPP
 
+#include <cstddef>
 #include <complex>
 #include <iostream>
 
@@ -61,6 +62,12 @@ public:
    // tick size
    virtual void tick() throw();
 
+   // Move forward n ticks, writing the code for each tick (+1 or -1) to
+   // code. carrierStart is the carrier phase for the first of them and
+   // carrierStep the change per tick, both in cycles.
+   virtual void tick(std::size_t n, float* code,
+                     double& carrierStart, double& carrierStep) throw();
+
    // get the current code & carrier state
    virtual int getCode() {return **codeGenPtr;};  // zero or one
    virtual std::complex<double> getCarrier(); //value between -1 and 1
@@ -27,6 +27,21 @@
 using namespace gpstk;
 using namespace std;
 
+namespace
+{
+   // Code delays of the early, prompt and late correlators, in ticks. The
+   // delay line of the SimpleCorrelator these replace held one more tick
+   // than its delay, which is kept here.
+   vector<unsigned> eplDelays(unsigned spacing)
+   {
+      vector<unsigned> d(3);
+      d[0] = 2*spacing + 1;
+      d[1] = spacing + 1;
+      d[2] = 1;
+      return d;
+   }
+}
+
 /// param localReplica the code/carrier that this object is to track
 /// param codeSpacing the correlator spacing (in sec) that will be used for 
 /// the code. This class will quantize this value to the closest number
@@ -38,12 +53,10 @@ EMLTracker::EMLTracker(CCReplica& localReplica, double codeSpacing) :
    dllError(0), dllAlpha(/*6*/3), dllBeta(/*0.01*/0.005),
    iadCount(0), nav(false), baseGain(1.0/(0.1767*1.404)),
    inSumSq(0), lrSumSq(0),iadThreshold(0.02),
-   dllMode(dmFar), pllMode(pmUnlocked), navChange(true), prevNav(true),periodCount(10),prn(0)
+   dllMode(dmFar), pllMode(pmUnlocked), navChange(true), prevNav(true),periodCount(10),prn(0),
+   correlator(eplDelays(
+                 static_cast<unsigned>(codeSpacing / localReplica.tickSize)))
 {
-   early.setDelay(2*eplSpacing);
-   prompt.setDelay(eplSpacing);
-   late.setDelay(0);
-
    // Since our 'prompt' code is really a late code we should really advance 
    // our local replica by this amount but not have it count as part of our
    // code phase offset.
@@ -62,77 +75,77 @@ EMLTracker::EMLTracker(CCReplica& localReplica, double codeSpacing) :
 
 bool EMLTracker::process(complex<double> in)
 {
-      //if(periodCount%10 == 0)
-      //{
-      integrate(in);
-         //}
-         //else if(periodCount%10 != 0)
-         //periodCount++;
-
-   if (++iadCount == iadCountMax)
+   complex<float> s(in.real(), in.imag());
+   bool dumped;
+   processBlock(&s, 1, dumped);
+   return dumped;
+}
+
+
+size_t EMLTracker::processBlock(const complex<float>* in, size_t n,
+                                bool& dumped)
+{
+   // Don't integrate past the end of this period
+   n = min(n, static_cast<size_t>(iadCountMax - iadCount));
+   integrate(in, n);
+   iadCount += n;
+
+   dumped = iadCount == iadCountMax;
+   if (dumped)
    {
       updateLoop();
       // and dump our accumulators
-      early.dump();
-      prompt.dump();
-      late.dump();
+      correlator.dump();
       inSumSq = 0;
       lrSumSq = 0;
       iadCount=0;
-         //periodCount++;
-      return true;
    }
-   
-   
-
-   return false;
+   return n;
 }
 
 
-void EMLTracker::integrate(complex<double> in)
+void EMLTracker::integrate(const complex<float>* in, size_t n)
 {
-   localReplica.tick();
-      
-   // First bring the signal level of the input to the same as the
-   // local replicas
-   in *= baseGain;
-
-   complex<double> carrier = localReplica.getCarrier();
-   complex<double> code = localReplica.getCode() ? plusOne : minusOne;
-
-   // mix in the carrier local replica
-   complex<double> m0 = in * conj(carrier);
-
-   // and sum them up.. (yea, the conj of the codes should be a NoOp)
-   code = conj(code);
-   early.process(m0, code);
-   prompt.process(m0, code);
-   late.process(m0, code);
-
-   // Update our sums for normalizing things...
-   complex<double> lr = conj(carrier) * code;
-   inSumSq += in.real()*in.real() + in.imag()*in.imag();
-   lrSumSq += lr.real()*lr.real() + lr.imag()*lr.imag();
+   if (n == 0)
+      return;
+   if (code.size() < n)
+      code.resize(n);
+
+   double carrierPhase, carrierStep;
+   localReplica.tick(n, &code[0], carrierPhase, carrierStep);
+
+   // Mix in the carrier local replica and sum against the codes
+   correlator.process(in, &code[0], n, carrierPhase, carrierStep);
+
+   // Update our sums for normalizing things. The input is brought to the
+   // signal level of the local replicas, whose power is one per tick.
+   inSumSq = correlator.getInSumSq() * baseGain * baseGain;
+   lrSumSq += n;
 }
 
 
 void EMLTracker::updateLoop()
 {
+   // Bring the sums to the signal level of the local replicas
+   const complex<double> early = correlator[0] * baseGain;
+   const complex<double> prompt = correlator[1] * baseGain;
+   const complex<double> late = correlator[2] * baseGain;
+
    sqrtSumSq = sqrt(inSumSq*lrSumSq);
 
-   emag = abs(early()) / sqrtSumSq;
-   pmag = abs(prompt()) / sqrtSumSq;
-   lmag = abs(late()) / sqrtSumSq;
+   emag = abs(early) / sqrtSumSq;
+   pmag = abs(prompt) / sqrtSumSq;
+   lmag = abs(late) / sqrtSumSq;
 
-   pI = prompt().real();
-   pQ = prompt().imag();
+   pI = prompt.real();
+   pQ = prompt.imag();
 
    snr= 10*log10(pmag*pmag/localReplica.tickSize);
 
    dllError = lmag - emag;
-   pllError = atan(prompt().imag() / prompt().real()) / PI;
+   pllError = atan(prompt.imag() / prompt.real()) / PI;
 
-   promptPhase =atan2(prompt().imag(), prompt().real()) / PI;
+   promptPhase =atan2(prompt.imag(), prompt.real()) / PI;
 
    DllMode oldDllMode=dllMode;
    // Do we have any idea where the peak may lie?
@@ -152,7 +165,7 @@ void EMLTracker::updateLoop()
 
    // At this point all that is left on the inphase is the nav data
    prevNav = nav;
-   nav = prompt().real() > 0;
+   nav = prompt.real() > 0;
    if(prevNav != nav)
    {
      navChange = true;
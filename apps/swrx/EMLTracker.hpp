@@ -29,11 +29,12 @@
 #include <complex>
 #include <iostream>
 #include <list>
+#include <vector>
 
 #include "icd_200_constants.hpp"
 
 #include "CCReplica.hpp"
-#include "SimpleCorrelator.hpp"
+#include "BlockCorrelator.hpp"
 #include "complex_math.h"
 
 
@@ -53,6 +54,18 @@ public:
    // It returns true when a dump was performed
    virtual bool process(std::complex<double> s) = 0;
 
+   // Process up to n samples, stopping after a dump. Returns the number
+   // of samples used, and sets dumped when the last of them caused a dump.
+   virtual std::size_t processBlock(const std::complex<float>* in,
+                                    std::size_t n, bool& dumped)
+   {
+      dumped = false;
+      std::size_t i=0;
+      while (i<n && !dumped)
+         dumped = process(in[i++]);
+      return i;
+   }
+
    CCReplica& localReplica;
 };
 
@@ -74,6 +87,9 @@ public:
 
    virtual bool process(std::complex<double> in);
 
+   virtual std::size_t processBlock(const std::complex<float>* in,
+                                    std::size_t n, bool& dumped);
+
    void dump(std::ostream& s, int detail=0) const;
 
    double pllAlpha, pllBeta, dllAlpha, dllBeta;
@@ -101,7 +117,7 @@ public:
    unsigned getIntegrateCount() const {return iadCount;}
    
 private:
-   void integrate(std::complex<double> in);
+   void integrate(const std::complex<float>* in, std::size_t n);
    void updateLoop();
 
    double pllError, dllError, promptPhase;
@@ -113,7 +129,9 @@ private:
    bool prevNav;
   
 
-   SimpleCorrelator<double> early, prompt, late;
+   // The early, prompt and late correlators, in that order
+   BlockCorrelator correlator;
+   std::vector<float> code;
    double emag, pmag, lmag, pI, pQ;
 
    // These are used to normalize the correlator counts
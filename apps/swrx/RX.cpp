@@ -612,7 +612,14 @@ void *Cfunction(void* p)
 
    while(index < bufferSize + 1) // number of data points to track before join.
    {
-      if (tr->process(b->arr[index]))
+      // Run the tracker up to its next dump, leaving index and dp at the
+      // last sample it used
+      bool dumped;
+      int used = tr->processBlock(&b->arr[index], bufferSize + 1 - index,
+                                  dumped);
+      index += used - 1;
+      dp += used - 1;
+      if (dumped)
       {
          if(v)
             tr->dump(cout);
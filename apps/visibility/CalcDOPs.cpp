@@ -118,13 +118,13 @@
 #include "FileFilterFrame.hpp"
 #include "DayTime.hpp"
 #include "StringUtils.hpp"
-#include "Matrix.hpp"
 #include "Position.hpp"
 #include "Stats.hpp"
 #include "WGS84Geoid.hpp"
 #include "icd_200_constants.hpp"
 #include "geometry.hpp"
 #include "GPSEphemerisStore.hpp"
+#include "CoverageEngine.hpp"
 
 using namespace std;
 using namespace gpstk;
@@ -187,15 +187,10 @@ WGS84Geoid WGS84;
 double dlon;                  // dlon is the spacing in lon on the equator
 vector<int> Sats;             // satellite PRNs available in the AlmOrbit map aomap
 Xvt SVPVT;                    // satellite info used to calculate SV position
-Position SV;                  // dummy variable for satellite position
-vector<Position> SVs;         // satellite position array used for each time step;
+vector<Triple> SVs;           // satellite position array used for each time step;
                               // a SV is added to SVs if it's valid
-class M4 : public Matrix<double> // trick to declare a 4x4 double array of Matrix
-{
-public:
-  M4() : Matrix<double>(4,4) {};
-};
-vector<M4> Rmat; // vector of XYZ->UENT coordinate transform 4x4 matrices
+CoverageEngine Coverage;      // the grid positions; computes DOPs for all at once
+vector<CoverageEngine::DOPs> GridDOPs; // DOPs of each grid position at a time step
 
 // time averaging
 
@@ -234,7 +229,7 @@ int WriteStatsFile(string filename);
 int OutputGrid(string filename);
 int DumpGrid(DayTime& tt, string filename);
 void BuildGrid(void);
-void ComputeDOPs(DayTime& tt, GridData& gd, vector<Position>& SVs, M4& R);
+void SaveDOPs(DayTime& tt, GridData& gd, CoverageEngine::DOPs& dops);
 
 //------------------------------------------------------------------------------------
 
@@ -418,6 +413,11 @@ try
       return -4;
    }
 
+   // set up the grid positions, with their XYZ->UEN transforms, once
+   Coverage.setElevationMask(5.0,false);       // TD Elevation limit input
+   for (i=0; i<Grid.size(); i++)
+      Coverage.addSite(Position(Grid[i].lat,Grid[i].lon,0.0,Position::Geodetic));
+
    // initialize storage of 'worsts' and 'peaks'
    IworstN = IworstG = IworstP = IworstH = IworstV = IworstT = -1; // indexes of worst Number and worst DOPs
    NtrofN  = NpeakG  = NpeakP  = NpeakH  = NpeakV  = NpeakT  =  0; // number of cells with DOP > 10, # with < 5 sats
@@ -454,14 +454,12 @@ try
           {
             continue;
           }
-          SV.setECEF(SVPVT.x[0],SVPVT.x[1],SVPVT.x[2]); // get SV position
-          SVs.push_back(SV);                            // add to the vector
+          SVs.push_back(SVPVT.x);                       // add SV position to the vector
         }
         else          // almanac mode
         {
           SVPVT = aomap[Sats[i]].svXvt(tt);
-          SV.setECEF(SVPVT.x[0],SVPVT.x[1],SVPVT.x[2]); // get SV position
-          SVs.push_back(SV);                            // add to the vector
+          SVs.push_back(SVPVT.x);                       // add SV position to the vector
         }
       }
 
@@ -470,26 +468,12 @@ try
       StepWorstG = StepWorstP = StepWorstH = StepWorstV = StepWorstT = 0.;
       StepWorstN = 10000.;
 
+      Coverage.setSatellites(SVs);  // compute DOPs at all grid positions
+      Coverage.computeDOPs(GridDOPs);
+
       for (i=0; i<Grid.size(); i++) // LOOP OVER GRID POSITIONS
       {
-        if ( j == 0 ) // set up grid position vector only on first time step
-        {
-          // transform XYZT to UENT: R*Vector(XYZT) = Vector(UENT)
-          double ca,sa,co,so;
-          Position Rx(Grid[i].lat,Grid[i].lon,0.0,Position::Geodetic); // grid position
-          ca = cos(Rx.geodeticLatitude()*DEG_TO_RAD);
-          sa = sin(Rx.geodeticLatitude()*DEG_TO_RAD);
-          co = cos(Rx.longitude()*DEG_TO_RAD);
-          so = sin(Rx.longitude()*DEG_TO_RAD);
-          M4 Rtemp;
-          Rtemp(0,0) = ca*co ; Rtemp(0,1) = ca*so ; Rtemp(0,2) = sa ; Rtemp(0,3) = 0.0;
-          Rtemp(1,0) = -so   ; Rtemp(1,1) = co    ; Rtemp(1,2) = 0.0; Rtemp(1,3) = 0.0;
-          Rtemp(2,0) = -sa*co; Rtemp(2,1) = -sa*so; Rtemp(2,2) = ca ; Rtemp(2,3) = 0.0;
-          Rtemp(3,0) = 0.0   ; Rtemp(3,1) = 0.0   ; Rtemp(3,2) = 0.0; Rtemp(3,3) = 1.0;
-          Rmat.push_back(Rtemp); // add this grid point's R matrix to the stack
-        }
-
-        ComputeDOPs(tt,Grid[i],SVs,Rmat[i]); // compute DOPs
+        SaveDOPs(tt,Grid[i],GridDOPs[i]);   // save DOPs computed for this point
 
         BadPDOP[i] = BadPDOP[i] + Grid[i].bdop; // adds up each grid pt.'s BDOP over all times
                                                 // BDOP for a single pt. is 0 or 1 for PDOP <= v. > 6
@@ -1339,58 +1323,31 @@ catch(Exception& e) { GPSTK_RETHROW(e); }
 
 //------------------------------------------------------------------------------------
 
-void ComputeDOPs(DayTime& tt, GridData& gd, vector<Position>& SVs, M4& R)
+void SaveDOPs(DayTime& tt, GridData& gd, CoverageEngine::DOPs& dops)
 {
 try
 {
-   int j,k,n,Nsvs;
-   double elev,rawrange;
-
-   Position Rx(gd.lat,gd.lon,0.0,Position::Geodetic); // grid position
-   gd.bdop = 0.;
-
-   Nsvs = SVs.size();
-
-   // construct direction cosine matrix and solution covariance
+   // DOPs were computed from the solution covariance in UENT
    // BlueBook vol 1 p 414  or  GPS 2ed (Misra & Enge) p 203
 
-   Matrix<double> DC(Nsvs,4), COV(4,4);
-   n = 0;                                     // number of visible SVs
-   for (j=0; j<Nsvs; j++)
-   {
-      elev = Rx.elevationGeodetic(SVs[j]);
-      if (elev <= 5.0) continue;              // TD Elevation limit input
-
-      rawrange = range(Rx,SVs[j]);            // geometric range
-
-      DC(n,0) = (Rx.X()-SVs[j].X())/rawrange; // direction cosines
-      DC(n,1) = (Rx.Y()-SVs[j].Y())/rawrange; // (G matrix of Misra & Enge)
-      DC(n,2) = (Rx.Z()-SVs[j].Z())/rawrange;
-      DC(n,3) = 1;
-
-      n++;                                    // increase counter for # visible SVs
-   }
+   gd.bdop = 0.;
 
-   // if there aren't 4 satellites, we can't go on
-   if (n < 4)
+   // if there aren't 4 satellites in a usable geometry, we can't go on
+   if (!dops.valid)
    {
-      lofs << "Inadequate visibility: grid " << Rx.printf("%5.1AN %5.1LE")
+      Position Rx(gd.lat,gd.lon,0.0,Position::Geodetic); // grid position
+      lofs << (dops.nsvs < 4 ? "Inadequate visibility" : "Singular geometry")
+           << ": grid " << Rx.printf("%5.1AN %5.1LE")
            << " time " << tt << endl;
       return;
    }
-   DC = Matrix<double>(DC,0,0,n,4);       // trim the unnecessary zeros
-
-   DC = DC * transpose(R);                // transform to UENT (G~ matrix)
-
-   COV = transpose(DC) * DC;              // (G~^T * G~)
-   COV = inverseSVD(COV);                 // (G~^T * G~)^-1
 
-   gd.vdop = ::sqrt(COV(0,0));            // pick off the various DOPs
-   gd.hdop = ::sqrt(COV(1,1) + COV(2,2));
-   gd.tdop = ::sqrt(COV(3,3));
-   gd.pdop = ::sqrt(COV(0,0) + COV(1,1) + COV(2,2));
-   gd.gdop = ::sqrt(COV(0,0) + COV(1,1) + COV(2,2) + COV(3,3));
-   gd.nsvs = n;
+   gd.vdop = dops.vdop;                   // pick off the various DOPs
+   gd.hdop = dops.hdop;
+   gd.tdop = dops.tdop;
+   gd.pdop = dops.pdop;
+   gd.gdop = dops.gdop;
+   gd.nsvs = dops.nsvs;
 
    if (gd.pdop > 6) { gd.bdop = gd.bdop + 1. ; } // def'n of BDOP
 }
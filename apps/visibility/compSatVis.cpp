@@ -45,6 +45,7 @@
 #include "GPSEphemerisStore.hpp"
 #include "icd_200_constants.hpp"
 #include "gps_constants.hpp"
+#include "CoverageEngine.hpp"
 
 // Project
 #include "VisSupport.hpp"
@@ -106,6 +107,10 @@ protected:
    SEMAlmanacStore SEMAlmStore;
 
    StaPosList stationPositions;
+
+     // The station positions again, in the order of stationPositions,
+     // to compute the elevations at all stations at once.
+   CoverageEngine coverage;
       
       // Storage for min, max , avg. statistics.  Storage is both by-SV 
       // and over the entire constellation
@@ -471,6 +476,9 @@ void compSatVis::process()
                                                          startT, 
                                                          includeStation, 
                                                          excludeStation );
+   StaPosList::const_iterator si;
+   for (si=stationPositions.begin();si!=stationPositions.end();++si)
+      coverage.addSite( Position(si->second), CoverageEngine::Geocentric );
    
       // Generate the header
    generateHeader( startT );
@@ -674,24 +682,30 @@ void compSatVis::computeVisibility( gpstk::DayTime currT )
    
    if (detailPrint) fprintf(logfp,"%s, ",currT.printf("%02H:%02M").c_str());
 
+      // Compute the elevations of the available SVs at all stations
+   vector<Triple> availPos;
+   for (PRNID=1;PRNID<=gpstk::MAX_PRN;++PRNID)
+      if (SVAvail[PRNID]) availPos.push_back(SVpos[PRNID]);
+   vector<double> elevations;
+   coverage.setSatellites( availPos );
+   coverage.computeElevations( elevations );
+
       // Now count number of Stations visible to each SV
    int maxNum = 0;
    int minNum = stationPositions.size() + 1; 
-   StaPosList::const_iterator splCI;
    DiscreteVisibleCounts& dvc0 = dvcList.find(0)->second;
    
+   size_t svNdx = 0;
    for (PRNID=1;PRNID<=gpstk::MAX_PRN;++PRNID)
    {
       if (!SVAvail[PRNID]) continue;
       int numVis = 0;
-      for (splCI =stationPositions.begin();
-           splCI!=stationPositions.end();
-           ++splCI)
+      for (size_t staNdx=0;staNdx<stationPositions.size();++staNdx)
       {
-         ECEF staPos = splCI->second;
-         double elv = staPos.elvAngle( SVpos[PRNID] );
+         double elv = elevations[staNdx*availPos.size() + svNdx];
          if (elv>=minimumElevationAngle) numVis++;
       }
+      svNdx++;
       if (detailPrint) fprintf(logfp,"   %2d,",numVis);
       if (numVis>maxNum) maxNum = numVis;
       if (numVis<minNum) minNum = numVis;
@@ -44,6 +44,7 @@
 #include "GPSEphemerisStore.hpp"
 #include "icd_200_constants.hpp"
 #include "gps_constants.hpp"
+#include "CoverageEngine.hpp"
 
 // Project
 #include "VisSupport.hpp"
@@ -109,6 +110,10 @@ protected:
 
    StaPosList stationPositions;
 
+     // The station positions again, in the order of stationPositions,
+     // to compute the elevations at all stations at once.
+   CoverageEngine coverage;
+
    typedef map<string,StaStats> StaStatsList;
    StaStatsList staStatsList;
    int epochCount;
@@ -481,6 +486,8 @@ void compStaVis::process()
    StaPosList::const_iterator vci;
    for (vci=stationPositions.begin();vci!=stationPositions.end();++vci)
    {
+       coverage.addSite( Position(vci->second), CoverageEngine::Geocentric );
+
        string name = (string) vci->first;
        StaStats temp = StaStats( name, maxSVCount, 0 );
        pair<string,StaStats> node( name, temp );
@@ -730,6 +737,21 @@ void compStaVis::computeVisibility( gpstk::DayTime currT )
       }
    }
    
+      // Compute the elevations of the available SVs at all stations
+   vector<Triple> availPos;
+   vector<int> availPRN;
+   for (PRNID=1;PRNID<=gpstk::MAX_PRN;++PRNID)
+   {
+      if (SVAvail[PRNID])
+      {
+         availPos.push_back(SVpos[PRNID]);
+         availPRN.push_back(PRNID);
+      }
+   }
+   vector<double> elevations;
+   coverage.setSatellites( availPos );
+   coverage.computeElevations( elevations );
+   
    if (detailPrint) fprintf(logfp,"%s ",currT.printf("T%04Y:%03j:%02H:%02M:%02S").c_str());
 
    string SVList;       // We'll build a list of SVs in view in this string
@@ -749,9 +771,10 @@ void compStaVis::computeVisibility( gpstk::DayTime currT )
    int maxNum = 0;
    int minNum = gpstk::MAX_PRN + 1; 
    StaPosList::const_iterator splCI;
+   size_t staNdx = 0;
    for (splCI =stationPositions.begin();
         splCI!=stationPositions.end();
-        ++splCI)
+        ++splCI, ++staNdx)
    {
       int numVis = 0;
       double elv = 0.0;
@@ -769,30 +792,29 @@ void compStaVis::computeVisibility( gpstk::DayTime currT )
 
       SVList = "";
       char SVform[10];
-      ECEF staPos = splCI->second;
-      for (PRNID=1;PRNID<=gpstk::MAX_PRN;++PRNID)
+      const double* staElv = availPRN.empty() ? 0 :
+                             &elevations[staNdx*availPRN.size()];
+      for (size_t k=0;k<availPRN.size();++k)
       {
-         if (SVAvail[PRNID])
+         PRNID = availPRN[k];
+         elv = staElv[k];
+         if (elv>=minimumElevationAngle)
          {
-            elv = staPos.elvAngle( SVpos[PRNID] );
-            if (elv>=minimumElevationAngle)
+            if (healthyOnly==0 ||
+               (healthyOnly!=0 && SVHealth[PRNID]==0))
+            {
+               numVis++;
+               ss.addToElvBins( elv );
+               sprintf(SVform," %02d",PRNID);
+               SVList += SVform;
+            }
+            else
             {
-               if (healthyOnly==0 ||
-                  (healthyOnly!=0 && SVHealth[PRNID]==0))
+               if (healthyOnly==2)
                {
-                  numVis++;
-                  ss.addToElvBins( elv );
-                  sprintf(SVform," %02d",PRNID);
+                  sprintf(SVform," %02d(HLTH)",PRNID);
                   SVList += SVform;
                }
-               else
-               {
-                  if (healthyOnly==2)
-                  {
-                     sprintf(SVform," %02d(HLTH)",PRNID);
-                     SVList += SVform;
-                  }
-               }
             }
          }
       }
@@ -0,0 +1,213 @@
+#pragma ident "$Id: $"
+
+/**
+* @file BatchOrbitPropagator.cpp
+* Propagates many initial states at once, on several threads.
+*/
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include "BatchOrbitPropagator.hpp"
+
+
+namespace gpstk
+{
+
+   namespace
+   {
+
+         // Propagates one state per item. An item takes a free propagator
+         // when it starts and gives it back when done; there are as many
+         // propagators as threads, so one is always free.
+      class PropagationTask : public ThreadPoolTask
+      {
+      public:
+
+         const std::vector<UTCTime>* utc0;
+         const std::vector< Vector<double> >* rv0;
+         double tf;
+
+         std::vector< Vector<double> >* rv;
+         std::vector< Matrix<double> >* phi;
+         std::vector<std::string>* errors;
+
+            // Propagators not used by any item right now
+         std::vector<SatOrbitPropagator*> freeList;
+
+#ifndef _WIN32
+         pthread_mutex_t freeMutex;
+
+         PropagationTask()
+         { pthread_mutex_init(&freeMutex, NULL); }
+
+         ~PropagationTask()
+         { pthread_mutex_destroy(&freeMutex); }
+#endif
+
+         SatOrbitPropagator* take()
+         {
+#ifndef _WIN32
+            pthread_mutex_lock(&freeMutex);
+#endif
+            SatOrbitPropagator* p( freeList.back() );
+            freeList.pop_back();
+#ifndef _WIN32
+            pthread_mutex_unlock(&freeMutex);
+#endif
+            return p;
+         }
+
+         void giveBack(SatOrbitPropagator* p)
+         {
+#ifndef _WIN32
+            pthread_mutex_lock(&freeMutex);
+#endif
+            freeList.push_back(p);
+#ifndef _WIN32
+            pthread_mutex_unlock(&freeMutex);
+#endif
+         }
+
+         virtual void process(size_t i)
+         {
+            SatOrbitPropagator* p( take() );
+
+            try
+            {
+               if( (*rv0)[i].size() < 6 )
+               {
+                  Exception e("The initial state must have 6 elements");
+                  GPSTK_THROW(e);
+               }
+
+               p->setInitState( (*utc0)[i], (*rv0)[i] );
+               p->integrateTo(tf);
+
+               (*rv)[i] = p->rvState();
+               (*phi)[i] = p->transitionMatrix();
+            }
+            catch(Exception& e)
+            {
+               (*errors)[i] = e.getText();
+            }
+            catch(...)
+            {
+               (*errors)[i] = "Unknown exception";
+            }
+
+            giveBack(p);
+         }
+
+      };  // End of class 'PropagationTask'
+
+   }  // End of anonymous namespace
+
+
+      // Constructor
+   BatchOrbitPropagator::BatchOrbitPropagator(unsigned int numThreads)
+      throw(Exception)
+      : pool(numThreads)
+   {
+      for(unsigned int k = 0; k < pool.size(); k++)
+      {
+         propagators.push_back(new SatOrbitPropagator());
+      }
+
+   }  // End of constructor 'BatchOrbitPropagator::BatchOrbitPropagator()'
+
+
+      // Default destructor
+   BatchOrbitPropagator::~BatchOrbitPropagator()
+   {
+      for(size_t k = 0; k < propagators.size(); k++)
+      {
+         delete propagators[k];
+      }
+      propagators.clear();
+   }
+
+
+      // set step size of the integrators
+   BatchOrbitPropagator& BatchOrbitPropagator::setStepSize(double step_size)
+   {
+      for(size_t k = 0; k < propagators.size(); k++)
+      {
+         propagators[k]->setStepSize(step_size);
+      }
+
+      return (*this);
+
+   }  // End of method 'BatchOrbitPropagator::setStepSize()'
+
+
+      /* Propagate each initial state to tf seconds after its epoch.
+       *
+       * @param utc0   epochs of the initial states
+       * @param rv0    initial states (position and velocity, J2000)
+       * @param tf     seconds to propagate each state
+       * @param rv     final states, J2000; one per initial state
+       * @param phi    6*6 state transition matrices, one per state
+       * @return       number of states that couldn't be propagated
+       */
+   int BatchOrbitPropagator::propagate(
+                                 const std::vector<UTCTime>& utc0,
+                                 const std::vector< Vector<double> >& rv0,
+                                 double tf,
+                                 std::vector< Vector<double> >& rv,
+                                 std::vector< Matrix<double> >& phi )
+      throw(Exception)
+   {
+      if(utc0.size() != rv0.size())
+      {
+         Exception e("The number of epochs and of initial states differ");
+         GPSTK_THROW(e);
+      }
+
+      const size_t n( rv0.size() );
+
+      rv.assign(n, Vector<double>());
+      phi.assign(n, Matrix<double>());
+      errors.assign(n, std::string());
+
+      PropagationTask task;
+      task.utc0 = &utc0;
+      task.rv0 = &rv0;
+      task.tf = tf;
+      task.rv = &rv;
+      task.phi = &phi;
+      task.errors = &errors;
+      task.freeList = propagators;
+
+         // Exceptions are caught inside the task, so this doesn't throw
+      pool.run(task, n);
+
+      int bad(0);
+      for(size_t i = 0; i < n; i++)
+      {
+         if( !errors[i].empty() ) bad++;
+      }
+
+      return bad;
+
+   }  // End of method 'BatchOrbitPropagator::propagate()'
+
+}  // End of namespace gpstk
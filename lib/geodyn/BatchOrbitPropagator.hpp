@@ -0,0 +1,155 @@
+#pragma ident "$Id: $"
+
+/**
+* @file BatchOrbitPropagator.hpp
+* Propagates many initial states at once, on several threads.
+*/
+
+#ifndef GPSTK_BATCH_ORBIT_PROPAGATOR_HPP
+#define GPSTK_BATCH_ORBIT_PROPAGATOR_HPP
+
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+#include <string>
+#include <vector>
+
+#include "ThreadPool.hpp"
+#include "SatOrbitPropagator.hpp"
+
+
+namespace gpstk
+{
+      /** @addtogroup GeoDynamics */
+      //@{
+
+      /**
+       * Batch Satellite Orbit Propagator
+       *
+       * Propagates a list of initial states, each from its own epoch, over
+       * the same time span, sharing the states among the threads of a
+       * ThreadPool. Every thread works with its own SatOrbitPropagator,
+       * so the force models (and their workspaces) are never shared; the
+       * Earth orientation parameters in IERS and the gravity coefficient
+       * tables are read by all of them. The JPL ephemeris and the MSISE00
+       * density model keep internal state, so their calls are serialized.
+       *
+       * The force models of all the threads must be set up the same way,
+       * before calling propagate(), and the IERS and JPL files must be
+       * loaded first too:
+       *
+       * IERS::loadIERSFile("InputData\\IERS\\finals.data");
+       * ReferenceFrames::setJPLEphFile("InputData\\DE405\\jplde405");
+       *
+       * BatchOrbitPropagator bop;    // one thread per processor
+       * bop.setStepSize(30.0);
+       * for(unsigned int k = 0; k < bop.getNumThreads(); k++)
+       * {
+       *    bop.getSatOrbitPointer(k)->enableGeopotential(SatOrbit::GM_EGM96,
+       *                                                  12, 12)
+       *                               .enableThirdBodyPerturbation(true,true);
+       * }
+       *
+       * std::vector<UTCTime> utc0;
+       * std::vector< Vector<double> > rv0, rv;
+       * std::vector< Matrix<double> > phi;
+       *   ... fill utc0 and rv0 ...
+       *
+       * int bad = bop.propagate(utc0, rv0, 3600.0*12, rv, phi);
+       *
+       * The results don't depend on the number of threads.
+       */
+   class BatchOrbitPropagator
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param numThreads number of threads to use; 0 means one per
+          *        processor.
+          */
+      BatchOrbitPropagator(unsigned int numThreads = 0)
+         throw(Exception);
+
+         /// Default destructor
+      virtual ~BatchOrbitPropagator();
+
+
+         /// Number of threads, and of orbit objects, used
+      unsigned int getNumThreads() const
+      { return propagators.size(); }
+
+         /// get the pointer to the satellite orbit object of thread k
+      SatOrbit* getSatOrbitPointer(unsigned int k)
+      { return propagators[k]->getSatOrbitPointer(); }
+
+         /// set step size of the integrators
+      BatchOrbitPropagator& setStepSize(double step_size = 10.0);
+
+
+         /** Propagate each initial state to tf seconds after its epoch.
+          *
+          * @param utc0   epochs of the initial states
+          * @param rv0    initial states (position and velocity, J2000)
+          * @param tf     seconds to propagate each state
+          * @param rv     final states, J2000; one per initial state
+          * @param phi    6*6 state transition matrices, one per state
+          * @return       number of states that couldn't be propagated;
+          *               their rv and phi are left empty, and the reason
+          *               is given by getError()
+          */
+      int propagate( const std::vector<UTCTime>& utc0,
+                     const std::vector< Vector<double> >& rv0,
+                     double tf,
+                     std::vector< Vector<double> >& rv,
+                     std::vector< Matrix<double> >& phi )
+         throw(Exception);
+
+
+         /// Why state i failed in the last propagate(); empty if it didn't
+      std::string getError(size_t i) const
+      { return (i < errors.size()) ? errors[i] : std::string(); }
+
+
+   private:
+
+         /// Copying would share the orbit objects
+      BatchOrbitPropagator(const BatchOrbitPropagator&);
+      BatchOrbitPropagator& operator=(const BatchOrbitPropagator&);
+
+
+         /// Threads that do the work
+      ThreadPool pool;
+
+         /// One propagator per thread
+      std::vector<SatOrbitPropagator*> propagators;
+
+         /// Errors of the last propagate(), one per state
+      std::vector<std::string> errors;
+
+   }; // End of class 'BatchOrbitPropagator'
+
+      // @}
+
+} // end namespace 'gpstk'
+
+
+#endif   // GPSTK_BATCH_ORBIT_PROPAGATOR_HPP
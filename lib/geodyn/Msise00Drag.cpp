@@ -29,6 +29,10 @@
 //============================================================================
 
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 #include "Msise00Drag.hpp"
 #include <string>
 #include <cmath>
@@ -41,6 +45,14 @@
 namespace gpstk
 {
 
+#ifndef _WIN32
+   namespace
+   {
+         // Guards the static work arrays used by gtd7() and gtd7d()
+      pthread_mutex_t msiseMutex = PTHREAD_MUTEX_INITIALIZER;
+   }
+#endif
+
    // test the model
    void Msise00Drag::test()
    {
@@ -353,6 +365,9 @@ namespace gpstk
       input.f107 = f107_in;
       input.ap = this->ap_opt;    //14.924291;//13.853964381; //???
 
+#ifndef _WIN32
+      pthread_mutex_lock(&msiseMutex);
+#endif
       if(alt > 500.0)
       {
          gtd7d(&input, &flags, &output);
@@ -360,6 +375,9 @@ namespace gpstk
       {
          gtd7(&input, &flags, &output);
       }
+#ifndef _WIN32
+      pthread_mutex_unlock(&msiseMutex);
+#endif
 
       return output.d[5]*1000.0; //[kg/m^3]  
 
@@ -27,6 +27,10 @@
 //
 //============================================================================
 
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
 #include "ReferenceFrames.hpp"
 #include <iostream>
 #include <string>
@@ -40,6 +44,15 @@
 namespace gpstk
 {
    using namespace std;
+
+#ifndef _WIN32
+   namespace
+   {
+         // Guards 'solarPlanets', whose file buffers are changed by
+         // every call to computeState()
+      pthread_mutex_t solarMutex = PTHREAD_MUTEX_INITIALIZER;
+   }
+#endif
       
       // Objects to handle JPL ephemeris 405 
    SolarSystem ReferenceFrames::solarPlanets;
@@ -125,10 +138,28 @@ namespace gpstk
       try
       {
          double rvState[6] = {0.0};
-         int ret = solarPlanets.computeState(JD_TO_MJD + TT.MJD(),
-            entity,
-            center,
-            rvState);
+         int ret(0);
+
+#ifndef _WIN32
+         pthread_mutex_lock(&solarMutex);
+#endif
+         try
+         {
+            ret = solarPlanets.computeState(JD_TO_MJD + TT.MJD(),
+               entity,
+               center,
+               rvState);
+         }
+         catch(...)
+         {
+#ifndef _WIN32
+            pthread_mutex_unlock(&solarMutex);
+#endif
+            throw;
+         }
+#ifndef _WIN32
+         pthread_mutex_unlock(&solarMutex);
+#endif
          
             // change the unit to km/s from km/day
          rvState[3] /= 86400.0;
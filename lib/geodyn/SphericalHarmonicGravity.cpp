@@ -42,49 +42,118 @@ namespace gpstk
        * @param m Desired order.
        */
    SphericalHarmonicGravity::SphericalHarmonicGravity(int n, int m)
-      : desiredDegree(n),
+      : vwDegree(-1),
+        vwOrder(-1),
+        csValid(false),
+        desiredDegree(n),
         desiredOrder(m),
         correctSolidTide(false),
-        correctOceanTide(false),
-        correctPoleTide(false)
+        correctPoleTide(false),
+        correctOceanTide(false)
+   {
+      resizeWorkspace();
+
+      //Sn0.resize(gmData.maxDegree, 0.0);
+
+   }
+
+
+      /* Size V, W and the recursion coefficients for the desired degree
+       * and order.
+       */
+   void SphericalHarmonicGravity::resizeWorkspace()
    {
       const int size = desiredDegree;
 
       V.resize( size + 3, size + 3, 0.0);
       W.resize( size + 3, size + 3, 0.0);
 
-      //Sn0.resize(gmData.maxDegree, 0.0);
+      // V(n,m) = ((2n-1)*z0*V(n-1,m) - (n+m-1)*rho*V(n-2,m)) / (n-m)
+      vwA.resize( size + 3, size + 3, 0.0);
+      vwB.resize( size + 3, size + 3, 0.0);
+      for (int m = 0; m <= (desiredOrder+2) && m < (size+3); m++)
+      {
+         for (int n = (m+2); n <= (desiredDegree+2); n++)
+         {
+            vwA(n,m) = double(2*n - 1) / double(n - m);
+            vwB(n,m) = double(n + m - 1) / double(n - m);
+         }
+      }
 
-   }
+      vwDegree = desiredDegree;
+      vwOrder = desiredOrder;
+
+   }  // End of method 'SphericalHarmonicGravity::resizeWorkspace()'
+
+
+      /* Fill Cnm and Snm from a CS matrix, where C(n,m) = CS(n,m) and
+       * S(n,m) = CS(m-1,n).
+       */
+   void SphericalHarmonicGravity::splitCS(const Matrix<double>& CS)
+   {
+      if( (int(Cnm.rows()) != desiredDegree+1) || 
+          (int(Cnm.cols()) != desiredOrder+1) )
+      {
+         Cnm.resize(desiredDegree+1, desiredOrder+1, 0.0);
+         Snm.resize(desiredDegree+1, desiredOrder+1, 0.0);
+      }
+
+      for (int m = 0; m <= desiredOrder; m++)
+      {
+         for (int n = m; n <= desiredDegree; n++)
+         {
+            Cnm(n,m) = CS(n,m);
+            Snm(n,m) = (m==0) ? 0.0 : CS(m-1,n);
+         }
+      }
+
+   }  // End of method 'SphericalHarmonicGravity::splitCS()'
 
    
       /* Evaluates the two harmonic functions V and W.
        * @param r ECI position vector.
        * @param E ECI to ECEF transformation matrix.
        */
-   void SphericalHarmonicGravity::computeVW(Vector<double> r, Matrix<double> E)
+   void SphericalHarmonicGravity::computeVW( const Vector<double>& r,
+                                             const Matrix<double>& E )
    {   
-      // dimension should be checked here
-      // I'll do it latter...
       if((r.size()!=3) || (E.rows()!=3) || (E.cols()!=3))
       {
          Exception e("Wrong input for computeVW");
          GPSTK_THROW(e);
       }
 
+      // The degree may have been changed by setDesiredDegree()
+      if( (vwDegree != desiredDegree) || (vwOrder != desiredOrder) )
+      {
+         resizeWorkspace();
+      }
+
       // Rotate from ECI to ECEF
-      Vector<double> r_bf = E * r; 
+      double r_bf[3];
+      for (int i = 0; i < 3; i++)
+      {
+         r_bf[i] = 0.0;
+         for (int k = 0; k < 3; k++)
+         {
+            r_bf[i] += E(i,k) * r(k);
+         }
+      }
 
       const double R_ref = gmData.refDistance;
 
       // Auxiliary quantities
-      double r_sqr =  dot(r_bf, r_bf);
+      double r_sqr = 0.0;
+      for (int i = 0; i < 3; i++)
+      {
+         r_sqr += r_bf[i] * r_bf[i];
+      }
       double rho   =  R_ref * R_ref / r_sqr;
 
       // Normalized coordinates
-      double x0 = R_ref * r_bf(0) / r_sqr;          
-      double y0 = R_ref * r_bf(1) / r_sqr;   
-      double z0 = R_ref * r_bf(2) / r_sqr;
+      double x0 = R_ref * r_bf[0] / r_sqr;          
+      double y0 = R_ref * r_bf[1] / r_sqr;   
+      double z0 = R_ref * r_bf[2] / r_sqr;
 
 
       //
@@ -94,38 +163,56 @@ namespace gpstk
       //   W_nm = (R_ref/r)^(n+1) * P_nm(sin(phi)) * sin(m*lambda)
       // up to degree and order n_max+1
       //
+      // Each column of V and W holds one order m, so the recursion over
+      // n runs along contiguous memory; the divisions by (n-m) are
+      // folded into the coefficients vwA and vwB.
+      //
+
+      const int nmax = desiredDegree + 2;
 
       // Calculate zonal terms V(n,0); set W(n,0)=0.0
-      V[0][0] = R_ref / std::sqrt(r_sqr);
-      W[0][0] = 0.0;
+      double* Vm = &V(0,0);
+      double* Wm = &W(0,0);
+      const double* Am = &vwA(0,0);
+      const double* Bm = &vwB(0,0);
+
+      Vm[0] = R_ref / std::sqrt(r_sqr);
+      Wm[0] = 0.0;
 
-      V[1][0] = z0 * V[0][0];
-      W[1][0] = 0.0;
+      Vm[1] = z0 * Vm[0];
+      Wm[1] = 0.0;
 
-      for(int n = 2; n <= (desiredDegree+2); n++) 
+      for(int n = 2; n <= nmax; n++) 
       {
-         V[n][0] = ((2*n - 1) * z0 * V[n-1][0] - (n - 1) * rho * V[n-2][0]) /n;
-         W[n][0] = 0.0;
+         Vm[n] = Am[n] * z0 * Vm[n-1] - Bm[n] * rho * Vm[n-2];
+         Wm[n] = 0.0;
       }
 
       // Calculate tesseral and sectorial terms
       for (int m = 1; m <= (desiredOrder+2); m++) 
       {
+         const double* Vp = Vm;        // order m-1
+         const double* Wp = Wm;
+         Vm = &V(0,m);
+         Wm = &W(0,m);
+         Am = &vwA(0,m);
+         Bm = &vwB(0,m);
+
          // Calculate V(m,m) .. V(n_max+1,m)
 
-         V[m][m] = (2 * m - 1) * ( x0 * V[m-1][m-1] - y0 * W[m-1][m-1] );
-         W[m][m] = (2 * m - 1) * ( x0 * W[m-1][m-1] + y0 * V[m-1][m-1] );
+         Vm[m] = (2 * m - 1) * ( x0 * Vp[m-1] - y0 * Wp[m-1] );
+         Wm[m] = (2 * m - 1) * ( x0 * Wp[m-1] + y0 * Vp[m-1] );
 
          if (m <= (desiredDegree+1) ) 
          {
-            V[m+1][m] = (2 * m + 1) * z0 * V[m][m];
-            W[m+1][m] = (2 * m + 1) * z0 * W[m][m];
+            Vm[m+1] = (2 * m + 1) * z0 * Vm[m];
+            Wm[m+1] = (2 * m + 1) * z0 * Wm[m];
          }
 
-         for (int n = (m+2); n <= (desiredDegree+2); n++) 
+         for (int n = (m+2); n <= nmax; n++) 
          {
-            V[n][m] = ((2*n-1)*z0*V[n-1][m] - (n+m-1)*rho*V[n-2][m]) / (n-m);
-            W[n][m] = ((2*n-1)*z0*W[n-1][m] - (n+m-1)*rho*W[n-2][m]) / (n-m);
+            Vm[n] = Am[n] * z0 * Vm[n-1] - Bm[n] * rho * Vm[n-2];
+            Wm[n] = Am[n] * z0 * Wm[n-1] - Bm[n] * rho * Wm[n-2];
          }
 
       }  // End 'for (int m = 1; m <= (desiredOrder + 2); m++) '
@@ -138,7 +225,8 @@ namespace gpstk
        * @param E ECI to ECEF transformation matrix.
        * @return ECI acceleration in m/s^2.
        */
-   Vector<double> SphericalHarmonicGravity::gravity(Vector<double> r, Matrix<double> E)
+   Vector<double> SphericalHarmonicGravity::gravity( const Vector<double>& r,
+                                                     const Matrix<double>& E )
    {
       // dimension should be checked here
       // I'll do it latter...
@@ -148,7 +236,12 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      Matrix<double> CS = gmData.unnormalizedCS;
+      // Coefficients of the model, split by order on first use
+      if( (int(Cnm.rows()) != desiredDegree+1) || 
+          (int(Cnm.cols()) != desiredOrder+1) )
+      {
+         splitCS(gmData.unnormalizedCS);
+      }
 
    
       // Calculate accelerations ax,ay,az
@@ -156,42 +249,57 @@ namespace gpstk
 
       for (int m = 0; m <= desiredOrder; m++)
       {
-         for (int n = m; n <= desiredDegree; n++)
+         const double* C = &Cnm(0,m);     // C[n] = C_n,m
+         const double* S = &Snm(0,m);     // S[n] = S_n,m
+
+         if (m==0) 
          {
-            if (m==0) 
-            {
-               double C = CS[n][0];               // = C_n,0
+            const double* V0 = &V(1,0);   // V0[n] = V[n+1][0]
+            const double* V1 = &V(1,1);
+            const double* W1 = &W(1,1);
 
-               ax -=       C * V[n+1][1];
-               ay -=       C * W[n+1][1];
-               az -= (n+1)*C * V[n+1][0];
+            for (int n = 0; n <= desiredDegree; n++)
+            {
+               ax -=       C[n] * V1[n];
+               ay -=       C[n] * W1[n];
+               az -= (n+1)*C[n] * V0[n];
             }
-            else 
+         }
+         else 
+         {
+            const double* Vm1 = &V(1,m-1);   // Vm1[n] = V[n+1][m-1]
+            const double* Wm1 = &W(1,m-1);
+            const double* Vm  = &V(1,m);
+            const double* Wm  = &W(1,m);
+            const double* Vp1 = &V(1,m+1);
+            const double* Wp1 = &W(1,m+1);
+
+            for (int n = m; n <= desiredDegree; n++)
             {
-               double C = CS[n][m];   // = C_n,m
-               double S = CS[m-1][n]; // = S_n,m
                double Fac = 0.5 * (n-m+1) * (n-m+2);
                
-               ax += 0.5*(-C*V[n+1][m+1] - S*W[n+1][m+1]) + Fac*(C*V[n+1][m-1] + S*W[n+1][m-1]);
-               ay += 0.5*(-C*W[n+1][m+1] + S*V[n+1][m+1]) + Fac*(-C*W[n+1][m-1] + S*V[n+1][m-1]);
-               az += (n-m+1)*(-C*V[n+1][m] - S*W[n+1][m]);
+               ax += 0.5*(-C[n]*Vp1[n] - S[n]*Wp1[n]) + Fac*(C[n]*Vm1[n] + S[n]*Wm1[n]);
+               ay += 0.5*(-C[n]*Wp1[n] + S[n]*Vp1[n]) + Fac*(-C[n]*Wm1[n] + S[n]*Vm1[n]);
+               az += (n-m+1)*(-C[n]*Vm[n] - S[n]*Wm[n]);
             }
 
-         }  // End of 'for (int n = m; n <= (desiredDegree+1) ; n++)'
+         }  // End of 'if (m==0) ... else ...'
 
       }  // End of 'for (int m = 0; m <= (desiredOrder+1); m++)'
 
       // Body-fixed acceleration
-      Vector<double> a_bf(3,0.0);
-      a_bf(0) = ax;
-      a_bf(1) = ay;
-      a_bf(2) = az;
-
-      a_bf = a_bf * ( gmData.GM / (gmData.refDistance * gmData.refDistance) );
+      const double fac = gmData.GM / (gmData.refDistance * gmData.refDistance);
+      double a_bf[3] = { ax * fac, ay * fac, az * fac };
 
-      // Inertial acceleration
-      Matrix<double> Etrans = transpose(E);
-      Vector<double> out = Etrans * a_bf;            // this line may be wrong  matrix * vector
+      // Inertial acceleration, transpose(E) * a_bf
+      Vector<double> out(3, 0.0);
+      for (int i = 0; i < 3; i++)
+      {
+         for (int k = 0; k < 3; k++)
+         {
+            out(i) += E(k,i) * a_bf[k];
+         }
+      }
 
       return out;
 
@@ -203,7 +311,9 @@ namespace gpstk
        * @param r ECI position vector.
        * @param E ECI to ECEF transformation matrix.
        */
-   Matrix<double> SphericalHarmonicGravity::gravityGradient(gpstk::Vector<double> r, gpstk::Matrix<double> E)
+   Matrix<double> SphericalHarmonicGravity::gravityGradient( 
+                                                      const Vector<double>& r,
+                                                      const Matrix<double>& E )
    {
       // dimension should be checked here
       // I'll do it latter...
@@ -213,7 +323,12 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      Matrix<double> CS = gmData.unnormalizedCS;
+      // Coefficients of the model, split by order on first use
+      if( (int(Cnm.rows()) != desiredDegree+1) || 
+          (int(Cnm.cols()) != desiredOrder+1) )
+      {
+         splitCS(gmData.unnormalizedCS);
+      }
 
    
       double xx = 0.0;     
@@ -223,79 +338,103 @@ namespace gpstk
       double yz = 0.0;
       double zz = 0.0;
 
-      Matrix<double> out(3, 3, 0.0);
-
       for (int m = 0; m <= desiredOrder; m++) 
       {
+         const double* Cm = &Cnm(0,m);
+         const double* Sm = &Snm(0,m);      // S_n,0 = 0
+
+         // Columns m-2 .. m+2 of V and W from row 2: Vm[n] = V[n+2][m]
+         const double* Vm   = &V(2,m);
+         const double* Wm   = &W(2,m);
+         const double* Vmp1 = &V(2,m+1);
+         const double* Wmp1 = &W(2,m+1);
+         const double* Vmp2 = &V(2,m+2);
+         const double* Wmp2 = &W(2,m+2);
+         const double* Vmm1 = (m > 0) ? &V(2,m-1) : 0;
+         const double* Wmm1 = (m > 0) ? &W(2,m-1) : 0;
+         const double* Vmm2 = (m > 1) ? &V(2,m-2) : 0;
+         const double* Wmm2 = (m > 1) ? &W(2,m-2) : 0;
+
          for (int n = m; n <= desiredDegree; n++) 
          {
             double Fac = (n-m+2)*(n-m+1);
             
-            double C = CS[n][m];
-            double S = (m==0) ? 0.0 : CS[m-1][n];   // yan changed
-            //S = (m==0)?Sn0(n):CS[m-1][n];   // yan changed
+            double C = Cm[n];
+            double S = Sm[n];
 
-            zz += Fac*(C*V[n+2][m] + S*W[n+2][m]);
+            zz += Fac*(C*Vm[n] + S*Wm[n]);
 
             if (m==0) 
             {
-               C = CS[n][0];   // = C_n,0
-
                Fac = (n+2)*(n+1);
-               xx += 0.5 * (C*V[n+2][2] - Fac*C*V[n+2][0]);
-               xy += 0.5 * C * W[n+2][2];
+               xx += 0.5 * (C*Vmp2[n] - Fac*C*Vm[n]);
+               xy += 0.5 * C * Wmp2[n];
                
                Fac = n + 1;
-               xz += Fac * C * V[n+2][1];
-               yz += Fac * C * W[n+2][1];
+               xz += Fac * C * Vmp1[n];
+               yz += Fac * C * Wmp1[n];
             }
             if (m > 0)
             {
-               C = CS[n][m];
-               S = CS[m-1][n];
-               
                double f1 = 0.5*(n-m+1);
                double f2 = (n-m+3)*(n-m+2)*f1;
 
-               xz += f1*(C*V[n+2][m+1]+S*W[n+2][m+1])-f2*(C*V[n+2][m-1]+S*W[n+2][m-1]);
-               yz += f1*(C*W[n+2][m+1]-S*V[n+2][m+1])+f2*(C*W[n+2][m-1]-S*V[n+2][m-1]);         //* bug in JAT, I fix it
+               xz += f1*(C*Vmp1[n]+S*Wmp1[n])-f2*(C*Vmm1[n]+S*Wmm1[n]);
+               yz += f1*(C*Wmp1[n]-S*Vmp1[n])+f2*(C*Wmm1[n]-S*Vmm1[n]);         //* bug in JAT, I fix it
           
                if (m == 1)
                {
                   Fac = (n+1)*n;
-                  xx += 0.25*(C*V[n+2][3]+S*W[n+2][3]-Fac*(3.0*C*V[n+2][1]+S*W[n+2][1]));
-                  xy += 0.25*(C*W[n+2][3]-S*V[n+2][3]-Fac*(C*W[n+2][1]+S*V[n+2][1]));
+                  xx += 0.25*(C*Vmp2[n]+S*Wmp2[n]-Fac*(3.0*C*Vm[n]+S*Wm[n]));
+                  xy += 0.25*(C*Wmp2[n]-S*Vmp2[n]-Fac*(C*Wm[n]+S*Vm[n]));
                }
                if (m > 1) 
                {
                   f1 = 2.0*(n-m+2)*(n-m+1);
                   f2 = (n-m+4)*(n-m+3)*f1*0.5;
-                  xx += 0.25*(C*V[n+2][m+2]+S*W[n+2][m+2]-f1*(C*V[n+2][m]+S*W[n+2][m])+f2*(C*V[n+2][m-2]+S*W[n+2][m-2]));
+                  xx += 0.25*(C*Vmp2[n]+S*Wmp2[n]-f1*(C*Vm[n]+S*Wm[n])+f2*(C*Vmm2[n]+S*Wmm2[n]));
 
-                  xy += 0.25*(C*W[n+2][m+2]-S*V[n+2][m+2]+f2*(-C*W[n+2][m-2]+S*V[n+2][m-2]));
+                  xy += 0.25*(C*Wmp2[n]-S*Vmp2[n]+f2*(-C*Wmm2[n]+S*Vmm2[n]));
                }
             }
          }
-         yy = -xx - zz;
-         
-         out(0,0) = xx;
-         out(0,1) = xy;
-         out(0,2) = xz;
-         out(1,0) = xy;
-         out(1,1) = yy;
-         out(1,2) = yz;
-         out(2,0) = xz;
-         out(2,1) = yz;
-         out(2,2) = zz;
 
       }  // for (int m = 0; m <= desiredOrder; m++) 
 
+      yy = -xx - zz;
+
       const double R_ref = gmData.refDistance;
-      out = out * (gmData.GM / (R_ref * R_ref * R_ref));
+      const double fac = gmData.GM / (R_ref * R_ref * R_ref);
 
-      // Rotate to ECI
-      Matrix<double> Etrans = transpose(E);
-      out = Etrans*(out*E);
+      double g[3][3] = { { xx*fac, xy*fac, xz*fac },
+                         { xy*fac, yy*fac, yz*fac },
+                         { xz*fac, yz*fac, zz*fac } };
+
+      // Rotate to ECI: transpose(E) * (g * E)
+      double gE[3][3];
+      for (int i = 0; i < 3; i++)
+      {
+         for (int j = 0; j < 3; j++)
+         {
+            gE[i][j] = 0.0;
+            for (int k = 0; k < 3; k++)
+            {
+               gE[i][j] += g[i][k] * E(k,j);
+            }
+         }
+      }
+
+      Matrix<double> out(3, 3, 0.0);
+      for (int i = 0; i < 3; i++)
+      {
+         for (int j = 0; j < 3; j++)
+         {
+            for (int k = 0; k < 3; k++)
+            {
+               out(i,j) += E(k,i) * gE[k][j];
+            }
+         }
+      }
 
       return out;         // the result should be checked
 
@@ -354,12 +493,25 @@ namespace gpstk
    // Correct tides to coefficients 
    void SphericalHarmonicGravity::correctCSTides(UTCTime t,bool solidFlag,bool oceanFlag,bool poleFlag)
    {
+      double mjd = t.MJD();
+
+      // The integrator evaluates the force several times at each epoch.
+      // The corrected copy is not used by gravity() or gravityGradient(),
+      // as before; only the work of making it is saved.
+      if( csValid && (mjd == csMJD) && 
+          (solidFlag == csSolid) && (oceanFlag == csOcean) && 
+          (poleFlag == csPole) && 
+          (desiredDegree == csDegree) && (desiredOrder == csOrder) )
+      {
+         return;
+      }
+
       // copy CS
-      Matrix<double> CS = gmData.unnormalizedCS;
+      tideCS = gmData.unnormalizedCS;
+      Matrix<double>& CS = tideCS;
       Vector<double> Sn0(CS.rows(),0.0);
 
       // 
-      double mjd = t.MJD();
       double leapYears = (mjd-gmData.refMJD)/365.25;
 
       double detC20 = normFactor(2,0)*leapYears*gmData.dotC20;
@@ -453,6 +605,14 @@ namespace gpstk
          CS(0,2) += normFactor(2,1)*dS21;
       }
 
+      csValid = true;
+      csMJD = mjd;
+      csSolid = solidFlag;
+      csOcean = oceanFlag;
+      csPole = poleFlag;
+      csDegree = desiredDegree;
+      csOrder = desiredOrder;
+
    }  // End of method 'SphericalHarmonicGravity::correctCSTides()'
 
 
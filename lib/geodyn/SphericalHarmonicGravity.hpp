@@ -72,7 +72,7 @@ namespace gpstk
           * @param E ECI to ECEF transformation matrix.
           * @return ECI acceleration in m/s^2.
           */
-      Vector<double> gravity(Vector<double> r, Matrix<double> E);
+      Vector<double> gravity(const Vector<double>& r, const Matrix<double>& E);
 
 
          /** Computes the partial derivative of gravity with respect to position.
@@ -80,7 +80,8 @@ namespace gpstk
           * @param r ECI position vector.
           * @param E ECI to ECEF transformation matrix.
           */
-      Matrix<double> gravityGradient(Vector<double> r, Matrix<double> E);
+      Matrix<double> gravityGradient(const Vector<double>& r,
+                                     const Matrix<double>& E);
       
 
          /** Call the relevant methods to compute the acceleration.
@@ -124,11 +125,21 @@ namespace gpstk
           * @param r ECI position vector.
           * @param E ECI to ECEF transformation matrix.
           */
-      void computeVW(Vector<double> r, Matrix<double> E);
+      void computeVW(const Vector<double>& r, const Matrix<double>& E);
 
-         /// Add tides to coefficients 
+         /** Add tides to a copy of the coefficients, kept in tideCS.
+          *  The corrections are computed once per epoch; calling again with
+          *  the same epoch, flags and degree does nothing.
+          */
       void correctCSTides(UTCTime t,bool solidFlag = false, bool oceanFlag = false, bool poleFlag = false);
 
+         /// Size V, W and the recursion coefficients for the desired degree
+         /// and order.
+      void resizeWorkspace();
+
+         /// Fill Cnm and Snm from a CS matrix (see gmData.unnormalizedCS).
+      void splitCS(const Matrix<double>& CS);
+
          /// normalized coefficient
       double normFactor(int n, int m);
 
@@ -160,6 +171,26 @@ namespace gpstk
          /// Harmonic function V and W
       Matrix<double> V, W;
 
+         /// Coefficients of the recursion for V and W (n >= m+2):
+         /// V(n,m) = vwA(n,m)*z0*V(n-1,m) - vwB(n,m)*rho*V(n-2,m)
+      Matrix<double> vwA, vwB;
+
+         /// Degree and order V, W, vwA and vwB are sized for
+      int vwDegree, vwOrder;
+
+         /// Coefficients C(n,m) and S(n,m) of the model; each column holds
+         /// one order, so the loops over n are contiguous.
+      Matrix<double> Cnm, Snm;
+
+         /// Copy of the coefficients used to apply the tide corrections
+      Matrix<double> tideCS;
+
+         /// Epoch (MJD UTC), flags and degree tideCS was corrected for
+      bool csValid;
+      double csMJD;
+      bool csSolid, csOcean, csPole;
+      int csDegree, csOrder;
+
          /// Degree and Order of gravity model desired.
       int desiredDegree, desiredOrder;
          
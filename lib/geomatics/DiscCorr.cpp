@@ -159,6 +159,7 @@ void GDCconfiguration::initialize(void)
 {
 try {
    p_oflog = &cout;
+   passNumber = 0;
 
    // use cfg(DT) NOT dt -  dt is part of SatPass...
    setcfg(DT, -1, "nominal timestep of data (seconds) [required - no default!]");
@@ -287,7 +288,7 @@ public:
    static const unsigned short GFDETECT;
    static const unsigned short GFFIX;
 
-   explicit GDCPass(SatPass& sp, const GDCconfiguration& gdc);
+   explicit GDCPass(SatPass& sp, const GDCconfiguration& gdc, int unique);
 
    //~GDCPass(void) { };
 
@@ -472,21 +473,25 @@ private:
    /// keep count of various results: slips, deletions, etc.; print to log in finish()
    map<string,int> learn;
 
+   /// obs types of the pass, in the order of obstypeenum
+   vector<string> DCobstypes;
+
+   /// these are used only to associate a unique number in the log file with
+   /// this pass, and with each (WL,GF) fix within it
+   int GDCUnique;
+   int GDCUniqueFix;
+
 }; // end class GDCPass
 
 //------------------------------------------------------------------------------------
 // local data
 //------------------------------------------------------------------------------------
-// these are used only to associate a unique number in the log file with each pass
-int GDCUnique=0;     // unique number for each call
-int GDCUniqueFix;    // unique for each (WL,GF) fix
-
 // conveniences only...
 #define log *(p_oflog)
 #define cfg(a) cfg_func(#a)
 // gcc doesn't like const enum...
 enum obstypeenum {  L1=0, L2=1, P1=2, P2=3, A1=4, A2=5 };   // P1 will <=> C1 or P1
-vector<string> DCobstypes;       // above are indexes into both data and this vector
+                                 // above are indexes into both data and DCobstypes
 
 // constants used in linear combinations
 const double CFF=C_GPS_M/OSC_FREQ;
@@ -595,14 +600,26 @@ int gpstk::DiscontinuityCorrector(SatPass& svp,
                                   vector<string>& editCmds,
                                   string& retMessage)
    throw(Exception)
+{
+   return DiscontinuityCorrector(svp, gdc, gdc.nextPassNumber(),
+                                 editCmds, retMessage);
+}
+
+//------------------------------------------------------------------------------------
+// The reentrant form: nothing here is shared between calls
+int gpstk::DiscontinuityCorrector(SatPass& svp,
+                                  const GDCconfiguration& gdc,
+                                  int passNumber,
+                                  vector<string>& editCmds,
+                                  string& retMessage)
+   throw(Exception)
 {
 try {
    int i,j,iret;
-   GDCUnique++;
 
    // --------------------------------------------------------------------------------
    // require obstypes L1,L2,C1/P1,P2, and add two auxiliary arrays
-   DCobstypes.clear();
+   vector<string> DCobstypes;
    DCobstypes.push_back("L1");
    DCobstypes.push_back("L2");
    DCobstypes.push_back((int(gdc.getParameter("useCA"))) == 0 ? "P1" : "C1");
@@ -612,15 +629,12 @@ try {
 
    // --------------------------------------------------------------------------------
    // test input for (a) some data and (b) the required obs types L1,L2,C1/P1,P2
-   vector<double> newdata(6);
-   try {
-      newdata[L1] = svp.data(0,DCobstypes[L1]);
-      newdata[L2] = svp.data(0,DCobstypes[L2]);
-      newdata[P1] = svp.data(0,DCobstypes[P1]);
-      newdata[P2] = svp.data(0,DCobstypes[P2]);
-   }
-   catch (Exception& e) { // if obs type is not found in input
-      return BadInput;
+   // and find the indexes of these obs types in the input
+   vector<int> svpIndex(4);
+   if(svp.size() == 0) return BadInput;
+   for(j=0; j<4; j++) {
+      svpIndex[j] = svp.getIndex(DCobstypes[j]);
+      if(svpIndex[j] < 0) return BadInput;    // obs type is not found in input
    }
 
    // --------------------------------------------------------------------------------
@@ -629,12 +643,13 @@ try {
 
    // fill the new SatPass with the input data
    nsvp.status() = svp.status();
+   vector<double> newdata(6);
    vector<unsigned short> lli(6),ssi(6);
    for(i=0; i<svp.size(); i++) {
       for(j=0; j<6; j++) {
-         newdata[j] = j < 4 ? svp.data(i,DCobstypes[j]) : 0.0;
-         lli[j] = j < 4 ? svp.LLI(i,DCobstypes[j]) : 0;
-         ssi[j] = j < 4 ? svp.SSI(i,DCobstypes[j]) : 0;
+         newdata[j] = j < 4 ? svp.data(i,svpIndex[j]) : 0.0;
+         lli[j] = j < 4 ? svp.LLI(i,svpIndex[j]) : 0;
+         ssi[j] = j < 4 ? svp.SSI(i,svpIndex[j]) : 0;
       }
       // return value must be 0
       nsvp.addData(svp.time(i), DCobstypes, newdata, lli, ssi, svp.getFlag(i));
@@ -642,7 +657,7 @@ try {
 
    // --------------------------------------------------------------------------------
    // create a GDCPass from the input SatPass (modified) and GDC configuration
-   GDCPass gp(nsvp,gdc);
+   GDCPass gp(nsvp,gdc,passNumber);
 
    // --------------------------------------------------------------------------------
    // implement the DC algorithm using the GDCPass
@@ -680,12 +695,86 @@ catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(
 catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 }
 
+//------------------------------------------------------------------------------------
+// class GDCbatch
+//------------------------------------------------------------------------------------
+namespace {
+   // correct one pass of a GDCbatch, with the debug output going to a string
+   class GDCbatchTask : public ThreadPoolTask {
+   public:
+      GDCbatchTask(vector<SatPass>& sps, const vector<int>& ind,
+                   const GDCconfiguration& gdc, int first,
+                   vector<GDCbatch::Result>& res)
+         : SPList(sps), indexes(ind), config(gdc), firstNumber(first), results(res)
+      { }
+
+      virtual void process(size_t i)
+      {
+         ostringstream oss;
+         GDCconfiguration passConfig(config);
+         passConfig.setDebugStream(oss);
+         GDCbatch::Result& r = results[i];
+         r.iret = DiscontinuityCorrector(SPList[indexes[i]], passConfig,
+                                         firstNumber+int(i), r.EditCmds, r.retMsg);
+         r.debugOutput = oss.str();
+      }
+
+      vector<SatPass>& SPList;
+      const vector<int>& indexes;
+      const GDCconfiguration& config;
+      int firstNumber;
+      vector<GDCbatch::Result>& results;
+   };
+}
+
+void GDCbatch::correct(vector<SatPass>& SPList,
+                       const vector<int>& indexes,
+                       GDCconfiguration& config,
+                       vector<Result>& results,
+                       bool writeLog)
+   throw(Exception)
+{
+try {
+   results.clear();
+   results.resize(indexes.size());
+   if(indexes.empty()) return;
+
+   // number the passes as serial calls would
+   int first = config.nextPassNumber();
+   for(int i=1; i<indexes.size(); i++) config.nextPassNumber();
+
+   GDCbatchTask task(SPList,indexes,config,first,results);
+   pool.run(task,indexes.size());
+
+   if(writeLog) {
+      ostream& os(config.getDebugStream());
+      for(int i=0; i<results.size(); i++)
+         os << results[i].debugOutput;
+   }
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+void GDCbatch::correct(vector<SatPass>& SPList,
+                       GDCconfiguration& config,
+                       vector<Result>& results,
+                       bool writeLog)
+   throw(Exception)
+{
+   vector<int> indexes(SPList.size());
+   for(int i=0; i<indexes.size(); i++) indexes[i] = i;
+   correct(SPList,indexes,config,results,writeLog);
+}
+
 //------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------
 // class GDCPass member functions
 //------------------------------------------------------------------------------------
-GDCPass::GDCPass(SatPass& sp, const GDCconfiguration& gdc)
-      : SatPass(sp.getSat(), sp.getDT(), sp.getObsTypes())
+GDCPass::GDCPass(SatPass& sp, const GDCconfiguration& gdc, int unique)
+      : SatPass(sp.getSat(), sp.getDT(), sp.getObsTypes()),
+        DCobstypes(sp.getObsTypes()), GDCUnique(unique), GDCUniqueFix(0)
 {
    int i,j;
    Status = sp.status();
@@ -697,16 +786,14 @@ GDCPass::GDCPass(SatPass& sp, const GDCconfiguration& gdc)
       indexForLabel[labelForIndex[i]] = i;
    }
 
-   vector<double> vdata;
-   vector<unsigned short> lli,ssi;
+   // the obs types are the same, so the columns are in the same order
+   vector<double> vdata(ot.size());
+   vector<unsigned short> lli(ot.size()),ssi(ot.size());
    for(i=0; i<sp.size(); i++) {
-      vdata.clear();
-      lli.clear();
-      ssi.clear();
       for(j=0; j<ot.size(); j++) {
-         vdata.push_back(sp.data(i,ot[j]));
-         lli.push_back(sp.LLI(i,ot[j]));
-         ssi.push_back(sp.SSI(i,ot[j]));
+         vdata[j] = sp.data(i,j);
+         lli[j] = sp.LLI(i,j);
+         ssi[j] = sp.SSI(i,j);
       }
       addData(sp.time(i),ot,vdata,lli,ssi,sp.getFlag(i));
    }
@@ -757,20 +844,20 @@ try {
    for(ilast=-1,i=0; i<size(); i++) {
 
       // ignore data the caller has marked BAD
-      if(!(spdvector[i].flag & OK)) continue;
+      if(!(flags[i] & OK)) continue;
 
       // just in case the caller has set it to something else...
-      spdvector[i].flag = OK;
+      flags[i] = OK;
 
          // look for obvious outliers
          // Don't do this - sometimes the pseudoranges get extreme values b/c the
          // clock is allowed to run off for long times - perfectly normal
-      //if(spdvector[i].data[P1] < cfg(MinRange) ||
-      //   spdvector[i].data[P1] > cfg(MaxRange) ||
-      //   spdvector[i].data[P2] < cfg(MinRange) ||
-      //   spdvector[i].data[P2] > cfg(MaxRange) )
+      //if(obsData[P1][i] < cfg(MinRange) ||
+      //   obsData[P1][i] > cfg(MaxRange) ||
+      //   obsData[P2][i] < cfg(MinRange) ||
+      //   obsData[P2][i] > cfg(MaxRange) )
       //{
-      //   spdvector[i].flag = BAD;
+      //   flags[i] = BAD;
       //   learn["points deleted: obvious outlier"]++;
       //   if(cfg(Debug) > 6)
       //      log << "Obvious outlier " << GDCUnique << " " << sat
@@ -804,30 +891,30 @@ try {
 
          // loop over points in this segment
       for(i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(flags[i] & OK)) continue;
 
-         dbias = fabs(spdvector[i].data[P1]-wl1*spdvector[i].data[L1]-biasL1);
+         dbias = fabs(obsData[P1][i]-wl1*obsData[L1][i]-biasL1);
          if(dbias > cfg(RawBiasLimit)) {
             if(cfg(Debug) >= 2) log << "BEFresetL1 " << GDCUnique
                << " " << sat << " " << time(i).printf(outFormat)
                << " " << fixed << setprecision(3) << biasL1
-               << " " << spdvector[i].data[P1] - wl1 * spdvector[i].data[L1] << endl;
-            biasL1 = spdvector[i].data[P1] - wl1 * spdvector[i].data[L1];
+               << " " << obsData[P1][i] - wl1 * obsData[L1][i] << endl;
+            biasL1 = obsData[P1][i] - wl1 * obsData[L1][i];
          }
 
-         dbias = fabs(spdvector[i].data[P2]-wl2*spdvector[i].data[L2]-biasL2);
+         dbias = fabs(obsData[P2][i]-wl2*obsData[L2][i]-biasL2);
          if(dbias > cfg(RawBiasLimit)) {
             if(cfg(Debug) >= 2) log << "BEFresetL2 " << GDCUnique
                << " " << sat << " " << time(i).printf(outFormat)
                << " " << fixed << setprecision(3) << biasL2
-               << " " << spdvector[i].data[P2] - wl2 * spdvector[i].data[L2] << endl;
-            biasL2 = spdvector[i].data[P2] - wl2 * spdvector[i].data[L2];
+               << " " << obsData[P2][i] - wl2 * obsData[L2][i] << endl;
+            biasL2 = obsData[P2][i] - wl2 * obsData[L2][i];
          }
 
-         spdvector[i].data[A1] =
-            spdvector[i].data[P1] - wl1 * spdvector[i].data[L1] - biasL1;
-         spdvector[i].data[A2] =
-            spdvector[i].data[P2] - wl2 * spdvector[i].data[L2] - biasL2;
+         obsData[A1][i] =
+            obsData[P1][i] - wl1 * obsData[L1][i] - biasL1;
+         obsData[A2][i] =
+            obsData[P2][i] - wl2 * obsData[L2][i] - biasL2;
 
       }  // end loop over points in the segment
 
@@ -863,16 +950,16 @@ try {
 
       // loop over points in this segment
       for(i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(flags[i] & OK)) continue;
 
          // narrow lane range (m)
-         wlr = wl1r * spdvector[i].data[P1] + wl2r * spdvector[i].data[P2];
+         wlr = wl1r * obsData[P1][i] + wl2r * obsData[P2][i];
          // wide lane phase (m)
-         wlp = wl1p * spdvector[i].data[L1] + wl2p * spdvector[i].data[L2];
+         wlp = wl1p * obsData[L1][i] + wl2p * obsData[L2][i];
          // geometry-free range (m)
-         gfr =        spdvector[i].data[P1] -        spdvector[i].data[P2];
+         gfr =        obsData[P1][i] -        obsData[P2][i];
          // geometry-free phase (m)
-         gfp = gf1p * spdvector[i].data[L1] + gf2p * spdvector[i].data[L2];
+         gfp = gf1p * obsData[L1][i] + gf2p * obsData[L2][i];
          // wide lane bias (cycles)
          wlbias = (wlp-wlr)/wlwl;
 
@@ -883,10 +970,10 @@ try {
          }
 
          // change the arrays
-         spdvector[i].data[L1] = gfp + gfr;              // only used in GF
-         spdvector[i].data[L2] = gfp;
-         spdvector[i].data[P1] = wlbias;
-         spdvector[i].data[P2] = - gfr;
+         obsData[L1][i] = gfp + gfr;              // only used in GF
+         obsData[L2][i] = gfp;
+         obsData[P1][i] = wlbias;
+         obsData[P2][i] = - gfr;
 
          it->npts++;
       }
@@ -1006,8 +1093,8 @@ try {
       }
       if(i > it->nend) {                  // change segments
          if(outlier) {
-            if(spdvector[ibad].flag & OK) nok--;
-            spdvector[ibad].flag = BAD;
+            if(flags[ibad] & OK) nok--;
+            flags[ibad] = BAD;
             learn[string("points deleted: ") + which + string(" slip outlier")]++;
             outlier = false;
          }
@@ -1015,36 +1102,36 @@ try {
          // update nbeg and nend
          while(it->nbeg < it->nend
             && it->nbeg < size()
-            && !(spdvector[it->nbeg].flag & OK) ) it->nbeg++;
+            && !(flags[it->nbeg] & OK) ) it->nbeg++;
          while(it->nend > it->nbeg
             && it->nend > 0
-            && !(spdvector[it->nend].flag & OK) ) it->nend--;
+            && !(flags[it->nend] & OK) ) it->nend--;
          it++;
          if(it == SegList.end())
             return ReturnOK;
          nok = 0;
       }
 
-      if(!(spdvector[i].flag & OK))
+      if(!(flags[i] & OK))
          continue;
       nok++;                                   // nok = # good points in segment
 
       if(igood == -1) igood = i;               // igood is index of last good point
 
-      if(fabs(spdvector[i].data[A1]) > limit) {// found an outlier (1st diff, cycles)
+      if(fabs(obsData[A1][i]) > limit) {// found an outlier (1st diff, cycles)
          outlier = true;
          ibad = i;                             // ibad is index of last bad point
       }
       else if(outlier) {                       // this point good, but not past one(s)
          for(j=igood+1; j<ibad; j++) {
-            if(spdvector[j].flag & OK)
+            if(flags[j] & OK)
                nok--;
-            if(spdvector[j].flag & DETECT)
+            if(flags[j] & DETECT)
                log << "Warning - found an obvious slip, "
                   << "but marking BAD a point already marked with slip "
                   << GDCUnique << " " << sat
                   << " " << time(j).printf(outFormat) << " " << j << endl;
-            spdvector[j].flag = BAD;             // mark all points between as bad
+            flags[j] = BAD;             // mark all points between as bad
             learn[string("points deleted: ") + which + string(" slip outlier")]++;
          }
 
@@ -1054,15 +1141,15 @@ try {
          it = createSegment(it,ibad,which+string(" slip gross"));
 
             // mark it
-         spdvector[ibad].flag |= (which == string("WL") ? WLDETECT : GFDETECT);
+         flags[ibad] |= (which == string("WL") ? WLDETECT : GFDETECT);
 
             // change the bias in the new segment
          if(which == "WL") {
-            wlbias = spdvector[ibad].data[P1];
+            wlbias = obsData[P1][ibad];
             it->bias1 = long(wlbias+(wlbias > 0 ? 0.5 : -0.5));   // WL bias (NWL)
          }
          if(which == "GF")
-            it->bias2 = spdvector[ibad].data[L2];                 // GFP bias
+            it->bias2 = obsData[L2][ibad];                 // GFP bias
 
             // prep for next point
          nok = 2;
@@ -1094,34 +1181,34 @@ try {
 
    for(i=0; i<size(); i++) {
       // ignore bad data
-      if(!(spdvector[i].flag & OK)) {
-         spdvector[i].data[A1] = spdvector[i].data[A2] = 0.0;
+      if(!(flags[i] & OK)) {
+         obsData[A1][i] = obsData[A2][i] = 0.0;
          continue;
       }
 
       // compute first differences - 'change the arrays' A1 and A2
       if(which == string("WL")) {
          if(iprev == -1)
-            spdvector[i].data[A1] = 0.0;
+            obsData[A1][i] = 0.0;
          else
-            spdvector[i].data[A1] =
-               (spdvector[i].data[P1] - spdvector[iprev].data[P1]) /
-                  (spdvector[i].ndt-spdvector[iprev].ndt);
+            obsData[A1][i] =
+               (obsData[P1][i] - obsData[P1][iprev]) /
+                  (counts[i]-counts[iprev]);
       }
       else if(which == string("GF")) {
          if(iprev == -1)            // first difference not defined at first point
-            spdvector[i].data[A1] = spdvector[i].data[A2] = 0.0;
+            obsData[A1][i] = obsData[A2][i] = 0.0;
          else {
             // compute first difference of L1 = raw residual GFP-GFR
-            spdvector[i].data[A1] =
-               (spdvector[i].data[L1] - spdvector[iprev].data[L1]);
+            obsData[A1][i] =
+               (obsData[L1][i] - obsData[L1][iprev]);
                   // 040809 should this be divided by delta N?
-                  // / (spdvector[i].ndt-spdvector[iprev].ndt);
+                  // / (counts[i]-counts[iprev]);
             // compute first difference of L2 = GFP
-            spdvector[i].data[A2] =
-               (spdvector[i].data[L2] - spdvector[iprev].data[L2]);
+            obsData[A2][i] =
+               (obsData[L2][i] - obsData[L2][iprev]);
                   // 040809 should this be divided by delta N?
-                  // / (spdvector[i].ndt-spdvector[iprev].ndt);
+                  // / (counts[i]-counts[iprev]);
          }
       }
 
@@ -1148,8 +1235,8 @@ try {
 
    // loop over data, adding to Stats, and counting good points
    for(int i=it->nbeg; i<=it->nend; i++) {
-      if(!(spdvector[i].flag & OK)) continue;
-      it->WLStats.Add(spdvector[i].data[P1] - it->bias1);
+      if(!(flags[i] & OK)) continue;
+      it->WLStats.Add(obsData[P1][i] - it->bias1);
       it->npts++;
    }
 
@@ -1185,8 +1272,8 @@ try {
 
       // put wlbias in vecA1, but without gaps: let j index good points only from nbeg
       for(j=i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
-         wlbias = spdvector[i].data[P1] - it->bias1;
+         if(!(flags[i] & OK)) continue;
+         wlbias = obsData[P1][i] - it->bias1;
          vecA1.push_back(wlbias);
          vecA2.push_back(0.0);
          j++;
@@ -1199,41 +1286,41 @@ try {
       // change the array : A1 is wlbias, A2 (output) will contain the weights
       // copy temps out into A1 and A2
       for(k=0,i=it->nbeg; i<j; k++,i++) {
-         spdvector[i].data[A1] = vecA1[k];
-         spdvector[i].data[A2] = vecA2[k];
+         obsData[A1][i] = vecA1[k];
+         obsData[A2][i] = vecA2[k];
       }
 
       haveslip = false;
       for(j=i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(flags[i] & OK)) continue;
 
-         wlbias = spdvector[i].data[P1] - it->bias1;
+         wlbias = obsData[P1][i] - it->bias1;
 
          // TD ? use weights at all? they remove a lot of points
          // TD add absolute limit?
          if(fabs(wlbias-ave) > nsigma ||
-               spdvector[j].data[A2] < cfg(WLRobustWeightLimit))
+               obsData[A2][j] < cfg(WLRobustWeightLimit))
             outlier = true;
          else
             outlier = false;
 
          // remove points by sigma stripping
          if(outlier) {
-            if(spdvector[i].flag & DETECT || i == it->nbeg) {
+            if(flags[i] & DETECT || i == it->nbeg) {
                haveslip = true;
                slipindex = i;        // mark
-               slip = spdvector[i].flag; // save to put on first good point
+               slip = flags[i]; // save to put on first good point
                //log << "Warning - marking a slip point BAD in WL sigma strip "
                //   << GDCUnique << " " << sat
                //   << " " << time(i).printf(outFormat) << " " << i << endl;
             }
-            spdvector[i].flag = BAD;
+            flags[i] = BAD;
             learn["points deleted: WL sigma stripping"]++;
             it->npts--;
             it->WLStats.Subtract(wlbias);
          }
          else if(haveslip) {
-            spdvector[i].flag = slip;
+            flags[i] = slip;
             haveslip = false;
          }
 
@@ -1242,10 +1329,10 @@ try {
             << " " << it->nseg
             << " " << time(i).printf(outFormat)
             << fixed << setprecision(3)
-            << " " << setw(3) << spdvector[i].flag
-            << " " << setw(13) << spdvector[j].data[A1] // wlbias
+            << " " << setw(3) << flags[i]
+            << " " << setw(13) << obsData[A1][j] // wlbias
             << " " << setw(13) << fabs(wlbias-ave)
-            << " " << setw(5) << spdvector[j].data[A2]  // 0 <= weight <= 1
+            << " " << setw(5) << obsData[A2][j]  // 0 <= weight <= 1
             << " " << setw(3) << i
             << (outlier ? " outlier" : "");
             if(i == it->nbeg) log
@@ -1266,27 +1353,27 @@ try {
       haveslip = false;
       ave = it->WLStats.Average();
       for(i=it->nbeg; i<=it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(flags[i] & OK)) continue;
 
-         wlbias = spdvector[i].data[P1] - it->bias1;
+         wlbias = obsData[P1][i] - it->bias1;
 
          // remove points by sigma stripping
          if(fabs(wlbias-ave) > nsigma) { // TD add absolute limit?
-            if(spdvector[i].flag & DETECT) {
+            if(flags[i] & DETECT) {
                haveslip = true;
                slipindex = i;        // mark
-               slip = spdvector[i].flag; // save to put on first good point
+               slip = flags[i]; // save to put on first good point
                //log << "Warning - marking a slip point BAD in WL sigma strip "
                //   << GDCUnique << " " << sat
                //   << " " << time(i).printf(outFormat) << " " << i << endl;
             }
-            spdvector[i].flag = BAD;
+            flags[i] = BAD;
             learn["points deleted: WL sigma stripping"]++;
             it->npts--;
             it->WLStats.Subtract(wlbias);
          }
          else if(haveslip) {
-            spdvector[i].flag = slip;
+            flags[i] = slip;
             haveslip = false;
          }
 
@@ -1296,7 +1383,7 @@ try {
    // change nbeg, but don't change the bias
    if(haveslip) {
       it->nbeg = slipindex;
-      //wlbias = spdvector[slipindex].data[P1];
+      //wlbias = obsData[P1][slipindex];
       //it->bias1 = long(wlbias+(wlbias > 0 ? 0.5 : -0.5));
    }
 
@@ -1305,8 +1392,8 @@ try {
       deleteSegment(it,"WL sigma stripping");
    else {
       // update nbeg and nend // TD add limit 0 size()
-      while(it->nbeg < it->nend && !(spdvector[it->nbeg].flag & OK)) it->nbeg++;
-      while(it->nend > it->nbeg && !(spdvector[it->nend].flag & OK)) it->nend--;
+      while(it->nbeg < it->nend && !(flags[it->nbeg] & OK)) it->nbeg++;
+      while(it->nend > it->nbeg && !(flags[it->nend] & OK)) it->nend--;
    }
 
 }
@@ -1342,15 +1429,15 @@ try {
 
    // fill up the future window to size 'width', but don't go beyond the segment
    while(futureStats.N() < width && iplus <= it->nend) {
-      if(spdvector[iplus].flag & OK) {                // add only good data
-         futureStats.Add(spdvector[iplus].data[P1] - it->bias1);
+      if(flags[iplus] & OK) {                // add only good data
+         futureStats.Add(obsData[P1][iplus] - it->bias1);
       }
       iplus++;
    }
 
    // now loop over all points in the segment
    for(i=it->nbeg; i<= it->nend; i++) {
-      if(!(spdvector[i].flag & OK))                      // add only good data
+      if(!(flags[i] & OK))                      // add only good data
          continue;
 
       // compute test and limit
@@ -1359,10 +1446,10 @@ try {
          test = fabs(futureStats.Average()-pastStats.Average());
       limit = ::sqrt(futureStats.Variance() + pastStats.Variance());
       // 'change the arrays' A1 and A2
-      spdvector[i].data[A1] = test;
-      spdvector[i].data[A2] = limit;
+      obsData[A1][i] = test;
+      obsData[A2][i] = limit;
 
-      wlbias = spdvector[i].data[P1] - it->bias1;        // debiased WLbias
+      wlbias = obsData[P1][i] - it->bias1;        // debiased WLbias
 
       // dump the stats
       if(cfg(Debug) >= 6) log << "WLS " << GDCUnique
@@ -1375,8 +1462,8 @@ try {
          << " " << setw(3) << futureStats.N()
          << " " << setw(7) << futureStats.Average()
          << " " << setw(7) << futureStats.StdDev()
-         << " " << setw(9) << spdvector[i].data[A1]
-         << " " << setw(9) << spdvector[i].data[A2]
+         << " " << setw(9) << obsData[A1][i]
+         << " " << setw(9) << obsData[A2][i]
          << " " << setw(9) << wlbias
          << " " << setw(3) << i
          << endl;
@@ -1387,15 +1474,15 @@ try {
       pastStats.Add(wlbias);
       // ... and move iplus up by one (good) point, ...
       while(futureStats.N() < width && iplus <= it->nend) {
-         if(spdvector[iplus].flag & OK) {
-            futureStats.Add(spdvector[iplus].data[P1] - it->bias1);
+         if(flags[iplus] & OK) {
+            futureStats.Add(obsData[P1][iplus] - it->bias1);
          }
          iplus++;
       }
       // ... and move iminus up by one good point
       while(pastStats.N() > width && iminus <= it->nend) {// <= nend not really nec.
-         if(spdvector[iminus].flag & OK) {
-            pastStats.Subtract(spdvector[iminus].data[P1] - it->bias1);
+         if(flags[iminus] & OK) {
+            pastStats.Subtract(obsData[P1][iminus] - it->bias1);
          }
          iminus++;
       }
@@ -1448,11 +1535,11 @@ try {
          }
       }
 
-      if(spdvector[i].flag & OK) {
+      if(flags[i] & OK) {
          nok++;                                 // nok = # good points in segment
 
          if(nok == 1) {                         // change the bias, as WLStats reset
-            wlbias = spdvector[i].data[P1];
+            wlbias = obsData[P1][i];
             it->bias1 = long(wlbias+(wlbias > 0 ? 0.5 : -0.5));
          }
 
@@ -1464,7 +1551,7 @@ try {
             if(cfg(Debug) >= 6) log << "too near end " << GDCUnique
                << " " << i << " " << nok << " " << it->npts-nok
                << " " << time(i).printf(outFormat)
-               << " " << spdvector[i].data[A1] << " " << spdvector[i].data[A2]
+               << " " << obsData[A1][i] << " " << obsData[A2][i]
                << endl;
          }
          else if(foundWLsmallSlip(it,i)) { // met condition 3
@@ -1476,18 +1563,18 @@ try {
             it = createSegment(it,i,"WL slip small");
 
             // mark it
-            spdvector[i].flag |= WLDETECT;
+            flags[i] |= WLDETECT;
 
             // prep for next segment
             // biases remain the same in the new segment
             it->npts = k - nok;
             nok = 0;
             it->WLStats.Reset();
-            wlbias = spdvector[i].data[P1]; // change the bias, as WLStats reset
+            wlbias = obsData[P1][i]; // change the bias, as WLStats reset
             it->bias1 = long(wlbias+(wlbias > 0 ? 0.5 : -0.5));
          }
 
-         it->WLStats.Add(spdvector[i].data[P1] - it->bias1);
+         it->WLStats.Add(obsData[P1][i] - it->bias1);
 
       } // end if good data
 
@@ -1525,8 +1612,8 @@ try {
    // A1 = test = fabs(futureStats.Average() - pastStats.Average());
    // A2 = limit = ::sqrt(futureStats.Variance() + pastStats.Variance());
    // all units WL cycles
-   double test = spdvector[i].data[A1];
-   double lim = spdvector[i].data[A2];
+   double test = obsData[A1][i];
+   double lim = obsData[A2][i];
 
    // 050109 if Debug=6, print only possible slips, if 7 print all
    bool isSlip=false;
@@ -1541,11 +1628,11 @@ try {
          //<< " " << it->npts << "pt"
          << fixed << setprecision(2)
          << " test=" << test << " lim=" << lim
-         << " (1)" << spdvector[i].data[A1]
-         << (spdvector[i].data[A1] > cfg(WLSlipSize) ? ">" : "<=")
+         << " (1)" << obsData[A1][i]
+         << (obsData[A1][i] > cfg(WLSlipSize) ? ">" : "<=")
          << cfg(WLSlipSize)
-         << " (2)" << spdvector[i].data[A1]-spdvector[i].data[A2]
-         << (spdvector[i].data[A1]-spdvector[i].data[A2]>cfg(WLSlipExcess)?">":"<=")
+         << " (2)" << obsData[A1][i]-obsData[A2][i]
+         << (obsData[A1][i]-obsData[A2][i]>cfg(WLSlipExcess)?">":"<=")
          << cfg(WLSlipExcess); // no endl
 
       // CONDITION 1  ||  CONDITION 2
@@ -1566,20 +1653,20 @@ try {
       jp = jm = i;
       do {
          // find next good point in future
-         do { jp++; } while(jp < it->nend && !(spdvector[jp].flag & OK));
+         do { jp++; } while(jp < it->nend && !(flags[jp] & OK));
          if(jp >= it->nend) break;
             // CONDITION 4: test(A1) is a local maximum
-         if(spdvector[i].data[A1]-spdvector[jp].data[A1] > j*slope) pass4++;
+         if(obsData[A1][i]-obsData[A1][jp] > j*slope) pass4++;
             // CONDITION 5: limit(A2) is a local minimum
-         if(spdvector[i].data[A2]-spdvector[jp].data[A2] < -j*slope) pass5++;
+         if(obsData[A2][i]-obsData[A2][jp] < -j*slope) pass5++;
 
          // find next good point in past
-         do { jm--; } while(jm > it->nbeg && !(spdvector[jm].flag & OK));
+         do { jm--; } while(jm > it->nbeg && !(flags[jm] & OK));
          if(jm <= it->nbeg) break;
             // CONDITION 4: test(A1) is a local maximum
-         if(spdvector[i].data[A1]-spdvector[jm].data[A1] > j*slope) pass4++;
+         if(obsData[A1][i]-obsData[A1][jm] > j*slope) pass4++;
             // CONDITION 5: limit(A2) is a local minimum
-         if(spdvector[i].data[A2]-spdvector[jm].data[A2] < -j*slope) pass5++;
+         if(obsData[A2][i]-obsData[A2][jm] < -j*slope) pass5++;
 
       } while(++j < minMaxWidth);
 
@@ -1659,8 +1746,8 @@ try {
    if(which == string("WL")) {                                    // WL
       WLPassStats.Reset();
       for(i=kt->nbeg; i <= kt->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
-         WLPassStats.Add(spdvector[i].data[P1] - kt->bias1);
+         if(!(flags[i] & OK)) continue;
+         WLPassStats.Add(obsData[P1][i] - kt->bias1);
       }
       // NB Now you have a measure of range noise for the whole pass :
       // sigma(WLbias) ~ sigma(WLrange) = 0.71*sigma(range), so
@@ -1673,14 +1760,14 @@ try {
    else {                                                         // GF
       //dumpSegments("GFFbefRebias",2,true); //temp
       for(ifirst=-1,i=kt->nbeg; i <= kt->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(flags[i] & OK)) continue;
          if(ifirst == -1) {
             ifirst = i;
-            kt->bias2 = spdvector[ifirst].data[L2] + spdvector[ifirst].data[P2];
-            kt->bias1 = spdvector[ifirst].data[P1];
+            kt->bias2 = obsData[L2][ifirst] + obsData[P2][ifirst];
+            kt->bias1 = obsData[P1][ifirst];
          }
          // change the data - recompute GFR-GFP so it has one consistent bias
-         spdvector[i].data[L1] = spdvector[i].data[L2] + spdvector[i].data[P2];
+         obsData[L1][i] = obsData[L2][i] + obsData[P2][i];
       }
    }
 
@@ -1799,12 +1886,12 @@ try {
 
    // now do the fixing - change the data in the right segment to match left's
    for(i=right->nbeg; i<=right->nend; i++) {
-      //if(!(spdvector[i].flag & OK)) continue;
-      spdvector[i].data[P1] -= nwl;                                 // WLbias
-      spdvector[i].data[L2] -= nwl * wl2;                           // GFP
+      //if(!(flags[i] & OK)) continue;
+      obsData[P1][i] -= nwl;                                 // WLbias
+      obsData[L2][i] -= nwl * wl2;                           // GFP
       // add to WLStats
-      //if(!(spdvector[i].flag & OK)) continue;
-      //left->WLStats.Add(spdvector[i].data[P1] - left->bias1);
+      //if(!(flags[i] & OK)) continue;
+      //left->WLStats.Add(obsData[P1][i] - left->bias1);
    }
 
    // fix the slips beyond the 'right' segment.
@@ -1817,9 +1904,9 @@ try {
       // can build up and produce errors.
       it->bias1 -= dwl;
       for(i=it->nbeg; i<=it->nend; i++) {
-         //if(!(spdvector[i].flag & OK)) continue;                 // TD don't?
-         spdvector[i].data[P1] -= nwl;                                 // WLbias
-         spdvector[i].data[L2] -= nwl * wl2;                           // GFP
+         //if(!(flags[i] & OK)) continue;                 // TD don't?
+         obsData[P1][i] -= nwl;                                 // WLbias
+         obsData[L2][i] -= nwl * wl2;                           // GFP
       }
    }
 
@@ -1830,7 +1917,7 @@ try {
    SlipList.push_back(newSlip);
 
    // mark it
-   spdvector[right->nbeg].flag |= WLFIX;
+   flags[right->nbeg] |= WLFIX;
 
    return;
 }
@@ -1864,11 +1951,11 @@ try {
    nl = 0;
    ilast = -1;                               // ilast is last good point before slip
    while(nb > left->nbeg && i < Npts) {
-      if(spdvector[nb].flag & OK) {
+      if(flags[nb] & OK) {
          if(ilast == -1) ilast = nb;
          i++; nl++;
-         Lstats.Add(spdvector[nb].data[L1] - left->bias2);
-//log << "LDATA " << nb << " " << spdvector[nb].data[L1]-left->bias2 << endl;
+         Lstats.Add(obsData[L1][nb] - left->bias2);
+//log << "LDATA " << nb << " " << obsData[L1][nb]-left->bias2 << endl;
       }
       nb--;
    }
@@ -1876,10 +1963,10 @@ try {
    i = 1;
    nr = 0;
    while(ne < right->nend && i < Npts) {
-      if(spdvector[ne].flag & OK) {
+      if(flags[ne] & OK) {
          i++; nr++;
-         Rstats.Add(spdvector[ne].data[L1] - right->bias2);
-//log << "RDATA " << ne << " " << spdvector[ne].data[L1]-right->bias2 << endl;
+         Rstats.Add(obsData[L1][ne] - right->bias2);
+//log << "RDATA " << ne << " " << obsData[L1][ne]-right->bias2 << endl;
       }
       ne++;
    }
@@ -1891,8 +1978,8 @@ try {
    // ultimately, GFR-GFP is accurate but noisy.
    // rms rof should tell you how much weight to put on rof
    // larger rof -> smaller npts and larger degree
-   dn1 = spdvector[right->nbeg].data[L2] - right->bias2
-         - (spdvector[ilast].data[L2] - left->bias2);
+   dn1 = obsData[L2][right->nbeg] - right->bias2
+         - (obsData[L2][ilast] - left->bias2);
    // this screws up most fixes
    //dn1 = Rstats.Average() - right->bias2 - (Lstats.Average() - left->bias2);
    n1 = long(dn1 + (dn1 > 0 ? 0.5 : -0.5));
@@ -1949,10 +2036,10 @@ try {
    // now do the fixing : 'change the data' within right segment
    // and through the end of the pass, to fix the slip
    for(i=right->nbeg; i<size(); i++) {
-      //if(!(spdvector[i].flag & OK)) continue;                 // TD? don't?
-      //spdvector[i].data[P1] -= nwl;                           // no change to WLbias
-      spdvector[i].data[L2] -= n1;                              // GFP
-      spdvector[i].data[L1] -= n1;                              // GFR+GFP
+      //if(!(flags[i] & OK)) continue;                 // TD? don't?
+      //obsData[P1][i] -= nwl;                           // no change to WLbias
+      obsData[L2][i] -= n1;                              // GFP
+      obsData[L1][i] -= n1;                              // GFR+GFP
    }
 
    // 'change the bias'  for all segments in the future (although right to be deleted)
@@ -1977,7 +2064,7 @@ try {
    }
 
    // mark it
-   spdvector[right->nbeg].flag |= GFFIX;
+   flags[right->nbeg] |= GFFIX;
 
    return;
 }
@@ -2017,14 +2104,14 @@ try {
 
          // add all the data
          for(i=nb; i<=ne; i++) {
-            if(!(spdvector[i].flag & OK)) continue;
+            if(!(flags[i] & OK)) continue;
             PF[in[k]].Add(
                // data
-               spdvector[i].data[L2]
+               obsData[L2][i]
                // - (either               left bias - poss. slip : right bias)
                   - (i < right->nbeg ? left->bias2-n1-(nadj+k-1) : right->bias2),
                //  use a debiased count
-               spdvector[i].ndt - spdvector[nb].ndt
+               counts[i] - counts[nb]
             );
          }
 
@@ -2033,11 +2120,11 @@ try {
          // compute RMS residual of fit
          rmsrof[in[k]] = 0.0;
          for(i=nb; i<=ne; i++) {
-            if(!(spdvector[i].flag & OK)) continue;
+            if(!(flags[i] & OK)) continue;
             rof =    // data minus fit
-               spdvector[i].data[L2]
+               obsData[L2][i]
                   - (i < right->nbeg ? left->bias2-n1-(nadj+k-1) : right->bias2)
-               - PF[in[k]].Evaluate(spdvector[i].ndt - spdvector[nb].ndt);
+               - PF[in[k]].Evaluate(counts[i] - counts[nb]);
             rmsrof[in[k]] += rof*rof;
          }
          rmsrof[in[k]] = ::sqrt(rmsrof[in[k]]);
@@ -2101,15 +2188,15 @@ try {
 
    // dump the raw data with all the fits
    if(cfg(Debug) >= 4) for(i=nb; i<=ne; i++) {
-      if(!(spdvector[i].flag & OK)) continue;
+      if(!(flags[i] & OK)) continue;
       log << "GFE " << GDCUnique << " " << sat
          << " " << GDCUniqueFix
          << " " << time(i).printf(outFormat)
-         << " " << setw(2) << spdvector[i].flag << fixed << setprecision(3);
-      for(k=0; k<3; k++) log << " " << spdvector[i].data[L2]
+         << " " << setw(2) << flags[i] << fixed << setprecision(3);
+      for(k=0; k<3; k++) log << " " << obsData[L2][i]
             - (i < right->nbeg ? left->bias2-n1-(nadj+k-1) : right->bias2)
-         << " " << PF[in[k]].Evaluate(spdvector[i].ndt - spdvector[nb].ndt);
-      log << " " << setw(3) << spdvector[i].ndt << endl;
+         << " " << PF[in[k]].Evaluate(counts[i] - counts[nb]);
+      log << " " << setw(3) << counts[i] << endl;
    }
 
    return nadj;
@@ -2142,14 +2229,14 @@ try {
    GFPassFit.Reset(ndeg);
 
    for(first=true,i=nbeg; i <= nend; i++) {
-      if(!(spdvector[i].flag & OK)) continue;
+      if(!(flags[i] & OK)) continue;
 
       // 'change the bias' (initial bias only) in the GFP by changing units, also
       // slip fixing in the WL may have changed the values of GFP
       if(first) {
 //temp uncomment next 3 lines then comment again
-         //if(fabs(spdvector[i].data[L2] - SegList.begin()->bias2) > 10.*wl21) {
-         //   SegList.begin()->bias2 = spdvector[i].data[L2];
+         //if(fabs(obsData[L2][i] - SegList.begin()->bias2) > 10.*wl21) {
+         //   SegList.begin()->bias2 = obsData[L2][i];
          //}
          SegList.begin()->bias2 /= wl21;
          first = false;
@@ -2157,18 +2244,18 @@ try {
 
       // 'change the arrays'
       // change units on the GFP and the GFR
-      spdvector[i].data[P2] /= wl21;                    // -gfr (cycles of wl21)
-      spdvector[i].data[L2] /= wl21;                    // gfp (cycles of wl21)
+      obsData[P2][i] /= wl21;                    // -gfr (cycles of wl21)
+      obsData[L2][i] /= wl21;                    // gfp (cycles of wl21)
 
       // compute polynomial fit
-      GFPassFit.Add(spdvector[i].data[P2],spdvector[i].ndt);
+      GFPassFit.Add(obsData[P2][i],counts[i]);
 
       // 'change the data'
       // save in L1                          // gfp+gfr residual (cycles of wl21)
-      // ?? spdvector[i].data[L1] =
-      //    spdvector[i].data[L2] - spdvector[i].data[P2] - SegList.begin()->bias2;
+      // ?? obsData[L1][i] =
+      //    obsData[L2][i] - obsData[P2][i] - SegList.begin()->bias2;
 // temp add -bias2  then remove it again
-      spdvector[i].data[L1] = spdvector[i].data[L2] - spdvector[i].data[P2];
+      obsData[L1][i] = obsData[L2][i] - obsData[P2][i];
                                  // - SegList.begin()->bias2;
    }
 
@@ -2206,15 +2293,15 @@ try {
 
       // compute stats on dGF/dt
       for(i=it->nbeg; i <= it->nend; i++) {
-         if(!(spdvector[i].flag & OK)) continue;
+         if(!(flags[i] & OK)) continue;
 
          // compute first-diff stats in meters
          // skip the first point in a segment - it is an obvious GF slip
-         if(i > it->nbeg) GFPassStats.Add(spdvector[i].data[A1]*wl21);
+         if(i > it->nbeg) GFPassStats.Add(obsData[A1][i]*wl21);
 
          // if a gross GF slip was found, must remove bias in L1=GF(R-P)
          // in all subsequent segments ; 'change the data' L1
-         //temp if(it != SegList.begin()) spdvector[i].data[L1] += bias - it->bias2;
+         //temp if(it != SegList.begin()) obsData[L1][i] += bias - it->bias2;
 
       }  // end loop over data in segment it
 
@@ -2281,8 +2368,8 @@ try {
    it->PF.Reset(ndeg);     // for fit to GF range
 
    for(i=it->nbeg; i <= it->nend; i++) {
-      if(!(spdvector[i].flag & OK)) continue;
-      it->PF.Add(spdvector[i].data[P2],spdvector[i].ndt);
+      if(!(flags[i] & OK)) continue;
+      it->PF.Add(obsData[P2][i],counts[i]);
    }
 
    if(it->PF.isSingular()) {     // this should never happen
@@ -2296,41 +2383,41 @@ try {
    rofStats.Reset();
    for(i=it->nbeg; i <= it->nend; i++) {
       // skip bad data
-      if(!(spdvector[i].flag & OK)) continue;
+      if(!(flags[i] & OK)) continue;
       
       // TD? Use whole pass for small segments?
-      //fit = GFPassFit.Evaluate(spdvector[i].ndt);  // use fit to gfr for whole pass
-      fit = it->PF.Evaluate(spdvector[i].ndt);
+      //fit = GFPassFit.Evaluate(counts[i]);  // use fit to gfr for whole pass
+      fit = it->PF.Evaluate(counts[i]);
 
       // all (fit, resid, gfr and gfp) are in cycles of wl21 (5.4cm)
 
       // compute gfp-(fit to gfr), store in A1 - 'change the arrays' A1 and A2
       // OR let's try first difference of residual of fit
       //           residual =  phase                            - fit to range
-      spdvector[i].data[A1] = spdvector[i].data[L2] - it->bias2 - fit;
+      obsData[A1][i] = obsData[L2][i] - it->bias2 - fit;
       if(rbias == 0.0) {
-         rbias = spdvector[i].data[A1];
-         nprev = spdvector[i].ndt - 1;
+         rbias = obsData[A1][i];
+         nprev = counts[i] - 1;
       }
-      spdvector[i].data[A1] -= rbias;                    // debias residual for plots
+      obsData[A1][i] -= rbias;                    // debias residual for plots
 
          // compute stats on residual of fit
-      rofStats.Add(spdvector[i].data[A1]);
+      rofStats.Add(obsData[A1][i]);
 
       if(1) { // 1stD of residual - remember A1 has just been debiased
-         tmp = spdvector[i].data[A1];
-         spdvector[i].data[A1] -= prev;       // diff with previous epoch's
+         tmp = obsData[A1][i];
+         obsData[A1][i] -= prev;       // diff with previous epoch's
          // 040809 should this be divided by delta n?
-         // spdvector[i].data[A1] /= (spdvector[i].ndt - nprev);
+         // obsData[A1][i] /= (counts[i] - nprev);
          prev = tmp;          // store residual for next point
-         nprev = spdvector[i].ndt;
+         nprev = counts[i];
       }
       
       // store fit in A2
-      //spdvector[i].data[A2] = fit;                   // fit to gfr (cycles of wl21)
+      //obsData[A2][i] = fit;                   // fit to gfr (cycles of wl21)
       // store raw residual GFP-GFR (cycles of wl21) in A2
-      //spdvector[i].data[A2]
-      //    = spdvector[i].data[L2] - it->bias2 - spdvector[i].data[P2];
+      //obsData[A2][i]
+      //    = obsData[L2][i] - it->bias2 - obsData[P2][i];
    }
 
    // TD? need this? use this?
@@ -2383,21 +2470,21 @@ try {
       for(iplus=it->nbeg; iplus<=it->nend+width; iplus++) {
 
          // ignore bad points
-         if(iplus <= it->nend && !(spdvector[iplus].flag & OK)) continue;
+         if(iplus <= it->nend && !(flags[iplus] & OK)) continue;
          if(ifirst == -1) ifirst = iplus;
 
          // pop the new i from the future
          if(futureIndex.size() == width || iplus > it->nend) {
             inew = futureIndex.front();
             futureIndex.pop_front();
-            futureStats.Subtract(spdvector[inew].data[A1]);
+            futureStats.Subtract(obsData[A1][inew]);
             nok++;
          }
 
          // put iplus into the future deque
          if(iplus <= it->nend) {
             futureIndex.push_back(iplus);
-            futureStats.Add(spdvector[iplus].data[A1]);
+            futureStats.Add(obsData[A1][iplus]);
          }
          else
             futureIndex.push_back(-1);
@@ -2413,15 +2500,15 @@ try {
          if(foundGFoutlier(i,inew,pastStats,futureStats)) {
             // check that i was not marked a slip in the last iteration
             // if so, let inew be the slip and i the outlier
-            if(spdvector[i].flag & DETECT) {
+            if(flags[i] & DETECT) {
                //log << "Warning - marking a slip point BAD in GF detect small "
                //   << GDCUnique << " " << sat
                //   << " " << time(i).printf(outFormat) << " " << i << endl;
-               spdvector[inew].flag = spdvector[i].flag;
+               flags[inew] = flags[i];
                it->nbeg = inew;
             }
-            spdvector[i].flag = BAD;
-            spdvector[inew].data[A1] += spdvector[i].data[A1];
+            flags[i] = BAD;
+            obsData[A1][inew] += obsData[A1][i];
             learn["points deleted: GF outlier"]++;
             i = inew;
             nok--;
@@ -2431,13 +2518,13 @@ try {
          if(pastIndex.size() == width) {
             j = pastIndex.front();
             pastIndex.pop_front();
-            pastStats.Subtract(spdvector[j].data[A1]);
+            pastStats.Subtract(obsData[A1][j]);
          }
 
          // move i into the past
          if(i > -1) {
             pastIndex.push_back(i);
-            pastStats.Add(spdvector[i].data[A1]);
+            pastStats.Add(obsData[A1][i]);
          }
 
          // return to original state
@@ -2453,7 +2540,7 @@ try {
             nok = 1;
 
             // mark it
-            spdvector[i].flag |= GFDETECT;
+            flags[i] |= GFDETECT;
 
             // TD print the "possible GF slip" and timetag here - see WLS
          }
@@ -2478,8 +2565,8 @@ bool GDCPass::foundGFoutlier(int i, int inew,
 try {
    if(i < 0 || inew < 0) return false;
    bool ok;
-   double pmag = spdvector[i].data[A1]; // -pastSt.Average();
-   double fmag = spdvector[inew].data[A1]; // -futureSt.Average();
+   double pmag = obsData[A1][i]; // -pastSt.Average();
+   double fmag = obsData[A1][inew]; // -futureSt.Average();
    double var = ::sqrt(pastSt.Variance() + futureSt.Variance());
 
    ostringstream oss;
@@ -2539,8 +2626,8 @@ try {
    pmag = fmag = pvar = fvar = 0.0;
    // note when past.N == 1, this is first good point, which has 1stD==0
    // TD be very careful when N is small
-   if(pastSt.N() > 0) pmag = spdvector[i].data[A1]-pastSt.Average();
-   if(futureSt.N() > 0) fmag = spdvector[i].data[A1]-futureSt.Average();
+   if(pastSt.N() > 0) pmag = obsData[A1][i]-pastSt.Average();
+   if(futureSt.N() > 0) fmag = obsData[A1][i]-futureSt.Average();
    if(pastSt.N() > 1) pvar = pastSt.Variance();
    if(futureSt.N() > 1) fvar = futureSt.Variance();
    mag = (pmag + fmag) / 2.0;
@@ -2568,7 +2655,7 @@ try {
       << " " << setw(7) << futureSt.StdDev()
       << " " << setw(7) << mag
       << " " << setw(7) << ::sqrt(pvar+fvar)
-      << " " << setw(9) << spdvector[i].data[A1]
+      << " " << setw(9) << obsData[A1][i]
       << " " << setw(7) << pmag
       << " " << setw(7) << pvar
       << " " << setw(7) << fmag
@@ -2638,10 +2725,10 @@ try {
          double magGFR,mtnGFR;
          Stats<double> pGFRmPh,fGFRmPh;
          for(j=0; j<pastIn.size(); j++) {
-            if(pastIn[j] > -1) pGFRmPh.Add(spdvector[pastIn[j]].data[L1]);
-            if(futureIn[j] > -1) fGFRmPh.Add(spdvector[futureIn[j]].data[L1]);
+            if(pastIn[j] > -1) pGFRmPh.Add(obsData[L1][pastIn[j]]);
+            if(futureIn[j] > -1) fGFRmPh.Add(obsData[L1][futureIn[j]]);
          }
-         magGFR = spdvector[i].data[L1] - (pGFRmPh.Average()+fGFRmPh.Average())/2.0;
+         magGFR = obsData[L1][i] - (pGFRmPh.Average()+fGFRmPh.Average())/2.0;
          mtnGFR = fabs(magGFR)/::sqrt(pGFRmPh.Variance()+fGFRmPh.Variance());
          
          if(cfg(Debug) >= 6)
@@ -2669,15 +2756,15 @@ try {
          Stats<double> fdStats;
          j = i-1; k=0;
          while(j >= ibeg && k < 15) {
-            if(spdvector[j].flag & OK) { fdStats.Add(spdvector[j].data[A2]); k++; }
+            if(flags[j] & OK) { fdStats.Add(obsData[A2][j]); k++; }
             j--;
          }
          j = i+1; k=0;
          while(j <= iend && k < 15) {
-            if(spdvector[j].flag & OK) { fdStats.Add(spdvector[j].data[A2]); k++; }
+            if(flags[j] & OK) { fdStats.Add(obsData[A2][j]); k++; }
             j++;
          }
-         magFD = spdvector[i].data[A2] - fdStats.Average();
+         magFD = obsData[A2][i] - fdStats.Average();
 
          if(cfg(Debug) >= 6)
             oss << " (7)1stD(GFP)mag=" << magFD
@@ -2712,24 +2799,24 @@ try {
    // loop over the data and look for points with GFDETECT but not WLDETECT or WLFIX
    for(i=0; i<size(); i++) {
 
-      if(!(spdvector[i].flag & OK)) continue;        // bad
-      if(!(spdvector[i].flag & DETECT)) continue;    // no slips
-      if(spdvector[i].flag & WLDETECT) continue;     // WL was detected
+      if(!(flags[i] & OK)) continue;        // bad
+      if(!(flags[i] & DETECT)) continue;    // no slips
+      if(flags[i] & WLDETECT) continue;     // WL was detected
 
       // GF only slip - compute WL stats on both sides
       Stats<double> futureStats,pastStats;
       k = i;
       // fill future
       while(k < size() && futureStats.N() < N) {
-         if(spdvector[k].flag & OK)                  // data is good
-            futureStats.Add(spdvector[k].data[P1]);        // wlbias
+         if(flags[k] & OK)                  // data is good
+            futureStats.Add(obsData[P1][k]);        // wlbias
          k++;
       }
       // fill past
       k = i-1;
       while(k >= 0 && pastStats.N() < N) {
-         if(spdvector[k].flag & OK)                  // data is good
-            pastStats.Add(spdvector[k].data[P1]);          // wlbias
+         if(flags[k] & OK)                  // data is good
+            pastStats.Add(obsData[P1][k]);          // wlbias
          k--;
       }
 
@@ -2751,9 +2838,9 @@ try {
 
          // now do the fixing - change the data to the future of the slip
          for(k=i; k<size(); k++) {
-            //if(!(spdvector[i].flag & OK)) continue;
-            spdvector[k].data[P1] -= nwl;                                 // WLbias
-            spdvector[k].data[L2] -= nwl * factor;                        // GFP
+            //if(!(flags[i] & OK)) continue;
+            obsData[P1][k] -= nwl;                                 // WLbias
+            obsData[L2][k] -= nwl * factor;                        // GFP
          }
          
          // Add to slip list
@@ -2763,7 +2850,7 @@ try {
          SlipList.push_back(newSlip);
 
          // mark it
-         spdvector[i].flag |= (WLDETECT + WLFIX);
+         flags[i] |= (WLDETECT + WLFIX);
 
          if(cfg(Debug) >= 7) log << "CHECK " << GDCUnique << " " << sat
             << " " << i
@@ -2807,6 +2894,10 @@ try {
    list<Slip>::iterator jt;
    string retMessage;
 
+   // indexes of the obs types L1,L2,C1/P1,P2 in the input SatPass
+   vector<int> svpIndex(4);
+   for(i=0; i<4; i++) svpIndex[i] = svp.getIndex(DCobstypes[i]);
+
    // ---------------------------------------------------------
    // sort the slips in time
    SlipList.sort();
@@ -2825,7 +2916,7 @@ try {
    for(i=0; i<size(); i++) {
 
       // is this point bad?
-      if(!(spdvector[i].flag & OK)) {       // data is bad
+      if(!(flags[i] & OK)) {       // data is bad
          ok = false;
          if(i == size() - 1) {    // but this is the last point 
             i++;
@@ -2922,30 +3013,30 @@ try {
       if(i >= size()) break;
 
       // 'change the data' for the last time
-      spdvector[i].data[L1] = svp.data(i,DCobstypes[L1]) - slipL1;
-      spdvector[i].data[L2] = svp.data(i,DCobstypes[L2]) - slipL2;
-      spdvector[i].data[P1] = svp.data(i,DCobstypes[P1]);
-      spdvector[i].data[P2] = svp.data(i,DCobstypes[P2]);
+      obsData[L1][i] = svp.data(i,svpIndex[L1]) - slipL1;
+      obsData[L2][i] = svp.data(i,svpIndex[L2]) - slipL2;
+      obsData[P1][i] = svp.data(i,svpIndex[P1]);
+      obsData[P2][i] = svp.data(i,svpIndex[P2]);
 
       // compute range minus phase for output
       // do the same at the beginning ("BEG")
 
       // compute WL and GFP
          // narrow lane range (m)
-      double wlr = wl1r * spdvector[i].data[P1] + wl2r * spdvector[i].data[P2];
+      double wlr = wl1r * obsData[P1][i] + wl2r * obsData[P2][i];
          // wide lane phase (m)
-      double wlp = wl1p * spdvector[i].data[L1] + wl2p * spdvector[i].data[L2];
+      double wlp = wl1p * obsData[L1][i] + wl2p * obsData[L2][i];
          // geo-free range (m)
-      double gfr = gf1r * spdvector[i].data[P1] + gf2r * spdvector[i].data[P2];
+      double gfr = gf1r * obsData[P1][i] + gf2r * obsData[P2][i];
          // geo-free phase (m)
-      double gfp = gf1p * spdvector[i].data[L1] + gf2p * spdvector[i].data[L2];
+      double gfp = gf1p * obsData[L1][i] + gf2p * obsData[L2][i];
       if(i == ifirst) {
          WLbias = (wlp-wlr)/wlwl;
          GFbias = gfp;
       }
-      spdvector[i].data[A1] = (wlp-wlr)/wlwl - WLbias; // wide lane bias (cyc)
-      spdvector[i].data[A2] = gfp - GFbias;            // geo-free phase (m)
-      //spdvector[i].data[A2] = gfr - gfp;             // geo-free range - phase (m)
+      obsData[A1][i] = (wlp-wlr)/wlwl - WLbias; // wide lane bias (cyc)
+      obsData[A2][i] = gfp - GFbias;            // geo-free phase (m)
+      //obsData[A2][i] = gfr - gfp;             // geo-free range - phase (m)
 
    } // end loop over all data
 
@@ -2967,10 +3058,10 @@ try {
    // ---------------------------------------------------------
    // copy corrected data into original SatPass, without disturbing other obs types
    for(i=0; i<size(); i++) {
-      svp.data(i,DCobstypes[L1]) = spdvector[i].data[L1];
-      svp.data(i,DCobstypes[L2]) = spdvector[i].data[L2];
-      svp.data(i,DCobstypes[P1]) = spdvector[i].data[P1];
-      svp.data(i,DCobstypes[P2]) = spdvector[i].data[P2];
+      svp.data(i,svpIndex[L1]) = obsData[L1][i];
+      svp.data(i,svpIndex[L2]) = obsData[L2][i];
+      svp.data(i,svpIndex[P1]) = obsData[P1][i];
+      svp.data(i,svpIndex[P2]) = obsData[P2][i];
 
       // change the flag for use by SatPass
       //const unsigned short SatPass::OK  = 1; good data
@@ -2980,20 +3071,20 @@ try {
       //const unsigned short SatPass::LL3 = 6; discontinuity on L1 and L2
       //const unsigned short GDCPass::DETECT   =   6;  // = WLDETECT | GFDETECT
       //const unsigned short GDCPass::FIX      =  24;  // = WLFIX | GFFIX
-      if(spdvector[i].flag & OK) {
-//??     if(((spdvector[i].flag & DETECT)!=0 && (spdvector[i].flag & FIX)==0)
-         if(((spdvector[i].flag & DETECT)==0 && (spdvector[i].flag & FIX)!=0)
+      if(flags[i] & OK) {
+//??     if(((flags[i] & DETECT)!=0 && (flags[i] & FIX)==0)
+         if(((flags[i] & DETECT)==0 && (flags[i] & FIX)!=0)
             || i == ifirst)
-            spdvector[i].flag = LL3 + OK;
+            flags[i] = LL3 + OK;
          else
-            spdvector[i].flag = OK;
+            flags[i] = OK;
       }
       else
-         spdvector[i].flag = BAD;
+         flags[i] = BAD;
 
-      svp.LLI(i,DCobstypes[L1]) = (spdvector[i].flag & LL1) ? 1 : 0;
-      svp.LLI(i,DCobstypes[L2]) = (spdvector[i].flag & LL2) ? 1 : 0;
-      svp.setFlag(i,spdvector[i].flag);
+      svp.LLI(i,svpIndex[L1]) = (flags[i] & LL1) ? 1 : 0;
+      svp.LLI(i,svpIndex[L2]) = (flags[i] & LL2) ? 1 : 0;
+      svp.setFlag(i,flags[i]);
    }
 
    // ---------------------------------------------------------
@@ -3093,8 +3184,8 @@ try {
    sit->nend = ibeg-1;
 
    // 'trim' beg and end indexes
-   while(s.nend > s.nbeg && !(spdvector[s.nend].flag & OK)) s.nend--;
-   while(sit->nend > sit->nbeg && !(spdvector[sit->nend].flag & OK)) sit->nend--;
+   while(s.nend > s.nbeg && !(flags[s.nend] & OK)) s.nend--;
+   while(sit->nend > sit->nbeg && !(flags[sit->nend] & OK)) sit->nend--;
 
    // get the segment number right
    s.nseg++;
@@ -3143,8 +3234,8 @@ try {
    ilast = -1;                               // last good point
    for(it=SegList.begin(); it != SegList.end(); it++) {
       //if(it->npts > 0) {
-      //   biaswl = spdvector[it->nbeg].data[P1];
-      //   biasgf = spdvector[it->nbeg].data[L2];
+      //   biaswl = obsData[P1][it->nbeg];
+      //   biasgf = obsData[L2][it->nbeg];
       //}
       //else biaswl = biasgf = 0.0;
 
@@ -3164,13 +3255,13 @@ try {
             << " bias(gf)=" << setw(13) << it->bias2; //biasgf;
          if(ilast > -1) {
             ifirst = it->nbeg;
-            while(ifirst <= it->nend && !(spdvector[ifirst].flag & OK)) ifirst++;
-            i = spdvector[ifirst].ndt - spdvector[ilast].ndt;
+            while(ifirst <= it->nend && !(flags[ifirst] & OK)) ifirst++;
+            i = counts[ifirst] - counts[ilast];
             oss << " Gap " << setprecision(1) << setw(5)
                << cfg(DT)*i << " s = " << i << " pts.";
          }
          ilast = it->nend;
-         while(ilast >= it->nbeg && !(spdvector[ilast].flag & OK)) ilast--;
+         while(ilast >= it->nbeg && !(flags[ilast] & OK)) ilast--;
       }
 
       oss << endl;
@@ -3183,20 +3274,20 @@ try {
       // dump the data
    for(it=SegList.begin(); it != SegList.end(); it++) {
       for(i=it->nbeg; i<=it->nend; i++) {
-         //if(!(spdvector[i].flag & OK)) continue;  //dfplot ignores bad data
+         //if(!(flags[i] & OK)) continue;  //dfplot ignores bad data
 
          log << "DSC" << label << " " << GDCUnique << " " << sat << " " << it->nseg
             << " " << time(i).printf(outFormat)
-            << " " << setw(3) << spdvector[i].flag
+            << " " << setw(3) << flags[i]
             << fixed << setprecision(3)
-            << " " << setw(13) << spdvector[i].data[L1] - it->bias2 //biasgf  //temp
-            << " " << setw(13) << spdvector[i].data[L2] - it->bias2 //biasgf
-            << " " << setw(13) << spdvector[i].data[P1] - it->bias1 //biaswl
-            << " " << setw(13) << spdvector[i].data[P2];
+            << " " << setw(13) << obsData[L1][i] - it->bias2 //biasgf  //temp
+            << " " << setw(13) << obsData[L2][i] - it->bias2 //biasgf
+            << " " << setw(13) << obsData[P1][i] - it->bias1 //biaswl
+            << " " << setw(13) << obsData[P2][i];
          if(extra) log
-            << " " << setw(13) << spdvector[i].data[A1]
-            << " " << setw(13) << spdvector[i].data[A2];
-         log << " " << setw(4) << i;          // TD? make this spdvector[i].ndt?
+            << " " << setw(13) << obsData[A1][i]
+            << " " << setw(13) << obsData[A2][i];
+         log << " " << setw(4) << i;          // TD? make this counts[i]?
          if(i == it->nbeg) log
             << " " << setw(13) << it->bias1 //biaswl
             << " " << setw(13) << it->bias2; //biasgf;
@@ -3225,10 +3316,10 @@ try {
       << endl;
 
    it->npts = 0;
-   for(i=it->nbeg; i<=it->nend; i++) if(spdvector[i].flag & OK) {
+   for(i=it->nbeg; i<=it->nend; i++) if(flags[i] & OK) {
       // count these : learn
       learn["points deleted: " + msg]++;
-      spdvector[i].flag = BAD;
+      flags[i] = BAD;
    }
 
    learn["segments deleted: " + msg]++;
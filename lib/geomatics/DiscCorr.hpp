@@ -39,6 +39,7 @@
 #include "RinexObsHeader.hpp"
 #include "SatPass.hpp"
 #include "Exception.hpp"
+#include "ThreadPool.hpp"
 
 #include <iostream>
 #include <fstream>
@@ -70,12 +71,20 @@ namespace gpstk {
          /// for booleans use (T,F)=(non-zero,zero).
       void setParameter(std::string label, double value) throw(gpstk::Exception);
 
-         /// Get the parameter in the configuration corresponding to label
-      double getParameter(std::string label) throw() { return CFG[label]; }
+         /// Get the parameter in the configuration corresponding to label;
+         /// unknown labels give zero.
+      double getParameter(std::string label) const throw()
+      {
+         std::map<std::string,double>::const_iterator it = CFG.find(label);
+         return (it == CFG.end() ? 0.0 : it->second);
+      }
 
          /// Tell GDCconfiguration to which stream to send debugging output.
       void setDebugStream(std::ostream& os) { p_oflog = &os; }
 
+         /// Get the stream to which debugging output is sent.
+      std::ostream& getDebugStream(void) { return *p_oflog; }
+
          /// Print help page, including descriptions and current values of all
          /// the parameters, to the ostream. If 'advanced' is true, also print
          /// advanced parameters.
@@ -85,6 +94,10 @@ namespace gpstk {
          /// Return version string
       std::string Version() throw() { return GDCVersion; }
 
+         /// Count a pass corrected with this configuration, and return its
+         /// number, which identifies the pass in the debug output.
+      int nextPassNumber() throw() { return ++passNumber; }
+
    protected:
 
          /// map containing configuration labels and their values
@@ -96,6 +109,9 @@ namespace gpstk {
          /// Stream on which to write debug output.
       std::ostream *p_oflog;
 
+         /// Number of the last pass corrected with this configuration.
+      int passNumber;
+
       void initialize(void);
 
       static std::string GDCVersion;
@@ -213,6 +229,76 @@ namespace gpstk {
                               std::string& retMsg)
       throw(Exception);
 
+   /** Reentrant GPSTK Discontinuity Corrector. This is the same as the
+   * routine above, except that the configuration is not changed and the
+   * pass number used in the debug output is given by the caller. Calls
+   * on different SatPasses may run at the same time, provided each
+   * configuration sends its debug output to a different stream.
+   * @param SP         SatPass object containing the input data.
+   * @param config     GDCconfiguration object.
+   * @param passNumber number identifying this pass in the debug output,
+   *                   cf. GDCconfiguration::nextPassNumber().
+   * @param EditCmds   vector<string> (output) containing RinexEditor commands.
+   * @param retMsg     string summary of results
+   * @return 0 for success, otherwise return an Error code, as above.
+   */
+   int DiscontinuityCorrector(SatPass& SP,
+                              const GDCconfiguration& config,
+                              int passNumber,
+                              std::vector<std::string>& EditCmds,
+                              std::string& retMsg)
+      throw(Exception);
+
+   /// class GDCbatch runs the GPSTK Discontinuity Corrector on many SatPasses
+   /// at once, sharing them among the threads of a ThreadPool. Passes are
+   /// numbered in order from the configuration, and the debug output of each
+   /// is kept separately, so the results are identical to those of calling
+   /// DiscontinuityCorrector(SP,config,EditCmds,retMsg) on each pass in turn.
+   class GDCbatch {
+   public:
+         /// Output of the corrector for one pass.
+      class Result {
+      public:
+         int iret;                           ///< return value, as DiscontinuityCorrector
+         std::vector<std::string> EditCmds;  ///< RinexEditor commands
+         std::string retMsg;                 ///< summary of results
+         std::string debugOutput;            ///< output to the debug stream
+      };
+
+         /// constructor; numThreads is the number of threads to use,
+         /// 0 means one per processor.
+      explicit GDCbatch(unsigned int numThreads=0) throw(Exception)
+         : pool(numThreads) { }
+
+         /// Correct the passes SPList[indexes[i]], which must be distinct;
+         /// on return results[i] holds the output for SPList[indexes[i]].
+         /// If writeLog is true the debug output of all the passes is then
+         /// written, in order, to the debug stream of config; otherwise it
+         /// is left to the caller, in Result::debugOutput.
+      void correct(std::vector<SatPass>& SPList,
+                   const std::vector<int>& indexes,
+                   GDCconfiguration& config,
+                   std::vector<Result>& results,
+                   bool writeLog=true)
+         throw(Exception);
+
+         /// Correct all the passes in SPList; results[i] is the output for
+         /// SPList[i].
+      void correct(std::vector<SatPass>& SPList,
+                   GDCconfiguration& config,
+                   std::vector<Result>& results,
+                   bool writeLog=true)
+         throw(Exception);
+
+         /// Number of threads used
+      unsigned int numThreads() const throw() { return pool.size(); }
+
+   private:
+         /// threads that run the corrector
+      ThreadPool pool;
+
+   }; // end class GDCbatch
+
    //@}
 
 }  // end namespace gpstk
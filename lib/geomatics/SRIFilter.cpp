@@ -47,6 +47,7 @@
 //=============================================================================
 
 //------------------------------------------------------------------------------------
+#include <algorithm>
 #include "SRIFilter.hpp"
 #include "RobustStats.hpp"
 #include "StringUtils.hpp"
@@ -127,6 +128,30 @@ SRIFilter& SRIFilter::operator=(const SRIFilter& right)
    return *this;
 }
 
+//------------------------------------------------------------------------------------
+// Replace A with L*A, where L is lower triangular; the zeros above the diagonal of
+// L are skipped, otherwise the sums are formed as in operator*.
+static void lowerTriangularTimes(const Matrix<double>& L, Matrix<double>& A)
+   throw(MatrixException)
+{
+   if(L.cols() != A.rows() || L.rows() != L.cols()) {
+      MatrixException e("Incompatible dimensions for Matrix * Matrix");
+      GPSTK_THROW(e);
+   }
+
+   const unsigned int n=L.rows();
+   unsigned int i,j,k;
+   double sum;
+   for(j=0; j<A.cols(); j++) {
+      for(i=n; i-- > 0; ) {         // row i uses rows <= i only, so go up
+         sum = 0.0;
+         for(k=0; k<=i; k++)
+            sum += L(i,k) * A(k,j);
+         A(i,j) = sum;
+      }
+   }
+}
+
 //------------------------------------------------------------------------------------
 // SRIF (Kalman) measurement update, or least squares update
 // Returns (whitened) residuals in D
@@ -152,20 +177,30 @@ void SRIFilter::measurementUpdate(const Matrix<double>& H,
       GPSTK_THROW(me);
    }
    try {
-      Matrix<double> P(H);
+      const unsigned int M=H.rows(), N=R.cols();
+      unsigned int i,j;
       Cholesky<double> Ch;
 
+         // A = H || D
+      Matrix<double> A(M,N+1);
+      for(j=0; j<N; j++)
+         for(i=0; i<M; i++)
+            A(i,j) = H(i,j);
+      for(i=0; i<M; i++)
+         A(i,N) = D(i);
+
          // whiten partials and data
       if(&CM != &SRINullMatrix) {
-         Matrix<double> L;
          Ch(CM);
-         L = inverse(Ch.L);
-         P = L * P;
-         D = L * D;
+         lowerTriangularTimes(inverse(Ch.L), A);
       }
 
-         // update *this with the whitened information
-      SrifMU(R, Z, P, D);
+         // update *this with the whitened information, all rows at once
+      SrifMU(R, Z, A);
+
+         // copy residuals out of A into D
+      for(i=0; i<M; i++)
+         D(i) = A(i,N);
 
          // un-whiten residuals
       if(&CM != &SRINullMatrix) {
@@ -242,6 +277,60 @@ void SRIFilter::Reset(const int N)
 // private beyond this
 //------------------------------------------------------------------------------------
 
+//------------------------------------------------------------------------------------
+// Replace P with R*P, where R is upper triangular; the zeros below the diagonal of
+// R are skipped, which leaves the sums exactly as operator* forms them.
+template <class T>
+static void upperTriangularTimes(const Matrix<T>& R, Matrix<T>& P)
+   throw(MatrixException)
+{
+   if(R.cols() != P.rows() || R.rows() != R.cols()) {
+      MatrixException e("Incompatible dimensions for Matrix * Matrix");
+      GPSTK_THROW(e);
+   }
+
+   const unsigned int n=R.rows();
+   unsigned int i,j,k;
+   T sum;
+   for(j=0; j<P.cols(); j++) {
+      for(i=0; i<n; i++) {          // row i uses rows >= i only, so go down
+         sum = T(0);
+         for(k=i; k<n; k++)
+            sum += R(i,k) * P(k,j);
+         P(i,j) = sum;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------------
+// Find the rows [lo,hi), among the first n, of column k of A outside of which the
+// column is zero; lo=n and hi=0 if it is all zero.
+template <class T>
+static void columnExtent(const Matrix<T>& A, unsigned int k, unsigned int n,
+                         unsigned int& lo, unsigned int& hi)
+   throw()
+{
+   lo = n;
+   hi = 0;
+   for(unsigned int i=0; i<n; i++) {
+      if(A(i,k) != T(0)) {
+         if(lo == n) lo = i;
+         hi = i+1;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------------
+// Extend the rows [klo,khi) to include [lo,hi), if that is not empty.
+static inline void mergeExtent(unsigned int lo, unsigned int hi,
+                               unsigned int& klo, unsigned int& khi)
+   throw()
+{
+   if(lo >= hi) return;
+   if(lo < klo) klo = lo;
+   if(hi > khi) khi = hi;
+}
+
 //------------------------------------------------------------------------------------
 // Kalman time update.
 // This routine uses the Householder transformation to propagate the SRIFilter
@@ -373,7 +462,7 @@ void SRIFilter::SrifTU(Matrix<T>& R,
    try {
       // initialize
       Rwx = T(0);
-      PhiInv = R * PhiInv;                   // set PhiInv = Rd = R*PhiInv
+      upperTriangularTimes(R, PhiInv);       // set PhiInv = Rd = R*PhiInv
       G = -PhiInv * G;
       // fixed Matrix problem - unary minus should not return an l-value
       //G = -(PhiInv * G);                     // set G = -Rd*G
@@ -383,10 +472,20 @@ void SRIFilter::SrifTU(Matrix<T>& R,
       //A = (Rw || Rwx || Zw) && (G || PhiInv || Z);
       //cout << "SrifTU - :\n" << fixed << setw(10) << setprecision(5) << A << endl;
 
+         // Rows [lo,hi) of each column of G and PhiInv outside of which the
+         // column is zero; the loops below skip those zeros. A transformation
+         // spreads the rows of its column into the columns it is applied to.
+      unsigned int lo, hi, ilo, ihi;
+      std::vector<unsigned int> Glo(ns), Ghi(ns), PIlo(n), PIhi(n);
+      for(k=0; k<ns; k++) columnExtent(G, k, n, Glo[k], Ghi[k]);
+      for(k=0; k<n; k++) columnExtent(PhiInv, k, n, PIlo[k], PIhi[k]);
+
       //---------------------------------------------------------------
       for(j=0; j<ns; j++) {               // loop over first ns columns
+         lo = Glo[j];
+         hi = Ghi[j];
          sum = T(0);
-         for(i=0; i<n; i++)               // rows of -Rd*G
+         for(i=lo; i<hi; i++)             // rows of -Rd*G
             sum += G(i,j)*G(i,j);
          dum = Rw(j,j);
          sum += dum*dum;
@@ -403,13 +502,16 @@ void SRIFilter::SrifTU(Matrix<T>& R,
          if(j+1 < ns) {                   // apply to G
             for(k=j+1; k<ns; k++) {       // columns to right of diagonal
                sum = delta * Rw(j,k);
-               for(i=0; i<n; i++)         // rows of G
+               ilo = std::max(lo,Glo[k]);
+               ihi = std::min(hi,Ghi[k]);
+               for(i=ilo; i<ihi; i++)     // rows of G
                   sum += G(i,j)*G(i,k);
                if(sum == T(0)) continue;
                sum *= beta;
                Rw(j,k) += sum*delta;
-               for(i=0; i<n; i++)         // rows of G again
+               for(i=lo; i<hi; i++)       // rows of G again
                   G(i,k) += sum * G(i,j);
+               mergeExtent(lo, hi, Glo[k], Ghi[k]);
             }
          }
 
@@ -417,31 +519,36 @@ void SRIFilter::SrifTU(Matrix<T>& R,
             // to Rwx and PhiInv
          for(k=0; k<n; k++) {             // columns of Rwx and PhiInv
             sum = delta * Rwx(j,k);
-            for(i=0; i<n; i++)            // rows of PhiInv and G
+            ilo = std::max(lo,PIlo[k]);
+            ihi = std::min(hi,PIhi[k]);
+            for(i=ilo; i<ihi; i++)        // rows of PhiInv and G
                sum += PhiInv(i,k) * G(i,j);
             if(sum == T(0)) continue;
             sum *= beta;
             Rwx(j,k) += sum*delta;
-            for(i=0; i<n; i++)            // rows of PhiInv and G
+            for(i=lo; i<hi; i++)          // rows of PhiInv and G
                PhiInv(i,k) += sum * G(i,j);
+            mergeExtent(lo, hi, PIlo[k], PIhi[k]);
          }                                // end loop over columns of Rwx and PhiInv
 
             // apply jth Householder transformation
             // to Zw and Z
          sum = delta * Zw(j);
-         for(i=0; i<n; i++)               // rows of G and elements of Z
+         for(i=lo; i<hi; i++)             // rows of G and elements of Z
             sum += Z(i) * G(i,j);
          if(sum == T(0)) continue;
          sum *= beta;
          Zw(j) += sum * delta;
-         for(i=0; i<n; i++)               // rows of G and elements of Z
+         for(i=lo; i<hi; i++)             // rows of G and elements of Z
             Z(i) += sum * G(i,j);
       }                                   // end loop over first ns columns
 
       //---------------------------------------------------------------
       for(j=0; j<n; j++) {                // loop over columns of Rwx and PhiInv
+         lo = std::max(j+1,PIlo[j]);       // rows below the diagonal
+         hi = PIhi[j];
          sum = T(0);
-         for(i=j+1; i<n; i++)             // rows of PhiInv
+         for(i=lo; i<hi; i++)             // rows of PhiInv
             sum += PhiInv(i,j)*PhiInv(i,j);
          dum = PhiInv(j,j);
          sum += dum*dum;
@@ -455,23 +562,26 @@ void SRIFilter::SrifTU(Matrix<T>& R,
             // apply jth Householder transformation to columns of PhiInv on row j
          for(k=j+1; k<n; k++) {           // columns of PhiInv
             sum = delta * PhiInv(j,k);
-            for(i=j+1; i<n; i++)
+            ilo = std::max(lo,PIlo[k]);
+            ihi = std::min(hi,PIhi[k]);
+            for(i=ilo; i<ihi; i++)
                sum += PhiInv(i,j)*PhiInv(i,k);
             if(sum == T(0)) continue;
             sum *= beta;
             PhiInv(j,k) += sum*delta;
-            for(i=j+1; i<n; i++)
+            for(i=lo; i<hi; i++)
                PhiInv(i,k) += sum * PhiInv(i,j);
+            mergeExtent(lo, hi, PIlo[k], PIhi[k]);
          }
 
             // apply jth Householder transformation to Z
          sum = delta *Z(j);
-         for(i=j+1; i<n; i++)
+         for(i=lo; i<hi; i++)
             sum += Z(i) * PhiInv(i,j);
          if(sum == T(0)) continue;
          sum *= beta;
          Z(j) += sum*delta;
-         for(i=j+1; i<n; i++)
+         for(i=lo; i<hi; i++)
             Z(i) += sum * PhiInv(i,j);
       }                                   // end loop over cols of Rwx and PhiInv
 
@@ -602,8 +712,8 @@ try {
    Matrix<T> A;
    A = Rw + Rwx*G;
    Rwx = Rwx * Phi;
-   Phi = R * Phi;
-   G = R * G;
+   upperTriangularTimes(R, Phi);
+   upperTriangularTimes(R, G);
 
          //-----------------------------------------
          // HouseHolder Transformation
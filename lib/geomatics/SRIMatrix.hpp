@@ -48,6 +48,7 @@
 
 //------------------------------------------------------------------------------------
 // system includes
+#include <vector>
 // GPSTk
 #include "Vector.hpp"
 #include "Matrix.hpp"
@@ -57,6 +58,111 @@
 namespace gpstk
 {
 
+   /// Householder kernel of SrifMU(); see SrifMU().
+   /// Element (j,k), k >= j, of the n x n upper triangular R is at R[j + k*n]
+   /// (Matrix storage). Column k of A is zero outside the rows [first(k),last(k)];
+   /// that range only grows as the transformations mix columns, so the loops skip the
+   /// zeros of sparse partials (e.g. one row per bias). Four columns are
+   /// transformed together, each accumulating its own sum in the original order,
+   /// so that the results are the same except perhaps the sign of zero elements.
+   template <class T>
+   void SrifMUKernel(T *R, Vector<T>& Z, Matrix<T>& A,
+                     unsigned int n, unsigned int m)
+      throw()
+   {
+      if(m == 0 || n == 0) return;
+
+      const T EPS=-T(1.e-200);
+      const unsigned int np1=n+1;
+      const unsigned int step=n;
+      unsigned int i,j,k,q,lo,hi;
+      T dum, delta, beta;
+
+         // rows of each column of A that may be non-zero: [first(k),last(k)];
+         // with only a few rows this is not worth tracking
+      const bool sparse=(m >= 4);
+      std::vector<unsigned int> first(np1,sparse ? m : 0), last(np1,m-1);
+      for(k=0; sparse && k<np1; k++) {
+         const T *Ak = &A(0,k);
+         last[k] = 0;
+         for(i=0; i<m; i++) {
+            if(Ak[i] != T(0)) {
+               if(first[k] == m) first[k] = i;
+               last[k] = i;
+            }
+         }
+      }
+
+      for(j=0; j<n; j++) {          // loop over columns
+            // row j of R, from the diagonal: Rj[(k-j)*step] = R(j,k)
+         T *Rj = R + j*(n+1);
+         const T *Aj = &A(0,j);
+         lo = first[j];
+         hi = (lo < m ? last[j]+1 : lo);
+
+         T sum = T(0);
+         for(i=lo; i<hi; i++)
+            sum += Aj[i]*Aj[i];     // sum squares of elements in this column below d
+         if(sum <= T(0)) continue;
+
+         dum = Rj[0];
+         sum += dum * dum;          // add diagonal element
+         sum = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
+         delta = dum - sum;
+         Rj[0] = sum;
+
+         beta = sum*delta;          // beta must be negative
+         if(beta > EPS) continue;
+         beta = T(1)/beta;
+
+            // columns of R to right of diagonal, four at a time when column j
+            // of A is long enough; each sum is formed in the original order
+         k = j+1;
+         for( ; hi-lo >= 4 && k+4 <= n; k+=4) {
+            T *Ak[4], s[4];
+            for(q=0; q<4; q++) {
+               Ak[q] = &A(0,k+q);
+               s[q] = delta * Rj[(k+q-j)*step];
+            }
+            for(i=lo; i<hi; i++) {
+               const T a(Aj[i]);
+               s[0] += a * Ak[0][i];
+               s[1] += a * Ak[1][i];
+               s[2] += a * Ak[2][i];
+               s[3] += a * Ak[3][i];
+            }
+            for(q=0; q<4; q++) {
+               if(s[q] == T(0)) continue;
+               sum = s[q] * beta;
+               Rj[(k+q-j)*step] += sum*delta;
+               for(i=lo; i<hi; i++)
+                  Ak[q][i] += sum * Aj[i];
+               if(first[k+q] == m || lo < first[k+q]) first[k+q] = lo;
+               if(hi-1 > last[k+q]) last[k+q] = hi-1;
+            }
+         }
+
+            // the remaining columns one at a time, then Z as column n
+         for( ; k<np1; k++) {
+            T& Rjk = (k==n ? Z(j) : Rj[(k-j)*step]);
+            T *Ak = &A(0,k);
+            sum = delta * Rjk;
+            for(i=lo; i<hi; i++)
+               sum += Aj[i] * Ak[i];
+            if(sum == T(0)) continue;
+
+            sum *= beta;
+            Rjk += sum*delta;
+            for(i=lo; i<hi; i++)
+               Ak[i] += sum * Aj[i];
+            if(sparse) {
+               if(first[k] == m || lo < first[k]) first[k] = lo;
+               if(hi-1 > last[k]) last[k] = hi-1;
+            }
+         }
+      }
+   }  // end SrifMUKernel
+
    //---------------------------------------------------------------------------------
    // This routine uses the Householder algorithm to update the SRI
    // state and covariance.
@@ -142,47 +248,12 @@ namespace gpstk
          }
       }
    
-      const T EPS=-T(1.e-200);
-      unsigned int m=M, n=R.rows();
+      unsigned int m=M;
       if(m==0 || m > A.rows()) m=A.rows();
-      unsigned int np1=n+1;         // if np1 = n, state vector Z is not updated
-      unsigned int i,j,k;
-      T dum, delta, beta;
-   
-      for(j=0; j<n; j++) {          // loop over columns
-         T sum = T(0);
-         for(i=0; i<m; i++)
-            sum += A(i,j)*A(i,j);   // sum squares of elements in this column below d
-         if(sum <= T(0)) continue;
-   
-         dum = R(j,j);
-         sum += dum * dum;          // add diagonal element
-         sum = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
-         delta = dum - sum;
-         R(j,j) = sum;
-   
-         if(j+1 > np1) break;
-   
-         beta = sum*delta;          // beta must be negative
-         if(beta > EPS) continue;
-         beta = T(1)/beta;
-   
-         for(k=j+1; k<np1; k++) {   // columns to right of diagonal
-            sum = delta * (k==n ? Z(j) : R(j,k));
-            for(i=0; i<m; i++)
-               sum += A(i,j) * A(i,k);
-            if(sum == T(0)) continue;
-   
-            sum *= beta;
-            if(k==n) Z(j) += sum*delta;
-            else   R(j,k) += sum*delta;
-   
-            for(i=0; i<m; i++)
-               A(i,k) += sum * A(i,j);
-         }
-      }
+      if(R.rows() > 0) SrifMUKernel(&R(0,0), Z, A, R.rows(), m);
    }  // end SrifMU
-    
+
+
 
    //---------------------------------------------------------------------------------
    // This is simply SrifMU(R,Z,A) with H and D passed in rather
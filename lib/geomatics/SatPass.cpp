@@ -91,6 +91,9 @@ void SatPass::init(GSatID insat, double indt, vector<string> obstypes) throw()
       indexForLabel[obstypes[i]] = i;
       labelForIndex[i] = obstypes[i];
    }
+   obsData.resize(obstypes.size());
+   obsLLI.resize(obstypes.size());
+   obsSSI.resize(obstypes.size());
 }
 
 SatPass& SatPass::operator=(const SatPass& right) throw()
@@ -104,9 +107,12 @@ SatPass& SatPass::operator=(const SatPass& right) throw()
       firstTime = right.firstTime;
       lastTime = right.lastTime;
       ngood = right.ngood;
-      spdvector.resize(right.spdvector.size());
-      for(int i=0; i<right.spdvector.size(); i++)
-         spdvector[i] = right.spdvector[i];
+      flags = right.flags;
+      counts = right.counts;
+      toffsets = right.toffsets;
+      obsData = right.obsData;
+      obsLLI = right.obsLLI;
+      obsSSI = right.obsSSI;
    }
 
    return *this;
@@ -138,26 +144,30 @@ int SatPass::addData(const DayTime tt,
                   + StringUtils::asString(ssi.size()));
       GPSTK_THROW(e);
    }
-   if(spdvector.size() > 0 && spdvector[0].data.size() != data.size()) {
-      Exception e("Error - addData passed different dimension that earlier!"
-                   + StringUtils::asString(data.size()) + " != "
-                   + StringUtils::asString(spdvector[0].data.size()));
+   if(data.size() > obsData.size()) {
+      Exception e("Error - addData passed more data than obs types!"
+                   + StringUtils::asString(data.size()) + " > "
+                   + StringUtils::asString(obsData.size()));
       GPSTK_THROW(e);
    }
 
-   // create a new SatPassData
-   SatPassData spd(data.size());
-   spd.flag = flag;
+   // put the data in the order of the columns
+   vector<double> vdata(obsData.size(),0.0);
+   vector<unsigned short> vlli(obsData.size(),0),vssi(obsData.size(),0);
+   map<string, unsigned int>::const_iterator it;
    for(int k=0; k<data.size(); k++) {
-      int i = indexForLabel[obstypes[k]];
-      spd.data[i] = data[k];
-      spd.lli[i] = lli[k];
-      spd.ssi[i] = ssi[k];
+      if((it = indexForLabel.find(obstypes[k])) == indexForLabel.end()) {
+         Exception e("Invalid obs type in addData() " + obstypes[k]);
+         GPSTK_THROW(e);
+      }
+      vdata[it->second] = data[k];
+      vlli[it->second] = lli[k];
+      vssi[it->second] = ssi[k];
    }
 
    // push_back defines count and
    // returns : >=0 index of added data (ok), -1 gap, -2 tt out of order
-   return push_back(tt, spd);
+   return push_back(tt, flag, vdata, vlli, vssi);
 }
 
 // return -3 sat not found, data not added
@@ -170,7 +180,8 @@ int SatPass::addData(const RinexObsData& robs) throw()
    RinexObsData::RinexSatMap::const_iterator it;
    RinexObsData::RinexObsTypeMap::const_iterator jt;
    map<string,unsigned int>::const_iterator kt;
-   SatPassData spd(indexForLabel.size());
+   vector<double> vdata(obsData.size(),0.0);
+   vector<unsigned short> vlli(obsData.size(),0),vssi(obsData.size(),0);
 
    // loop over satellites
    for(it=robs.obs.begin(); it != robs.obs.end(); it++) {
@@ -179,20 +190,18 @@ int SatPass::addData(const RinexObsData& robs) throw()
          for(kt=indexForLabel.begin(); kt != indexForLabel.end(); kt++) {
             if((jt=it->second.find(RinexObsHeader::convertObsType(kt->first)))
                   == it->second.end()) {
-               spd.data[kt->second] = 0.0;
-               spd.lli[kt->second] = 0;
-               spd.ssi[kt->second] = 0;
+               vdata[kt->second] = 0.0;
+               vlli[kt->second] = 0;
+               vssi[kt->second] = 0;
             }
             else {
-               spd.data[kt->second] = jt->second.data;
-               spd.lli[kt->second] = jt->second.lli;
-               spd.ssi[kt->second] = jt->second.ssi;
+               vdata[kt->second] = jt->second.data;
+               vlli[kt->second] = jt->second.lli;
+               vssi[kt->second] = jt->second.ssi;
             }
          }  // end loop over obs
 
-         spd.flag = OK;             // default
-
-         return push_back(robs.time,spd);
+         return push_back(robs.time, OK, vdata, vlli, vssi);   // flag OK default
       }
    }
    return -3;
@@ -216,6 +225,12 @@ void SatPass::smooth(bool smoothPR, bool debiasPH, string& msg) throw(Exception)
    }
    if(indexForLabel.find("P1") == indexForLabel.end()) useC1=true;
 
+   // columns of the data, looked up once
+   vector<double>& L1 = obsData[indexForLabel["L1"]];
+   vector<double>& L2 = obsData[indexForLabel["L2"]];
+   vector<double>& P1 = obsData[indexForLabel[(useC1 ? "C1" : "P1")]];
+   vector<double>& P2 = obsData[indexForLabel["P2"]];
+
    //static const double CFF=C_GPS_M/OSC_FREQ;
    static const double F1=L1_MULT;   // 154.0;
    static const double F2=L2_MULT;   // 120.0;
@@ -245,12 +260,10 @@ void SatPass::smooth(bool smoothPR, bool debiasPH, string& msg) throw(Exception)
    Stats<double> PB1,PB2;
 
    // get the biases B = L - DP
-   for(first=true,i=0; i<spdvector.size(); i++) {
-      if(!(spdvector[i].flag & OK)) continue;        // skip bad data
-      double P1 = spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]];
-      double P2 = spdvector[i].data[indexForLabel["P2"]];
-      RB1 = wl1*spdvector[i].data[indexForLabel["L1"]] - D11*P1 - D12*P2;
-      RB2 = wl2*spdvector[i].data[indexForLabel["L2"]] - D21*P1 - D22*P2;
+   for(first=true,i=0; i<flags.size(); i++) {
+      if(!(flags[i] & OK)) continue;                 // skip bad data
+      RB1 = wl1*L1[i] - D11*P1[i] - D12*P2[i];
+      RB2 = wl2*L2[i] - D21*P1[i] - D22*P2[i];
       if(first) { dbL1 = RB1; dbL2 = RB2; first = false; }
       PB1.Add(RB1-dbL1);
       PB2.Add(RB2-dbL2);
@@ -280,23 +293,22 @@ void SatPass::smooth(bool smoothPR, bool debiasPH, string& msg) throw(Exception)
 
    if(!debiasPH && !smoothPR) return;
 
-   for(i=0; i<spdvector.size(); i++) {
-      if(!(spdvector[i].flag & OK)) continue;        // skip bad data
+   for(i=0; i<flags.size(); i++) {
+      if(!(flags[i] & OK)) continue;                 // skip bad data
 
       // compute the debiased phase
-      dbL1 = spdvector[i].data[indexForLabel["L1"]] - RB1;
-      dbL2 = spdvector[i].data[indexForLabel["L2"]] - RB2;
+      dbL1 = L1[i] - RB1;
+      dbL2 = L2[i] - RB2;
 
       // replace the phase with the debiased phase
       if(debiasPH) {
-         spdvector[i].data[indexForLabel["L1"]] = dbL1;
-         spdvector[i].data[indexForLabel["L2"]] = dbL2;
+         L1[i] = dbL1;
+         L2[i] = dbL2;
       }
       // smooth the range - replace the pseudorange with the smoothed pseudorange
       if(smoothPR) {
-         spdvector[i].data[indexForLabel[(useC1 ? "C1" : "P1")]]
-                                                = D11*wl1*dbL1 + D12*wl2*dbL2;
-         spdvector[i].data[indexForLabel["P2"]] = D21*wl1*dbL1 + D22*wl2*dbL2;
+         P1[i] = D11*wl1*dbL1 + D12*wl2*dbL2;
+         P2[i] = D21*wl1*dbL1 + D22*wl2*dbL2;
       }
    }
 }
@@ -304,99 +316,93 @@ void SatPass::smooth(bool smoothPR, bool debiasPH, string& msg) throw(Exception)
 // -------------------------- get and set routines ----------------------------
 double& SatPass::data(unsigned int i, std::string type) throw(Exception)
 {
-   if(i >= spdvector.size()) {
-      Exception e("Invalid index in data() " + asString(i));
-      GPSTK_THROW(e);
-   }
-   map<string, unsigned int>::const_iterator it;
-   if((it = indexForLabel.find(type)) == indexForLabel.end()) {
+   int k = getIndex(type);
+   if(k < 0) {
       Exception e("Invalid obs type in data() " + type);
       GPSTK_THROW(e);
    }
-   return spdvector[i].data[it->second];
+   return data(i,k);
+}
+
+int SatPass::getIndex(const string& type) const throw()
+{
+   map<string, unsigned int>::const_iterator it = indexForLabel.find(type);
+   return (it == indexForLabel.end() ? -1 : int(it->second));
 }
 
 double& SatPass::timeoffset(unsigned int i) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= toffsets.size()) {
       Exception e("Invalid index in timeoffset() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].toffset;
+   return toffsets[i];
 }
 
 unsigned short& SatPass::LLI(unsigned int i, std::string type) throw(Exception)
 {
-   if(i >= spdvector.size()) {
-      Exception e("Invalid index in LLI() " + asString(i));
-      GPSTK_THROW(e);
-   }
-   map<string, unsigned int>::const_iterator it;
-   if((it = indexForLabel.find(type)) == indexForLabel.end()) {
+   int k = getIndex(type);
+   if(k < 0) {
       Exception e("Invalid obs type in LLI() " + type);
       GPSTK_THROW(e);
    }
-   return spdvector[i].lli[it->second];
+   return LLI(i,k);
 }
 
 unsigned short& SatPass::SSI(unsigned int i, std::string type) throw(Exception)
 {
-   if(i >= spdvector.size()) {
-      Exception e("Invalid index in SSI() " + asString(i));
-      GPSTK_THROW(e);
-   }
-   map<string, unsigned int>::const_iterator it;
-   if((it = indexForLabel.find(type)) == indexForLabel.end()) {
+   int k = getIndex(type);
+   if(k < 0) {
       Exception e("Invalid obs type in SSI() " + type);
       GPSTK_THROW(e);
    }
-   return spdvector[i].ssi[it->second];
+   return SSI(i,k);
 }
 
 // ---------------------------------- set routines ----------------------------
 void SatPass::setFlag(unsigned int i, unsigned short f) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= flags.size()) {
       Exception e("Invalid index in setFlag() " + asString(i));
       GPSTK_THROW(e);
    }
 
-   if(spdvector[i].flag != BAD && f == BAD) ngood--;
-   if(spdvector[i].flag == BAD && f != BAD) ngood++;
-   spdvector[i].flag = f;
+   if(flags[i] != BAD && f == BAD) ngood--;
+   if(flags[i] == BAD && f != BAD) ngood++;
+   flags[i] = f;
 }
 
 // ---------------------------------- get routines ----------------------------
 // get value of flag at one index
 unsigned short SatPass::getFlag(unsigned int i) throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= flags.size()) {
       Exception e("Invalid index in getFlag() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].flag;
+   return flags[i];
 }
 
 // get one element of the count array of this SatPass
 unsigned int SatPass::getCount(unsigned int i) const throw(Exception)
 {
-   if(i >= spdvector.size()) {
+   if(i >= counts.size()) {
       Exception e("invalid in getCount() " + asString(i));
       GPSTK_THROW(e);
    }
-   return spdvector[i].ndt;
+   return counts[i];
 }
 
 // ---------------------------------- utils -----------------------------------
 // return the time corresponding to the given index in the data array
 DayTime SatPass::time(unsigned int i) const throw(Exception)
 {
-   if(i > spdvector.size()) {
+   if(i > counts.size()) {
       Exception e("invalid in time() " + asString(i));
       GPSTK_THROW(e);
    }
    // computing toff first is necessary to avoid a rare bug in DayTime..
-   double toff = spdvector[i].ndt * dt + spdvector[i].toffset;
+   double toff = counts[i] * dt + toffsets[i];
    return (firstTime + toff);
 }
 
@@ -427,11 +433,14 @@ try {
 
    oldgood = ngood;
    ngood = ilast = 0;
-   for(i=0; i<spdvector.size(); i++) {             // loop over all data
-      n = spdvector[i].ndt;
+   newSP.obsData.resize(obsData.size());
+   newSP.obsLLI.resize(obsData.size());
+   newSP.obsSSI.resize(obsData.size());
+   for(i=0; i<flags.size(); i++) {                 // loop over all data
+      n = counts[i];
       tt = time(i);
       if(n < N) {                                     // keep in this SatPass
-         if(spdvector[i].flag != BAD) ngood++;
+         if(flags[i] != BAD) ngood++;
          ilast = i;
       }
       else {                                          // copy out data into new SP
@@ -440,14 +449,19 @@ try {
             newSP.firstTime = newSP.lastTime = tt;
          }
          j = newSP.countForTime(tt);
-         spdvector[i].ndt = j;
-         spdvector[i].toffset = tt - newSP.firstTime - j*dt;
-         newSP.spdvector.push_back(spdvector[i]);
+         newSP.flags.push_back(flags[i]);
+         newSP.counts.push_back(j);
+         newSP.toffsets.push_back(tt - newSP.firstTime - j*dt);
+         for(int k=0; k<obsData.size(); k++) {
+            newSP.obsData[k].push_back(obsData[k][i]);
+            newSP.obsLLI[k].push_back(obsLLI[k][i]);
+            newSP.obsSSI[k].push_back(obsSSI[k][i]);
+         }
       }
    }
 
    // now trim this SatPass
-   spdvector.resize(ilast+1);
+   resizeEpochs(ilast+1);
    lastTime = time(ilast);
 
    return true;
@@ -459,7 +473,7 @@ void SatPass::decimate(const int N, DayTime refTime) throw(Exception)
 {
 try {
    if(N <= 1) return;
-   if(spdvector.size() < N) { dt = N*dt; return; }
+   if(flags.size() < N) { dt = N*dt; return; }
    if(refTime == DayTime::BEGINNING_OF_TIME) refTime = firstTime;
 
    // find new firstTime = time(nstart)
@@ -471,27 +485,27 @@ try {
    // decimate
    ngood = 0;
    DayTime newfirstTime, tt;
-   for(j=0,i=0; i<spdvector.size(); i++) {
-      if(spdvector[i].ndt % N != nstart) continue;
+   for(j=0,i=0; i<flags.size(); i++) {
+      if(counts[i] % N != nstart) continue;
       lastTime = time(i);
       if(j==0) {
          newfirstTime = time(i);
-         spdvector[i].toffset = 0.0;
-         spdvector[i].ndt = 0;
+         toffsets[i] = 0.0;
+         counts[i] = 0;
       }
       else {
          tt = time(i);
-         spdvector[i].ndt = int(0.5+(tt-newfirstTime)/(N*dt));
-         spdvector[i].toffset = tt - newfirstTime - spdvector[i].ndt * N * dt;
+         counts[i] = int(0.5+(tt-newfirstTime)/(N*dt));
+         toffsets[i] = tt - newfirstTime - counts[i] * N * dt;
       }
-      spdvector[j] = spdvector[i];
-      if(spdvector[j].flag != BAD) ngood++;
+      copyEpoch(i,j);
+      if(flags[j] != BAD) ngood++;
       j++;
    }
 
    dt = N*dt;
    firstTime = newfirstTime;
-   spdvector.resize(j); // trim
+   resizeEpochs(j); // trim
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
 }
@@ -509,24 +523,24 @@ void SatPass::dump(ostream& os, string msg1, string msg2) throw()
    os << " gap(pts)";
    os << endl;
 
-   for(i=0; i<spdvector.size(); i++) {
+   for(i=0; i<flags.size(); i++) {
       tt = time(i);
       os << msg1
          << " " << setw(3) << i
          << " " << sat
-         << " " << setw(3) << spdvector[i].ndt
-         << " " << setw(2) << spdvector[i].flag
+         << " " << setw(3) << counts[i]
+         << " " << setw(2) << flags[i]
          << " " << tt.printf(SatPass::outFormat)
          << fixed << setprecision(6)
-         << " " << setw(9) << spdvector[i].toffset
+         << " " << setw(9) << toffsets[i]
          << setprecision(3);
       for(j=0; j<indexForLabel.size(); j++)
-         os << " " << setw(13) << spdvector[i].data[j]
-            << " " << spdvector[i].lli[j]
-            << " " << spdvector[i].ssi[j];
-      if(i==0) last = spdvector[i].ndt;
-      if(spdvector[i].ndt - last > 1) os << " " << spdvector[i].ndt-last;
-      last = spdvector[i].ndt;
+         os << " " << setw(13) << obsData[j][i]
+            << " " << obsLLI[j][i]
+            << " " << obsSSI[j][i];
+      if(i==0) last = counts[i];
+      if(counts[i] - last > 1) os << " " << counts[i]-last;
+      last = counts[i];
       os << endl;
    }
 }
@@ -534,7 +548,7 @@ void SatPass::dump(ostream& os, string msg1, string msg2) throw()
 // output SatPass to ostream
 ostream& operator<<(ostream& os, SatPass& sp )
 {
-   os << setw(4) << sp.spdvector.size()
+   os << setw(4) << sp.flags.size()
       << " " << sp.sat
       << " " << setw(4) << sp.ngood
       << " " << setw(2) << sp.Status
@@ -546,14 +560,17 @@ ostream& operator<<(ostream& os, SatPass& sp )
    return os;
 }
 
-// ---------------------------- private SatPassData functions --------------------
+// ---------------------------- private column functions ------------------------
 // add data to the arrays at timetag tt (private)
 // return >=0 ok (index of added data), -1 gap, -2 timetag out of order
-int SatPass::push_back(const DayTime tt, SatPassData& spd) throw()
+int SatPass::push_back(const DayTime tt, unsigned short flag,
+                       const vector<double>& data,
+                       const vector<unsigned short>& lli,
+                       const vector<unsigned short>& ssi) throw()
 {
    unsigned int n;
       // if this is the first point, save first time
-   if(spdvector.size() == 0) {
+   if(flags.size() == 0) {
       firstTime = lastTime = tt;
       n = 0;
    }
@@ -562,29 +579,63 @@ int SatPass::push_back(const DayTime tt, SatPassData& spd) throw()
          // compute count for this point - prev line means n is >= 0
       n = countForTime(tt);
          // test size of gap
-      if( (n - spdvector[spdvector.size()-1].ndt) * dt > maxGap)
+      if( (n - counts[counts.size()-1]) * dt > maxGap)
          return -1;
       lastTime = tt;
    }
 
       // add it
-   //spd.flag = 1;
    ngood++;  // ngood is useless unless it's changed whenever any flag is...
-   spd.ndt = n;
-   spd.toffset = tt - firstTime - n*dt;
-   spdvector.push_back(spd);
-   return (spdvector.size()-1);
+   flags.push_back(flag);
+   counts.push_back(n);
+   toffsets.push_back(tt - firstTime - n*dt);
+   for(int k=0; k<obsData.size(); k++) {
+      obsData[k].push_back(data[k]);
+      obsLLI[k].push_back(lli[k]);
+      obsSSI[k].push_back(ssi[k]);
+   }
+   return (flags.size()-1);
 }
 
-// get one element of the data array of this SatPass (private)
-struct SatPass::SatPassData SatPass::getData(unsigned int i) const
-   throw(Exception)
+// copy all the data at index i to index j (private)
+void SatPass::copyEpoch(unsigned int i, unsigned int j) throw()
 {
-   if(i >= spdvector.size()) {         // TD ?? keep this - its private
-      Exception e("invalid in getData() " + asString(i));
+   flags[j] = flags[i];
+   counts[j] = counts[i];
+   toffsets[j] = toffsets[i];
+   for(int k=0; k<obsData.size(); k++) {
+      obsData[k][j] = obsData[k][i];
+      obsLLI[k][j] = obsLLI[k][i];
+      obsSSI[k][j] = obsSSI[k][i];
+   }
+}
+
+// resize all the columns to n (private)
+void SatPass::resizeEpochs(unsigned int n) throw()
+{
+   flags.resize(n);
+   counts.resize(n);
+   toffsets.resize(n);
+   for(int k=0; k<obsData.size(); k++) {
+      obsData[k].resize(n);
+      obsLLI[k].resize(n);
+      obsSSI[k].resize(n);
+   }
+}
+
+// throw if either index is invalid (private)
+void SatPass::checkIndexes(unsigned int i, unsigned int k, const char *func)
+   const throw(Exception)
+{
+   if(i >= flags.size()) {
+      Exception e("Invalid index in " + string(func) + "() " + asString(i));
+      GPSTK_THROW(e);
+   }
+   if(k >= obsData.size()) {
+      Exception e("Invalid obs type index in " + string(func) + "() "
+                  + asString(k));
       GPSTK_THROW(e);
    }
-   return spdvector[i];
 }
 
 // -------------------------------------------------------------------------------
@@ -676,14 +727,14 @@ int SatPassIterator::next(map<unsigned int, unsigned int>& indexMap) throw(Excep
 
          if(SPList[i].Status < 0) continue;     // should never happen
 
-         if(countOffset[sat] + SPList[i].spdvector[j].ndt == currentN) {
+         if(countOffset[sat] + SPList[i].counts[j] == currentN) {
             // found active sat at this count - add to map
             nextIndexMap[i] = j;
             numsvs++;
 
             // increment data index
             j++;
-            if(j == SPList[i].spdvector.size()) {     // this pass is done
+            if(j == SPList[i].size()) {     // this pass is done
                indexStatus[i] = 1;
 
                // find the next pass for this sat
@@ -750,7 +801,7 @@ int SatPassIterator::next(RinexObsData& robs) throw(Exception)
       GSatID sat = SPList[i].getSat();
 
       bool found = false;
-      bool flag = (SPList[i].spdvector[j].flag != SatPass::BAD);
+      bool flag = (SPList[i].flags[j] != SatPass::BAD);
       for(int k=0; k<SPList[i].labelForIndex.size(); k++) {
          RinexObsHeader::RinexObsType ot;
          ot = RinexObsHeader::convertObsType(SPList[i].labelForIndex[k]);
@@ -758,9 +809,9 @@ int SatPassIterator::next(RinexObsData& robs) throw(Exception)
          }
          else {
             found = true;
-            robs.obs[sat][ot].data = flag ? SPList[i].spdvector[j].data[k] : 0.;
-            robs.obs[sat][ot].lli  = flag ? SPList[i].spdvector[j].lli[k] : 0;
-            robs.obs[sat][ot].ssi  = flag ? SPList[i].spdvector[j].ssi[k] : 0;
+            robs.obs[sat][ot].data = flag ? SPList[i].obsData[k][j] : 0.;
+            robs.obs[sat][ot].lli  = flag ? SPList[i].obsLLI[k][j] : 0;
+            robs.obs[sat][ot].ssi  = flag ? SPList[i].obsSSI[k][j] : 0;
          }
       }
       if(found) robs.numSvs++;
@@ -156,6 +156,24 @@ public:
    /// @return the data of the given type at the given index
    double& data(unsigned int i, std::string type) throw(Exception);
 
+   /// Get the index of an obs type, for use with the data(), LLI() and SSI()
+   /// accessors that take an index; these do not look up the obs type on each
+   /// call, and so are better in loops. The index of an obs type is its
+   /// position in the list given to the constructor.
+   /// @param  type observation type (e.g. "L1")
+   /// @return the index of the obs type, or -1 if it is not stored
+   int getIndex(const std::string& type) const throw();
+
+   /// Access the data for one obs type at one index, as either l-value or r-value
+   /// @param  i    index of the data of interest
+   /// @param  k    index of the obs type (cf. getIndex()) of the data of interest
+   /// @return the data of the given type at the given index
+   double& data(unsigned int i, unsigned int k) throw(Exception)
+   {
+      checkIndexes(i, k, "data");
+      return obsData[k][i];
+   }
+
    /// Access the time offset from the nominal time (i.e. timetag) at one index
    /// (epoch), as either l-value or r-value
    /// @param  i    index of the data of interest
@@ -168,12 +186,32 @@ public:
    /// @return the LLI of the given type at the given index
    unsigned short& LLI(unsigned int i, std::string type) throw(Exception);
 
+   /// Access the LLI for one obs type at one index, as either l-value or r-value
+   /// @param  i    index of the data of interest
+   /// @param  k    index of the obs type (cf. getIndex()) of the data of interest
+   /// @return the LLI of the given type at the given index
+   unsigned short& LLI(unsigned int i, unsigned int k) throw(Exception)
+   {
+      checkIndexes(i, k, "LLI");
+      return obsLLI[k][i];
+   }
+
    /// Access the ssi for one obs type at one index, as either l-value or r-value
    /// @param  i    index of the data of interest
    /// @param  type observation type (e.g. "L1") of the data of interest
    /// @return the SSI of the given type at the given index
    unsigned short& SSI(unsigned int i, std::string type) throw(Exception);
 
+   /// Access the SSI for one obs type at one index, as either l-value or r-value
+   /// @param  i    index of the data of interest
+   /// @param  k    index of the obs type (cf. getIndex()) of the data of interest
+   /// @return the SSI of the given type at the given index
+   unsigned short& SSI(unsigned int i, unsigned int k) throw(Exception)
+   {
+      checkIndexes(i, k, "SSI");
+      return obsSSI[k][i];
+   }
+
    // -------------------------------- set routines ----------------------------
 
    /// change the maximum time gap (in seconds) allowed within any SatPass
@@ -226,7 +264,7 @@ public:
 
    /// @return the earliest time of good data in this SatPass data
    DayTime getFirstGoodTime(void) const throw() {
-      for(int j=0; j<spdvector.size(); j++) if(spdvector[j].flag & OK) {
+      for(int j=0; j<flags.size(); j++) if(flags[j] & OK) {
          return time(j);
       }
       return DayTime::END_OF_TIME;
@@ -234,7 +272,7 @@ public:
 
    /// @return the latest time of good data in this SatPass data
    DayTime getLastGoodTime(void) const throw() {
-      for(int j=spdvector.size()-1; j>=0; j--) if(spdvector[j].flag & OK) {
+      for(int j=flags.size()-1; j>=0; j--) if(flags[j] & OK) {
          return time(j);
       }
       return DayTime::BEGINNING_OF_TIME;
@@ -254,7 +292,7 @@ public:
 
    /// get the size of (the arrays in) this SatPass
    /// @return the size of the data array in this object
-   unsigned int size(void) const throw() { return spdvector.size(); }
+   unsigned int size(void) const throw() { return flags.size(); }
 
    /// get one element of the count array of this SatPass
    /// @param  i   index of the data of interest
@@ -265,7 +303,7 @@ public:
    // -------------------------------- utils ---------------------------------
 
    /// clear the data (but not the obs types) from the arrays
-   void clear(void) throw() { spdvector.clear(); }
+   void clear(void) throw() { resizeEpochs(0); }
 
    /// compute the timetag associated with index i in the data array
    /// @param  i   index of the data of interest
@@ -350,57 +388,12 @@ protected:
    int countForTime(const DayTime& tt) const throw(Exception)
       { return int((tt-firstTime)/dt + 0.5); }
 
-   // --------------- SatPassData data structure for internal use only ----------
-   //
-   struct SatPassData {
-
-      // ---------------------- member data ----------------------------------
-
-      /// a flag (cf. SatPass::BAD, etc.) that is set to OK at creation
-      /// then reset by other processing.
-      unsigned short flag;
-      /// time 'count' : time of data = FirstTime + ndt * dt + offset
-      unsigned int ndt;
-      /// offset of time from integer number * dt since FirstTime.
-      double toffset;
-      /// data for one epoch of RINEX data
-      std::vector<double> data;
-      /// loss-of-lock and signal-strength indicators (from RINEX) for data
-      /// parallel to data vector
-      std::vector<unsigned short> lli,ssi;
-
-      // ---------------------- private member functions ---------------------
-
-      /// constructor
-      /// @param n the number of data types to be stored, default 4
-      SatPassData(unsigned short n=4) : flag(SatPass::OK), ndt(0), toffset(0.0)
-      {
-         data = std::vector<double>(n,0.0);
-         lli = std::vector<unsigned short>(n,0);
-         ssi = std::vector<unsigned short>(n,0);
-      }
-
-      // d'tor, copy c'tor and operator= are built by compiler,
-      // but operator= will not work correctly, b/c a deep copy is needed.
-      SatPassData& operator=(const SatPassData& right) throw()
-      {
-         if(&right != this) {
-            flag = right.flag;
-            ndt = right.ndt;
-            toffset = right.toffset;
-            data.resize(right.data.size());
-            lli.resize(right.lli.size());
-            ssi.resize(right.ssi.size());
-            int i;
-            for(i=0; i<right.data.size(); i++) data[i] = right.data[i];
-            for(i=0; i<right.lli.size(); i++) lli[i] = right.lli[i];
-            for(i=0; i<right.ssi.size(); i++) ssi[i] = right.ssi[i];
-         }
-
-         return *this;
-      }
-
-   }; // end struct SatPassData
+   /// throw if i is not a valid index of the data, or k of an obs type
+   /// @param i    index of the data
+   /// @param k    index of the obs type
+   /// @param func name of the calling function, for the message
+   void checkIndexes(unsigned int i, unsigned int k, const char *func) const
+      throw(Exception);
 
    // --------------- private member data -----------------------------
    /// Status flag for use exclusively by the caller. It is set to 0
@@ -414,7 +407,8 @@ protected:
    /// Satellite identifier for this data.
    GSatID sat;
 
-   /// STL map relating strings identifying obs types with indexes in SatPassData
+   /// STL map relating strings identifying obs types with their index, which
+   /// is the index of their column in obsData, obsLLI and obsSSI
    std::map<std::string,unsigned int> indexForLabel;
    std::map<unsigned int,std::string> labelForIndex;
 
@@ -426,22 +420,44 @@ protected:
    /// number of timetags with good data in the data arrays.
    unsigned int ngood;
 
-   /// ALL data in the pass, stored in SatPassData objects, in time order
-   std::vector<SatPassData> spdvector;
+   // ALL data in the pass, in time order, stored by column: element i of each
+   // vector belongs to the i-th epoch of the pass.
+
+   /// a flag (cf. SatPass::BAD, etc.) for each epoch, set to OK at creation
+   /// then reset by other processing.
+   std::vector<unsigned short> flags;
+
+   /// time 'count' : time of data = firstTime + counts[i] * dt + toffsets[i]
+   std::vector<unsigned int> counts;
+
+   /// offset of time from integer number * dt since firstTime.
+   std::vector<double> toffsets;
+
+   /// data, and loss-of-lock and signal-strength indicators (from RINEX), one
+   /// column per obs type, indexed as in indexForLabel.
+   std::vector< std::vector<double> > obsData;
+   std::vector< std::vector<unsigned short> > obsLLI,obsSSI;
 
    // --------------- private member functions ------------------------
 
    /// called by constructors to initialize - see doc for them.
    void init(GSatID sat, double dt, std::vector<std::string> obstypes) throw();
 
-   /// add a complete SatPassData at time tt
+   /// add a complete epoch at time tt; data, lli and ssi are indexed as
+   /// the columns of obsData.
    /// @return n>=0 if data was added successfully, n is the index of the new data
    ///            -1 if a gap is found (no data is added),
    ///            -2 if time tag is out of order (no data is added)
-   int push_back(const DayTime tt, SatPassData& spd) throw();
+   int push_back(const DayTime tt, unsigned short flag,
+                 const std::vector<double>& data,
+                 const std::vector<unsigned short>& lli,
+                 const std::vector<unsigned short>& ssi) throw();
+
+   /// copy the epoch at index i to index j, for all columns
+   void copyEpoch(unsigned int i, unsigned int j) throw();
 
-   /// get a complete SatPassData at count i
-   struct SatPassData getData(unsigned int i) const throw(Exception);
+   /// resize all the columns to n epochs
+   void resizeEpochs(unsigned int n) throw();
 
    // --------------- friend functions --------------------------------
 
@@ -585,7 +601,7 @@ private:
    /// index of the current object in the list for this satellite
    std::map<GSatID,int> listIndex;
 
-   /// index of the data vector (spdvector) of the current object in the list
+   /// index of the data (epoch) of the current object in the list
    /// for this satellite
    std::map<GSatID,int> dataIndex;
 
@@ -601,7 +617,7 @@ private:
    std::vector<SatPass>& SPList;
 
    /// map of indexes i,j, created by next(), such that data returned by next() is
-   /// found at SatPassList[i].spdvector[j] where map[i]=j.
+   /// found at epoch j of SatPassList[i] where map[i]=j.
    std::map<unsigned int,unsigned int> nextIndexMap;
 
 }; // end class SatPassIterator
@@ -305,7 +305,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { index = classIndex++; };
+      { index = nextIndex(classIndex); };
 
 
    }; // End of class 'BasicModel'
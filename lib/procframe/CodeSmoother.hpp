@@ -292,7 +292,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { (*this).index = classIndex++; };
+      { (*this).index = nextIndex(classIndex); };
 
 
    }; // End of class 'CodeSmoother'
@@ -49,14 +49,14 @@ namespace gpstk
 
 
 
-      /* Returns a satTypeValueMap object, adding the new data generated when
-       * calling this object.
+      /* Computes the linear combinations for every satellite in 'gData'.
+       * It works both for satTypeValueMap and satTypeValueTable objects.
        *
        * @param time      Epoch corresponding to the data.
        * @param gData     Data object holding the data.
        */
-   satTypeValueMap& ComputeLinear::Process( const DayTime& time,
-                                            satTypeValueMap& gData )
+   template<class STVMap>
+   STVMap& ComputeLinear::processData( const DayTime& time, STVMap& gData )
       throw(ProcessingException)
    {
 
@@ -64,7 +64,7 @@ namespace gpstk
       {
 
             // Loop through all the satellites
-         satTypeValueMap::iterator it;
+         typename STVMap::iterator it;
          for( it = gData.begin(); it != gData.end(); ++it )
          {
 
@@ -116,7 +116,33 @@ namespace gpstk
 
       }
 
-   }  // End of method 'ComputeLinear::Process()'
+   }  // End of method 'ComputeLinear::processData()'
+
+
+
+      /* Returns a satTypeValueMap object, adding the new data generated when
+       * calling this object.
+       *
+       * @param time      Epoch corresponding to the data.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueMap& ComputeLinear::Process( const DayTime& time,
+                                            satTypeValueMap& gData )
+      throw(ProcessingException)
+   { return processData(time, gData); }
+
+
+
+      /* Returns a satTypeValueTable object, adding the new data generated
+       * when calling this object.
+       *
+       * @param time      Epoch corresponding to the data.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& ComputeLinear::Process( const DayTime& time,
+                                              satTypeValueTable& gData )
+      throw(ProcessingException)
+   { return processData(time, gData); }
 
 
 } // End of namespace gpstk
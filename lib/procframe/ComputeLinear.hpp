@@ -165,6 +165,17 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a satTypeValueTable object, adding the new data
+          *  generated when calling this object.
+          *
+          * @param time      Epoch corresponding to the data.
+          * @param gData     Data object holding the data.
+          */
+      virtual satTypeValueTable& Process( const DayTime& time,
+                                          satTypeValueTable& gData )
+         throw(ProcessingException);
+
+
          /** Returns a gnnsSatTypeValue object, adding the new data 
           *  generated when calling this object.
           *
@@ -185,6 +196,16 @@ namespace gpstk
       { Process(gData.header.epoch, gData.body); return gData; };
 
 
+         /** Returns a gnssRinexTable object, adding the new data generated
+          *  when calling this object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException)
+      { Process(gData.header.epoch, gData.body); return gData; };
+
+
          /// Returns the list of linear combinations to be computed.
       virtual LinearCombList getLinearCombinations(void) const
       { return linearList; };
@@ -243,6 +264,12 @@ namespace gpstk
       LinearCombList linearList;
 
 
+         /// Does the work of both Process() methods above.
+      template<class STVMap>
+      STVMap& processData( const DayTime& time, STVMap& gData )
+         throw(ProcessingException);
+
+
          /// Initial index assigned to this class.
       static int classIndex;
 
@@ -251,7 +278,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { index = classIndex++; };
+      { index = nextIndex(classIndex); };
 
 
    }; // end class ComputeLinear
@@ -1652,18 +1652,26 @@ in matrix and number of types do not match") );
    gnssRinex gnssDataMap::getGnssRinex( const SourceID& source ) const
    {
 
-         // Get first data set
-      gnssDataMap gdMap( (*this).frontEpoch() );
-
          // Declare a gnssRinex object to be returned
       gnssRinex toReturn;
 
+         // Nothing to look for in an empty structure
+      if( (*this).empty() )
+      {
+         return toReturn;
+      }
+
+         // Look only into the first data set. Walk it in place instead of
+         // copying it with 'frontEpoch()', which is costly for big networks
+      gnssDataMap::const_iterator endPos(
+                  (*this).upper_bound( (*(*this).begin()).first + tolerance ) );
+
          // We'll need a flag
       bool found(false);
 
          // Look into the data structure
-      for( gnssDataMap::const_iterator it = gdMap.begin();
-           it != gdMap.end() && !found;
+      for( gnssDataMap::const_iterator it = (*this).begin();
+           it != endPos && !found;
            ++it )
       {
 
@@ -2049,8 +2057,14 @@ in matrix and number of types do not match") );
       throw( ValueNotFound )
    {
 
-         // Look for the epoch (DayTime) data
-      gnssDataMap gdMap( frontEpoch() );
+         // Look for the first epoch (DayTime) data. Walk it in place
+         // instead of copying it with 'frontEpoch()', as this method is
+         // called once per equation by the solvers
+      gnssDataMap::const_iterator endPos( (*this).end() );
+      if( !(*this).empty() )
+      {
+         endPos = (*this).upper_bound( (*(*this).begin()).first + tolerance );
+      }
 
          // Value to be returned
       double toReturn;
@@ -2059,20 +2073,24 @@ in matrix and number of types do not match") );
       bool found(false);
 
          // Look into the data structure
-      for( gnssDataMap::const_iterator it = gdMap.begin();
-           it != gdMap.end() && !found;
+      for( gnssDataMap::const_iterator it = (*this).begin();
+           it != endPos && !found;
            ++it )
       {
 
-         try
-         {
-            toReturn = (*it).second.getValue( source, satellite, type );
-            found = true;
-         }
-         catch(...)
-         {
-            continue;
-         }
+            // Look for the source, satellite and type without throwing, as
+            // each source usually lives in its own element
+         sourceDataMap::const_iterator it2( (*it).second.find(source) );
+         if( it2 == (*it).second.end() ) continue;
+
+         satTypeValueMap::const_iterator it3( (*it2).second.find(satellite) );
+         if( it3 == (*it2).second.end() ) continue;
+
+         typeValueMap::const_iterator it4( (*it3).second.find(type) );
+         if( it4 == (*it3).second.end() ) continue;
+
+         toReturn = (*it4).second;
+         found = true;
 
       }
 
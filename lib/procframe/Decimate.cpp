@@ -88,14 +88,14 @@ namespace gpstk
 
 
 
-      /* Returns a satTypeValueMap object, adding the new data generated when
-       * calling this object.
+      /* Decides if the epoch must be decimated. It works both for
+       * satTypeValueMap and satTypeValueTable objects.
        *
        * @param time      Epoch corresponding to the data.
        * @param gData     Data object holding the data.
        */
-   satTypeValueMap& Decimate::Process( const DayTime& time,
-                                       satTypeValueMap& gData )
+   template<class STVMap>
+   STVMap& Decimate::processData( const DayTime& time, STVMap& gData )
       throw(DecimateEpoch)
    {
 
@@ -119,7 +119,33 @@ namespace gpstk
 
       return gData;
 
-   }  // End of method 'Decimate::Process()'
+   }  // End of method 'Decimate::processData()'
+
+
+
+      /* Returns a satTypeValueMap object, adding the new data generated when
+       * calling this object.
+       *
+       * @param time      Epoch corresponding to the data.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueMap& Decimate::Process( const DayTime& time,
+                                       satTypeValueMap& gData )
+      throw(DecimateEpoch)
+   { return processData(time, gData); }
+
+
+
+      /* Returns a satTypeValueTable object, adding the new data generated
+       * when calling this object.
+       *
+       * @param time      Epoch corresponding to the data.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& Decimate::Process( const DayTime& time,
+                                         satTypeValueTable& gData )
+      throw(DecimateEpoch)
+   { return processData(time, gData); }
 
 
 
@@ -179,6 +179,17 @@ namespace gpstk
          throw(DecimateEpoch);
 
 
+         /** Returns a satTypeValueTable object, adding the new data
+          *  generated when calling this object.
+          *
+          * @param time      Epoch corresponding to the data.
+          * @param gData     Data object holding the data.
+          */
+      virtual satTypeValueTable& Process( const DayTime& time,
+                                          satTypeValueTable& gData )
+         throw(DecimateEpoch);
+
+
          /** Returns a gnnsSatTypeValue object, adding the new data
           *  generated when calling this object.
           *
@@ -199,6 +210,16 @@ namespace gpstk
       { Process(gData.header.epoch, gData.body); return gData; };
 
 
+         /** Returns a gnssRinexTable object, adding the new data generated
+          *  when calling this object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(DecimateEpoch)
+      { Process(gData.header.epoch, gData.body); return gData; };
+
+
          /// Returns sampling interval, in seconds.
       virtual double getSampleInterval(void) const
       { return sampling; };
@@ -255,6 +276,11 @@ namespace gpstk
          /// Last processed epoch
       DayTime lastEpoch;
 
+         /// Does the work of both Process() methods above.
+      template<class STVMap>
+      STVMap& processData( const DayTime& time, STVMap& gData )
+         throw(DecimateEpoch);
+
          /// Initial index assigned to this class.
       static int classIndex;
 
@@ -263,7 +289,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { index = classIndex++; };
+      { index = nextIndex(classIndex); };
 
 
    }; // End of class 'Decimate'
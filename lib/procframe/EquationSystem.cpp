@@ -191,15 +191,21 @@ namespace gpstk
          // Now, let's update the global set of unknowns with current unknowns
       varUnknowns.insert( currentUnknowns.begin(), currentUnknowns.end() );
 
-         // Compute phiMatrix and qMatrix
+         // Compute phi and q diagonals
       getPhiQ(gdsMap);
 
+         // Index the data of each source
+      prepareSourceDataIndex(gdsMap);
+
          // Build prefit residuals vector
       getPrefit(gdsMap);
 
          // Get geometry and weights matrices
       getGeometryWeights(gdsMap);
 
+         // Pointers in the index are only valid while preparing
+      sourceDataIndex.clear();
+
          // Set this object as "prepared"
       isPrepared = true;
 
@@ -492,9 +498,12 @@ namespace gpstk
 
       const int numVar( varUnknowns.size() );
 
-         // Resize phiMatrix and qMatrix
-      phiMatrix.resize( numVar, numVar, 0.0);
-      qMatrix.resize( numVar, numVar, 0.0);
+         // Resize phiVector and qVector
+      phiVector.assign(numVar, 0.0);
+      qVector.assign(numVar, 0.0);
+
+         // 'gnssRinex' objects already extracted from 'gdsMap', per source
+      std::map<SourceID, gnssRinex> gRinMap;
 
          // Set a counter
       int i(0);
@@ -509,8 +518,17 @@ namespace gpstk
          if( currentUnknowns.find( (*itVar) ) != currentUnknowns.end() )
          {
 
-               // Get a 'gnssRinex' data structure
-            gnssRinex gRin( gdsMap.getGnssRinex( (*itVar).getSource() ) );
+               // Get a 'gnssRinex' data structure. Extracting it is costly,
+               // so it is done once per source
+            SourceID source( (*itVar).getSource() );
+            std::map<SourceID, gnssRinex>::iterator itRin(
+                                                   gRinMap.find(source) );
+            if( itRin == gRinMap.end() )
+            {
+               itRin = gRinMap.insert( std::make_pair( source,
+                                    gdsMap.getGnssRinex(source) ) ).first;
+            }
+            gnssRinex& gRin( (*itRin).second );
 
                // Prepare variable's stochastic model
             (*itVar).getModel()->Prepare( (*itVar).getType(),
@@ -521,15 +539,15 @@ namespace gpstk
             if( oldUnknowns.find( (*itVar) ) != oldUnknowns.end() )
             {
                   // This variable is 'old'; compute its phi and q values
-               phiMatrix(i,i) = (*itVar).getModel()->getPhi();
-               qMatrix(i,i)   = (*itVar).getModel()->getQ();
+               phiVector[i] = (*itVar).getModel()->getPhi();
+               qVector[i]   = (*itVar).getModel()->getQ();
             }
             else
             {
                   // This variable is 'new', so let's use its initial variance
                   // instead of its stochastic model
-               phiMatrix(i,i) = 0.0;
-               qMatrix(i,i)   = (*itVar).getInitialVariance();
+               phiVector[i] = 0.0;
+               qVector[i]   = (*itVar).getInitialVariance();
             }
 
          }
@@ -537,8 +555,8 @@ namespace gpstk
          {
                // If (*itVar) is NOT inside 'currentUnknowns', then apply it
                // a white noise stochastic model to decorrelate it
-            phiMatrix(i,i) = whiteNoiseModel.getPhi();
-            qMatrix(i,i)   = whiteNoiseModel.getQ();
+            phiVector[i] = whiteNoiseModel.getPhi();
+            qVector[i]   = whiteNoiseModel.getQ();
          }
 
             // Increment counter
@@ -567,7 +585,7 @@ namespace gpstk
       {
 
             // Store SourceID, SatID and TypeID of current equation
-         tempPrefit.push_back( gdsMap.getValue( (*itEq).header.equationSource,
+         tempPrefit.push_back( getSourceValue( (*itEq).header.equationSource,
                                           (*itEq).header.equationSat,
                                           (*itEq).header.indTerm.getType() ) );
 
@@ -583,16 +601,28 @@ namespace gpstk
 
 
 
-      // Compute hMatrix and rMatrix
+      // Compute hRows and weightVector
    void EquationSystem::getGeometryWeights( gnssDataMap& gdsMap )
    {
 
-         // Resize hMatrix and rMatrix
-      hMatrix.resize( measVector.size(), varUnknowns.size(), 0.0);
-      rMatrix.resize( measVector.size(),  measVector.size(), 0.0);
+         // Resize hRows and weightVector
+      hRows.assign( measVector.size(), GeometryRow() );
+      weightVector.assign( measVector.size(), 0.0 );
+
+         // Column of each unknown, so that every equation only visits its
+         // own variables instead of all the unknowns
+      std::map<Variable, int> colMap;
+      int numCol(0);
+      for( VariableSet::const_iterator itCol = varUnknowns.begin();
+           itCol != varUnknowns.end();
+           ++itCol )
+      {
+         colMap[ (*itCol) ] = numCol;
+         ++numCol;
+      }
 
-         // Let's work with the first element of the data structure
-      gnssDataMap gds2( gdsMap.frontEpoch() );
+         // Data types present for each source, computed once per source
+      std::map<SourceID, TypeIDSet> typeSetMap;
 
          // Let's fill weights and geometry matrices
       int row(0);                      // Declare a counter for row number
@@ -607,26 +637,28 @@ namespace gpstk
          SatID sat( (*itRow).header.equationSat );
 
             // Get a TypeIDSet with all the data types present in current GDS
-            // Declare an appropriate object
-         TypeIDSet typeSet;
+         std::map<SourceID, TypeIDSet>::iterator itTypes(
+                                                   typeSetMap.find(source) );
+         if( itTypes == typeSetMap.end() )
+         {
 
-            // We need a flag
-         bool found( false );
+               // Declare an appropriate object
+            TypeIDSet typeSet;
 
-            // Iterate through data structure
-         for( gnssDataMap::const_iterator itGDS = gds2.begin();
-              itGDS != gds2.end() && !found;
-              ++itGDS )
-         {
                // Look for source
-            sourceDataMap::const_iterator itSDM = (*itGDS).second.find(source);
-            if( itSDM != (*itGDS).second.end() )
+            std::map<SourceID, const satTypeValueMap*>::const_iterator itSDM(
+                                             sourceDataIndex.find(source) );
+            if( itSDM != sourceDataIndex.end() )
             {
                   // Get the types
-               typeSet = (*itSDM).second.getTypeID();
-               found = true;
+               typeSet = (*itSDM).second->getTypeID();
             }
+
+            itTypes = typeSetMap.insert(
+                                 std::make_pair(source, typeSet) ).first;
+
          }
+         const TypeIDSet& typeSet( (*itTypes).second );
 
 
             // First, fill weights matrix
@@ -635,64 +667,72 @@ namespace gpstk
          if( typeSet.find(TypeID::weight) != typeSet.end() )
          {
                // Weights matrix = Equation weight * observation weight
-            rMatrix(row,row) = (*itRow).header.constWeight
-                               * gds2.getValue(source, sat, TypeID::weight);
+            weightVector[row] = (*itRow).header.constWeight
+                                * getSourceValue(source, sat, TypeID::weight);
          }
          else
          {
                // Weights matrix = Equation weight
-            rMatrix(row,row) = (*itRow).header.constWeight;
+            weightVector[row] = (*itRow).header.constWeight;
          }
 
             // Second, fill geometry matrix: Look for equation coefficients
-         int col(0);                   // Declare a counter for column number
-         for( VariableSet::const_iterator itCol = varUnknowns.begin();
-              itCol != varUnknowns.end();
+         GeometryRow& hRow( hRows[row] );
+         for( VariableSet::const_iterator itCol = (*itRow).body.begin();
+              itCol != (*itRow).body.end();
               ++itCol )
          {
 
-               // Check if unknown is in current equation and also is marked
-               // as a current unknown
-            if( (*itRow).body.find( (*itCol) ) != (*itRow).body.end() &&
-                currentUnknowns.find( (*itCol) ) != currentUnknowns.end() )
+               // Check if unknown is marked as a current unknown
+            std::map<Variable, int>::const_iterator itMap(
+                                                   colMap.find( (*itCol) ) );
+            if( itMap == colMap.end() ||
+                currentUnknowns.find( (*itCol) ) == currentUnknowns.end() )
+            {
+               continue;
+            }
+
+               // Use the unknown as stored in 'varUnknowns'
+            const Variable& var( (*itMap).first );
+            int col( (*itMap).second );
+
+               // Check if '(*itCol)' unknown variable enforces a specific
+               // coefficient
+            if( var.isDefaultForced() )
+            {
+                  // Use default coefficient
+               hRow.push_back( std::make_pair( col,
+                                          var.getDefaultCoefficient() ) );
+            }
+            else
             {
+                  // Look the coefficient in provided data
 
-                  // Check if '(*itCol)' unknown variable enforces a specific
-                  // coefficient
-               if( (*itCol).isDefaultForced() )
+                  // Get type of current varUnknown
+               TypeID type( var.getType() );
+
+                  // Check if this type has an entry in current GDS type set
+               if( typeSet.find(type) != typeSet.end() )
                {
-                     // Use default coefficient
-                  hMatrix(row,col) = (*itCol).getDefaultCoefficient();
+                     // If type was found, insert value into hMatrix
+                  hRow.push_back( std::make_pair( col,
+                                       getSourceValue(source, sat, type) ) );
                }
                else
                {
-                     // Look the coefficient in provided data
-
-                     // Get type of current varUnknown
-                  TypeID type( (*itCol).getType() );
-
-                     // Check if this type has an entry in current GDS type set
-                  if( typeSet.find(type) != typeSet.end() )
-                  {
-                        // If type was found, insert value into hMatrix
-                     hMatrix(row,col) = gds2.getValue(source, sat, type);
-                  }
-                  else
-                  {
-                        // If value for current type is not in gdsMap, then
-                        // insert default coefficient for this variable
-                     hMatrix(row,col) = (*itCol).getDefaultCoefficient();
-                  }
-
-               }  // End of 'if( (*itCol).isDefaultForced() ) ...'
-
-            }  // End of 'if( (*itRow).body.find( (*itCol) ) != ...'
+                     // If value for current type is not in gdsMap, then
+                     // insert default coefficient for this variable
+                  hRow.push_back( std::make_pair( col,
+                                          var.getDefaultCoefficient() ) );
+               }
 
-               // Increment column counter
-            ++col;
+            }  // End of 'if( (*itCol).isDefaultForced() ) ...'
 
          }  // End of 'for( VariableSet::const_iterator itCol = ...'
 
+            // Columns were visited in 'varUnknowns' order, so 'hRow' is
+            // already sorted
+
             // Handle type index variable
          for( VariableSet::const_iterator itCol = (*itRow).body.begin();
              itCol != (*itRow).body.end();
@@ -704,7 +744,7 @@ namespace gpstk
 
             Variable var(*itr);
 
-            col = 0;            
+            int col(0);
             for( VariableSet::const_iterator it = varUnknowns.begin(); it != varUnknowns.end(); it++)
             {
                 if(((*itCol).getType() == (*it).getType())                  &&
@@ -721,13 +761,17 @@ namespace gpstk
                 col++;    
             }
 
-            
+               // No matching unknown: nothing to fill
+            if( col >= numCol ) continue;
+
+            double coef(0.0);
+
             // Check if '(*itCol)' unknown variable enforces a specific
             // coefficient
             if( (*itCol).isDefaultForced() )
             {
                    // Use default coefficient
-                hMatrix(row,col) = (*itCol).getDefaultCoefficient();
+                coef = (*itCol).getDefaultCoefficient();
             }
             else
             {
@@ -740,17 +784,30 @@ namespace gpstk
                 if( typeSet.find(type) != typeSet.end() )
                 {
                        // If type was found, insert value into hMatrix
-                    hMatrix(row,col) = gds2.getValue(source, sat, type);
+                    coef = getSourceValue(source, sat, type);
                 }
                 else
                 {
                       // If value for current type is not in gdsMap, then
                       // insert default coefficient for this variable
-                    hMatrix(row,col) = (*itCol).getDefaultCoefficient();
+                    coef = (*itCol).getDefaultCoefficient();
                 }
 
             }  // End of 'if( (*itCol).isDefaultForced() ) ...'
-            
+
+               // Overwrite the coefficient if this column was already set,
+               // keeping 'hRow' sorted by column
+            GeometryRow::iterator itH( hRow.begin() );
+            while( itH != hRow.end() && (*itH).first < col ) ++itH;
+            if( itH != hRow.end() && (*itH).first == col )
+            {
+               (*itH).second = coef;
+            }
+            else
+            {
+               hRow.insert( itH, std::make_pair(col, coef) );
+            }
+
          }
 
             // Increment row number
@@ -765,6 +822,72 @@ namespace gpstk
 
 
 
+      // Fill 'sourceDataIndex' with the data in 'gdsMap'
+   void EquationSystem::prepareSourceDataIndex( const gnssDataMap& gdsMap )
+   {
+
+      sourceDataIndex.clear();
+
+      if( gdsMap.empty() )
+      {
+         return;
+      }
+
+         // Only the first epoch is used, as in 'gnssDataMap::getValue()'
+      DayTime firstEpoch( (*gdsMap.begin()).first );
+      gnssDataMap::const_iterator endPos(
+                  gdsMap.upper_bound( firstEpoch + gdsMap.getTolerance() ) );
+
+      for( gnssDataMap::const_iterator it = gdsMap.begin();
+           it != endPos;
+           ++it )
+      {
+         for( sourceDataMap::const_iterator itSDM = (*it).second.begin();
+              itSDM != (*it).second.end();
+              ++itSDM )
+         {
+               // Keep the first match, as 'gnssDataMap::getValue()' does
+            sourceDataIndex.insert(
+                           std::make_pair( (*itSDM).first, &(*itSDM).second ) );
+         }
+      }
+
+      return;
+
+   }  // End of method 'EquationSystem::prepareSourceDataIndex()'
+
+
+
+      // Get the value of a given type from 'sourceDataIndex'
+   double EquationSystem::getSourceValue( const SourceID& source,
+                                          const SatID& sat,
+                                          const TypeID& type ) const
+      throw(ValueNotFound)
+   {
+
+      std::map<SourceID, const satTypeValueMap*>::const_iterator itSDM(
+                                             sourceDataIndex.find(source) );
+      if( itSDM != sourceDataIndex.end() )
+      {
+         satTypeValueMap::const_iterator itSat(
+                                          (*itSDM).second->find(sat) );
+         if( itSat != (*itSDM).second->end() )
+         {
+            typeValueMap::const_iterator itType(
+                                          (*itSat).second.find(type) );
+            if( itType != (*itSat).second.end() )
+            {
+               return (*itType).second;
+            }
+         }
+      }
+
+      GPSTK_THROW(ValueNotFound("Value not found"));
+
+   }  // End of method 'EquationSystem::getSourceValue()'
+
+
+
       /* Return the TOTAL number of variables being processed.
        *
        * \warning You must call method Prepare() first, otherwise this
@@ -974,6 +1097,18 @@ namespace gpstk
          GPSTK_THROW(InvalidEquationSystem("EquationSystem is not prepared"));
       }
 
+      int numRow( hRows.size() );
+      Matrix<double> hMatrix( numRow, varUnknowns.size(), 0.0 );
+      for( int row = 0; row < numRow; ++row )
+      {
+         for( GeometryRow::const_iterator it = hRows[row].begin();
+              it != hRows[row].end();
+              ++it )
+         {
+            hMatrix( row, (*it).first ) = (*it).second;
+         }
+      }
+
       return hMatrix;
 
    }  // End of method 'EquationSystem::getGeometryMatrix()'
@@ -996,6 +1131,13 @@ namespace gpstk
          GPSTK_THROW(InvalidEquationSystem("EquationSystem is not prepared"));
       }
 
+      int numVar( weightVector.size() );
+      Matrix<double> rMatrix( numVar, numVar, 0.0 );
+      for( int i = 0; i < numVar; ++i )
+      {
+         rMatrix(i,i) = weightVector[i];
+      }
+
       return rMatrix;
 
    }  // End of method 'EquationSystem::getWeightsMatrix()'
@@ -1017,6 +1159,13 @@ namespace gpstk
          GPSTK_THROW(InvalidEquationSystem("EquationSystem is not prepared"));
       }
 
+      int numVar( phiVector.size() );
+      Matrix<double> phiMatrix( numVar, numVar, 0.0 );
+      for( int i = 0; i < numVar; ++i )
+      {
+         phiMatrix(i,i) = phiVector[i];
+      }
+
       return phiMatrix;
 
    }  // End of method 'EquationSystem::getPhiMatrix()'
@@ -1039,10 +1188,104 @@ namespace gpstk
          GPSTK_THROW(InvalidEquationSystem("EquationSystem is not prepared"));
       }
 
+      int numVar( qVector.size() );
+      Matrix<double> qMatrix( numVar, numVar, 0.0 );
+      for( int i = 0; i < numVar; ++i )
+      {
+         qMatrix(i,i) = qVector[i];
+      }
+
       return qMatrix;
 
    }  // End of method 'EquationSystem::getQMatrix()'
 
 
 
+      /* Get the non-zero coefficients of the geometry matrix, one
+       *  GeometryRow per current equation.
+       *
+       * \warning You must call method Prepare() first, otherwise this
+       * method will throw an InvalidEquationSystem exception.
+       */
+   const std::vector<EquationSystem::GeometryRow>&
+   EquationSystem::getGeometryRows() const
+      throw(InvalidEquationSystem)
+   {
+
+         // If the object as not ready, throw an exception
+      if (!isPrepared)
+      {
+         GPSTK_THROW(InvalidEquationSystem("EquationSystem is not prepared"));
+      }
+
+      return hRows;
+
+   }  // End of method 'EquationSystem::getGeometryRows()'
+
+
+
+      /* Get the diagonal of the weights matrix.
+       *
+       * \warning You must call method Prepare() first, otherwise this
+       * method will throw an InvalidEquationSystem exception.
+       */
+   const std::vector<double>& EquationSystem::getWeightsDiagonal() const
+      throw(InvalidEquationSystem)
+   {
+
+         // If the object as not ready, throw an exception
+      if (!isPrepared)
+      {
+         GPSTK_THROW(InvalidEquationSystem("EquationSystem is not prepared"));
+      }
+
+      return weightVector;
+
+   }  // End of method 'EquationSystem::getWeightsDiagonal()'
+
+
+
+      /* Get the diagonal of the State Transition Matrix (PhiMatrix).
+       *
+       * \warning You must call method Prepare() first, otherwise this
+       * method will throw an InvalidEquationSystem exception.
+       */
+   const std::vector<double>& EquationSystem::getPhiDiagonal() const
+      throw(InvalidEquationSystem)
+   {
+
+         // If the object as not ready, throw an exception
+      if (!isPrepared)
+      {
+         GPSTK_THROW(InvalidEquationSystem("EquationSystem is not prepared"));
+      }
+
+      return phiVector;
+
+   }  // End of method 'EquationSystem::getPhiDiagonal()'
+
+
+
+      /* Get the diagonal of the Process Noise Covariance Matrix
+       *  (QMatrix).
+       *
+       * \warning You must call method Prepare() first, otherwise this
+       * method will throw an InvalidEquationSystem exception.
+       */
+   const std::vector<double>& EquationSystem::getQDiagonal() const
+      throw(InvalidEquationSystem)
+   {
+
+         // If the object as not ready, throw an exception
+      if (!isPrepared)
+      {
+         GPSTK_THROW(InvalidEquationSystem("EquationSystem is not prepared"));
+      }
+
+      return qVector;
+
+   }  // End of method 'EquationSystem::getQDiagonal()'
+
+
+
 }  // End of namespace gpstk
@@ -161,6 +161,11 @@ namespace gpstk
    {
    public:
 
+         /// Non-zero coefficients of one row of the geometry matrix, as
+         /// (column, coefficient) pairs.
+      typedef std::vector< std::pair<int, double> > GeometryRow;
+
+
          /// Default constructor
       EquationSystem()
          : isPrepared(false)
@@ -341,6 +346,47 @@ namespace gpstk
          throw(InvalidEquationSystem);
 
 
+         /** Get the non-zero coefficients of the geometry matrix, one
+          *  GeometryRow per current equation. Columns follow the order of
+          *  getVarUnknowns().
+          *
+          * \warning You must call method Prepare() first, otherwise this
+          * method will throw an InvalidEquationSystem exception.
+          */
+      virtual const std::vector<GeometryRow>& getGeometryRows() const
+         throw(InvalidEquationSystem);
+
+
+         /** Get the diagonal of the weights matrix. This matrix is always
+          *  diagonal.
+          *
+          * \warning You must call method Prepare() first, otherwise this
+          * method will throw an InvalidEquationSystem exception.
+          */
+      virtual const std::vector<double>& getWeightsDiagonal() const
+         throw(InvalidEquationSystem);
+
+
+         /** Get the diagonal of the State Transition Matrix (PhiMatrix).
+          *  This matrix is always diagonal.
+          *
+          * \warning You must call method Prepare() first, otherwise this
+          * method will throw an InvalidEquationSystem exception.
+          */
+      virtual const std::vector<double>& getPhiDiagonal() const
+         throw(InvalidEquationSystem);
+
+
+         /** Get the diagonal of the Process Noise Covariance Matrix
+          *  (QMatrix). This matrix is always diagonal.
+          *
+          * \warning You must call method Prepare() first, otherwise this
+          * method will throw an InvalidEquationSystem exception.
+          */
+      virtual const std::vector<double>& getQDiagonal() const
+         throw(InvalidEquationSystem);
+
+
          /// Get the number of equation descriptions being currently processed.
       virtual int getEquationDefinitionNumber() const
       { return equationDescriptionList.size(); };
@@ -388,17 +434,19 @@ namespace gpstk
          /// Set containing satellites being currently processed
       SatIDSet currentSatSet;
 
-         /// State Transition Matrix (PhiMatrix)
-      Matrix<double> phiMatrix;
+         /// Diagonal of the State Transition Matrix (PhiMatrix). Full
+         /// matrices are only built when asked for, as they grow with the
+         /// square of the number of unknowns.
+      std::vector<double> phiVector;
 
-         /// Process noise covariance matrix (QMatrix)
-      Matrix<double> qMatrix;
+         /// Diagonal of the process noise covariance matrix (QMatrix)
+      std::vector<double> qVector;
 
-         /// Geometry matrix
-      Matrix<double> hMatrix;
+         /// Non-zero coefficients of the geometry matrix
+      std::vector<GeometryRow> hRows;
 
-         /// Weights matrix
-      Matrix<double> rMatrix;
+         /// Diagonal of the weights matrix
+      std::vector<double> weightVector;
 
          /// Measurements vector (Prefit-residuals)
       Vector<double> measVector;
@@ -409,15 +457,28 @@ namespace gpstk
          /// Prepare set of current unknowns and list of current equations
       VariableSet prepareCurrentUnknownsAndEquations( gnssDataMap& gdsMap );
 
-         /// Compute phiMatrix and qMatrix
+         /// Compute phi and q diagonals
       void getPhiQ( const gnssDataMap& gdsMap );
 
          /// Compute prefit residuals vector
       void getPrefit( gnssDataMap& gdsMap );
 
-         /// Compute hMatrix and rMatrix
+         /// Compute geometry rows and weights diagonal
       void getGeometryWeights( gnssDataMap& gdsMap );
 
+         /// Map holding the data of each source in the first epoch of the
+         /// GDS being processed, so it is looked for only once
+      std::map<SourceID, const satTypeValueMap*> sourceDataIndex;
+
+         /// Fill 'sourceDataIndex' with the data in 'gdsMap'
+      void prepareSourceDataIndex( const gnssDataMap& gdsMap );
+
+         /// Get the value of a given type from 'sourceDataIndex'
+      double getSourceValue( const SourceID& source,
+                             const SatID& sat,
+                             const TypeID& type ) const
+         throw(ValueNotFound);
+
          /// General white noise stochastic model
       static WhiteNoiseModel whiteNoiseModel;
 
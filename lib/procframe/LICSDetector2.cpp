@@ -75,16 +75,17 @@ namespace gpstk
 
 
 
-      /* Returns a satTypeValueMap object, adding the new data generated
-       *  when calling this object.
+      /* Runs the cycle slip detector on every satellite in 'gData'. It
+       * works both for satTypeValueMap and satTypeValueTable objects.
        *
        * @param epoch     Time of observations.
        * @param gData     Data object holding the data.
        * @param epochflag Epoch flag.
        */
-   satTypeValueMap& LICSDetector2::Process( const DayTime& epoch,
-                                            satTypeValueMap& gData,
-                                            const short& epochflag )
+   template<class STVMap>
+   STVMap& LICSDetector2::processData( const DayTime& epoch,
+                                       STVMap& gData,
+                                       const short& epochflag )
       throw(ProcessingException)
    {
 
@@ -98,7 +99,7 @@ namespace gpstk
          SatIDSet satRejectedSet;
 
             // Loop through all the satellites
-         satTypeValueMap::iterator it;
+         typename STVMap::iterator it;
          for (it = gData.begin(); it != gData.end(); ++it)
          {
             try
@@ -179,7 +180,37 @@ namespace gpstk
 
       }
 
-   }  // End of method 'LICSDetector2::Process()'
+   }  // End of method 'LICSDetector2::processData()'
+
+
+
+      /* Returns a satTypeValueMap object, adding the new data generated
+       * when calling this object.
+       *
+       * @param epoch     Time of observations.
+       * @param gData     Data object holding the data.
+       * @param epochflag Epoch flag.
+       */
+   satTypeValueMap& LICSDetector2::Process( const DayTime& epoch,
+                                            satTypeValueMap& gData,
+                                            const short& epochflag )
+      throw(ProcessingException)
+   { return processData(epoch, gData, epochflag); }
+
+
+
+      /* Returns a satTypeValueTable object, adding the new data generated
+       * when calling this object.
+       *
+       * @param epoch     Time of observations.
+       * @param gData     Data object holding the data.
+       * @param epochflag Epoch flag.
+       */
+   satTypeValueTable& LICSDetector2::Process( const DayTime& epoch,
+                                              satTypeValueTable& gData,
+                                              const short& epochflag )
+      throw(ProcessingException)
+   { return processData(epoch, gData, epochflag); }
 
 
 
@@ -310,6 +341,37 @@ namespace gpstk
    }  // End of method 'LICSDetector2::Process()'
 
 
+      /* Returns a gnssRinexTable object, adding the new data generated when
+       * calling this object.
+       *
+       * @param gData    Data object holding the data.
+       */
+   gnssRinexTable& LICSDetector2::Process(gnssRinexTable& gData)
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         Process(gData.header.epoch, gData.body, gData.header.epochFlag);
+
+         return gData;
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + StringUtils::asString( getIndex() ) + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of method 'LICSDetector2::Process()'
+
+
       /* Method that implements the LI cycle slip detection algorithm
        *
        * @param epoch     Time of observations.
@@ -320,13 +382,14 @@ namespace gpstk
        * @param lli1      LLI1 index.
        * @param lli2      LLI2 index.
        */
-   double LICSDetector2::getDetection( const DayTime& epoch,
-                                       const SatID& sat,
-                                       typeValueMap& tvMap,
-                                       const short& epochflag,
-                                       const double& li,
-                                       const double& lli1,
-                                       const double& lli2 )
+   template<class TVMap>
+   double LICSDetector2::computeDetection( const DayTime& epoch,
+                                           const SatID& sat,
+                                           TVMap& tvMap,
+                                           const short& epochflag,
+                                           const double& li,
+                                           const double& lli1,
+                                           const double& lli2 )
    {
 
       bool reportCS(false);
@@ -537,7 +600,35 @@ namespace gpstk
          return 0.0;
       }
 
-   }  // End of method 'LICSDetector2::getDetection()'
+   }  // End of method 'LICSDetector2::computeDetection()'
+
+
+
+      /* Method that implements the cycle slip detection algorithm, for a
+       * typeValueMap.
+       */
+   double LICSDetector2::getDetection( const DayTime& epoch,
+                                       const SatID& sat,
+                                       typeValueMap& tvMap,
+                                       const short& epochflag,
+                                       const double& li,
+                                       const double& lli1,
+                                       const double& lli2 )
+   { return computeDetection(epoch, sat, tvMap, epochflag, li, lli1, lli2); }
+
+
+
+      /* Method that implements the cycle slip detection algorithm, for a
+       * row of a satTypeValueTable.
+       */
+   double LICSDetector2::getDetection( const DayTime& epoch,
+                                       const SatID& sat,
+                                       typeValueRow& tvMap,
+                                       const short& epochflag,
+                                       const double& li,
+                                       const double& lli1,
+                                       const double& lli2 )
+   { return computeDetection(epoch, sat, tvMap, epochflag, li, lli1, lli2); }
 
 
 
@@ -164,6 +164,19 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a satTypeValueTable object, adding the new data
+          *  generated when calling this object.
+          *
+          * @param epoch     Time of observations.
+          * @param gData     Data object holding the data.
+          * @param epochflag Epoch flag.
+          */
+      virtual satTypeValueTable& Process( const DayTime& epoch,
+                                          satTypeValueTable& gData,
+                                          const short& epochflag = 0 )
+         throw(ProcessingException);
+
+
 
          /** Method to get the maximum interval of time allowed between two
           *  successive epochs, in seconds.
@@ -261,6 +274,15 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a gnssRinexTable object, adding the new data generated
+          *  when calling this object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException);
+
+
          /// Returns an index identifying this object.
       virtual int getIndex(void) const;
 
@@ -273,6 +295,39 @@ namespace gpstk
       virtual ~LICSDetector2() {};
 
 
+   protected:
+
+
+         /** Method that implements the LI cycle slip detection algorithm
+          *
+          * @param epoch     Time of observations.
+          * @param sat       SatID.
+          * @param tvMap     Data structure of TypeID and values.
+          * @param epochflag Epoch flag.
+          * @param li        Current LI observation value.
+          * @param lli1      LLI1 index.
+          * @param lli2      LLI2 index.
+          */
+      virtual double getDetection( const DayTime& epoch,
+                                   const SatID& sat,
+                                   typeValueMap& tvMap,
+                                   const short& epochflag,
+                                   const double& li,
+                                   const double& lli1,
+                                   const double& lli2 );
+
+
+         /// The same as above, for a row of a satTypeValueTable. A class
+         /// that overrides one of these should override both.
+      virtual double getDetection( const DayTime& epoch,
+                                   const SatID& sat,
+                                   typeValueRow& tvMap,
+                                   const short& epochflag,
+                                   const double& li,
+                                   const double& lli1,
+                                   const double& lli2 );
+
+
    private:
 
 
@@ -338,23 +393,23 @@ namespace gpstk
       std::map<SatID, filterData> LIData;
 
 
-         /** Method that implements the LI cycle slip detection algorithm
-          *
-          * @param epoch     Time of observations.
-          * @param sat       SatID.
-          * @param tvMap     Data structure of TypeID and values.
-          * @param epochflag Epoch flag.
-          * @param li        Current LI observation value.
-          * @param lli1      LLI1 index.
-          * @param lli2      LLI2 index.
-          */
-      virtual double getDetection( const DayTime& epoch,
-                                   const SatID& sat,
-                                   typeValueMap& tvMap,
-                                   const short& epochflag,
-                                   const double& li,
-                                   const double& lli1,
-                                   const double& lli2 );
+         /// Does the work of both getDetection() methods.
+      template<class TVMap>
+      double computeDetection( const DayTime& epoch,
+                               const SatID& sat,
+                               TVMap& tvMap,
+                               const short& epochflag,
+                               const double& li,
+                               const double& lli1,
+                               const double& lli2 );
+
+
+         /// Does the work of both Process() methods above.
+      template<class STVMap>
+      STVMap& processData( const DayTime& epoch,
+                           STVMap& gData,
+                           const short& epochflag )
+         throw(ProcessingException);
 
 
          /// Initial index assigned to this class.
@@ -367,7 +422,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { index = classIndex++; };
+      { index = nextIndex(classIndex); };
 
 
    }; // End of class 'LICSDetector2'
@@ -159,6 +159,19 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a satTypeValueTable object, adding the new data
+          *  generated when calling this object.
+          *
+          * @param epoch     Time of observations.
+          * @param gData     Data object holding the data.
+          * @param epochflag Epoch flag.
+          */
+      virtual satTypeValueTable& Process( const DayTime& epoch,
+                                          satTypeValueTable& gData,
+                                          const short& epochflag = 0 )
+         throw(ProcessingException);
+
+
          /** Method to set the maximum interval of time allowed between two
           *  successive epochs.
           *
@@ -224,6 +237,15 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a gnssRinexTable object, adding the new data generated
+          *  when calling this object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException);
+
+
          /// Returns an index identifying this object.
       virtual int getIndex(void) const;
 
@@ -236,6 +258,40 @@ namespace gpstk
       virtual ~MWCSDetector() {};
 
 
+   protected:
+
+
+         /** Method that implements the Melbourne-Wubbena cycle slip
+          *  detection algorithm
+          *
+          * @param epoch     Time of observations.
+          * @param sat       SatID.
+          * @param tvMap     Data structure of TypeID and values.
+          * @param epochflag Epoch flag.
+          * @param mw        Current MW observation value.
+          * @param lli1      LLI1 index.
+          * @param lli2      LLI2 index.
+          */
+      virtual double getDetection( const DayTime& epoch,
+                                   const SatID& sat,
+                                   typeValueMap& tvMap,
+                                   const short& epochflag,
+                                   const double& mw,
+                                   const double& lli1,
+                                   const double& lli2 );
+
+
+         /// The same as above, for a row of a satTypeValueTable. A class
+         /// that overrides one of these should override both.
+      virtual double getDetection( const DayTime& epoch,
+                                   const SatID& sat,
+                                   typeValueRow& tvMap,
+                                   const short& epochflag,
+                                   const double& mw,
+                                   const double& lli1,
+                                   const double& lli2 );
+
+
    private:
 
 
@@ -292,24 +348,23 @@ namespace gpstk
       std::map<SatID, filterData> MWData;
 
 
-         /** Method that implements the Melbourne-Wubbena cycle slip
-          *  detection algorithm
-          *
-          * @param epoch     Time of observations.
-          * @param sat       SatID.
-          * @param tvMap     Data structure of TypeID and values.
-          * @param epochflag Epoch flag.
-          * @param mw        Current MW observation value.
-          * @param lli1      LLI1 index.
-          * @param lli2      LLI2 index.
-          */
-      virtual double getDetection( const DayTime& epoch,
-                                   const SatID& sat,
-                                   typeValueMap& tvMap,
-                                   const short& epochflag,
-                                   const double& mw,
-                                   const double& lli1,
-                                   const double& lli2 );
+         /// Does the work of both getDetection() methods.
+      template<class TVMap>
+      double computeDetection( const DayTime& epoch,
+                               const SatID& sat,
+                               TVMap& tvMap,
+                               const short& epochflag,
+                               const double& mw,
+                               const double& lli1,
+                               const double& lli2 );
+
+
+         /// Does the work of both Process() methods above.
+      template<class STVMap>
+      STVMap& processData( const DayTime& epoch,
+                           STVMap& gData,
+                           const short& epochflag )
+         throw(ProcessingException);
 
 
          /// Initial index assigned to this class.
@@ -322,7 +377,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { (*this).index = classIndex++; };
+      { (*this).index = nextIndex(classIndex); };
 
 
    }; // End of class 'MWCSDetector'
@@ -96,6 +96,33 @@ namespace gpstk
       // First, We clear the data map
       gdsMap.clear();
 
+      std::list<gnssRinex> gRinList;
+
+      if( readEpochData(gRinList) )
+      {
+         std::list<gnssRinex>::const_iterator it;
+         for( it = gRinList.begin(); it != gRinList.end(); ++it )
+         {
+            gdsMap.addGnssRinex(*it);
+         }
+
+         return true;
+      }
+
+      return false;
+
+   }  // End of method 'NetworkObsStreams::readEpochData()'
+
+
+      // Get epoch data of the network, one 'gnssRinex' per receiver
+      // @gRinList  Object hold epoch observation data of the network
+      // @return    Is there more epoch data for the network 
+   bool NetworkObsStreams::readEpochData(std::list<gnssRinex>& gRinList)
+      throw(SynchronizeException)
+   {
+      // First, We clear the data list
+      gRinList.clear();
+
 
       RinexObsStream* pRefObsStream = mapSourceStream[referenceSource];
 
@@ -103,7 +130,7 @@ namespace gpstk
   
       if( (*pRefObsStream) >> gRef )
       {
-         gdsMap.addGnssRinex(gRef);
+         gRinList.push_back(gRef);
 
          std::map<SourceID, RinexObsStream*>::iterator it;
          for( it = mapSourceStream.begin();
@@ -119,7 +146,7 @@ namespace gpstk
             try
             {
                gRin >> synchro;
-               gdsMap.addGnssRinex(gRin);
+               gRinList.push_back(gRin);
             }
             catch(...)
             {
@@ -114,6 +114,14 @@ namespace gpstk
          /// @return  Is there more epoch data for the network 
       bool readEpochData(gnssDataMap& gdsMap)
          throw(SynchronizeException);
+
+         /// Get epoch data of the network, keeping the data of each
+         /// receiver (header included) in its own 'gnssRinex' object,
+         /// reference receiver first
+         /// @gRinList  Object hold epoch observation data of the network
+         /// @return    Is there more epoch data for the network 
+      bool readEpochData(std::list<gnssRinex>& gRinList)
+         throw(SynchronizeException);
          
          /// Get the SourceID of the rinex observation file
       SourceID sourceIDOfRinexObsFile(std::string obsFile);
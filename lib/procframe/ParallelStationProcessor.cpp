@@ -0,0 +1,192 @@
+#pragma ident "$Id$"
+
+/**
+ * @file ParallelStationProcessor.cpp
+ * This class runs the processing chains of the receivers of a network in
+ * parallel, one chain per receiver, and joins the results in a
+ * 'gnssDataMap'.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <vector>
+
+#include "ParallelStationProcessor.hpp"
+
+
+namespace gpstk
+{
+
+   namespace
+   {
+
+         // The data of one epoch, grouped by processing object: each item
+         // runs one object over all the receivers it was given (normally
+         // just one), so no object is ever used by two threads at once.
+      class StationTask : public ThreadPoolTask
+      {
+      public:
+
+         struct Group
+         {
+            ProcessingClass* pClass;
+            std::vector<gnssRinex*> data;
+         };
+
+         std::vector<Group> groups;
+
+            // Receivers whose processing failed, and why; one map per
+            // item, as items may fail at the same time
+         std::vector< std::map<gnssRinex*, std::string> > groupFailures;
+
+         virtual void process(size_t i)
+         {
+            Group& group = groups[i];
+
+            for( size_t k = 0; k < group.data.size(); k++ )
+            {
+               try
+               {
+                  group.pClass->Process( *group.data[k] );
+               }
+               catch(Exception& e)
+               {
+                  groupFailures[i][group.data[k]] = e.getText();
+               }
+               catch(...)
+               {
+                  groupFailures[i][group.data[k]] = "Unknown exception";
+               }
+            }
+         }
+
+      };  // End of class 'StationTask'
+
+   }  // End of anonymous namespace
+
+
+
+      /* Processes the data of one epoch, one 'gnssRinex' per receiver,
+       * and adds the results to a 'gnssDataMap'.
+       *
+       * @param gRinList   Data of the receivers; processed in place.
+       * @param gdsMap     Map where the results are added.
+       */
+   gnssDataMap& ParallelStationProcessor::Process(
+                                             std::list<gnssRinex>& gRinList,
+                                             gnssDataMap& gdsMap )
+   {
+
+      rejected.clear();
+
+      StationTask task;
+      std::map<ProcessingClass*, size_t> groupOf;
+
+      std::list<gnssRinex>::iterator it;
+      for( it = gRinList.begin(); it != gRinList.end(); ++it )
+      {
+         std::map<SourceID, ProcessingClass*>::const_iterator itStation(
+                                          stations.find( it->header.source ) );
+
+            // Data from receivers without a chain are not processed
+         if( itStation == stations.end() ) continue;
+
+         std::map<ProcessingClass*, size_t>::iterator itGroup(
+                                          groupOf.find( itStation->second ) );
+
+         if( itGroup == groupOf.end() )
+         {
+            StationTask::Group group;
+            group.pClass = itStation->second;
+            task.groups.push_back(group);
+            itGroup = groupOf.insert(
+               std::make_pair( itStation->second, task.groups.size()-1 ) ).first;
+         }
+
+         task.groups[itGroup->second].data.push_back( &(*it) );
+
+      }  // End of 'for( it = gRinList.begin(); ...'
+
+      task.groupFailures.resize( task.groups.size() );
+
+         // Exceptions are caught inside the task, so this doesn't throw
+      pool.run( task, task.groups.size() );
+
+      std::map<gnssRinex*, std::string> failures;
+      for( size_t i = 0; i < task.groupFailures.size(); i++ )
+      {
+         failures.insert( task.groupFailures[i].begin(),
+                          task.groupFailures[i].end() );
+      }
+
+         // Join the results, in the order of the list
+      for( it = gRinList.begin(); it != gRinList.end(); ++it )
+      {
+         std::map<gnssRinex*, std::string>::const_iterator itFail(
+                                                   failures.find( &(*it) ) );
+
+         if( itFail != failures.end() )
+         {
+            rejected[it->header.source] = itFail->second;
+            continue;
+         }
+
+         gdsMap.addGnssRinex(*it);
+      }
+
+      return gdsMap;
+
+   }  // End of method 'ParallelStationProcessor::Process()'
+
+
+
+      /* Reads the next epoch of a network, processes it, and puts the
+       * results in 'gdsMap' (after clearing it).
+       *
+       * @param network    Network data streams.
+       * @param gdsMap     Object to hold the processed data.
+       *
+       * @return  Is there more epoch data for the network
+       */
+   bool ParallelStationProcessor::readEpochData( NetworkObsStreams& network,
+                                                 gnssDataMap& gdsMap )
+      throw(SynchronizeException)
+   {
+
+      gdsMap.clear();
+
+      std::list<gnssRinex> gRinList;
+
+      if( !network.readEpochData(gRinList) )
+      {
+         rejected.clear();
+         return false;
+      }
+
+      Process(gRinList, gdsMap);
+
+      return true;
+
+   }  // End of method 'ParallelStationProcessor::readEpochData()'
+
+
+}  // End of namespace gpstk
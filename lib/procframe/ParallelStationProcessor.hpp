@@ -0,0 +1,186 @@
+#pragma ident "$Id$"
+
+/**
+ * @file ParallelStationProcessor.hpp
+ * This class runs the processing chains of the receivers of a network in
+ * parallel, one chain per receiver, and joins the results in a
+ * 'gnssDataMap'.
+ */
+
+#ifndef GPSTK_PARALLEL_STATION_PROCESSOR_HPP
+#define GPSTK_PARALLEL_STATION_PROCESSOR_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <list>
+#include <map>
+#include <string>
+
+#include "ThreadPool.hpp"
+#include "ProcessingClass.hpp"
+#include "NetworkObsStreams.hpp"
+
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+
+      /** This class runs the processing chains of the receivers of a
+       *  network in parallel.
+       *
+       * Each receiver ('SourceID') gets its own processing object, usually
+       * a 'ProcessingList' built from objects used by that receiver only.
+       * Every epoch, the 'gnssRinex' data of the receivers are handed out
+       * to a pool of threads, each one processed by its receiver's chain,
+       * and the results are joined in a 'gnssDataMap' ready for
+       * 'SolverGeneral'.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   NetworkObsStreams network;
+       *   network.addRinexObsFile("acor1480.08o");
+       *   network.addRinexObsFile("madr1480.08o");
+       *
+       *      // One set of processing objects per receiver
+       *   BasicModel modelAcor(acorPos, SP3EphList), modelMadr(...);
+       *   ProcessingList acorList, madrList;
+       *   acorList.push_back(modelAcor);
+       *   madrList.push_back(modelMadr);
+       *   ...
+       *
+       *   ParallelStationProcessor stations;
+       *   stations.addStation(acorSource, acorList);
+       *   stations.addStation(madrSource, madrList);
+       *
+       *   gnssDataMap gdsMap;
+       *   while( stations.readEpochData(network, gdsMap) )
+       *   {
+       *      gdsMap >> solver;
+       *   }
+       * @endcode
+       *
+       * Processing objects are not copied: the chains of two receivers
+       * must not share any object that changes while processing (cycle
+       * slip detectors, smoothers, models, etc.). Objects only read from
+       * while processing, such as ephemeris stores, may be shared.
+       *
+       * If the chain of a receiver throws an exception at some epoch, the
+       * data of that receiver are left out of the result for that epoch,
+       * and the reason is available through 'getRejected()'. Data from
+       * receivers without a chain are passed on unchanged.
+       */
+   class ParallelStationProcessor
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param numThreads    Number of threads to use; 0 means one per
+          *                      processor.
+          */
+      ParallelStationProcessor(unsigned int numThreads = 0)
+         throw(Exception)
+         : pool(numThreads)
+      {};
+
+
+         /** Sets the processing object to be used for the data of a given
+          *  receiver.
+          *
+          * @param source     Receiver whose data 'pClass' will process.
+          * @param pClass     Processing object (usually a
+          *                   'ProcessingList').
+          */
+      virtual ParallelStationProcessor& addStation( const SourceID& source,
+                                                    ProcessingClass& pClass )
+      { stations[source] = &pClass; return (*this); };
+
+
+         /// Removes the processing object of a given receiver.
+      virtual ParallelStationProcessor& removeStation(const SourceID& source)
+      { stations.erase(source); return (*this); };
+
+
+         /// Returns the number of threads used.
+      virtual unsigned int getNumThreads(void) const
+      { return pool.size(); };
+
+
+         /** Processes the data of one epoch, one 'gnssRinex' per receiver,
+          *  and adds the results to a 'gnssDataMap'.
+          *
+          * @param gRinList   Data of the receivers; processed in place.
+          * @param gdsMap     Map where the results are added.
+          */
+      virtual gnssDataMap& Process( std::list<gnssRinex>& gRinList,
+                                    gnssDataMap& gdsMap );
+
+
+         /** Reads the next epoch of a network, processes it, and puts the
+          *  results in 'gdsMap' (after clearing it).
+          *
+          * @param network    Network data streams.
+          * @param gdsMap     Object to hold the processed data.
+          *
+          * @return  Is there more epoch data for the network
+          */
+      virtual bool readEpochData( NetworkObsStreams& network,
+                                  gnssDataMap& gdsMap )
+         throw(SynchronizeException);
+
+
+         /// Returns the receivers left out at the last epoch processed,
+         /// with the reason.
+      virtual const std::map<SourceID, std::string>& getRejected(void) const
+      { return rejected; };
+
+
+         /// Destructor
+      virtual ~ParallelStationProcessor() {};
+
+
+   private:
+
+
+         /// Processing object of each receiver
+      std::map<SourceID, ProcessingClass*> stations;
+
+
+         /// Threads that run the chains
+      ThreadPool pool;
+
+
+         /// Receivers left out at the last epoch, and why
+      std::map<SourceID, std::string> rejected;
+
+
+   }; // End of class 'ParallelStationProcessor'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_PARALLEL_STATION_PROCESSOR_HPP
@@ -0,0 +1,86 @@
+#pragma ident "$Id$"
+
+/**
+ * @file ProcessingClass.cpp
+ * This is an abstract base class for objects processing GNSS Data
+ * Structures (GDS).
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#include "ProcessingClass.hpp"
+
+
+namespace gpstk
+{
+
+#ifndef _WIN32
+   namespace
+   {
+         // Guards the 'classIndex' counters of all the children
+      pthread_mutex_t indexMutex = PTHREAD_MUTEX_INITIALIZER;
+   }
+#endif
+
+
+      // Returns the value of 'counter' and increments it.
+   int ProcessingClass::nextIndex(int& counter)
+   {
+
+#ifndef _WIN32
+      pthread_mutex_lock(&indexMutex);
+      int index( counter++ );
+      pthread_mutex_unlock(&indexMutex);
+
+      return index;
+#else
+      return counter++;
+#endif
+
+   }  // End of method 'ProcessingClass::nextIndex()'
+
+
+
+      /* Processing method for the dense 'gnssRinexTable' structure.
+       *
+       * @param gData    Data object holding the data.
+       */
+   gnssRinexTable& ProcessingClass::Process(gnssRinexTable& gData)
+   {
+
+      gnssRinex gRin;
+      gData.getGnssRinex(gRin);
+
+      Process(gRin);
+
+      gData.assign(gRin);
+
+      return gData;
+
+   }  // End of method 'ProcessingClass::Process()'
+
+
+}  // End of namespace gpstk
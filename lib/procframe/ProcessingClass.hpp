@@ -34,6 +34,7 @@
 
 #include "StringUtils.hpp"
 #include "DataStructures.hpp"
+#include "SatTypeValueTable.hpp"
 
 
 namespace gpstk
@@ -97,6 +98,19 @@ namespace gpstk
       virtual gnssRinex& Process(gnssRinex& gData) = 0;
 
 
+         /** Processing method for the dense 'gnssRinexTable' structure.
+          *
+          * Children that don't handle 'gnssRinexTable' objects get this
+          * version, which converts the data to a 'gnssRinex', calls
+          * Process(gnssRinex&) and stores the result back in 'gData'.
+          * Children override it as they are ported to the dense
+          * structures.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData);
+
+
          /// Abstract method. It returns an unique index identifying the object.
       virtual int getIndex(void) const = 0;
 
@@ -134,6 +148,17 @@ namespace gpstk
       virtual ~ProcessingClass() {};
 
 
+   protected:
+
+
+         /** Returns the value of 'counter' and increments it. Children use
+          *  it to assign the indexes of their objects from their static
+          *  'classIndex', so objects may be created from several threads
+          *  at once.
+          */
+      static int nextIndex(int& counter);
+
+
 
    }; // End of class 'ProcessingClass'
 
@@ -150,6 +175,12 @@ namespace gpstk
    { procClass.Process(gData); return gData; }
 
 
+      /// Input operator from gnssRinexTable to ProcessingClass.
+   inline gnssRinexTable& operator>>( gnssRinexTable& gData,
+                                      ProcessingClass& procClass )
+   { procClass.Process(gData); return gData; }
+
+
    //@}
 
 }  // End of namespace gpstk
@@ -113,4 +113,37 @@ namespace gpstk
 
 
 
+
+      /* Processing method. It returns a gnnsRinexTable object.
+       *
+       * @param gData    Data object holding the data.
+       */
+   gnssRinexTable& ProcessingList::Process(gnssRinexTable& gData)
+   {
+
+      try
+      {
+
+         std::list<ProcessingClass*>::const_iterator pos;
+         for (pos = proclist.begin(); pos != proclist.end(); ++pos)
+         {
+            (*pos)->Process(gData);
+         }
+
+         return gData;
+
+      }
+      catch(...)
+      {
+
+            // This method must throw the same exceptions it may get from
+            // the 'ProcessingList' elements, without altering them.
+         throw;
+
+      }
+
+   }  // End of method 'ProcessingList::Process()'
+
+
+
 }  // End of namespace gpstk
@@ -102,6 +102,13 @@ namespace gpstk
       virtual gnssRinex& Process(gnssRinex& gData);
 
 
+         /** Processing method. It returns a gnnsRinexTable object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData);
+
+
          /// Returns a pointer to the first element.
       virtual ProcessingClass* front(void)
       { return (proclist.front()); };
@@ -179,7 +186,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { index = classIndex++; };
+      { index = nextIndex(classIndex); };
 
 
    }; // End of class 'ProcessingList'
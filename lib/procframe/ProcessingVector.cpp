@@ -114,4 +114,37 @@ namespace gpstk
 
 
 
+
+      /* Processing method. It returns a gnnsRinexTable object.
+       *
+       * @param gData    Data object holding the data.
+       */
+   gnssRinexTable& ProcessingVector::Process(gnssRinexTable& gData)
+   {
+
+      try
+      {
+
+         std::vector<ProcessingClass*>::const_iterator pos;
+         for (pos = procvector.begin(); pos != procvector.end(); ++pos)
+         {
+            (*pos)->Process(gData);
+         }
+
+         return gData;
+
+      }
+      catch(...)
+      {
+
+            // This method must throw the same exceptions it may get from
+            // the 'ProcessingVector' elements, without altering them.
+         throw;
+
+      }
+
+   }  // End of method 'ProcessingVector::Process()'
+
+
+
 }  // End of namespace gpstk
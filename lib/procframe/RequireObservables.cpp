@@ -65,11 +65,13 @@ namespace gpstk
 
 
 
-      // Returns a satTypeValueMap object, filtering the target observables.
+      // Removes the satellites lacking any of the required observables.
+      // It works both for satTypeValueMap and satTypeValueTable objects.
       //
       // @param gData     Data object holding the data.
       //
-   satTypeValueMap& RequireObservables::Process(satTypeValueMap& gData)
+   template<class STVMap>
+   STVMap& RequireObservables::processData(STVMap& gData)
       throw(ProcessingException)
    {
 
@@ -79,7 +81,7 @@ namespace gpstk
          SatIDSet satRejectedSet;
 
             // Loop through all the satellites
-         for ( satTypeValueMap::iterator satIt = gData.begin();
+         for ( typename STVMap::iterator satIt = gData.begin();
                satIt != gData.end();
                ++satIt )
          {
@@ -92,11 +94,8 @@ namespace gpstk
             {
 
 
-                  // Try to find required type
-               typeValueMap::iterator it( (*satIt).second.find(*typeIt) );
-
                   // Now, check if this TypeID exists in this data structure
-               if ( it == (*satIt).second.end() )
+               if ( (*satIt).second.find(*typeIt) == (*satIt).second.end() )
                {
                      // If we couldn't find type, then schedule this
                      // satellite for removal
@@ -128,7 +127,27 @@ namespace gpstk
 
       }
 
-   }  // End of 'RequireObservables::Process()'
+   }  // End of 'RequireObservables::processData()'
+
+
+
+      // Returns a satTypeValueMap object, filtering the target observables.
+      //
+      // @param gData     Data object holding the data.
+      //
+   satTypeValueMap& RequireObservables::Process(satTypeValueMap& gData)
+      throw(ProcessingException)
+   { return processData(gData); }
+
+
+
+      // Returns a satTypeValueTable object, filtering the target observables.
+      //
+      // @param gData     Data object holding the data.
+      //
+   satTypeValueTable& RequireObservables::Process(satTypeValueTable& gData)
+      throw(ProcessingException)
+   { return processData(gData); }
 
 
 } // End of namespace gpstk
@@ -112,6 +112,15 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a satTypeValueTable object, checking the required
+          *  observables.
+          *
+          * @param gData     Data object holding the data.
+          */
+      virtual satTypeValueTable& Process(satTypeValueTable& gData)
+         throw(ProcessingException);
+
+
          /** Method to add a TypeID to be required.
           *
           * @param type      Extra TypeID to be required.
@@ -170,6 +179,16 @@ namespace gpstk
       { Process(gData.body); return gData; };
 
 
+         /** Returns a gnssRinexTable object, checking the required
+          *  observables.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException)
+      { Process(gData.body); return gData; };
+
+
          /// Returns an index identifying this object.
       virtual int getIndex(void) const;
 
@@ -189,6 +208,12 @@ namespace gpstk
       TypeIDSet requiredTypeSet;
 
 
+         /// Does the work of both Process() methods above.
+      template<class STVMap>
+      STVMap& processData(STVMap& gData)
+         throw(ProcessingException);
+
+
          /// Initial index assigned to this class.
       static int classIndex;
 
@@ -199,7 +224,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { index = classIndex++; };
+      { index = nextIndex(classIndex); };
 
    }; // End of class 'RequireObservables'
 
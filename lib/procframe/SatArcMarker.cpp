@@ -99,14 +99,15 @@ namespace gpstk
 
 
 
-      /* Returns a satTypeValueMap object, adding the new data generated
-       *  when calling this object.
+      /* Marks the satellite arcs of every satellite in 'gData'. It works
+       * both for satTypeValueMap and satTypeValueTable objects.
        *
        * @param epoch     Time of observations.
        * @param gData     Data object holding the data.
        */
-   satTypeValueMap& SatArcMarker::Process( const DayTime& epoch,
-                                           satTypeValueMap& gData )
+   template<class STVMap>
+   STVMap& SatArcMarker::processData( const DayTime& epoch,
+                                      STVMap& gData )
       throw(ProcessingException)
    {
 
@@ -118,7 +119,7 @@ namespace gpstk
          SatIDSet satRejectedSet;
 
             // Loop through all the satellites
-         for ( satTypeValueMap::iterator it = gData.begin();
+         for ( typename STVMap::iterator it = gData.begin();
                it != gData.end();
                ++it )
          {
@@ -213,7 +214,33 @@ namespace gpstk
 
       }
 
-   }  // End of method 'SatArcMarker::Process()'
+   }  // End of method 'SatArcMarker::processData()'
+
+
+
+      /* Returns a satTypeValueMap object, adding the new data generated
+       *  when calling this object.
+       *
+       * @param epoch     Time of observations.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueMap& SatArcMarker::Process( const DayTime& epoch,
+                                           satTypeValueMap& gData )
+      throw(ProcessingException)
+   { return processData(epoch, gData); }
+
+
+
+      /* Returns a satTypeValueTable object, adding the new data generated
+       *  when calling this object.
+       *
+       * @param epoch     Time of observations.
+       * @param gData     Data object holding the data.
+       */
+   satTypeValueTable& SatArcMarker::Process( const DayTime& epoch,
+                                             satTypeValueTable& gData )
+      throw(ProcessingException)
+   { return processData(epoch, gData); }
 
 
 
@@ -281,4 +308,36 @@ namespace gpstk
 
 
 
+      /* Returns a gnssRinexTable object, adding the new data generated when
+       *  calling this object.
+       *
+       * @param gData    Data object holding the data.
+       */
+   gnssRinexTable& SatArcMarker::Process(gnssRinexTable& gData)
+      throw(ProcessingException)
+   {
+
+      try
+      {
+
+         Process(gData.header.epoch, gData.body);
+
+         return gData;
+
+      }
+      catch(Exception& u)
+      {
+            // Throw an exception if something unexpected happens
+         ProcessingException e( getClassName() + ":"
+                                + StringUtils::asString( getIndex() ) + ":"
+                                + u.what() );
+
+         GPSTK_THROW(e);
+
+      }
+
+   }  // End of method 'SatArcMarker::Process()'
+
+
+
 }  // End of namespace gpstk
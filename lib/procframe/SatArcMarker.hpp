@@ -171,6 +171,17 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a satTypeValueTable object, adding the new data
+          *  generated when calling this object.
+          *
+          * @param epoch     Time of observations.
+          * @param gData     Data object holding the data.
+          */
+      virtual satTypeValueTable& Process( const DayTime& epoch,
+                                          satTypeValueTable& gData )
+         throw(ProcessingException);
+
+
          /** Returns a gnnsSatTypeValue object, adding the new data generated
           *  when calling this object.
           *
@@ -189,6 +200,15 @@ namespace gpstk
          throw(ProcessingException);
 
 
+         /** Returns a gnssRinexTable object, adding the new data generated
+          *  when calling this object.
+          *
+          * @param gData    Data object holding the data.
+          */
+      virtual gnssRinexTable& Process(gnssRinexTable& gData)
+         throw(ProcessingException);
+
+
          /// Returns an index identifying this object.
       virtual int getIndex(void) const;
 
@@ -229,6 +249,12 @@ namespace gpstk
       std::map<SatID, bool> satIsNewMap;
 
 
+         /// Does the work of both Process() methods above.
+      template<class STVMap>
+      STVMap& processData( const DayTime& epoch, STVMap& gData )
+         throw(ProcessingException);
+
+
          /// Initial index assigned to this class.
       static int classIndex;
 
@@ -239,7 +265,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { index = classIndex++; };
+      { index = nextIndex(classIndex); };
 
 
    }; // End of class 'SatArcMarker'
@@ -0,0 +1,1089 @@
+#pragma ident "$Id$"
+
+/**
+ * @file SatTypeValueTable.cpp
+ * Dense, table-based counterparts of 'satTypeValueMap' and 'gnssRinex'.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <algorithm>
+
+#include "SatTypeValueTable.hpp"
+
+
+namespace gpstk
+{
+
+   using namespace std;
+
+
+      ////// typeValueRow //////
+
+
+   std::pair<TypeID, double>
+   typeValueRow::const_iterator::operator*() const
+   {
+
+      size_t slot( table->order[pos] );
+
+      return std::make_pair( table->types[slot], table->columns[slot][row] );
+
+   }  // End of method 'typeValueRow::const_iterator::operator*()'
+
+
+   typeValueRow::const_iterator& typeValueRow::const_iterator::operator++()
+   {
+
+      ++pos;
+      skipAbsent();
+
+      return (*this);
+
+   }  // End of method 'typeValueRow::const_iterator::operator++()'
+
+
+
+      // Returns the number of different types available.
+   size_t typeValueRow::numTypes() const
+   {
+
+      size_t n(0);
+
+      for(size_t s = 0; s < table->types.size(); s++)
+      {
+         if( table->flags[s][row] ) ++n;
+      }
+
+      return n;
+
+   }  // End of method 'typeValueRow::numTypes()'
+
+
+      // Returns a TypeIDSet with all the data types present in this object.
+   TypeIDSet typeValueRow::getTypeID() const
+   {
+
+      TypeIDSet typeSet;
+
+      for(const_iterator it = begin(); it != end(); ++it)
+      {
+         typeSet.insert( (*it).first );
+      }
+
+      return typeSet;
+
+   }  // End of method 'typeValueRow::getTypeID()'
+
+
+   typeValueRow::const_iterator typeValueRow::begin() const
+   { return const_iterator(table, row, 0); }
+
+
+      // Returns the data value (double) corresponding to provided type.
+   double typeValueRow::getValue(const TypeID& type) const
+      throw(TypeIDNotFound)
+   {
+
+      size_t slot( table->getSlot(type) );
+
+      if( slot == satTypeValueTable::noSlot ||
+          !table->hasValue(row, slot) )
+      {
+         GPSTK_THROW(TypeIDNotFound("TypeID not found in map"));
+      }
+
+      return table->columns[slot][row];
+
+   }  // End of method 'typeValueRow::getValue()'
+
+
+      // Returns a reference to the data value (double) with
+      // corresponding type.
+   double& typeValueRow::operator()(const TypeID& type)
+      throw(TypeIDNotFound)
+   {
+
+      size_t slot( table->getSlot(type) );
+
+      if( slot == satTypeValueTable::noSlot ||
+          !table->hasValue(row, slot) )
+      {
+         GPSTK_THROW(TypeIDNotFound("TypeID not found in map"));
+      }
+
+      return table->columns[slot][row];
+
+   }  // End of method 'typeValueRow::operator()'
+
+
+      // Modifies this object, removing this type of data.
+   typeValueRow& typeValueRow::removeTypeID(const TypeID& type)
+   {
+
+      size_t slot( table->getSlot(type) );
+
+      if( slot != satTypeValueTable::noSlot )
+      {
+         table->flags[slot][row] = 0;
+      }
+
+      return (*this);
+
+   }  // End of method 'typeValueRow::removeTypeID()'
+
+
+      // Returns a typeValueMap holding the values of this row.
+   typeValueMap typeValueRow::getTypeValueMap() const
+   {
+
+      typeValueMap tvMap;
+
+      for(const_iterator it = begin(); it != end(); ++it)
+      {
+         tvMap[ (*it).first ] = (*it).second;
+      }
+
+      return tvMap;
+
+   }  // End of method 'typeValueRow::getTypeValueMap()'
+
+
+
+      ////// satTypeValueTable //////
+
+
+   const size_t satTypeValueTable::noSlot = static_cast<size_t>(-1);
+
+
+
+      // Copy constructor.
+   satTypeValueTable::satTypeValueTable(const satTypeValueTable& right)
+      : sats(right.sats), entries(right.entries), types(right.types),
+        slotOf(right.slotOf), order(right.order), rank(right.rank),
+        columns(right.columns), flags(right.flags)
+   {
+      renumberEntries(0);
+   }
+
+
+      // Assignment operator.
+   satTypeValueTable&
+   satTypeValueTable::operator=(const satTypeValueTable& right)
+   {
+
+      if( this == &right ) return (*this);
+
+      sats = right.sats;
+      entries = right.entries;
+      types = right.types;
+      slotOf = right.slotOf;
+      order = right.order;
+      rank = right.rank;
+      columns = right.columns;
+      flags = right.flags;
+
+      renumberEntries(0);
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::operator=()'
+
+
+
+      // Returns the slot of 'type', creating it if needed.
+   size_t satTypeValueTable::insertSlot(const TypeID& type)
+   {
+
+      size_t slot( getSlot(type) );
+      if( slot != noSlot ) return slot;
+
+      size_t t( static_cast<size_t>(type.type) );
+      if( t >= slotOf.size() )
+      {
+         slotOf.resize( std::max( t + 1, 2*slotOf.size() ), noSlot );
+      }
+
+      slot = types.size();
+      slotOf[t] = slot;
+      types.push_back(type);
+
+         // Keep 'order' sorted by type
+      std::vector<size_t>::iterator pos( order.begin() );
+      while( pos != order.end() && types[*pos] < type ) ++pos;
+      order.insert(pos, slot);
+
+      rank.resize( order.size() );
+      for(size_t k = 0; k < order.size(); k++)
+      {
+         rank[ order[k] ] = k;
+      }
+
+         // New columns go at the end, leaving the others in place
+      columns.push_back( std::vector<double>( sats.size(), 0.0 ) );
+      flags.push_back( std::vector<unsigned char>( sats.size(), 0 ) );
+
+      return slot;
+
+   }  // End of method 'satTypeValueTable::insertSlot()'
+
+
+      // Returns the row of 'satellite', or the number of satellites.
+   size_t satTypeValueTable::getRow(const SatID& satellite) const
+   {
+
+      std::vector<SatID>::const_iterator pos(
+                     std::lower_bound(sats.begin(), sats.end(), satellite) );
+
+      if( pos != sats.end() && *pos == satellite )
+      {
+         return (pos - sats.begin());
+      }
+
+      return sats.size();
+
+   }  // End of method 'satTypeValueTable::getRow()'
+
+
+      // Returns the row of 'satellite', inserting an empty one if needed.
+   size_t satTypeValueTable::insertRow(const SatID& satellite)
+   {
+
+         // Satellites usually come in order, so try the end first
+      if( sats.empty() || sats.back() < satellite )
+      {
+         sats.push_back(satellite);
+         entries.push_back(value_type());
+         renumberEntries(sats.size() - 1);
+         for(size_t s = 0; s < columns.size(); s++)
+         {
+            columns[s].push_back(0.0);
+            flags[s].push_back(0);
+         }
+
+         return (sats.size() - 1);
+      }
+
+      std::vector<SatID>::iterator pos(
+                     std::lower_bound(sats.begin(), sats.end(), satellite) );
+
+      size_t r( pos - sats.begin() );
+
+      if( *pos == satellite ) return r;
+
+      sats.insert(pos, satellite);
+      entries.insert(entries.begin() + r, value_type());
+      renumberEntries(r);
+      for(size_t s = 0; s < columns.size(); s++)
+      {
+         columns[s].insert(columns[s].begin() + r, 0.0);
+         flags[s].insert(flags[s].begin() + r, 0);
+      }
+
+      return r;
+
+   }  // End of method 'satTypeValueTable::insertRow()'
+
+
+      // Removes row 'r'.
+   void satTypeValueTable::eraseRow(size_t r)
+   {
+
+      sats.erase(sats.begin() + r);
+      entries.erase(entries.begin() + r);
+      renumberEntries(r);
+      for(size_t s = 0; s < columns.size(); s++)
+      {
+         columns[s].erase(columns[s].begin() + r);
+         flags[s].erase(flags[s].begin() + r);
+      }
+
+   }  // End of method 'satTypeValueTable::eraseRow()'
+
+
+      // Points the handles in 'entries' from row 'r' on at their rows.
+   void satTypeValueTable::renumberEntries(size_t r)
+   {
+
+      for( ; r < entries.size(); r++)
+      {
+         entries[r].first = sats[r];
+         entries[r].second = typeValueRow(this, r);
+      }
+
+   }  // End of method 'satTypeValueTable::renumberEntries()'
+
+
+
+      // Removes all the satellites. Types and memory are kept.
+   void satTypeValueTable::clear()
+   {
+
+      sats.clear();
+      entries.clear();
+
+      for(size_t s = 0; s < columns.size(); s++)
+      {
+         columns[s].clear();
+         flags[s].clear();
+      }
+
+   }  // End of method 'satTypeValueTable::clear()'
+
+
+      // Replaces the contents of this object with the data in 'stvMap'.
+   satTypeValueTable& satTypeValueTable::assign(const satTypeValueMap& stvMap)
+   {
+
+      clear();
+
+      for( satTypeValueMap::const_iterator it = stvMap.begin();
+           it != stvMap.end();
+           ++it )
+      {
+
+         size_t r( insertRow( (*it).first ) );
+
+         for( typeValueMap::const_iterator itObs = (*it).second.begin();
+              itObs != (*it).second.end();
+              ++itObs )
+         {
+            size_t slot( insertSlot( (*itObs).first ) );
+            columns[slot][r] = (*itObs).second;
+            flags[slot][r] = 1;
+         }
+
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::assign()'
+
+
+      // Returns a satTypeValueMap holding the same data as this object.
+   satTypeValueMap satTypeValueTable::getSatTypeValueMap() const
+   {
+
+      satTypeValueMap stvMap;
+      getSatTypeValueMap(stvMap);
+
+      return stvMap;
+
+   }  // End of method 'satTypeValueTable::getSatTypeValueMap()'
+
+
+      // Stores in 'stvMap' the same data as this object.
+   void satTypeValueTable::getSatTypeValueMap(satTypeValueMap& stvMap) const
+   {
+
+      stvMap.clear();
+
+      for(size_t r = 0; r < sats.size(); r++)
+      {
+
+            // Rows are sorted, so hint the insertion at the end
+         satTypeValueMap::iterator itSat(
+            stvMap.insert( stvMap.end(),
+                           std::make_pair( sats[r], typeValueMap() ) ) );
+
+         typeValueMap& tvMap( (*itSat).second );
+
+         for(size_t k = 0; k < order.size(); k++)
+         {
+            size_t slot( order[k] );
+
+            if( hasValue(r, slot) )
+            {
+               tvMap.insert( tvMap.end(),
+                             std::make_pair( types[slot],
+                                             columns[slot][r] ) );
+            }
+         }
+
+      }
+
+   }  // End of method 'satTypeValueTable::getSatTypeValueMap()'
+
+
+      // Returns the total number of data elements in the table.
+   size_t satTypeValueTable::numElements() const
+   {
+
+      size_t n(0);
+
+      for(size_t s = 0; s < flags.size(); s++)
+      {
+         for(size_t r = 0; r < sats.size(); r++)
+         {
+            if( flags[s][r] ) ++n;
+         }
+      }
+
+      return n;
+
+   }  // End of method 'satTypeValueTable::numElements()'
+
+
+      // Returns an iterator to 'satellite', or end().
+   satTypeValueTable::iterator satTypeValueTable::find(const SatID& satellite)
+   { return iterator( this, getRow(satellite) ); }
+
+
+      // Returns an iterator to 'satellite', or end().
+   satTypeValueTable::const_iterator
+   satTypeValueTable::find(const SatID& satellite) const
+   { return const_iterator( this, getRow(satellite) ); }
+
+
+      // Returns 1 if 'satellite' is present, 0 otherwise.
+   size_t satTypeValueTable::count(const SatID& satellite) const
+   { return ( (getRow(satellite) < sats.size()) ? 1 : 0 ); }
+
+
+      // Returns the data of 'satellite', inserting an empty row if needed.
+   typeValueRow satTypeValueTable::operator[](const SatID& satellite)
+   { return typeValueRow( this, insertRow(satellite) ); }
+
+
+      // Removes the satellite at 'pos', returning an iterator to the next.
+   satTypeValueTable::iterator satTypeValueTable::erase(iterator pos)
+   {
+
+      eraseRow(pos.row);
+
+      return iterator(this, pos.row);
+
+   }  // End of method 'satTypeValueTable::erase()'
+
+
+      // Returns a SatIDSet with all the satellites present in this object.
+   SatIDSet satTypeValueTable::getSatID() const
+   {
+      return SatIDSet( sats.begin(), sats.end() );
+   }
+
+
+      // Returns a Vector with all the satellites present in this object.
+   Vector<SatID> satTypeValueTable::getVectorOfSatID() const
+   {
+
+      Vector<SatID> satVector( sats.size() );
+
+      for(size_t r = 0; r < sats.size(); r++)
+      {
+         satVector[r] = sats[r];
+      }
+
+      return satVector;
+
+   }  // End of method 'satTypeValueTable::getVectorOfSatID()'
+
+
+      // Returns a TypeIDSet with all the data types present in this object.
+   TypeIDSet satTypeValueTable::getTypeID() const
+   {
+
+      TypeIDSet typeSet;
+
+      for(size_t slot = 0; slot < types.size(); slot++)
+      {
+         for(size_t r = 0; r < sats.size(); r++)
+         {
+            if( hasValue(r, slot) )
+            {
+               typeSet.insert( types[slot] );
+               break;
+            }
+         }
+      }
+
+      return typeSet;
+
+   }  // End of method 'satTypeValueTable::getTypeID()'
+
+
+      // Returns a satTypeValueTable with only this satellite.
+   satTypeValueTable satTypeValueTable::extractSatID(
+                                          const SatID& satellite ) const
+   {
+
+      satTypeValueTable stvTable(*this);
+      stvTable.keepOnlySatID(satellite);
+
+      return stvTable;
+
+   }  // End of method 'satTypeValueTable::extractSatID()'
+
+
+      // Returns a satTypeValueTable with only these satellites.
+   satTypeValueTable satTypeValueTable::extractSatID(
+                                          const SatIDSet& satSet ) const
+   {
+
+      satTypeValueTable stvTable(*this);
+      stvTable.keepOnlySatID(satSet);
+
+      return stvTable;
+
+   }  // End of method 'satTypeValueTable::extractSatID()'
+
+
+      // Modifies this object, keeping only this satellite.
+   satTypeValueTable& satTypeValueTable::keepOnlySatID(
+                                                const SatID& satellite )
+   {
+
+      SatIDSet satSet;
+      satSet.insert(satellite);
+
+      return keepOnlySatID(satSet);
+
+   }  // End of method 'satTypeValueTable::keepOnlySatID()'
+
+
+      // Modifies this object, keeping only these satellites.
+   satTypeValueTable& satTypeValueTable::keepOnlySatID(const SatIDSet& satSet)
+   {
+
+      size_t r(sats.size());
+      while( r > 0 )
+      {
+         --r;
+         if( satSet.find( sats[r] ) == satSet.end() )
+         {
+            eraseRow(r);
+         }
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::keepOnlySatID()'
+
+
+      // Returns a satTypeValueTable with only this type of value.
+   satTypeValueTable satTypeValueTable::extractTypeID(
+                                                const TypeID& type ) const
+   {
+
+      satTypeValueTable stvTable(*this);
+      stvTable.keepOnlyTypeID(type);
+
+      return stvTable;
+
+   }  // End of method 'satTypeValueTable::extractTypeID()'
+
+
+      // Returns a satTypeValueTable with only these types of data.
+   satTypeValueTable satTypeValueTable::extractTypeID(
+                                          const TypeIDSet& typeSet ) const
+   {
+
+      satTypeValueTable stvTable(*this);
+      stvTable.keepOnlyTypeID(typeSet);
+
+      return stvTable;
+
+   }  // End of method 'satTypeValueTable::extractTypeID()'
+
+
+      // Modifies this object, keeping only this type of data.
+   satTypeValueTable& satTypeValueTable::keepOnlyTypeID(const TypeID& type)
+   {
+
+      TypeIDSet typeSet;
+      typeSet.insert(type);
+
+      return keepOnlyTypeID(typeSet);
+
+   }  // End of method 'satTypeValueTable::keepOnlyTypeID()'
+
+
+      // Modifies this object, keeping only these types of data.
+   satTypeValueTable& satTypeValueTable::keepOnlyTypeID(
+                                                const TypeIDSet& typeSet )
+   {
+
+      for(size_t slot = 0; slot < types.size(); slot++)
+      {
+         if( typeSet.find( types[slot] ) == typeSet.end() )
+         {
+            removeTypeID( types[slot] );
+         }
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::keepOnlyTypeID()'
+
+
+      // Modifies this object, removing this satellite.
+   satTypeValueTable& satTypeValueTable::removeSatID(const SatID& satellite)
+   {
+
+      size_t r( getRow(satellite) );
+      if( r < sats.size() ) eraseRow(r);
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::removeSatID()'
+
+
+      // Modifies this object, removing these satellites.
+   satTypeValueTable& satTypeValueTable::removeSatID(const SatIDSet& satSet)
+   {
+
+      if( satSet.empty() ) return (*this);
+
+      size_t r(sats.size());
+      while( r > 0 )
+      {
+         --r;
+         if( satSet.find( sats[r] ) != satSet.end() )
+         {
+            eraseRow(r);
+         }
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::removeSatID()'
+
+
+      // Modifies this object, removing this type of data.
+   satTypeValueTable& satTypeValueTable::removeTypeID(const TypeID& type)
+   {
+
+      size_t slot( getSlot(type) );
+
+      if( slot != noSlot )
+      {
+         std::fill( flags[slot].begin(), flags[slot].end(), 0 );
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::removeTypeID()'
+
+
+      // Modifies this object, removing these types of data.
+   satTypeValueTable& satTypeValueTable::removeTypeID(
+                                                const TypeIDSet& typeSet )
+   {
+
+      for( TypeIDSet::const_iterator pos = typeSet.begin();
+           pos != typeSet.end();
+           ++pos )
+      {
+         removeTypeID(*pos);
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::removeTypeID()'
+
+
+      // Returns a GPSTk::Vector containing the data values with this type.
+   Vector<double> satTypeValueTable::getVectorOfTypeID(
+                                                const TypeID& type ) const
+   {
+
+      Vector<double> result( sats.size(), 0.0 );
+
+      size_t slot( getSlot(type) );
+
+      if( slot != noSlot )
+      {
+         for(size_t r = 0; r < sats.size(); r++)
+         {
+            if( hasValue(r, slot) )
+            {
+               result[r] = columns[slot][r];
+            }
+         }
+      }
+
+      return result;
+
+   }  // End of method 'satTypeValueTable::getVectorOfTypeID()'
+
+
+      // Returns a GPSTk::Matrix containing the data values in this set.
+   Matrix<double> satTypeValueTable::getMatrixOfTypes(
+                                          const TypeIDSet& typeSet ) const
+   {
+
+      Matrix<double> tempMat( sats.size(), typeSet.size(), 0.0 );
+
+      size_t col(0);
+      for( TypeIDSet::const_iterator pos = typeSet.begin();
+           pos != typeSet.end();
+           ++pos, ++col )
+      {
+
+         size_t slot( getSlot(*pos) );
+         if( slot == noSlot ) continue;
+
+         for(size_t r = 0; r < sats.size(); r++)
+         {
+            if( hasValue(r, slot) )
+            {
+               tempMat(r, col) = columns[slot][r];
+            }
+         }
+
+      }
+
+      return tempMat;
+
+   }  // End of method 'satTypeValueTable::getMatrixOfTypes()'
+
+
+      // Modifies this object, adding one vector of data with this type,
+      // one value per satellite.
+   satTypeValueTable& satTypeValueTable::insertTypeIDVector(
+                                          const TypeID& type,
+                                          const Vector<double> dataVector )
+      throw(NumberOfSatsMismatch)
+   {
+
+      if( dataVector.size() != sats.size() )
+      {
+         GPSTK_THROW(NumberOfSatsMismatch(" Number of data values in vector \
+and number of satellites do not match"));
+      }
+
+      size_t slot( insertSlot(type) );
+
+      for(size_t r = 0; r < sats.size(); r++)
+      {
+         columns[slot][r] = dataVector[r];
+         flags[slot][r] = 1;
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::insertTypeIDVector()'
+
+
+      // Modifies this object, adding a matrix of data, one vector
+      // per satellite.
+   satTypeValueTable& satTypeValueTable::insertMatrix(
+                                          const TypeIDSet& typeSet,
+                                          const Matrix<double> dataMatrix )
+      throw(NumberOfSatsMismatch, NumberOfTypesMismatch)
+   {
+
+      if( dataMatrix.rows() != sats.size() )
+      {
+         GPSTK_THROW(NumberOfSatsMismatch("Number of rows in matrix and \
+number of satellites do not match"));
+      }
+
+      if( dataMatrix.cols() != typeSet.size() )
+      {
+         GPSTK_THROW(NumberOfTypesMismatch("Number of columns in matrix and \
+number of types do not match"));
+      }
+
+      size_t col(0);
+      for( TypeIDSet::const_iterator pos = typeSet.begin();
+           pos != typeSet.end();
+           ++pos, ++col )
+      {
+
+         size_t slot( insertSlot(*pos) );
+
+         for(size_t r = 0; r < sats.size(); r++)
+         {
+            columns[slot][r] = dataMatrix(r, col);
+            flags[slot][r] = 1;
+         }
+
+      }
+
+      return (*this);
+
+   }  // End of method 'satTypeValueTable::insertMatrix()'
+
+
+      // Returns the data value (double) corresponding to provided SatID
+      // and TypeID.
+   double satTypeValueTable::getValue( const SatID& satellite,
+                                       const TypeID& type ) const
+      throw( SatIDNotFound, TypeIDNotFound )
+   {
+
+      size_t r( getRow(satellite) );
+
+      if( r == sats.size() )
+      {
+         GPSTK_THROW(SatIDNotFound("SatID not found in map"));
+      }
+
+      return typeValueRow( const_cast<satTypeValueTable*>(this), r )
+                                                            .getValue(type);
+
+   }  // End of method 'satTypeValueTable::getValue()'
+
+
+      // Returns the data of the satellite with corresponding SatID.
+   typeValueRow satTypeValueTable::operator()(const SatID& satellite)
+      throw(SatIDNotFound)
+   {
+
+      size_t r( getRow(satellite) );
+
+      if( r == sats.size() )
+      {
+         GPSTK_THROW(SatIDNotFound("SatID not found in map"));
+      }
+
+      return typeValueRow(this, r);
+
+   }  // End of method 'satTypeValueTable::operator()'
+
+
+      // Convenience output method
+   std::ostream& satTypeValueTable::dump( std::ostream& s,
+                                          int mode ) const
+   {
+
+      for(const_iterator it = begin(); it != end(); ++it)
+      {
+
+            // First, print satellite (system and PRN)
+         s << (*it).first << " ";
+
+         for( typeValueRow::const_iterator itObs = (*it).second.begin();
+              itObs != (*it).second.end();
+              ++itObs )
+         {
+
+            if (mode==1)
+            {
+               s << (*itObs).first << " ";
+            }
+
+            s << (*itObs).second << " ";
+
+         }
+
+         s << endl;
+
+      }
+
+      return s;
+
+   }  // End of method 'satTypeValueTable::dump()'
+
+
+      // stream output for satTypeValueTable
+   std::ostream& operator<<( std::ostream& s,
+                             const satTypeValueTable& stvTable )
+   {
+
+      stvTable.dump(s);
+      return s;
+
+   }  // End of 'operator<<'
+
+
+
+      ////// gnssRinexTable //////
+
+
+      // Replaces the contents of this object with the data in 'gRin'.
+   gnssRinexTable& gnssRinexTable::assign(const gnssRinex& gRin)
+   {
+
+      header = gRin.header;
+      body.assign(gRin.body);
+
+      return (*this);
+
+   }  // End of method 'gnssRinexTable::assign()'
+
+
+      // Stores in 'gRin' the same data as this object.
+   void gnssRinexTable::getGnssRinex(gnssRinex& gRin) const
+   {
+
+      gRin.header = header;
+      body.getSatTypeValueMap(gRin.body);
+
+   }  // End of method 'gnssRinexTable::getGnssRinex()'
+
+
+
+      // Input for gnssRinexTable from RinexObsHeader
+   gnssRinexTable& operator>>( const RinexObsHeader& roh,
+                               gnssRinexTable& f )
+   {
+
+         // First, select the right system the data came from
+      f.header.source.type = SatIDsystem2SourceIDtype(roh.system);
+
+         // Set the proper name for the receiver
+      f.header.source.sourceName = roh.markerName;
+
+         // Set the proper antenna type for the receiver
+      f.header.antennaType = roh.antType;
+
+         // Set the proper antenna position
+      f.header.antennaPosition = roh.antennaPosition;
+
+      return f;
+
+   }  // End of 'operator>>'
+
+
+
+      // Input for gnssRinexTable from RinexObsData
+   gnssRinexTable& operator>>( const RinexObsData& rod,
+                               gnssRinexTable& f )
+   {
+
+         // Fill header epoch with the proper value
+      f.header.epoch = rod.time;
+
+         // Fill header epoch with the proper value
+      f.header.epochFlag = rod.epochFlag;
+
+      f.body.clear();
+
+         // Same conversions as FilltypeValueMapwithRinexObsTypeMap()
+      for( RinexObsData::RinexSatMap::const_iterator it = rod.obs.begin();
+           it != rod.obs.end();
+           ++it )
+      {
+
+         typeValueRow row( f.body[ (*it).first ] );
+
+         for( RinexObsData::RinexObsTypeMap::const_iterator itObs =
+                                                      (*it).second.begin();
+              itObs != (*it).second.end();
+              ++itObs )
+         {
+
+            TypeID type( RinexType2TypeID( (*itObs).first ) );
+            double value( (*itObs).second.data );
+
+            TypeID lliType, ssiType;
+            double wavelength(0.0);
+
+            switch( type.type )
+            {
+               case TypeID::L1:
+                  lliType = TypeID::LLI1;
+                  ssiType = TypeID::SSI1;
+                  wavelength = L1_WAVELENGTH;
+                  break;
+               case TypeID::L2:
+                  lliType = TypeID::LLI2;
+                  ssiType = TypeID::SSI2;
+                  wavelength = L2_WAVELENGTH;
+                  break;
+               case TypeID::L5:
+                  lliType = TypeID::LLI5;
+                  ssiType = TypeID::SSI5;
+                  wavelength = L5_WAVELENGTH;
+                  break;
+               case TypeID::L6:
+                  lliType = TypeID::LLI6;
+                  ssiType = TypeID::SSI6;
+                  wavelength = L6_WAVELENGTH;
+                  break;
+               case TypeID::L7:
+                  lliType = TypeID::LLI7;
+                  ssiType = TypeID::SSI7;
+                  wavelength = L7_WAVELENGTH;
+                  break;
+               case TypeID::L8:
+                  lliType = TypeID::LLI8;
+                  ssiType = TypeID::SSI8;
+                  wavelength = L8_WAVELENGTH;
+                  break;
+               default:
+                  break;
+            }
+
+            if( wavelength != 0.0 )
+            {
+                  // Phases are given in meters, along with their
+                  // LLI and SSI indexes
+               row[lliType] = (*itObs).second.lli;
+               row[ssiType] = (*itObs).second.ssi;
+               value = value * wavelength;
+            }
+
+            row[type] = value;
+
+         }
+
+      }  // End of 'for( RinexObsData::RinexSatMap::const_iterator it = ...'
+
+      return f;
+
+   }  // End of 'operator>>'
+
+
+
+      // Stream input for gnssRinexTable
+   std::istream& operator>>( std::istream& i,
+                             gnssRinexTable& f )
+      throw(FFStreamError, gpstk::StringUtils::StringException)
+   {
+
+      RinexObsStream* strm = dynamic_cast<RinexObsStream*>(&i);
+      if( strm == 0 )
+      {
+         FFStreamError e("operator>> stream argument must be a "
+                         "RinexObsStream");
+         GPSTK_THROW(e);
+      }
+
+      try
+      {
+
+            // If the header hasn't been read, read it...
+         if( !strm->headerRead ) (*strm) >> strm->header;
+
+         strm->header >> f;
+
+         RinexObsData rod;
+         if( (*strm) >> rod )
+         {
+            rod >> f;
+         }
+
+      }
+      catch(...)
+      {
+            // As with gnssRinex, errors show up in the stream state
+      }
+
+      return i;
+
+   }  // End of stream input for gnssRinexTable
+
+
+}  // End of namespace gpstk
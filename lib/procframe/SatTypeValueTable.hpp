@@ -0,0 +1,877 @@
+#pragma ident "$Id$"
+
+/**
+ * @file SatTypeValueTable.hpp
+ * Dense, table-based counterparts of 'satTypeValueMap' and 'gnssRinex'.
+ */
+
+#ifndef GPSTK_SATTYPEVALUETABLE_HPP
+#define GPSTK_SATTYPEVALUETABLE_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//============================================================================
+
+
+#include <utility>
+#include <vector>
+#include <deque>
+
+#include "DataStructures.hpp"
+
+
+
+namespace gpstk
+{
+
+      /** @addtogroup DataStructures */
+      //@{
+
+
+   class satTypeValueTable;
+
+
+      /** Data of one satellite inside a 'satTypeValueTable'.
+       *
+       * This is a light handle (a table and a row number) offering the
+       * same interface as 'typeValueMap', so code written for the data
+       * of one satellite works with both. Iteration visits the types
+       * present in increasing TypeID order, and yields
+       * (TypeID, value) pairs; values are modified through operator[]
+       * and operator().
+       *
+       * As with iterators of std::vector, handles and references to
+       * values become invalid when satellites are added to or removed
+       * from the table.
+       */
+   class typeValueRow
+   {
+   public:
+
+         /// Read-only iterator over the (TypeID, value) pairs of a row
+      class const_iterator
+      {
+      public:
+
+         const_iterator()
+            : table(0), row(0), pos(0) {};
+
+         const_iterator( const satTypeValueTable* t,
+                         size_t r,
+                         size_t p );
+
+            /// Holds the pair returned by operator->()
+         class pointer
+         {
+         public:
+            pointer(const std::pair<TypeID, double>& p)
+               : value(p) {};
+
+            const std::pair<TypeID, double>* operator->() const
+            { return &value; };
+
+         private:
+            std::pair<TypeID, double> value;
+         };
+
+            /// The pair is built from the table, so it is returned by
+            /// value: keeping it doesn't depend on the iterator.
+         std::pair<TypeID, double> operator*() const;
+
+         pointer operator->() const
+         { return pointer(operator*()); };
+
+         const_iterator& operator++();
+
+         const_iterator operator++(int)
+         { const_iterator tmp(*this); ++(*this); return tmp; };
+
+         bool operator==(const const_iterator& right) const
+         { return (pos == right.pos); };
+
+         bool operator!=(const const_iterator& right) const
+         { return (pos != right.pos); };
+
+      private:
+
+            /// Skips columns without a value in this row
+         void skipAbsent();
+
+         const satTypeValueTable* table;
+         size_t row;
+         size_t pos;
+
+      }; // End of class 'const_iterator'
+
+      typedef const_iterator iterator;
+
+
+         /// Default constructor: a handle to no data.
+      typeValueRow()
+         : table(0), row(0) {};
+
+
+         /// Handle to row 'r' of table 't'.
+      typeValueRow(satTypeValueTable* t, size_t r)
+         : table(t), row(r) {};
+
+
+         /// Returns the number of different types available.
+      size_t numTypes() const;
+
+
+         /// Same as numTypes().
+      size_t size() const
+      { return numTypes(); };
+
+
+         /// Returns true if there are no values in this row.
+      bool empty() const
+      { return (numTypes() == 0); };
+
+
+         /// Returns a TypeIDSet with all the data types present in
+         /// this object.
+      TypeIDSet getTypeID() const;
+
+
+         /// First (TypeID, value) pair of this row.
+      const_iterator begin() const;
+
+
+         /// Past-the-end iterator of this row.
+      const_iterator end() const;
+
+
+         /// Returns an iterator to the value of 'type', or end().
+      const_iterator find(const TypeID& type) const;
+
+
+         /// Returns 1 if this row has a value of 'type', 0 otherwise.
+      size_t count(const TypeID& type) const;
+
+
+         /// Returns a reference to the value of 'type', inserting a zero
+         /// value if it is not present (as std::map::operator[] does).
+      double& operator[](const TypeID& type);
+
+
+         /** Returns the data value (double) corresponding to provided type.
+          *
+          * @param type       Type of value to be looked for.
+          */
+      double getValue(const TypeID& type) const
+         throw(TypeIDNotFound);
+
+
+         /// Returns a reference to the data value (double) with
+         /// corresponding type.
+         /// @param type Type of value to be looked for.
+      double& operator()(const TypeID& type)
+         throw(TypeIDNotFound);
+
+
+         /// Modifies this object, removing this type of data.
+         /// @param type Type of value to be removed.
+      typeValueRow& removeTypeID(const TypeID& type);
+
+
+         /// Removes the value of 'type', if present.
+      void erase(const TypeID& type)
+      { removeTypeID(type); };
+
+
+         /// Returns a typeValueMap holding the values of this row.
+      typeValueMap getTypeValueMap() const;
+
+
+   private:
+
+      satTypeValueTable* table;
+      size_t row;
+
+   }; // End of class 'typeValueRow'
+
+
+
+      /** Dense replacement for 'satTypeValueMap'.
+       *
+       * Values are kept in columns: one row per satellite, sorted by
+       * SatID, and one column ("slot") per TypeID, reached by indexing a
+       * table with the TypeID value instead of searching a tree. A slot,
+       * once created, stays in place for the lifetime of the object, and
+       * clear() keeps the memory, so an object reused epoch after epoch
+       * stops allocating as soon as it has seen the largest epoch and all
+       * the types of the processing.
+       *
+       * The interface follows that of 'satTypeValueMap': iterators give
+       * access to 'first' (the SatID) and 'second' (a 'typeValueRow',
+       * which behaves as a 'typeValueMap'), and the usual numSats(),
+       * getVectorOfTypeID(), insertTypeIDVector(), removeSatID(), etc.
+       * methods are provided. This way, processing code may be turned
+       * into templates working on both kinds of objects.
+       *
+       * Iterators, row handles and references to values are invalidated
+       * by the insertion and removal of satellites. Adding new types
+       * invalidates none of them. As with 'satTypeValueMap', the
+       * 'value_type' an iterator refers to belongs to the table, so a
+       * reference to it outlives the iterator and doesn't change when
+       * the iterator moves.
+       *
+       * @sa satTypeValueMap, gnssRinexTable.
+       */
+   class satTypeValueTable
+   {
+   public:
+
+         /// What an iterator gives access to
+      struct value_type
+      {
+         SatID first;
+         typeValueRow second;
+      };
+
+
+         /// Iterator over the satellites of the table
+      class iterator
+      {
+      public:
+
+         iterator()
+            : table(0), row(0) {};
+
+         iterator(satTypeValueTable* t, size_t r)
+            : table(t), row(r) {};
+
+         value_type& operator*() const
+         { return table->entries[row]; };
+
+         value_type* operator->() const
+         { return &(table->entries[row]); };
+
+         iterator& operator++()
+         { ++row; return (*this); };
+
+         iterator operator++(int)
+         { iterator tmp(*this); ++row; return tmp; };
+
+         bool operator==(const iterator& right) const
+         { return (row == right.row); };
+
+         bool operator!=(const iterator& right) const
+         { return (row != right.row); };
+
+      private:
+
+         satTypeValueTable* table;
+         size_t row;
+
+         friend class satTypeValueTable;
+
+      }; // End of class 'iterator'
+
+
+         /// Read-only iterator over the satellites of the table
+      class const_iterator
+      {
+      public:
+
+         const_iterator()
+            : table(0), row(0) {};
+
+         const_iterator(const satTypeValueTable* t, size_t r)
+            : table(t), row(r) {};
+
+         const_iterator(const iterator& it)
+            : table(it.table), row(it.row) {};
+
+         const value_type& operator*() const
+         { return table->entries[row]; };
+
+         const value_type* operator->() const
+         { return &(table->entries[row]); };
+
+         const_iterator& operator++()
+         { ++row; return (*this); };
+
+         const_iterator operator++(int)
+         { const_iterator tmp(*this); ++row; return tmp; };
+
+         bool operator==(const const_iterator& right) const
+         { return (row == right.row); };
+
+         bool operator!=(const const_iterator& right) const
+         { return (row != right.row); };
+
+      private:
+
+         const satTypeValueTable* table;
+         size_t row;
+
+      }; // End of class 'const_iterator'
+
+
+
+         /// Default constructor.
+      satTypeValueTable() {};
+
+
+         /// Copy constructor.
+      satTypeValueTable(const satTypeValueTable& right);
+
+
+         /// Assignment operator.
+      satTypeValueTable& operator=(const satTypeValueTable& right);
+
+
+         /// Builds a table holding the same data as 'stvMap'.
+      explicit satTypeValueTable(const satTypeValueMap& stvMap)
+      { assign(stvMap); };
+
+
+         /// Replaces the contents of this object with the data in 'stvMap'.
+      satTypeValueTable& assign(const satTypeValueMap& stvMap);
+
+
+         /// Returns a satTypeValueMap holding the same data as this object.
+      satTypeValueMap getSatTypeValueMap() const;
+
+
+         /// Stores in 'stvMap' the same data as this object.
+      void getSatTypeValueMap(satTypeValueMap& stvMap) const;
+
+
+         /// Returns the number of available satellites.
+      size_t numSats() const
+      { return sats.size(); };
+
+
+         /// Same as numSats().
+      size_t size() const
+      { return sats.size(); };
+
+
+         /// Returns true if there are no satellites.
+      bool empty() const
+      { return sats.empty(); };
+
+
+         /// Removes all the satellites. Types and memory are kept, ready
+         /// for the next epoch.
+      void clear();
+
+
+         /** Returns the total number of data elements in the table.
+          * This method DOES NOT suppose that all the satellites have
+          * the same number of type values.
+          */
+      size_t numElements() const;
+
+
+      iterator begin()
+      { return iterator(this, 0); };
+
+      iterator end()
+      { return iterator(this, sats.size()); };
+
+      const_iterator begin() const
+      { return const_iterator(this, 0); };
+
+      const_iterator end() const
+      { return const_iterator(this, sats.size()); };
+
+
+         /// Returns an iterator to 'satellite', or end().
+      iterator find(const SatID& satellite);
+
+         /// Returns an iterator to 'satellite', or end().
+      const_iterator find(const SatID& satellite) const;
+
+
+         /// Returns 1 if 'satellite' is present, 0 otherwise.
+      size_t count(const SatID& satellite) const;
+
+
+         /// Returns the data of 'satellite', inserting an empty row if
+         /// it is not present (as std::map::operator[] does).
+      typeValueRow operator[](const SatID& satellite);
+
+
+         /// Removes 'satellite', if present.
+      void erase(const SatID& satellite)
+      { removeSatID(satellite); };
+
+
+         /// Removes the satellite at 'pos', returning an iterator to
+         /// the next satellite.
+      iterator erase(iterator pos);
+
+
+         /// Returns a SatIDSet with all the satellites present in this object.
+      SatIDSet getSatID() const;
+
+
+         /// Returns a Vector with all the satellites present in this object.
+      Vector<SatID> getVectorOfSatID() const;
+
+
+         /// Returns a TypeIDSet with all the data types present in
+         /// this object.  This does not imply that all satellites have
+         /// these types.
+      TypeIDSet getTypeID() const;
+
+
+         /// Returns a satTypeValueTable with only this satellite.
+         /// @param satellite Satellite to be extracted.
+      satTypeValueTable extractSatID(const SatID& satellite) const;
+
+
+         /// Returns a satTypeValueTable with only these satellites.
+         /// @param satSet Set (SatIDSet) containing the satellites to
+         ///               be extracted.
+      satTypeValueTable extractSatID(const SatIDSet& satSet) const;
+
+
+         /// Modifies this object, keeping only this satellite.
+         /// @param satellite Satellite to be kept.
+      satTypeValueTable& keepOnlySatID(const SatID& satellite);
+
+
+         /// Modifies this object, keeping only these satellites.
+         /// @param satSet Set (SatIDSet) containing the satellites to be kept.
+      satTypeValueTable& keepOnlySatID(const SatIDSet& satSet);
+
+
+         /// Returns a satTypeValueTable with only this type of value.
+         /// @param type Type of value to be extracted.
+      satTypeValueTable extractTypeID(const TypeID& type) const;
+
+
+         /// Returns a satTypeValueTable with only these types of data.
+         /// @param typeSet Set (TypeIDSet) containing the types of data
+         ///                to be extracted.
+      satTypeValueTable extractTypeID(const TypeIDSet& typeSet) const;
+
+
+         /// Modifies this object, keeping only this type of data.
+         /// @param type Type of value to be kept.
+      satTypeValueTable& keepOnlyTypeID(const TypeID& type);
+
+
+         /// Modifies this object, keeping only these types of data.
+         /// @param typeSet Set (TypeIDSet) containing the types of data
+         ///                to be kept.
+      satTypeValueTable& keepOnlyTypeID(const TypeIDSet& typeSet);
+
+
+         /// Modifies this object, removing this satellite.
+         /// @param satellite Satellite to be removed.
+      satTypeValueTable& removeSatID(const SatID& satellite);
+
+
+         /// Modifies this object, removing these satellites.
+         /// @param satSet Set (SatIDSet) containing the satellites
+         ///               to be removed.
+      satTypeValueTable& removeSatID(const SatIDSet& satSet);
+
+
+         /// Modifies this object, removing this type of data.
+         /// @param type Type of value to be removed.
+      satTypeValueTable& removeTypeID(const TypeID& type);
+
+
+         /// Modifies this object, removing these types of data.
+         /// @param typeSet Set (TypeIDSet) containing the types of data
+         ///                to be removed.
+      satTypeValueTable& removeTypeID(const TypeIDSet& typeSet);
+
+
+         /// Returns a GPSTk::Vector containing the data values with this type.
+         /// @param type Type of value to be returned.
+         /// This method returns zero if a given satellite does not have
+         /// this type.
+      Vector<double> getVectorOfTypeID(const TypeID& type) const;
+
+
+         /// Returns a GPSTk::Matrix containing the data values in this set.
+         /// @param typeSet  TypeIDSet of values to be returned.
+      Matrix<double> getMatrixOfTypes(const TypeIDSet& typeSet) const;
+
+
+         /** Modifies this object, adding one vector of data with this type,
+          *  one value per satellite.
+          *
+          * @param type          Type of data to be added.
+          * @param dataVector    GPSTk Vector containing the data to be added.
+          *
+          * @sa satTypeValueMap::insertTypeIDVector()
+          */
+      satTypeValueTable& insertTypeIDVector( const TypeID& type,
+                                             const Vector<double> dataVector )
+         throw(NumberOfSatsMismatch);
+
+
+         /** Modifies this object, adding a matrix of data, one vector
+          *  per satellite.
+          *
+          * @param typeSet       Set (TypeIDSet) containing the types of data
+          *                      to be added.
+          * @param dataMatrix    GPSTk Matrix containing the data to be added.
+          *
+          * @sa satTypeValueMap::insertMatrix()
+          */
+      satTypeValueTable& insertMatrix( const TypeIDSet& typeSet,
+                                       const Matrix<double> dataMatrix )
+         throw(NumberOfSatsMismatch, NumberOfTypesMismatch);
+
+
+         /** Returns the data value (double) corresponding to provided SatID
+          *  and TypeID.
+          *
+          * @param satellite     Satellite to be looked for.
+          * @param type          Type to be looked for.
+          */
+      double getValue( const SatID& satellite,
+                       const TypeID& type ) const
+         throw( SatIDNotFound, TypeIDNotFound );
+
+
+         /// Returns the data of the satellite with corresponding SatID.
+         /// @param satellite Satellite to be looked for.
+      typeValueRow operator()(const SatID& satellite)
+         throw(SatIDNotFound);
+
+
+         /// Convenience output method
+      virtual std::ostream& dump( std::ostream& s,
+                                  int mode = 0) const;
+
+
+         /// Destructor.
+      virtual ~satTypeValueTable() {};
+
+
+   private:
+
+         /// Sentinel for types without a slot
+      static const size_t noSlot;
+
+
+         /// Returns the slot of 'type', or noSlot.
+      size_t getSlot(const TypeID& type) const
+      {
+         size_t t( static_cast<size_t>(type.type) );
+         return ( (t < slotOf.size()) ? slotOf[t] : noSlot );
+      };
+
+
+         /// Returns the slot of 'type', creating it if needed.
+      size_t insertSlot(const TypeID& type);
+
+
+         /// Returns the row of 'satellite', or the number of satellites
+         /// if it is not present.
+      size_t getRow(const SatID& satellite) const;
+
+
+         /// Returns the row of 'satellite', inserting an empty one (in
+         /// SatID order) if needed.
+      size_t insertRow(const SatID& satellite);
+
+
+         /// Removes row 'r'.
+      void eraseRow(size_t r);
+
+
+         /// Points the handles in 'entries' from row 'r' on at their rows.
+      void renumberEntries(size_t r);
+
+
+         /// Returns true if row 'r' has a value in slot 's'.
+      bool hasValue(size_t r, size_t s) const
+      { return (flags[s][r] != 0); };
+
+
+         /// Satellites, in increasing order; row 'i' belongs to sats[i]
+      std::vector<SatID> sats;
+
+         /// What the iterators refer to: the SatID and a handle of each
+         /// row, kept in step with 'sats'
+      std::vector<value_type> entries;
+
+         /// Type held in each slot
+      std::vector<TypeID> types;
+
+         /// Slot of each TypeID value, or noSlot
+      std::vector<size_t> slotOf;
+
+         /// Slots, sorted by type
+      std::vector<size_t> order;
+
+         /// Position of each slot inside 'order'
+      std::vector<size_t> rank;
+
+         /// Values of each slot, one per row. A std::deque keeps the
+         /// columns in place when new slots are added.
+      std::deque< std::vector<double> > columns;
+
+         /// Flags telling which values of each slot are present
+      std::deque< std::vector<unsigned char> > flags;
+
+
+      friend class typeValueRow;
+      friend class typeValueRow::const_iterator;
+
+   };  // End of class 'satTypeValueTable'
+
+
+
+      // Hot accessors, inline so that processing classes looping over
+      // every satellite and type do not pay a call for each value.
+
+   inline
+   typeValueRow::const_iterator::const_iterator( const satTypeValueTable* t,
+                                                 size_t r,
+                                                 size_t p )
+      : table(t), row(r), pos(p)
+   {
+      skipAbsent();
+   }
+
+
+   inline void typeValueRow::const_iterator::skipAbsent()
+   {
+
+      if(table == 0) return;
+
+      while( ( pos < table->order.size() ) &&
+             !table->hasValue(row, table->order[pos]) )
+      {
+         ++pos;
+      }
+
+   }  // End of method 'typeValueRow::const_iterator::skipAbsent()'
+
+
+   inline typeValueRow::const_iterator typeValueRow::end() const
+   { return const_iterator(table, row, table->order.size()); }
+
+
+      // Returns an iterator to the value of 'type', or end().
+   inline typeValueRow::const_iterator
+   typeValueRow::find(const TypeID& type) const
+   {
+
+      size_t slot( table->getSlot(type) );
+
+      if( slot == satTypeValueTable::noSlot ||
+          !table->hasValue(row, slot) )
+      {
+         return end();
+      }
+
+      return const_iterator(table, row, table->rank[slot]);
+
+   }  // End of method 'typeValueRow::find()'
+
+
+      // Returns 1 if this row has a value of 'type', 0 otherwise.
+   inline size_t typeValueRow::count(const TypeID& type) const
+   {
+
+      size_t slot( table->getSlot(type) );
+
+      return ( ( slot != satTypeValueTable::noSlot &&
+                 table->hasValue(row, slot) ) ? 1 : 0 );
+
+   }  // End of method 'typeValueRow::count()'
+
+
+      // Returns a reference to the value of 'type', inserting a zero
+      // value if it is not present.
+   inline double& typeValueRow::operator[](const TypeID& type)
+   {
+
+      size_t slot( table->getSlot(type) );
+      if( slot == satTypeValueTable::noSlot )
+      {
+         slot = table->insertSlot(type);
+      }
+
+      if( !table->flags[slot][row] )
+      {
+         table->flags[slot][row] = 1;
+         table->columns[slot][row] = 0.0;
+      }
+
+      return table->columns[slot][row];
+
+   }  // End of method 'typeValueRow::operator[]'
+
+
+
+      /// stream output for satTypeValueTable
+   std::ostream& operator<<( std::ostream& s,
+                             const satTypeValueTable& stvTable );
+
+
+
+      /** Dense counterpart of 'gnssRinex': a 'sourceEpochRinexHeader' and
+       *  a 'satTypeValueTable' body.
+       *
+       * A typical way to use this structure follows:
+       *
+       * @code
+       *   RinexObsStream rin("onsa2240.05o");
+       *   gnssRinexTable gRin;
+       *
+       *   while(rin >> gRin)
+       *   {
+       *      gRin >> requireObs >> linear1 >> markCSLI >> markCSMW;
+       *   }
+       * @endcode
+       *
+       * Processing classes that do not handle 'gnssRinexTable' objects
+       * yet get their data converted to and from 'gnssRinex' (see
+       * ProcessingClass::Process()), so chains may mix both kinds. That
+       * conversion is paid at every such class, so when a chain ends with
+       * several of them it is cheaper to convert once with getGnssRinex()
+       * and go on with a 'gnssRinex' object.
+       */
+   struct gnssRinexTable : gnssData<sourceEpochRinexHeader, satTypeValueTable>
+   {
+
+         /// Default constructor.
+      gnssRinexTable() {};
+
+
+         /// Builds a gnssRinexTable holding the same data as 'gRin'.
+      explicit gnssRinexTable(const gnssRinex& gRin)
+      { assign(gRin); };
+
+
+         /// Replaces the contents of this object with the data in 'gRin'.
+      gnssRinexTable& assign(const gnssRinex& gRin);
+
+
+         /// Stores in 'gRin' the same data as this object.
+      void getGnssRinex(gnssRinex& gRin) const;
+
+
+         /// Returns the number of satellites available in the body.
+      size_t numSats() const
+      { return body.numSats(); };
+
+
+         /// Returns a SatIDSet with all the satellites present in this object.
+      SatIDSet getSatID() const
+      { return body.getSatID(); };
+
+
+         /// Returns a Vector with all the satellites present in this object.
+      Vector<SatID> getVectorOfSatID() const
+      { return body.getVectorOfSatID(); };
+
+
+         /// Returns a TypeIDSet with all the data types present in
+         /// this object.
+      TypeIDSet getTypeID() const
+      { return body.getTypeID(); };
+
+
+         /// Returns a GPSTk::Vector containing the data values with this type.
+         /// @param type Type of value to be returned.
+      Vector<double> getVectorOfTypeID(const TypeID& type) const
+      { return body.getVectorOfTypeID(type); };
+
+
+         /// Modifies this object, adding one vector of data with this type,
+         /// one value per satellite.
+      gnssRinexTable& insertTypeIDVector( const TypeID& type,
+                                          const Vector<double> dataVector )
+         throw(NumberOfSatsMismatch)
+      { body.insertTypeIDVector(type, dataVector); return (*this); };
+
+
+         /// Modifies this object, keeping only these satellites.
+      gnssRinexTable& keepOnlySatID(const SatIDSet& satSet)
+      { body.keepOnlySatID(satSet); return (*this); };
+
+
+         /// Modifies this object, keeping only these types of data.
+      gnssRinexTable& keepOnlyTypeID(const TypeIDSet& typeSet)
+      { body.keepOnlyTypeID(typeSet); return (*this); };
+
+
+         /// Modifies this object, removing these satellites.
+      gnssRinexTable& removeSatID(const SatIDSet& satSet)
+      { body.removeSatID(satSet); return (*this); };
+
+
+         /// Modifies this object, removing these types of data.
+      gnssRinexTable& removeTypeID(const TypeIDSet& typeSet)
+      { body.removeTypeID(typeSet); return (*this); };
+
+
+         /** Returns the data value (double) corresponding to provided SatID
+          *  and TypeID.
+          */
+      double getValue( const SatID& satellite,
+                       const TypeID& type ) const
+         throw( SatIDNotFound, TypeIDNotFound )
+      { return body.getValue(satellite, type); };
+
+
+         /// Destructor.
+      virtual ~gnssRinexTable() {};
+
+   };  // End of 'gnssRinexTable'
+
+
+
+      /// Input for gnssRinexTable from RinexObsHeader.
+      /// @param roh RinexObsHeader holding the data.
+      /// @param f gnssRinexTable receiving the data.
+   gnssRinexTable& operator>>( const RinexObsHeader& roh,
+                               gnssRinexTable& f );
+
+
+      /// Input for gnssRinexTable from RinexObsData.
+      /// @param rod RinexObsData holding the data.
+      /// @param f gnssRinexTable receiving the data.
+   gnssRinexTable& operator>>( const RinexObsData& rod,
+                               gnssRinexTable& f );
+
+
+      /** Stream input for gnssRinexTable.
+       *
+       * Epochs are read as RinexObsData objects and their observations
+       * go straight into the table, with the same conversions (phases
+       * in meters, LLI and SSI indexes) done for 'gnssRinex'.
+       */
+   std::istream& operator>>( std::istream& i,
+                             gnssRinexTable& f )
+      throw(FFStreamError, gpstk::StringUtils::StringException);
+
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif // GPSTK_SATTYPEVALUETABLE_HPP
@@ -55,7 +55,7 @@ namespace gpstk
        *                      to be solved.
        */
    SolverGeneral::SolverGeneral( const std::list<Equation>& equationList )
-      : firstTime(true)
+      : firstTime(true), sparseMode(false)
    {
 
          // Visit each "Equation" in 'equationList' and add them to 'equSystem'
@@ -170,9 +170,16 @@ namespace gpstk
             // This equation model MUST HAS BEEN previously set, usually when
             // creating the SolverPPP object with the appropriate
             // constructor.
-         Compute( measVector,
-                  hMatrix,
-                  rMatrix );
+         if( sparseMode )
+         {
+            computeBlocks( measVector );
+         }
+         else
+         {
+            Compute( measVector,
+                     hMatrix,
+                     rMatrix );
+         }
 
 
             // Store data after computing
@@ -214,6 +221,14 @@ namespace gpstk
             // Measurements vector (Prefit-residuals)
          measVector = equSystem.getPrefitsVector();
 
+            // In sparse mode the rest is handled block by block
+         if( sparseMode )
+         {
+            prepareBlocks();
+
+            return gdsMap;
+         }
+
             // Geometry matrix
          hMatrix = equSystem.getGeometryMatrix();
 
@@ -484,6 +499,373 @@ covariance matrix.");
 
 
 
+      // Find the root of the block 'col' belongs to.
+   int SolverGeneral::findBlockRoot( std::vector<int>& parent, int col )
+   {
+
+      while( parent[col] != col )
+      {
+            // Shorten the path while climbing up
+         parent[col] = parent[ parent[col] ];
+         col = parent[col];
+      }
+
+      return col;
+
+   }  // End of method 'SolverGeneral::findBlockRoot()'
+
+
+
+      /* Split the current unknowns into independent blocks, and fill
+       * the state and covariance matrix of each block. Used in sparse
+       * mode instead of feeding the full system to the Kalman filter.
+       */
+   void SolverGeneral::prepareBlocks(void)
+   {
+
+         // Get the set with unknowns being processed
+      VariableSet unkSet( equSystem.getVarUnknowns() );
+      const int numUnknowns( unkSet.size() );
+
+         // Geometry rows hold the columns involved in each equation
+      const std::vector<EquationSystem::GeometryRow>& hRows(
+                                             equSystem.getGeometryRows() );
+      const int numRows( hRows.size() );
+
+         // Columns of the unknowns
+      std::vector<Variable> unkVector( unkSet.begin(), unkSet.end() );
+      std::map<Variable, int> colMap;
+      for( int col = 0; col < numUnknowns; ++col )
+      {
+         colMap[ unkVector[col] ] = col;
+      }
+
+         // At first, each unknown is a block on its own
+      std::vector<int> parent( numUnknowns );
+      for( int col = 0; col < numUnknowns; ++col )
+      {
+         parent[col] = col;
+      }
+
+         // Unknowns appearing in the same equation belong to the same block
+      for( int row = 0; row < numRows; ++row )
+      {
+         const EquationSystem::GeometryRow& hRow( hRows[row] );
+         if( hRow.empty() ) continue;
+
+         int root( findBlockRoot( parent, hRow[0].first ) );
+         for( size_t k = 1; k < hRow.size(); ++k )
+         {
+            parent[ findBlockRoot( parent, hRow[k].first ) ] = root;
+         }
+      }
+
+         // Unknowns with covariance between them belong to the same block
+      if( !firstTime )
+      {
+         for( std::map<Variable, VariableDataMap>::const_iterator itCov =
+                                                         covarianceMap.begin();
+              itCov != covarianceMap.end();
+              ++itCov )
+         {
+
+            std::map<Variable, int>::const_iterator itCol1(
+                                             colMap.find( (*itCov).first ) );
+            if( itCol1 == colMap.end() ) continue;
+
+            for( VariableDataMap::const_iterator itVar2 =
+                                                      (*itCov).second.begin();
+                 itVar2 != (*itCov).second.end();
+                 ++itVar2 )
+            {
+
+               if( (*itVar2).second == 0.0 ) continue;
+
+               std::map<Variable, int>::const_iterator itCol2(
+                                             colMap.find( (*itVar2).first ) );
+               if( itCol2 == colMap.end() ) continue;
+
+               parent[ findBlockRoot( parent, (*itCol2).second ) ] =
+                                 findBlockRoot( parent, (*itCol1).second );
+            }
+         }
+      }
+
+         // Build the blocks. Columns are visited in order, so the unknowns
+         // of each block keep the order of 'unkSet'
+      blockList.clear();
+      std::vector<int> blockOf( numUnknowns, -1 );
+      for( int col = 0; col < numUnknowns; ++col )
+      {
+         int root( findBlockRoot( parent, col ) );
+         if( blockOf[root] < 0 )
+         {
+            blockOf[root] = blockList.size();
+            blockList.push_back( VariableBlock() );
+         }
+
+         VariableBlock& block( blockList[ blockOf[root] ] );
+         block.vars.push_back( unkVector[col] );
+         block.cols.push_back( col );
+      }
+
+         // Assign each equation to its block
+      for( int row = 0; row < numRows; ++row )
+      {
+         if( hRows[row].empty() ) continue;
+
+         int root( findBlockRoot( parent, hRows[row][0].first ) );
+         blockList[ blockOf[root] ].rows.push_back( row );
+      }
+
+         // Feed each block with the correct state and covariance matrix
+      for( std::vector<VariableBlock>::iterator itBlock = blockList.begin();
+           itBlock != blockList.end();
+           ++itBlock )
+      {
+
+         const std::vector<Variable>& vars( (*itBlock).vars );
+         const int numVar( vars.size() );
+
+         (*itBlock).state.resize( numVar, 0.0 );
+         (*itBlock).covariance.resize( numVar, numVar, 0.0 );
+
+         if( firstTime )
+         {
+               // Fill the initial covariance matrix
+            for( int i = 0; i < numVar; ++i )
+            {
+               (*itBlock).covariance(i, i) = vars[i].getInitialVariance();
+            }
+         }
+         else
+         {
+
+            for( int i = 0; i < numVar; ++i )
+            {
+
+                  // Fill the state vector
+               (*itBlock).state(i) = stateMap[ vars[i] ];
+
+                  // Fill the diagonal element
+               VariableDataMap& covRow( covarianceMap[ vars[i] ] );
+               (*itBlock).covariance(i, i) = covRow[ vars[i] ];
+
+               for( int j = i+1; j < numVar; ++j )
+               {
+
+                     // Check if 'vars[j]' belongs to 'covarianceMap'
+                  if( covarianceMap.find( vars[j] ) != covarianceMap.end() )
+                  {
+                        // If it belongs, get element from 'covarianceMap'
+                     (*itBlock).covariance(i, j) =
+                        (*itBlock).covariance(j, i) = covRow[ vars[j] ];
+                  }
+                  else
+                  {
+                        // If it doesn't belong, ask for default covariance
+                     (*itBlock).covariance(i, j) =
+                        (*itBlock).covariance(j, i) =
+                                                vars[j].getInitialVariance();
+                  }
+               }
+            }
+
+         }  // End of 'if( firstTime )'
+
+      }  // End of 'for( std::vector<VariableBlock>::iterator itBlock = ...'
+
+         // No longer first time
+      firstTime = false;
+
+      return;
+
+   }  // End of method 'SolverGeneral::prepareBlocks()'
+
+
+
+      /* Compute the solution of the given equations set block by block,
+       * using the sparse geometry and the diagonal weights, phi and q
+       * values provided by the equation system.
+       *
+       * @param prefitResiduals   Vector of prefit residuals
+       *
+       * @return
+       *  0 if OK
+       *  -1 if problems arose
+       */
+   int SolverGeneral::computeBlocks( const Vector<double>& prefitResiduals )
+      throw(InvalidSolver)
+   {
+
+         // By default, results are invalid
+      valid = false;
+
+      const std::vector<EquationSystem::GeometryRow>& hRows(
+                                             equSystem.getGeometryRows() );
+      const std::vector<double>& weights( equSystem.getWeightsDiagonal() );
+      const std::vector<double>& phiVector( equSystem.getPhiDiagonal() );
+      const std::vector<double>& qVector( equSystem.getQDiagonal() );
+
+      int pRow = static_cast<int>(prefitResiduals.size());
+      if ( static_cast<int>(weights.size()) != pRow )
+      {
+         InvalidSolver e("prefitResiduals size does not match dimension of \
+weightMatrix");
+         GPSTK_THROW(e);
+      }
+
+      if ( static_cast<int>(hRows.size()) != pRow )
+      {
+         InvalidSolver e("prefitResiduals size does not match dimension \
+of designMatrix");
+         GPSTK_THROW(e);
+      }
+
+         // Get the number of unknowns being processed
+      int numUnknowns( equSystem.getTotalNumVariables() );
+
+      if ( static_cast<int>(phiVector.size()) != numUnknowns ||
+           static_cast<int>(qVector.size()) != numUnknowns )
+      {
+         InvalidSolver e("Number of unknowns does not match dimension \
+of phiMatrix");
+         GPSTK_THROW(e);
+      }
+
+      solution.resize( numUnknowns, 0.0 );
+      postfitResiduals = prefitResiduals;
+
+         // Position of each unknown inside its own block
+      std::vector<int> blockCol( numUnknowns, 0 );
+
+      for( std::vector<VariableBlock>::iterator itBlock = blockList.begin();
+           itBlock != blockList.end();
+           ++itBlock )
+      {
+
+         const std::vector<int>& cols( (*itBlock).cols );
+         const std::vector<int>& rows( (*itBlock).rows );
+         const int numVar( cols.size() );
+         const int numRow( rows.size() );
+
+         for( int i = 0; i < numVar; ++i )
+         {
+            blockCol[ cols[i] ] = i;
+         }
+
+         if( numRow == 0 )
+         {
+
+               // No measurements: just propagate state and covariance
+            for( int i = 0; i < numVar; ++i )
+            {
+               double phi_i( phiVector[ cols[i] ] );
+
+               (*itBlock).state(i) *= phi_i;
+
+               for( int j = 0; j < numVar; ++j )
+               {
+                  (*itBlock).covariance(i, j) *= phi_i * phiVector[ cols[j] ];
+               }
+
+               (*itBlock).covariance(i, i) += qVector[ cols[i] ];
+            }
+
+         }
+         else
+         {
+
+            Matrix<double> phiMatrix( numVar, numVar, 0.0 );
+            Matrix<double> qMatrix( numVar, numVar, 0.0 );
+            for( int i = 0; i < numVar; ++i )
+            {
+               phiMatrix(i, i) = phiVector[ cols[i] ];
+               qMatrix(i, i)   = qVector[ cols[i] ];
+            }
+
+               // The weights matrix is diagonal, so the measurements noise
+               // covariance matrix is just its inverse element by element
+            Vector<double> measVector( numRow, 0.0 );
+            Matrix<double> hMatrix( numRow, numVar, 0.0 );
+            Matrix<double> measNoiseMatrix( numRow, numRow, 0.0 );
+            for( int k = 0; k < numRow; ++k )
+            {
+               int row( rows[k] );
+
+               if( !( weights[row] > 0.0 ) )
+               {
+                  InvalidSolver e("Correct(): Unable to compute measurements \
+noise covariance matrix.");
+                  GPSTK_THROW(e);
+               }
+
+               measVector(k) = prefitResiduals(row);
+               measNoiseMatrix(k, k) = 1.0 / weights[row];
+
+               for( EquationSystem::GeometryRow::const_iterator itH =
+                                                         hRows[row].begin();
+                    itH != hRows[row].end();
+                    ++itH )
+               {
+                  hMatrix( k, blockCol[ (*itH).first ] ) = (*itH).second;
+               }
+            }
+
+            try
+            {
+
+                  // Call the Kalman filter object.
+               kFilter.Reset( (*itBlock).state, (*itBlock).covariance );
+               kFilter.Compute( phiMatrix,
+                                qMatrix,
+                                measVector,
+                                hMatrix,
+                                measNoiseMatrix );
+
+            }
+            catch(InvalidSolver& e)
+            {
+               GPSTK_RETHROW(e);
+            }
+
+            (*itBlock).state = kFilter.xhat;
+            (*itBlock).covariance = kFilter.P;
+
+               // Compute the postfit residuals of this block
+            for( int k = 0; k < numRow; ++k )
+            {
+               int row( rows[k] );
+
+               for( EquationSystem::GeometryRow::const_iterator itH =
+                                                         hRows[row].begin();
+                    itH != hRows[row].end();
+                    ++itH )
+               {
+                  postfitResiduals(row) -= (*itH).second
+                                 * (*itBlock).state( blockCol[ (*itH).first ] );
+               }
+            }
+
+         }  // End of 'if( numRow == 0 )'
+
+            // Store the solution of this block
+         for( int i = 0; i < numVar; ++i )
+         {
+            solution( cols[i] ) = (*itBlock).state(i);
+         }
+
+      }  // End of 'for( std::vector<VariableBlock>::iterator itBlock = ...'
+
+         // If everything is fine so far, then the results should be valid
+      valid = true;
+
+      return 0;
+
+   }  // End of method 'SolverGeneral::computeBlocks()'
+
+
+
       /* Code to be executed after 'Compute()' method.
        *
        * @param gData    Data object holding the data.
@@ -499,58 +881,93 @@ covariance matrix.");
          stateMap.clear();
          covarianceMap.clear();
 
+         int i(0);      // Set an index
 
-            // Get the set with unknowns being processed
-         VariableSet unkSet( equSystem.getVarUnknowns() );
+         if( sparseMode )
+         {
 
+               // Store state and covariance of each block. Covariance
+               // between different blocks is zero, and it is not stored
+            for( std::vector<VariableBlock>::const_iterator itBlock =
+                                                            blockList.begin();
+                 itBlock != blockList.end();
+                 ++itBlock )
+            {
 
-            // Store values of current state
+               const std::vector<Variable>& vars( (*itBlock).vars );
+               const int numVar( vars.size() );
 
-         int i(0);      // Set an index
+               for( i = 0; i < numVar; ++i )
+               {
 
-         for( VariableSet::const_iterator itVar = unkSet.begin();
-              itVar != unkSet.end();
-              ++itVar )
-         {
+                  stateMap[ vars[i] ] = (*itBlock).state(i);
+
+                  VariableDataMap& covRow( covarianceMap[ vars[i] ] );
+                  for( int j = i; j < numVar; ++j )
+                  {
+                     covRow[ vars[j] ] = (*itBlock).covariance(i, j);
+                  }
+               }
+
+            }  // End of 'for( std::vector<VariableBlock>::const_iterator ...'
 
-            stateMap[ (*itVar) ] = solution(i);
-            ++i;
          }
+         else
+         {
 
+               // Get the set with unknowns being processed
+            VariableSet unkSet( equSystem.getVarUnknowns() );
 
-            // Store values of covariance matrix
 
-            // We need a copy of 'unkSet'
-         VariableSet tempSet( unkSet );
+               // Store values of current state
 
-         i = 0;         // Reset 'i' index
+            i = 0;         // Reset 'i' index
 
-         for( VariableSet::const_iterator itVar1 = unkSet.begin();
-              itVar1 != unkSet.end();
-              ++itVar1 )
-         {
+            for( VariableSet::const_iterator itVar = unkSet.begin();
+                 itVar != unkSet.end();
+                 ++itVar )
+            {
+
+               stateMap[ (*itVar) ] = solution(i);
+               ++i;
+            }
 
-               // Fill the diagonal element
-            covarianceMap[ (*itVar1) ][ (*itVar1) ] = covMatrix(i, i);
 
-            int j(i+1);      // Set 'j' index
+               // Store values of covariance matrix
 
-               // Remove current Variable from 'tempSet'
-            tempSet.erase( (*itVar1) );
+               // We need a copy of 'unkSet'
+            VariableSet tempSet( unkSet );
 
-            for( VariableSet::const_iterator itVar2 = tempSet.begin();
-                 itVar2 != tempSet.end();
-                 ++itVar2 )
+            i = 0;         // Reset 'i' index
+
+            for( VariableSet::const_iterator itVar1 = unkSet.begin();
+                 itVar1 != unkSet.end();
+                 ++itVar1 )
             {
 
-               covarianceMap[ (*itVar1) ][ (*itVar2) ] = covMatrix(i, j);
+                  // Fill the diagonal element
+               covarianceMap[ (*itVar1) ][ (*itVar1) ] = covMatrix(i, i);
 
-               ++j;
-            }
+               int j(i+1);      // Set 'j' index
+
+                  // Remove current Variable from 'tempSet'
+               tempSet.erase( (*itVar1) );
+
+               for( VariableSet::const_iterator itVar2 = tempSet.begin();
+                    itVar2 != tempSet.end();
+                    ++itVar2 )
+               {
 
-            ++i;
+                  covarianceMap[ (*itVar1) ][ (*itVar2) ] = covMatrix(i, j);
 
-         }  // End of for( VariableSet::const_iterator itVar1 = unkSet...'
+                  ++j;
+               }
+
+               ++i;
+
+            }  // End of for( VariableSet::const_iterator itVar1 = unkSet...'
+
+         }  // End of 'if( sparseMode )'
 
 
             // Store the postfit residuals in the GNSS Data Structure
@@ -809,4 +1226,55 @@ covariance matrix.");
 
 
 
+      /* Returns the covariance between two given Variables. It is zero
+       * for Variables in different blocks in sparse mode.
+       *
+       * @param var1    First Variable.
+       * @param var2    Second Variable.
+       */
+   double SolverGeneral::getCovariance( const Variable& var1,
+                                        const Variable& var2 )
+      throw(InvalidRequest)
+   {
+
+         // Check if the provided Variables exist in the solution. If not,
+         // an InvalidSolver exception will be issued.
+      if( stateMap.find( var1 ) == stateMap.end() ||
+          stateMap.find( var2 ) == stateMap.end() )
+      {
+         InvalidRequest e("Variable not found in covariance matrix.");
+         GPSTK_THROW(e);
+      }
+
+         // Only one of the symmetric elements is stored, and none at all
+         // between different blocks
+      std::map<Variable, VariableDataMap >::const_iterator it;
+      VariableDataMap::const_iterator itData;
+
+      it = covarianceMap.find( var1 );
+      if( it != covarianceMap.end() )
+      {
+         itData = (*it).second.find( var2 );
+         if( itData != (*it).second.end() )
+         {
+            return (*itData).second;
+         }
+      }
+
+      it = covarianceMap.find( var2 );
+      if( it != covarianceMap.end() )
+      {
+         itData = (*it).second.find( var1 );
+         if( itData != (*it).second.end() )
+         {
+            return (*itData).second;
+         }
+      }
+
+      return 0.0;
+
+   }  // End of method 'SolverGeneral::getCovariance()'
+
+
+
 }  // End of namespace gpstk
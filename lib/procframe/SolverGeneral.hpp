@@ -172,7 +172,8 @@ namespace gpstk
           *
           * @param equation      Object describing the equations to be solved.
           */
-      SolverGeneral( const Equation& equation ) : firstTime(true)
+      SolverGeneral( const Equation& equation )
+         : firstTime(true), sparseMode(false)
       { equSystem.addEquation(equation); };
 
 
@@ -189,7 +190,8 @@ namespace gpstk
           * @param equationSys         Object describing an equation system to
           *                            be solved.
           */
-      SolverGeneral( const EquationSystem& equationSys ) : firstTime(true)
+      SolverGeneral( const EquationSystem& equationSys )
+         : firstTime(true), sparseMode(false)
       { equSystem = equationSys; };
 
 
@@ -245,6 +247,40 @@ namespace gpstk
       { firstTime = true; return (*this); };
 
 
+         /** Set whether the filter works block by block (sparse mode).
+          *
+          * In sparse mode the unknowns are split into independent blocks:
+          * two unknowns belong to the same block when they appear in the
+          * same equation or their covariance is not zero. Each block is
+          * then filtered on its own, so for networks where every station
+          * has its own unknowns (coordinates, clock, troposphere and
+          * ambiguities) the run time grows linearly with the number of
+          * stations instead of with the cube of the number of unknowns.
+          * Ambiguities entering or leaving the system only change the size
+          * of their own block.
+          *
+          * The solution is the same as in the normal (dense) mode,
+          * because the covariance between different blocks is always zero.
+          * Unknowns shared by all the stations (for instance, satellite
+          * clocks) join all the stations into a single block, and then
+          * this mode gives no advantage.
+          *
+          * @param sparse     Whether sparse mode is used or not.
+          *
+          * \warning In sparse mode the full covariance matrix of the
+          * solution ('covMatrix') and the matrices returned by
+          * getPhiMatrix() and getQMatrix() are not computed. Use
+          * getVariance() instead.
+          */
+      virtual SolverGeneral& setSparseMode(bool sparse)
+      { sparseMode = sparse; return (*this); };
+
+
+         /// Get whether the filter works block by block (sparse mode).
+      virtual bool getSparseMode(void) const
+      { return sparseMode; };
+
+
          /** Returns a reference to a gnnsSatTypeValue object after
           *  solving the previously defined equation system.
           *
@@ -339,6 +375,17 @@ namespace gpstk
          throw(InvalidRequest);
 
 
+         /** Returns the covariance between two given Variables. It is zero
+          *  for Variables in different blocks in sparse mode.
+          *
+          * @param var1    First Variable.
+          * @param var2    Second Variable.
+          */
+      virtual double getCovariance( const Variable& var1,
+                                    const Variable& var2 )
+         throw(InvalidRequest);
+
+
          /// Get the State Transition Matrix (phiMatrix)
       virtual Matrix<double> getPhiMatrix(void) const
       { return phiMatrix; };
@@ -423,6 +470,34 @@ namespace gpstk
       bool firstTime;
 
 
+         /// Boolean indicating if the filter works block by block
+      bool sparseMode;
+
+
+         /// Group of unknowns independent from the rest of the system
+      struct VariableBlock
+      {
+            /// Unknowns belonging to this block
+         std::vector<Variable> vars;
+
+            /// Position of each unknown in the set of unknowns
+         std::vector<int> cols;
+
+            /// Position of the current equations involving these unknowns
+         std::vector<int> rows;
+
+            /// State of the unknowns
+         Vector<double> state;
+
+            /// Covariance matrix of the unknowns
+         Matrix<double> covariance;
+      };
+
+
+         /// Blocks being processed in sparse mode
+      std::vector<VariableBlock> blockList;
+
+
          /// Initial index assigned to this class.
       static int classIndex;
 
@@ -431,7 +506,7 @@ namespace gpstk
 
          /// Sets the index and increment classIndex.
       void setIndex(void)
-      { index = classIndex++; };
+      { index = nextIndex(classIndex); };
 
 
          // Do not allow the use of the default constructor.
@@ -458,6 +533,31 @@ namespace gpstk
          throw(InvalidSolver);
 
 
+         /** Split the current unknowns into independent blocks, and fill
+          *  the state and covariance matrix of each block. Used in sparse
+          *  mode instead of feeding the full system to the Kalman filter.
+          */
+      void prepareBlocks(void);
+
+
+         /** Compute the solution of the given equations set block by
+          *  block, using the sparse geometry and the diagonal weights, phi
+          *  and q values provided by the equation system.
+          *
+          * @param prefitResiduals   Vector of prefit residuals
+          *
+          * @return
+          *  0 if OK
+          *  -1 if problems arose
+          */
+      virtual int computeBlocks( const Vector<double>& prefitResiduals )
+         throw(InvalidSolver);
+
+
+         /// Find the root of the block 'col' belongs to.
+      static int findBlockRoot( std::vector<int>& parent, int col );
+
+
    }; // End of class 'SolverGeneral'
 
       //@}
@@ -35,11 +35,20 @@ namespace vdraw
     if (buf == 0 || len == 0)
       return;
 
-    // Go in order...
-    for(unsigned int i=0;i<len;i++)
+    // The sums can go 5552 bytes before they might overflow 32 bits, so
+    // only take the modulus that often.
+    const unsigned char *p = (const unsigned char*)buf;
+    while(len)
     {
-      a = (a+(((int)buf[i])&0x000000FF)) % mod;
-      b = (b+a) % mod;
+      unsigned int n = len<5552 ? len : 5552;
+      len -= n;
+      while(n--)
+      {
+        a += *p++;
+        b += a;
+      }
+      a %= mod;
+      b %= mod;
     }
   }
 
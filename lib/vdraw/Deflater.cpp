@@ -0,0 +1,654 @@
+#pragma ident "$Id:$"
+
+/// @file Deflater.cpp Streaming zlib (deflate) compressor. Class definitions.
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+#include <algorithm>
+#include <cstring>
+
+#include "Deflater.hpp"
+
+namespace vdraw
+{
+  namespace
+  {
+    const int WSIZE = 32768;            // Largest match distance
+    const int WMASK = WSIZE-1;
+    const int WIN2 = 2*WSIZE;           // Size of the window buffer
+    const int MIN_MATCH = 3;
+    const int MAX_MATCH = 258;
+    const int MIN_LOOKAHEAD = MAX_MATCH+MIN_MATCH+1;
+    const int MAX_DIST = WSIZE-MIN_LOOKAHEAD;
+    const int TOO_FAR = 4096;           // Don't use length 3 matches further
+    const int HBITS = 15;
+    const int HSIZE = 1<<HBITS;
+    const unsigned int MAX_SYMS = 16384; // Symbols per block
+
+    /// Tuning by level, as in zlib: good, lazy, nice, chain
+    const int config[10][4] = {
+      {0,0,0,0},
+      {4,4,8,4},       {4,5,16,8},      {4,6,32,32},
+      {4,4,16,16},     {8,16,32,32},    {8,16,128,128},
+      {8,32,128,256},  {32,128,258,1024}, {32,258,258,4096} };
+
+    const int lengthBase[29] = {
+      3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,
+      67,83,99,115,131,163,195,227,258 };
+    const int lengthExtra[29] = {
+      0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+    const int distBase[30] = {
+      1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,
+      1025,1537,2049,3073,4097,6145,8193,12289,16385,24577 };
+    const int distExtra[30] = {
+      0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+
+    /// Order the code length code lengths are sent in
+    const int clOrder[19] = {
+      16,17,18,0,8,7,9,6,10,5,11,4,12,3,13,2,14,1,15 };
+
+    /// Reverse the low len bits of code, since Huffman codes are sent
+    /// most significant bit first
+    unsigned short reverse(unsigned int code, int len)
+    {
+      unsigned int r = 0;
+      for(int i=0;i<len;i++)
+      {
+        r = (r<<1) | (code&1);
+        code >>= 1;
+      }
+      return (unsigned short)r;
+    }
+
+    /// Canonical Huffman codes (bit reversed) from code lengths
+    void makeCodes(const unsigned char *len, int n, unsigned short *code)
+    {
+      int count[16], next[16];
+      std::fill(count,count+16,0);
+      for(int i=0;i<n;i++) count[len[i]]++;
+      count[0] = 0;
+      int c = 0;
+      for(int bits=1;bits<16;bits++)
+      {
+        c = (c+count[bits-1])<<1;
+        next[bits] = c;
+      }
+      for(int i=0;i<n;i++)
+        code[i] = len[i] ? reverse(next[len[i]]++,len[i]) : 0;
+    }
+
+    /// Take the lightest of the next leaf and the next internal node
+    inline int lightest(const std::vector<unsigned long> &w,
+                        int &leaf, int leaves, int &node, int nodes)
+    {
+      if(leaf<leaves && (node>=nodes || w[leaf]<=w[node]))
+        return leaf++;
+      return node++;
+    }
+
+    /**
+     * Huffman code lengths no longer than limit.  If the tree is too deep
+     * the frequencies are flattened and it is built again.
+     */
+    void buildLengths(const unsigned int *freq, int n, int limit,
+                      unsigned char *len)
+    {
+      std::vector<unsigned int> f(freq,freq+n);
+      for(;;)
+      {
+        std::vector<std::pair<unsigned int,int> > sym;
+        for(int i=0;i<n;i++)
+        {
+          len[i] = 0;
+          if(f[i]) sym.push_back(std::make_pair(f[i],i));
+        }
+        int m = sym.size();
+        if(m==0) return;
+        if(m==1)
+        {
+          len[sym[0].second] = 1;
+          return;
+        }
+        std::sort(sym.begin(),sym.end());
+
+        // Leaves are 0..m-1, in order of weight; internal nodes are made
+        // in order of weight too, so two queues do instead of a heap.
+        std::vector<unsigned long> w(2*m-1);
+        std::vector<int> parent(2*m-1), depth(2*m-1);
+        for(int i=0;i<m;i++) w[i] = sym[i].first;
+        int leaf = 0, node = m;
+        for(int k=m;k<2*m-1;k++)
+        {
+          int a = lightest(w,leaf,m,node,k);
+          int b = lightest(w,leaf,m,node,k);
+          w[k] = w[a]+w[b];
+          parent[a] = parent[b] = k;
+        }
+        depth[2*m-2] = 0;
+        for(int k=2*m-3;k>=0;k--)
+          depth[k] = depth[parent[k]]+1;
+
+        int maxDepth = 0;
+        for(int i=0;i<m;i++)
+        {
+          len[sym[i].second] = depth[i];
+          if(depth[i]>maxDepth) maxDepth = depth[i];
+        }
+        if(maxDepth<=limit) return;
+
+        for(int i=0;i<n;i++)
+          if(f[i]) f[i] = (f[i]>>1) | 1;
+      }
+    }
+
+    /// Lookup tables built once
+    struct Tables
+    {
+      unsigned char lengthCode[MAX_MATCH+1];  // length -> 0..28
+      unsigned char distCode[512];            // see dcode()
+      unsigned char fixedLitLen[288];
+      unsigned short fixedLitCode[288];
+      unsigned char fixedDistLen[30];
+      unsigned short fixedDistCode[30];
+
+      Tables()
+      {
+        for(int c=0;c<29;c++)
+          for(int l=0;l<(1<<lengthExtra[c]);l++)
+            if(lengthBase[c]+l<=MAX_MATCH)
+              lengthCode[lengthBase[c]+l] = c;
+        lengthCode[MAX_MATCH] = 28;
+
+        for(int c=0;c<30;c++)
+          for(int d=0;d<(1<<distExtra[c]);d++)
+          {
+            int dist = distBase[c]+d-1;
+            if(dist<256)
+              distCode[dist] = c;
+            else
+              distCode[256+(dist>>7)] = c;
+          }
+
+        for(int i=0;i<288;i++)
+          fixedLitLen[i] = i<144 ? 8 : i<256 ? 9 : i<280 ? 7 : 8;
+        makeCodes(fixedLitLen,288,fixedLitCode);
+        std::fill(fixedDistLen,fixedDistLen+30,5);
+        makeCodes(fixedDistLen,30,fixedDistCode);
+      }
+
+      /// Distance code, 0..29, of a distance 1..32768
+      inline int dcode(int dist) const
+      {
+        dist--;
+        return dist<256 ? distCode[dist] : distCode[256+(dist>>7)];
+      }
+    };
+
+    const Tables tables;
+  }
+
+  Deflater::Deflater(int level)
+      : window(WIN2), head(HSIZE,-1), prev(WSIZE,-1),
+        strstart(0), lookahead(0), blockStart(0),
+        prevLength(MIN_MATCH-1), prevMatch(0), matchStart(0),
+        matchAvailable(false), bitBuf(0), bitCount(0),
+        totalIn(0), finished(false)
+  {
+    if(level<1) level = 1;
+    if(level>9) level = 9;
+    goodLength = config[level][0];
+    maxLazy    = config[level][1];
+    niceLength = config[level][2];
+    maxChain   = config[level][3];
+    lazy = level>3;
+
+    symLen.reserve(MAX_SYMS);
+    symDist.reserve(MAX_SYMS);
+    std::fill(litFreq,litFreq+286,0);
+    std::fill(distFreq,distFreq+30,0);
+
+    // zlib header: deflate with a 32k window, and a hint of the level
+    int cmf = 0x78;
+    int flg = (level<2 ? 0 : level<6 ? 1 : level==6 ? 2 : 3)<<6;
+    flg += 31-((cmf*256+flg)%31);
+    out += (char)cmf;
+    out += (char)flg;
+  }
+
+  void Deflater::write(const char* buf, unsigned int len)
+    throw(VDrawException)
+  {
+    if(finished)
+      throw VDrawException("Deflater::write() after finish()");
+
+    adler.update(buf,len);
+    totalIn += len;
+    while(len)
+    {
+      int end = strstart+lookahead;
+      if(end==WIN2)
+      {
+        slide();
+        end -= WSIZE;
+      }
+      unsigned int n = WIN2-end;
+      if(n>len) n = len;
+      std::memcpy(&window[end],buf,n);
+      buf += n;
+      len -= n;
+      lookahead += n;
+      process(false);
+    }
+  }
+
+  void Deflater::finish()
+    throw(VDrawException)
+  {
+    if(finished)
+      throw VDrawException("Deflater::finish() called twice");
+
+    process(true);
+    if(matchAvailable)
+    {
+      literal(window[strstart-1]);
+      matchAvailable = false;
+    }
+    flushBlock(true);
+    alignBits();
+
+    unsigned int a = adler.getValue();
+    out += (char)((a>>24)&0xFF);
+    out += (char)((a>>16)&0xFF);
+    out += (char)((a>>8) &0xFF);
+    out += (char)(a      &0xFF);
+    finished = true;
+  }
+
+  int Deflater::insert(int pos)
+  {
+    const unsigned char *p = &window[pos];
+    unsigned int h = ((p[0]<<16) | (p[1]<<8) | p[2]) * 2654435761u;
+    h >>= 32-HBITS;
+    int old = head[h];
+    prev[pos&WMASK] = old;
+    head[h] = pos;
+    return old;
+  }
+
+  int Deflater::longestMatch(int cur, int prevLen)
+  {
+    int chain = maxChain;
+    if(prevLen>=goodLength) chain >>= 2;
+    int maxLen = lookahead<MAX_MATCH ? lookahead : MAX_MATCH;
+    int nice = niceLength<maxLen ? niceLength : maxLen;
+    int best = prevLen;
+    if(best>=maxLen) return best;
+    int limit = strstart>MAX_DIST ? strstart-MAX_DIST : 0;
+
+    const unsigned char *scan = &window[strstart];
+    do
+    {
+      const unsigned char *m = &window[cur];
+      // Check the bytes that decide first
+      if(m[best]!=scan[best] || m[best-1]!=scan[best-1] ||
+         m[0]!=scan[0] || m[1]!=scan[1])
+        continue;
+      int len = 2;
+      while(len<maxLen && m[len]==scan[len]) len++;
+      if(len>best)
+      {
+        matchStart = cur;
+        best = len;
+        if(len>=nice) break;
+      }
+    } while((cur=prev[cur&WMASK])>=limit && --chain!=0);
+
+    return best;
+  }
+
+  void Deflater::process(bool flush)
+  {
+    // Matching needs MAX_MATCH bytes after strstart, so until the end of
+    // the input some are always kept for the next write().
+    int minLookahead = flush ? 0 : MIN_LOOKAHEAD;
+    if(!lazy)
+    {
+      processFast(minLookahead);
+      return;
+    }
+    while(lookahead>minLookahead)
+    {
+      int hashHead = lookahead>=MIN_MATCH ? insert(strstart) : -1;
+
+      // Find a match here, then only use the previous one if it is not
+      // shorter (lazy evaluation)
+      int curLen = MIN_MATCH-1;
+      int curMatch = 0;
+      if(hashHead>=0 && prevLength<maxLazy && strstart-hashHead<=MAX_DIST)
+      {
+        curLen = longestMatch(hashHead,prevLength);
+        curMatch = matchStart;
+        if(curLen==MIN_MATCH && strstart-curMatch>TOO_FAR)
+          curLen = MIN_MATCH-1;
+      }
+
+      if(prevLength>=MIN_MATCH && curLen<=prevLength)
+      {
+        int maxInsert = strstart+lookahead-MIN_MATCH;
+        match(prevLength,strstart-1-prevMatch);
+
+        // strstart-1 starts the match and strstart is hashed already
+        lookahead -= prevLength-1;
+        for(int n=prevLength-2;n>0;n--)
+          if(++strstart<=maxInsert) insert(strstart);
+        strstart++;
+        matchAvailable = false;
+        prevLength = MIN_MATCH-1;
+      }
+      else
+      {
+        if(matchAvailable)
+          literal(window[strstart-1]);
+        matchAvailable = true;
+        prevLength = curLen;
+        prevMatch = curMatch;
+        strstart++;
+        lookahead--;
+      }
+
+      if(symLen.size()>=MAX_SYMS)
+        flushBlock(false);
+    }
+  }
+
+  void Deflater::processFast(int minLookahead)
+  {
+    // Take each match as it is found, and don't hash the inside of long
+    // ones (maxLazy is the longest that is hashed here)
+    while(lookahead>minLookahead)
+    {
+      int hashHead = lookahead>=MIN_MATCH ? insert(strstart) : -1;
+      int len = 0;
+      if(hashHead>=0 && strstart-hashHead<=MAX_DIST)
+        len = longestMatch(hashHead,MIN_MATCH-1);
+
+      if(len>=MIN_MATCH)
+      {
+        match(len,strstart-matchStart);
+        lookahead -= len;
+        if(len<=maxLazy && lookahead>=MIN_MATCH)
+        {
+          while(--len>0)
+            insert(++strstart);
+          strstart++;
+        }
+        else
+          strstart += len;
+      }
+      else
+      {
+        literal(window[strstart]);
+        strstart++;
+        lookahead--;
+      }
+
+      if(symLen.size()>=MAX_SYMS)
+        flushBlock(false);
+    }
+  }
+
+  void Deflater::slide()
+  {
+    // The block must be coded while its bytes are in the window, in case
+    // it is better stored.
+    flushBlock(false);
+
+    std::memcpy(&window[0],&window[WSIZE],WSIZE);
+    strstart -= WSIZE;
+    blockStart -= WSIZE;
+    prevMatch -= WSIZE;
+    for(int i=0;i<HSIZE;i++)
+      head[i] = head[i]>=WSIZE ? head[i]-WSIZE : -1;
+    for(int i=0;i<WSIZE;i++)
+      prev[i] = prev[i]>=WSIZE ? prev[i]-WSIZE : -1;
+  }
+
+  void Deflater::literal(unsigned char c)
+  {
+    symLen.push_back(c);
+    symDist.push_back(0);
+    litFreq[c]++;
+  }
+
+  void Deflater::match(int len, int dist)
+  {
+    symLen.push_back(len);
+    symDist.push_back(dist);
+    litFreq[257+tables.lengthCode[len]]++;
+    distFreq[tables.dcode(dist)]++;
+  }
+
+  void Deflater::alignBits()
+  {
+    if(bitCount>0)
+      out += (char)(bitBuf&0xFF);
+    bitBuf = 0;
+    bitCount = 0;
+  }
+
+  void Deflater::flushBlock(bool last)
+  {
+    int blockEnd = strstart-(matchAvailable?1:0);
+    if(!last && symLen.empty() && blockEnd==blockStart)
+      return;
+
+    litFreq[256] = 1;   // End of block
+
+    // Bits of the block with each coding; the extra bits of lengths and
+    // distances are the same for both Huffman codings
+    unsigned long extra = 0;
+    for(int i=0;i<29;i++)
+      extra += (unsigned long)litFreq[257+i]*lengthExtra[i];
+    for(int i=0;i<30;i++)
+      extra += (unsigned long)distFreq[i]*distExtra[i];
+
+    unsigned long fixedBits = 3+extra;
+    for(int i=0;i<286;i++)
+      fixedBits += (unsigned long)litFreq[i]*tables.fixedLitLen[i];
+    for(int i=0;i<30;i++)
+      fixedBits += (unsigned long)distFreq[i]*5;
+
+    // Dynamic codes.  At least two codes in each tree keep every decoder
+    // happy.
+    unsigned int lf[286], df[30];
+    std::copy(litFreq,litFreq+286,lf);
+    std::copy(distFreq,distFreq+30,df);
+    int nl=0, nd=0;
+    for(int i=0;i<286;i++) if(lf[i]) nl++;
+    for(int i=0;i<30;i++) if(df[i]) nd++;
+    if(nl<2) lf[lf[0]?1:0] = 1;
+    if(nd<2)
+    {
+      if(!df[0]) df[0] = 1;
+      else df[1] = 1;
+    }
+    unsigned char llen[286], dlen[30];
+    unsigned short lcode[286], dcode[30];
+    buildLengths(lf,286,15,llen);
+    buildLengths(df,30,15,dlen);
+    makeCodes(llen,286,lcode);
+    makeCodes(dlen,30,dcode);
+
+    int hlit = 286, hdist = 30;
+    while(hlit>257 && llen[hlit-1]==0) hlit--;
+    while(hdist>1 && dlen[hdist-1]==0) hdist--;
+
+    // Run length code the code lengths, as (code, extra) pairs
+    unsigned char lens[286+30];
+    std::copy(llen,llen+hlit,lens);
+    std::copy(dlen,dlen+hdist,lens+hlit);
+    int nlens = hlit+hdist;
+    std::vector<std::pair<int,int> > rle;
+    unsigned int clFreq[19];
+    std::fill(clFreq,clFreq+19,0);
+    for(int i=0;i<nlens;)
+    {
+      int l = lens[i];
+      int run = 1;
+      while(i+run<nlens && lens[i+run]==l) run++;
+      i += run;
+      if(l==0)
+      {
+        while(run>=11)
+        {
+          int r = run<138 ? run : 138;
+          rle.push_back(std::make_pair(18,r-11));
+          run -= r;
+        }
+        if(run>=3)
+        {
+          rle.push_back(std::make_pair(17,run-3));
+          run = 0;
+        }
+      }
+      else
+      {
+        rle.push_back(std::make_pair(l,0));
+        run--;
+        while(run>=3)
+        {
+          int r = run<6 ? run : 6;
+          rle.push_back(std::make_pair(16,r-3));
+          run -= r;
+        }
+      }
+      for(;run>0;run--)
+        rle.push_back(std::make_pair(l,0));
+    }
+    for(size_t i=0;i<rle.size();i++)
+      clFreq[rle[i].first]++;
+
+    unsigned char clLen[19];
+    unsigned short clCode[19];
+    buildLengths(clFreq,19,7,clLen);
+    makeCodes(clLen,19,clCode);
+    int hclen = 19;
+    while(hclen>4 && clLen[clOrder[hclen-1]]==0) hclen--;
+
+    unsigned long dynBits = 3+5+5+4+3*hclen+extra;
+    for(size_t i=0;i<rle.size();i++)
+    {
+      int c = rle[i].first;
+      dynBits += clLen[c] + (c==16 ? 2 : c==17 ? 3 : c==18 ? 7 : 0);
+    }
+    for(int i=0;i<286;i++)
+      dynBits += (unsigned long)litFreq[i]*llen[i];
+    for(int i=0;i<30;i++)
+      dynBits += (unsigned long)distFreq[i]*dlen[i];
+
+    unsigned long storedLen = blockEnd-blockStart;
+    unsigned long storedBits = 8*storedLen+7+(3+32)*(storedLen/65535+1);
+
+    if(storedBits<=fixedBits && storedBits<=dynBits)
+    {
+      putStored(last);
+    }
+    else if(fixedBits<=dynBits)
+    {
+      putBits(last?3:2,3);    // BFINAL, BTYPE=01
+      putSymbols(tables.fixedLitCode,tables.fixedLitLen,
+                 tables.fixedDistCode,tables.fixedDistLen);
+    }
+    else
+    {
+      putBits(last?5:4,3);    // BFINAL, BTYPE=10
+      putBits(hlit-257,5);
+      putBits(hdist-1,5);
+      putBits(hclen-4,4);
+      for(int i=0;i<hclen;i++)
+        putBits(clLen[clOrder[i]],3);
+      for(size_t i=0;i<rle.size();i++)
+      {
+        int c = rle[i].first;
+        putBits(clCode[c],clLen[c]);
+        if(c==16) putBits(rle[i].second,2);
+        else if(c==17) putBits(rle[i].second,3);
+        else if(c==18) putBits(rle[i].second,7);
+      }
+      putSymbols(lcode,llen,dcode,dlen);
+    }
+
+    symLen.clear();
+    symDist.clear();
+    std::fill(litFreq,litFreq+286,0);
+    std::fill(distFreq,distFreq+30,0);
+    blockStart = blockEnd;
+  }
+
+  void Deflater::putSymbols(const unsigned short *lcode,
+                            const unsigned char *llen,
+                            const unsigned short *dcode,
+                            const unsigned char *dlen)
+  {
+    for(size_t i=0;i<symLen.size();i++)
+    {
+      int dist = symDist[i];
+      if(dist==0)
+      {
+        int c = symLen[i];
+        putBits(lcode[c],llen[c]);
+      }
+      else
+      {
+        int len = symLen[i];
+        int c = tables.lengthCode[len];
+        putBits(lcode[257+c],llen[257+c]);
+        if(lengthExtra[c]) putBits(len-lengthBase[c],lengthExtra[c]);
+        c = tables.dcode(dist);
+        putBits(dcode[c],dlen[c]);
+        if(distExtra[c]) putBits(dist-distBase[c],distExtra[c]);
+      }
+    }
+    putBits(lcode[256],llen[256]);
+  }
+
+  void Deflater::putStored(bool last)
+  {
+    int pos = blockStart;
+    int len = strstart-(matchAvailable?1:0)-blockStart;
+    do
+    {
+      int n = len<65535 ? len : 65535;
+      len -= n;
+      putBits((last && len==0) ? 1 : 0,3);   // BFINAL, BTYPE=00
+      alignBits();
+      out += (char)(n&0xFF);
+      out += (char)((n>>8)&0xFF);
+      out += (char)(~n&0xFF);
+      out += (char)((~n>>8)&0xFF);
+      out.append((const char*)&window[pos],n);
+      pos += n;
+    } while(len>0);
+  }
+
+} // namespace vdraw
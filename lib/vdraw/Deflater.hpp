@@ -0,0 +1,225 @@
+#pragma ident "$Id:$"
+
+/// @file Deflater.hpp Streaming zlib (deflate) compressor. Class declarations.
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+
+#ifndef VDRAW_DEFLATER_H
+#define VDRAW_DEFLATER_H
+
+#include <string>
+#include <vector>
+
+#include "Adler32.hpp"
+#include "VDrawException.hpp"
+
+// RFC 1950 (zlib) and RFC 1951 (deflate)
+
+namespace vdraw
+{
+  /** \addtogroup BasicVectorGraphics */
+  //@{
+
+  /**
+   * This class compresses a stream of bytes into a zlib stream.
+   *
+   * Input is given in pieces of any size with write(). It goes through a
+   * 32k sliding window (LZ77 with hash chains, and lazy matching from
+   * level 4 up, as in zlib), and the resulting symbols are coded in
+   * blocks. Each block is written with
+   * whichever of the stored, fixed Huffman or dynamic Huffman codings is
+   * the smallest, so incompressible data grows by only a few bytes.
+   *
+   * The compressed bytes pile up in an output buffer that the caller should
+   * drain as it goes; memory use does not depend on the length of the input.
+   *
+   * \code
+   * Deflater d;
+   * while(...)
+   * {
+   *   d.write(buf,len);
+   *   out << d.getOutput();
+   *   d.clearOutput();
+   * }
+   * d.finish();
+   * out << d.getOutput();
+   * \endcode
+   */
+  class Deflater
+  {
+    public:
+      /**
+       * Constructor.
+       * @param level Compression level, from 1 (fastest) to 9 (smallest).
+       */
+      Deflater(int level=6);
+
+      /**
+       * Compress some bytes.
+       * @param buf The bytes to compress
+       * @param len The number of bytes
+       */
+      void write(const char* buf, unsigned int len)
+        throw(VDrawException);
+
+      /**
+       * Compress a string.
+       * @param str The string to compress
+       */
+      void write(const std::string &str)
+        throw(VDrawException)
+      {
+        write(str.data(),str.length());
+      }
+
+      /**
+       * Compress everything still buffered and end the zlib stream.  Nothing
+       * may be written after this.
+       */
+      void finish()
+        throw(VDrawException);
+
+      /// Compressed bytes that haven't been cleared yet.
+      inline const std::string& getOutput() const { return out; }
+
+      /// Forget the compressed bytes, once they have been used.
+      inline void clearOutput() { out.erase(); }
+
+      /// Number of bytes given to write() so far.
+      inline unsigned long getTotalIn() const { return totalIn; }
+
+    protected:
+      /// Code the symbols collected so far as one block.
+      void flushBlock(bool last);
+
+      /// Run the matcher over the window, leaving lookahead for matching.
+      void process(bool flush);
+
+      /// The same without lazy matching, for the fast levels
+      void processFast(int minLookahead);
+
+      /// Move the upper half of the window down.
+      void slide();
+
+      /// Insert the string at pos into the hash chains. Returns the old head.
+      int insert(int pos);
+
+      /// Find the longest match for the string at strstart.
+      int longestMatch(int cur, int prevLen);
+
+      /// Record a literal byte.
+      void literal(unsigned char c);
+
+      /// Record a match.
+      void match(int len, int dist);
+
+      /// Append the low n bits of v to the output, least significant first.
+      inline void putBits(unsigned int v, int n)
+      {
+        bitBuf |= (unsigned long)v << bitCount;
+        bitCount += n;
+        while(bitCount>=8)
+        {
+          out += (char)(bitBuf&0xFF);
+          bitBuf >>= 8;
+          bitCount -= 8;
+        }
+      }
+
+      /// Pad the output to a byte boundary.
+      void alignBits();
+
+      /// Write the collected symbols using the given codes.
+      void putSymbols(const unsigned short *lcode, const unsigned char *llen,
+                      const unsigned short *dcode, const unsigned char *dlen);
+
+      /// Write the block as stored (uncompressed) blocks.
+      void putStored(bool last);
+
+      /// Window of input, twice the largest match distance.
+      std::vector<unsigned char> window;
+
+      /// Most recent position of each hash value, -1 for none.
+      std::vector<int> head;
+
+      /// Previous position with the same hash, by position in the window.
+      std::vector<int> prev;
+
+      /// Window position being matched
+      int strstart;
+
+      /// Bytes at and after strstart
+      int lookahead;
+
+      /// Start of the current block in the window
+      int blockStart;
+
+      /// Match found at the previous position (lazy matching)
+      int prevLength;
+      int prevMatch;
+
+      /// Start of the last match found by longestMatch()
+      int matchStart;
+
+      /// True if the byte before strstart is still to be coded
+      bool matchAvailable;
+
+      /// @name Tuning, from the compression level
+      //@{
+      int maxChain;
+      int maxLazy;
+      int goodLength;
+      int niceLength;
+      bool lazy;
+      //@}
+
+      /// Symbols of the current block: literal or length, and distance
+      /// (0 for a literal)
+      std::vector<unsigned short> symLen;
+      std::vector<unsigned short> symDist;
+
+      /// Symbol frequencies of the current block
+      unsigned int litFreq[286];
+      unsigned int distFreq[30];
+
+      /// Compressed bytes
+      std::string out;
+
+      /// Bits not yet in a whole byte of output
+      unsigned long bitBuf;
+      int bitCount;
+
+      /// Checksum of the input
+      Adler32 adler;
+
+      unsigned long totalIn;
+      bool finished;
+
+  }; // class Deflater
+
+  //@}
+
+} // namespace vdraw
+
+#endif //VDRAW_DEFLATER_H
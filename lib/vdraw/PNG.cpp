@@ -26,22 +26,32 @@
 
 #include "PNG.hpp"
 #include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
 
 namespace vdraw
 {
-  const std::string PNG::header = "\211PNG\r\n\032\n";
+  const int PNG::defaultLevel;
 
   std::string PNG::png(const Bitmap &b)
+  {
+    std::ostringstream s;
+    png(s,b);
+    return s.str();
+  }
+
+  void PNG::png(std::ostream &o, const Bitmap &b)
   {
     InterpolatedColorMap icm;
     ColorMap cm;
     if(b.getICM(&icm))
     {
-      return *png(icm,b.osr,b.osc);
+      png(o,icm,b.osr,b.osc);
     }
     else if(b.getCM(&cm))
     {
-      return *png(cm,b.osr,b.osc); 
+      png(o,cm,b.osr,b.osc); 
     }
     else
     { 
@@ -52,29 +62,72 @@ namespace vdraw
 
   PNG::string_ptr PNG::png(const ColorMap &c, int osr, int osc)
   {
-    std::stringstream s;
-    s << header 
-      << *ihdr_full(c.getCols()*osc,c.getRows()*osr)
-      << *srgb() 
-      //<< phys()
-      << *idat(c,osr,osc)
-      << *iend();
+    std::ostringstream s;
+    png(s,c,osr,osc);
     return string_ptr(new std::string(s.str()));
   }
 
+  void PNG::png(std::ostream &o, const ColorMap &c, int osr, int osc,
+                int level)
+  {
+    // For oversampling, we make a row buffer and repeat it as necessary
+    // to create the image.
+    int cols = c.getCols()*osc;
+    PNGWriter w(o,cols,c.getRows()*osr,level);
+    std::vector<unsigned char> r(3*cols);
+    for(int row=0; row<c.getRows(); row++)
+    {
+      int x = 0;
+      for(int col=0; col<c.getCols(); col++)
+      {
+        unsigned int l = c.get(row,col).getRGB();
+        for(int cc=0; cc<osc; cc++)
+        {
+          r[x++] = (l>>16)&0xFF;
+          r[x++] = (l>>8) &0xFF;
+          r[x++] = l      &0xFF;
+        }
+      }
+      for(int rr=0; rr<osr; rr++)
+        w.writeRow(&r[0]);
+    }
+    w.close();
+  }
+
   PNG::string_ptr PNG::png(const InterpolatedColorMap &c, int osr, int osc)
   {
-    std::stringstream s;
-    s << header 
-      << *ihdr_indexed(c.getCols()*osc,c.getRows()*osr)
-      << *srgb() 
-      //<< phys()
-      << *plte(c)
-      << *idat(c,osr,osc)
-      << *iend();
+    std::ostringstream s;
+    png(s,c,osr,osc);
     return string_ptr(new std::string(s.str()));
   }
 
+  void PNG::png(std::ostream &o, const InterpolatedColorMap &c,
+                int osr, int osc, int level)
+  {
+    // TODO Smaller palette on request?
+    Palette p = c.getPalette();
+    std::vector<Color> plte(256);
+    for(int i=0;i<256;i++)
+      plte[i] = p.getColor(i/256.0);
+
+    int cols = c.getCols()*osc;
+    PNGWriter w(o,cols,c.getRows()*osr,plte,level);
+    std::vector<unsigned char> r(cols);
+    for(int row=0; row<c.getRows(); row++)
+    {
+      int x = 0;
+      for(int col=0; col<c.getCols(); col++)
+      {
+        unsigned char t = ((int)(c.getIndex(row,col)*255))&0xFF;
+        for(int cc=0; cc<osc; cc++) 
+          r[x++] = t;
+      }
+      for(int rr=0; rr<osr; rr++) 
+        w.writeRow(&r[0]);
+    }
+    w.close();
+  }
+
   /*
    * TODO Future ideas for optimization
    * -- Indexed Color Map 
@@ -131,269 +184,15 @@ namespace vdraw
 
   int PNG::cost_idat(int stream)
   {
+    // The Deflater never codes a block bigger than it would be stored, and
+    // its blocks hold at least 16k bytes except for the last one before
+    // each slide of the window and at the end.
     int i = stream;
-    // Huffman bits, 5 per 0xFFFF and 5 for whats left
-    i += 5*(stream>>16 + (stream&0xFFFF?1:0));
+    i += 6*(2*(stream>>14) + 2); // Stored block headers, at worst
     i += 4; // Adler-32 checksum
     i += 2; // zlib bytes
-    i += 12*(stream/0x2000 + (stream%0x2000?1:0)); //Chunk bits (if split)
+    i += 12*((i>>15) + 1);  // Chunk bits, 32k or more per IDAT
     return i;
   }
 
-  PNG::string_ptr PNG::ihdr_full(int width, int height)
-  {
-    std::stringstream s;
-    s << *itos(width)  // width              -- 4 bytes
-      << *itos(height) // height             -- 4 bytes
-      << btoc(8)      // bit depth          -- 1 byte
-      << btoc(2)      // color type         -- 1 byte -- Truecolor
-      << btoc(0)      // compression method -- 1 byte
-      << btoc(0)      // filter method      -- 1 byte
-      << btoc(0);     // interlace method   -- 1 byte
-    return chunk("IHDR",s.str());
-  }
-
-  PNG::string_ptr PNG::ihdr_indexed(int width, int height)
-  {
-    std::stringstream s;
-    s << *itos(width)  // width              -- 4 bytes
-      << *itos(height) // height             -- 4 bytes
-      << btoc(8)      // bit depth          -- 1 byte
-      << btoc(3)      // color type         -- 1 byte -- Interpolated
-      << btoc(0)      // compression method -- 1 byte
-      << btoc(0)      // filter method      -- 1 byte
-      << btoc(0);     // interlace method   -- 1 byte
-    return chunk("IHDR",s.str());
-  }
-
-
-  PNG::string_ptr PNG::srgb()
-  {
-    std::stringstream s;
-    s << btoc(0);     // We want the colors to look good
-    return chunk("sRGB",s.str());
-  }
-
-  PNG::string_ptr PNG::phys()
-  {
-    std::stringstream s;
-    s << *itos(1)  // Pixels per unit x axis
-      << *itos(1)  // Pixels per unit y axis
-      << btoc(1); // We know the unit
-    return chunk("pHYs",s.str());
-  }
-
-  PNG::string_ptr PNG::plte(const InterpolatedColorMap &c)
-  {
-    // TODO Smaller palette on request?
-    Palette p = c.getPalette();
-    std::stringstream s;
-    for(int i=0;i<256;i++)
-      s << *ctos(p.getColor(i/256.0));
-    return chunk("PLTE",s.str());
-  }
-
-  /*
-   * ZLIB flag information
-   * First two bytes:
-   * +-----+-----+
-   * | CMP | FLG |
-   * +-----+-----+
-   * CMP:
-   *  - Bits 0-3 = 0x08 (deflate compression)
-   *  - Bits 4-7 = For CM = 8, CINFO is the base-2 logarithm 
-   *    of the LZ77 window size, minus eight
-   *
-   */
-
-  PNG::string_ptr PNG::idat(const InterpolatedColorMap &c, int osr, int osc)
-  {
-    std::stringstream s;
-    string_ptr tmp = data(c,osr,osc);
-    unsigned int a = alder(tmp);
-    s << *huff(*tmp)
-      << *itos(a);
-    tmp = string_ptr(new std::string(s.str()));
-    return split(*prefix(*tmp));
-  }
-
-  PNG::string_ptr PNG::idat(const ColorMap &c, int osr, int osc)
-  {
-    std::stringstream s;
-    string_ptr tmp = data(c,osr,osc);
-    unsigned int a = alder(tmp);
-    s << *huff(*tmp)
-      << *itos(a);
-    tmp = string_ptr(new std::string(s.str()));
-    return split(*prefix(*tmp));
-  }
-
-  PNG::string_ptr PNG::split(const std::string &str)
-  {
-    std::stringstream s;
-    int len = str.size();
-    int pos = 0;
-    do
-    {
-      //printf("split() :: len=%08x pos=%08x \n",len,pos);
-      int dist=0;
-      if(len>0x02000)
-        dist = 0x02000;
-      else
-        dist = len;
-      len -= dist;
-
-      s << *chunk("IDAT",str.substr(pos,dist));
-
-      pos += dist;
-    } while(len);
-    return string_ptr(new std::string(s.str()));            
-  }
-
-  PNG::string_ptr PNG::prefix(const std::string &str)
-  {
-    // TODO There are limits to IDAT length...check and split
-    int len = str.size();
-    int cmp = (int)(log((double)len)/log(2.0))-8;
-    if(cmp<0) cmp = 0;
-    else if(cmp>7) cmp = 7;
-    cmp = (cmp<<4) | 0x08;
-    int flg = 0;
-    int tmp = (cmp*256+flg)%31;
-    if(tmp!=0) flg += 31-tmp;
-    std::stringstream s;
-    // TODO ZLIB data stream...? Adler-32
-    s << btoc(cmp)          // See CMP notes above
-      << btoc(flg)          // Flag
-      << str;
-    return string_ptr(new std::string(s.str()));            
-  }
-
-  PNG::string_ptr PNG::huff(const std::string &str)
-  {
-    // Add huff information
-    std::stringstream s;
-    int len = str.size();
-    int pos = 0;
-    do
-    {
-      //printf("huff() :: len=%08x pos=%08x\n",len,pos);          
-      int dist=0;
-      if(len>0x0FFFF)
-        dist = 0x0FFFF;
-      else
-        dist = len;
-      len -= dist;
-
-      // These go backwards
-      s << btoc((len?0x00:0x01)) // Set final bit on last block
-        << btoc(dist) 
-        << btoc(dist>>8)
-        << btoc(~dist)
-        << btoc((~dist)>>8)
-        << str.substr(pos,dist);
-
-      pos += dist;
-    } while(len);
-    return string_ptr(new std::string(s.str()));            
-  }
-
-  PNG::string_ptr PNG::data(const ColorMap &c, int osr, int osc)
-  {
-    // For oversampling, we make a row buffer and a column one and repeat as
-    // necessary to create the image.
-    std::stringstream s;
-    for(int row=0; row<c.getRows(); row++)
-    {
-      std::stringstream r;
-      r << btoc(0x00);   // Filter method 0 (identity)
-      for(int col=0; col<c.getCols(); col++)
-      {
-        string_ptr t = ctos(c.get(row,col));
-        for(int cc=0; cc<osc; cc++) 
-          r << *t;
-      }
-      std::string rstr = r.str();
-      for(int rr=0; rr<osr; rr++) 
-        s << rstr;
-    }
-    return string_ptr(new std::string(s.str()));            
-  }
-
-  PNG::string_ptr PNG::data(const InterpolatedColorMap &c, int osr, int osc)
-  {
-    // For oversampling, we make a row buffer and a column one and repeat as
-    // necessary to create the image.
-    std::stringstream s;
-    for(int row=0; row<c.getRows(); row++)
-    {
-      std::stringstream r;
-      r << btoc(0x00);   // Filter method 0 (no filter)
-      for(int col=0; col<c.getCols(); col++)
-      {
-        char t = btoc((int)(c.getIndex(row,col)*255));
-        for(int cc=0; cc<osc; cc++) 
-          r << t;
-      }
-      std::string rstr = r.str();      
-      for(int rr=0; rr<osr; rr++) 
-        s << rstr;
-    }
-    return string_ptr(new std::string(s.str()));            
-  }
-
-
-  unsigned int PNG::alder(const PNG::string_ptr &str)
-  {
-    Adler32 a;
-    a.update(str);
-    return a.getValue();
-  }
-
-  PNG::string_ptr PNG::iend()
-  {
-    return chunk("IEND","");
-  }
-
-  PNG::string_ptr PNG::chunk(const std::string &title, const std::string &text)
-  {
-    CRC32 c;
-    c.update(title);
-    c.update(text);
-    std::stringstream s;
-    s << *itos(text.length())
-      << title
-      << text
-      << *itos(c.getValue());
-    return string_ptr(new std::string(s.str()));    
-  }
-
-  PNG::string_ptr PNG::itos(int i)
-  {
-    std::stringstream s;
-    s << btoc((i>>24)&0x000000FF)
-      << btoc((i>>16)&0x000000FF)
-      << btoc((i>>8) &0x000000FF)
-      << btoc(i      &0x000000FF);
-    return string_ptr(new std::string(s.str()));        
-  }
-
-  PNG::string_ptr PNG::ctos(const Color &color)
-  {
-    unsigned int l = color.getRGB();
-    std::stringstream s;
-    s << btoc((l>>16)&0x000000FF)
-      << btoc((l>>8) &0x000000FF)
-      << btoc(l      &0x000000FF);
-    return string_ptr(new std::string(s.str()));            
-  }
-
-
-  char PNG::btoc(int b)
-  {
-    return (char)(b&0x000000FF);
-  }
-
 } // namespace vdraw
-
-
@@ -29,8 +29,7 @@
 #define VDRAW_PNG_H
 
 #include<string>
-#include<sstream>
-#include<cmath>
+#include<ostream>
 #include<memory>
 
 #include "Bitmap.hpp"
@@ -38,8 +37,7 @@
 #include "ColorMap.hpp"
 #include "InterpolatedColorMap.hpp"
 #include "Palette.hpp"
-#include "CRC32.hpp"
-#include "Adler32.hpp"
+#include "PNGWriter.hpp"
 
 namespace vdraw
 {
@@ -48,6 +46,10 @@ namespace vdraw
 
   /**
    * Used to create PNG Images.
+   *
+   * The images are compressed with a Deflater and written out by a
+   * PNGWriter one row at a time.  The functions writing to a stream never
+   * hold the whole image in memory.
    */
   class PNG
   {
@@ -55,6 +57,10 @@ namespace vdraw
       /// Typedef of string pointer using auto_ptr
       typedef std::auto_ptr<std::string> string_ptr;
 
+      /// Compression level used unless another is given.  Plots are
+      /// mostly flat areas, so the fast levels lose little size.
+      static const int defaultLevel = 2;
+
       /**
        * Get a string representing the contents of a PNG file using a Bitmap.
        * This is a helper function to call the others.
@@ -62,104 +68,62 @@ namespace vdraw
       static std::string png(const Bitmap &b);
 
       /**
-       * Get a string representing the contents of a PNG file using an indexed
+       * Write a PNG file using a Bitmap.
+       */
+      static void png(std::ostream &o, const Bitmap &b);
+
+      /**
+       * Get a string representing the contents of a PNG file using a full
        * color map.
        */
       static string_ptr png(const ColorMap &c, int osr=1, int osc=1);
 
+      /**
+       * Write a PNG file using a full color map.
+       * @param o Stream to write to, opened in binary mode
+       * @param c The colors
+       * @param osr Times to repeat each row (oversampling)
+       * @param osc Times to repeat each column (oversampling)
+       * @param level Compression level, 1 (fastest) to 9 (smallest)
+       */
+      static void png(std::ostream &o, const ColorMap &c,
+                      int osr=1, int osc=1, int level=defaultLevel);
+
       /**
        * Get a string representing the contents of a PNG file using an indexed
        * color map.
        */
       static string_ptr png(const InterpolatedColorMap &c, int osr=1, int osc=1);
 
-      /// Get the byte cost of an indexed PNG
+      /**
+       * Write a PNG file using an indexed color map.
+       * @param o Stream to write to, opened in binary mode
+       * @param c The colors
+       * @param osr Times to repeat each row (oversampling)
+       * @param osc Times to repeat each column (oversampling)
+       * @param level Compression level, 1 (fastest) to 9 (smallest)
+       */
+      static void png(std::ostream &o, const InterpolatedColorMap &c,
+                      int osr=1, int osc=1, int level=defaultLevel);
+
+      /// Get the byte cost of an indexed PNG.  This is an upper bound; the
+      /// image is usually much smaller once compressed.
       /// Returns -1 if the bitmap doesn't have an Indexed/InterpolatedColorMap
       static int cost_indexed(const Bitmap& b);
 
-      /// Get the byte cost of an indexed PNG with numcol colors
+      /// Get the byte cost of an indexed PNG with numcol colors (upper bound)
       static int cost_indexed(int rows, int cols, int numcol);
 
-      /// Get the byte cost of a non-indexed PNG
+      /// Get the byte cost of a non-indexed PNG (upper bound)
       static int cost_constant(const Bitmap& b);
 
-      /// Get the byte cost of a non-indexed PNG
+      /// Get the byte cost of a non-indexed PNG (upper bound)
       static int cost_constant(int rows, int cols);
 
     protected:
-      /// PNG file format header bytes 
-      static const std::string header;
-
-      /// Get the cost for IDAT chunks for a stream of this length
+      /// Get the most the IDAT chunks can take for a stream of this length
       static int cost_idat(int stream);
 
-      /// IHDR Chunk for full color maps
-      static string_ptr ihdr_full(int width, int height);
-
-      /// IHDR Chunk for indexed color maps
-      static string_ptr ihdr_indexed(int width, int height);
-
-      /// sRGB Chunk for telling the PNG renderer to keep the colors pretty
-      static string_ptr srgb();
-
-      /// pHYs Chunk for telling the PNG renderer pixel width/height
-      static string_ptr phys();
-
-      /// PLTE Chunk for listing the indexed colors
-      static string_ptr plte(const InterpolatedColorMap &c);
-
-      /*
-       * ZLIB flag information
-       * First two bytes:
-       * +-----+-----+
-       * | CMP | FLG |
-       * +-----+-----+
-       * CMP:
-       *  - Bits 0-3 = 0x08 (deflate compression)
-       *  - Bits 4-7 = For CM = 8, CINFO is the base-2 logarithm 
-       *    of the LZ77 window size, minus eight
-       *
-       */
-
-      /// IDAT Chunk for an indexed color map
-      static string_ptr idat(const InterpolatedColorMap &c, int osr, int osc);
-
-      /// IDAT Chunk for a full color map      
-      static string_ptr idat(const ColorMap &c, int osr, int osc);
-
-      /// Split up IDAT Chunk to multiple chunks if too large
-      static string_ptr split(const std::string &str);
-
-      /// Add the IDAT prefix bytes for the zlib stream
-      static string_ptr prefix(const std::string &str);
-
-      /// Add the segment bits for the huffman format (non compressed)
-      static string_ptr huff(const std::string &str);
-
-      /// Get the color data for a full color map
-      static string_ptr data(const ColorMap &c, int osr, int osc);
-
-      /// Get the color data for an indexed color map      
-      static string_ptr data(const InterpolatedColorMap &c, int osr, int osc);
-
-      /// Get the alder32 checksum for a string
-      static unsigned int alder(const string_ptr &str);
-
-      /// IEND Chunk required at end of PNG
-      static string_ptr iend();
-
-      /// Add chunk bits (length, checksum) before and after chunk bytes
-      static string_ptr chunk(const std::string &title, const std::string &text);
-
-      /// Integer to string of 4 bytes
-      static string_ptr itos(int i);
-
-      /// Color to string of 3 bytes
-      static string_ptr ctos(const Color &color);
-
-      /// Byte to single character
-      static char btoc(int b);
-
   }; // class PNG
 
   //@}
@@ -0,0 +1,216 @@
+#pragma ident "$Id:$"
+
+/// @file PNGWriter.cpp Write PNG images a row at a time. Class definitions.
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "PNGWriter.hpp"
+#include "CRC32.hpp"
+
+namespace vdraw
+{
+  namespace
+  {
+    /// Compressed bytes to collect before writing an IDAT chunk
+    const unsigned int IDAT_SIZE = 0x8000;
+
+    /// Integer to 4 bytes, most significant first
+    void putInt(char *buf, unsigned int i)
+    {
+      buf[0] = (char)((i>>24)&0xFF);
+      buf[1] = (char)((i>>16)&0xFF);
+      buf[2] = (char)((i>>8) &0xFF);
+      buf[3] = (char)(i      &0xFF);
+    }
+
+    /// Paeth predictor from the PNG specification
+    inline int paeth(int a, int b, int c)
+    {
+      int p = a+b-c;
+      int pa = std::abs(p-a), pb = std::abs(p-b), pc = std::abs(p-c);
+      if(pa<=pb && pa<=pc) return a;
+      if(pb<=pc) return b;
+      return c;
+    }
+  }
+
+  PNGWriter::PNGWriter(std::ostream &o, int w, int h, int level)
+    throw(VDrawException)
+      : ostr(o), width(w), height(h), bpp(3), rows(0),
+        indexed(false), closed(false), deflater(level)
+  {
+    start(2);   // Truecolor
+  }
+
+  PNGWriter::PNGWriter(std::ostream &o, int w, int h,
+                       const std::vector<Color> &palette, int level)
+    throw(VDrawException)
+      : ostr(o), width(w), height(h), bpp(1), rows(0),
+        indexed(true), closed(false), deflater(level)
+  {
+    if(palette.empty() || palette.size()>256)
+      throw VDrawException("PNGWriter: the palette must have 1 to 256 colors");
+
+    start(3);   // Indexed
+
+    std::string plte;
+    for(size_t i=0;i<palette.size();i++)
+    {
+      unsigned int l = palette[i].getRGB();
+      plte += (char)((l>>16)&0xFF);
+      plte += (char)((l>>8) &0xFF);
+      plte += (char)(l      &0xFF);
+    }
+    chunk("PLTE",plte.data(),plte.size());
+  }
+
+  void PNGWriter::start(int colorType)
+  {
+    if(width<=0 || height<=0)
+      throw VDrawException("PNGWriter: the image must not be empty");
+
+    ostr.write("\211PNG\r\n\032\n",8);
+
+    char ihdr[13];
+    putInt(ihdr,width);
+    putInt(ihdr+4,height);
+    ihdr[8]  = 8;           // bit depth
+    ihdr[9]  = colorType;   // color type
+    ihdr[10] = 0;           // compression method
+    ihdr[11] = 0;           // filter method
+    ihdr[12] = 0;           // interlace method
+    chunk("IHDR",ihdr,13);
+
+    char srgb = 0;          // We want the colors to look good
+    chunk("sRGB",&srgb,1);
+
+    int rowBytes = bpp*width;
+    prior.assign(rowBytes,0);
+    for(int f=0;f<(indexed?1:5);f++)
+    {
+      filtered[f].resize(rowBytes+1);
+      filtered[f][0] = f;
+    }
+  }
+
+  void PNGWriter::writeRow(const unsigned char *row)
+    throw(VDrawException)
+  {
+    if(closed || rows>=height)
+      throw VDrawException("PNGWriter::writeRow() past the end of the image");
+
+    int best = 0;
+    if(indexed)
+      std::copy(row,row+width,filtered[0].begin()+1);
+    else
+      best = filter(row);
+
+    deflater.write((const char*)&filtered[best][0],filtered[best].size());
+    std::copy(row,row+bpp*width,prior.begin());
+    rows++;
+    flushData(false);
+  }
+
+  void PNGWriter::close()
+    throw(VDrawException)
+  {
+    if(closed)
+      return;
+    if(rows!=height)
+      throw VDrawException("PNGWriter::close() before the last row");
+
+    deflater.finish();
+    flushData(true);
+    chunk("IEND",0,0);
+    closed = true;
+  }
+
+  int PNGWriter::filter(const unsigned char *row)
+  {
+    int n = bpp*width;
+    const unsigned char *up = &prior[0];
+    unsigned char *none  = &filtered[0][1];
+    unsigned char *sub   = &filtered[1][1];
+    unsigned char *upf   = &filtered[2][1];
+    unsigned char *avg   = &filtered[3][1];
+    unsigned char *pae   = &filtered[4][1];
+
+    for(int i=0;i<n;i++)
+    {
+      int a = i>=bpp ? row[i-bpp] : 0;
+      int b = up[i];
+      int c = i>=bpp ? up[i-bpp] : 0;
+      int x = row[i];
+      none[i] = x;
+      sub[i]  = x-a;
+      upf[i]  = x-b;
+      avg[i]  = x-((a+b)>>1);
+      pae[i]  = x-paeth(a,b,c);
+    }
+
+    // Smallest sum of the bytes taken as signed differences
+    int best = 0;
+    unsigned long bestSum = 0;
+    for(int f=0;f<5;f++)
+    {
+      const unsigned char *p = &filtered[f][1];
+      unsigned long sum = 0;
+      for(int i=0;i<n;i++)
+        sum += p[i]<128 ? p[i] : 256-p[i];
+      if(f==0 || sum<bestSum)
+      {
+        best = f;
+        bestSum = sum;
+      }
+    }
+    return best;
+  }
+
+  void PNGWriter::flushData(bool all)
+  {
+    const std::string &data = deflater.getOutput();
+    if(data.size()<IDAT_SIZE && !(all && data.size()))
+      return;
+    chunk("IDAT",data.data(),data.size());
+    deflater.clearOutput();
+  }
+
+  void PNGWriter::chunk(const char *type, const char *data, unsigned int len)
+  {
+    char buf[4];
+    CRC32 crc;
+    crc.update(type,4);
+    if(len) crc.update(data,len);
+
+    putInt(buf,len);
+    ostr.write(buf,4);
+    ostr.write(type,4);
+    if(len) ostr.write(data,len);
+    putInt(buf,crc.getValue());
+    ostr.write(buf,4);
+  }
+
+} // namespace vdraw
@@ -0,0 +1,163 @@
+#pragma ident "$Id:$"
+
+/// @file PNGWriter.hpp Write PNG images a row at a time. Class declarations.
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+
+#ifndef VDRAW_PNGWRITER_H
+#define VDRAW_PNGWRITER_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Color.hpp"
+#include "Deflater.hpp"
+#include "VDrawException.hpp"
+
+namespace vdraw
+{
+  /** \addtogroup BasicVectorGraphics */
+  //@{
+
+  /**
+   * This class writes a PNG image to a stream one row at a time.
+   *
+   * Rows are filtered and compressed as they are given, and the image data
+   * goes out in IDAT chunks of about 32k, so only a few rows and the
+   * compressor's window are ever held in memory.
+   *
+   * Truecolor rows use the PNG filter that looks best for each row (the
+   * smallest sum of absolute differences); indexed rows are not filtered,
+   * as the PNG specification suggests for palette images.
+   *
+   * \code
+   * std::ofstream f("map.png",std::ios::binary);
+   * PNGWriter png(f,width,height);
+   * for(int row=0;row<height;row++)
+   * {
+   *   ... // fill rgb with 3*width bytes
+   *   png.writeRow(rgb);
+   * }
+   * png.close();
+   * \endcode
+   */
+  class PNGWriter
+  {
+    public:
+      /**
+       * Constructor for a truecolor image, 8 bits per sample.  The header
+       * is written right away.
+       * @param o Stream to write to, opened in binary mode
+       * @param width Width of the image
+       * @param height Height of the image
+       * @param level Compression level, 1-9
+       */
+      PNGWriter(std::ostream &o, int width, int height, int level=6)
+        throw(VDrawException);
+
+      /**
+       * Constructor for an indexed color image.  The header and the palette
+       * are written right away.
+       * @param o Stream to write to, opened in binary mode
+       * @param width Width of the image
+       * @param height Height of the image
+       * @param palette Colors for the indexes, up to 256
+       * @param level Compression level, 1-9
+       */
+      PNGWriter(std::ostream &o, int width, int height,
+                const std::vector<Color> &palette, int level=6)
+        throw(VDrawException);
+
+      /**
+       * Write the next row of the image.
+       * @param row Width bytes for an indexed image, or 3*width bytes
+       *   (red, green, blue) for a truecolor image
+       */
+      void writeRow(const unsigned char *row)
+        throw(VDrawException);
+
+      /**
+       * Write the end of the image.  Every row must have been written.
+       */
+      void close()
+        throw(VDrawException);
+
+      /// Width of the image
+      inline int getWidth() const { return width; }
+
+      /// Height of the image
+      inline int getHeight() const { return height; }
+
+      /// Number of rows written so far
+      inline int getRowsWritten() const { return rows; }
+
+    protected:
+      /// Write the signature and the header chunks
+      void start(int colorType);
+
+      /// Write the compressed data so far as IDAT chunks
+      void flushData(bool all);
+
+      /// Write a chunk with its length and checksum
+      void chunk(const char *type, const char *data, unsigned int len);
+
+      /// Filter the row every way, into filtered, and return the type of
+      /// the filter to use
+      int filter(const unsigned char *row);
+
+      /// Stream being written
+      std::ostream &ostr;
+
+      /// Dimensions
+      int width, height;
+
+      /// Bytes per pixel, 1 (indexed) or 3 (truecolor)
+      int bpp;
+
+      /// Rows written so far
+      int rows;
+
+      /// True if the image is indexed color
+      bool indexed;
+
+      /// True once close() has written IEND
+      bool closed;
+
+      /// Previous (unfiltered) row, for the Up, Average and Paeth filters
+      std::vector<unsigned char> prior;
+
+      /// Filter type byte followed by the filtered row, for each filter type
+      std::vector<unsigned char> filtered[5];
+
+      /// Compressor for the image data
+      Deflater deflater;
+
+  }; // class PNGWriter
+
+  //@}
+
+} // namespace vdraw
+
+#endif //VDRAW_PNGWRITER_H
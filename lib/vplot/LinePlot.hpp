@@ -95,6 +95,10 @@ namespace vplot
         sl.addSeries(label,series,ss);
       }
 
+      /// Set the level of detail, in columns per point (0 to draw every
+      /// point).  See SeriesList::setResolution().
+      inline void setResolution(double r) { sl.setResolution(r); }
+
       /// Draw the Plot to this frame, with the key on the dir side
       inline void draw(Frame& frame, int dir)
       {
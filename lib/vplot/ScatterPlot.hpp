@@ -78,6 +78,10 @@ namespace vplot
         sl.addSeries(label,series,m);
       }
 
+      /// Set the level of detail, in columns per point (0 to draw every
+      /// point).  See SeriesList::setResolution().
+      inline void setResolution(double r) { sl.setResolution(r); }
+
       /// Draw the Plot to this frame
       inline void drawPlot(Frame& frame)
       {
@@ -26,6 +26,7 @@
 //============================================================================
 
 #include <algorithm>
+#include <cmath>
 
 #include "SeriesList.hpp"
 #include "Splitter.hpp"
@@ -58,11 +59,75 @@ namespace vplot
     } 
   }
 
+  void SeriesList::decimateLine(const vector< pair<double,double> >& in,
+                                vector< pair<double,double> >& out,
+                                double minX, double width)
+  {
+    out.clear();
+    double scale = 1.0/width;
+    size_t n = in.size();
+    size_t start = 0;
+    while(start<n)
+    {
+      // The run of points in this column
+      double col = floor((in[start].first-minX)*scale);
+      size_t lo = start, hi = start, end = start+1;
+      while(end<n && floor((in[end].first-minX)*scale)==col)
+      {
+        if(in[end].second<in[lo].second) lo = end;
+        if(in[end].second>in[hi].second) hi = end;
+        end++;
+      }
+
+      // First, lowest and highest in order, and last; each once
+      size_t keep[4] = { start, min(lo,hi), max(lo,hi), end-1 };
+      for(int k=0; k<4; k++)
+        if(k==0 || keep[k]!=keep[k-1])
+          out.push_back(in[keep[k]]);
+
+      start = end;
+    }
+  }
+
+  void SeriesList::binPoints(const vector< pair<double,double> >& in,
+                             vector< pair<double,double> >& out,
+                             double minX, double maxX, double minY, double maxY,
+                             int cols, int rows)
+  {
+    out.clear();
+    vector<bool> used((size_t)cols*rows, false);
+    double scaleX = cols/(maxX-minX);
+    double scaleY = rows/(maxY-minY);
+    for(size_t i=0; i<in.size(); i++)
+    {
+      double x = in[i].first;
+      double y = in[i].second;
+      if(!(x>=minX && x<=maxX && y>=minY && y<=maxY))
+      {
+        out.push_back(in[i]);
+        continue;
+      }
+      int c = min((int)((x-minX)*scaleX), cols-1);
+      int r = min((int)((y-minY)*scaleY), rows-1);
+      size_t cell = (size_t)r*cols + c;
+      if(!used[cell])
+      {
+        used[cell] = true;
+        out.push_back(in[i]);
+      }
+    }
+  }
+
   void SeriesList::drawInFrame(Frame& innerFrame, double minX, double maxX, double minY, double maxY)
   {
     double multX = innerFrame.getWidth()/(maxX-minX);
     double multY = innerFrame.getHeight()/(maxY-minY);
 
+    // Level of detail columns for lines
+    int cols = 0;
+    if(resolution>0 && maxX>minX && maxY>minY)
+      cols = (int)ceil(innerFrame.getWidth()*resolution);
+
     // Draw lines
     for(int i=0;i<getNumSeries();i++)
     {
@@ -77,29 +142,37 @@ namespace vplot
         continue;
       }
 
+      bool lines = !s.getColor().isClear();
+      bool marks = !m.getColor().isClear();
+
+      // Reduce long series to what can be seen.  A decimated line with
+      // markers is drawn twice: the line alone, then the binned markers.
       vector< pair<double,double> >& vec = getPointList(i);
-      Path curve(vec,innerFrame.lx(), innerFrame.ly());
+      vector< pair<double,double> > decimated, binned;
+      bool lod = (cols>0 && vec.size()>4*(size_t)cols);
+      if(lod && lines)
+        decimateLine(vec,decimated,minX,(maxX-minX)/cols);
+      if(lod && marks)
+      {
+        // One marker per cell of the size of the drawn marker, and never
+        // more than one per point; overlapping markers add nothing.
+        double cell = max(2*m.getRange(), max(1.0, 1.0/resolution));
+        int mcols = (int)ceil(innerFrame.getWidth()/cell);
+        int mrows = (int)ceil(innerFrame.getHeight()/cell);
+        binPoints(vec,binned,minX,maxX,minY,maxY,mcols,mrows);
+      }
 
       // What I'd give for a line of haskell...
       // map (\(x,y) -> (multX*(x-minX), multY*(y-minY))) vector
       map_object map_instance(multX,minX,multY,minY);
 
-      innerFrame.setMarker(m);
+      innerFrame.setMarker((lines && lod) ? Marker::clear() : m);
       innerFrame.setLineStyle(s);
 
-      if(s.getColor().isClear())
+      if(lines)
       {
-        // crop
-        auto_ptr< Path > cropX = Splitter::cropToBox(minX,maxX,minY,maxY,curve);
-
-        // Fit it to the box.
-        std::for_each(cropX->begin(), cropX->end(), map_instance);
+        Path curve(lod ? decimated : vec, innerFrame.lx(), innerFrame.ly());
 
-        // Draw the line
-        innerFrame.line(*cropX);
-      }
-      else 
-      {
         // interpolate
         auto_ptr< std::list<Path> > interpX = Splitter::interpToBox(minX,maxX,minY,maxY,curve);
 
@@ -112,6 +185,22 @@ namespace vplot
           innerFrame.line(*i);
         }
       }
+
+      if(marks && (!lines || lod))
+      {
+        Path curve(lod ? binned : vec, innerFrame.lx(), innerFrame.ly());
+        innerFrame.setMarker(m);
+        innerFrame.setLineStyle(StrokeStyle::clear());
+
+        // crop
+        auto_ptr< Path > cropX = Splitter::cropToBox(minX,maxX,minY,maxY,curve);
+
+        // Fit it to the box.
+        std::for_each(cropX->begin(), cropX->end(), map_instance);
+
+        // Draw the line
+        innerFrame.line(*cropX);
+      }
       innerFrame.pop_state();
     }
   }
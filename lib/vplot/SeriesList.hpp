@@ -58,6 +58,7 @@ namespace vplot
        * Constructor.
        */
       SeriesList() 
+        : resolution(2.0)
       {
       }
 
@@ -162,6 +163,54 @@ namespace vplot
       /// Return a pointer to the list of points
       vector< pair<double,double> >& getPointList(int idx) { return pointlists[idx]; }
 
+      /**
+       * Set the level of detail used when drawing.  Before a series is
+       * drawn it is reduced to what can be seen at this resolution, so the
+       * output size depends on the size of the frame and not on the number
+       * of points.  Lines keep the first, last, lowest and highest point of
+       * each column (min/max decimation) and markers keep one point for
+       * each cell of a grid (density binning).  The cells are as large as
+       * the drawn marker and at least one point (or one column) across.
+       * Series too short to gain anything are drawn as they are.
+       * @param r Columns per unit of frame coordinates, i.e. per point;
+       *   0 draws every point.  The default is 2.
+       */
+      void setResolution(double r) { resolution = (r>0 ? r : 0); }
+
+      /// Get the level of detail, in columns per point (0 for none)
+      double getResolution() const { return resolution; }
+
+      /**
+       * Min/max decimation of a line.  Consecutive points falling in the
+       * same column keep only the first, last, lowest and highest, in their
+       * original order.  Drawn one column wide, the line looks the same.
+       * @param in The points of the line
+       * @param out On return, the points to draw
+       * @param minX The x value of the left edge of the first column
+       * @param width The width of a column, in x units
+       */
+      static void decimateLine(const vector< pair<double,double> >& in,
+                               vector< pair<double,double> >& out,
+                               double minX, double width);
+
+      /**
+       * Density binning of points drawn with markers.  The first point in
+       * each cell of a cols by rows grid over the box is kept.  Points
+       * outside the box are all kept.
+       * @param in The points
+       * @param out On return, the points to draw
+       * @param minX Left edge of the box
+       * @param maxX Right edge of the box
+       * @param minY Bottom edge of the box
+       * @param maxY Top edge of the box
+       * @param cols Number of columns of the grid
+       * @param rows Number of rows of the grid
+       */
+      static void binPoints(const vector< pair<double,double> >& in,
+                            vector< pair<double,double> >& out,
+                            double minX, double maxX, double minY, double maxY,
+                            int cols, int rows);
+
       /// Return the minimums and maximum of all the data.
       void findMinMax(double& minX, double &maxX, double& minY, double& maxY);
 
@@ -192,6 +241,9 @@ namespace vplot
       /// List of markers indexed by number
       vector< Marker > markers;
 
+      /// Level of detail, in columns per point (0 for none)
+      double resolution;
+
       /// This struct helps in translating coordinates for a set of points
       struct map_object
       {
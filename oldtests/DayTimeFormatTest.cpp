@@ -0,0 +1,417 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2006, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file DayTimeFormatTest.cpp
+ * Checks the table driven calendar conversions of DayTime and the
+ * formatting and reading of DayTimeFormat against the way they were done
+ * before, and measures how many of each are done per second.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "DayTime.hpp"
+#include "DayTimeFormat.hpp"
+#include "StringUtils.hpp"
+
+using namespace std;
+using namespace gpstk;
+using namespace gpstk::StringUtils;
+
+
+int failures = 0;
+
+void check(bool ok, const string& what)
+{
+   if (!ok)
+   {
+      if (failures < 20)
+         cout << "FAILED: " << what << endl;
+      failures++;
+   }
+}
+
+
+   // The calendar conversions as DayTime computed them before the table
+void oldJDtoCalendar(long jd, int& iyear, int& imonth, int& iday)
+{
+   long L, M, N, P, Q;
+   if(jd > 2299160)    // after Oct 4, 1582
+   {
+      L = jd + 68569;
+      M = (4 * L) / 146097;
+      L = L - ((146097 * M + 3) / 4);
+      N = (4000 * (L + 1)) / 1461001;
+      L = L - ((1461 * N) / 4) + 31;
+      P = (80 * L) / 2447;
+      iday = int(L - (2447 * P) / 80);
+      L = P / 11;
+      imonth = int(P + 2 - 12 * L);
+      iyear = int(100 * (M - 49) + N + L);
+   }
+   else
+   {
+      P = jd + 1402;
+      Q = (P - 1) / 1461;
+      L = P - 1461 * Q;
+      M = (L - 1) / 365 - L / 1461;
+      N = L - 365 * M + 30;
+      P = (80 * N) / 2447;
+      iday = int(N - (2447 * P) / 80);
+      N = P / 11;
+      imonth = int(P + 2 - 12 * N);
+      iyear = int(4 * Q + M + N - 4716);
+      if(iyear <= 0)
+         --iyear;
+   }
+   if(iyear > 1599 && !(iyear % 100) && (iyear % 400) &&
+      imonth == 2 && iday == 29)
+   {
+      imonth = 3;
+      iday = 1;
+   }
+}
+
+long oldCalendarToJD(int yy, int mm, int dd)
+{
+   if(yy == 0)
+      --yy;
+   if(yy < 0)
+      ++yy;
+
+   long jd;
+   double y = double(yy), m = double(mm);
+   if(yy < 1582 || (yy == 1582 && (mm < 10 || (mm == 10 && dd < 15))))
+   {
+      jd = 1729777 + dd + 367 * yy
+         - long(7 * ( y + 5001 + long((m - 9) / 7)) / 4)
+         + long(275 * m / 9);
+   }
+   else
+   {
+      jd = 1721029 + dd + 367 * yy
+         - long(7 * (y + long((m + 9) / 12)) / 4)
+         - long(3 * (long((y + (m - 9) / 7) / 100) + 1) / 4)
+         + long(275 * m / 9);
+      if( (! (yy % 100) && (yy % 400) && mm > 2 && mm < 9) ||
+          (!((yy - 1) % 100) && ((yy - 1) % 400) && mm == 1))
+         --jd;
+   }
+   return jd;
+}
+
+
+   // DayTime::printf() as it was, one regular expression per conversion
+string oldPrintf(const DayTime& t, const char *fmt)
+{
+   static const char *MonthNames[] = { "Error",
+      "January","February", "March", "April", "May", "June","July",
+      "August", "September", "October", "November", "December" };
+   static const char *MonthAbbrevNames[] = { "err", "Jan", "Feb", "Mar",
+      "Apr", "May", "Jun","Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+   static const char *DayOfWeekNames[] = { "Sunday", "Monday", "Tuesday",
+      "Wednesday", "Thursday", "Friday", "Saturday" };
+   static const char *DayOfWeekAbbrevNames[] = {
+      "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+
+   string rv = fmt;
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*S"),
+                       string("Sd"), (short)t.second());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*(\\.[[:digit:]]+)?f"),
+                       string("ff"), t.second());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*G"),
+                       string("Ghd"), t.GPS10bitweek());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*F"),
+                       string("Fhd"), t.GPSfullweek());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*(\\.[[:digit:]]+)?g"),
+                       string("gf"), t.GPSsow());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*(\\.[[:digit:]]+)?s"),
+                       string("sf"), t.DOYsecond());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*(\\.[[:digit:]]+)?Q"),
+                       string("QLf"), t.getMJDasLongDouble());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*Y"),
+                       string("Yhd"), t.year());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*y"),
+                       string("yhd"), (short)(t.year() % 100));
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*m"),
+                       string("mhd"), t.month());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*b"),
+                       string("bs"), MonthAbbrevNames[t.month()]);
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*B"),
+                       string("Bs"), MonthNames[t.month()]);
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*d"),
+                       string("dhd"), t.day());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*H"),
+                       string("Hhd"), t.hour());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*M"),
+                       string("Mhd"), t.minute());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*w"),
+                       string("whd"), t.dayOfWeek());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*a"),
+                       string("as"), DayOfWeekAbbrevNames[t.dayOfWeek()]);
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*A"),
+                       string("As"), DayOfWeekNames[t.dayOfWeek()]);
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*z"),
+                       string("zd"), (int)t.GPSzcountFloor());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*Z"),
+                       string("Zd"), (int)t.GPSzcount());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*U"),
+                       string("Ud"), (int)t.unixTime().tv_sec);
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*u"),
+                       string("ud"), (int)t.unixTime().tv_usec);
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*j"),
+                       string("jhd"), t.DOY());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*C"),
+                       string("Cd"), (int)t.fullZcount());
+   rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*c"),
+                       string("cd"), (int)t.fullZcountFloor());
+   return rv;
+}
+
+   // A RINEX observation epoch read as RinexObsData did before
+DayTime oldParseEpoch(const string& line, int century)
+{
+   int year  = asInt(   line.substr(1,  2 ));
+   int month = asInt(   line.substr(4,  2 ));
+   int day   = asInt(   line.substr(7,  2 ));
+   int hour  = asInt(   line.substr(10, 2 ));
+   int min   = asInt(   line.substr(13, 2 ));
+   double sec = asDouble(line.substr(15, 11));
+
+   double ds = 0;
+   if (sec >= 60.) { ds = sec; sec = 0.0; }
+   DayTime rv(century + year, month, day, hour, min, sec);
+   if (ds != 0) rv += ds;
+   return rv;
+}
+
+
+   // Seconds of CPU time since 'start'
+double since(clock_t start)
+{
+   return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+void report(const char* what, long count, double sec)
+{
+   cout << setw(34) << what << setw(12) << fixed << setprecision(0)
+        << ((sec > 0) ? count / sec : 0.0) << " /s" << endl;
+}
+
+
+/// Returns 0 if all the checks pass.
+int main(int argc, char *argv[])
+{
+   try
+   {
+      srand(1);
+
+         // Every day from well before to well after the calendar table
+      long first = oldCalendarToJD(1500, 1, 1);
+      long last = oldCalendarToJD(2500, 12, 31);
+      for (long jd = first; jd <= last; jd++)
+      {
+         int y, m, d, oy, om, od;
+         DayTime::convertJDtoCalendar(jd, y, m, d);
+         oldJDtoCalendar(jd, oy, om, od);
+         check(y == oy && m == om && d == od,
+               "convertJDtoCalendar " + asString(jd));
+      }
+      for (int y = 1500; y <= 2500; y++)
+         for (int m = 0; m <= 13; m++)
+            for (int d = 0; d <= 32; d++)
+               check(DayTime::convertCalendarToJD(y, m, d)
+                     == oldCalendarToJD(y, m, d),
+                     "convertCalendarToJD " + asString(y) + "/"
+                     + asString(m) + "/" + asString(d));
+
+         // Dates that aren't valid are still refused
+      bool threw = false;
+      try { DayTime(2009, 2, 29, 0, 0, 0.0); }
+      catch (DayTime::DayTimeException&) { threw = true; }
+      check(threw, "2009/02/29 refused");
+      threw = false;
+      try { DayTime(2009, 3, 1, 0, 60, 0.0); }
+      catch (DayTime::DayTimeException&) { threw = true; }
+      check(threw, "00:60 refused");
+
+         // Random times from 1985 to 2035
+      vector<DayTime> times;
+      for (int i = 0; i < 20000; i++)
+      {
+         long mjd = 46066 + rand() % 18262;
+         double sod = (rand() % 86400) + (rand() % 10000000) * 1e-7;
+         times.push_back(DayTime(mjd + sod / 86400.0L));
+      }
+      times.push_back(DayTime(2000, 2, 29, 23, 59, 59.99999999));
+      times.push_back(DayTime(1999, 12, 31, 0, 0, 0.0));
+
+      const char* formats[] = {
+         " %02y %2m %2d %2H %2M%11.7f",
+         "%6Y%6m%6d%6H%6M%13.7f",
+         "*  %4Y %2m %2d %2H %2M %11.8f",
+         "%Y/%02m/%02d %2H:%02M:%06.3f = %F/%10.3g",
+         "%04F %10.3g %-5G|%5j|% 5w|%03S|%s|%.9Q",
+         "%a %A %b %B %10B|%-10b|%z %Z %C %c %U %u",
+         "100%% %%Y %Y%m%d%H%M%S %5.Y %.3d %",
+         ""
+      };
+      const int numFormats = sizeof(formats) / sizeof(formats[0]);
+      for (size_t i = 0; i < times.size(); i++)
+         for (int f = 0; f < numFormats; f++)
+         {
+            string want = oldPrintf(times[i], formats[f]);
+            check(times[i].printf(formats[f]) == want,
+                  string("printf ") + formats[f] + ": "
+                  + times[i].printf(formats[f]) + " != " + want);
+         }
+
+         // Reading the layout of a RINEX observation epoch
+      DayTimeFormat epoch(" %02y %2m %2d %2H %2M%11.7f");
+      vector<string> lines;
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         string line = epoch.print(times[i]);
+         lines.push_back(line);
+         int century = times[i].year() / 100 * 100;
+         check(epoch.scan(line, century) == oldParseEpoch(line, century),
+               "scan " + line);
+      }
+      check(epoch.scan(" 09  3  1 23 59 60.0000000", 2000)
+            == DayTime(2009, 3, 2, 0, 0, 0.0), "scan of 60 seconds");
+      check(epoch.scan(" 99 12 31  0  0  0.5", 1980)
+            == DayTime(1999, 12, 31, 0, 0, 0.5), "scan of a short line");
+      check(DayTimeFormat("%4Y %3j %2H%2M%2S").scan("2009  60 011203")
+            == DayTime(2009, 60, 3600 + 720 + 3.0), "scan of a day of year");
+      check(DayTimeFormat("%4Y%2m%2d").scan("20090301")
+            == DayTime(2009, 3, 1, 0, 0, 0.0), "scan of a date");
+      threw = false;
+      try { epoch.scan(" 09  2 29  0  0  0.0000000", 2000); }
+      catch (DayTime::DayTimeException&) { threw = true; }
+      check(threw, "scan of an invalid date");
+
+         // Buffers that are too short are filled and terminated
+      char buf[64];
+      DayTimeFormat header("%6Y%6m%6d%6H%6M%13.7f");
+      check(header.print(times[0], buf, 10) == 43 && strlen(buf) == 9,
+            "short buffer");
+
+         // Throughput
+      cout << "Conversions of " << times.size() << " times" << endl;
+      const int passes = 5;
+      long n = long(passes) * times.size();
+      clock_t start;
+      volatile long sink = 0;
+
+      vector<long> days;
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         int y, m, d;
+         times[i].getYMD(y, m, d);
+         days.push_back(oldCalendarToJD(y, m, d));
+      }
+
+      start = clock();
+      for (int p = 0; p < passes * 100; p++)
+         for (size_t i = 0; i < days.size(); i++)
+         {
+            int y, m, d;
+            oldJDtoCalendar(days[i], y, m, d);
+            sink += d;
+         }
+      report("old JD to calendar", 100 * n, since(start));
+
+      start = clock();
+      for (int p = 0; p < passes * 100; p++)
+         for (size_t i = 0; i < days.size(); i++)
+         {
+            int y, m, d;
+            DayTime::convertJDtoCalendar(days[i], y, m, d);
+            sink += d;
+         }
+      report("table JD to calendar", 100 * n, since(start));
+
+      start = clock();
+      for (int p = 0; p < passes * 100; p++)
+         for (size_t i = 0; i < days.size(); i++)
+            sink += oldCalendarToJD(1985 + i % 50, 1 + i % 12, 1 + i % 28);
+      report("old calendar to JD", 100 * n, since(start));
+
+      start = clock();
+      for (int p = 0; p < passes * 100; p++)
+         for (size_t i = 0; i < days.size(); i++)
+            sink += DayTime::convertCalendarToJD(1985 + i % 50, 1 + i % 12,
+                                                 1 + i % 28);
+      report("table calendar to JD", 100 * n, since(start));
+
+      start = clock();
+      for (int p = 0; p < passes; p++)
+         for (size_t i = 0; i < times.size(); i++)
+            sink += oldPrintf(times[i], formats[0]).length();
+      report("old printf", n, since(start));
+
+      start = clock();
+      for (int p = 0; p < passes; p++)
+         for (size_t i = 0; i < times.size(); i++)
+            sink += times[i].printf(formats[0]).length();
+      report("DayTime::printf", n, since(start));
+
+      start = clock();
+      for (int p = 0; p < passes; p++)
+         for (size_t i = 0; i < times.size(); i++)
+            sink += epoch.print(times[i], buf, sizeof(buf));
+      report("DayTimeFormat::print to a buffer", n, since(start));
+
+      start = clock();
+      for (int p = 0; p < passes; p++)
+         for (size_t i = 0; i < lines.size(); i++)
+            sink += oldParseEpoch(lines[i], 2000).DOYday();
+      report("old epoch parse", n, since(start));
+
+      start = clock();
+      for (int p = 0; p < passes; p++)
+         for (size_t i = 0; i < lines.size(); i++)
+            sink += epoch.scan(lines[i], 2000).DOYday();
+      report("DayTimeFormat::scan", n, since(start));
+   }
+   catch(Exception& e)
+   {
+      cout << e << endl;
+      return 1;
+   }
+
+   if (failures)
+   {
+      cout << failures << " checks failed" << endl;
+      return 1;
+   }
+   cout << "All checks passed" << endl;
+   return 0;
+}
@@ -0,0 +1,235 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2006, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file FFStreamForwardTest.cpp
+ * Reads a RINEX obs file with a corrupt epoch line in FFStream
+ * forward-only mode, from the file and from a mapping: the bad record
+ * must be skipped and counted once, and a plain while (strm >> rod) loop
+ * must read every other record to the end of the file.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstdio>
+
+#include "RinexObsData.hpp"
+#include "RinexObsHeader.hpp"
+#include "RinexObsStream.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+int failures = 0;
+
+void check(bool ok, const string& what)
+{
+   if (!ok)
+   {
+      cout << "FAILED: " << what << endl;
+      failures++;
+   }
+}
+
+
+   // Read every record of the file, the usual way.
+void readAll(const char* fn, vector<RinexObsData>& records)
+{
+   RinexObsStream strm(fn);
+   strm.exceptions(ios::failbit);
+
+   RinexObsHeader roh;
+   RinexObsData rod;
+   strm >> roh;
+   while (strm >> rod)
+   {
+      records.push_back(rod);
+   }
+}
+
+
+   // Copy the file, replacing the date on the epoch line of record
+   // 'bad' with letters. Records are counted as RinexObsData reads them,
+   // one per epoch line, event records included.
+void corrupt(const char* in, const char* out, size_t bad)
+{
+   ifstream is(in);
+   ofstream os(out);
+
+   string line;
+   bool inHeader = true;
+   int linesPerSv = 1;
+   size_t record = 0;
+   int skipLines = 0;
+   while (getline(is, line))
+   {
+      if (inHeader)
+      {
+         if (line.find("# / TYPES OF OBSERV") != string::npos &&
+             line[5] != ' ')
+         {
+            linesPerSv = (atoi(line.substr(0, 6).c_str()) + 4) / 5;
+         }
+         inHeader = (line.find("END OF HEADER") == string::npos);
+      }
+      else if (skipLines > 0)
+      {
+         skipLines--;
+      }
+      else
+      {
+            // An epoch line. It is followed by more lines of SVs, 12 to
+            // a line, then the obs of each SV; or by header lines for
+            // epoch flags above 1.
+         int numSvs = atoi(line.substr(29, 3).c_str());
+         if (line[28] > '1')
+         {
+            skipLines = numSvs;
+         }
+         else
+         {
+            skipLines = (numSvs - 1) / 12 + numSvs * linesPerSv;
+         }
+         if (record == bad)
+         {
+            line.replace(1, 8, "xx xx xx");
+         }
+         record++;
+      }
+      os << line << endl;
+   }
+}
+
+
+   // The usual mode stops at the bad record
+void checkDefault(const char* fn, size_t bad, bool mapped)
+{
+   const string how(mapped ? " (mapped)" : "");
+   RinexObsStream strm(fn);
+   RinexObsHeader roh;
+   RinexObsData rod;
+   strm >> roh;
+   if (mapped)
+   {
+      check(strm.mapFile(), "file mapped");
+   }
+   size_t n = 0;
+   while (strm >> rod)
+   {
+      n++;
+   }
+   check(n == bad, "default mode stops at the bad record" + how);
+   check(strm.getBadRecords() == 1, "default mode counts it" + how);
+}
+
+
+   // Forward-only mode skips it, without a clear()
+void checkForward(const char* fn, size_t bad,
+                  const vector<RinexObsData>& good, bool mapped)
+{
+   const string how(mapped ? " (mapped)" : "");
+   RinexObsStream strm(fn);
+   strm.setForwardOnly();
+   RinexObsHeader roh;
+   RinexObsData rod;
+   strm >> roh;
+   if (mapped)
+   {
+      check(strm.mapFile(), "file mapped");
+   }
+   vector<RinexObsData> read;
+   while (strm >> rod)
+   {
+      read.push_back(rod);
+   }
+
+   check(read.size() + 1 == good.size(), "all other records read" + how);
+   check(strm.getBadRecords() == 1, "bad record counted once" + how);
+   check(strm.getReadStatus() == FFStream::readEOF, "ends at EOF" + how);
+
+   for (size_t i = 0, j = 0;
+        i < read.size() && j < good.size();
+        i++, j++)
+   {
+      if (j == bad)
+      {
+         j++;
+      }
+      check( read[i].time == good[j].time &&
+             read[i].numSvs == good[j].numSvs &&
+             read[i].obs.size() == good[j].obs.size(),
+             "record " + StringUtils::asString(j) + " matches" + how );
+   }
+
+   cout << "Records: " << good.size()
+        << ", read in forward-only mode" << how << ": " << read.size()
+        << ", bad records: " << strm.getBadRecords() << endl;
+}
+
+
+/// Returns 0 if all the checks pass.
+int main(int argc, char *argv[])
+{
+   if (argc < 2)
+   {
+      cout << "Usage: FFStreamForwardTest <RINEX obs file>" << endl;
+      return 1;
+   }
+
+   try
+   {
+      vector<RinexObsData> good;
+      readAll(argv[1], good);
+      check(good.size() > 2, "enough records in the file");
+
+      const size_t bad = good.size() / 2;
+      const char* tmpName = "FFStreamForwardTest.tmp";
+      corrupt(argv[1], tmpName, bad);
+
+      checkDefault(tmpName, bad, false);
+      checkDefault(tmpName, bad, true);
+      checkForward(tmpName, bad, good, false);
+      checkForward(tmpName, bad, good, true);
+
+      remove(tmpName);
+   }
+   catch (Exception& e)
+   {
+      cout << e << endl;
+      return 1;
+   }
+
+   if (failures)
+   {
+      cout << failures << " check(s) failed" << endl;
+      return 1;
+   }
+   cout << "All checks passed" << endl;
+
+   return 0;
+}
@@ -0,0 +1,170 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2006, The University of Texas at Austin
+//
+//============================================================================
+
+
+/**
+ * @file GPSEphemerisPackTest.cpp
+ * Compares GPSEphemerisPack::evaluate() with EngEphemeris::svXvt() over a
+ * day of broadcast ephemerides: reports the largest differences and the
+ * time taken by each.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <ctime>
+#include <cmath>
+#include <cstdlib>
+
+#include "RinexEphemerisStore.hpp"
+#include "GPSEphemerisPack.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+/// Returns 0 if the pack agrees with svXvt() within 1e-6 m.
+int main(int argc, char *argv[])
+{
+
+   if (argc < 2)
+   {
+      cout << "GPSEphemerisPackTest navfile [passes]" << endl;
+      return -1;
+   }
+
+   int passes = (argc > 2) ? atoi(argv[2]) : 20;
+   if (passes < 1)
+   {
+      passes = 1;
+   }
+
+   try
+   {
+      RinexEphemerisStore store;
+      store.loadFile(argv[1]);
+
+      double dxMax = 0, dvMax = 0, dtMax = 0;
+      double tScalar = 0, tPack = 0;
+      long evals = 0;
+
+         // A new snapshot every hour, evaluated each 30 s within the hour
+      for (DayTime tb = store.getInitialTime(); tb < store.getFinalTime();
+           tb += 3600.0)
+      {
+         GPSEphemerisPack pack(store, tb);
+         const vector<SatID>& sats = pack.getSatIDs();
+         if (sats.empty())
+         {
+            continue;
+         }
+
+         vector<const EngEphemeris*> ephs;
+         for (size_t i = 0; i < sats.size(); i++)
+         {
+            ephs.push_back(&store.findEphemeris(sats[i], tb));
+         }
+
+         vector<DayTime> times;
+         for (double s = 0; s < 3600.0; s += 30.0)
+         {
+            times.push_back(tb + s);
+         }
+
+         vector<Xvt> scalar(sats.size() * times.size());
+         vector<Xvt> packed(sats.size() * times.size());
+
+         clock_t start = clock();
+         for (int pass = 0; pass < passes; pass++)
+         {
+            for (size_t j = 0; j < times.size(); j++)
+            {
+               for (size_t i = 0; i < sats.size(); i++)
+               {
+                  scalar[j*sats.size() + i] = ephs[i]->svXvt(times[j]);
+               }
+            }
+         }
+         tScalar += double(clock() - start) / CLOCKS_PER_SEC;
+
+         start = clock();
+         for (int pass = 0; pass < passes; pass++)
+         {
+            for (size_t j = 0; j < times.size(); j++)
+            {
+               pack.evaluate(times[j], &packed[j*sats.size()]);
+            }
+         }
+         tPack += double(clock() - start) / CLOCKS_PER_SEC;
+
+         for (size_t k = 0; k < scalar.size(); k++)
+         {
+            for (int c = 0; c < 3; c++)
+            {
+               dxMax = max(dxMax, fabs(scalar[k].x[c] - packed[k].x[c]));
+               dvMax = max(dvMax, fabs(scalar[k].v[c] - packed[k].v[c]));
+            }
+            dtMax = max(dtMax, fabs(scalar[k].dtime - packed[k].dtime));
+         }
+         evals += scalar.size();
+      }
+
+      cout << "File: " << argv[1] << ", " << evals << " SV epochs, "
+           << passes << " passes" << endl;
+      cout << fixed << setprecision(4);
+      cout << setw(18) << "svXvt" << setw(12) << tScalar << " s" << endl;
+      cout << setw(18) << "pack" << setw(12) << tPack << " s" << endl;
+      if (tPack > 0)
+      {
+         cout << setw(18) << "speedup" << setw(12) << tScalar / tPack
+              << endl;
+      }
+      cout << scientific << setprecision(3);
+      cout << setw(18) << "max position diff" << setw(12) << dxMax << " m"
+           << endl;
+      cout << setw(18) << "max velocity diff" << setw(12) << dvMax << " m/s"
+           << endl;
+      cout << setw(18) << "max clock diff" << setw(12) << dtMax << " s"
+           << endl;
+
+      if (evals > 0 && dxMax <= 1.0e-6)
+      {
+         cout << "Pack agrees with svXvt." << endl;
+         return 0;
+      }
+
+      cout << "Pack and svXvt DIFFER." << endl;
+      return 1;
+   }
+   catch(gpstk::Exception& e)
+   {
+      cout << e << endl;
+   }
+   catch(...)
+   {
+      cout << "Some other exception thrown..." << endl;
+   }
+
+   return -1;
+}
@@ -0,0 +1,364 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2009, The University of Texas at Austin
+//
+//============================================================================
+
+
+/**
+ * @file MatrixKernelsTest.cpp
+ * Compares the blocked Matrix<double> kernels with straightforward
+ * versions of the generic algorithms, element by element, and reports
+ * the time taken by each.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+
+#include "Matrix.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   // The generic algorithms, as in MatrixOperators.hpp and
+   // MatrixFunctors.hpp, written out on Matrix<double> elements.
+
+Matrix<double> refMultiply(const Matrix<double>& l, const Matrix<double>& r)
+{
+   Matrix<double> p(l.rows(), r.cols(), 0.0);
+   for (size_t i = 0; i < p.rows(); i++)
+      for (size_t j = 0; j < p.cols(); j++)
+         for (size_t k = 0; k < l.cols(); k++)
+            p(i,j) += l(i,k) * r(k,j);
+   return p;
+}
+
+Vector<double> refMultiply(const Matrix<double>& m, const Vector<double>& v)
+{
+   Vector<double> p(m.rows());
+   for (size_t i = 0; i < m.rows(); i++)
+   {
+      p[i] = 0;
+      for (size_t j = 0; j < m.cols(); j++)
+         p[i] += m(i,j) * v[j];
+   }
+   return p;
+}
+
+Matrix<double> refTranspose(const Matrix<double>& m)
+{
+   Matrix<double> t(m.cols(), m.rows());
+   for (size_t i = 0; i < m.rows(); i++)
+      for (size_t j = 0; j < m.cols(); j++)
+         t(j,i) = m(i,j);
+   return t;
+}
+
+Matrix<double> refCholesky(const Matrix<double>& m)
+{
+   int N = m.rows();
+   Matrix<double> L(N, N, 0.0);
+   for (int j = 0; j < N; j++)
+   {
+      double sum = m(j,j);
+      for (int k = 0; k < j; k++) sum -= L(j,k)*L(j,k);
+      L(j,j) = ::sqrt(sum);
+      for (int i = j+1; i < N; i++)
+      {
+         sum = m(i,j);
+         for (int k = 0; k < j; k++) sum -= L(i,k)*L(j,k);
+         L(i,j) = sum/L(j,j);
+      }
+   }
+   return L;
+}
+
+Matrix<double> refInverseChol(const Matrix<double>& m)
+{
+   Matrix<double> L(refCholesky(m));
+   int N = m.rows();
+   Matrix<double> LI(N, N, 0.0);
+   for (int i = 0; i < N; i++)
+   {
+      LI(i,i) = 1.0 / L(i,i);
+      for (int j = 0; j < i; j++)
+      {
+         double sum = 0.0;
+         for (int k = i; k >= 0; k--) sum += L(i,k)*LI(k,j);
+         LI(i,j) = -sum*LI(i,i);
+      }
+   }
+   return refMultiply(refTranspose(LI), LI);
+}
+
+void refLUD(const Matrix<double>& m, Matrix<double>& LU, Vector<int>& Pivot,
+            int& parity)
+{
+   size_t N = m.rows(), imax = 0;
+   Vector<double> V(N, 0.0);
+   LU = m;
+   Pivot = Vector<int>(N);
+   parity = 1;
+   for (size_t i = 0; i < N; i++)
+   {
+      double big = 0.0;
+      for (size_t j = 0; j < N; j++)
+         if (std::abs(LU(i,j)) > big) big = std::abs(LU(i,j));
+      V(i) = 1.0/big;
+   }
+   for (size_t j = 0; j < N; j++)
+   {
+      for (size_t i = 0; i < j; i++)
+      {
+         double t = LU(i,j);
+         for (size_t k = 0; k < i; k++) t -= LU(i,k)*LU(k,j);
+         LU(i,j) = t;
+      }
+      double big = 0.0;
+      for (size_t i = j; i < N; i++)
+      {
+         double t = LU(i,j);
+         for (size_t k = 0; k < j; k++) t -= LU(i,k)*LU(k,j);
+         LU(i,j) = t;
+         double d = V(i)*std::abs(t);
+         if (d >= big) { big = d; imax = i; }
+      }
+      if (j != imax)
+      {
+         LU.swapRows(imax, j);
+         V(imax) = V(j);
+         parity = -parity;
+      }
+      Pivot(j) = imax;
+      if (j != N-1)
+      {
+         double d = 1.0/LU(j,j);
+         for (size_t i = j+1; i < N; i++) LU(i,j) *= d;
+      }
+   }
+}
+
+Matrix<double> refInverseLUD(const Matrix<double>& m)
+{
+   Matrix<double> LU;
+   Vector<int> Pivot;
+   int parity;
+   refLUD(m, LU, Pivot, parity);
+   size_t N = m.rows();
+   Matrix<double> inv(N, N);
+   Vector<double> v(N);
+   for (size_t c = 0; c < N; c++)
+   {
+      v = 0.0;
+      v(c) = 1.0;
+      bool first = true;
+      size_t ii = 0;
+      for (size_t i = 0; i < N; i++)
+      {
+         double sum = v(Pivot(i));
+         v(Pivot(i)) = v(i);
+         if (first && sum != 0.0) { ii = i; first = false; }
+         else if (!first)
+            for (size_t j = ii; j < i; j++) sum -= LU(i,j)*v(j);
+         v(i) = sum;
+      }
+      for (size_t i = N-1; ; i--)
+      {
+         double sum = v(i);
+         for (size_t j = i+1; j < N; j++) sum -= LU(i,j)*v(j);
+         v(i) = sum / LU(i,i);
+         if (i == 0) break;
+      }
+      for (size_t i = 0; i < N; i++) inv(i,c) = v(i);
+   }
+   return inv;
+}
+
+
+   // True when a and b hold the same bits.
+template <class BaseClass1, class BaseClass2>
+bool same(const ConstMatrixBase<double, BaseClass1>& a,
+          const ConstMatrixBase<double, BaseClass2>& b)
+{
+   if (a.rows() != b.rows() || a.cols() != b.cols()) return false;
+   for (size_t i = 0; i < a.rows(); i++)
+      for (size_t j = 0; j < a.cols(); j++)
+      {
+         double x = a(i,j), y = b(i,j);
+         if (memcmp(&x, &y, sizeof(double)) != 0) return false;
+      }
+   return true;
+}
+
+bool same(const Vector<double>& a, const Vector<double>& b)
+{
+   if (a.size() != b.size()) return false;
+   return memcmp(a.begin(), b.begin(), a.size()*sizeof(double)) == 0;
+}
+
+int failures = 0;
+
+void report(const string& what, size_t n, bool ok, double tRef, double tNew)
+{
+   cout << setw(12) << left << what << right << setw(6) << n
+        << (ok ? "  same  " : "  DIFFER")
+        << fixed << setprecision(4) << setw(10) << tRef
+        << setw(10) << tNew << endl;
+   if (!ok) failures++;
+}
+
+double seconds(clock_t start)
+{
+   return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+
+/// Returns 0 if every kernel reproduces the generic results exactly.
+int main(int argc, char *argv[])
+{
+   vector<size_t> sizes;
+   for (int i = 1; i < argc; i++)
+      sizes.push_back(atoi(argv[i]));
+   if (sizes.empty())
+   {
+      sizes.push_back(7);
+      sizes.push_back(33);
+      sizes.push_back(100);
+      sizes.push_back(257);
+   }
+
+   srand(1234);
+   cout << "operation     size  result  generic   blocked   (seconds)"
+        << endl;
+
+   try
+   {
+      for (size_t s = 0; s < sizes.size(); s++)
+      {
+         const size_t n = sizes[s];
+         Matrix<double> A(n, n), B(n, n+3), S;
+         Vector<double> v(n);
+         for (size_t i = 0; i < n; i++)
+         {
+            v(i) = rand() / double(RAND_MAX) - 0.5;
+            for (size_t j = 0; j < n; j++)
+               A(i,j) = rand() / double(RAND_MAX) - 0.5;
+            for (size_t j = 0; j < n+3; j++)
+               B(i,j) = rand() / double(RAND_MAX) - 0.5;
+         }
+            // symmetric positive definite
+         S = refMultiply(refTranspose(A), A);
+         for (size_t i = 0; i < n; i++)
+            S(i,i) += 1.0;
+
+         clock_t t0;
+         double tRef, tNew;
+
+         t0 = clock();
+         Matrix<double> P1 = refMultiply(A, B);
+         tRef = seconds(t0);
+         t0 = clock();
+         Matrix<double> P2 = A * B;
+         tNew = seconds(t0);
+         report("A*B", n, same(P1, P2), tRef, tNew);
+
+         t0 = clock();
+         Vector<double> w1 = refMultiply(A, v);
+         tRef = seconds(t0);
+         t0 = clock();
+         Vector<double> w2 = A * v;
+         tNew = seconds(t0);
+         report("A*v", n, same(w1, w2), tRef, tNew);
+
+         t0 = clock();
+         Matrix<double> T1 = refTranspose(B);
+         tRef = seconds(t0);
+         t0 = clock();
+         Matrix<double> T2 = transpose(B);
+         tNew = seconds(t0);
+         report("transpose", n, same(T1, T2), tRef, tNew);
+
+         t0 = clock();
+         Matrix<double> L1 = refCholesky(S);
+         tRef = seconds(t0);
+         t0 = clock();
+         CholeskyCrout<double> CC;
+         CC(S);
+         tNew = seconds(t0);
+         report("Cholesky", n, same(L1, CC.L), tRef, tNew);
+
+         t0 = clock();
+         Matrix<double> C1 = refInverseChol(S);
+         tRef = seconds(t0);
+         t0 = clock();
+         Matrix<double> C2 = inverseChol(S);
+         tNew = seconds(t0);
+         report("inverseChol", n, same(C1, C2), tRef, tNew);
+
+         Matrix<double> LU1;
+         Vector<int> piv1;
+         int par1;
+         t0 = clock();
+         refLUD(A, LU1, piv1, par1);
+         tRef = seconds(t0);
+         t0 = clock();
+         LUDecomp<double> LUD;
+         LUD(A);
+         tNew = seconds(t0);
+         bool ok = same(LU1, LUD.LU) && par1 == LUD.parity;
+         for (size_t i = 0; ok && i < n; i++)
+            ok = (piv1(i) == LUD.Pivot(i));
+         report("LUDecomp", n, ok, tRef, tNew);
+
+         t0 = clock();
+         Matrix<double> I1 = refInverseLUD(A);
+         tRef = seconds(t0);
+         t0 = clock();
+         Matrix<double> I2 = inverseLUD(A);
+         tNew = seconds(t0);
+         report("inverseLUD", n, same(I1, I2), tRef, tNew);
+
+            // a slice keeps inverse() on the generic code
+         ConstMatrixSlice<double> As(A, 0, 0, n, n);
+         t0 = clock();
+         Matrix<double> G1 = inverse(As);
+         tRef = seconds(t0);
+         t0 = clock();
+         Matrix<double> G2 = inverse(A);
+         tNew = seconds(t0);
+         report("inverse", n, same(G1, G2), tRef, tNew);
+      }
+   }
+   catch (Exception& e)
+   {
+      cout << e << endl;
+      return 1;
+   }
+
+   cout << (failures ? "FAILED" : "all results identical") << endl;
+   return failures;
+}
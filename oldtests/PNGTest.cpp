@@ -0,0 +1,558 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2009, The University of Texas at Austin
+//
+//============================================================================
+
+
+/**
+ * @file PNGTest.cpp
+ * Checks the vdraw Deflater and PNG encoder by decoding what they write,
+ * and times PNG encoding and the rendering of a large SurfacePlot.
+ *
+ * Usage: PNGTest [size]   (default 1200, the side of the surface plot)
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <cstdlib>
+#include <cmath>
+
+#include "Deflater.hpp"
+#include "PNG.hpp"
+#include "CRC32.hpp"
+#include "Adler32.hpp"
+#include "SVGImage.hpp"
+#include "SurfacePlot.hpp"
+
+using namespace std;
+using namespace vdraw;
+using namespace vplot;
+
+
+   // A small inflater (RFC 1951), written straight from the RFC for
+   // checking, in the manner of zlib's puff.c.
+class Inflater
+{
+public:
+   Inflater(const string& s)
+      : in(s), pos(0), bitBuf(0), bitCount(0)
+   {}
+
+      // Decode a zlib stream; throws a string on any error
+   string zlib()
+   {
+      if (in.size() < 6)
+         throw string("zlib stream too short");
+      int cmf = (unsigned char)in[0], flg = (unsigned char)in[1];
+      if ((cmf & 0x0f) != 8 || (cmf*256 + flg) % 31)
+         throw string("bad zlib header");
+      pos = 2;
+      int last;
+      do
+      {
+         last = bits(1);
+         int type = bits(2);
+         if (type == 0)
+            stored();
+         else if (type == 1)
+            fixed();
+         else if (type == 2)
+            dynamic();
+         else
+            throw string("bad block type");
+      } while (!last);
+
+      unsigned int a = 0;
+      for (int i = 0; i < 4; i++)
+      {
+         if (pos >= in.size())
+            throw string("missing Adler-32");
+         a = (a << 8) | (unsigned char)in[pos++];
+      }
+      Adler32 check;
+      check.update(out);
+      if (a != check.getValue())
+         throw string("Adler-32 mismatch");
+      return out;
+   }
+
+private:
+   struct Huffman
+   {
+      short count[16];
+      short symbol[288];
+   };
+
+   int bits(int n)
+   {
+      while (bitCount < n)
+      {
+         if (pos >= in.size())
+            throw string("ran out of input");
+         bitBuf |= (unsigned long)(unsigned char)in[pos++] << bitCount;
+         bitCount += 8;
+      }
+      int v = bitBuf & ((1UL << n) - 1);
+      bitBuf >>= n;
+      bitCount -= n;
+      return v;
+   }
+
+   void stored()
+   {
+      bitBuf = 0;
+      bitCount = 0;
+      if (pos + 4 > in.size())
+         throw string("ran out of input");
+      unsigned int len = (unsigned char)in[pos] |
+                         ((unsigned char)in[pos+1] << 8);
+      unsigned int nlen = (unsigned char)in[pos+2] |
+                          ((unsigned char)in[pos+3] << 8);
+      pos += 4;
+      if (len != (~nlen & 0xffff) || pos + len > in.size())
+         throw string("bad stored block");
+      out.append(in, pos, len);
+      pos += len;
+   }
+
+   void build(Huffman& h, const short* length, int n)
+   {
+      for (int len = 0; len < 16; len++)
+         h.count[len] = 0;
+      for (int s = 0; s < n; s++)
+         h.count[length[s]]++;
+      int left = 1;
+      for (int len = 1; len < 16; len++)
+      {
+         left <<= 1;
+         left -= h.count[len];
+         if (left < 0)
+            throw string("over-subscribed code");
+      }
+      short offs[16];
+      offs[1] = 0;
+      for (int len = 1; len < 15; len++)
+         offs[len+1] = offs[len] + h.count[len];
+      for (int s = 0; s < n; s++)
+         if (length[s])
+            h.symbol[offs[length[s]]++] = s;
+   }
+
+   int decode(const Huffman& h)
+   {
+      int code = 0, first = 0, index = 0;
+      for (int len = 1; len < 16; len++)
+      {
+         code |= bits(1);
+         int count = h.count[len];
+         if (code - count < first)
+            return h.symbol[index + (code - first)];
+         index += count;
+         first += count;
+         first <<= 1;
+         code <<= 1;
+      }
+      throw string("bad code");
+   }
+
+   void codes(const Huffman& lencode, const Huffman& distcode)
+   {
+      static const short lbase[29] = {
+         3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+         35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+      static const short lext[29] = {
+         0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+         3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+      static const short dbase[30] = {
+         1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+         257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+         8193, 12289, 16385, 24577};
+      static const short dext[30] = {
+         0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+         7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+      for (;;)
+      {
+         int symbol = decode(lencode);
+         if (symbol < 256)
+            out += (char)symbol;
+         else if (symbol == 256)
+            return;
+         else
+         {
+            symbol -= 257;
+            if (symbol >= 29)
+               throw string("bad length symbol");
+            int len = lbase[symbol] + bits(lext[symbol]);
+            symbol = decode(distcode);
+            if (symbol >= 30)
+               throw string("bad distance symbol");
+            size_t dist = dbase[symbol] + bits(dext[symbol]);
+            if (dist > out.size() || dist > 32768)
+               throw string("distance too far back");
+            for (int i = 0; i < len; i++)
+               out += out[out.size() - dist];
+         }
+      }
+   }
+
+   void fixed()
+   {
+      Huffman lencode, distcode;
+      short lengths[288];
+      int s;
+      for (s = 0; s < 144; s++) lengths[s] = 8;
+      for (; s < 256; s++) lengths[s] = 9;
+      for (; s < 280; s++) lengths[s] = 7;
+      for (; s < 288; s++) lengths[s] = 8;
+      build(lencode, lengths, 288);
+      for (s = 0; s < 30; s++) lengths[s] = 5;
+      build(distcode, lengths, 30);
+      codes(lencode, distcode);
+   }
+
+   void dynamic()
+   {
+      static const short order[19] =
+         {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+      int nlen = bits(5) + 257;
+      int ndist = bits(5) + 1;
+      int ncode = bits(4) + 4;
+      if (nlen > 286 || ndist > 30)
+         throw string("bad counts");
+
+      short lengths[316];
+      int index;
+      for (index = 0; index < ncode; index++)
+         lengths[order[index]] = bits(3);
+      for (; index < 19; index++)
+         lengths[order[index]] = 0;
+      Huffman lencode, distcode;
+      build(lencode, lengths, 19);
+
+      index = 0;
+      while (index < nlen + ndist)
+      {
+         int symbol = decode(lencode);
+         if (symbol < 16)
+            lengths[index++] = symbol;
+         else
+         {
+            int len = 0, rep;
+            if (symbol == 16)
+            {
+               if (index == 0)
+                  throw string("repeat with no first length");
+               len = lengths[index - 1];
+               rep = 3 + bits(2);
+            }
+            else if (symbol == 17)
+               rep = 3 + bits(3);
+            else
+               rep = 11 + bits(7);
+            if (index + rep > nlen + ndist)
+               throw string("too many lengths");
+            while (rep--)
+               lengths[index++] = len;
+         }
+      }
+      if (lengths[256] == 0)
+         throw string("no end-of-block code");
+      build(lencode, lengths, nlen);
+      build(distcode, lengths + nlen, ndist);
+      codes(lencode, distcode);
+   }
+
+   const string& in;
+   size_t pos;
+   unsigned long bitBuf;
+   int bitCount;
+   string out;
+};
+
+
+   // Decode a PNG as written by vdraw: check the chunks, inflate the image
+   // data and undo the filters. Returns the rows without the filter bytes.
+string unpng(const string& png, int& width, int& height, int& colorType)
+{
+   if (png.compare(0, 8, "\211PNG\r\n\032\n"))
+      throw string("bad signature");
+   string idat;
+   size_t pos = 8;
+   bool end = false;
+   while (!end)
+   {
+      if (pos + 12 > png.size())
+         throw string("truncated chunk");
+      unsigned int len = 0;
+      for (int i = 0; i < 4; i++)
+         len = (len << 8) | (unsigned char)png[pos+i];
+      string type = png.substr(pos + 4, 4);
+      string data = png.substr(pos + 8, len);
+      unsigned int crc = 0;
+      for (int i = 0; i < 4; i++)
+         crc = (crc << 8) | (unsigned char)png[pos+8+len+i];
+      CRC32 check;
+      check.update(type);
+      check.update(data);
+      if (crc != check.getValue())
+         throw string("bad CRC in ") + type;
+      pos += 12 + len;
+
+      if (type == "IHDR")
+      {
+         width = height = 0;
+         for (int i = 0; i < 4; i++)
+         {
+            width = (width << 8) | (unsigned char)data[i];
+            height = (height << 8) | (unsigned char)data[4+i];
+         }
+         colorType = data[9];
+      }
+      else if (type == "IDAT")
+         idat += data;
+      else if (type == "IEND")
+         end = true;
+   }
+
+   string raw = Inflater(idat).zlib();
+   int bpp = (colorType == 2) ? 3 : 1;
+   size_t rowBytes = bpp * width;
+   if (raw.size() != (rowBytes + 1) * height)
+      throw string("wrong amount of image data");
+
+   string img(rowBytes * height, '\0');
+   for (int r = 0; r < height; r++)
+   {
+      int filter = raw[r * (rowBytes + 1)];
+      const unsigned char* f =
+         (const unsigned char*)raw.data() + r * (rowBytes + 1) + 1;
+      for (size_t i = 0; i < rowBytes; i++)
+      {
+         int a = (i >= (size_t)bpp) ? (unsigned char)img[r*rowBytes+i-bpp] : 0;
+         int b = r ? (unsigned char)img[(r-1)*rowBytes+i] : 0;
+         int c = (r && i >= (size_t)bpp) ?
+            (unsigned char)img[(r-1)*rowBytes+i-bpp] : 0;
+         int p = a + b - c, pa = abs(p-a), pb = abs(p-b), pc = abs(p-c);
+         int pred = 0;
+         switch (filter)
+         {
+            case 0: pred = 0; break;
+            case 1: pred = a; break;
+            case 2: pred = b; break;
+            case 3: pred = (a + b) >> 1; break;
+            case 4: pred = (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+               break;
+            default: throw string("bad filter type");
+         }
+         img[r*rowBytes+i] = (char)(f[i] + pred);
+      }
+   }
+   return img;
+}
+
+
+double seconds(clock_t t0)
+{
+   return double(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+
+int failures = 0;
+
+void check(const string& what, bool ok)
+{
+   cout << setw(40) << left << what << (ok ? "ok" : "FAILED") << endl;
+   if (!ok)
+      failures++;
+}
+
+
+   // Test data: runs, noise and repeats, much like a plot with a few
+   // smooth areas
+string testData(size_t n)
+{
+   string s;
+   while (s.size() < n)
+   {
+      int kind = rand() % 3;
+      int len = 1 + rand() % 400;
+      if (kind == 0)
+         s.append(len, (char)(rand() % 4));
+      else if (kind == 1)
+         for (int i = 0; i < len; i++)
+            s += (char)rand();
+      else if (s.size() > 1000)
+         s += s.substr(s.size() - 1 - rand() % 1000, len);
+   }
+   s.resize(n);
+   return s;
+}
+
+
+   // A field with rings and some noise
+double field(int i, int j, int n)
+{
+   double x = i - n/2.0, y = j - n/2.0;
+   double r = sqrt(x*x + y*y);
+   return sin(r / n * 25.0) * cos(y / n * 7.0) + 0.02 * (rand() % 100) / 100.0;
+}
+
+
+int main(int argc, char* argv[])
+{
+   int n = (argc > 1) ? atoi(argv[1]) : 1200;
+   srand(1);
+   cout << fixed << setprecision(3);
+
+   try
+   {
+         // The compressor on its own, every level, input given in pieces
+      size_t sizes[] = {0, 1, 2, 100, 40000, 70000, 300000};
+      for (int s = 0; s < 7; s++)
+      {
+         string data = testData(sizes[s]);
+         for (int level = 1; level <= 9; level += 4)
+         {
+            Deflater d(level);
+            string z;
+            for (size_t i = 0; i < data.size(); )
+            {
+               size_t len = 1 + rand() % 20000;
+               if (len > data.size() - i)
+                  len = data.size() - i;
+               d.write(data.data() + i, len);
+               i += len;
+               z += d.getOutput();
+               d.clearOutput();
+            }
+            d.finish();
+            z += d.getOutput();
+            ostringstream what;
+            what << "deflate " << sizes[s] << " bytes, level " << level;
+            check(what.str(), Inflater(z).zlib() == data);
+         }
+      }
+
+         // Indexed and truecolor images, with oversampling
+      Palette p(Color::GREY, -1, 1);
+      p.setColor(0.00, Color(Color::BLUE));
+      p.setColor(0.50, Color(Color::YELLOW));
+      p.setColor(1.00, Color(Color::RED));
+
+      int rows = 150, cols = 201;
+      InterpolatedColorMap icm(cols, rows, p);
+      ColorMap cm(cols, rows);
+      for (int i = 0; i < rows; i++)
+         for (int j = 0; j < cols; j++)
+         {
+            double v = (field(i, j, rows) + 1) / 2;
+            icm.setColor(i, j, v);
+            cm.setColor(i, j, p.getColor(v));
+         }
+
+      int w, h, type;
+      string img = unpng(*PNG::png(icm, 2, 3), w, h, type);
+      bool ok = (w == 3*cols && h == 2*rows && type == 3);
+      for (int i = 0; ok && i < h; i++)
+         for (int j = 0; ok && j < w; j++)
+            ok = ((unsigned char)img[i*w+j] ==
+                  (((int)(icm.getIndex(i/2, j/3) * 255)) & 0xff));
+      check("indexed PNG", ok);
+
+      img = unpng(*PNG::png(cm, 3, 2), w, h, type);
+      ok = (w == 2*cols && h == 3*rows && type == 2);
+      for (int i = 0; ok && i < h; i++)
+         for (int j = 0; ok && j < w; j++)
+         {
+            int rgb = cm.get(i/3, j/2).getRGB();
+            ok = ((unsigned char)img[3*(i*w+j)]   == ((rgb >> 16) & 0xff) &&
+                  (unsigned char)img[3*(i*w+j)+1] == ((rgb >> 8) & 0xff) &&
+                  (unsigned char)img[3*(i*w+j)+2] == (rgb & 0xff));
+         }
+      check("truecolor PNG", ok);
+
+         // Timing of a large map on its own
+      InterpolatedColorMap big(n, n, p);
+      ColorMap bigc(n, n);
+      for (int i = 0; i < n; i++)
+         for (int j = 0; j < n; j++)
+         {
+            double v = (field(i, j, n) + 1) / 2;
+            big.setColor(i, j, v);
+            bigc.setColor(i, j, p.getColor(v));
+         }
+
+      clock_t t0 = clock();
+      size_t isize = PNG::png(big)->size();
+      double ti = seconds(t0);
+      t0 = clock();
+      size_t csize = PNG::png(bigc)->size();
+      double tc = seconds(t0);
+
+      double raw = double(n) * n;
+      cout << endl
+           << "indexed   " << n << "x" << n << ": " << ti << " s, "
+           << raw / 1e6 / ti << " Mpixel/s, " << isize << " bytes ("
+           << 100.0 * isize / raw << "% of raw)" << endl
+           << "truecolor " << n << "x" << n << ": " << tc << " s, "
+           << raw / 1e6 / tc << " Mpixel/s, " << csize << " bytes ("
+           << 100.0 * csize / (3 * raw) << "% of raw)" << endl;
+
+         // A whole surface plot with its key, as SVG
+      SurfacePlot sp(n, n, p);
+      sp.setColorLabel("Ring value");
+      sp.setXAxis(-1, 1);
+      sp.setYAxis(-1, 1);
+      for (int i = 0; i < n; i++)
+         for (int j = 0; j < n; j++)
+            sp.set(i, j, field(i, j, n));
+
+      ostringstream svg;
+      t0 = clock();
+      {
+         SVGImage image(svg, n + 200, n + 100);
+         Frame f(image);
+         sp.draw(&f, 0);
+      }
+      double ts = seconds(t0);
+      cout << "SurfacePlot " << n << "x" << n << " to SVG: " << ts << " s, "
+           << svg.str().size() << " bytes" << endl;
+   }
+   catch (string& e)
+   {
+      cout << "decoding failed: " << e << endl;
+      return 1;
+   }
+   catch (VDrawException& e)
+   {
+      cout << e.what() << endl;
+      return 1;
+   }
+
+   cout << (failures ? "FAILED" : "all images decoded") << endl;
+   return failures;
+}
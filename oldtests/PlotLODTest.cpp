@@ -0,0 +1,183 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2009, The University of Texas at Austin
+//
+//============================================================================
+
+
+/**
+ * @file PlotLODTest.cpp
+ * Checks that LinePlot and ScatterPlot reduce long series to what can be
+ * seen in the frame, and times drawing them to SVG with and without the
+ * reduction.
+ *
+ * Usage: PlotLODTest [points] [series]   (default 86400 points, 1 series)
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <cstdlib>
+#include <cmath>
+
+#include "SVGImage.hpp"
+#include "LinePlot.hpp"
+#include "ScatterPlot.hpp"
+
+using namespace std;
+using namespace vdraw;
+using namespace vplot;
+
+
+int failures = 0;
+
+void check(const string& what, bool ok)
+{
+   if (!ok)
+   {
+      cout << "FAILED: " << what << endl;
+      failures++;
+   }
+}
+
+
+double seconds(clock_t t0)
+{
+   return double(clock() - t0) / CLOCKS_PER_SEC;
+}
+
+
+   // Number of points drawn with markers in an SVG document, i.e. the
+   // points of the polylines that have a marker-mid.
+size_t countMarkers(const string& svg)
+{
+   size_t n = 0;
+   string::size_type pos = 0;
+   while ((pos = svg.find("marker-mid=", pos)) != string::npos)
+   {
+      string::size_type b = svg.find("points=\"", pos);
+      if (b == string::npos)
+         break;
+      b += 8;
+      string::size_type e = svg.find('"', b);
+      for (string::size_type i = b; i < e; i++)
+         if (svg[i] == ',')
+            n++;
+      pos = e;
+   }
+   return n;
+}
+
+
+   // Draws the series to an 800x600 SVG at the given resolution
+string draw(vector< vector< pair<double,double> > >& data,
+            bool scatter, double resolution, double& t)
+{
+   ostringstream svg;
+   clock_t t0 = clock();
+   {
+      SVGImage image(svg, 800, 600);
+      Frame f(image);
+      if (scatter)
+      {
+         ScatterPlot sp;
+         sp.setResolution(resolution);
+         for (size_t s = 0; s < data.size(); s++)
+            sp.addSeries("series", data[s]);
+         sp.drawPlot(f);
+      }
+      else
+      {
+         LinePlot lp;
+         lp.setResolution(resolution);
+         for (size_t s = 0; s < data.size(); s++)
+            lp.addSeries("series", data[s]);
+         lp.draw(f, 0);
+      }
+   }
+   t = seconds(t0);
+   return svg.str();
+}
+
+
+int main(int argc, char* argv[])
+{
+   int npts = (argc > 1) ? atoi(argv[1]) : 86400;
+   int nser = (argc > 2) ? atoi(argv[2]) : 1;
+
+   cout << fixed << setprecision(3);
+
+   try
+   {
+         // A day of 1 s samples: a slow signal with noise
+      srand(1);
+      vector< vector< pair<double,double> > > data(nser);
+      for (int s = 0; s < nser; s++)
+         for (int i = 0; i < npts; i++)
+            data[s].push_back(make_pair(double(i),
+               sin(i / 3000.0 + s) * (1 + 0.1 * s) +
+               0.3 * (rand() / double(RAND_MAX) - 0.5)));
+
+      for (int scatter = 0; scatter < 2; scatter++)
+      {
+         double tAll, tLod;
+         string all = draw(data, scatter, 0, tAll);
+         string lod = draw(data, scatter, 2, tLod);
+         cout << (scatter ? "scatter" : "line   ") << " " << nser << "x"
+              << npts << ": every point " << tAll << " s, "
+              << all.size() << " bytes; reduced " << tLod << " s, "
+              << lod.size() << " bytes" << endl;
+         check(scatter ? "scatter reduced" : "line reduced",
+               lod.size() < all.size());
+      }
+
+         // Points everywhere in the box: no more markers than fit without
+         // overlapping, i.e. one per marker sized cell of the frame.
+      vector< vector< pair<double,double> > > cloud(1);
+      for (int i = 0; i < 1000000; i++)
+         cloud[0].push_back(make_pair(rand() / double(RAND_MAX),
+                                      rand() / double(RAND_MAX)));
+      double t;
+      string svg = draw(cloud, true, 2, t);
+      size_t kept = countMarkers(svg);
+      double range = ScatterPlot().pickNextMarker(0).getRange();
+      double cells = ceil(800 / (2 * range)) * ceil(600 / (2 * range));
+      cout << "scatter cloud of 1000000: " << t << " s, " << kept
+           << " markers, " << svg.size() << " bytes" << endl;
+      check("markers at most one per cell", kept > 0 && kept <= cells);
+
+         // Drawing every point still does
+      string every = draw(cloud, true, 0, t);
+      check("resolution 0 draws every point",
+            countMarkers(every) == cloud[0].size());
+   }
+   catch (VDrawException& e)
+   {
+      cout << e.what() << endl;
+      return 1;
+   }
+
+   cout << (failures ? "FAILED" : "All checks passed") << endl;
+   return failures;
+}
@@ -0,0 +1,198 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2006, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file RinexObsMapTest.cpp
+ * Compares the memory-mapped RinexObsStream read mode with the ordinary
+ * stream path: every record must come out the same, and the time taken
+ * by each path is reported.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <ctime>
+#include <cstdlib>
+
+#include "RinexObsData.hpp"
+#include "RinexObsHeader.hpp"
+#include "RinexObsStream.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   // Read every record of the file, in mapped mode or not.
+double readAll( const char* fn, bool mapped, int passes,
+                vector<RinexObsData>& records )
+{
+   clock_t start = clock();
+
+   for (int pass = 0; pass < passes; pass++)
+   {
+      records.clear();
+
+      RinexObsStream strm(fn);
+      strm.exceptions(ios::failbit);
+      if (mapped && !strm.mapFile())
+      {
+         cout << "Unable to map " << fn << endl;
+         exit(1);
+      }
+
+      RinexObsHeader roh;
+      RinexObsData rod;
+      strm >> roh;
+      while (strm >> rod)
+      {
+         records.push_back(rod);
+      }
+   }
+
+   return double(clock() - start) / CLOCKS_PER_SEC / passes;
+}
+
+
+bool sameRecord(const RinexObsData& a, const RinexObsData& b)
+{
+   if ( a.time != b.time || a.epochFlag != b.epochFlag ||
+        a.numSvs != b.numSvs || a.clockOffset != b.clockOffset ||
+        a.obs.size() != b.obs.size() )
+   {
+      return false;
+   }
+
+   RinexObsData::RinexSatMap::const_iterator ia, ib;
+   for (ia = a.obs.begin(), ib = b.obs.begin(); ia != a.obs.end(); ia++, ib++)
+   {
+      if (ia->first != ib->first || ia->second.size() != ib->second.size())
+      {
+         return false;
+      }
+
+      RinexObsData::RinexObsTypeMap::const_iterator ja, jb;
+      for (ja = ia->second.begin(), jb = ib->second.begin();
+           ja != ia->second.end(); ja++, jb++)
+      {
+         if ( !(ja->first == jb->first) ||
+              ja->second.data != jb->second.data ||
+              ja->second.lli != jb->second.lli ||
+              ja->second.ssi != jb->second.ssi )
+         {
+            return false;
+         }
+      }
+   }
+
+   return true;
+}
+
+
+/// Returns 0 if the mapped and stream paths agree.
+int main(int argc, char *argv[])
+{
+
+   if (argc < 2)
+   {
+      cout << "RinexObsMapTest obsfile [passes]" << endl;
+      return -1;
+   }
+
+   int passes = (argc > 2) ? atoi(argv[2]) : 5;
+   if (passes < 1)
+   {
+      passes = 1;
+   }
+
+   try
+   {
+      vector<RinexObsData> streamRecs, mappedRecs;
+
+      double tStream = readAll(argv[1], false, passes, streamRecs);
+      double tMapped = readAll(argv[1], true, passes, mappedRecs);
+
+      cout << "File: " << argv[1] << ", " << streamRecs.size()
+           << " epochs, " << passes << " passes" << endl;
+      cout << fixed << setprecision(4);
+      cout << setw(18) << "stream path" << setw(12) << tStream << " s" << endl;
+      cout << setw(18) << "mapped path" << setw(12) << tMapped << " s" << endl;
+      if (tMapped > 0)
+      {
+         cout << setw(18) << "speedup" << setw(12) << tStream / tMapped
+              << endl;
+      }
+
+      bool same = (streamRecs.size() == mappedRecs.size());
+      for (size_t i = 0; same && i < streamRecs.size(); i++)
+      {
+         if (!sameRecord(streamRecs[i], mappedRecs[i]))
+         {
+            cout << "Record " << i << " differs" << endl;
+            same = false;
+         }
+      }
+
+         // Random access through the epoch index
+      RinexObsStream strm(argv[1]);
+      strm.exceptions(ios::failbit);
+      strm.mapFile();
+      size_t n = strm.indexEpochs();
+      if (n != streamRecs.size())
+      {
+         cout << "Index has " << n << " epochs" << endl;
+         same = false;
+      }
+      for (size_t k = 0; same && k < n; k += 97)
+      {
+         size_t i = n - 1 - k;
+         RinexObsData rod;
+         strm.seekEpoch(i);
+         strm >> rod;
+         if (!sameRecord(rod, streamRecs[i]))
+         {
+            cout << "Indexed record " << i << " differs" << endl;
+            same = false;
+         }
+      }
+
+      if (same)
+      {
+         cout << "All records match." << endl;
+         return 0;
+      }
+
+      cout << "Mapped and stream records DIFFER." << endl;
+      return 1;
+   }
+   catch(gpstk::Exception& e)
+   {
+      cout << e << endl;
+   }
+   catch(...)
+   {
+      cout << "Some other exception thrown..." << endl;
+   }
+
+   return -1;
+}
@@ -0,0 +1,335 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2006, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file SatTypeValueTableTest.cpp
+ * Checks that satTypeValueTable iterators behave as those of
+ * satTypeValueMap, and runs the PPP processing of example8 with
+ * gnssRinex and with gnssRinexTable objects, checking that the solutions
+ * are the same and timing both.
+ *
+ * The data files of example8 (onsa2240.05o, igs1335[456].sp3,
+ * OCEAN-GOT00.dat and PRN_GPS) are looked for in the directory given as
+ * the argument, or in the current directory.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <ctime>
+
+#include "RinexObsStream.hpp"
+#include "SP3EphemerisStore.hpp"
+#include "TropModel.hpp"
+#include "DataStructures.hpp"
+#include "SatTypeValueTable.hpp"
+#include "RequireObservables.hpp"
+#include "SimpleFilter.hpp"
+#include "XYZ2NEU.hpp"
+#include "BasicModel.hpp"
+#include "LICSDetector2.hpp"
+#include "MWCSDetector.hpp"
+#include "SolidTides.hpp"
+#include "OceanLoading.hpp"
+#include "PoleTides.hpp"
+#include "CorrectObservables.hpp"
+#include "ComputeWindUp.hpp"
+#include "ComputeSatPCenter.hpp"
+#include "ComputeTropModel.hpp"
+#include "ComputeLinear.hpp"
+#include "LinearCombinations.hpp"
+#include "ComputeDOP.hpp"
+#include "SatArcMarker.hpp"
+#include "GravitationalDelay.hpp"
+#include "PhaseCodeAlignment.hpp"
+#include "EclipsedSatFilter.hpp"
+#include "Decimate.hpp"
+#include "SolverPPP.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+int failures = 0;
+
+void check(bool ok, const string& what)
+{
+   if (!ok)
+   {
+      cout << "FAILED: " << what << endl;
+      failures++;
+   }
+}
+
+
+   // A reference to what an iterator points to must not depend on the
+   // iterator, as with satTypeValueMap.
+void checkIterators()
+{
+   satTypeValueMap stvMap;
+   for (int prn = 1; prn <= 8; prn++)
+   {
+      SatID sat(prn, SatID::systemGPS);
+      stvMap[sat][TypeID::C1] = 2.0e7 + prn;
+      stvMap[sat][TypeID::L1] = 1.0e8 + prn;
+   }
+
+   satTypeValueTable table(stvMap);
+   SatID sat3(3, SatID::systemGPS);
+
+   const satTypeValueTable::value_type& found = *table.find(sat3);
+   satTypeValueTable::iterator it = table.begin();
+   const satTypeValueTable::value_type& first = *it;
+   ++it;
+   ++it;
+   table.find(SatID(7, SatID::systemGPS));
+
+   check( first.first == SatID(1, SatID::systemGPS) &&
+          first.second.getValue(TypeID::C1) == 2.0e7 + 1,
+          "reference kept across ++it" );
+   check( found.first == sat3 &&
+          found.second.getValue(TypeID::L1) == 1.0e8 + 3,
+          "reference from find() kept" );
+
+      // Values written through a kept reference land in the table
+   typeValueRow& row = (*table.find(sat3)).second;
+   row[TypeID::P2] = 5.0;
+   check( table.getValue(sat3, TypeID::P2) == 5.0, "write through row" );
+
+      // A copy has rows of its own
+   satTypeValueTable copy(table);
+   (*copy.find(sat3)).second[TypeID::P2] = 6.0;
+   check( table.getValue(sat3, TypeID::P2) == 5.0 &&
+          copy.getValue(sat3, TypeID::P2) == 6.0, "copy is independent" );
+   copy = table;
+   check( copy.find(sat3)->second.getValue(TypeID::P2) == 5.0,
+          "assigned copy" );
+
+      // Inserting and removing satellites keeps the rows in step
+   table.removeSatID(SatID(2, SatID::systemGPS));
+   table[SatID(10, SatID::systemGPS)][TypeID::C1] = 1.0;
+   bool inStep = true;
+   for (satTypeValueTable::const_iterator ci = table.begin();
+        ci != table.end();
+        ++ci)
+   {
+      inStep = inStep && ( ci->second.getValue(TypeID::C1) ==
+                           table.getValue(ci->first, TypeID::C1) );
+   }
+   check(inStep, "rows in step after insert and remove");
+
+      // Pairs of a row are values, so they outlive the row iterator
+   typeValueMap tvMap( found.second.getTypeValueMap() );
+   typeValueMap::const_iterator mi = tvMap.begin();
+   typeValueRow::const_iterator ri = found.second.begin();
+   const std::pair<TypeID, double>& kept = *ri;
+   ++ri;
+   check( kept.first == mi->first && kept.second == mi->second,
+          "row pair kept across ++" );
+   ++mi;
+   check( ri->first == mi->first && ri->second == mi->second,
+          "row pairs through ->" );
+}
+
+
+   // The same data, as a gnssRinex, for the back end of the chain
+void toRinex(gnssRinex& a, gnssRinex& b)
+{ b = a; }
+
+void toRinex(gnssRinexTable& a, gnssRinex& b)
+{ a.getGnssRinex(b); }
+
+
+   // The processing of example8, with the front end (up to SatArcMarker)
+   // working on a 'G' object. Returns the solutions printed as text.
+template <class G>
+string runPPP( const string& dir,
+               SP3EphemerisStore& SP3EphList,
+               double& tRead,
+               double& tFront,
+               double& tTotal )
+{
+   RinexObsStream rin((dir + "onsa2240.05o").c_str());
+
+   Position nominalPos(3370658.5419, 711877.1496, 5349786.9542);
+   NeillTropModel neillTM( nominalPos.getAltitude(),
+                           nominalPos.getGeodeticLatitude(), 224 );
+   XYZ2NEU baseChange(nominalPos);
+
+   RequireObservables requireObs(TypeID::P1);
+   requireObs.addRequiredType(TypeID::P2);
+   requireObs.addRequiredType(TypeID::L1);
+   requireObs.addRequiredType(TypeID::L2);
+
+   SimpleFilter pcFilter;
+   pcFilter.setFilteredType(TypeID::PC);
+
+   BasicModel basic(nominalPos, SP3EphList);
+   LICSDetector2 markCSLI;
+   MWCSDetector markCSMW;
+
+   SolidTides solid;
+   OceanLoading ocean((dir + "OCEAN-GOT00.dat").c_str());
+   PoleTides pole(0.02094, 0.42728);
+
+   Triple offsetL1(0.0780, 0.0, 0.0), offsetL2(0.096, 0.0, 0.0);
+   Triple offsetARP(0.9950, 0.0, 0.0);
+   CorrectObservables corr(SP3EphList);
+   corr.setNominalPosition(nominalPos);
+   corr.setL1pc(offsetL1);
+   corr.setL2pc(offsetL2);
+   corr.setMonument(offsetARP);
+
+   ComputeWindUp windup(SP3EphList, nominalPos, dir + "PRN_GPS");
+   ComputeSatPCenter svPcenter(nominalPos);
+   ComputeTropModel computeTropo(neillTM);
+
+   LinearCombinations comb;
+   ComputeLinear linear1(comb.pdeltaCombination);
+   linear1.addLinear(comb.ldeltaCombination);
+   linear1.addLinear(comb.mwubbenaCombination);
+   linear1.addLinear(comb.liCombination);
+   ComputeLinear linear2(comb.pcCombination);
+   linear2.addLinear(comb.lcCombination);
+   ComputeLinear linear3(comb.pcPrefit);
+   linear3.addLinear(comb.lcPrefit);
+
+   SolverPPP pppSolver(true);
+   SatArcMarker markArc;
+   markArc.setDeleteUnstableSats(true);
+   markArc.setUnstablePeriod(151.0);
+   GravitationalDelay grDelay(nominalPos);
+   PhaseCodeAlignment phaseAlign;
+   ComputeDOP cDOP;
+   EclipsedSatFilter eclipsedSV;
+   Decimate decimateData(900.0, 5.0, SP3EphList.getInitialTime());
+
+   ostringstream os;
+   os << fixed << setprecision(6);
+
+   tRead = tFront = 0.0;
+   clock_t start = clock();
+
+   G gRin;
+   while (true)
+   {
+      clock_t t0 = clock();
+      if (!(rin >> gRin))
+      {
+         break;
+      }
+      tRead += double(clock() - t0) / CLOCKS_PER_SEC;
+
+      DayTime time(gRin.header.epoch);
+      Triple tides( solid.getSolidTide(time, nominalPos) +
+                    ocean.getOceanLoading("ONSA", time) +
+                    pole.getPoleTide(time, nominalPos) );
+      corr.setExtraBiases(tides);
+
+      try
+      {
+         t0 = clock();
+         gRin >> requireObs >> linear1 >> markCSLI >> markCSMW >> markArc;
+         tFront += double(clock() - t0) / CLOCKS_PER_SEC;
+
+         gRin >> decimateData;
+
+         gnssRinex back;
+         toRinex(gRin, back);
+         back >> basic >> eclipsedSV >> grDelay >> svPcenter >> corr
+              >> windup >> computeTropo >> linear2 >> pcFilter
+              >> phaseAlign >> linear3 >> baseChange >> cDOP >> pppSolver;
+      }
+      catch (DecimateEpoch& d)
+      {
+         continue;
+      }
+      catch (Exception& e)
+      {
+         continue;
+      }
+
+      os << time.DOYsecond() << " "
+         << pppSolver.getSolution(TypeID::dLat) << " "
+         << pppSolver.getSolution(TypeID::dLon) << " "
+         << pppSolver.getSolution(TypeID::dH) << endl;
+   }
+
+   tTotal = double(clock() - start) / CLOCKS_PER_SEC;
+
+   return os.str();
+}
+
+
+/// Returns 0 if all the checks pass.
+int main(int argc, char *argv[])
+{
+   checkIterators();
+
+   string dir( (argc > 1) ? string(argv[1]) + "/" : string("") );
+
+   try
+   {
+      SP3EphemerisStore SP3EphList;
+      SP3EphList.rejectBadPositions(true);
+      SP3EphList.rejectBadClocks(true);
+      SP3EphList.loadFile(dir + "igs13354.sp3");
+      SP3EphList.loadFile(dir + "igs13355.sp3");
+      SP3EphList.loadFile(dir + "igs13356.sp3");
+
+      double mapRead, mapFront, mapTotal;
+      double tabRead, tabFront, tabTotal;
+      string mapOut = runPPP<gnssRinex>( dir, SP3EphList,
+                                         mapRead, mapFront, mapTotal );
+      string tabOut = runPPP<gnssRinexTable>( dir, SP3EphList,
+                                              tabRead, tabFront, tabTotal );
+
+      check(!mapOut.empty(), "solutions computed");
+      check(mapOut == tabOut, "same solutions with both structures");
+
+      cout << fixed << setprecision(3)
+           << "                   gnssRinex  gnssRinexTable" << endl
+           << "  RINEX reading   " << setw(8) << mapRead << " s"
+           << setw(12) << tabRead << " s" << endl
+           << "  front end       " << setw(8) << mapFront << " s"
+           << setw(12) << tabFront << " s" << endl
+           << "  whole run       " << setw(8) << mapTotal << " s"
+           << setw(12) << tabTotal << " s" << endl;
+   }
+   catch (Exception& e)
+   {
+      cout << e << endl;
+      return 1;
+   }
+
+   if (failures)
+   {
+      cout << failures << " check(s) failed" << endl;
+      return 1;
+   }
+   cout << "All checks passed" << endl;
+
+   return 0;
+}
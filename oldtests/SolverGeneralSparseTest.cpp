@@ -0,0 +1,344 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2009, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file SolverGeneralSparseTest.cpp
+ * Runs the same synthetic PPP-like network through SolverGeneral in dense
+ * and in sparse mode, checking that states, covariances and postfit
+ * residuals agree, and times both modes for growing networks.
+ *
+ * Usage: SolverGeneralSparseTest [stations ...]
+ *
+ * Each number of stations given is timed over 10 epochs in both modes
+ * (dense mode only up to 20 stations). The default is 5 and 10.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <ctime>
+#include <cstdlib>
+#include <cmath>
+
+#include "SolverGeneral.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+int failures = 0;
+
+void check(bool ok, const string& what)
+{
+   if (!ok)
+   {
+      cout << "FAILED: " << what << endl;
+      failures++;
+   }
+}
+
+
+   // Same value, to a tolerance relative to its size
+bool near(double a, double b)
+{
+   return fabs(a - b) <= 1e-9 * max(1.0, max(fabs(a), fabs(b)));
+}
+
+
+SourceID station(int s)
+{
+   return SourceID(SourceID::GPS, "ST" + StringUtils::asString(s));
+}
+
+
+   // One epoch of the network. Every station sees about 30 satellites,
+   // and satellites rise and set, so ambiguity arcs start and end.
+gnssDataMap makeEpoch(int numStations, int epoch, unsigned& seed)
+{
+   gnssDataMap gdsMap;
+   DayTime time(2008, 1, 1, 0, 0, 0.0);
+   time += 30.0 * epoch;
+
+   for (int s = 0; s < numStations; s++)
+   {
+      gnssRinex gRin;
+      gRin.header.source = station(s);
+      gRin.header.epoch = time;
+
+      for (int prn = 1; prn <= 32; prn++)
+      {
+         if ((prn * 7 + s * 3 + epoch) % 40 >= 30)
+         {
+            continue;
+         }
+
+         double az = prn * 0.7 + s * 0.1 + epoch * 0.01;
+         double el = 0.2 + 0.04 * ((prn + s) % 30);
+         double r1 = rand_r(&seed) / double(RAND_MAX) - 0.5;
+         double r2 = rand_r(&seed) / double(RAND_MAX) - 0.5;
+
+         typeValueMap tvMap;
+         tvMap[TypeID::dx] = -cos(el) * sin(az);
+         tvMap[TypeID::dy] = -cos(el) * cos(az);
+         tvMap[TypeID::dz] = -sin(el);
+         tvMap[TypeID::cdt] = 1.0;
+         tvMap[TypeID::wetMap] = 1.0 / sin(el);
+         tvMap[TypeID::prefitC] = 1.0 + r1;
+         tvMap[TypeID::prefitL] = 1.0 + 0.01 * r2 + 0.1 * prn;
+         tvMap[TypeID::weight] = 1.0;
+
+         gRin.body[SatID(prn, SatID::systemGPS)] = tvMap;
+      }
+
+      gdsMap.addGnssRinex(gRin);
+   }
+
+   return gdsMap;
+}
+
+
+   // Stochastic models of one solver. They keep the time of the last
+   // epoch, so two solvers can not share them.
+struct Models
+{
+   WhiteNoiseModel whiteNoise;
+   RandomWalkModel tropo;
+   StochasticModel constant;
+
+   Models() : tropo(1e-6) {}
+};
+
+
+   // Per-station coordinates, clock and troposphere, and per-arc
+   // ambiguities: every station is a block of its own.
+EquationSystem makeSystem(Models& models)
+{
+   Variable dx(TypeID::dx, &models.whiteNoise, true, false, 100.0);
+   Variable dy(TypeID::dy, &models.whiteNoise, true, false, 100.0);
+   Variable dz(TypeID::dz, &models.whiteNoise, true, false, 100.0);
+   Variable cdt(TypeID::cdt, &models.whiteNoise, true, false, 9.0e10);
+   Variable wet(TypeID::wetMap, &models.tropo, true, false, 0.25);
+   Variable amb(TypeID::BLC, &models.constant, true, true, 9.0e10);
+   amb.setDefaultForced(true);
+
+   Equation code( (Variable(TypeID::prefitC)) );
+   code.addVariable(dx);
+   code.addVariable(dy);
+   code.addVariable(dz);
+   code.addVariable(cdt);
+   code.addVariable(wet);
+
+   Equation phase( (Variable(TypeID::prefitL)) );
+   phase.addVariable(dx);
+   phase.addVariable(dy);
+   phase.addVariable(dz);
+   phase.addVariable(cdt);
+   phase.addVariable(wet);
+   phase.addVariable(amb);
+   phase.setWeight(10000.0);
+
+   EquationSystem system;
+   system.addEquation(code);
+   system.addEquation(phase);
+
+   return system;
+}
+
+
+   // The unknown of 'unknowns' with the type, source and satellite of
+   // 'var'. Unknowns of different systems have different models.
+Variable sameUnknown(const Variable& var, const VariableSet& unknowns)
+{
+   for (VariableSet::const_iterator it = unknowns.begin();
+        it != unknowns.end();
+        ++it)
+   {
+      if ( (*it).getType() == var.getType() &&
+           (*it).getSource() == var.getSource() &&
+           (*it).getSatellite() == var.getSatellite() )
+      {
+         return (*it);
+      }
+   }
+
+   InvalidRequest e("Unknown not found");
+   GPSTK_THROW(e);
+}
+
+
+   // Runs a network of 4 stations through both modes, comparing them
+   // after every epoch.
+void checkSparse()
+{
+   const int numStations = 4;
+
+   Models denseModels, sparseModels;
+   SolverGeneral dense( makeSystem(denseModels) );
+   SolverGeneral sparse( makeSystem(sparseModels) );
+   sparse.setSparseMode(true);
+
+   unsigned seed = 1;
+   bool sameStates = true, sameCovs = true, samePostfits = true;
+   bool blocksZero = true;
+
+   for (int epoch = 0; epoch < 10; epoch++)
+   {
+      gnssDataMap dMap( makeEpoch(numStations, epoch, seed) );
+      gnssDataMap sMap( dMap );
+      dense.Process(dMap);
+      sparse.Process(sMap);
+
+         // The unknowns of both systems, in the same order
+      vector<Variable> dVars, sVars;
+      VariableSet dSet( dense.getEquationSystem().getVarUnknowns() );
+      VariableSet sSet( sparse.getEquationSystem().getVarUnknowns() );
+      check(dSet.size() == sSet.size(), "same number of unknowns");
+      for (VariableSet::const_iterator it = dSet.begin();
+           it != dSet.end();
+           ++it)
+      {
+         dVars.push_back(*it);
+         sVars.push_back( sameUnknown(*it, sSet) );
+      }
+
+      for (size_t i = 0; i < dVars.size(); i++)
+      {
+         sameStates = sameStates && near( dense.getSolution(dVars[i]),
+                                          sparse.getSolution(sVars[i]) );
+
+         for (size_t j = i; j < dVars.size(); j++)
+         {
+            double dc = dense.getCovariance(dVars[i], dVars[j]);
+            double sc = sparse.getCovariance(sVars[i], sVars[j]);
+            sameCovs = sameCovs && near(dc, sc) &&
+                       near(sc, sparse.getCovariance(sVars[j], sVars[i]));
+
+               // Different stations never share a block
+            if (dVars[i].getSource() != dVars[j].getSource())
+            {
+               blocksZero = blocksZero && (sc == 0.0) && near(dc, 0.0);
+            }
+         }
+      }
+
+      for (int s = 0; s < numStations; s++)
+      {
+         gnssRinex dRin( dMap.getGnssRinex(station(s)) );
+         gnssRinex sRin( sMap.getGnssRinex(station(s)) );
+         for (satTypeValueMap::iterator it = dRin.body.begin();
+              it != dRin.body.end();
+              ++it)
+         {
+            samePostfits = samePostfits &&
+               near( (*it).second[TypeID::postfitC],
+                     sRin.body[(*it).first][TypeID::postfitC] ) &&
+               near( (*it).second[TypeID::postfitL],
+                     sRin.body[(*it).first][TypeID::postfitL] );
+         }
+      }
+   }
+
+   check(sameStates, "same states in both modes");
+   check(sameCovs, "same covariances in both modes");
+   check(blocksZero, "no covariance between stations");
+   check(samePostfits, "same postfit residuals in both modes");
+}
+
+
+   // Seconds per epoch of a network of the given size
+double timeRun(int numStations, bool sparseMode, int& numUnknowns)
+{
+   Models models;
+   SolverGeneral solver( makeSystem(models) );
+   solver.setSparseMode(sparseMode);
+
+   const int numEpochs = 10;
+   unsigned seed = 1;
+   double total = 0.0;
+   for (int epoch = 0; epoch < numEpochs; epoch++)
+   {
+      gnssDataMap gdsMap( makeEpoch(numStations, epoch, seed) );
+      clock_t t0 = clock();
+      solver.Process(gdsMap);
+      total += double(clock() - t0) / CLOCKS_PER_SEC;
+   }
+   numUnknowns = solver.getEquationSystem().getTotalNumVariables();
+
+   return total / numEpochs;
+}
+
+
+/// Returns 0 if all the checks pass.
+int main(int argc, char *argv[])
+{
+   try
+   {
+      checkSparse();
+
+      vector<int> sizes;
+      for (int i = 1; i < argc; i++)
+      {
+         sizes.push_back(atoi(argv[i]));
+      }
+      if (sizes.empty())
+      {
+         sizes.push_back(5);
+         sizes.push_back(10);
+      }
+
+      cout << "  stations  unknowns  dense s/epoch  sparse s/epoch" << endl
+           << fixed;
+      for (size_t i = 0; i < sizes.size(); i++)
+      {
+         int numUnknowns;
+         double tSparse = timeRun(sizes[i], true, numUnknowns);
+         cout << setw(10) << sizes[i] << setw(10) << numUnknowns;
+         if (sizes[i] <= 20)
+         {
+            cout << setw(15) << setprecision(3)
+                 << timeRun(sizes[i], false, numUnknowns);
+         }
+         else
+         {
+            cout << setw(15) << "-";
+         }
+         cout << setw(16) << setprecision(3) << tSparse << endl;
+      }
+   }
+   catch (Exception& e)
+   {
+      cout << e << endl;
+      return 1;
+   }
+
+   if (failures)
+   {
+      cout << failures << " check(s) failed" << endl;
+      return 1;
+   }
+   cout << "All checks passed" << endl;
+
+   return 0;
+}
@@ -0,0 +1,251 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2009, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file SrifMUTest.cpp
+ * Compares the SRIF measurement update SrifMU() with the plain Householder
+ * loop it replaced, on random dense and sparse partials, and reports the
+ * time taken by each. The results must be the same, element by element.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <ctime>
+#include <cstdlib>
+#include <cmath>
+
+#include "SRIMatrix.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+int failures = 0;
+
+void check(bool ok, const string& what)
+{
+   if (!ok)
+   {
+      cout << "FAILED: " << what << endl;
+      failures++;
+   }
+}
+
+
+   // SrifMU() as it was before the kernel skipped the zeros of A, with
+   // every loop running over all the rows.
+void refSrifMU(Matrix<double>& R, Vector<double>& Z, Matrix<double>& A,
+               unsigned int M)
+{
+   const double EPS=-1.e-200;
+   unsigned int m=M, n=R.rows();
+   if(m==0 || m > A.rows()) m=A.rows();
+   unsigned int np1=n+1;
+   unsigned int i,j,k;
+   double dum, delta, beta;
+
+   for(j=0; j<n; j++) {
+      double sum = 0.0;
+      for(i=0; i<m; i++)
+         sum += A(i,j)*A(i,j);
+      if(sum <= 0.0) continue;
+
+      dum = R(j,j);
+      sum += dum * dum;
+      sum = (dum > 0.0 ? -1.0 : 1.0) * ::sqrt(sum);
+      delta = dum - sum;
+      R(j,j) = sum;
+
+      if(j+1 > np1) break;
+
+      beta = sum*delta;
+      if(beta > EPS) continue;
+      beta = 1.0/beta;
+
+      for(k=j+1; k<np1; k++) {
+         sum = delta * (k==n ? Z(j) : R(j,k));
+         for(i=0; i<m; i++)
+            sum += A(i,j) * A(i,k);
+         if(sum == 0.0) continue;
+
+         sum *= beta;
+         if(k==n) Z(j) += sum*delta;
+         else   R(j,k) += sum*delta;
+
+         for(i=0; i<m; i++)
+            A(i,k) += sum * A(i,j);
+      }
+   }
+}
+
+
+double uniform()
+{
+   return rand()/double(RAND_MAX) - 0.5;
+}
+
+
+   // An n x n a priori SRI: random upper triangle, with a weak diagonal
+void randomSRI(Matrix<double>& R, Vector<double>& Z, unsigned int n)
+{
+   R = Matrix<double>(n,n,0.0);
+   Z = Vector<double>(n,0.0);
+   for(unsigned int i=0; i<n; i++) {
+      R(i,i) = 1.e-3 + uniform();
+      for(unsigned int j=i+1; j<n; j++)
+         R(i,j) = 0.1*uniform();
+      Z(i) = uniform();
+   }
+}
+
+
+   // H||D, m x (n+1), with 'common' dense columns (e.g. position and
+   // clock) and, if 'biases', one more non-zero partial per row at a
+   // random bias. Otherwise all the partials are dense.
+Matrix<double> randomPartials(unsigned int m, unsigned int n,
+                              unsigned int common, bool biases)
+{
+   Matrix<double> A(m,n+1,0.0);
+   for(unsigned int i=0; i<m; i++) {
+      if(biases) {
+         for(unsigned int k=0; k<common; k++)
+            A(i,k) = uniform();
+         A(i,common + rand()%(n-common)) = 1.0;
+      }
+      else {
+         for(unsigned int k=0; k<n; k++)
+            A(i,k) = uniform();
+      }
+      A(i,n) = uniform();
+   }
+   return A;
+}
+
+
+   // Runs both updates on the same input, M rows of A being used, and
+   // checks that R, Z and A are the same. Returns the time of each.
+void compare(const string& what, Matrix<double> R, Vector<double> Z,
+             Matrix<double> A, unsigned int M, int repeat,
+             double& tRef, double& tNew)
+{
+   Matrix<double> Rr, Rn, Ar, An;
+   Vector<double> Zr, Zn;
+
+   clock_t t0 = clock();
+   for(int i=0; i<repeat; i++) {
+      Rr = R; Zr = Z; Ar = A;
+      refSrifMU(Rr, Zr, Ar, M);
+   }
+   tRef = double(clock() - t0) / CLOCKS_PER_SEC;
+
+   t0 = clock();
+   for(int i=0; i<repeat; i++) {
+      Rn = R; Zn = Z; An = A;
+      SrifMU(Rn, Zn, An, M);
+   }
+   tNew = double(clock() - t0) / CLOCKS_PER_SEC;
+
+   bool same = true;
+   for(size_t i=0; i<R.rows(); i++) {
+      same = same && (Zr(i) == Zn(i));
+      for(size_t j=0; j<R.cols(); j++)
+         same = same && (Rr(i,j) == Rn(i,j));
+   }
+   for(size_t i=0; i<A.rows(); i++)
+      for(size_t j=0; j<A.cols(); j++)
+         same = same && (Ar(i,j) == An(i,j));
+
+   check(same, what);
+}
+
+
+/// Returns 0 if all the checks pass.
+int main(int argc, char *argv[])
+{
+   try
+   {
+      srand(11);
+      double tRef, tNew;
+      Matrix<double> R;
+      Vector<double> Z;
+
+         // Random shapes, dense and sparse, including fewer than four
+         // rows and row counts given by M
+      for(int trial=0; trial<500; trial++) {
+         unsigned int n = 1 + rand()%40;
+         unsigned int m = 1 + rand()%30;
+         unsigned int common = (n > 1 ? rand()%n : 0);
+         bool biases = (n > 1 && trial%2 == 1);
+         unsigned int M = (trial%5 == 0 ? 1 + rand()%m : 0);
+
+         randomSRI(R, Z, n);
+         Matrix<double> A(randomPartials(m, n, common, biases));
+
+         ostringstream os;
+         os << "trial " << trial << ": n=" << n << " m=" << m
+            << " common=" << common << (biases ? " sparse" : " dense")
+            << " M=" << M;
+         compare(os.str(), R, Z, A, M, 1, tRef, tNew);
+      }
+
+         // A column of zeros, and an empty a priori R
+      randomSRI(R, Z, 6);
+      Matrix<double> A(randomPartials(8, 6, 6, false));
+      for(unsigned int i=0; i<8; i++)
+         A(i,2) = 0.0;
+      compare("zero column", R, Z, A, 0, 1, tRef, tNew);
+      R = Matrix<double>(6,6,0.0);
+      Z = Vector<double>(6,0.0);
+      compare("zero a priori", R, Z, A, 0, 1, tRef, tNew);
+
+         // Timing: an epoch of 50 rows, 5 common unknowns and 200 biases
+      cout << fixed << setprecision(3)
+           << "                      reference     SrifMU" << endl;
+      randomSRI(R, Z, 205);
+      A = randomPartials(50, 205, 5, true);
+      compare("timing, sparse", R, Z, A, 0, 20, tRef, tNew);
+      cout << "  205 unknowns, sparse " << setw(8) << tRef << " s"
+           << setw(9) << tNew << " s" << endl;
+      A = randomPartials(50, 205, 205, false);
+      compare("timing, dense", R, Z, A, 0, 20, tRef, tNew);
+      cout << "  205 unknowns, dense  " << setw(8) << tRef << " s"
+           << setw(9) << tNew << " s" << endl;
+   }
+   catch(Exception& e)
+   {
+      cout << e << endl;
+      return 1;
+   }
+
+   if (failures)
+   {
+      cout << failures << " check(s) failed" << endl;
+      return 1;
+   }
+   cout << "All checks passed" << endl;
+
+   return 0;
+}
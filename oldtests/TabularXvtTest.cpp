@@ -0,0 +1,255 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2006, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file TabularXvtTest.cpp
+ * Measures TabularEphemerisStore::getXvt() calls per second with the time
+ * maps and with the compacted tables, and through getXvtBatch(), and checks
+ * that all of them give the same results (and the same failures) for every
+ * satellite and epoch.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <ctime>
+
+#include "SP3EphemerisStore.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   // Result of one getXvt() call
+struct Outcome
+{
+   bool ok;
+   Xvt xvt;
+   string text;
+};
+
+
+   // Query every satellite at every epoch, returning calls per second.
+double queryAll( const SP3EphemerisStore& store,
+                 const vector<SatID>& sats,
+                 const vector<DayTime>& times,
+                 int passes,
+                 vector<Outcome>& out )
+{
+   clock_t start = clock();
+
+   for (int pass = 0; pass < passes; pass++)
+   {
+      out.clear();
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         for (size_t s = 0; s < sats.size(); s++)
+         {
+            Outcome o;
+            try
+            {
+               o.xvt = store.getXvt(sats[s], times[i]);
+               o.ok = true;
+            }
+            catch(InvalidRequest& e)
+            {
+               o.ok = false;
+               o.text = e.getText();
+            }
+            out.push_back(o);
+         }
+      }
+   }
+
+   double sec = double(clock() - start) / CLOCKS_PER_SEC;
+   return (sec > 0) ? double(passes) * out.size() / sec : 0.0;
+}
+
+
+   // The same queries through getXvtBatch(), grouped by satellite, with
+   // the results put back in the order used by queryAll().
+double queryBatch( const SP3EphemerisStore& store,
+                   const vector<SatID>& sats,
+                   const vector<DayTime>& times,
+                   int passes,
+                   vector<Outcome>& out )
+{
+   const size_t n = sats.size() * times.size();
+   vector<SatID> ids(n);
+   vector<DayTime> when(n);
+   vector<Xvt> xvt(n);
+   bool *valid = new bool[n];
+
+   for (size_t s = 0; s < sats.size(); s++)
+   {
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         ids[s*times.size() + i] = sats[s];
+         when[s*times.size() + i] = times[i];
+      }
+   }
+
+   clock_t start = clock();
+   for (int pass = 0; pass < passes; pass++)
+   {
+      store.getXvtBatch(&ids[0], &when[0], n, &xvt[0], valid);
+   }
+   double sec = double(clock() - start) / CLOCKS_PER_SEC;
+
+   out.resize(n);
+   for (size_t s = 0; s < sats.size(); s++)
+   {
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         Outcome& o = out[i*sats.size() + s];
+         o.ok = valid[s*times.size() + i];
+         o.xvt = xvt[s*times.size() + i];
+      }
+   }
+   delete [] valid;
+
+   return (sec > 0) ? double(passes) * n / sec : 0.0;
+}
+
+
+bool sameOutcome(const Outcome& a, const Outcome& b)
+{
+   if (a.ok != b.ok)
+      return false;
+   if (!a.ok)
+      return a.text == b.text;
+
+   return ( a.xvt.x[0] == b.xvt.x[0] && a.xvt.x[1] == b.xvt.x[1] &&
+            a.xvt.x[2] == b.xvt.x[2] && a.xvt.v[0] == b.xvt.v[0] &&
+            a.xvt.v[1] == b.xvt.v[1] && a.xvt.v[2] == b.xvt.v[2] &&
+            a.xvt.dtime == b.xvt.dtime && a.xvt.ddtime == b.xvt.ddtime );
+}
+
+
+/// Returns 0 if the compacted tables give the same results as the maps.
+int main(int argc, char *argv[])
+{
+
+   if (argc < 2)
+   {
+      cout << "TabularXvtTest sp3file [sp3file ...]" << endl;
+      return -1;
+   }
+
+   try
+   {
+      SP3EphemerisStore store;
+      for (int i = 1; i < argc; i++)
+      {
+         store.loadFile(argv[i]);
+      }
+
+         // All GPS satellites, and a query each 30 s (plus a few ms, so
+         // most calls interpolate) over the whole span and a little beyond
+      vector<SatID> sats;
+      for (int prn = 1; prn <= 32; prn++)
+      {
+         sats.push_back(SatID(prn, SatID::systemGPS));
+      }
+
+      vector<DayTime> times;
+      for (DayTime t = store.getInitialTime() - 600.0;
+           t <= store.getFinalTime() + 600.0; t += 30.0)
+      {
+         times.push_back(t + 0.003);
+         if (times.size() % 30 == 0)
+         {
+            times.push_back(t);
+         }
+      }
+
+      const int passes = 3;
+      vector<Outcome> mapOut, tableOut, batchOut;
+
+      double mapRate = queryAll(store, sats, times, passes, mapOut);
+      store.compact();
+      double tableRate = queryAll(store, sats, times, passes, tableOut);
+      double batchRate = queryBatch(store, sats, times, passes, batchOut);
+
+      cout << "Queries: " << mapOut.size() << " (" << sats.size()
+           << " satellites, " << times.size() << " epochs), "
+           << passes << " passes" << endl;
+      cout << fixed << setprecision(0);
+      cout << setw(18) << "time maps" << setw(12) << mapRate
+           << " calls/s" << endl;
+      cout << setw(18) << "compact tables" << setw(12) << tableRate
+           << " calls/s" << endl;
+      cout << setw(18) << "batch, compact" << setw(12) << batchRate
+           << " calls/s" << endl;
+      if (mapRate > 0)
+      {
+         cout << setprecision(2) << setw(18) << "speedup" << setw(12)
+              << tableRate / mapRate << setw(12) << batchRate / mapRate
+              << endl;
+      }
+
+      bool same = (mapOut.size() == tableOut.size());
+      size_t failed = 0;
+      for (size_t i = 0; same && i < mapOut.size(); i++)
+      {
+         if (!mapOut[i].ok)
+         {
+            failed++;
+         }
+         if (!sameOutcome(mapOut[i], tableOut[i]))
+         {
+            cout << "Query " << i << " differs" << endl;
+            same = false;
+         }
+            // the batch has no failure text to compare
+         batchOut[i].text = mapOut[i].text;
+         if (!sameOutcome(mapOut[i], batchOut[i]))
+         {
+            cout << "Batch query " << i << " differs" << endl;
+            same = false;
+         }
+      }
+
+      if (same)
+      {
+         cout << "All results match (" << failed
+              << " requests failed on both paths)." << endl;
+         return 0;
+      }
+
+      cout << "Map and compact results DIFFER." << endl;
+      return 1;
+   }
+   catch(gpstk::Exception& e)
+   {
+      cout << e << endl;
+   }
+   catch(...)
+   {
+      cout << "Some other exception thrown..." << endl;
+   }
+
+   return -1;
+}
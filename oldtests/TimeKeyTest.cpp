@@ -0,0 +1,203 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2006, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file TimeKeyTest.cpp
+ * Checks the conversions, ordering, arithmetic and hash of TimeKey, and
+ * measures lookups per second in a std::map keyed by DayTime and by
+ * TimeKey.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+
+#include "TimeKey.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+int failures = 0;
+
+void check(bool ok, const char* what)
+{
+   if (!ok)
+   {
+      cout << "FAILED: " << what << endl;
+      failures++;
+   }
+}
+
+
+   // Lookups per second of every time in 'times', repeated 'passes' times
+template <class Key>
+double lookupRate( const vector<DayTime>& times,
+                   int passes,
+                   long& found )
+{
+   map<Key, int> m;
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      m[times[i]] = int(i);
+   }
+
+      // The lookup times are built beforehand, so only the search is timed
+   vector<Key> keys(times.begin(), times.end());
+   found = 0;
+
+   clock_t start = clock();
+   for (int pass = 0; pass < passes; pass++)
+   {
+      for (size_t i = 0; i < keys.size(); i++)
+      {
+         typename map<Key, int>::const_iterator it = m.find(keys[i]);
+         if (it != m.end() && it->second == int(i))
+         {
+            found++;
+         }
+      }
+   }
+   double sec = double(clock() - start) / CLOCKS_PER_SEC;
+
+   return (sec > 0) ? double(passes) * keys.size() / sec : 0.0;
+}
+
+
+/// Returns 0 if all the checks pass.
+int main(int argc, char *argv[])
+{
+   try
+   {
+      srand(1);
+
+         // Conversions: random times from 1990 to 2030, to the microsecond
+      for (int i = 0; i < 100000; i++)
+      {
+         long mjd = 47892 + rand() % 14610;
+         double sod = (rand() % 86400) + (rand() % 1000000) * 1e-6;
+         DayTime t(mjd + sod / 86400.0L);
+
+         TimeKey k(t);
+         DayTime back = k.getDayTime();
+         check(std::abs(back - t) < 1e-9, "DayTime round trip");
+         check(TimeKey(back) == k, "DayTime round trip key");
+
+         CommonTime ct(t);
+         check(TimeKey(ct) == k, "CommonTime key");
+         check(TimeKey(k.getCommonTime()) == k, "CommonTime round trip");
+
+         TimeKey later = k + 0.5;
+         check(later - k == 0.5, "difference");
+         check(later > k && k < later && k != later, "ordering");
+         check((later - 0.5) == k, "subtraction");
+      }
+
+         // The ordering agrees with DayTime's for times further apart
+         // than its tolerance
+      DayTime t0(2009, 3, 1, 0, 0, 0.0);
+      for (int i = 0; i < 1000; i++)
+      {
+         DayTime a = t0 + (rand() % 86400000) * 1e-3;
+         DayTime b = t0 + (rand() % 86400000) * 1e-3;
+         check((a < b) == (TimeKey(a) < TimeKey(b)), "same order");
+         check((a == b) == (TimeKey(a) == TimeKey(b)), "same equality");
+      }
+
+         // The ends of time, and times beyond the range of the count
+      check(TimeKey(DayTime::BEGINNING_OF_TIME) == TimeKey::BEGINNING_OF_TIME,
+            "beginning of time");
+      check(TimeKey(DayTime::END_OF_TIME) == TimeKey::END_OF_TIME,
+            "end of time");
+      check(TimeKey::BEGINNING_OF_TIME.getDayTime()
+            == DayTime::BEGINNING_OF_TIME, "beginning of time back");
+      check(TimeKey::END_OF_TIME.getDayTime() == DayTime::END_OF_TIME,
+            "end of time back");
+      check(TimeKey(DayTime(1600, 1, 1, 0, 0, 0.0))
+            == TimeKey::BEGINNING_OF_TIME, "before the range");
+      check(TimeKey(DayTime(2400, 1, 1, 0, 0, 0.0))
+            == TimeKey::END_OF_TIME, "after the range");
+      check(TimeKey(t0) - 1e12 == TimeKey::BEGINNING_OF_TIME,
+            "clamped subtraction");
+      check(TimeKey::END_OF_TIME + 1.0 == TimeKey::END_OF_TIME,
+            "end stays the end");
+      check(TimeKey() == TimeKey(DayTime(1980, 1, 6, 0, 0, 0.0)),
+            "GPS epoch");
+      check(TimeKey(DayTime(1970, 1, 1, 0, 0, 0.0)).getTicks()
+            == -315964800LL * TimeKey::TICKS_PER_SEC, "before the epoch");
+
+         // Epochs 30 s apart should spread over the buckets of a table
+      const size_t buckets = 1024;
+      vector<int> load(buckets, 0);
+      for (int i = 0; i < 2880; i++)
+      {
+         load[(TimeKey(t0) + 30.0 * i).hash() % buckets]++;
+      }
+      int most = 0;
+      for (size_t b = 0; b < buckets; b++)
+      {
+         most = max(most, load[b]);
+      }
+      check(most < 12, "hash spread");
+      check(TimeKey(t0).hash() == TimeKey(t0 + 0.0).hash(), "equal hash");
+
+         // Lookups of a day of 1 s epochs
+      vector<DayTime> times;
+      for (int i = 0; i < 86400; i++)
+      {
+         times.push_back(t0 + double(i));
+      }
+      const int passes = 10;
+      long dayFound, keyFound;
+      double dayRate = lookupRate<DayTime>(times, passes, dayFound);
+      double keyRate = lookupRate<TimeKey>(times, passes, keyFound);
+      check(dayFound == long(passes) * times.size(), "DayTime lookups");
+      check(keyFound == long(passes) * times.size(), "TimeKey lookups");
+
+      cout << "map::find() over " << times.size() << " epochs, "
+           << passes << " passes" << endl;
+      cout << fixed << setprecision(0);
+      cout << setw(18) << "DayTime key" << setw(12) << dayRate
+           << " lookups/s" << endl;
+      cout << setw(18) << "TimeKey key" << setw(12) << keyRate
+           << " lookups/s" << endl;
+   }
+   catch(Exception& e)
+   {
+      cout << e << endl;
+      return 1;
+   }
+
+   if (failures)
+   {
+      cout << failures << " checks failed" << endl;
+      return 1;
+   }
+   cout << "All checks passed" << endl;
+   return 0;
+}
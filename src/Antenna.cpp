@@ -43,6 +43,7 @@ namespace gpstk
        */
    Antenna::Antenna( const Triple& eccL1,
                      const Triple& eccL2 )
+      : dazi(0.0)
    {
          // Add eccentricities
       addAntennaEcc(G01, eccL1);
@@ -67,6 +68,7 @@ namespace gpstk
                      double NorthEccL2,
                      double EastEccL2,
                      double UpEccL2 )
+      : dazi(0.0)
    {
          // Add eccentricities
       addAntennaEcc(G01, NorthEccL1, EastEccL1, UpEccL1);
@@ -222,24 +224,64 @@ namespace gpstk
          azimuth -= 360.0;
       }
 
+         // Get the right azimuth interval
+      const double row( std::floor(azimuth/dazi) );
+      const double lowerAzimuth( row * dazi );
+      const double upperAzimuth( lowerAzimuth + dazi );
+
+         // Find the fraction from 'lowerAzimuth'
+      const double fractionalAzimuth( ( azimuth - lowerAzimuth ) /
+                                      ( upperAzimuth - lowerAzimuth ) );
+
+         // Look first in the grid, where no search is needed
+      PCGridMap::const_iterator itGrid( pcGrid.find(freq) );
+      if( itGrid != pcGrid.end() )
+      {
+
+         const std::vector< std::vector<double> >& grid( (*itGrid).second );
+         const size_t i( ( row >= 0.0 && row < grid.size() ) ?
+                         static_cast<size_t>(row) : grid.size() );
+
+         if( i < grid.size() && !grid[i].empty() )
+         {
+               // Get the normalized angle
+            const double normalizedAngle( (angle-zen1)/dzen );
+
+            if( fractionalAzimuth == 0.0 )
+            {
+                  // Return result. Only the "Up" component is important.
+               return Triple( linearInterpol( grid[i], normalizedAngle ),
+                              0.0,
+                              0.0 );
+            }
+
+               // Row 'i+1' must be the pattern for 'upperAzimuth'
+            if( i+1 < grid.size() && !grid[i+1].empty() &&
+                (row+1.0)*dazi == upperAzimuth )
+            {
+               double val1( linearInterpol( grid[i], normalizedAngle ) );
+               double val2( linearInterpol( grid[i+1], normalizedAngle ) );
+
+                  // Return result. Only the "Up" component is important.
+               return Triple( ( val1 + (val2-val1) * fractionalAzimuth ),
+                              0.0,
+                              0.0 );
+            }
+         }
+
+      }  // End of 'if( itGrid != pcGrid.end() )...'
+
+
          // Look for this frequency in pcMap
          // Define iterator
       PCDataMap::const_iterator it( pcMap.find(freq) );
       if( it != pcMap.end() )
       {
 
-            // Get the right azimuth interval
-         const double lowerAzimuth( std::floor(azimuth/dazi) * dazi );
-         const double upperAzimuth( lowerAzimuth + dazi );
-
                // Look for data vectors
          AzimuthDataMap::const_iterator it2( (*it).second.find(lowerAzimuth) );
          AzimuthDataMap::const_iterator it3( (*it).second.find(upperAzimuth) );
 
-            // Find the fraction from 'lowerAzimuth'
-         const double fractionalAzimuth( ( azimuth - lowerAzimuth ) /
-                                         ( upperAzimuth - lowerAzimuth ) );
-
             // Check if 'azimuth' exactly corresponds to a value in the map
          if( fractionalAzimuth == 0.0 )
          {
@@ -357,6 +399,67 @@ namespace gpstk
 
 
 
+      /* Put a pattern of 'pcMap' in its row of 'pcGrid', if it has one.
+       *
+       * @param[in] freq        Frequency.
+       * @param[in] azi         Azimuth.
+       * @param[in] pcVec       Vector of phase centers, in METERS.
+       */
+   void Antenna::addPCGridRow( frequencyType freq,
+                               double azi,
+                               const std::vector<double>& pcVec )
+   {
+
+         // Without an azimuth increment there is no grid
+      if( !( dazi > 0.0 ) )
+      {
+         return;
+      }
+
+         // Patterns that are not exactly on a grid azimuth are only
+         // kept in 'pcMap'
+      const double row( std::floor(azi/dazi) );
+      if( row < 0.0 || row * dazi != azi )
+      {
+         return;
+      }
+
+      std::vector< std::vector<double> >& grid( pcGrid[freq] );
+
+      const size_t i( static_cast<size_t>(row) );
+      if( i >= grid.size() )
+      {
+         grid.resize(i+1);
+      }
+
+      grid[i] = pcVec;
+
+   }  // End of method 'Antenna::addPCGridRow()'
+
+
+
+      // Rebuild 'pcGrid' from 'pcMap' and 'dazi'.
+   void Antenna::buildPCGrid()
+   {
+
+      pcGrid.clear();
+
+      for( PCDataMap::const_iterator it = pcMap.begin();
+           it != pcMap.end();
+           ++it )
+      {
+         for( AzimuthDataMap::const_iterator it2 = (*it).second.begin();
+              it2 != (*it).second.end();
+              ++it2 )
+         {
+            addPCGridRow( (*it).first, (*it2).first, (*it2).second );
+         }
+      }
+
+   }  // End of method 'Antenna::buildPCGrid()'
+
+
+
       // Returns if this object is valid. The validity criteria is to
       // have a non-empty 'antennaData' map AND a non-empty 'antennaEccMap'.
    bool Antenna::isValid() const
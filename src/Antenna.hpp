@@ -166,7 +166,7 @@ namespace gpstk
 
 
          /// Default constructor.
-      Antenna() {};
+      Antenna() : dazi(0.0) {};
 
 
          /** Common constructor.
@@ -349,7 +349,7 @@ namespace gpstk
           * @param[in] daz      Increment of the azimuth
           */
       Antenna setDazi( double daz )
-      { dazi = daz; return (*this); };
+      { dazi = daz; buildPCGrid(); return (*this); };
 
 
          /// Get initial zenith grid value.
@@ -534,7 +534,7 @@ namespace gpstk
           * @param[in] pMap Antenna azimuth dependent patterns map, METERS.
           */
       Antenna setAntennaPCMap( const PCDataMap& pMap )
-      { pcMap = pMap; return (*this); };
+      { pcMap = pMap; buildPCGrid(); return (*this); };
 
 
          /** Add antenna azimuth dependent pattern, in METERS.
@@ -546,7 +546,8 @@ namespace gpstk
       Antenna addAntennaPattern( frequencyType freq,
                                  double azi,
                                  const std::vector<double>& pcVec )
-      { pcMap[freq][azi] = pcVec; return (*this); };
+      { pcMap[freq][azi] = pcVec; addPCGridRow(freq, azi, pcVec);
+        return (*this); };
 
 
          /// Get antenna non-azimuth dependent RMS map, in METERS.
@@ -671,6 +672,27 @@ namespace gpstk
       PCDataMap pcRMSMap;
 
 
+         /// Azimuth dependent patterns as a regular grid: row 'i' holds the
+         /// pattern for azimuth i*dazi, or is empty if there is none.
+      typedef std::map< frequencyType,
+                        std::vector< std::vector<double> > > PCGridMap;
+
+
+         /// Copy of 'pcMap' indexed by azimuth, used by
+         /// getAntennaPCVariation() instead of searching 'pcMap'
+      PCGridMap pcGrid;
+
+
+         /// Put a pattern of 'pcMap' in its row of 'pcGrid', if it has one.
+      void addPCGridRow( frequencyType freq,
+                         double azi,
+                         const std::vector<double>& pcVec );
+
+
+         /// Rebuild 'pcGrid' from 'pcMap' and 'dazi'.
+      void buildPCGrid();
+
+
          /** Linear interpolation as function of normalized angle
           *
           * @param[in] dataVector         std::vector holding data.
@@ -28,6 +28,11 @@
 //============================================================================
 
 
+#include <fstream>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/stat.h>
+
 #include "AntexReader.hpp"
 
 
@@ -225,15 +230,7 @@ namespace gpstk
             // Process 'validFrom' line
          if( label == validFrom )
          {
-               // Get validity as Year, Month, Day, Hour, Min, Sec
-            DayTime valFrom( asInt( strip( line.substr(0,6) ) ),
-                            asInt( strip( line.substr(6,6) ) ),
-                            asInt( strip( line.substr(12,6) ) ),
-                            asInt( strip( line.substr(18,6) ) ),
-                            asInt( strip( line.substr(24,6) ) ),
-                            asDouble( strip( line.substr(30,13) ) ) );
-
-            antenna.setAntennaValidFrom( valFrom );
+            antenna.setAntennaValidFrom( parseValidity(line) );
 
                // Mark that we found "Valid From"
             validFromPresent = true;
@@ -242,15 +239,7 @@ namespace gpstk
             // Process 'validUntil' line
          if( label == validUntil )
          {
-               // Get validity as Year, Month, Day, Hour, Min, Sec
-            DayTime valUntil( asInt( strip( line.substr(0,6) ) ),
-                             asInt( strip( line.substr(6,6) ) ),
-                             asInt( strip( line.substr(12,6) ) ),
-                             asInt( strip( line.substr(18,6) ) ),
-                             asInt( strip( line.substr(24,6) ) ),
-                             asDouble( strip( line.substr(30,13) ) ) );
-
-            antenna.setAntennaValidUntil( valUntil );
+            antenna.setAntennaValidUntil( parseValidity(line) );
 
                // Mark that we found "Valid Until"
             validUntilPresent = true;
@@ -548,293 +537,486 @@ namespace gpstk
 
 
 
-      /* Method to get antenna data from a given model. Just the model,
-       * without including the radome
-       *
-       * @param model      Antenna model, without including radome.
-       *
-       * @note Antenna model case is NOT relevant.
-       *
-       * @warning The antenna returned will be the first one in the Antex
-       * file that matches the condition.
-       */
-   Antenna AntexReader::getAntennaNoRadome(const string& model)
-      throw(ObjectNotFound)
+      // Parse a 'validFrom' or 'validUntil' line
+   DayTime AntexReader::parseValidity( const std::string& line )
    {
 
-         // Flag that signals if we found the antenna
-      bool antennaFound(false);
+         // Get validity as Year, Month, Day, Hour, Min, Sec
+      return DayTime( asInt( strip( line.substr(0,6) ) ),
+                      asInt( strip( line.substr(6,6) ) ),
+                      asInt( strip( line.substr(12,6) ) ),
+                      asInt( strip( line.substr(18,6) ) ),
+                      asInt( strip( line.substr(24,6) ) ),
+                      asDouble( strip( line.substr(30,13) ) ) );
 
-         // Create 'Antenna' object to be returned
-      Antenna antenna;
-
-         // We need to read the data stream (file) from the beginning
-      FFTextStream::open( fileName.c_str(), std::ios::in );
-
-         // Strip radome, change to upper case and strip leading and
-         // trailing spaces
-      string uModel( strip( upperCase( model.substr(0,15) ) ) );
+   }  // End of method 'AntexReader::parseValidity()'
 
-         // Getting antennas out of Antex file is a costly process, so this
-         // object will keep a "buffer" called 'antennaMap' where all antennas
-         // previously looked up are stored.
-         // Then, let's look first into this "buffer"
-      AntennaDataMap::const_iterator it1( antennaMap.find(uModel) );
-      if( it1 != antennaMap.end() )
-      {
 
-            // Return the first antenna found. Note that there several
-            // different maps in cascade.
-         RadSerCalValAntMap::const_iterator it2( (*it1).second.begin() );
-         SerCalValAntMap::const_iterator it3( (*it2).second.begin() );
-         CalValAntMap::const_iterator it4( (*it3).second.begin() );
-         ValAntMap::const_iterator it5( (*it4).second.begin() );
 
-            // we found the antenna
-         antenna = (*it5).second;
-         antennaFound = true;
+      // Scan the rest of the file, after the header, to build the index
+   void AntexReader::scanAntennas()
+      throw( InvalidAntex,
+             FFStreamError,
+             gpstk::StringUtils::StringException )
+   {
 
-      }  // End of 'if( it1 != antennaMap.end() )...'
+      AntennaEntry entry;
 
+         // Position and line number of the line after 'startOfAntenna'
+      long offset(-1);
+      unsigned int nextLine(0);
 
-         // Antenna is not in 'antennaMap': Let's look for it in file
-      if( !antennaFound )
+      try
       {
 
-         try
+            // Repeat until End Of File
+         while( true )
          {
 
-               // Repeat until antenna is found or End Of File
-            while( !antennaFound )
+            std::string line;
+
+               // Read one line from file
+            formattedGetLine(line, true);
+
+               // Pattern lines may be shorter than a label line
+            if( line.size() <= 60 )
             {
+               continue;
+            }
 
-               std::string label;
-               std::string line;
+               // Get label
+            std::string label( strip( line.substr(60,20) ) );
 
-                  // Look for 'typeSerial' line
-               while( label != typeSerial )
+            if( label == startOfAntenna )
+            {
+               offset = static_cast<long>( tellg() );
+               nextLine = lineNumber + 1;
+            }
+            else if( label == typeSerial )
+            {
+                  // Same fields used by fillAntennaData()
+               entry.model  = strip( line.substr(0,15) );
+               entry.radome = strip( line.substr(16,4) );
+               entry.serial = strip( line.substr(20,20) );
+               entry.validFrom  = DayTime::BEGINNING_OF_TIME;
+               entry.validUntil = DayTime::END_OF_TIME;
+
+               if( offset < 0 || nextLine != lineNumber )
                {
-                     // Read one line from file
-                  formattedGetLine(line, true);
-
-                     // Get label
-                  label = strip( line.substr(60,20) );
+                  InvalidAntex ia( "'" + typeSerial + "' not after '"
+                                   + startOfAntenna + "' in Antex file." );
+                  GPSTK_THROW(ia);
                }
 
-                  // Check if model matches. Read only model, not radome
-               if( uModel == strip( line.substr(0,15) ) )
+               entry.offset = offset;
+               entry.line = lineNumber;
+            }
+            else if( label == validFrom )
+            {
+               entry.validFrom = parseValidity(line);
+            }
+            else if( label == validUntil )
+            {
+               entry.validUntil = parseValidity(line);
+            }
+            else if( label == endOfAntenna )
+            {
+               if( offset >= 0 )
                {
+                  antennaIndex.push_back(entry);
+               }
 
-                     // We found the antenna. Fill it with data
-                  antenna = fillAntennaData( line );
+               offset = -1;
+            }
 
-                     // Insert antenna into buffer 'antennaMap'
-                  antennaMap[ antenna.getAntennaType()      ]
-                            [ antenna.getAntennaRadome()    ]
-                            [ antenna.getAntennaSerial()    ]
-                            [ antenna.getAntennaCalMethod() ]
-                            [ antenna.getAntennaValidFrom() ] = antenna;
+         }  // End of 'while( true )...'
 
-                  antennaFound = true;
+      }  // End of try block
+      catch( InvalidAntex& ia )
+      {
+         GPSTK_RETHROW(ia);
+      }
+      catch( EndOfFile& e )
+      {
+         return;
+      }
+      catch(...)
+      {
+         InvalidAntex ia("Unknown error when indexing Antex file.");
+         GPSTK_THROW(ia);
+      }
 
-               }  // End of 'if( uModel == strip( line.substr(0,15) ) )...'
+   }  // End of method 'AntexReader::scanAntennas()'
 
-            }  // End of 'while( !antennaFound )...'
 
-         }  // End of try block
-         catch( InvalidAntex& ia )
-         {
 
-               // We need to close this data stream
-            (*this).close();
+      // Fill 'modelIndex' and 'serialIndex' from 'antennaIndex'
+   void AntexReader::indexAntennas()
+   {
+
+      modelIndex.clear();
+      serialIndex.clear();
+
+      for( size_t i = 0; i < antennaIndex.size(); ++i )
+      {
+         modelIndex[ antennaIndex[i].model ].push_back(i);
+         serialIndex[ antennaIndex[i].serial ].push_back(i);
+      }
+
+   }  // End of method 'AntexReader::indexAntennas()'
 
-            GPSTK_RETHROW(ia);
+
+
+   namespace
+   {
+
+         // Index file layout: 'indexMagic', 'indexByteOrder', size and
+         // modification time of the Antex file, number of antennas, and
+         // then, for each antenna, model, radome and serial (as a length
+         // byte plus characters), validity (a flag, year, day of year and
+         // second of day for both dates), offset and line number.
+         // Values are stored in the byte order of the machine; the
+         // 'indexByteOrder' mark tells if the file was written by another
+         // kind of machine.
+      const char indexMagic[8] = { 'A', 'T', 'X', 'I', 'D', 'X', '0', '1' };
+      const unsigned int indexByteOrder( 0x01020304 );
+
+         // Validity flags
+      const unsigned char timeBegin( 1 );    // DayTime::BEGINNING_OF_TIME
+      const unsigned char timeEnd( 2 );      // DayTime::END_OF_TIME
+      const unsigned char timeYDS( 3 );      // Year, day of year, second
+
+      template <class T>
+      inline void writeValue( std::ostream& s, const T& value )
+      { s.write( reinterpret_cast<const char*>(&value), sizeof(T) ); }
+
+      template <class T>
+      inline bool readValue( std::istream& s, T& value )
+      {
+         s.read( reinterpret_cast<char*>(&value), sizeof(T) );
+         return s.good();
+      }
+
+      inline void writeString( std::ostream& s, const std::string& str )
+      {
+         unsigned char size( static_cast<unsigned char>(
+                                 str.size() < 255 ? str.size() : 255 ) );
+         writeValue(s, size);
+         s.write( str.data(), size );
+      }
+
+      inline bool readString( std::istream& s, std::string& str )
+      {
+         unsigned char size;
+         if( !readValue(s, size) ) return false;
+         char buffer[256];
+         s.read( buffer, size );
+         str.assign( buffer, size );
+         return s.good();
+      }
+
+      inline void writeTime( std::ostream& s, const DayTime& t )
+      {
+         if( t == DayTime::BEGINNING_OF_TIME )
+         {
+            writeValue(s, timeBegin);
          }
-         catch( EndOfFile& e )
+         else if( t == DayTime::END_OF_TIME )
          {
-               // We need to close this data stream
-            (*this).close();
-
-            ObjectNotFound notFound("Antenna not found in Antex file.");
-            GPSTK_THROW(notFound);
+            writeValue(s, timeEnd);
          }
-         catch(...)
+         else
          {
-               // We need to close this data stream
-            (*this).close();
-
-            InvalidAntex ia("Unknown error when reading Antex header.");
-            GPSTK_THROW(ia);
+            writeValue(s, timeYDS);
+            writeValue(s, t.DOYyear());
+            writeValue(s, t.DOYday());
+            writeValue(s, t.DOYsecond());
          }
+      }
 
-      }  // End of 'if( !antennaFound )...'
+      inline bool readTime( std::istream& s, DayTime& t )
+      {
+         unsigned char flag;
+         if( !readValue(s, flag) ) return false;
 
+         if( flag == timeBegin )
+         {
+            t = DayTime::BEGINNING_OF_TIME;
+            return true;
+         }
 
-         // We need to close this data stream
-      (*this).close();
+         if( flag == timeEnd )
+         {
+            t = DayTime::END_OF_TIME;
+            return true;
+         }
 
-         // Return antenna
-      return antenna;
+         short year, doy;
+         double sod;
+         if( flag != timeYDS ||
+             !readValue(s, year) ||
+             !readValue(s, doy)  ||
+             !readValue(s, sod) )
+         {
+            return false;
+         }
 
-   }  // End of method 'AntexReader::getAntennaNoRadome()'
+         t.setYDoySod(year, doy, sod);
+         return true;
+      }
 
+   }  // End of anonymous namespace
 
 
-      /* Method to get antenna data from a given IGS model.
-       *
-       * @param model      IGS antenna model
-       *
-       * @note Antenna model case is NOT relevant.
-       *
-       * @note IGS antenna model combines antenna type and radome.
-       *
-       * @warning The antenna returned will be the first one in the Antex
-       * file that matches the condition.
-       *
-       * @warning If IGS model doesn't include radome, method
-       * 'getAntennaNoRadome()' will be automatically called.
+
+      /* Read the index from 'indexFileName'. Returns false if the file
+       * is missing, damaged or for another version of the Antex file.
        */
-   Antenna AntexReader::getAntenna(const string& model)
-      throw(ObjectNotFound)
+   bool AntexReader::readIndexFile( long fileSize,
+                                    long fileTime )
    {
 
-         // Flag that signals if we found the antenna
-      bool antennaFound(false);
+      std::ifstream s( indexFileName.c_str(),
+                       std::ios::in | std::ios::binary );
+
+      char magic[8];
+      unsigned int byteOrder;
+      long size, time;
+      unsigned int count;
+
+      s.read( magic, 8 );
+      if( !s.good()                             ||
+          !std::equal( magic, magic+8, indexMagic ) ||
+          !readValue(s, byteOrder)              ||
+          byteOrder != indexByteOrder           ||
+          !readValue(s, size)                   ||
+          !readValue(s, time)                   ||
+          size != fileSize                      ||
+          time != fileTime                      ||
+          !readValue(s, count) )
+      {
+         return false;
+      }
 
-         // Create 'Antenna' object to be returned
-      Antenna antenna;
+      try
+      {
 
+         std::vector<AntennaEntry> index(count);
 
-         // We need to read the data stream (file) from the beginning
-      FFTextStream::open( fileName.c_str(), std::ios::in );
+         for( size_t i = 0; i < index.size(); ++i )
+         {
+            AntennaEntry& entry( index[i] );
+
+            if( !readString(s, entry.model)     ||
+                !readString(s, entry.radome)    ||
+                !readString(s, entry.serial)    ||
+                !readTime(s, entry.validFrom)   ||
+                !readTime(s, entry.validUntil)  ||
+                !readValue(s, entry.offset)     ||
+                !readValue(s, entry.line)       ||
+                entry.offset < 0                ||
+                entry.offset >= fileSize )
+            {
+               return false;
+            }
+         }
 
-         // Change input to upper case and strip leading and trailing spaces
-      string uModel( strip( upperCase( model.substr(0,15) ) ) );
+         antennaIndex.swap(index);
 
-         // Check if we have radome data here. If not, call alternative method
-      if( model.size() < 17 )
+      }
+      catch(...)
       {
-            // We need to close this data stream
-         (*this).close();
+            // Bad dates in a damaged file
+         return false;
+      }
 
-         return getAntennaNoRadome(uModel);
+      return true;
+
+   }  // End of method 'AntexReader::readIndexFile()'
+
+
+
+      // Write the index to 'indexFileName'.
+   void AntexReader::writeIndexFile( long fileSize,
+                                     long fileTime ) const
+   {
+
+      std::ofstream s( indexFileName.c_str(),
+                       std::ios::out | std::ios::trunc | std::ios::binary );
+
+      s.write( indexMagic, 8 );
+      writeValue(s, indexByteOrder);
+      writeValue(s, fileSize);
+      writeValue(s, fileTime);
+      writeValue(s, static_cast<unsigned int>( antennaIndex.size() ));
+
+      for( size_t i = 0; i < antennaIndex.size(); ++i )
+      {
+         const AntennaEntry& entry( antennaIndex[i] );
+
+         writeString(s, entry.model);
+         writeString(s, entry.radome);
+         writeString(s, entry.serial);
+         writeTime(s, entry.validFrom);
+         writeTime(s, entry.validUntil);
+         writeValue(s, entry.offset);
+         writeValue(s, entry.line);
       }
 
-         // Get radome
-      string uRadome( strip( upperCase( model.substr(16,4) ) ) );
+         // The index file is just a cache, so errors writing it are ignored
+
+   }  // End of method 'AntexReader::writeIndexFile()'
+
+
+
+      // Get the antenna at position 'i' of 'antennaIndex'.
+   Antenna AntexReader::getAntennaEntry( size_t i )
+      throw(InvalidAntex)
+   {
 
          // Getting antennas out of Antex file is a costly process, so this
-         // object will keep a "buffer" called 'antennaMap' where all antennas
-         // previously looked up are stored.
+         // object will keep a "buffer" called 'antennaCache' where all
+         // antennas previously looked up are stored.
          // Then, let's look first into this "buffer"
-      AntennaDataMap::const_iterator it1( antennaMap.find(uModel) );
-      if( it1 != antennaMap.end() )
+      AntennaCache::const_iterator it( antennaCache.find(i) );
+      if( it != antennaCache.end() )
       {
+         return (*it).second;
+      }
 
-         RadSerCalValAntMap::const_iterator it2( (*it1).second.find(uRadome) );
-
-         if( it2 != (*it1).second.end() )
-         {
+      Antenna antenna;
 
-               // Return the first antenna found. Note that there several
-               // different maps in cascade.
-            SerCalValAntMap::const_iterator it3( (*it2).second.begin() );
-            CalValAntMap::const_iterator it4( (*it3).second.begin() );
-            ValAntMap::const_iterator it5( (*it4).second.begin() );
+      try
+      {
 
-               // we found the antenna
-            antenna = (*it5).second;
-            antennaFound = true;
+            // Go straight to the antenna 'typeSerial' line
+         FFTextStream::open( fileName.c_str(), std::ios::in );
+         seekg( antennaIndex[i].offset );
+         lineNumber = antennaIndex[i].line - 1;
 
-         }  // End of 'if( it2 != (*it1).second.end() )...'
+         std::string line;
+         formattedGetLine(line, true);
 
-      }  // End of 'if( it1 != antennaMap.end() )'
+         if( line.size() <= 60 ||
+             strip( line.substr(60,20) ) != typeSerial )
+         {
+            InvalidAntex ia("Antex file changed since it was indexed.");
+            GPSTK_THROW(ia);
+         }
 
+            // Fill antenna with data
+         antenna = fillAntennaData( line );
 
-         // Antenna is not in 'antennaMap': Let's look for it in file
-      if( !antennaFound )
+      }  // End of try block
+      catch( InvalidAntex& ia )
       {
 
-         try
-         {
+            // We need to close this data stream
+         (*this).close();
 
-               // Repeat until antenna is found or End Of File
-            while( !antennaFound )
-            {
+         GPSTK_RETHROW(ia);
+      }
+      catch(...)
+      {
+            // We need to close this data stream
+         (*this).close();
 
-               std::string label;
-               std::string line;
+         InvalidAntex ia("Unknown error when reading Antex data.");
+         GPSTK_THROW(ia);
+      }
 
-                  // Look for 'typeSerial' line
-               while( label != typeSerial )
-               {
-                     // Read one line from file
-                  formattedGetLine(line, true);
+         // We need to close this data stream
+      (*this).close();
 
-                     // Get label
-                  label = strip( line.substr(60,20) );
-               }
+         // Insert antenna into buffer 'antennaCache'
+      antennaCache[i] = antenna;
 
-                  // Check if model matches. Read only model, not radome
-               if( uModel == strip( line.substr(0,15) ) )
-               {
+      return antenna;
 
-                     // Check if radome matches
-                  if( uRadome == strip( line.substr(16,4) ) )
-                  {
+   }  // End of method 'AntexReader::getAntennaEntry()'
 
-                        // We found the antenna. Fill it with data
-                     antenna = fillAntennaData( line );
 
-                        // Insert antenna into buffer 'antennaMap'
-                     antennaMap[ antenna.getAntennaType()      ]
-                               [ antenna.getAntennaRadome()    ]
-                               [ antenna.getAntennaSerial()    ]
-                               [ antenna.getAntennaCalMethod() ]
-                               [ antenna.getAntennaValidFrom() ] = antenna;
 
-                     antennaFound = true;
+      /* Method to get antenna data from a given model. Just the model,
+       * without including the radome
+       *
+       * @param model      Antenna model, without including radome.
+       *
+       * @note Antenna model case is NOT relevant.
+       *
+       * @warning The antenna returned will be the first one in the Antex
+       * file that matches the condition.
+       */
+   Antenna AntexReader::getAntennaNoRadome(const string& model)
+      throw(ObjectNotFound)
+   {
 
-                  }  // End of 'if( uModel == strip( line.substr(0,15) ) )...'
+         // Strip radome, change to upper case and strip leading and
+         // trailing spaces
+      string uModel( strip( upperCase( model.substr(0,15) ) ) );
 
-               } // End of 'if( uModel == strip( line.substr(0,15) ) )...'
+         // Antennas with this model, in file order
+      EntryListMap::const_iterator it( modelIndex.find(uModel) );
+      if( it == modelIndex.end() )
+      {
+         ObjectNotFound notFound("Antenna not found in Antex file.");
+         GPSTK_THROW(notFound);
+      }
 
-            }  // End of 'while( !antennaFound )...'
+      return getAntennaEntry( (*it).second.front() );
 
-         }  // End of try block
-         catch( InvalidAntex& ia )
-         {
+   }  // End of method 'AntexReader::getAntennaNoRadome()'
 
-               // We need to close this data stream
-            (*this).close();
 
-            GPSTK_RETHROW(ia);
-         }
-         catch( EndOfFile& e )
-         {
-               // We need to close this data stream
-            (*this).close();
 
-            ObjectNotFound notFound("Antenna not found in Antex file.");
-            GPSTK_THROW(notFound);
-         }
-         catch(...)
-         {
-               // We need to close this data stream
-            (*this).close();
+      /* Method to get antenna data from a given IGS model.
+       *
+       * @param model      IGS antenna model
+       *
+       * @note Antenna model case is NOT relevant.
+       *
+       * @note IGS antenna model combines antenna type and radome.
+       *
+       * @warning The antenna returned will be the first one in the Antex
+       * file that matches the condition.
+       *
+       * @warning If IGS model doesn't include radome, method
+       * 'getAntennaNoRadome()' will be automatically called.
+       */
+   Antenna AntexReader::getAntenna(const string& model)
+      throw(ObjectNotFound)
+   {
 
-            InvalidAntex ia("Unknown error when reading Antex header.");
-            GPSTK_THROW(ia);
-         }
+         // Change input to upper case and strip leading and trailing spaces
+      string uModel( strip( upperCase( model.substr(0,15) ) ) );
 
-      }  // End of 'if( !antennaFound )...'
+         // Check if we have radome data here. If not, call alternative method
+      if( model.size() < 17 )
+      {
+         return getAntennaNoRadome(uModel);
+      }
 
+         // Get radome
+      string uRadome( strip( upperCase( model.substr(16,4) ) ) );
 
-         // We need to close this data stream
-      (*this).close();
+         // Antennas with this model, in file order
+      EntryListMap::const_iterator it( modelIndex.find(uModel) );
+      if( it != modelIndex.end() )
+      {
+         const EntryList& entries( (*it).second );
 
-         // Return antenna
-      return antenna;
+         for( size_t k = 0; k < entries.size(); ++k )
+         {
+               // Check if radome matches
+            if( uRadome == antennaIndex[ entries[k] ].radome )
+            {
+               return getAntennaEntry( entries[k] );
+            }
+         }
+      }
+
+      ObjectNotFound notFound("Antenna not found in Antex file.");
+      GPSTK_THROW(notFound);
 
    }  // End of method 'AntexReader::getAntenna()'
 
@@ -857,16 +1039,6 @@ namespace gpstk
       throw(ObjectNotFound)
    {
 
-         // Flag that signals if we found the antenna
-      bool antennaFound(false);
-
-         // Create 'Antenna' object to be returned
-      Antenna antenna;
-
-
-         // We need to read the data stream (file) from the beginning
-      FFTextStream::open( fileName.c_str(), std::ios::in );
-
          // Change input to upper case and strip leading and trailing spaces
       string uModel( strip( upperCase( model.substr(0,15) ) ) );
 
@@ -880,131 +1052,27 @@ namespace gpstk
          // Get serial
       string uSerial( strip( upperCase( serial ) ) );
 
-         // Getting antennas out of Antex file is a costly process, so this
-         // object will keep a "buffer" called 'antennaMap' where all antennas
-         // previously looked up are stored.
-         // Then, let's look first into this "buffer"
-      AntennaDataMap::const_iterator it1( antennaMap.find(uModel) );
-      if( it1 != antennaMap.end() )
+         // Antennas with this model, in file order
+      EntryListMap::const_iterator it( modelIndex.find(uModel) );
+      if( it != modelIndex.end() )
       {
+         const EntryList& entries( (*it).second );
 
-         RadSerCalValAntMap::const_iterator it2( (*it1).second.find(uRadome) );
-
-         if( it2 != (*it1).second.end() )
+         for( size_t k = 0; k < entries.size(); ++k )
          {
+            const AntennaEntry& entry( antennaIndex[ entries[k] ] );
 
-            SerCalValAntMap::const_iterator it3( (*it2).second.find(uSerial) );
-
-            if( it3 != (*it2).second.end() )
+               // Check if radome and serial match
+            if( uRadome == entry.radome &&
+                uSerial == entry.serial )
             {
-
-                  // Return the first antenna found. Note that there several
-                  // different maps in cascade.
-               CalValAntMap::const_iterator it4( (*it3).second.begin() );
-               ValAntMap::const_iterator it5( (*it4).second.begin() );
-
-                  // we found the antenna
-               antenna = (*it5).second;
-               antennaFound = true;
-
-            }  // End of 'if( it3 != (*it2).second.end() )...'
-
-         }  // End of 'if( it2 != (*it1).second.end() )...'
-
-      }  // End of 'if( it1 != antennaMap.end() )'
-
-
-         // Antenna is not in 'antennaMap': Let's look for it in file
-      if( !antennaFound )
-      {
-
-            // Antenna is not in 'antennaMap': Let's look for it in file
-         try
-         {
-
-               // Repeat until antenna is found or End Of File
-            while( !antennaFound )
-            {
-
-               std::string label;
-               std::string line;
-
-                  // Look for 'typeSerial' line
-               while( label != typeSerial )
-               {
-                     // Read one line from file
-                  formattedGetLine(line, true);
-
-                     // Get label
-                  label = strip( line.substr(60,20) );
-               }
-
-                  // Check if model matches. Read only model, not radome
-               if( uModel == strip( line.substr(0,15) ) )
-               {
-
-                     // Check if radome matches
-                  if( uRadome == strip( line.substr(16,4) ) )
-                  {
-
-                        // Check if serial matches
-                     if( uSerial == strip( line.substr(20,20) ) )
-                     {
-
-                           // We found the antenna. Fill it with data
-                        antenna = fillAntennaData( line );
-
-                           // Insert antenna into buffer 'antennaMap'
-                        antennaMap[ antenna.getAntennaType()      ]
-                                  [ antenna.getAntennaRadome()    ]
-                                  [ antenna.getAntennaSerial()    ]
-                                  [ antenna.getAntennaCalMethod() ]
-                                  [ antenna.getAntennaValidFrom() ] = antenna;
-
-                        antennaFound = true;
-
-                     }  // End of 'if( uSerial == strip( line.substr(20,20) ) )'
-
-                  }  // End of 'if( uModel == strip( line.substr(0,15) ) )...'
-
-               } // End of 'if( uModel == strip( line.substr(0,15) ) )...'
-
-            }  // End of 'while( !antennaFound )...'
-
-         }  // End of try block
-         catch( InvalidAntex& ia )
-         {
-
-               // We need to close this data stream
-            (*this).close();
-
-            GPSTK_RETHROW(ia);
-         }
-         catch( EndOfFile& e )
-         {
-               // We need to close this data stream
-            (*this).close();
-
-            ObjectNotFound notFound("Antenna not found in Antex file.");
-            GPSTK_THROW(notFound);
+               return getAntennaEntry( entries[k] );
+            }
          }
-         catch(...)
-         {
-               // We need to close this data stream
-            (*this).close();
-
-            InvalidAntex ia("Unknown error when reading Antex header.");
-            GPSTK_THROW(ia);
-         }
-
-      }  // End of 'if( !antennaFound )...'
-
-
-         // We need to close this data stream
-      (*this).close();
+      }
 
-         // Return antenna
-      return antenna;
+      ObjectNotFound notFound("Antenna not found in Antex file.");
+      GPSTK_THROW(notFound);
 
    }  // End of method 'AntexReader::getAntenna()'
 
@@ -1030,16 +1098,6 @@ namespace gpstk
       throw(ObjectNotFound)
    {
 
-         // Flag that signals if we found the antenna
-      bool antennaFound(false);
-
-         // Create 'Antenna' object to be returned
-      Antenna antenna;
-
-
-         // We need to read the data stream (file) from the beginning
-      FFTextStream::open( fileName.c_str(), std::ios::in );
-
          // Change input to upper case and strip leading and trailing spaces
       const string uModel( strip( upperCase( model.substr(0,15) ) ) );
 
@@ -1052,165 +1110,30 @@ namespace gpstk
 
       const string uSerial( strip( upperCase( serial ) ) );
 
-         // Getting antennas out of Antex file is a costly process, so this
-         // object will keep a "buffer" called 'antennaMap' where all antennas
-         // previously looked up are stored.
-         // Then, let's look first into this "buffer"
-      AntennaDataMap::const_iterator it1( antennaMap.find(uModel) );
-      if( it1 != antennaMap.end() )
+         // Antennas with this model, in file order
+      EntryListMap::const_iterator it( modelIndex.find(uModel) );
+      if( it != modelIndex.end() )
       {
+         const EntryList& entries( (*it).second );
 
-         RadSerCalValAntMap::const_iterator it2( (*it1).second.find(uRadome) );
-
-         if( it2 != (*it1).second.end() )
+         for( size_t k = 0; k < entries.size(); ++k )
          {
-
-            SerCalValAntMap::const_iterator it3( (*it2).second.find(uSerial) );
-
-            if( it3 != (*it2).second.end() )
+            const AntennaEntry& entry( antennaIndex[ entries[k] ] );
+
+               // Check if radome and serial match, and if this antenna
+               // is valid at 'epoch'
+            if( uRadome == entry.radome &&
+                uSerial == entry.serial &&
+                epoch >= entry.validFrom &&
+                epoch <= entry.validUntil )
             {
-
-                  // Return the first antenna found with this model, radome and
-                  // serial, and start looking from there. Note that
-                  // calibration value is not taken into account here.
-               CalValAntMap::const_iterator it4( (*it3).second.begin() );
-
-               while( !antennaFound &&
-                      it4 != (*it3).second.end() )
-               {
-
-                     // Let's define a reverse iterator
-                  ValAntMap::const_reverse_iterator it5(
-                                                      (*it4).second.rbegin() );
-
-                  while( !antennaFound &&
-                         it5 != (*it4).second.rend() )
-                  {
-
-                        // We found the antenna if 'epoch' is between
-                        // "Valid From" and "Valid Until" fields
-                     if( epoch >= (*it5).first &&
-                         epoch <= (*it5).second.getAntennaValidUntil() )
-                     {
-                           // We found the antenna
-                        antenna = (*it5).second;
-                        antennaFound = true;
-                     }
-
-                     ++it5;
-
-                  }  // End of 'while( !antennaFound && it5 != ...'
-
-                  ++it4;
-
-               }  // End of 'while( !antennaFound && it4 != ...'
-
-
-            }  // End of 'if( it3 != (*it2).second.end() )...'
-
-         }  // End of 'if( it2 != (*it1).second.end() )...'
-
-      }  // End of 'if( it1 != antennaMap.end() )...'
-
-
-         // Antenna is not in 'antennaMap': Let's look for it in file
-      if( !antennaFound )
-      {
-
-            // Antenna is not in 'antennaMap': Let's look for it in file
-         try
-         {
-
-               // Repeat until antenna is found or End Of File
-            while( !antennaFound )
-            {
-
-               std::string label;
-               std::string line;
-
-                  // Look for 'typeSerial' line
-               while( label != typeSerial )
-               {
-                     // Read one line from file
-                  formattedGetLine(line, true);
-
-                     // Get label
-                  label = strip( line.substr(60,20) );
-               }
-
-                  // Check if model matches. Read only model, not radome
-               if( uModel == strip( line.substr(0,15) ) )
-               {
-
-                     // Check if radome matches
-                  if( uRadome == strip( line.substr(16,4) ) )
-                  {
-
-                        // Check if serial matches
-                     if( uSerial == strip( line.substr(20,20) ) )
-                     {
-
-                           // Read the antenna.
-                        antenna = fillAntennaData( line );
-
-                           // Check if this antenna is valid at 'epoch'
-                        if( epoch >= antenna.getAntennaValidFrom() &&
-                            epoch <= antenna.getAntennaValidUntil() )
-                        {
-
-                              // We found it. Insert antenna into buffer
-                              // 'antennaMap'
-                           antennaMap[ antenna.getAntennaType()   ]
-                                  [ antenna.getAntennaRadome()    ]
-                                  [ antenna.getAntennaSerial()    ]
-                                  [ antenna.getAntennaCalMethod() ]
-                                  [ antenna.getAntennaValidFrom() ] = antenna;
-
-                           antennaFound = true;
-                        }
-
-                     }  // End of 'if( uSerial == strip( line.substr(20,20) ) )'
-
-                  }  // End of 'if( uModel == strip( line.substr(0,15) ) )...'
-
-               } // End of 'if( uModel == strip( line.substr(0,15) ) )...'
-
-            }  // End of 'while( !antennaFound )...'
-
-         }  // End of try block
-         catch( InvalidAntex& ia )
-         {
-
-               // We need to close this data stream
-            (*this).close();
-
-            GPSTK_RETHROW(ia);
-         }
-         catch( EndOfFile& e )
-         {
-               // We need to close this data stream
-            (*this).close();
-
-            ObjectNotFound notFound("Antenna not found in Antex file.");
-            GPSTK_THROW(notFound);
+               return getAntennaEntry( entries[k] );
+            }
          }
-         catch(...)
-         {
-               // We need to close this data stream
-            (*this).close();
-
-            InvalidAntex ia("Unknown error when reading Antex header.");
-            GPSTK_THROW(ia);
-         }
-
-      }  // End of 'if( !antennaFound )...'
-
-
-         // We need to close this data stream
-      (*this).close();
+      }
 
-         // Return antenna
-      return antenna;
+      ObjectNotFound notFound("Antenna not found in Antex file.");
+      GPSTK_THROW(notFound);
 
    }  // End of method 'AntexReader::getAntenna()'
 
@@ -1234,177 +1157,35 @@ namespace gpstk
       throw(ObjectNotFound)
    {
 
-         // Flag that signals if we found the antenna
-      bool antennaFound(false);
-
-         // Create 'Antenna' object to be returned
-      Antenna antenna;
-
-
-         // We need to read the data stream (file) from the beginning
-      FFTextStream::open( fileName.c_str(), std::ios::in );
-
       const string uSerial( strip( upperCase( serial ) ) );
 
-         // Getting antennas out of Antex file is a costly process, so this
-         // object will keep a "buffer" called 'antennaMap' where all antennas
-         // previously looked up are stored.
-         // Then, let's look first into this "buffer"
-      AntennaDataMap::const_iterator it1( antennaMap.begin() );
-      while( !antennaFound &&
-             it1 != antennaMap.end() )
+         // Antennas with this serial, in file order
+      EntryListMap::const_iterator it( serialIndex.find(uSerial) );
+      if( it != serialIndex.end() )
       {
+         const EntryList& entries( (*it).second );
 
-         RadSerCalValAntMap::const_iterator it2( (*it1).second.begin() );
-
-         while( !antennaFound &&
-                it2 != (*it1).second.end() )
+         for( size_t k = 0; k < entries.size(); ++k )
          {
+            const AntennaEntry& entry( antennaIndex[ entries[k] ] );
 
-               // Look for the serial
-            SerCalValAntMap::const_iterator it3( (*it2).second.find(uSerial) );
-
-            if( it3 != (*it2).second.end() )
+               // Check if this antenna is valid at 'epoch'
+            if( epoch >= entry.validFrom &&
+                epoch <= entry.validUntil )
             {
-
-                  // Return the first antenna found with this model, radome and
-                  // serial, and start looking from there. Note that
-                  // calibration value is not taken into account here.
-               CalValAntMap::const_iterator it4( (*it3).second.begin() );
-
-               while( !antennaFound &&
-                      it4 != (*it3).second.end() )
-               {
-
-                     // Let's define a reverse iterator
-                  ValAntMap::const_reverse_iterator it5(
-                                                      (*it4).second.rbegin() );
-
-                  while( !antennaFound &&
-                         it5 != (*it4).second.rend() )
-                  {
-
-                        // We found the antenna if 'epoch' is between
-                        // "Valid From" and "Valid Until" fields
-                     if( epoch >= (*it5).first &&
-                         epoch <= (*it5).second.getAntennaValidUntil() )
-                     {
-                           // We found the antenna
-                        antenna = (*it5).second;
-                        antennaFound = true;
-                     }
-
-                     ++it5;
-
-                  }  // End of 'while( !antennaFound && it5 != ...'
-
-                  ++it4;
-
-               }  // End of 'while( !antennaFound && it4 != ...'
-
-            }  // End of 'if( it3 != (*it2).second.end() )...'
-
-            ++it2;
-
-         }  // End of 'while( !antennaFound && it2 != ...'
-
-         ++it1;
-
-      }  // End of 'while( !antennaFound && it1 != antennaMap.end() )...'
-
-
-         // Antenna is not in 'antennaMap': Let's look for it in file
-      if( !antennaFound )
-      {
-
-            // Antenna is not in 'antennaMap': Let's look for it in file
-         try
-         {
-
-               // Repeat until antenna is found or End Of File
-            while( !antennaFound )
-            {
-
-               std::string label;
-               std::string line;
-
-                  // Look for 'typeSerial' line
-               while( label != typeSerial )
-               {
-                     // Read one line from file
-                  formattedGetLine(line, true);
-
-                     // Get label
-                  label = strip( line.substr(60,20) );
-               }
-
-                  // Check if serial matches
-               if( uSerial == strip( line.substr(20,20) ) )
-               {
-
-                     // Read the antenna.
-                  antenna = fillAntennaData( line );
-
-                     // Check if this antenna is valid at 'epoch'
-                  if( epoch >= antenna.getAntennaValidFrom() &&
-                      epoch <= antenna.getAntennaValidUntil() )
-                  {
-
-                        // We found it. Insert antenna into buffer 'antennaMap'
-                     antennaMap[ antenna.getAntennaType()      ]
-                               [ antenna.getAntennaRadome()    ]
-                               [ antenna.getAntennaSerial()    ]
-                               [ antenna.getAntennaCalMethod() ]
-                               [ antenna.getAntennaValidFrom() ] = antenna;
-
-                     antennaFound = true;
-
-                  }
-
-               }  // End of 'if( uSerial == strip( line.substr(20,20) ) )'
-
-            }  // End of 'while( !antennaFound )...'
-
-         }  // End of try block
-         catch( InvalidAntex& ia )
-         {
-
-               // We need to close this data stream
-            (*this).close();
-
-            GPSTK_RETHROW(ia);
-         }
-         catch( EndOfFile& e )
-         {
-               // We need to close this data stream
-            (*this).close();
-
-            ObjectNotFound notFound("Antenna not found in Antex file.");
-            GPSTK_THROW(notFound);
-         }
-         catch(...)
-         {
-               // We need to close this data stream
-            (*this).close();
-
-            InvalidAntex ia("Unknown error when reading Antex header.");
-            GPSTK_THROW(ia);
+               return getAntennaEntry( entries[k] );
+            }
          }
+      }
 
-      }  // End of 'if( !antennaFound )...'
-
-
-         // We need to close this data stream
-      (*this).close();
-
-         // Return antenna
-      return antenna;
+      ObjectNotFound notFound("Antenna not found in Antex file.");
+      GPSTK_THROW(notFound);
 
    }  // End of method 'AntexReader::getAntenna()'
 
 
 
-      // Method to open and load Antex file header data.
+      // Method to open and load Antex file header data and antenna index.
    void AntexReader::open(const char* fn)
    {
 
@@ -1417,7 +1198,10 @@ namespace gpstk
       FFTextStream::open(fn, std::ios::in);
 
          // We must be sure that previous antenna data is cleared.
-      antennaMap.clear();
+      antennaIndex.clear();
+      modelIndex.clear();
+      serialIndex.clear();
+      antennaCache.clear();
       version = 0.0;
       refAntena = "";
       refAntenaSerial = "";
@@ -1427,34 +1211,46 @@ namespace gpstk
          // Load header of Antex File
       loadHeader();
 
-      return;
+      if( valid )
+      {
 
-   }  // End of method 'AntexReader::open()'
+            // Take the index from the index file, if it is up to date.
+            // Otherwise, scan the Antex file
+         struct stat fileStat;
+         bool useIndexFile( !indexFileName.empty() &&
+                            stat(fn, &fileStat) == 0 );
 
+         if( !useIndexFile ||
+             !readIndexFile( static_cast<long>(fileStat.st_size),
+                             static_cast<long>(fileStat.st_mtime) ) )
+         {
+            scanAntennas();
 
+            if( useIndexFile )
+            {
+               writeIndexFile( static_cast<long>(fileStat.st_size),
+                               static_cast<long>(fileStat.st_mtime) );
+            }
+         }
 
-      // Method to open and load Antex file header data.
-   void AntexReader::open(const string& fn)
-   {
+         indexAntennas();
 
-      fileName = fn;
+      }  // End of 'if( valid )...'
 
-         // We need to be sure current data stream is closed
+         // Antennas are read when needed, reopening the file
       (*this).close();
 
-         // Open data stream
-      FFTextStream::open(fn.c_str(), std::ios::in);
+      return;
 
-         // We must be sure that previous antenna data is cleared.
-      antennaMap.clear();
-      version = 0.0;
-      refAntena = "";
-      refAntenaSerial = "";
-      commentList.clear();
-      valid = false;
+   }  // End of method 'AntexReader::open()'
 
-         // Load header of Antex File
-      loadHeader();
+
+
+      // Method to open and load Antex file header data and antenna index.
+   void AntexReader::open(const string& fn)
+   {
+
+      open( fn.c_str() );
 
       return;
 
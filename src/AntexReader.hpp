@@ -32,6 +32,7 @@
 
 
 #include <string>
+#include <vector>
 #include <map>
 
 #include "Exception.hpp"
@@ -84,6 +85,10 @@ namespace gpstk
        *      // Create AntexReader object
        *   AntexReader antexread;
        *
+       *      // Optionally, keep the antenna index in a file, so that next
+       *      // runs don't need to scan the Antex file
+       *   antexread.setIndexFile("igs05.atx.idx");
+       *
        *      // Open Antex file. 'igs05.atx' is for absolute phase centers,
        *      // while 'igs_01.atx' is for relative phase centers.
        *   antexread.open("igs05.atx");
@@ -93,7 +98,7 @@ namespace gpstk
        *
        *      // Get antenna data and eccentricity for L1 for satellite GPS-07
        *      // at a specific epoch
-       *   DayTime epoch(2008, 6, 15, 10, 21, 12654.0);
+       *   DayTime epoch(2008, 6, 15, 10, 21, 14.0);
        *   satGPS07 = antexread.getAntenna( "G07", epoch );
        *   cout << satGPS07.getAntennaPCOffset( Antenna::G01 ) << endl;
        *
@@ -114,6 +119,11 @@ namespace gpstk
        *
        * @endcode
        *
+       * When the file is opened, it is scanned once to build an index of
+       * the antennas it holds (model, radome, serial, validity and
+       * position in the file). Each antenna is then read from the file
+       * the first time it is asked for, and kept in memory afterwards.
+       *
        * @sa Antenna.hpp
        */
    class AntexReader : public FFTextStream
@@ -166,35 +176,59 @@ namespace gpstk
 
 
          /** Common constructor. It will always open Antex file for read and
-          *  will load Antex file header data in one pass.
+          *  will load Antex file header data and antenna index in one pass.
           *
           * @param fn   Antex data file to read
           *
           */
       AntexReader(const char* fn)
-         : FFTextStream( fn, std::ios::in )
-      { fileName = fn; loadHeader(); };
+         : version(1.3), valid(false)
+      { open(fn); };
 
 
          /** Common constructor. It will always open Antex file for read and
-          *  will load Antex file header data in one pass.
+          *  will load Antex file header data and antenna index in one pass.
           *
           * @param fn   Antex data file to read
           *
           */
       AntexReader(const string& fn)
-         : FFTextStream( fn.c_str(), std::ios::in )
-      { fileName = fn; loadHeader(); };
+         : version(1.3), valid(false)
+      { open(fn); };
 
 
-         /// Method to open and load Antex file header data.
+         /// Method to open and load Antex file header data and antenna index.
       virtual void open(const char* fn);
 
 
-         /// Method to open and load Antex file header data.
+         /// Method to open and load Antex file header data and antenna index.
       virtual void open(const string& fn);
 
 
+         /** Set the file where the antenna index is kept between runs.
+          *
+          * If this file exists and was built for the same Antex file (same
+          * size and modification time), open() takes the index from it
+          * instead of scanning the Antex file; otherwise open() scans the
+          * Antex file and (re)writes it. It must be set before open().
+          *
+          * @param fn   Index file name. Empty (the default) means that no
+          *             index file is used.
+          */
+      AntexReader& setIndexFile(const string& fn)
+      { indexFileName = fn; return (*this); };
+
+
+         /// Get the name of the file where the antenna index is kept.
+      string getIndexFile() const
+      { return indexFileName; };
+
+
+         /// Number of antennas in the Antex file.
+      size_t getNumAntennas() const
+      { return antennaIndex.size(); };
+
+
          /** Method to get antenna data from a given model. Just the model,
           *  without including the radome
           *
@@ -307,31 +341,50 @@ namespace gpstk
    private:
 
 
-         // Handy antenna data types
+         /// Index entry: where to find an antenna in the Antex file
+      struct AntennaEntry
+      {
+         string model;           ///< Antenna model, without radome
+         string radome;          ///< Radome
+         string serial;          ///< Serial number
+         DayTime validFrom;      ///< Start of validity period
+         DayTime validUntil;     ///< End of validity period
+         long offset;            ///< Position of 'typeSerial' line in file
+         unsigned int line;      ///< Line number of 'typeSerial' line
+      };
+
+
+         // Handy index data types
 
-         // Validity:Antennas
-      typedef std::map< DayTime, Antenna > ValAntMap;
+         // Positions in 'antennaIndex', in file order
+      typedef std::vector<size_t> EntryList;
 
-         // Calibration:Validity:Antennas
-      typedef std::map< string, ValAntMap > CalValAntMap;
+         // Model:Entries, or Serial:Entries
+      typedef std::map< string, EntryList > EntryListMap;
 
-         // Serial:Calibration:Validity:Antennas
-      typedef std::map< string, CalValAntMap > SerCalValAntMap;
+         // Position in 'antennaIndex':Antenna
+      typedef std::map< size_t, Antenna > AntennaCache;
 
-         // Radome:Serial:Calibration:Validity:Antennas
-      typedef std::map< string, SerCalValAntMap > RadSerCalValAntMap;
 
-         // Model:Radome:Serial:Calibration:Validity:Antennas
-      typedef std::map< string, RadSerCalValAntMap > AntennaDataMap;
+         /// All antennas in the Antex file, in file order
+      std::vector<AntennaEntry> antennaIndex;
 
+         /// Antennas in 'antennaIndex' by model
+      EntryListMap modelIndex;
 
-         /// Map holding antennas already serched for (Antenna buffer)
-      AntennaDataMap antennaMap;
+         /// Antennas in 'antennaIndex' by serial number
+      EntryListMap serialIndex;
+
+         /// Antennas already read from the file (Antenna buffer)
+      AntennaCache antennaCache;
 
 
          /// Antex file name
       string fileName;
 
+         /// Antenna index file name
+      string indexFileName;
+
          /// Antex file version
       double version;
 
@@ -363,6 +416,37 @@ namespace gpstk
       Antenna fillAntennaData( const std::string& firstLine );
 
 
+         /// Parse a 'validFrom' or 'validUntil' line
+      static DayTime parseValidity( const std::string& line );
+
+
+         /// Scan the rest of the file, after the header, to build the index
+      void scanAntennas()
+         throw( InvalidAntex,
+                FFStreamError,
+                gpstk::StringUtils::StringException );
+
+
+         /// Fill 'modelIndex' and 'serialIndex' from 'antennaIndex'
+      void indexAntennas();
+
+
+         /// Read the index from 'indexFileName'. Returns false if the file
+         /// is missing, damaged or for another version of the Antex file.
+      bool readIndexFile( long fileSize,
+                          long fileTime );
+
+
+         /// Write the index to 'indexFileName'.
+      void writeIndexFile( long fileSize,
+                           long fileTime ) const;
+
+
+         /// Get the antenna at position 'i' of 'antennaIndex'.
+      Antenna getAntennaEntry( size_t i )
+         throw(InvalidAntex);
+
+
          /// Method to load Antex file header data.
       virtual void loadHeader(void)
          throw( InvalidAntex,
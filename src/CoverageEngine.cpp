@@ -0,0 +1,434 @@
+#pragma ident "$Id$"
+
+/**
+ * @file CoverageEngine.cpp
+ * Satellite visibility and DOP over a fixed set of ground sites.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include <cmath>
+#include <algorithm>
+
+#include "CoverageEngine.hpp"
+#include "geometry.hpp"
+
+namespace gpstk
+{
+
+   namespace
+   {
+         // Sites per ThreadPool item: enough to amortize the scheduling,
+         // few enough to balance the threads on small grids.
+      const size_t blockSize = 64;
+
+
+         // Site and satellite arrays shared by the tasks
+      struct Geometry
+      {
+         const double *sx, *sy, *sz;
+         const double *ux, *uy, *uz;
+         const double *ex, *ey;
+         const double *nx, *ny, *nz;
+         const double *px, *py, *pz;
+         size_t numSites, numSats;
+         double cosMask;
+         bool inclusive;
+      };
+
+
+         // Cosine of the zenith angle of each satellite seen from site i
+      inline void cosZenith(const Geometry& g, size_t i, double* c)
+      {
+         const double x(g.sx[i]), y(g.sy[i]), z(g.sz[i]);
+         const double ux(g.ux[i]), uy(g.uy[i]), uz(g.uz[i]);
+         for (size_t j=0; j<g.numSats; j++)
+         {
+            double dx = g.px[j] - x;
+            double dy = g.py[j] - y;
+            double dz = g.pz[j] - z;
+            double r = std::sqrt(dx*dx + dy*dy + dz*dz);
+            c[j] = (ux*dx + uy*dy + uz*dz) / r;
+         }
+      }
+
+
+      class ElevationTask : public ThreadPoolTask
+      {
+      public:
+         ElevationTask(const Geometry& geo, double* e)
+            : g(geo), elev(e)
+         {}
+
+         virtual void process(size_t b)
+         {
+            size_t end = std::min(g.numSites, (b+1)*blockSize);
+            for (size_t i=b*blockSize; i<end; i++)
+            {
+               double* row = elev + i*g.numSats;
+               cosZenith(g, i, row);
+               for (size_t j=0; j<g.numSats; j++)
+               {
+                     // roundoff can put the cosine just outside [-1,1]
+                  double c = std::max(-1.0, std::min(1.0, row[j]));
+                  row[j] = 90.0 - std::acos(c) * RAD_TO_DEG;
+               }
+            }
+         }
+
+         const Geometry& g;
+         double* elev;
+      };
+
+
+      class CountTask : public ThreadPoolTask
+      {
+      public:
+         CountTask(const Geometry& geo, int* n)
+            : g(geo), counts(n)
+         {}
+
+         virtual void process(size_t b)
+         {
+            std::vector<double> c(g.numSats);
+            size_t end = std::min(g.numSites, (b+1)*blockSize);
+            for (size_t i=b*blockSize; i<end; i++)
+            {
+               cosZenith(g, i, &c[0]);
+               int n = 0;
+               for (size_t j=0; j<g.numSats; j++)
+                  n += (g.inclusive ? c[j] >= g.cosMask : c[j] > g.cosMask);
+               counts[i] = n;
+            }
+         }
+
+         const Geometry& g;
+         int* counts;
+      };
+
+
+      class DOPTask : public ThreadPoolTask
+      {
+      public:
+         DOPTask(const Geometry& geo, CoverageEngine::DOPs* d)
+            : g(geo), dops(d)
+         {}
+
+         virtual void process(size_t b)
+         {
+            const size_t ns = g.numSats;
+            std::vector<double> work(4*ns);
+            double* cu = &work[0];
+            double* ce = cu + ns;
+            double* cn = ce + ns;
+            double* w = cn + ns;
+
+            size_t end = std::min(g.numSites, (b+1)*blockSize);
+            for (size_t i=b*blockSize; i<end; i++)
+            {
+               const double x(g.sx[i]), y(g.sy[i]), z(g.sz[i]);
+               const double ux(g.ux[i]), uy(g.uy[i]), uz(g.uz[i]);
+               const double ex(g.ex[i]), ey(g.ey[i]);
+               const double nx(g.nx[i]), ny(g.ny[i]), nz(g.nz[i]);
+
+                  // Line of sight in up, east, north, and a 0/1 weight
+                  // for visibility; no branches, so this vectorizes
+               for (size_t j=0; j<ns; j++)
+               {
+                  double dx = g.px[j] - x;
+                  double dy = g.py[j] - y;
+                  double dz = g.pz[j] - z;
+                  double r = 1.0 / std::sqrt(dx*dx + dy*dy + dz*dz);
+                  cu[j] = (ux*dx + uy*dy + uz*dz) * r;
+                  ce[j] = (ex*dx + ey*dy) * r;
+                  cn[j] = (nx*dx + ny*dy + nz*dz) * r;
+                  w[j] = (g.inclusive ? cu[j] >= g.cosMask
+                                      : cu[j] > g.cosMask) ? 1.0 : 0.0;
+               }
+
+                  // Normal matrix of the UENT solution: the sum of g*g^T
+                  // with g = (u, e, n, 1) over the visible satellites
+               double uu(0), ue(0), un(0), ut(0), ee(0), en(0), et(0);
+               double nn(0), nt(0), tt(0);
+               for (size_t j=0; j<ns; j++)
+               {
+                  double u = w[j]*cu[j], e = w[j]*ce[j], n = w[j]*cn[j];
+                  uu += u*cu[j];  ue += u*ce[j];  un += u*cn[j];  ut += u;
+                  ee += e*ce[j];  en += e*cn[j];  et += e;
+                  nn += n*cn[j];  nt += n;
+                  tt += w[j];
+               }
+
+               CoverageEngine::DOPs& d = dops[i];
+               d.nsvs = int(tt + 0.5);
+               d.valid = false;
+               d.gdop = d.pdop = d.hdop = d.vdop = d.tdop = 0.0;
+               if (d.nsvs < 4)
+                  continue;
+
+                  // Cholesky factor L of the normal matrix ...
+               double L[4][4];
+               double N[4][4] = { { uu, ue, un, ut },
+                                  { ue, ee, en, et },
+                                  { un, en, nn, nt },
+                                  { ut, et, nt, tt } };
+               bool ok = true;
+               for (int k=0; k<4 && ok; k++)
+               {
+                  double s = N[k][k];
+                  for (int m=0; m<k; m++)
+                     s -= L[k][m]*L[k][m];
+                  if (s <= 0.0)
+                  {
+                     ok = false;
+                     break;
+                  }
+                  L[k][k] = std::sqrt(s);
+                  for (int r=k+1; r<4; r++)
+                  {
+                     double t = N[r][k];
+                     for (int m=0; m<k; m++)
+                        t -= L[r][m]*L[k][m];
+                     L[r][k] = t / L[k][k];
+                  }
+               }
+                  // singular geometry: valid stays false with nsvs >= 4
+               if (!ok)
+                  continue;
+
+                  // ... whose inverse M gives diag(N^-1) = column sums
+                  // of M^2, M lower triangular
+               double M[4][4];
+               for (int c=0; c<4; c++)
+               {
+                  M[c][c] = 1.0 / L[c][c];
+                  for (int r=c+1; r<4; r++)
+                  {
+                     double s = 0.0;
+                     for (int m=c; m<r; m++)
+                        s -= L[r][m]*M[m][c];
+                     M[r][c] = s / L[r][r];
+                  }
+               }
+               double q[4];
+               for (int c=0; c<4; c++)
+               {
+                  q[c] = 0.0;
+                  for (int r=c; r<4; r++)
+                     q[c] += M[r][c]*M[r][c];
+               }
+
+               d.vdop = std::sqrt(q[0]);
+               d.hdop = std::sqrt(q[1] + q[2]);
+               d.tdop = std::sqrt(q[3]);
+               d.pdop = std::sqrt(q[0] + q[1] + q[2]);
+               d.gdop = std::sqrt(q[0] + q[1] + q[2] + q[3]);
+               d.valid = true;
+            }
+         }
+
+         const Geometry& g;
+         CoverageEngine::DOPs* dops;
+      };
+
+   }  // End of anonymous namespace
+
+
+
+      // Common constructor.
+   CoverageEngine::CoverageEngine(unsigned int numThreads)
+      throw(Exception)
+      : cosMask(1.0), maskInclusive(true), pool(numThreads)
+   {
+      setElevationMask(0.0);
+   }
+
+
+
+      // Remove all sites.
+   void CoverageEngine::clearSites()
+   {
+      sx.clear(); sy.clear(); sz.clear();
+      ux.clear(); uy.clear(); uz.clear();
+      ex.clear(); ey.clear();
+      nx.clear(); ny.clear(); nz.clear();
+   }
+
+
+
+      // Add a site and return its index, counting from 0.
+   size_t CoverageEngine::addSite(const Position& site, UpVector up)
+   {
+      double x(site.X()), y(site.Y()), z(site.Z());
+      double lon = site.getLongitude() * DEG_TO_RAD;
+      double lat = (up == Geodetic) ? site.getGeodeticLatitude()
+                                    : site.getGeocentricLatitude();
+      lat *= DEG_TO_RAD;
+
+      double ca(std::cos(lat)), sa(std::sin(lat));
+      double co(std::cos(lon)), so(std::sin(lon));
+
+      sx.push_back(x);
+      sy.push_back(y);
+      sz.push_back(z);
+
+      if (up == Geodetic)
+      {
+         ux.push_back(ca*co);
+         uy.push_back(ca*so);
+         uz.push_back(sa);
+      }
+      else
+      {
+            // straight from the position vector, as Triple::elvAngle
+         double r = std::sqrt(x*x + y*y + z*z);
+         ux.push_back(x/r);
+         uy.push_back(y/r);
+         uz.push_back(z/r);
+      }
+
+      ex.push_back(-so);
+      ey.push_back(co);
+
+      nx.push_back(-sa*co);
+      ny.push_back(-sa*so);
+      nz.push_back(ca);
+
+      return sx.size() - 1;
+   }
+
+
+
+      // Set the elevation mask, in degrees.
+   void CoverageEngine::setElevationMask(double mask, bool inclusive)
+   {
+      cosMask = std::cos((90.0 - mask) * DEG_TO_RAD);
+      maskInclusive = inclusive;
+   }
+
+
+
+      // Set the satellite positions (ECEF, meters) for the epoch.
+   void CoverageEngine::setSatellites(const std::vector<Triple>& svPos)
+   {
+      size_t n = svPos.size();
+      px.resize(n);
+      py.resize(n);
+      pz.resize(n);
+      for (size_t j=0; j<n; j++)
+      {
+         px[j] = svPos[j][0];
+         py[j] = svPos[j][1];
+         pz[j] = svPos[j][2];
+      }
+   }
+
+
+
+   namespace
+   {
+      template <class V>
+      const double* ptr(const V& v)
+      { return v.empty() ? 0 : &v[0]; }
+   }
+
+
+
+      // Compute the elevation of every satellite at every site.
+   void CoverageEngine::computeElevations(std::vector<double>& elev)
+      throw(Exception)
+   {
+      Geometry g = { ptr(sx), ptr(sy), ptr(sz), ptr(ux), ptr(uy), ptr(uz),
+                     ptr(ex), ptr(ey), ptr(nx), ptr(ny), ptr(nz),
+                     ptr(px), ptr(py), ptr(pz),
+                     sx.size(), px.size(), cosMask, maskInclusive };
+
+      elev.resize(g.numSites * g.numSats);
+      if (elev.empty())
+         return;
+
+      ElevationTask task(g, &elev[0]);
+      pool.run(task, (g.numSites + blockSize - 1) / blockSize);
+   }
+
+
+
+      // Compute the number of satellites visible from each site.
+   void CoverageEngine::countVisible(std::vector<int>& counts)
+      throw(Exception)
+   {
+      Geometry g = { ptr(sx), ptr(sy), ptr(sz), ptr(ux), ptr(uy), ptr(uz),
+                     ptr(ex), ptr(ey), ptr(nx), ptr(ny), ptr(nz),
+                     ptr(px), ptr(py), ptr(pz),
+                     sx.size(), px.size(), cosMask, maskInclusive };
+
+      counts.assign(g.numSites, 0);
+      if (counts.empty() || g.numSats == 0)
+         return;
+
+      CountTask task(g, &counts[0]);
+      pool.run(task, (g.numSites + blockSize - 1) / blockSize);
+   }
+
+
+
+      // Compute the DOPs of each site.
+   void CoverageEngine::computeDOPs(std::vector<DOPs>& dops)
+      throw(Exception)
+   {
+      Geometry g = { ptr(sx), ptr(sy), ptr(sz), ptr(ux), ptr(uy), ptr(uz),
+                     ptr(ex), ptr(ey), ptr(nx), ptr(ny), ptr(nz),
+                     ptr(px), ptr(py), ptr(pz),
+                     sx.size(), px.size(), cosMask, maskInclusive };
+
+      dops.resize(g.numSites);
+      if (dops.empty())
+         return;
+
+      if (g.numSats == 0)
+      {
+         DOPs none = { 0.0, 0.0, 0.0, 0.0, 0.0, 0, false };
+         dops.assign(g.numSites, none);
+         return;
+      }
+
+      DOPTask task(g, &dops[0]);
+      pool.run(task, (g.numSites + blockSize - 1) / blockSize);
+   }
+
+}  // End of namespace gpstk
@@ -0,0 +1,214 @@
+#pragma ident "$Id$"
+
+/**
+ * @file CoverageEngine.hpp
+ * Satellite visibility and DOP over a fixed set of ground sites.
+ */
+
+#ifndef GPSTK_COVERAGEENGINE_HPP
+#define GPSTK_COVERAGEENGINE_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include <vector>
+
+#include "Exception.hpp"
+#include "Triple.hpp"
+#include "Position.hpp"
+#include "ThreadPool.hpp"
+
+namespace gpstk
+{
+
+      /** @addtogroup GPSsolutions */
+      //@{
+
+      /**
+       * Computes satellite elevations, visibility and DOPs for many ground
+       * sites at once, one epoch at a time. The sites are given once;
+       * their ECEF position and local up, east and north unit vectors are
+       * kept, so nothing is converted again at each epoch. Then, for each
+       * epoch, the satellite positions are given and the results for all
+       * sites are computed in blocks of sites shared by the threads of a
+       * ThreadPool. The data is kept as arrays of coordinates, so the
+       * loops over satellites can be vectorized by the compiler.
+       *
+       * @code
+       * CoverageEngine ce;
+       * ce.setElevationMask(5.0, false);
+       * for (i=0; i<grid.size(); i++)
+       *    ce.addSite(Position(grid[i].lat, grid[i].lon, 0.0,
+       *                        Position::Geodetic));
+       * for (t=start; t<end; t+=dt)
+       * {
+       *    ce.setSatellites(svPositions(t));
+       *    ce.computeDOPs(dops);
+       *    ...
+       * }
+       * @endcode
+       *
+       * The DOPs are those of the usual 4-parameter (position and clock)
+       * solution, in the local up, east, north frame, as in Misra & Enge,
+       * GPS 2ed, p203.
+       */
+   class CoverageEngine
+   {
+   public:
+
+         /// Which local vertical to use for a site's elevations
+      enum UpVector
+      {
+         Geodetic,      ///< normal to the ellipsoid, as Position::elevationGeodetic
+         Geocentric     ///< along the position vector, as Triple::elvAngle
+      };
+
+         /// DOPs at one site
+      struct DOPs
+      {
+         double gdop;
+         double pdop;
+         double hdop;
+         double vdop;
+         double tdop;
+         int nsvs;      ///< satellites above the mask
+         bool valid;    ///< false if fewer than 4 satellites were visible,
+                        ///< or their geometry was singular
+      };
+
+
+         /** Common constructor.
+          *
+          * @param numThreads number of threads to use; 0 means one per
+          *        processor.
+          */
+      CoverageEngine(unsigned int numThreads = 0)
+         throw(Exception);
+
+
+         /// Destructor
+      virtual ~CoverageEngine() {};
+
+
+         /// Remove all sites.
+      void clearSites();
+
+
+         /** Add a site and return its index, counting from 0.
+          *
+          * @param site  the site position, in any coordinate system
+          * @param up    the vertical its elevations are measured from
+          */
+      size_t addSite(const Position& site, UpVector up = Geodetic);
+
+
+         /// Number of sites
+      size_t getNumSites() const
+      { return sx.size(); };
+
+
+         /** Set the elevation mask, in degrees. A satellite is visible
+          *  if its elevation is above the mask, or equal to it when
+          *  \a inclusive is true. The default mask is 0, inclusive.
+          */
+      void setElevationMask(double mask, bool inclusive = true);
+
+
+         /// Set the satellite positions (ECEF, meters) for the epoch.
+      void setSatellites(const std::vector<Triple>& svPos);
+
+
+         /// Number of satellites set for the epoch
+      size_t getNumSatellites() const
+      { return px.size(); };
+
+
+         /** Compute the elevation, in degrees, of every satellite at
+          *  every site.
+          *
+          * @param elev  on return, the elevation of satellite j at site i
+          *              is elev[i*getNumSatellites() + j]
+          */
+      void computeElevations(std::vector<double>& elev)
+         throw(Exception);
+
+
+         /** Compute the number of satellites visible from each site.
+          *
+          * @param counts  on return, one count per site
+          */
+      void countVisible(std::vector<int>& counts)
+         throw(Exception);
+
+
+         /** Compute the DOPs of each site, using the satellites visible
+          *  from it.
+          *
+          * @param dops  on return, one DOPs per site
+          */
+      void computeDOPs(std::vector<DOPs>& dops)
+         throw(Exception);
+
+
+   private:
+
+         /// Site positions, and up, east and north unit vectors. East
+         /// has no z component.
+      std::vector<double> sx, sy, sz;
+      std::vector<double> ux, uy, uz;
+      std::vector<double> ex, ey;
+      std::vector<double> nx, ny, nz;
+
+         /// Satellite positions of the epoch
+      std::vector<double> px, py, pz;
+
+         /// Cosine of the zenith angle at the mask
+      double cosMask;
+
+         /// Whether satellites at the mask count as visible
+      bool maskInclusive;
+
+         /// Threads that do the work
+      ThreadPool pool;
+
+   }; // End of class 'CoverageEngine'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_COVERAGEENGINE_HPP
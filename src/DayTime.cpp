@@ -55,38 +55,184 @@
 
 #include "gpstkplatform.h"
 #include "DayTime.hpp"
+#include "DayTimeFormat.hpp"
 
 namespace gpstk
 {
    using namespace std;
    using namespace gpstk::StringUtils;
 
-      // ----------- Part  0: month and day labels -------------------
+      // ----------- Part  0: calendar -----------------------------
       //
-      /// Long month names for converstion from numbers to strings
-   static const char *MonthNames[] = { 
-      "Error",
-      "January","February", "March", "April",
-      "May", "June","July", "August",
-      "September", "October", "November", "December"
-   };
-  
-      /// Short month names for converstion from numbers to strings
-   static const char *MonthAbbrevNames[] = {
-      "err", "Jan", "Feb", "Mar", "Apr", "May", "Jun","Jul",
-      "Aug", "Sep", "Oct", "Nov", "Dec"
-   };
-  
-      /// Long day of week names for converstion from numbers to strings
-   static const char *DayOfWeekNames[] = {
-      "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday",
-      "Friday", "Saturday"
-   };
-
-      /// Short day of week names for converstion from numbers to strings
-   static const char *DayOfWeekAbbrevNames[] = {
-      "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
-   };
+   namespace
+   {
+         // These two routines convert 'integer JD' and calendar time; they
+         // were derived from Sinnott, R. W. "Bits and Bytes" Sky & Telescope
+         // Magazine, Vol 82, p. 183, August 1991, and The Astronomical
+         // Almanac, published by the U.S. Naval Observatory.
+         // NB range of applicability of this routine is from 0JD (4713BC)
+         // to approx 3442448JD (4713AD).
+      void jdToCalendar(long jd, 
+                        int& iyear, 
+                        int& imonth,
+                        int& iday)
+      {
+         long L, M, N, P, Q;
+         if(jd > 2299160)    // after Oct 4, 1582
+         {
+            L = jd + 68569;
+            M = (4 * L) / 146097;
+            L = L - ((146097 * M + 3) / 4);
+            N = (4000 * (L + 1)) / 1461001;
+            L = L - ((1461 * N) / 4) + 31;
+            P = (80 * L) / 2447;
+            iday = int(L - (2447 * P) / 80);
+            L = P / 11;
+            imonth = int(P + 2 - 12 * L);
+            iyear = int(100 * (M - 49) + N + L);
+         }
+         else 
+         {
+            P = jd + 1402;
+            Q = (P - 1) / 1461;
+            L = P - 1461 * Q;
+            M = (L - 1) / 365 - L / 1461;
+            N = L - 365 * M + 30;
+            P = (80 * N) / 2447;
+            iday = int(N - (2447 * P) / 80);
+            N = P / 11;
+            imonth = int(P + 2 - 12 * N);
+            iyear = int(4 * Q + M + N - 4716);
+            if(iyear <= 0) 
+            {
+               --iyear;
+            }
+         }
+            // catch century/non-400 non-leap years
+         if(iyear > 1599 && 
+            !(iyear % 100) && 
+            (iyear % 400) && 
+            imonth == 2 && 
+            iday == 29)
+         {
+            imonth = 3;
+            iday = 1;
+         }
+      }
+
+      long calendarToJD(int yy, 
+                        int mm,
+                        int dd) 
+      {
+         if(yy == 0)
+            --yy;         // there is no year 0
+
+         if(yy < 0) 
+            ++yy;
+      
+         long jd;
+         double y = double(yy), m = double(mm);
+
+            // In the conversion from the Julian Calendar to the Gregorian
+            // Calendar the day after October 4, 1582 was October 15, 1582.
+            //
+            // if the date is before October 15, 1582
+         if(yy < 1582 || (yy == 1582 && (mm < 10 || (mm == 10 && dd < 15))))
+         {
+            jd = 1729777 + dd + 367 * yy 
+               - long(7 * ( y + 5001 + long((m - 9) / 7)) / 4) 
+               + long(275 * m / 9);
+         }
+         else   // after Oct 4, 1582
+         {     
+           jd = 1721029 + dd + 367 * yy 
+              - long(7 * (y + long((m + 9) / 12)) / 4)
+              - long(3 * (long((y + (m - 9) / 7) / 100) + 1) / 4) 
+              + long(275 * m / 9);
+
+               // catch century/non-400 non-leap years
+            if( (! (yy % 100) && 
+                 (yy % 400) && 
+                 mm > 2 && 
+                 mm < 9)      || 
+                (!((yy - 1) % 100) &&
+                 ((yy - 1) % 400) &&
+                 mm == 1)) 
+            {
+               --jd;
+            }
+         }
+         return jd;
+      }
+
+         /// Days before each month (and in the year), common and leap years
+      const int daysBeforeMonth[2][13] = {
+         { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365 },
+         { 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366 }
+      };
+
+         /// Set when calendarTable has been built.  It is statically
+         /// initialized, so it is false while static objects of other
+         /// files are made before the table; the routines above are used
+         /// until then.
+      bool calendarBuilt = false;
+
+         /// Calendar of the years nearly all times fall in, so that the
+         /// conversions are a lookup.  It is built from the routines above,
+         /// so the results are the same.
+      struct CalendarTable
+      {
+         enum { FIRST_YEAR = 1600, YEARS = 800 };
+
+         CalendarTable()
+         {
+            for (int i = 0; i <= YEARS; i++)
+               yearStart[i] = calendarToJD(FIRST_YEAR + i, 1, 1);
+
+            for (int leap = 0; leap < 2; leap++)
+               for (int m = 1; m <= 12; m++)
+                  for (int d = daysBeforeMonth[leap][m-1];
+                       d < daysBeforeMonth[leap][m]; d++)
+                     monthOfDay[leap][d] = (unsigned char)m;
+
+            calendarBuilt = true;
+         }
+
+            /// 1 if the year at this index is a leap year
+         int leap(int i) const
+         { return (yearStart[i+1] - yearStart[i] == 366) ? 1 : 0; }
+
+            /// 'Julian day' of January 1 of FIRST_YEAR+i, up to the year
+            /// after the last
+         long yearStart[YEARS + 1];
+
+            /// Month of each (0-based) day of the year, common and leap
+         unsigned char monthOfDay[2][366];
+      };
+
+         /// Built during static initialization, before main() and so
+         /// before any thread can use it.  A function-local static would be
+         /// built on first use, which C++98 doesn't make thread safe.
+      const CalendarTable calendarTable;
+
+         /// The 'Julian day' of a valid date in the table.
+         /// @return false if the date is invalid or not in the table
+      inline bool tableJD(int yy, int mm, int dd, long& jd)
+      {
+         int i = yy - CalendarTable::FIRST_YEAR;
+         if (!calendarBuilt || i < 0 || i >= CalendarTable::YEARS ||
+             mm < 1 || mm > 12 || dd < 1)
+            return false;
+
+         const CalendarTable& cal = calendarTable;
+         const int* before = daysBeforeMonth[cal.leap(i)];
+         if (dd > before[mm] - before[mm-1])
+            return false;
+
+         jd = cal.yearStart[i] + before[mm-1] + dd - 1;
+         return true;
+      }
+   }
 
       // ----------- Part  1: exceptions and constants ---------------
       //
@@ -1045,7 +1191,16 @@ namespace gpstk
                             TimeFrame f)
       throw(DayTime::DayTimeException)
    {
-      long tempDay = convertCalendarToJD(yy, mm, dd);
+      long tempDay;
+         // a date found in the calendar table is valid
+      if(tableJD(yy, mm, dd, tempDay))
+      {
+         jday = tempDay;
+         timeFrame = f;
+         return *this;
+      }
+
+      tempDay = convertCalendarToJD(yy, mm, dd);
       if(DAYTIME_TEST_VALID) 
       {
          int y, m, d;
@@ -1073,7 +1228,11 @@ namespace gpstk
       throw(DayTime::DayTimeException)
    {
       double sod = convertTimeToSOD(hh, mm, sec);
-      if(DAYTIME_TEST_VALID) 
+         // fields in range that add up to the same minute need no round trip
+      bool inRange = (hh >= 0 && hh < 24 && mm >= 0 && mm < 60 &&
+                      sec >= 0.0 && sec < 60.0 &&
+                      long(sod) / 60 == hh * 60 + mm);
+      if(DAYTIME_TEST_VALID && !inRange) 
       {
          int h, m;
          double s;
@@ -1552,59 +1711,7 @@ namespace gpstk
    string DayTime::printf(const char *fmt) const
       throw(gpstk::StringUtils::StringException)
    {
-      string rv = fmt;
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*S"), 
-                          string("Sd"), (short)second());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*(\\.[[:digit:]]+)?f"),
-                          string("ff"), second());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*G"),
-                          string("Ghd"), GPS10bitweek());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*F"),
-                          string("Fhd"), GPSfullweek());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*(\\.[[:digit:]]+)?g"),
-                          string("gf"), GPSsow());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*(\\.[[:digit:]]+)?s"),
-                          string("sf"), DOYsecond());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*(\\.[[:digit:]]+)?Q"),
-                          string("QLf"), getMJDasLongDouble());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*Y"),
-                          string("Yhd"), year());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*y"),
-                          string("yhd"), (short)(year() % 100));
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*m"),
-                          string("mhd"), month());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*b"),
-                          string("bs"), MonthAbbrevNames[month()]);
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*B"),
-                          string("Bs"), MonthNames[month()]);
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*d"),
-                          string("dhd"), day());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*H"),
-                          string("Hhd"), hour());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*M"),
-                          string("Mhd"), minute());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*w"),
-                          string("whd"), dayOfWeek());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*a"),
-                          string("as"), DayOfWeekAbbrevNames[dayOfWeek()]);
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*A"),
-                          string("As"), DayOfWeekNames[dayOfWeek()]);
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*z"),
-                          string("zd"), GPSzcountFloor());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*Z"),
-                          string("Zd"), GPSzcount());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*U"),
-                          string("Ud"), unixTime().tv_sec);
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*u"),
-                          string("ud"), unixTime().tv_usec);
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*j"),
-                          string("jhd"), DOY());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*C"),
-                          string("Cd"), fullZcount());
-      rv = formattedPrint(rv, string("%[ 0-]?[[:digit:]]*c"),
-                          string("cd"), fullZcountFloor());
-
-      return rv;
+      return DayTimeFormat(fmt).print(*this);
    }
 
       // Format this time into a string.
@@ -1671,59 +1778,34 @@ namespace gpstk
 
       // ----------- Part 11: functions: fundamental conversions -----------
       //
-      // These two routines convert 'integer JD' and calendar time; they were
-      // derived from Sinnott, R. W. "Bits and Bytes" Sky & Telescope Magazine,
-      // Vol 82, p. 183, August 1991, and The Astronomical Almanac, published
-      // by the U.S. Naval Observatory.
-      // NB range of applicability of this routine is from 0JD (4713BC)
-      // to approx 3442448JD (4713AD).
    void DayTime::convertJDtoCalendar(long jd, 
                                      int& iyear, 
                                      int& imonth,
                                      int& iday)
       throw()
    {
-      long L, M, N, P, Q;
-      if(jd > 2299160)    // after Oct 4, 1582
+      const CalendarTable& cal = calendarTable;
+      if (!calendarBuilt ||
+          jd < cal.yearStart[0] || jd >= cal.yearStart[CalendarTable::YEARS])
       {
-         L = jd + 68569;
-         M = (4 * L) / 146097;
-         L = L - ((146097 * M + 3) / 4);
-         N = (4000 * (L + 1)) / 1461001;
-         L = L - ((1461 * N) / 4) + 31;
-         P = (80 * L) / 2447;
-         iday = int(L - (2447 * P) / 80);
-         L = P / 11;
-         imonth = int(P + 2 - 12 * L);
-         iyear = int(100 * (M - 49) + N + L);
-      }
-      else 
-      {
-         P = jd + 1402;
-         Q = (P - 1) / 1461;
-         L = P - 1461 * Q;
-         M = (L - 1) / 365 - L / 1461;
-         N = L - 365 * M + 30;
-         P = (80 * N) / 2447;
-         iday = int(N - (2447 * P) / 80);
-         N = P / 11;
-         imonth = int(P + 2 - 12 * N);
-         iyear = int(4 * Q + M + N - 4716);
-         if(iyear <= 0) 
-         {
-            --iyear;
-         }
-      }
-         // catch century/non-400 non-leap years
-      if(iyear > 1599 && 
-         !(iyear % 100) && 
-         (iyear % 400) && 
-         imonth == 2 && 
-         iday == 29)
-      {
-         imonth = 3;
-         iday = 1;
+         jdToCalendar(jd, iyear, imonth, iday);
+         return;
       }
+
+         // 146097 days in 400 years gives the year, or the one next to it
+      int i = int((jd - cal.yearStart[0]) * 400 / 146097);
+      if (i >= CalendarTable::YEARS)
+         i = CalendarTable::YEARS - 1;
+      while (cal.yearStart[i] > jd)
+         i--;
+      while (cal.yearStart[i+1] <= jd)
+         i++;
+
+      int leap = cal.leap(i);
+      int doy = int(jd - cal.yearStart[i]);
+      imonth = cal.monthOfDay[leap][doy];
+      iday = doy - daysBeforeMonth[leap][imonth-1] + 1;
+      iyear = CalendarTable::FIRST_YEAR + i;
    }
    
    long DayTime::convertCalendarToJD(int yy, 
@@ -1731,45 +1813,10 @@ namespace gpstk
                                      int dd) 
       throw()
    {
-      if(yy == 0)
-         --yy;         // there is no year 0
-
-      if(yy < 0) 
-         ++yy;
-      
       long jd;
-      double y = double(yy), m = double(mm), d = double(dd);
-
-         // In the conversion from the Julian Calendar to the Gregorian
-         // Calendar the day after October 4, 1582 was October 15, 1582.
-         //
-         // if the date is before October 15, 1582
-      if(yy < 1582 || (yy == 1582 && (mm < 10 || (mm == 10 && dd < 15))))
-      {
-         jd = 1729777 + dd + 367 * yy 
-            - long(7 * ( y + 5001 + long((m - 9) / 7)) / 4) 
-            + long(275 * m / 9);
-      }
-      else   // after Oct 4, 1582
-      {     
-        jd = 1721029 + dd + 367 * yy 
-           - long(7 * (y + long((m + 9) / 12)) / 4)
-           - long(3 * (long((y + (m - 9) / 7) / 100) + 1) / 4) 
-           + long(275 * m / 9);
-
-            // catch century/non-400 non-leap years
-         if( (! (yy % 100) && 
-              (yy % 400) && 
-              mm > 2 && 
-              mm < 9)      || 
-             (!((yy - 1) % 100) &&
-              ((yy - 1) % 400) &&
-              mm == 1)) 
-         {
-            --jd;
-         }
-      }
-      return jd;
+      if (tableJD(yy, mm, dd, jd))
+         return jd;
+      return calendarToJD(yy, mm, dd);
    }
 
    void DayTime::convertSODtoTime(double sod, 
@@ -1081,6 +1081,9 @@ namespace gpstk
           *
           * @warning See above note.
           *
+          * To format many times the same way, compile the format once into
+          * a DayTimeFormat instead.
+          *
           * @param fmt format to use for this time.
           * @return a string containing this time in the
           * representation specified by \c fmt.
@@ -1166,6 +1169,9 @@ namespace gpstk
          // ----------- Part 12: private functions and member data ----------
          //
    private:
+         /// TimeKey converts straight from and to the internal representation
+      friend class TimeKey;
+
          /// Initialization method.  Used by the constructors.
       void init() 
          throw();
@@ -0,0 +1,460 @@
+#pragma ident "$Id$"
+
+
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file DayTimeFormat.cpp
+ * gpstk::DayTimeFormat - a DayTime::printf() format, compiled once
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+#include "DayTimeFormat.hpp"
+
+namespace gpstk
+{
+   using namespace std;
+
+   const char * const DayTimeFormat::MonthNames[13] = {
+      "Error",
+      "January","February", "March", "April",
+      "May", "June","July", "August",
+      "September", "October", "November", "December"
+   };
+
+   const char * const DayTimeFormat::MonthAbbrevNames[13] = {
+      "err", "Jan", "Feb", "Mar", "Apr", "May", "Jun","Jul",
+      "Aug", "Sep", "Oct", "Nov", "Dec"
+   };
+
+   const char * const DayTimeFormat::DayOfWeekNames[7] = {
+      "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday",
+      "Friday", "Saturday"
+   };
+
+   const char * const DayTimeFormat::DayOfWeekAbbrevNames[7] = {
+      "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+   };
+
+   namespace
+   {
+         /// Conversions DayTime::printf() knows, and those of them that
+         /// take a precision
+      const char * const CONVERSIONS = "SfGFgsQYymbBdHMwaAzZUujCc";
+      const char * const FLOAT_CONVERSIONS = "fgsQ";
+
+         /// Output to a buffer that counts, as snprintf() does, what
+         /// doesn't fit
+      class Output
+      {
+      public:
+         Output(char* b, size_t s)
+               : buf(b), size(s), count(0)
+         {}
+
+         void put(char c)
+         {
+            if (count + 1 < size)
+               buf[count] = c;
+            count++;
+         }
+
+         void put(const char* s, size_t n)
+         {
+            for (size_t i = 0; i < n; i++)
+               put(s[i]);
+         }
+
+         size_t finish()
+         {
+            if (size)
+               buf[(count < size) ? count : size - 1] = '\0';
+            return count;
+         }
+
+      private:
+         char* buf;
+         size_t size;
+         size_t count;
+      };
+
+         /// Same as sprintf() with "%d" and the flag and width given
+      void putInt(Output& out, long v, char flag, int width)
+      {
+         char digits[24];
+         int n = 0;
+         unsigned long u = (v < 0) ? 0UL - (unsigned long)v : (unsigned long)v;
+         do
+         {
+            digits[n++] = char('0' + u % 10);
+            u /= 10;
+         } while (u);
+
+         char sign = (v < 0) ? '-' : ((flag == ' ') ? ' ' : '\0');
+         int pad = width - n - (sign ? 1 : 0);
+
+         if (flag != '-' && flag != '0')
+            for ( ; pad > 0; pad--)
+               out.put(' ');
+         if (sign)
+            out.put(sign);
+         if (flag == '0')
+            for ( ; pad > 0; pad--)
+               out.put('0');
+         while (n)
+            out.put(digits[--n]);
+         for ( ; pad > 0; pad--)
+            out.put(' ');
+      }
+
+         /// sprintf() of one value, with a buffer big enough for the widest
+         /// double the specification can give
+      template <class T>
+      void putFormatted(Output& out, const string& spec, int width,
+                        int precision, T value)
+      {
+         char local[512];
+         size_t need = size_t(width) + size_t(precision > 0 ? precision : 0)
+            + 330;
+         if (need <= sizeof(local))
+         {
+            int n = sprintf(local, spec.c_str(), value);
+            out.put(local, n);
+         }
+         else
+         {
+            vector<char> big(need);
+            int n = sprintf(&big[0], spec.c_str(), value);
+            out.put(&big[0], n);
+         }
+      }
+   }
+
+   DayTimeFormat::DayTimeFormat(const char* fmt)
+      throw()
+         : format(fmt)
+   {
+      compile();
+   }
+
+   DayTimeFormat::DayTimeFormat(const std::string& fmt)
+      throw()
+         : format(fmt)
+   {
+      compile();
+   }
+
+   void DayTimeFormat::compile()
+      throw()
+   {
+      tokens.clear();
+      needDate = needTime = false;
+
+      Token literal;
+      literal.conv = literal.flag = '\0';
+      literal.width = 0;
+      literal.precision = -1;
+
+      string::size_type i = 0;
+      while (i < format.length())
+      {
+         if (format[i] != '%')
+         {
+            literal.text += format[i++];
+            continue;
+         }
+
+            // %[ 0-]?[[:digit:]]*(\.[[:digit:]]+)?X, as DayTime::printf()
+            // has always matched them
+         string::size_type j = i + 1;
+         Token field;
+         field.flag = '\0';
+         field.width = 0;
+         field.precision = -1;
+
+         if (j < format.length() && format[j] && strchr(" 0-", format[j]))
+            field.flag = format[j++];
+         while (j < format.length() && isdigit(format[j]))
+            field.width = field.width * 10 + (format[j++] - '0');
+         if (j + 1 < format.length() && format[j] == '.' &&
+             isdigit(format[j+1]))
+         {
+            field.precision = 0;
+            for (j++; j < format.length() && isdigit(format[j]); j++)
+               field.precision = field.precision * 10 + (format[j] - '0');
+         }
+
+         char c = (j < format.length()) ? format[j] : '\0';
+         if (c == '\0' || !strchr(CONVERSIONS, c) ||
+             (field.precision >= 0 && !strchr(FLOAT_CONVERSIONS, c)))
+         {
+               // not a conversion, so the % is just text
+            literal.text += format[i++];
+            continue;
+         }
+
+         if (!literal.text.empty())
+         {
+            tokens.push_back(literal);
+            literal.text.erase();
+         }
+
+         field.conv = c;
+         if (strchr("fgsQbBaA", c))
+         {
+               // formatted by sprintf(), with the conversion that
+               // DayTime::printf() substituted
+            field.text = format.substr(i, j - i);
+            if (c == 'Q')
+               field.text += "Lf";
+            else if (strchr(FLOAT_CONVERSIONS, c))
+               field.text += "f";
+            else
+               field.text += "s";
+         }
+         tokens.push_back(field);
+
+         if (strchr("YymbBd", c))
+            needDate = true;
+         if (strchr("SfHM", c))
+            needTime = true;
+
+         i = j + 1;
+      }
+
+      if (!literal.text.empty())
+         tokens.push_back(literal);
+   }
+
+   std::size_t DayTimeFormat::print(const DayTime& t,
+                                    char* buf,
+                                    std::size_t size) const
+      throw(gpstk::StringUtils::StringException)
+   {
+      Output out(buf, size);
+
+      try
+      {
+            // The calendar date and time of day are worked out once
+         int year = 0, month = 0, day = 0, hour = 0, minute = 0;
+         double second = 0.0;
+         if (needDate)
+            t.getYMD(year, month, day);
+         if (needTime)
+            DayTime::convertSODtoTime(t.secOfDay(), hour, minute, second);
+
+         for (vector<Token>::const_iterator i = tokens.begin();
+              i != tokens.end(); i++)
+         {
+            const Token& k = *i;
+            switch (k.conv)
+            {
+               case '\0':
+                  out.put(k.text.data(), k.text.length());
+                  break;
+               case 'S':
+                  putInt(out, short(second), k.flag, k.width);
+                  break;
+               case 'f':
+                  putFormatted(out, k.text, k.width, k.precision, second);
+                  break;
+               case 'G':
+                  putInt(out, t.GPS10bitweek(), k.flag, k.width);
+                  break;
+               case 'F':
+                  putInt(out, t.GPSfullweek(), k.flag, k.width);
+                  break;
+               case 'g':
+                  putFormatted(out, k.text, k.width, k.precision, t.GPSsow());
+                  break;
+               case 's':
+                  putFormatted(out, k.text, k.width, k.precision,
+                               t.DOYsecond());
+                  break;
+               case 'Q':
+                  putFormatted(out, k.text, k.width, k.precision,
+                               t.getMJDasLongDouble());
+                  break;
+               case 'Y':
+                  putInt(out, short(year), k.flag, k.width);
+                  break;
+               case 'y':
+                  putInt(out, short(year % 100), k.flag, k.width);
+                  break;
+               case 'm':
+                  putInt(out, month, k.flag, k.width);
+                  break;
+               case 'b':
+                  putFormatted(out, k.text, k.width, k.precision,
+                               MonthAbbrevNames[month]);
+                  break;
+               case 'B':
+                  putFormatted(out, k.text, k.width, k.precision,
+                               MonthNames[month]);
+                  break;
+               case 'd':
+                  putInt(out, day, k.flag, k.width);
+                  break;
+               case 'H':
+                  putInt(out, hour, k.flag, k.width);
+                  break;
+               case 'M':
+                  putInt(out, minute, k.flag, k.width);
+                  break;
+               case 'w':
+                  putInt(out, t.dayOfWeek(), k.flag, k.width);
+                  break;
+               case 'a':
+                  putFormatted(out, k.text, k.width, k.precision,
+                               DayOfWeekAbbrevNames[t.dayOfWeek()]);
+                  break;
+               case 'A':
+                  putFormatted(out, k.text, k.width, k.precision,
+                               DayOfWeekNames[t.dayOfWeek()]);
+                  break;
+               case 'z':
+                  putInt(out, int(t.GPSzcountFloor()), k.flag, k.width);
+                  break;
+               case 'Z':
+                  putInt(out, int(t.GPSzcount()), k.flag, k.width);
+                  break;
+               case 'U':
+                  putInt(out, int(t.unixTime().tv_sec), k.flag, k.width);
+                  break;
+               case 'u':
+                  putInt(out, int(t.unixTime().tv_usec), k.flag, k.width);
+                  break;
+               case 'j':
+                  putInt(out, t.DOY(), k.flag, k.width);
+                  break;
+               case 'C':
+                  putInt(out, int(t.fullZcount()), k.flag, k.width);
+                  break;
+               case 'c':
+                  putInt(out, int(t.fullZcountFloor()), k.flag, k.width);
+                  break;
+            }
+         }
+      }
+      catch(DayTime::DayTimeException& e)
+      {
+         gpstk::StringUtils::StringException se(e);
+         se.addText("Cannot format time");
+         GPSTK_THROW(se);
+      }
+
+      return out.finish();
+   }
+
+   std::string DayTimeFormat::print(const DayTime& t) const
+      throw(gpstk::StringUtils::StringException)
+   {
+      char buf[128];
+      size_t n = print(t, buf, sizeof(buf));
+      if (n < sizeof(buf))
+         return string(buf, n);
+
+      vector<char> big(n + 1);
+      print(t, &big[0], big.size());
+      return string(&big[0], n);
+   }
+
+   DayTime DayTimeFormat::scan(const char* str,
+                               std::size_t len,
+                               int yearBase) const
+      throw(DayTime::DayTimeException)
+   {
+      using gpstk::StringUtils::asInt;
+      using gpstk::StringUtils::asDouble;
+
+      int year = 0, month = 1, day = 1, doy = 0, hour = 0, minute = 0;
+      double sec = 0.0;
+      bool twoDigitYear = false, haveDoy = false;
+
+      size_t pos = 0;
+      for (vector<Token>::const_iterator i = tokens.begin();
+           i != tokens.end(); i++)
+      {
+         const Token& k = *i;
+         if (k.conv == '\0')
+         {
+            pos += k.text.length();
+            continue;
+         }
+
+         if (k.width == 0 || !strchr("YymdjHMSf", k.conv))
+         {
+            DayTime::DayTimeException dte("Can't read %" + string(1, k.conv)
+                                          + " with format " + format);
+            GPSTK_THROW(dte);
+         }
+
+         const char* p = str + pos;
+         size_t n = (pos >= len) ? 0 : min(size_t(k.width), len - pos);
+         pos += k.width;
+
+         switch (k.conv)
+         {
+            case 'Y': year = asInt(p, n);  twoDigitYear = false;  break;
+            case 'y': year = asInt(p, n);  twoDigitYear = true;   break;
+            case 'm': month = asInt(p, n);                        break;
+            case 'd': day = asInt(p, n);                          break;
+            case 'j': doy = asInt(p, n);   haveDoy = true;        break;
+            case 'H': hour = asInt(p, n);                         break;
+            case 'M': minute = asInt(p, n);                       break;
+            case 'S': sec = asInt(p, n);                          break;
+            case 'f': sec = asDouble(p, n);                       break;
+         }
+      }
+
+      if (twoDigitYear)
+         year = yearBase + ((year - yearBase) % 100 + 100) % 100;
+
+         // 60 seconds or more doesn't make a valid time of day
+      double ds = 0.0;
+      if (sec >= 60.0)
+      {
+         ds = sec;
+         sec = 0.0;
+      }
+
+         // Copying a time is much cheaper than the default constructor,
+         // which reads the system clock
+      DayTime t(DayTime::BEGINNING_OF_TIME);
+      t.setTolerance(DayTime::getDayTimeTolerance());
+      if (haveDoy)
+         t.setYDoySod(year, doy, DayTime::convertTimeToSOD(hour, minute, sec));
+      else
+         t.setYMDHMS(year, month, day, hour, minute, sec);
+      if (ds != 0.0)
+         t += ds;
+
+      return t;
+   }
+
+} // namespace gpstk
@@ -0,0 +1,186 @@
+#pragma ident "$Id$"
+
+
+
+#ifndef GPSTK_DAYTIMEFORMAT_HPP
+#define GPSTK_DAYTIMEFORMAT_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file DayTimeFormat.hpp
+ * gpstk::DayTimeFormat - a DayTime::printf() format, compiled once
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "DayTime.hpp"
+
+namespace gpstk
+{
+      /** @addtogroup timegroup */
+      //@{
+
+      /**
+       * A format of DayTime::printf(), taken apart once so that it can be
+       * used on many times.
+       *
+       * DayTime::printf() looks for each of its conversions in turn with a
+       * regular expression and computes the calendar date again for each
+       * one it finds.  A DayTimeFormat splits the format into literal text
+       * and conversions when it is constructed; print() then computes the
+       * date and time of day once and writes every field in one pass,
+       * straight into a caller's buffer if wanted.  The output is the same
+       * as DayTime::printf(), which now uses this class.
+       *
+       * A conversion is a '%', at most one of the flags ' ', '0' and '-',
+       * an optional width, a precision for the floating point conversions
+       * (f, g, s and Q) only, and one of the conversion characters listed
+       * at DayTime::printf().  Anything else is copied as it is.
+       *
+       * The same format can read times from fixed column text, such as the
+       * epochs of RINEX and SP3 records, with scan().
+       *
+       * \code
+       * static const DayTimeFormat epoch(" %02y %2m %2d %2H %2M%11.7f");
+       * char buf[32];
+       * epoch.print(t, buf, sizeof(buf));
+       * DayTime t2 = epoch.scan(buf, strlen(buf), 2000);
+       * \endcode
+       */
+   class DayTimeFormat
+   {
+   public:
+         /// Compile a format.
+      DayTimeFormat(const char* fmt)
+         throw();
+
+         /// Compile a format.
+      DayTimeFormat(const std::string& fmt)
+         throw();
+
+         /// The format this was made from.
+      const std::string& getFormat() const
+         throw()
+      { return format; }
+
+         /**
+          * Format a time into a buffer, as snprintf() does.
+          * @param t the time to format.
+          * @param buf where to put the result, always terminated with a
+          *   null character if \a size is not 0.
+          * @param size the size of \a buf.
+          * @return the length of the whole formatted time; if this is
+          *   \a size or more the result was cut short.
+          */
+      std::size_t print(const DayTime& t,
+                        char* buf,
+                        std::size_t size) const
+         throw(gpstk::StringUtils::StringException);
+
+         /// Format a time into a string.
+      std::string print(const DayTime& t) const
+         throw(gpstk::StringUtils::StringException);
+
+         /**
+          * Read a time from text laid out by this format.  Each conversion
+          * takes exactly its width in characters, and each literal
+          * character skips one character without looking at it (check
+          * separators before calling this if they matter).  Characters
+          * beyond \a len read as blanks, and blank fields as zero.
+          *
+          * The conversions Y, y, m, d, j, H, M, S and f may be used, each
+          * with a width; fields that aren't in the format are 0, except
+          * month and day which are 1.  Seconds of 60 or more (leap
+          * seconds, or a rollover written as 60.0) are added after the rest
+          * of the time is set.
+          *
+          * @param str the text.
+          * @param len the number of characters in \a str.
+          * @param yearBase a two digit year (y) is the year from yearBase
+          *   to yearBase+99 that ends in those digits.  For instance, with
+          *   1980 the years 80 to 99 are 1980 to 1999, and 00 to 79 are
+          *   2000 to 2079; with 2000 they are all in 2000 to 2099.
+          * @return the time, with the default tolerance.
+          * @throw DayTime::DayTimeException if the format has a conversion
+          *   that can't be read or that has no width, or if the time is
+          *   not valid.
+          */
+      DayTime scan(const char* str,
+                   std::size_t len,
+                   int yearBase = 1980) const
+         throw(DayTime::DayTimeException);
+
+         /// Read a time from a string. @see scan(const char*,size_t,int)
+      DayTime scan(const std::string& str,
+                   int yearBase = 1980) const
+         throw(DayTime::DayTimeException)
+      { return scan(str.data(), str.length(), yearBase); }
+
+         /// @name Names used by the b, B, a and A conversions
+         //@{
+         /// Month names, from index 1 (index 0 is an error marker)
+      static const char * const MonthNames[13];
+      static const char * const MonthAbbrevNames[13];
+         /// Day of week names, Sunday first
+      static const char * const DayOfWeekNames[7];
+      static const char * const DayOfWeekAbbrevNames[7];
+         //@}
+
+   private:
+         /// One piece of a format: literal text, or a conversion
+      struct Token
+      {
+            /// Conversion character, or 0 for literal text
+         char conv;
+            /// Flag character (' ', '0' or '-'), or 0 for none
+         char flag;
+            /// Field width, 0 for none
+         int width;
+            /// Precision, -1 for none
+         int precision;
+            /// Literal text, or the printf() specification of a
+            /// conversion that is formatted by sprintf()
+         std::string text;
+      };
+
+         /// Split the format into tokens.
+      void compile()
+         throw();
+
+      std::string format;
+      std::vector<Token> tokens;
+
+         /// True if the calendar date or the time of day is printed
+      bool needDate;
+      bool needTime;
+
+   }; // end class DayTimeFormat
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_DAYTIMEFORMAT_HPP
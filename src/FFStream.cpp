@@ -63,6 +63,9 @@ namespace gpstk
 #endif
       filename = std::string(fn);
       recordNumber = 0;
+      readStatus = readOK;
+      badRecords = 0;
+      skippingBad = false;
       clear();
 
    }  // End of method 'FFStream::open()'
@@ -101,6 +104,44 @@ namespace gpstk
       throw(FFStreamError, gpstk::StringUtils::StringException)
    {
 
+      if (forwardOnly)
+      {
+            // Skip malformed records. A record is counted once, however
+            // many of its lines are tried before a good record is found.
+            // Finding where the stream is costs a readPosition(), but only
+            // after a bad read; it makes sure every read skipped moves the
+            // stream on.
+         std::streampos lastBad(-1);
+         while (true)
+         {
+            forwardFFStreamGet(rec);
+            if (readStatus != readBadRecord)
+            {
+               skippingBad = false;
+               return;
+            }
+
+               // The bad record counts as read: the next read starts
+               // where this one stopped
+            if (!skippingBad)
+            {
+               recordNumber++;
+               badRecords++;
+               skippingBad = true;
+            }
+
+            clear();
+            std::streampos pos = readPosition();
+            if ( (pos == std::streampos(-1)) || (pos == lastBad) )
+            {
+                  // Can't tell, or nothing was read: stop here
+               setstate(std::ios::failbit);
+               return;
+            }
+            lastBad = pos;
+         }
+      }
+
          // Mark where we start in case there is an error.
       long initialPosition = tellg();
       unsigned long initialRecordNumber = recordNumber;
@@ -112,6 +153,7 @@ namespace gpstk
          {
             rec.reallyGetRecord(*this);
             recordNumber++;
+            readStatus = readOK;
          }
          catch (std::exception &e)
          {
@@ -121,6 +163,8 @@ namespace gpstk
                   gpstk::StringUtils::asString(recordNumber));
             mostRecentException.addText("In file " + filename);
             mostRecentException.addLocation(FILE_LOCATION);
+            readStatus = readBadRecord;
+            badRecords++;
             clear();
             seekg(initialPosition);
             recordNumber = initialRecordNumber;
@@ -136,6 +180,7 @@ namespace gpstk
             e.addText("In file " + filename);
             e.addLocation(FILE_LOCATION);
             mostRecentException = e;
+            readStatus = readEOF;
          }
          catch (gpstk::StringUtils::StringException& e)
          {
@@ -144,6 +189,8 @@ namespace gpstk
             e.addText("In file " + filename);
             e.addLocation(FILE_LOCATION);
             mostRecentException = e;
+            readStatus = readBadRecord;
+            badRecords++;
             clear();
             seekg(initialPosition);
             recordNumber = initialRecordNumber;
@@ -158,6 +205,8 @@ namespace gpstk
             e.addText("In file " + filename);
             e.addLocation(FILE_LOCATION);
             mostRecentException = e;
+            readStatus = readBadRecord;
+            badRecords++;
             clear();
             seekg(initialPosition);
             recordNumber = initialRecordNumber;
@@ -209,6 +258,62 @@ namespace gpstk
 
 
 
+      // Reads one record without saving the file position. Errors are
+      // recorded in 'readStatus' and 'mostRecentException', never thrown.
+   void FFStream::forwardFFStreamGet(FFData& rec)
+      throw()
+   {
+
+      clear();
+
+      try
+      {
+         rec.reallyGetRecord(*this);
+         recordNumber++;
+         readStatus = readOK;
+         return;
+      }
+      catch (EndOfFile& e)
+      {
+            // eof already set fail()
+         e.addText("In record " +
+                   gpstk::StringUtils::asString(recordNumber));
+         e.addText("In file " + filename);
+         mostRecentException = e;
+         readStatus = readEOF;
+         return;
+      }
+      catch (gpstk::Exception& e)
+      {
+         e.addText("In record " +
+                   gpstk::StringUtils::asString(recordNumber));
+         e.addText("In file " + filename);
+         e.addLocation(FILE_LOCATION);
+         mostRecentException = e;
+      }
+      catch (std::exception& e)
+      {
+         mostRecentException = FFStreamError("std::exception thrown: " +
+                                             std::string(e.what()));
+         mostRecentException.addText("In record " +
+               gpstk::StringUtils::asString(recordNumber));
+         mostRecentException.addText("In file " + filename);
+         mostRecentException.addLocation(FILE_LOCATION);
+      }
+      catch (...)
+      {
+         mostRecentException = FFStreamError("Unknown exception thrown");
+         mostRecentException.addText("In file " + filename);
+         mostRecentException.addLocation(FILE_LOCATION);
+      }
+
+      readStatus = readBadRecord;
+      setstate(std::ios::failbit);
+
+   }  // End of method 'FFStream::forwardFFStreamGet()'
+
+
+
       // the crazy double try block is so that no gpstk::Exception throws 
       // get masked, allowing all exception information (line numbers, text,
       // etc) to be retained.
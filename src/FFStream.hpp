@@ -118,6 +118,12 @@ namespace gpstk
        *     RinexObsHeader::reallyGetRecord() for more information for files
        *     that read header data.
        *
+       * Reading can also be done in forward-only mode (see
+       * setForwardOnly()), for programs that just go through a file once:
+       * the stream then doesn't keep track of where each record starts,
+       * and reports malformed records with getReadStatus() instead of
+       * throwing.
+       *
        * @warning When using open(), the internal header data of the stream
        * is not guaranteed to be retained.
        */
@@ -125,6 +131,15 @@ namespace gpstk
    {
    public:
 
+         /// Outcome of the last record read.
+      enum ReadStatus
+      {
+         readOK = 0,       ///< The record was read
+         readEOF,          ///< End of file was found
+         readBadRecord     ///< The record was malformed
+      };
+
+
          /// Virtual destructor
       virtual ~FFStream(void) {};
 
@@ -133,7 +148,8 @@ namespace gpstk
           * Default constructor
           */
       FFStream()
-            : recordNumber(0) {};
+            : recordNumber(0), forwardOnly(false), readStatus(readOK),
+              badRecords(0), skippingBad(false) {};
 
 
          /** Common constructor.
@@ -149,7 +165,8 @@ namespace gpstk
 #else
             std::fstream(fn, mode),
 #endif
-            recordNumber(0), filename(fn)
+            recordNumber(0), filename(fn), forwardOnly(false),
+            readStatus(readOK), badRecords(0), skippingBad(false)
       { clear(); }
 
 
@@ -166,7 +183,8 @@ namespace gpstk
 #else
             std::fstream(fn.c_str(), mode),
 #endif
-            recordNumber(0), filename(fn)
+            recordNumber(0), filename(fn), forwardOnly(false),
+            readStatus(readOK), badRecords(0), skippingBad(false)
       { clear(); };
 
 
@@ -191,6 +209,48 @@ namespace gpstk
       void dumpState(std::ostream& s = std::cout) const;
 
 
+         /**
+          * Turns forward-only reading on or off. It is off by default.
+          *
+          * Normally every record read first saves the file position, so
+          * that a malformed record can put the stream back where the
+          * record started, and then throws if exceptions() asks for it.
+          * In forward-only mode nothing is saved and nothing is thrown: a
+          * malformed record is skipped and counted once (see
+          * getBadRecords()), its error is kept in mostRecentException, and
+          * reading goes on from where its parse stopped, so a loop such as
+          * while (strm >> rec) carries on to the end of the file. If the
+          * stream can't tell its position (a pipe, for instance), or a
+          * malformed record didn't move it on, failbit is set instead,
+          * getReadStatus() returns readBadRecord, and clear() lets reading
+          * go on.
+          *
+          * Turning this mode on also turns off the exceptions of the
+          * stream, as they would be thrown when failbit is set.
+          */
+      FFStream& setForwardOnly(bool fwd = true)
+      {
+         forwardOnly = fwd;
+         if (fwd) exceptions(std::ios::goodbit);
+         return (*this);
+      };
+
+
+         /// Whether forward-only reading is on.
+      bool isForwardOnly() const
+      { return forwardOnly; };
+
+
+         /// Outcome of the last record read.
+      ReadStatus getReadStatus() const
+      { return readStatus; };
+
+
+         /// Number of malformed records found since the file was opened.
+      unsigned long getBadRecords() const
+      { return badRecords; };
+
+
          /**
           * Throws \a mostRecentException only if the stream is enabled
           * to throw exceptions when failbit is set.
@@ -234,12 +294,42 @@ namespace gpstk
    protected:
 
 
+         /// Whether records are read without saving the file position
+      bool forwardOnly;
+
+
+         /// Outcome of the last record read
+      ReadStatus readStatus;
+
+
+         /// Number of malformed records found
+      unsigned long badRecords;
+
+
+         /// Whether the reads since the last good record have failed, so
+         /// that a malformed record is counted only once
+      bool skippingBad;
+
+
          /// Encapsulates shared try/catch blocks for all file types
          /// to hide std::exception.
       virtual void tryFFStreamGet(FFData& rec)
          throw(FFStreamError, gpstk::StringUtils::StringException);
 
 
+         /// Reads one record for tryFFStreamGet() in forward-only mode;
+         /// never throws.
+      virtual void forwardFFStreamGet(FFData& rec)
+         throw();
+
+
+         /// Where the next record read starts, or std::streampos(-1) if
+         /// that can't be told. Forward-only mode uses it to make sure a
+         /// malformed record moved the stream on.
+      virtual std::streampos readPosition()
+      { return tellg(); };
+
+
          /// Encapsulates shared try/catch blocks for all file types
          /// to hide std::exception.
       virtual void tryFFStreamPut(const FFData& rec)
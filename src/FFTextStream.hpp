@@ -162,6 +162,23 @@ namespace gpstk
        };
 
 
+         /// calls FFStream::forwardFFStreamGet and adds line number
+         /// information; forward-only reads don't throw nor rewind
+      virtual void forwardFFStreamGet(FFData& rec)
+         throw()
+      {
+
+         FFStream::forwardFFStreamGet(rec);
+
+         if (readStatus == readBadRecord)
+         {
+            mostRecentException.addText( std::string("Near file line ") +
+                                 gpstk::StringUtils::asString(lineNumber) );
+         }
+
+      };
+
+
          /// calls FFStream::tryFFStreamPut and adds line number information
       virtual void tryFFStreamPut(const FFData& rec)
          throw(FFStreamError, gpstk::StringUtils::StringException)
@@ -0,0 +1,298 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file GPSEphemerisPack.cpp
+ * Broadcast ephemerides of many satellites held as parallel arrays, so the
+ * IS-GPS-200 orbit and clock model can be evaluated for all of them at once.
+ * The satellites are worked on in blocks of laneBlock. Kepler's equation is
+ * iterated over the whole block, and each satellite is masked out of the
+ * loop once its own step has converged. The trigonometry is done with the
+ * scalar sin(), cos() and atan2().
+ */
+
+#include <cmath>
+
+#include "GPSEphemerisPack.hpp"
+#include "GPSGeoid.hpp"
+#include "icd_200_constants.hpp"
+
+namespace gpstk
+{
+   using namespace std;
+
+   namespace
+   {
+      /// Number of satellites evaluate() works on in one pass; the
+      /// intermediate arrays of one block stay on the stack.
+      const size_t laneBlock = 32;
+   }
+
+
+   //--------------------------------------------------------------------------
+   //--------------------------------------------------------------------------
+   void GPSEphemerisPack::load(const GPSEphemerisStore& store,
+                               const DayTime& t)
+      throw()
+   {
+      clear();
+
+      GPSEphemerisStore::UBEMap::const_iterator prn_i;
+      for (prn_i = store.ube.begin(); prn_i != store.ube.end(); prn_i++)
+      {
+         const EngEphemeris* eph = (store.method == 0)
+            ? store.searchUser(prn_i->second, t)
+            : store.searchNear(prn_i->second, t);
+         if (eph == NULL)
+            continue;
+
+         try
+         {
+            addEphemeris(*eph);
+         }
+         catch(InvalidRequest&)
+         {
+            // incomplete ephemeris; svXvt() would fail on it too
+         }
+      }
+   } // end of GPSEphemerisPack::load()
+
+
+   //--------------------------------------------------------------------------
+   //--------------------------------------------------------------------------
+   void GPSEphemerisPack::addEphemeris(const EngEphemeris& eph)
+      throw(InvalidRequest)
+   {
+      GPSGeoid geoid;
+
+      try
+      {
+            // Get everything before touching the arrays, so a missing
+            // subframe leaves the pack as it was
+         DayTime toe(eph.getEphemerisEpoch()), toc(eph.getEpochTime());
+         SatID sat(eph.getPRNID(), SatID::systemGPS);
+         double A = eph.getA(), Ahalf = eph.getAhalf();
+         bool igtran = (Ahalf < 2550.0e0);     // ground transmitter
+         double lecc = igtran ? 0.0e0 : eph.getEcc();
+         double mm = (sqrt(geoid.gm()) / (A*Ahalf)) + eph.getDn();
+         double omegaDot = eph.getOmegaDot(), Toe = eph.getToe();
+         double M0 = eph.getM0(), W = eph.getW();
+         double Af0 = eph.getAf0(), Af1 = eph.getAf1(), Af2 = eph.getAf2();
+         double Cuc = eph.getCuc(), Cus = eph.getCus();
+         double Crc = eph.getCrc(), Crs = eph.getCrs();
+         double Cic = eph.getCic(), Cis = eph.getCis();
+         double I0 = eph.getI0(), IDot = eph.getIDot();
+         double Omega0 = eph.getOmega0();
+
+         if (sats.empty())
+            refTime = toe;
+
+         sats.push_back(sat);
+         toeOffset.push_back(refTime - toe);
+         tocOffset.push_back(refTime - toc);
+         af0.push_back(Af0);
+         af1.push_back(Af1);
+         af2.push_back(Af2);
+         m0.push_back(M0);
+         meanRate.push_back(igtran ? 0.0e0 : mm);
+         amm.push_back(mm);
+         a.push_back(A);
+         ahalf.push_back(Ahalf);
+         ecc.push_back(lecc);
+         q.push_back(sqrt(1.0e0 - lecc*lecc));
+         w.push_back(W);
+         cuc.push_back(Cuc);
+         cus.push_back(Cus);
+         crc.push_back(Crc);
+         crs.push_back(Crs);
+         cic.push_back(Cic);
+         cis.push_back(Cis);
+         i0.push_back(I0);
+         idot.push_back(igtran ? 0.0e0 : IDot);
+         omega0.push_back(Omega0);
+         nodeRate.push_back(igtran ? 0.0e0 : omegaDot - geoid.angVelocity());
+         nodeToe.push_back(igtran ? omegaDot * Toe
+                                  : geoid.angVelocity() * Toe);
+         omegaDotEF.push_back(omegaDot - geoid.angVelocity());
+      }
+      catch(InvalidRequest& ir)
+      {
+         GPSTK_RETHROW(ir);
+      }
+   } // end of GPSEphemerisPack::addEphemeris()
+
+
+   //--------------------------------------------------------------------------
+   //--------------------------------------------------------------------------
+   void GPSEphemerisPack::clear()
+      throw()
+   {
+      sats.clear();
+      toeOffset.clear();  tocOffset.clear();
+      af0.clear();  af1.clear();  af2.clear();
+      m0.clear();  meanRate.clear();
+      amm.clear();  a.clear();  ahalf.clear();  ecc.clear();  q.clear();
+      w.clear();  cuc.clear();  cus.clear();  crc.clear();  crs.clear();
+      cic.clear();  cis.clear();
+      i0.clear();  idot.clear();
+      omega0.clear();  nodeRate.clear();  nodeToe.clear();
+      omegaDotEF.clear();
+   } // end of GPSEphemerisPack::clear()
+
+
+   //--------------------------------------------------------------------------
+   // The steps and the order of the operations are those of
+   // EngEphemeris::svXvt(), see there for the details.
+   //--------------------------------------------------------------------------
+   void GPSEphemerisPack::evaluate(const DayTime& t, Xvt* xvt) const
+      throw()
+   {
+      GPSGeoid geoid;
+      const double sqrtgm = sqrt(geoid.gm());
+      const double twoPI = 2.0e0 * PI;
+      const double dt = t - refTime;
+
+      double elapte[laneBlock], elaptc[laneBlock];
+      double meana[laneBlock], ea[laneBlock];
+      bool active[laneBlock];
+
+      for (size_t first = 0; first < sats.size(); first += laneBlock)
+      {
+         const size_t n = min(laneBlock, sats.size() - first);
+
+            // Elapsed times, mean anomaly and the starting guess of the
+            // eccentric anomaly
+         for (size_t k = 0; k < n; k++)
+         {
+            const size_t i = first + k;
+            elapte[k] = dt + toeOffset[i];
+            elaptc[k] = dt + tocOffset[i];
+            meana[k] = fmod(m0[i] + elapte[k] * meanRate[i], twoPI);
+            ea[k] = meana[k] + ecc[i] * sin(meana[k]);
+            active[k] = true;
+         }
+
+            // Kepler's equation: every satellite takes the same Newton
+            // steps as in svXvt() and stops when its own step is small
+         for (int loop_cnt = 1; loop_cnt <= 20; loop_cnt++)
+         {
+            bool more = false;
+            for (size_t k = 0; k < n; k++)
+            {
+               if (!active[k])
+                  continue;
+               const size_t i = first + k;
+               double F = meana[k] - ( ea[k] - ecc[i] * sin(ea[k]));
+               double G = 1.0 - ecc[i] * cos(ea[k]);
+               double delea = F/G;
+               ea[k] = ea[k] + delea;
+               active[k] = (fabs(delea) > 1.0e-11);
+               more = more || active[k];
+            }
+            if (!more)
+               break;
+         }
+
+            // Clock, position and velocity
+         for (size_t k = 0; k < n; k++)
+         {
+            const size_t i = first + k;
+            Xvt& sv = xvt[i];
+
+            sv.ddtime = af1[i] + elaptc[k] * af2[i];
+            double dtc = af0[i] + elaptc[k] * ( sv.ddtime );
+            double sinea = sin(ea[k]);
+            double cosea = cos(ea[k]);
+            double dtr = REL_CONST * ecc[i] * ahalf[i] * sinea;
+            sv.dtime = dtc + dtr;
+
+            double G = 1.0e0 - ecc[i] * cosea;
+            double GSTA  = q[i] * sinea;
+            double GCTA  = cosea - ecc[i];
+            double truea = atan2 ( GSTA, GCTA );
+
+            double alat = truea + w[i];
+            double talat = 2.0e0 * alat;
+            double c2al = cos( talat );
+            double s2al = sin( talat );
+
+            double du  = c2al * cuc[i] +  s2al * cus[i];
+            double dr  = c2al * crc[i] +  s2al * crs[i];
+            double di  = c2al * cic[i] +  s2al * cis[i];
+
+            double U    = alat + du;
+            double R    = a[i]*G  + dr;
+            double AINC = i0[i] + idot[i] * elapte[k]  +  di;
+            double ANLON = omega0[i] + nodeRate[i] * elapte[k] - nodeToe[i];
+
+            double cosu = cos( U );
+            double sinu = sin( U );
+            double xip  = R * cosu;
+            double yip  = R * sinu;
+
+            double can  = cos( ANLON );
+            double san  = sin( ANLON );
+            double cinc = cos( AINC  );
+            double sinc = sin( AINC  );
+
+            sv.x[0] = xip*can  -  yip*cinc*san;
+            sv.x[1] = xip*san  +  yip*cinc*can;
+            sv.x[2] =             yip*sinc;
+
+            double dek = amm[i] * a[i] / R;
+            double dlk = ahalf[i] * q[i] * sqrtgm / (R*R);
+            double div = idot[i] - 2.0e0 * dlk *
+               ( cic[i]  * s2al - cis[i] * c2al );
+            double domk = omegaDotEF[i];
+            double duv = dlk*(1.e0+ 2.e0 * (cus[i]*c2al - cuc[i]*s2al) );
+            double drv = a[i] * ecc[i] * dek * sinea - 2.e0 * dlk *
+               ( crc[i] * s2al - crs[i] * c2al );
+
+            double dxp = drv*cosu - R*sinu*duv;
+            double dyp = drv*sinu + R*cosu*duv;
+
+            sv.v[0] = dxp*can - xip*san*domk - dyp*cinc*san
+               + yip*( sinc*san*div - cinc*can*domk);
+            sv.v[1] = dxp*san + xip*can*domk + dyp*cinc*can
+               - yip*( sinc*can*div + cinc*san*domk);
+            sv.v[2] = dyp*sinc + yip*cinc*div;
+         }
+      }
+   } // end of GPSEphemerisPack::evaluate()
+
+} // namespace gpstk
@@ -0,0 +1,157 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+/**
+ * @file GPSEphemerisPack.hpp
+ * Broadcast ephemerides of many satellites held as parallel arrays, so the
+ * IS-GPS-200 orbit and clock model can be evaluated for all of them at once.
+ */
+
+#ifndef GPSTK_GPSEPHEMERISPACK_HPP
+#define GPSTK_GPSEPHEMERISPACK_HPP
+
+#include <vector>
+
+#include "SatID.hpp"
+#include "DayTime.hpp"
+#include "Xvt.hpp"
+#include "EngEphemeris.hpp"
+#include "GPSEphemerisStore.hpp"
+
+namespace gpstk
+{
+   /** @addtogroup ephemstore */
+   //@{
+
+   /// A snapshot of one broadcast ephemeris per satellite, stored as a
+   /// structure of arrays (one array per orbit parameter). evaluate()
+   /// runs the computation of EngEphemeris::svXvt() for every satellite
+   /// at once, each step as a loop over a block of satellites, with the
+   /// per-ephemeris constants worked out when the pack is built. The
+   /// results agree with svXvt() to well within a micrometer.
+   class GPSEphemerisPack
+   {
+   public:
+
+      /// Constructor; the pack is empty.
+      GPSEphemerisPack()
+         throw()
+      {}
+
+      /// Constructor, see load().
+      GPSEphemerisPack(const GPSEphemerisStore& store, const DayTime& t)
+         throw()
+      { load(store, t); }
+
+      /// Replace the contents of the pack with the ephemeris that
+      /// store.getXvt() would use at time t, for every satellite that
+      /// has one.
+      /// @param store the ephemerides to choose from
+      /// @param t the time of the snapshot
+      void load(const GPSEphemerisStore& store, const DayTime& t)
+         throw();
+
+      /// Add one ephemeris to the pack.
+      /// @param eph the ephemeris to add
+      /// @throw InvalidRequest if eph does not hold subframes 1-3
+      void addEphemeris(const EngEphemeris& eph)
+         throw(InvalidRequest);
+
+      /// Remove all ephemerides.
+      void clear()
+         throw();
+
+      /// Get the number of satellites in the pack.
+      size_t size() const
+         throw()
+      { return sats.size(); }
+
+      /// Get the satellites in the pack, in the order used by evaluate().
+      const std::vector<SatID>& getSatIDs() const
+         throw()
+      { return sats; }
+
+      /// Compute the position, velocity and clock correction of every
+      /// satellite in the pack at time t, as EngEphemeris::svXvt() does.
+      /// @param t the time to evaluate the orbits at
+      /// @param xvt array with room for size() results, in the order of
+      ///    getSatIDs()
+      void evaluate(const DayTime& t, Xvt* xvt) const
+         throw();
+
+   private:
+
+      /// The satellites, one per lane of the arrays below.
+      std::vector<SatID> sats;
+
+      /// Time that the epochs below are measured from.
+      DayTime refTime;
+
+      /// Seconds from the ephemeris and clock epochs to refTime
+      std::vector<double> toeOffset, tocOffset;
+
+      /// Clock polynomial
+      std::vector<double> af0, af1, af2;
+
+      /// Mean anomaly at epoch and mean motion applied to it (zero for
+      /// ground transmitters)
+      std::vector<double> m0, meanRate;
+
+      /// Mean motion, semi-major axis and its square root, eccentricity
+      /// and sqrt(1-e^2)
+      std::vector<double> amm, a, ahalf, ecc, q;
+
+      /// Argument of perigee and harmonic corrections
+      std::vector<double> w, cuc, cus, crc, crs, cic, cis;
+
+      /// Inclination at epoch and its rate
+      std::vector<double> i0, idot;
+
+      /// Ascending node: omega0 + nodeRate*elapte - nodeToe
+      std::vector<double> omega0, nodeRate, nodeToe;
+
+      /// Rate of the node in the Earth-fixed frame, for velocities
+      std::vector<double> omegaDotEF;
+
+   }; // end class GPSEphemerisPack
+
+   //@}
+
+} // namespace gpstk
+
+#endif  // GPSTK_GPSEPHEMERISPACK_HPP
@@ -71,6 +71,52 @@ namespace gpstk
    } // end of GPSEphemerisStore::getXvt()
 
 
+   //--------------------------------------------------------------------------
+   //--------------------------------------------------------------------------
+   size_t GPSEphemerisStore::getXvtBatch(const SatID* ids,
+                                         const DayTime* times,
+                                         size_t n,
+                                         Xvt* xvt,
+                                         bool* valid)
+      const throw()
+   {
+      size_t good = 0;
+      const EngEphMap* em = NULL;
+
+      for (size_t i = 0; i < n; i++)
+      {
+         valid[i] = false;
+
+         // consecutive requests for one satellite share the map lookup
+         if (i == 0 || ids[i].id != ids[i-1].id)
+         {
+            UBEMap::const_iterator prn_i = ube.find(ids[i].id);
+            em = (prn_i == ube.end()) ? NULL : &prn_i->second;
+         }
+         if (em == NULL)
+            continue;
+
+         const EngEphemeris* eph = (method == 0) ? searchUser(*em, times[i])
+                                                 : searchNear(*em, times[i]);
+         if (eph == NULL)
+            continue;
+
+         try
+         {
+            xvt[i] = eph->svXvt(times[i]);
+            valid[i] = true;
+            good++;
+         }
+         catch(InvalidRequest&)
+         {
+            // incomplete ephemeris; leave this one invalid
+         }
+      }
+
+      return good;
+   } // end of GPSEphemerisStore::getXvtBatch()
+
+
    //--------------------------------------------------------------------------
    //--------------------------------------------------------------------------
    const EngEphemeris&
@@ -249,7 +295,6 @@ namespace gpstk
    GPSEphemerisStore::findUserEphemeris(const SatID sat, const DayTime& t) 
       const throw(InvalidRequest)
    {
-      DayTime test;
       UBEMap::const_iterator prn_i = ube.find(sat.id);
       if (prn_i == ube.end())
       {
@@ -257,8 +302,27 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      const EngEphMap& em = prn_i->second;
-      DayTime t1(0.0L), t2(0.0L), Tot = DayTime::BEGINNING_OF_TIME;
+      const EngEphemeris* eph = searchUser(prn_i->second, t);
+      if (eph == NULL)
+      {
+         string mess = "No eph found for satellite "
+            + asString(sat) + " at " + t.printf("%03j %02H:%02M:%02S");
+         InvalidRequest e(mess);
+         GPSTK_THROW(e);
+      }
+
+      return *eph;
+   } // end of GPSEphemerisStore::findEphemeris()
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+   const EngEphemeris*
+   GPSEphemerisStore::searchUser(const EngEphMap& em, const DayTime& t) 
+      const throw()
+   {
+      DayTime t2(0.0L), Tot = DayTime::BEGINNING_OF_TIME;
+      TimeKey key(t);
       EngEphMap::const_iterator it = em.end();
 
       // Find eph with (Toe-(fitint/2)) > t - 4 hours
@@ -266,7 +330,7 @@ namespace gpstk
       // Backup one ephemeris to make sure you get the
       // correct one in case of fit intervals greater 
       // than 4 hours.
-      EngEphMap::const_iterator ei = em.upper_bound(t - 4 * 3600); 
+      EngEphMap::const_iterator ei = em.upper_bound(key - 4 * 3600); 
       if (!em.empty() && ei != em.begin() )
       {
          ei--;
@@ -275,21 +339,19 @@ namespace gpstk
       for (; ei != em.end(); ei++)
       {
          const EngEphemeris& current = ei->second;
-         // t1 = Toe-(fitint / 2)
-         t1 = ei->first;
          // t2 = HOW time
          t2 = current.getTransmitTime();
 
-         // Ephemeredes are ordered by fit interval.  
-         // If the start of the fit interval is in the future, 
-         // this and any more ephemerides are not the one you are
-         // looking for.
-         if( t1 > t ) 
+         // Ephemeredes are ordered by fit interval (the key is
+         // Toe-(fitint / 2)).  If the start of the fit interval is in
+         // the future, this and any more ephemerides are not the one
+         // you are looking for.
+         if( ei->first > key ) 
          {
             break;
          }
          
-         double dt1 = t - t1;
+         double dt1 = key - ei->first;
          double dt2 = t - t2;
 
          if (dt1 >= 0 &&                           // t is after start of fit interval
@@ -302,16 +364,8 @@ namespace gpstk
          }
       }
 
-      if (it == em.end())
-      {
-         string mess = "No eph found for satellite "
-            + asString(sat) + " at " + t.printf("%03j %02H:%02M:%02S");
-         InvalidRequest e(mess);
-         GPSTK_THROW(e);
-      }
-
-      return it->second;
-   } // end of GPSEphemerisStore::findEphemeris()
+      return (it == em.end()) ? NULL : &it->second;
+   } // end of GPSEphemerisStore::searchUser()
 
 
 //-----------------------------------------------------------------------------
@@ -320,7 +374,6 @@ namespace gpstk
    GPSEphemerisStore::findNearEphemeris(const SatID sat, const DayTime& t) 
       const throw(InvalidRequest)
    {
-      DayTime test;
       UBEMap::const_iterator prn_i = ube.find(sat.id);
       if (prn_i == ube.end())
       {
@@ -328,9 +381,28 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
-      const EngEphMap& em = prn_i->second;
+      const EngEphemeris* eph = searchNear(prn_i->second, t);
+      if (eph == NULL)
+      {
+         string mess = "No eph found for satellite "
+            + asString(sat) + " at " + t.printf("%03j %02H:%02M:%02S");
+         InvalidRequest e(mess);
+         GPSTK_THROW(e);
+      }
+
+      return *eph;
+   } // end of GPSEphemerisStore::findNearEphemeris()
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+   const EngEphemeris*
+   GPSEphemerisStore::searchNear(const EngEphMap& em, const DayTime& t) 
+      const throw()
+   {
       double dt2min = -1;
-      DayTime tstart, how;
+      DayTime how;
+      TimeKey key(t);
       EngEphMap::const_iterator it = em.end();
 
       // Find eph with (Toe-(fitint/2)) > t - 4 hours
@@ -338,7 +410,7 @@ namespace gpstk
       // Backup one ephemeris to make sure you get the
       // correct one in case of fit intervals greater 
       // than 4 hours.
-      EngEphMap::const_iterator ei = em.upper_bound(t - 4 * 3600); 
+      EngEphMap::const_iterator ei = em.upper_bound(key - 4 * 3600); 
       if (!em.empty() && ei != em.begin() )
       {
          ei--;
@@ -347,18 +419,16 @@ namespace gpstk
       for (; ei != em.end(); ei++)
       {
          const EngEphemeris& current = ei->second;
-         // tstart = Toe-(fitint / 2)
-         tstart = ei->first;
          // how = HOW time
          how = current.getTransmitTime();
 
-         // Ephemerides are ordered by time of start of fit interval.  
-         // If the start of the fit interval is in the future, 
-         // this and any more ephemerides are not the one you are
-         // looking for.
-         if( tstart > t ) break;
+         // Ephemerides are ordered by time of start of fit interval
+         // (the key is Toe-(fitint / 2)).  If the start of the fit
+         // interval is in the future, this and any more ephemerides
+         // are not the one you are looking for.
+         if( ei->first > key ) break;
          
-         double dt1 = t - tstart;
+         double dt1 = key - ei->first;
          double dt2 = t - how;
 
          if (dt1 >= 0 &&                           // t is after start of fit interval
@@ -370,16 +440,8 @@ namespace gpstk
          }
       }
 
-      if (it == em.end())
-      {
-         string mess = "No eph found for satellite "
-            + asString(sat) + " at " + t.printf("%03j %02H:%02M:%02S");
-         InvalidRequest e(mess);
-         GPSTK_THROW(e);
-      }
-
-      return it->second;
-   } // end of GPSEphemerisStore::findNearEphemeris()
+      return (it == em.end()) ? NULL : &it->second;
+   } // end of GPSEphemerisStore::searchNear()
 
 
 //-----------------------------------------------------------------------------
@@ -404,7 +466,7 @@ namespace gpstk
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //   const EngEphMap 
-   const std::map<DayTime, EngEphemeris>& 
+   const GPSEphemerisStore::EngEphMap& 
    GPSEphemerisStore::getEphMap( const SatID sat )
             const throw(InvalidRequest)
    {
@@ -53,6 +53,7 @@
 #include "XvtStore.hpp"
 #include "SatID.hpp"
 #include "EngEphemeris.hpp"
+#include "TimeKey.hpp"
 #include "icd_200_constants.hpp"
 
 namespace gpstk
@@ -89,6 +90,21 @@ namespace gpstk
       ///    information as to why the request failed.
       Xvt getXvt(const SatID sat, const DayTime& t)
          const throw(InvalidRequest);
+
+
+      /// Compute the Xvt of many satellites at once, using the search
+      /// method configured by SearchNear/SearchPast. Requests for which
+      /// getXvt() would throw leave their valid[] entry false instead.
+      /// Consecutive requests for the same satellite share one lookup.
+      /// @param[in] ids the SVs' SatIDs (n of them)
+      /// @param[in] times the times to look up (n of them)
+      /// @param[in] n the number of requests
+      /// @param[out] xvt the Xvt results (room for n)
+      /// @param[out] valid the validity mask (room for n)
+      /// @return the number of valid results
+      size_t getXvtBatch(const SatID* ids, const DayTime* times, size_t n,
+                         Xvt* xvt, bool* valid)
+         const throw();
       
 
       /// A debugging function that outputs in human readable form,
@@ -232,8 +248,9 @@ namespace gpstk
       {method = 0;}
 
       /// This is intended to just store sets of unique EngEphemerides
-      /// for a single SV.  The key is the Toe - 1/2 the fit interval.
-      typedef std::map<DayTime, EngEphemeris> EngEphMap;
+      /// for a single SV.  The key is the Toe - 1/2 the fit interval,
+      /// as a TimeKey so that lookups are integer comparisons.
+      typedef std::map<TimeKey, EngEphemeris> EngEphMap;
       
       /// Returns a map of the ephemerides available for the specified
       /// satellite.  Note that the return is specifically chosen as a 
@@ -243,6 +260,9 @@ namespace gpstk
                const throw(InvalidRequest);
 
    private:
+
+      /// Builds its snapshots straight from the map below
+      friend class GPSEphemerisPack;
       
       /// This is intended to hold all unique EngEphemerides for each SV
       /// The key is the prn of the SV.
@@ -250,6 +270,16 @@ namespace gpstk
       
       /// The map where all EngEphemerides are stored.
       UBEMap ube;
+
+      /// The search of findUserEphemeris() over one SV's map.
+      /// @return the ephemeris found, NULL if there is none
+      const EngEphemeris* searchUser(const EngEphMap& em, const DayTime& t)
+         const throw();
+
+      /// The search of findNearEphemeris() over one SV's map.
+      /// @return the ephemeris found, NULL if there is none
+      const EngEphemeris* searchNear(const EngEphMap& em, const DayTime& t)
+         const throw();
       
       DayTime initialTime; //< Time of the first EngEphemeris
       DayTime finalTime;   //< Time of the last EngEphemeris
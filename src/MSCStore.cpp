@@ -148,6 +148,7 @@ namespace gpstk
    {
       
          // For each station....      
+      const TimeKey kmin(tmin), kmax(tmax);
       MMi mmi;
       for(mmi = mscMap.begin(); mmi != mscMap.end(); mmi++)
       {
@@ -156,7 +157,7 @@ namespace gpstk
          StaMSCMap& smmr = mmi->second;
          StaMSCMap::reverse_iterator smmir;
          smmir = smmr.rbegin();
-         if (smmir->first > tmax) 
+         if (smmir->first > kmax) 
          {
             smmr.clear();   
          }
@@ -164,14 +165,10 @@ namespace gpstk
             // one entry that needs to be retained.
          else 
          {
-            SMMi smmi = smmr.begin();
-            SMMi lastTooEarly = smmi;// Just initialize to a valid value 
-            while (smmi != smmr.end() && smmi->first < tmin)
-            {
-               lastTooEarly = smmi;
-               ++smmi;
-            }
-            if (smmi != smmr.begin()) smmr.erase( smmr.begin(), lastTooEarly );
+            // Keep the last object effective before tmin, as it is
+            // still in effect at tmin
+            SMMi smmi = smmr.lower_bound(kmin);
+            if (smmi != smmr.begin()) smmr.erase( smmr.begin(), --smmi );
          }
       }
       initialTime = tmin;
@@ -281,13 +278,14 @@ namespace gpstk
             // the earliest time that the MSCData object is applicable.  There
             // is no corresponding end time.  Therefore, we'll start at the 
             // END of the time-ordered list and select the first object
-            // with a key <= the time of interest.  
+            // with a key <= the time of interest, i.e. the one before
+            // the first key > t.
             //
-         StaMSCMap::const_reverse_iterator smmir;
-         for (smmir = mm->second.rbegin(); smmir != mm->second.rend(); ++smmir)
+         SMMci smmi = mm->second.upper_bound( TimeKey(t) );
+         if (smmi != mm->second.begin())
          {
-            const DayTime& dtr = smmir->first;
-            if (dtr<=t) return( smmir->second );
+            --smmi;
+            return( smmi->second );
          }
 
             // If we reach this point, there's no time-approprate entry for 
@@ -56,6 +56,7 @@
 #include "MSCData.hpp"
 #include "MSCStream.hpp"
 #include "MSCHeader.hpp"
+#include "TimeKey.hpp"
 
 namespace gpstk
 {
@@ -194,8 +195,8 @@ namespace gpstk
          
    private:
       /// StaMSCMap is a list of MSCData objects for a particular station
-      /// in order of their effective epoch
-      typedef std::map<gpstk::DayTime, MSCData> StaMSCMap;
+      /// in order of their effective epoch (as a TimeKey)
+      typedef std::map<gpstk::TimeKey, MSCData> StaMSCMap;
       typedef StaMSCMap::const_iterator SMMci;
       typedef StaMSCMap::iterator SMMi;
       
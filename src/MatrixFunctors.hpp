@@ -31,6 +31,7 @@
 //============================================================================
 
 #include <cmath>
+#include "MatrixKernels.hpp"
 
 namespace gpstk
 {
@@ -427,6 +428,7 @@ namespace gpstk
             LU = m;
             Pivot = Vector<int>(N);
             parity = 1;
+            if(blockedLUDecomp(LU, Pivot, parity)) return;
 
             for(i=0; i<N; i++) {    // get scale of each row
                big = T(0);
@@ -659,6 +661,11 @@ namespace gpstk
                GPSTK_THROW(e);
            }
 
+           if(blockedCholeskyCrout(m, (*this).L)) {
+               (*this).U = transpose((*this).L);
+               return;
+           }
+
            int N = m.rows(), i, j, k;
            double sum;
            (*this).L = Matrix<T>(N,N, 0.0);
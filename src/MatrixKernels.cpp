@@ -0,0 +1,791 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file MatrixKernels.cpp
+ * Cache-blocked kernels for Matrix<double>.
+ */
+
+#include <algorithm>
+#include <vector>
+#include "MathBase.hpp"
+#include "Matrix.hpp"
+#include "MatrixKernels.hpp"
+
+namespace gpstk
+{
+   namespace
+   {
+         // Rows of the left operand kept in cache by blockedMultiply().
+      const size_t ROW_BLOCK = 64;
+
+         // Inner dimension kept in cache by blockedMultiply().
+      const size_t INNER_BLOCK = 128;
+
+         // Rows of the result kept in cache by Matrix * Vector.
+      const size_t VECTOR_BLOCK = 512;
+
+         // Tile size of blockedTranspose().
+      const size_t TILE = 32;
+
+         // Panel width of the factorizations.
+      const size_t PANEL = 32;
+   }
+
+
+   void blockedMultiply( size_t rows, size_t cols, size_t inner,
+                         const double* l, const double* r, double* result )
+      throw()
+   {
+      std::fill(result, result + rows*cols, 0.0);
+
+         // Every element of the result gets its products added in
+         // ascending order of k, as operator* does.
+      for (size_t k0 = 0; k0 < inner; k0 += INNER_BLOCK)
+      {
+         const size_t k1 = std::min(inner, k0 + INNER_BLOCK);
+
+         for (size_t i0 = 0; i0 < rows; i0 += ROW_BLOCK)
+         {
+            const size_t i1 = std::min(rows, i0 + ROW_BLOCK);
+
+            size_t j = 0;
+            for ( ; j + 4 <= cols; j += 4)
+            {
+               const double* b0 = r + j*inner;
+               const double* b1 = b0 + inner;
+               const double* b2 = b1 + inner;
+               const double* b3 = b2 + inner;
+               double* c0 = result + j*rows;
+               double* c1 = c0 + rows;
+               double* c2 = c1 + rows;
+               double* c3 = c2 + rows;
+
+                  // 2 x 4 blocks of the result are kept in registers
+               size_t i = i0;
+               for ( ; i + 2 <= i1; i += 2)
+               {
+                  double s00 = c0[i], s10 = c0[i+1];
+                  double s01 = c1[i], s11 = c1[i+1];
+                  double s02 = c2[i], s12 = c2[i+1];
+                  double s03 = c3[i], s13 = c3[i+1];
+                  const double* a = l + k0*rows + i;
+                  for (size_t k = k0; k < k1; k++, a += rows)
+                  {
+                     const double a0 = a[0], a1 = a[1];
+                     s00 += a0 * b0[k];  s10 += a1 * b0[k];
+                     s01 += a0 * b1[k];  s11 += a1 * b1[k];
+                     s02 += a0 * b2[k];  s12 += a1 * b2[k];
+                     s03 += a0 * b3[k];  s13 += a1 * b3[k];
+                  }
+                  c0[i] = s00;  c0[i+1] = s10;
+                  c1[i] = s01;  c1[i+1] = s11;
+                  c2[i] = s02;  c2[i+1] = s12;
+                  c3[i] = s03;  c3[i+1] = s13;
+               }
+               for ( ; i < i1; i++)
+               {
+                  double s0 = c0[i], s1 = c1[i], s2 = c2[i], s3 = c3[i];
+                  const double* a = l + k0*rows + i;
+                  for (size_t k = k0; k < k1; k++, a += rows)
+                  {
+                     s0 += *a * b0[k];
+                     s1 += *a * b1[k];
+                     s2 += *a * b2[k];
+                     s3 += *a * b3[k];
+                  }
+                  c0[i] = s0;  c1[i] = s1;  c2[i] = s2;  c3[i] = s3;
+               }
+            }
+
+            for ( ; j < cols; j++)
+            {
+               const double* b = r + j*inner;
+               double* c = result + j*rows;
+               for (size_t k = k0; k < k1; k++)
+               {
+                  const double* a = l + k*rows;
+                  const double x = b[k];
+                  for (size_t i = i0; i < i1; i++)
+                     c[i] += a[i] * x;
+               }
+            }
+         }
+      }
+   }  // end blockedMultiply
+
+
+   void blockedMultiply( size_t rows, size_t cols,
+                         const double* m, const double* v, double* result )
+      throw()
+   {
+      std::fill(result, result + rows, 0.0);
+
+      for (size_t i0 = 0; i0 < rows; i0 += VECTOR_BLOCK)
+      {
+         const size_t i1 = std::min(rows, i0 + VECTOR_BLOCK);
+
+         size_t j = 0;
+         for ( ; j + 4 <= cols; j += 4)
+         {
+            const double* a0 = m + j*rows;
+            const double* a1 = a0 + rows;
+            const double* a2 = a1 + rows;
+            const double* a3 = a2 + rows;
+            const double x0 = v[j], x1 = v[j+1], x2 = v[j+2], x3 = v[j+3];
+            for (size_t i = i0; i < i1; i++)
+            {
+               double s = result[i];
+               s += a0[i] * x0;
+               s += a1[i] * x1;
+               s += a2[i] * x2;
+               s += a3[i] * x3;
+               result[i] = s;
+            }
+         }
+         for ( ; j < cols; j++)
+         {
+            const double* a = m + j*rows;
+            const double x = v[j];
+            for (size_t i = i0; i < i1; i++)
+               result[i] += a[i] * x;
+         }
+      }
+   }  // end blockedMultiply
+
+
+   void blockedTranspose( size_t rows, size_t cols,
+                          const double* m, double* result )
+      throw()
+   {
+      for (size_t j0 = 0; j0 < cols; j0 += TILE)
+      {
+         const size_t j1 = std::min(cols, j0 + TILE);
+         for (size_t i0 = 0; i0 < rows; i0 += TILE)
+         {
+            const size_t i1 = std::min(rows, i0 + TILE);
+            for (size_t j = j0; j < j1; j++)
+               for (size_t i = i0; i < i1; i++)
+                  result[j + i*cols] = m[i + j*rows];
+         }
+      }
+   }  // end blockedTranspose
+
+
+   namespace
+   {
+         // c[i] -= a_q[i] * x[q] for q = 0, ..., nk-1 in turn and i in
+         // [from, to), where a_q = a + q*lda. Groups of four columns are
+         // subtracted with the element held in a register.
+      inline void subtractProducts( double* c, const double* a, size_t lda,
+                                    const double* x, size_t nk,
+                                    size_t from, size_t to )
+      {
+         size_t q = 0;
+         for ( ; q + 4 <= nk; q += 4)
+         {
+            const double* a0 = a + q*lda;
+            const double* a1 = a0 + lda;
+            const double* a2 = a1 + lda;
+            const double* a3 = a2 + lda;
+            const double x0 = x[q], x1 = x[q+1], x2 = x[q+2], x3 = x[q+3];
+            for (size_t i = from; i < to; i++)
+            {
+               double s = c[i];
+               s -= a0[i] * x0;
+               s -= a1[i] * x1;
+               s -= a2[i] * x2;
+               s -= a3[i] * x3;
+               c[i] = s;
+            }
+         }
+         for ( ; q < nk; q++)
+         {
+            const double* aq = a + q*lda;
+            const double xq = x[q];
+            for (size_t i = from; i < to; i++)
+               c[i] -= aq[i] * xq;
+         }
+      }
+
+         // Cholesky: subtract L(i,k)*L(j,k), k in [k0,k1), from column j.
+      inline void choleskyUpdate( size_t n, double* L, size_t j,
+                                  size_t k0, size_t k1 )
+      {
+         double x[PANEL];
+         for (size_t k = k0; k < k1; k += PANEL)
+         {
+            const size_t nk = std::min(PANEL, k1 - k);
+            for (size_t q = 0; q < nk; q++)
+               x[q] = L[j + (k+q)*n];
+            subtractProducts(L + j*n, L + k*n, n, x, nk, j, n);
+         }
+      }
+
+         // LU: subtract LU(i,k)*LU(k,j) from the elements i > k of column
+         // j, for k in [k0,k1) in turn. LU(k,j) itself is only final
+         // after the steps before k, so the rows inside [k0,k1) are done
+         // one step at a time and the rest in groups.
+      inline void luUpdate( size_t n, double* lu, size_t j,
+                            size_t k0, size_t k1 )
+      {
+         double* lj = lu + j*n;
+         double x[PANEL];
+         for (size_t k = k0; k < k1; k += PANEL)
+         {
+            const size_t nk = std::min(PANEL, k1 - k);
+            for (size_t q = 0; q < nk; q++)
+            {
+               x[q] = lj[k+q];
+               const double* lk = lu + (k+q)*n;
+               for (size_t i = k+q+1; i < k+nk; i++)
+                  lj[i] -= lk[i] * x[q];
+            }
+            subtractProducts(lj, lu + k*n, n, x, nk, k+nk, n);
+         }
+      }
+
+         // One right hand side of luBackSub().
+      void luBackSub1( size_t n, const double* luT, const int* pivot,
+                       double* v )
+      {
+            // un-pivot
+         bool first = true;
+         size_t ii = 0;
+         for (size_t i = 0; i < n; i++)
+         {
+            const double* row = luT + i*n;
+            double sum = v[pivot[i]];
+            v[pivot[i]] = v[i];
+            if (first && sum != 0.0)
+            {
+               ii = i;
+               first = false;
+            }
+            else if (!first)
+            {
+               for (size_t j = ii; j < i; j++)
+                  sum -= row[j] * v[j];
+            }
+            v[i] = sum;
+         }
+
+            // back substitution
+         for (size_t i = n; i-- > 0; )
+         {
+            const double* row = luT + i*n;
+            double sum = v[i];
+            for (size_t j = i+1; j < n; j++)
+               sum -= row[j] * v[j];
+            v[i] = sum / row[i];
+         }
+      }
+
+         // Four right hand sides of luBackSub() at once, so that the rows
+         // of LU are read once for all four and the four sums are
+         // independent.
+      void luBackSub4( size_t n, const double* luT, const int* pivot,
+                       double* b )
+      {
+         double* v[4] = { b, b + n, b + 2*n, b + 3*n };
+         bool first[4] = { true, true, true, true };
+         size_t ii[4] = { 0, 0, 0, 0 };
+
+            // un-pivot
+         for (size_t i = 0; i < n; i++)
+         {
+            const double* row = luT + i*n;
+            double sum[4];
+            bool loop[4];
+            bool all = true;
+            size_t common = 0;
+            for (int q = 0; q < 4; q++)
+            {
+               sum[q] = v[q][pivot[i]];
+               v[q][pivot[i]] = v[q][i];
+               if (first[q] && sum[q] != 0.0)
+               {
+                  ii[q] = i;
+                  first[q] = false;
+                  loop[q] = false;
+               }
+               else
+                  loop[q] = !first[q];
+               all = all && loop[q];
+               common = std::max(common, ii[q]);
+            }
+
+            if (all)
+            {
+               for (int q = 0; q < 4; q++)
+                  for (size_t j = ii[q]; j < common; j++)
+                     sum[q] -= row[j] * v[q][j];
+               double s0 = sum[0], s1 = sum[1], s2 = sum[2], s3 = sum[3];
+               for (size_t j = common; j < i; j++)
+               {
+                  const double r = row[j];
+                  s0 -= r * v[0][j];
+                  s1 -= r * v[1][j];
+                  s2 -= r * v[2][j];
+                  s3 -= r * v[3][j];
+               }
+               sum[0] = s0;  sum[1] = s1;  sum[2] = s2;  sum[3] = s3;
+            }
+            else
+            {
+               for (int q = 0; q < 4; q++)
+                  if (loop[q])
+                     for (size_t j = ii[q]; j < i; j++)
+                        sum[q] -= row[j] * v[q][j];
+            }
+
+            for (int q = 0; q < 4; q++)
+               v[q][i] = sum[q];
+         }
+
+            // back substitution
+         for (size_t i = n; i-- > 0; )
+         {
+            const double* row = luT + i*n;
+            double s0 = v[0][i], s1 = v[1][i], s2 = v[2][i], s3 = v[3][i];
+            for (size_t j = i+1; j < n; j++)
+            {
+               const double r = row[j];
+               s0 -= r * v[0][j];
+               s1 -= r * v[1][j];
+               s2 -= r * v[2][j];
+               s3 -= r * v[3][j];
+            }
+            v[0][i] = s0 / row[i];
+            v[1][i] = s1 / row[i];
+            v[2][i] = s2 / row[i];
+            v[3][i] = s3 / row[i];
+         }
+      }
+   }
+
+
+   bool blockedCholeskyCrout( size_t n, const double* m, double* L )
+      throw()
+   {
+      std::fill(L, L + n*n, 0.0);
+      for (size_t j = 0; j < n; j++)
+         std::copy(m + j + j*n, m + (j+1)*n, L + j + j*n);
+
+         // Left looking, one panel of columns at a time. Column j gets
+         // L(i,k)*L(j,k) subtracted for k = 0, 1, ..., j-1 in turn, as in
+         // CholeskyCrout, but the columns k left of the panel are read
+         // only once for the whole panel.
+      for (size_t j0 = 0; j0 < n; j0 += PANEL)
+      {
+         const size_t j1 = std::min(n, j0 + PANEL);
+
+         for (size_t k = 0; k < j0; k += PANEL)
+            for (size_t j = j0; j < j1; j++)
+               choleskyUpdate(n, L, j, k, std::min(j0, k + PANEL));
+
+         for (size_t j = j0; j < j1; j++)
+         {
+            double* lj = L + j*n;
+            choleskyUpdate(n, L, j, j0, j);
+
+            if (!(lj[j] > 0.0))
+               return false;
+
+            lj[j] = SQRT(lj[j]);
+            const double d = lj[j];
+            for (size_t i = j+1; i < n; i++)
+               lj[i] = lj[i] / d;
+         }
+      }
+
+      return true;
+   }  // end blockedCholeskyCrout
+
+
+   void lowerTriangularInverse( size_t n, const double* LT, double* LI )
+      throw()
+   {
+      std::fill(LI, LI + n*n, 0.0);
+
+      for (size_t i = 0; i < n; i++)
+      {
+            // row i of L is column i of LT
+         const double* li = LT + i*n;
+         const double d = 1.0 / li[i];
+         LI[i + i*n] = d;
+
+            // The sums run from k = i down to k = 0, zeros included, so
+            // that even the signs of zero results match inverseChol().
+            // Four columns are done at once.
+         size_t j = 0;
+         for ( ; j + 4 <= i; j += 4)
+         {
+            const double* l0 = LI + j*n;
+            const double* l1 = l0 + n;
+            const double* l2 = l1 + n;
+            const double* l3 = l2 + n;
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            for (size_t k = i + 1; k-- > 0; )
+            {
+               const double x = li[k];
+               s0 += x * l0[k];
+               s1 += x * l1[k];
+               s2 += x * l2[k];
+               s3 += x * l3[k];
+            }
+            LI[i + j*n] = -s0 * d;
+            LI[i + (j+1)*n] = -s1 * d;
+            LI[i + (j+2)*n] = -s2 * d;
+            LI[i + (j+3)*n] = -s3 * d;
+         }
+         for ( ; j < i; j++)
+         {
+            const double* lij = LI + j*n;
+            double sum = 0.0;
+            for (size_t k = i + 1; k-- > 0; )
+               sum += li[k] * lij[k];
+            LI[i + j*n] = -sum * d;
+         }
+      }
+   }  // end lowerTriangularInverse
+
+
+   bool blockedLUDecomp( size_t n, double* lu, int* pivot, int& parity,
+                         double* scale )
+      throw()
+   {
+         // get scale of each row
+      std::fill(scale, scale + n, 0.0);
+      for (size_t j = 0; j < n; j++)
+      {
+         const double* col = lu + j*n;
+         for (size_t i = 0; i < n; i++)
+         {
+            const double t = ABS(col[i]);
+            if (t > scale[i])
+               scale[i] = t;
+         }
+      }
+      for (size_t i = 0; i < n; i++)
+      {
+         if (scale[i] <= 0.0)
+            return false;
+         scale[i] = 1.0 / scale[i];
+      }
+
+      parity = 1;
+
+         // Left looking Crout, one panel of columns at a time. Element
+         // (i,j) gets LU(i,k)*LU(k,j) subtracted for k = 0, 1, ... in turn,
+         // as in LUDecomp. Row interchanges swap whole rows, so updates
+         // made before an interchange are carried along with the rows.
+      for (size_t j0 = 0; j0 < n; j0 += PANEL)
+      {
+         const size_t j1 = std::min(n, j0 + PANEL);
+
+         for (size_t k = 0; k < j0; k += PANEL)
+            for (size_t j = j0; j < j1; j++)
+               luUpdate(n, lu, j, k, std::min(j0, k + PANEL));
+
+         for (size_t j = j0; j < j1; j++)
+         {
+            double* lj = lu + j*n;
+            luUpdate(n, lu, j, j0, j);
+
+               // find largest pivot
+            double big = 0.0;
+            size_t imax = j;
+            for (size_t i = j; i < n; i++)
+            {
+               const double d = scale[i] * ABS(lj[i]);
+               if (d >= big)
+               {
+                  big = d;
+                  imax = i;
+               }
+            }
+
+            if (j != imax)
+            {
+               for (size_t c = 0; c < n; c++)
+                  std::swap(lu[imax + c*n], lu[j + c*n]);
+               scale[imax] = scale[j];
+               parity = -parity;
+            }
+            pivot[j] = static_cast<int>(imax);
+
+            const double t = lj[j];
+            if (t == 0.0)
+               return false;
+            if (j != n-1)
+            {
+               const double d = 1.0 / t;
+               for (size_t i = j+1; i < n; i++)
+                  lj[i] *= d;
+            }
+         }
+      }
+
+      return true;
+   }  // end blockedLUDecomp
+
+
+   void luBackSub( size_t n, const double* luT, const int* pivot,
+                   size_t ncols, double* b )
+      throw()
+   {
+      size_t c = 0;
+      for ( ; c + 4 <= ncols; c += 4)
+         luBackSub4(n, luT, pivot, b + c*n);
+      for ( ; c < ncols; c++)
+         luBackSub1(n, luT, pivot, b + c*n);
+   }  // end luBackSub
+
+
+   bool gaussJordanInverse( size_t n, const double* m, double* work )
+      throw()
+   {
+      const size_t nn = n*n;
+      double* a = work;
+      double* factor = work + 2*nn;
+
+         // [ m | I ], n x 2n
+      std::copy(m, m + nn, a);
+      std::fill(a + nn, a + 2*nn, 0.0);
+      for (size_t i = 0; i < n; i++)
+         a[nn + i + i*n] = 1.0;
+
+      for (size_t r = 0; r < n; r++)
+      {
+            // if a(r,r) is zero, find another row to add to it
+         if (a[r + r*n] == 0.0)
+         {
+            size_t t = r+1;
+            while ( (t < n) && (a[t + r*n] == 0.0) )
+               t++;
+
+            if (t == n)
+               return false;
+
+            for (size_t j = r; j < 2*n; j++)
+               a[r + j*n] += (a[t + j*n] / a[t + r*n]);
+         }
+
+            // scale this row's (r,r)'th element to 1
+         const double temp = a[r + r*n];
+         for (size_t j = r; j < 2*n; j++)
+            a[r + j*n] /= temp;
+
+            // Do the elimination a column at a time. The factors are
+            // taken before any row changes, which is what inverse()
+            // sees too, since each row only changes itself.
+         const double arr = a[r + r*n];
+         for (size_t t = 0; t < n; t++)
+            if (t != r)
+               factor[t] = a[t + r*n] / arr;
+
+         for (size_t j = r; j < 2*n; j++)
+         {
+            double* col = a + j*n;
+            const double x = col[r];
+            for (size_t t = 0; t < r; t++)
+               col[t] -= factor[t] * x;
+            for (size_t t = r+1; t < n; t++)
+               col[t] -= factor[t] * x;
+         }
+      }
+
+      return true;
+   }  // end gaussJordanInverse
+
+
+   bool blockedMultiply( const ConstMatrixBase<double, Matrix<double> >& l,
+                         const ConstMatrixBase<double, Matrix<double> >& r,
+                         Matrix<double>& result )
+   {
+      const size_t rows = l.rows(), cols = r.cols(), inner = l.cols();
+      if (std::max(rows, std::max(cols, inner)) < MATRIX_KERNEL_MIN_SIZE)
+         return false;
+
+      const Matrix<double>& lm = static_cast<const Matrix<double>&>(l);
+      const Matrix<double>& rm = static_cast<const Matrix<double>&>(r);
+      if (result.rows() != rows || result.cols() != cols)
+         result.resize(rows, cols);
+      blockedMultiply(rows, cols, inner, lm.begin(), rm.begin(),
+                      result.begin());
+      return true;
+   }
+
+
+   bool blockedMultiply( const ConstMatrixBase<double, Matrix<double> >& m,
+                         const ConstVectorBase<double, Vector<double> >& v,
+                         Vector<double>& result )
+   {
+      if (std::max(m.rows(), m.cols()) < MATRIX_KERNEL_MIN_SIZE)
+         return false;
+
+      const Matrix<double>& mm = static_cast<const Matrix<double>&>(m);
+      const Vector<double>& vv = static_cast<const Vector<double>&>(v);
+      if (result.size() != m.rows())
+         result.resize(m.rows());
+      blockedMultiply(m.rows(), m.cols(), mm.begin(), vv.begin(),
+                      result.begin());
+      return true;
+   }
+
+
+   bool blockedTranspose( const ConstMatrixBase<double, Matrix<double> >& m,
+                          Matrix<double>& result )
+   {
+      if (std::max(m.rows(), m.cols()) < MATRIX_KERNEL_MIN_SIZE)
+         return false;
+
+      const Matrix<double>& mm = static_cast<const Matrix<double>&>(m);
+      if (result.rows() != m.cols() || result.cols() != m.rows())
+         result.resize(m.cols(), m.rows());
+      blockedTranspose(m.rows(), m.cols(), mm.begin(), result.begin());
+      return true;
+   }
+
+
+   bool blockedCholeskyCrout(
+                           const ConstMatrixBase<double, Matrix<double> >& m,
+                           Matrix<double>& L )
+      throw(MatrixException)
+   {
+      const size_t n = m.rows();
+      if (n < MATRIX_KERNEL_MIN_SIZE)
+         return false;
+
+      const Matrix<double>& mm = static_cast<const Matrix<double>&>(m);
+      L.resize(n, n);
+      if (!blockedCholeskyCrout(n, mm.begin(), L.begin()))
+      {
+         MatrixException e("CholeskyCrout fails - eigenvalue <= 0");
+         GPSTK_THROW(e);
+      }
+      return true;
+   }
+
+
+   bool blockedInverseChol( const ConstMatrixBase<double, Matrix<double> >& m,
+                            Matrix<double>& inv )
+      throw(MatrixException)
+   {
+      const size_t n = m.rows();
+      if (n < MATRIX_KERNEL_MIN_SIZE)
+         return false;
+
+      if (!m.isSquare())
+      {
+         MatrixException e("CholeskyCrout requires a square matrix");
+         GPSTK_THROW(e);
+      }
+
+      const Matrix<double>& mm = static_cast<const Matrix<double>&>(m);
+      std::vector<double> L(n*n), LT(n*n), LI(n*n), LIT(n*n);
+      if (!blockedCholeskyCrout(n, mm.begin(), &L[0]))
+      {
+         MatrixException e("CholeskyCrout fails - eigenvalue <= 0");
+         GPSTK_THROW(e);
+      }
+
+         // m^-1 = transpose(LI)*LI, where LI = L^-1
+      blockedTranspose(n, n, &L[0], &LT[0]);
+      lowerTriangularInverse(n, &LT[0], &LI[0]);
+      blockedTranspose(n, n, &LI[0], &LIT[0]);
+      inv.resize(n, n);
+      blockedMultiply(n, n, n, &LIT[0], &LI[0], inv.begin());
+      return true;
+   }
+
+
+   bool blockedLUDecomp( Matrix<double>& LU, Vector<int>& pivot, int& parity )
+      throw(MatrixException)
+   {
+      const size_t n = LU.rows();
+      if (n < MATRIX_KERNEL_MIN_SIZE)
+         return false;
+
+      std::vector<double> scale(n);
+      if (pivot.size() != n)
+         pivot.resize(n);
+      if (!blockedLUDecomp(n, LU.begin(), pivot.begin(), parity, &scale[0]))
+      {
+         SingularMatrixException e("singular matrix!");
+         GPSTK_THROW(e);
+      }
+      return true;
+   }
+
+
+   bool blockedInverseLUD( const ConstMatrixBase<double, Matrix<double> >& m,
+                           Matrix<double>& inv )
+      throw(MatrixException)
+   {
+      const size_t n = m.rows();
+      if (n < MATRIX_KERNEL_MIN_SIZE)
+         return false;
+
+      Matrix<double> LU(static_cast<const Matrix<double>&>(m));
+      Vector<int> pivot(n);
+      int parity;
+      blockedLUDecomp(LU, pivot, parity);
+
+      std::vector<double> luT(n*n);
+      blockedTranspose(n, n, LU.begin(), &luT[0]);
+
+      inv.resize(n, n);
+      double* b = inv.begin();
+      std::fill(b, b + n*n, 0.0);
+      for (size_t i = 0; i < n; i++)
+         b[i + i*n] = 1.0;
+      luBackSub(n, &luT[0], pivot.begin(), n, b);
+      return true;
+   }
+
+
+   bool blockedInverse( const ConstMatrixBase<double, Matrix<double> >& m,
+                        Matrix<double>& inv )
+      throw(MatrixException)
+   {
+      const size_t n = m.rows();
+      if (n < MATRIX_KERNEL_MIN_SIZE)
+         return false;
+
+      const Matrix<double>& mm = static_cast<const Matrix<double>&>(m);
+      std::vector<double> work(2*n*n + n);
+      if (!gaussJordanInverse(n, mm.begin(), &work[0]))
+      {
+         SingularMatrixException e("Singular matrix");
+         GPSTK_THROW(e);
+      }
+
+      inv.resize(n, n);
+      std::copy(&work[n*n], &work[0] + 2*n*n, inv.begin());
+      return true;
+   }
+
+}  // namespace gpstk
@@ -0,0 +1,212 @@
+#pragma ident "$Id$"
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file MatrixKernels.hpp
+ * Cache-blocked kernels for Matrix<double>, used by the Matrix operators
+ * and functors when the matrices are big enough.
+ */
+
+#ifndef GPSTK_MATRIX_KERNELS_HPP
+#define GPSTK_MATRIX_KERNELS_HPP
+
+#include <cstddef>
+#include "MatrixBase.hpp"
+
+namespace gpstk
+{
+ /** @addtogroup VectorGroup */
+   //@{
+
+   template <class T> class Matrix;
+
+      /** Matrix<double> objects with at least this number of rows or
+       * columns are handled by the kernels below. Smaller matrices keep
+       * using the generic code, where the loop overhead is lower.
+       */
+   const size_t MATRIX_KERNEL_MIN_SIZE = 16;
+
+/**
+ * @name Raw kernels
+ * These work on plain arrays stored in column major order, like
+ * Matrix<T> does. Every element is accumulated in the same order as the
+ * generic code in MatrixOperators.hpp and MatrixFunctors.hpp, so the
+ * results are the same bit by bit; only the traversal is changed, so
+ * that the inner loops run over contiguous memory.
+ */
+   //@{
+
+      /** result = l * r, where l is rows x inner and r is inner x cols.
+       * result must not overlap l or r.
+       */
+   void blockedMultiply( size_t rows, size_t cols, size_t inner,
+                         const double* l, const double* r, double* result )
+      throw();
+
+      /// result = m * v, where m is rows x cols.
+   void blockedMultiply( size_t rows, size_t cols,
+                         const double* m, const double* v, double* result )
+      throw();
+
+      /// result = transpose(m), where m is rows x cols.
+   void blockedTranspose( size_t rows, size_t cols,
+                          const double* m, double* result )
+      throw();
+
+      /** Cholesky-Crout decomposition of the symmetric positive definite
+       * n x n matrix m into the lower triangular L, with m = L*transpose(L).
+       * Only the lower triangle of m is used.
+       * @return false if m is not positive definite.
+       */
+   bool blockedCholeskyCrout( size_t n, const double* m, double* L )
+      throw();
+
+      /** Inverse LI of the n x n lower triangular matrix L, computed as
+       * inverseChol() does.
+       * @param LT  transpose(L), so that the rows of L are contiguous.
+       */
+   void lowerTriangularInverse( size_t n, const double* LT, double* LI )
+      throw();
+
+      /** LU decomposition, in place, of the n x n matrix lu, with the
+       * same implicit pivoting as LUDecomp.
+       * @param pivot   n row interchanges done.
+       * @param parity  +1 or -1 for an even or odd number of interchanges.
+       * @param scale   n doubles of workspace.
+       * @return false if the matrix is singular.
+       */
+   bool blockedLUDecomp( size_t n, double* lu, int* pivot, int& parity,
+                         double* scale )
+      throw();
+
+      /** Solve for ncols right hand sides, in place, using the output of
+       * blockedLUDecomp(). The same back substitution as
+       * LUDecomp::backSub() is used for each right hand side.
+       * @param luT  The LU decomposition, transposed.
+       * @param b    n x ncols right hand sides, overwritten by the solution.
+       */
+   void luBackSub( size_t n, const double* luT, const int* pivot,
+                   size_t ncols, double* b )
+      throw();
+
+      /** Inverse of the n x n matrix m by Gaussian elimination, as
+       * inverse() does.
+       * @param work  2*n*n + n doubles of workspace; the inverse is left
+       *              in elements n*n to 2*n*n - 1.
+       * @return false if the matrix is singular.
+       */
+   bool gaussJordanInverse( size_t n, const double* m, double* work )
+      throw();
+
+   //@}
+
+/**
+ * @name Dispatchers
+ * Called by the generic templates. The template versions do nothing and
+ * return false; the overloads for Matrix<double> (and Vector<double>) use
+ * the raw kernels when the matrices are at least MATRIX_KERNEL_MIN_SIZE
+ * in size, and return true when the work is done.
+ */
+   //@{
+
+   template <class T, class BaseClass1, class BaseClass2>
+   inline bool blockedMultiply( const ConstMatrixBase<T, BaseClass1>& l,
+                                const ConstMatrixBase<T, BaseClass2>& r,
+                                Matrix<T>& result )
+   { return false; }
+
+   bool blockedMultiply( const ConstMatrixBase<double, Matrix<double> >& l,
+                         const ConstMatrixBase<double, Matrix<double> >& r,
+                         Matrix<double>& result );
+
+   template <class T, class BaseClass1, class BaseClass2>
+   inline bool blockedMultiply( const ConstMatrixBase<T, BaseClass1>& m,
+                                const ConstVectorBase<T, BaseClass2>& v,
+                                Vector<T>& result )
+   { return false; }
+
+   bool blockedMultiply( const ConstMatrixBase<double, Matrix<double> >& m,
+                         const ConstVectorBase<double, Vector<double> >& v,
+                         Vector<double>& result );
+
+   template <class T, class BaseClass>
+   inline bool blockedTranspose( const ConstMatrixBase<T, BaseClass>& m,
+                                 Matrix<T>& result )
+   { return false; }
+
+   bool blockedTranspose( const ConstMatrixBase<double, Matrix<double> >& m,
+                          Matrix<double>& result );
+
+   template <class T, class BaseClass>
+   inline bool blockedCholeskyCrout( const ConstMatrixBase<T, BaseClass>& m,
+                                     Matrix<T>& L )
+   { return false; }
+
+   bool blockedCholeskyCrout(
+                           const ConstMatrixBase<double, Matrix<double> >& m,
+                           Matrix<double>& L )
+      throw(MatrixException);
+
+   template <class T, class BaseClass>
+   inline bool blockedInverseChol( const ConstMatrixBase<T, BaseClass>& m,
+                                   Matrix<T>& inv )
+   { return false; }
+
+   bool blockedInverseChol( const ConstMatrixBase<double, Matrix<double> >& m,
+                            Matrix<double>& inv )
+      throw(MatrixException);
+
+   template <class T>
+   inline bool blockedLUDecomp( Matrix<T>& LU, Vector<int>& pivot,
+                                int& parity )
+   { return false; }
+
+   bool blockedLUDecomp( Matrix<double>& LU, Vector<int>& pivot, int& parity )
+      throw(MatrixException);
+
+   template <class T, class BaseClass>
+   inline bool blockedInverseLUD( const ConstMatrixBase<T, BaseClass>& m,
+                                  Matrix<T>& inv )
+   { return false; }
+
+   bool blockedInverseLUD( const ConstMatrixBase<double, Matrix<double> >& m,
+                           Matrix<double>& inv )
+      throw(MatrixException);
+
+   template <class T, class BaseClass>
+   inline bool blockedInverse( const ConstMatrixBase<T, BaseClass>& m,
+                               Matrix<T>& inv )
+   { return false; }
+
+   bool blockedInverse( const ConstMatrixBase<double, Matrix<double> >& m,
+                        Matrix<double>& inv )
+      throw(MatrixException);
+
+   //@}
+
+   //@}
+
+}  // namespace gpstk
+
+#endif
@@ -288,6 +288,8 @@ namespace gpstk
    inline Matrix<T> transpose(const ConstMatrixBase<T, BaseClass>& m)
    {
       Matrix<T> temp(m.cols(), m.rows());
+      if (blockedTranspose(m, temp))
+         return temp;
       size_t i, j;
       for (i = 0; i < m.rows(); i++)
          for (j = 0; j < m.cols(); j++)
@@ -435,6 +437,12 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
+      {
+         Matrix<T> inv;
+         if (blockedInverse(m, inv))
+            return inv;
+      }
+
       Matrix<T> toReturn(m.rows(), m.cols() * 2);
 
       size_t r, t, j;
@@ -508,6 +516,7 @@ namespace gpstk
 
       size_t i,j,N=m.rows();
       Matrix<T> inv(m);
+      if(blockedInverseLUD(m, inv)) return inv;
       Vector<T> V(N);
       LUDecomp<T> LU;
       LU(m);
@@ -571,6 +580,7 @@ namespace gpstk
        int N = m.rows(), i, j, k;
        double sum;
        Matrix<T> LI(N,N, 0.0);      // Here we will first store L^-1, and later m^-1
+       if(blockedInverseChol(m, LI)) return LI;
 
        // Let's call CholeskyCrout class to decompose matrix "m" in L*LT
        gpstk::CholeskyCrout<double> CC;
@@ -608,6 +618,8 @@ namespace gpstk
       }
    
       Matrix<T> toReturn(l.rows(), r.cols(), T(0));
+      if (blockedMultiply(l, r, toReturn))
+         return toReturn;
       size_t i, j, k;
       for (i = 0; i < toReturn.rows(); i++)
          for (j = 0; j < toReturn.cols(); j++)
@@ -632,6 +644,8 @@ namespace gpstk
       }
    
       Vector<T> toReturn(m.rows());
+      if (blockedMultiply(m, v, toReturn))
+         return toReturn;
       size_t i, j;
       for (i = 0; i < m.rows(); i++) 
       {
@@ -59,37 +59,58 @@ namespace gpstk
    /** @defgroup math Mathematical algorithms */
    //@{
 
-   /** Perform Lagrange interpolation on the data (X[i],Y[i]), i=1,N (N=X.size()),
+   /** Perform Lagrange interpolation on the data (X[i],Y[i]), i=0,N-1,
     * returning the value of Y(x). Also return an estimate of the estimation error in 'err'.
-    * Assumes k=X.size() is even, and that x is between X[j-1] and X[j], where j=k/2.
+    * Assumes N is even, and that x is between X[j-1] and X[j], where j=N/2.
+    * This version works directly on contiguous arrays; windows of up to 16
+    * points use no heap storage.
     */
    template <class T>
-   T LagrangeInterpolation(const std::vector<T>& X, const std::vector<T>& Y, const T& x, T& err)
+   T LagrangeInterpolation(const T* X, const T* Y, size_t N, const T& x, T& err)
    {
       size_t i,j,k;
       T y,del;
-      std::vector<T> D,Q;
+      T Dbuf[16],Qbuf[16];
+      std::vector<T> Dvec,Qvec;
+      T *D(Dbuf),*Q(Qbuf);
+
+      if(N > 16) {
+         Dvec.resize(N);
+         Qvec.resize(N);
+         D = &Dvec[0];
+         Q = &Qvec[0];
+      }
 
       err = T(0);
-      k = X.size()/2;
+      k = N/2;
       if(x == X[k]) return Y[k];
       if(x == X[k-1]) return Y[k-1];
       if(ABS(x-X[k-1]) < ABS(x-X[k])) k=k-1;
-      for(i=0; i<X.size(); i++) {
-         Q.push_back(Y[i]);
-         D.push_back(Y[i]);
+      for(i=0; i<N; i++) {
+         Q[i] = Y[i];
+         D[i] = Y[i];
       }
       y = Y[k--];
-      for(j=1; j<X.size(); j++) {
-         for(i=0; i<X.size()-j; i++) {
+      for(j=1; j<N; j++) {
+         for(i=0; i<N-j; i++) {
             del = (Q[i+1]-D[i])/(X[i]-X[i+j]);
             D[i] = (X[i+j]-x)*del;
             Q[i] = (X[i]-x)*del;
          }
-         err = (2*k < X.size()-j ? Q[k+1] : D[k--]);
+         err = (2*k < N-j ? Q[k+1] : D[k--]);
          y += err;
       }
       return y;
+   }  // end T LagrangeInterpolation(const T*, const T*, size_t, const T, T&)
+
+   /** Perform Lagrange interpolation on the data (X[i],Y[i]), i=1,N (N=X.size()),
+    * returning the value of Y(x). Also return an estimate of the estimation error in 'err'.
+    * Assumes k=X.size() is even, and that x is between X[j-1] and X[j], where j=k/2.
+    */
+   template <class T>
+   T LagrangeInterpolation(const std::vector<T>& X, const std::vector<T>& Y, const T& x, T& err)
+   {
+      return LagrangeInterpolation(&X[0], &Y[0], X.size(), x, err);
    }  // end T LagrangeInterpolation(vector, vector, const T, T&)
 
    // The following is a
@@ -106,31 +127,44 @@ namespace gpstk
    // Qij is symmetric, there are only N(N+1)/2 - N of them, so store them
    // in a vector of length N(N+1)/2, where Qij==Q[i+j*(j+1)/2] (ignore i=j).
 
-   /** Perform Lagrange interpolation on the data (X[i],Y[i]), i=1,N (N=X.size()),
+   /** Perform Lagrange interpolation on the data (X[i],Y[i]), i=0,N-1,
     * returning the value of Y(x) and dY(x)/dX.
     * Assumes that x is between X[k-1] and X[k], where k=N/2.
+    * This version works directly on contiguous arrays; windows of up to 16
+    * points use no heap storage.
     * Warning: for use with the precise (SP3) ephemeris only when velocity is not
     * available; estimates of velocity, and especially clock drift, not as accurate.
     */
    template <class T>
-   void LagrangeInterpolation(const std::vector<T>& X, const std::vector<T>& Y, const T& x, T& y, T& dydx)
+   void LagrangeInterpolation(const T* X, const T* Y, size_t N, const T& x, T& y, T& dydx)
    {
-      size_t i,j,k,N=X.size(),M;
+      size_t i,j,k,M;
       M = (N*(N+1))/2;
-      std::vector<T> P(N,T(1)),Q(M,T(1)),D(N,T(1));
+      T Pbuf[16],Qbuf[136],Dbuf[16];
+      std::vector<T> Pvec,Qvec,Dvec;
+      T *P(Pbuf),*Q(Qbuf),*D(Dbuf);
+
+      if(N > 16) {
+         Pvec.resize(N);
+         Qvec.resize(M);
+         Dvec.resize(N);
+         P = &Pvec[0];
+         Q = &Qvec[0];
+         D = &Dvec[0];
+      }
+      for(i=0; i<N; i++) P[i] = D[i] = T(1);
+      for(i=0; i<M; i++) Q[i] = T(1);
+
       for(i=0; i<N; i++) {
          for(j=0; j<N; j++) {
             if(i != j) {
                P[i] *= x-X[j];
                D[i] *= X[i]-X[j];
                if(i < j) {
-//std::cout << "Compute Q[" << i << "," << j << "=" << (i+(j*(j+1))/2) << "] = 1 ";
                   for(k=0; k<N; k++) {
                      if(k == i || k == j) continue;
-//std::cout << " * (x-X[" << k << "])";
                      Q[i+(j*(j+1))/2] *= (x-X[k]);
                   }
-//std::cout << " = " << Q[i+(j*(j+1))/2] << std::endl;
                }
             }
          }
@@ -145,6 +179,18 @@ namespace gpstk
          }
          dydx += Y[i]*S;
       }
+   }  // end void LagrangeInterpolation(const T*, const T*, size_t, const T, T&, T&)
+
+   /** Perform Lagrange interpolation on the data (X[i],Y[i]), i=1,N (N=X.size()),
+    * returning the value of Y(x) and dY(x)/dX.
+    * Assumes that x is between X[k-1] and X[k], where k=N/2.
+    * Warning: for use with the precise (SP3) ephemeris only when velocity is not
+    * available; estimates of velocity, and especially clock drift, not as accurate.
+    */
+   template <class T>
+   void LagrangeInterpolation(const std::vector<T>& X, const std::vector<T>& Y, const T& x, T& y, T& dydx)
+   {
+      LagrangeInterpolation(&X[0], &Y[0], X.size(), x, y, dydx);
    }  // end void LagrangeInterpolation(vector, vector, const T, T&, T&)
 
 
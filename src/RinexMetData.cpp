@@ -50,6 +50,7 @@
 
 #include "StringUtils.hpp"
 #include "DayTime.hpp"
+#include "DayTimeFormat.hpp"
 #include "RinexMetHeader.hpp"
 #include "RinexMetData.hpp"
 #include "RinexMetStream.hpp"
@@ -62,6 +63,9 @@ namespace gpstk
    const int RinexMetData::maxObsPerLine = 8;
    const int RinexMetData::maxObsPerContinuationLine = 10;
 
+      // Layout of the time at the start of a record
+   static const DayTimeFormat timeFormat(" %02y %2m %2d %2H %2M %2S");
+
    void RinexMetData::reallyPutRecord(FFStream& ffs) const
       throw(std::exception, FFStreamError, 
             gpstk::StringUtils::StringException)
@@ -73,18 +77,7 @@ namespace gpstk
       string line;
       
          // write the first line
-      line += " ";
-      line += rightJustify(asString<short>(time.year()),2,'0');
-      line += " ";
-      line += rightJustify(asString<short>(time.month()),2);
-      line += " ";
-      line += rightJustify(asString<short>(time.day()),2);
-      line += " ";
-      line += rightJustify(asString<short>(time.hour()),2);
-      line += " ";
-      line += rightJustify(asString<short>(time.minute()),2);
-      line += " ";
-      line += rightJustify(asString<short>(short(time.second())),2);
+      line += timeFormat.print(time);
       
       for (int i = 0; 
            (i < strm.header.obsTypeList.size()) &&
@@ -226,7 +219,7 @@ namespace gpstk
       {
             // according to the RINEX spec, any 2 digit year 80 or greater
             // is a year in the 1900s (1980-1999), under 80 is 2000s
-         const int YearRollover = 80;
+         const int YearRollover = 1980;
          
             // check if the spaces are in the right place - an easy way to check
             // if there's corruption in the file
@@ -241,24 +234,7 @@ namespace gpstk
             GPSTK_THROW(e);
          }
          
-         int year, month, day, hour, min;
-         double sec;
-         
-         year  = asInt(   line.substr(1,  2 ));
-         month = asInt(   line.substr(3,  3 ));
-         day   = asInt(   line.substr(6,  3 ));
-         hour  = asInt(   line.substr(9,  3 ));
-         min   = asInt(   line.substr(12, 3 ));
-         sec   = asInt(   line.substr(15, 3 ));
-         
-         if (year < YearRollover)
-         {
-            year += 100;
-         }
-         year += 1900;
-         
-         DayTime rv(year, month, day, hour, min, sec);
-         return rv;
+         return timeFormat.scan(line, YearRollover);
       }
       catch (std::exception &e)
       {
@@ -50,6 +50,7 @@
 
 #include "StringUtils.hpp"
 #include "DayTime.hpp"
+#include "DayTimeFormat.hpp"
 #include "RinexNavData.hpp"
 #include "RinexNavStream.hpp"
 #include "icd_200_constants.hpp"
@@ -229,23 +230,16 @@ namespace gpstk
       return l;
    }
 
+      // Layout of the epoch after the PRN on the first line of a record;
+      // the year is padded with 0s but none of the rest are
+   static const DayTimeFormat epochFormat(" %02y %2m %2d %2H %2M%5.1f");
+
    string RinexNavData::putPRNEpoch(void) const
       throw(StringException)
    {
       string line;
       line += rightJustify(asString(PRNID), 2);
-      line += string(1, ' ');
-         // year is padded with 0s but none of the rest are
-      line += rightJustify(asString<short>(time.year()), 2, '0');
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(time.month()), 2);
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(time.day()), 2);
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(time.hour()), 2);
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(time.minute()), 2);
-      line += rightJustify(asString(time.second(), 1), 5);
+      line += epochFormat.print(time);
       line += string(1, ' ');
       line += doub2for(af0, 18, 2);
       line += string(1, ' ');
@@ -387,24 +381,12 @@ namespace gpstk
          
          PRNID = asInt(currentLine.substr(0,2));
 
-         short yr = asInt(currentLine.substr(2,3));
-         short mo = asInt(currentLine.substr(5,3));
-         short day = asInt(currentLine.substr(8,3));
-         short hr = asInt(currentLine.substr(11,3));
-         short min = asInt(currentLine.substr(14,3));
-         double sec = asDouble(currentLine.substr(17,5));
-         
             // years 80-99 represent 1980-1999
-         const int rolloverYear = 80;
-         if (yr < rolloverYear)
-            yr += 100;
-         yr += 1900;
+         const int rolloverYear = 1980;
 
          // Real Rinex has epochs 'yy mm dd hr 59 60.0' surprisingly often....
-         double ds=0;
-         if(sec >= 60.) { ds=sec; sec=0.0; }
-         time = DayTime(yr,mo,day,hr,min,sec);
-         if(ds != 0) time += ds;
+         time = epochFormat.scan(currentLine.data() + 2,
+                                 currentLine.length() - 2, rolloverYear);
          
          Toc = time.GPSsecond();
          af0 = gpstk::StringUtils::for2doub(currentLine.substr(22,19));
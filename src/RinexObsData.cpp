@@ -42,17 +42,81 @@
  */
 
 #include "StringUtils.hpp"
+#include "DayTimeFormat.hpp"
 #include "RinexObsData.hpp"
 #include "RinexObsStream.hpp"
 
 using namespace gpstk::StringUtils;
 using namespace std;
 
+namespace
+{
+      // Layout of the epoch at the start of an epoch/flag line
+   const gpstk::DayTimeFormat epochFormat(" %02y %2m %2d %2H %2M%11.7f");
+
+      // Width of the field [pos, pos+n) of a line of len characters,
+      // clipped to the end of the line like std::string::substr().
+   inline string::size_type fieldWidth( string::size_type len,
+                                        string::size_type pos,
+                                        string::size_type n )
+   { return (pos >= len) ? 0 : min(n, len - pos); }
+
+      // In-place equivalent of RinexSatID::fromString()
+   gpstk::SatID parseSatID(const char* p, string::size_type n)
+      throw(gpstk::FFStreamError)
+   {
+      gpstk::SatID sat(-1, gpstk::SatID::systemGPS);
+
+      string::size_type i = 0;
+      while (i < n && isspace(static_cast<unsigned char>(p[i])))
+         i++;
+      if (i == n)
+         return sat;
+
+      switch (p[i])
+      {
+         case '0': case '1': case '2': case '3': case '4':
+         case '5': case '6': case '7': case '8': case '9':
+            i--;
+            break;
+         case 'R': case 'r':
+            sat.system = gpstk::SatID::systemGlonass;
+            break;
+         case 'T': case 't':
+            sat.system = gpstk::SatID::systemTransit;
+            break;
+         case 'S': case 's':
+            sat.system = gpstk::SatID::systemGeosync;
+            break;
+         case 'E': case 'e':
+            sat.system = gpstk::SatID::systemGalileo;
+            break;
+         case 'M': case 'm':
+            sat.system = gpstk::SatID::systemMixed;
+            break;
+         case 'G': case 'g':
+            break;
+         default:
+            gpstk::FFStreamError e(string("Invalid system character \"")
+                                   + p[i] + string("\""));
+            GPSTK_THROW(e);
+      }
+      i++;
+
+      sat.id = asInt(p + i, n - i);
+      if (sat.id <= 0)
+         sat.id = -1;
+
+      return sat;
+   }
+}
+
 namespace gpstk
 {
 
       // Definition of static variable to be used across RinexObsData objects
    DayTime gpstk::RinexObsData::previousTime;
+   const string::size_type RinexObsData::minEpochLineLength;
 	
    void RinexObsData::reallyPutRecord(FFStream& ffs) const 
       throw(std::exception, FFStreamError, StringException)
@@ -185,6 +249,14 @@ namespace gpstk
          // If the header hasn't been read, read it...
       if(!strm.headerRead) strm >> strm.header;
       
+         // Mapped streams are parsed in place
+      if(strm.isMapped())
+      {
+         getMappedRecord(strm);
+         return;
+      }
+
+
          // Clear out this object
       RinexObsHeader& hdr = strm.header;
       
@@ -317,6 +389,193 @@ namespace gpstk
    } // end of reallyGetRecord()
 
 
+   void RinexObsData::getMappedRecord(RinexObsStream& strm)
+      throw(exception, FFStreamError, gpstk::StringUtils::StringException)
+   {
+      strm.startMappedRead();
+
+      unsigned long initialPos = strm.mapPos;
+
+      try
+      {
+         const RinexObsHeader& hdr = strm.header;
+
+            // Clear out this object. Only the fields that the parse
+            // below doesn't always set need to be reset.
+         obs.clear();
+         if (auxHeader.valid)
+            auxHeader = RinexObsHeader();
+
+         const char *line, *end;
+         strm.mappedGetLine(line, end, true);
+         string::size_type len = end - line;
+
+         if (len > 80 || len < minEpochLineLength ||
+             line[0] != ' ' || line[3] != ' ' || line[6] != ' ')
+         {
+            FFStreamError e("Bad epoch line");
+            GPSTK_THROW(e);
+         }
+
+            // process the epoch line, including SV list and clock bias
+         epochFlag = asInt(line + 28, 1);
+         if ((epochFlag < 0) || (epochFlag > 6))
+         {
+            FFStreamError e("Invalid epoch flag: " + asString(epochFlag));
+            GPSTK_THROW(e);
+         }
+
+            // See reallyGetRecord() for the epoch time rules
+         bool noEpochTime = (len >= 26);
+         for (int i = 0; noEpochTime && i < 26; i++)
+            noEpochTime = (line[i] == ' ');
+
+         if (noEpochTime &&
+             (epochFlag==0 || epochFlag==1 || epochFlag==5 || epochFlag==6 ))
+         {
+            FFStreamError e("Required epoch time missing: " +
+                            string(line, len));
+            GPSTK_THROW(e);
+         }
+         else if (noEpochTime)
+         {
+            time = previousTime;
+         }
+         else
+         {
+            time = parseTime(line, len, hdr);
+            previousTime = time;
+         }
+
+         numSvs = asInt(line + 29, fieldWidth(len, 29, 3));
+
+         if (len > 68)
+            clockOffset = asDouble(line + 68, fieldWidth(len, 68, 12));
+         else
+            clockOffset = 0.0;
+
+            // Now read the observations ...
+         if (epochFlag==0 || epochFlag==1 || epochFlag==6)
+         {
+            int isv, ndx, line_ndx;
+            vector<SatID> satIndex(numSvs);
+            const int col=30;
+            for (isv=1, ndx=0; ndx<numSvs; isv++, ndx++)
+            {
+               if (! (isv % 13))
+               {
+                  strm.mappedGetLine(line, end);
+                  len = end - line;
+                  isv = 1;
+                  if (len > 80)
+                  {
+                     FFStreamError err("Invalid line size:" + asString(len));
+                     GPSTK_THROW(err);
+                  }
+               }
+               string::size_type pos = col+isv*3-1;
+               if (pos > len)
+               {
+                  FFStreamError err("Missing satellite ID");
+                  GPSTK_THROW(err);
+               }
+               satIndex[ndx] = parseSatID(line + pos, fieldWidth(len, pos, 3));
+            }
+
+            const short numObs = hdr.obsTypeList.size();
+            for (isv=0; isv < numSvs; isv++)
+            {
+               RinexObsTypeMap& satObs = obs[satIndex[isv]];
+               for (ndx=0, line_ndx=0; ndx < numObs; ndx++, line_ndx++)
+               {
+                  if (! (line_ndx % 5))
+                  {
+                     strm.mappedGetLine(line, end);
+                     len = end - line;
+                     line_ndx = 0;
+                     if (len > 80)
+                     {
+                        FFStreamError err("Invalid line size:" + asString(len));
+                        GPSTK_THROW(err);
+                     }
+                  }
+
+                     // Fields past the end of the line are blank
+                  string::size_type pos = line_ndx*16;
+                  RinexDatum& datum = satObs[hdr.obsTypeList[ndx]];
+                  datum.data = asDouble(line + pos, fieldWidth(len, pos, 14));
+                  datum.lli = asInt(line + pos + 14, fieldWidth(len, pos+14, 1));
+                  datum.ssi = asInt(line + pos + 15, fieldWidth(len, pos+15, 1));
+               }
+            }
+         }
+            // ... or the auxiliary header information
+         else if (numSvs > 0)
+         {
+            auxHeader.clear();
+            for (int i=0; i<numSvs; i++)
+            {
+               strm.mappedGetLine(line, end);
+               string hline(line, end - line);
+               StringUtils::stripTrailing(hline);
+               auxHeader.ParseHeaderRecord(hline);
+            }
+         }
+      }
+      catch (...)
+      {
+            // Leave the mapping where the record started, the same way
+            // FFStream rolls the file position back; in forward-only mode
+            // reading goes on after the line that failed, as it does from
+            // the file.
+         if (!strm.isForwardOnly())
+         {
+            strm.mapPos = initialPos;
+         }
+         throw;
+      }
+
+   } // end of getMappedRecord()
+
+
+   DayTime RinexObsData::parseTime(const char* line,
+                                   string::size_type len,
+                                   const RinexObsHeader& hdr) const
+      throw(FFStreamError)
+   {
+      try
+      {
+         if ( len < 16 ||
+              (line[0] != ' ') ||
+              (line[3] != ' ') ||
+              (line[6] != ' ') ||
+              (line[9] != ' ') ||
+              (line[12] != ' ') ||
+              (line[15] != ' '))
+         {
+            FFStreamError e("Invalid time format");
+            GPSTK_THROW(e);
+         }
+
+            // two digit years are in the century of the first observation
+         int yy = hdr.firstObs.year()/100;
+         yy *= 100;
+
+            // Real Rinex has epochs 'yy mm dd hr 59 60.0' surprisingly
+            // often; scan() adds seconds of 60 or more after the rest
+         return epochFormat.scan(line, len, yy);
+      }
+      catch (gpstk::Exception& e)
+      {
+         std::string text;
+         for(size_t i=0; i<e.getTextCount(); i++) text += e.getText(i);
+         FFStreamError err("gpstk::Exception in parseTime(): " + text);
+         GPSTK_THROW(err);
+      }
+
+   }
+
+
    DayTime RinexObsData::parseTime(const string& line, 
                                    const RinexObsHeader& hdr) const
       throw(FFStreamError)
@@ -342,25 +601,11 @@ namespace gpstk
             return DayTime(DayTime::BEGINNING_OF_TIME);
          }
 
-         int year, month, day, hour, min;
-         double sec;
          int yy = hdr.firstObs.year()/100;
          yy *= 100;
-   
-         year  = asInt(   line.substr(1,  2 ));
-         month = asInt(   line.substr(4,  2 ));
-         day   = asInt(   line.substr(7,  2 ));
-         hour  = asInt(   line.substr(10, 2 ));
-         min   = asInt(   line.substr(13, 2 ));
-         sec   = asDouble(line.substr(15, 11));
 
          // Real Rinex has epochs 'yy mm dd hr 59 60.0' surprisingly often....
-         double ds=0;
-         if(sec >= 60.) { ds=sec; sec=0.0; }
-         DayTime rv(yy+year, month, day, hour, min, sec);
-         if(ds != 0) rv += ds;
-
-         return rv;
+         return epochFormat.scan(line, yy);
       }
          // string exceptions for substr are caught here
       catch (std::exception &e)
@@ -371,7 +616,7 @@ namespace gpstk
       catch (gpstk::Exception& e)
       {
          std::string text;
-         for(int i=0; i<e.getTextCount(); i++) text += e.getText(i);
+         for(size_t i=0; i<e.getTextCount(); i++) text += e.getText(i);
          FFStreamError err("gpstk::Exception in parseTime(): " + text);
          GPSTK_THROW(err);
       }
@@ -386,20 +631,7 @@ namespace gpstk
          return string(26, ' ');
       }
 
-      string line;
-      line  = string(1, ' ');
-      line += rightJustify(asString<short>(dt.year()),2);
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(dt.month()),2);
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(dt.day()),2);
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(dt.hour()),2);
-      line += string(1, ' ');
-      line += rightJustify(asString<short>(dt.minute()),2);
-      line += rightJustify(asString(dt.second(), 7),11);
-
-      return line;
+      return epochFormat.print(dt);
    }
 
 
@@ -55,6 +55,8 @@
 
 namespace gpstk
 {
+   class RinexObsStream;
+
    /** @addtogroup RinexObs */
    //@{
 
@@ -99,6 +101,8 @@ namespace gpstk
           * then the number of auxiliary header records to follow.
           */
       short numSvs;
+         /// Shortest valid epoch line: the numSvs field ends in column 32.
+      static const std::string::size_type minEpochLineLength = 32;
       double clockOffset;      ///< optional clock offset
       RinexSatMap obs;         ///< the map of observations
       RinexObsHeader auxHeader;///< auxiliary header records (epochFlag 2-5)
@@ -167,6 +171,23 @@ namespace gpstk
           */
       DayTime parseTime(const std::string& line, const RinexObsHeader& hdr) const
          throw(FFStreamError);
+
+         /**
+          * Version of reallyGetRecord() for streams in mapped mode
+          * (see RinexObsStream::mapFile()).  The fields are decoded in
+          * place from the mapped file, with the same checks as the
+          * stream path.
+          */
+      void getMappedRecord(RinexObsStream& strm)
+         throw(std::exception, FFStreamError,
+               gpstk::StringUtils::StringException);
+
+         /// parseTime() for an epoch line of \a len characters in the
+         /// file mapping.
+      DayTime parseTime(const char* line,
+                        std::string::size_type len,
+                        const RinexObsHeader& hdr) const
+         throw(FFStreamError);
    }; // class RinexObsData
 
    //@}
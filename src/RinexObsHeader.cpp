@@ -42,6 +42,7 @@
  */
 
 #include "StringUtils.hpp"
+#include "DayTimeFormat.hpp"
 #include "RinexObsHeader.hpp"
 #include "RinexObsStream.hpp"
 
@@ -850,30 +851,17 @@ namespace gpstk
    }
 
 
+      // Layout of the TIME OF FIRST OBS and TIME OF LAST OBS records
+   static const DayTimeFormat timeFormat("%6Y%6m%6d%6H%6M%13.7f");
+
    DayTime RinexObsHeader::parseTime(const string& line) const
    {
-      int year, month, day, hour, min;
-      double sec;
-   
-      year  = asInt(   line.substr(0,  6 ));
-      month = asInt(   line.substr(6,  6 ));
-      day   = asInt(   line.substr(12, 6 ));
-      hour  = asInt(   line.substr(18, 6 ));
-      min   = asInt(   line.substr(24, 6 ));
-      sec   = asDouble(line.substr(30, 13));
-      return DayTime(year, month, day, hour, min, sec);
+      return timeFormat.scan(line);
    }
 
    string RinexObsHeader::writeTime(const DayTime& dt) const
    {
-      string line;
-      line  = rightJustify(asString<short>(dt.year()), 6);
-      line += rightJustify(asString<short>(dt.month()), 6);
-      line += rightJustify(asString<short>(dt.day()), 6);
-      line += rightJustify(asString<short>(dt.hour()), 6);
-      line += rightJustify(asString<short>(dt.minute()), 6);
-      line += rightJustify(asString(dt.second(), 7), 13);
-      return line;
+      return timeFormat.print(dt);
    }
 
    void RinexObsHeader::dump(ostream& s) const
@@ -0,0 +1,351 @@
+#pragma ident "$Id$"
+
+/**
+ * @file RinexObsStream.cpp
+ * File stream for Rinex observation file data
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "RinexObsStream.hpp"
+#include "RinexObsData.hpp"
+
+namespace gpstk
+{
+
+      // Switch this stream to memory-mapped reading.
+   bool RinexObsStream::mapFile()
+   {
+
+      unmapFile();
+
+#ifndef _WIN32
+      if (filename.empty() || !is_open())
+      {
+         return false;
+      }
+
+      int fd = ::open(filename.c_str(), O_RDONLY);
+      if (fd < 0)
+      {
+         return false;
+      }
+
+      struct stat st;
+      if (fstat(fd, &st) != 0 || st.st_size <= 0)
+      {
+         ::close(fd);
+         return false;
+      }
+
+      void* addr = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+
+      if (addr == MAP_FAILED)
+      {
+         return false;
+      }
+
+         // Records are read front to back
+      madvise(addr, st.st_size, MADV_SEQUENTIAL);
+
+      mapBase = static_cast<const char*>(addr);
+      mapSize = st.st_size;
+      return true;
+#else
+      return false;
+#endif
+
+   }  // End of method 'RinexObsStream::mapFile()'
+
+
+
+      // Release the file mapping, if any.
+   void RinexObsStream::unmapFile()
+   {
+
+#ifndef _WIN32
+      if (mapBase != 0)
+      {
+         munmap(const_cast<char*>(mapBase), mapSize);
+      }
+#endif
+
+      mapBase = 0;
+      mapSize = 0;
+      mapPos = 0;
+      mapStarted = false;
+      dataStart = 0;
+      dataLine = 0;
+      indexBuilt = false;
+      epochOffsets.clear();
+
+   }  // End of method 'RinexObsStream::unmapFile()'
+
+
+
+      // Set the mapped read position to the end of the header.
+   void RinexObsStream::startMappedRead()
+   {
+
+      if (mapStarted)
+      {
+         return;
+      }
+
+         // The header goes through the ordinary stream path, which
+         // leaves the file position at the first data record.
+      if (!headerRead)
+      {
+         (*this) >> header;
+      }
+
+      std::streampos pos = tellg();
+      if (pos < 0 || static_cast<unsigned long>(pos) > mapSize)
+      {
+         FFStreamError e("Unable to locate the end of the header");
+         GPSTK_THROW(e);
+      }
+
+      dataStart = pos;
+      dataLine = lineNumber;
+      mapPos = dataStart;
+      mapStarted = true;
+
+   }  // End of method 'RinexObsStream::startMappedRead()'
+
+
+
+      // Get the next line from the file mapping, without copying.
+   void RinexObsStream::mappedGetLine( const char*& begin,
+                                       const char*& end,
+                                       const bool expectEOF )
+      throw(EndOfFile, FFStreamError)
+   {
+
+      lineNumber++;
+
+      if (mapPos >= mapSize)
+      {
+            // Leave the stream in the same state a failed getline()
+            // would, without letting exceptions() turn it into an
+            // ios::failure.
+         try
+         {
+            setstate(std::ios::eofbit | std::ios::failbit);
+         }
+         catch (std::exception&)
+         {}
+
+         if (expectEOF)
+         {
+            EndOfFile err("EOF encountered");
+            GPSTK_THROW(err);
+         }
+         else
+         {
+            FFStreamError err("Unexpected EOF encountered");
+            GPSTK_THROW(err);
+         }
+      }
+
+      const char* p = mapBase + mapPos;
+      const char* last = mapBase + mapSize;
+      const char* nl =
+         static_cast<const char*>(std::memchr(p, '\n', last - p));
+
+      end = (nl != 0) ? nl : last;
+      mapPos = end - mapBase + ((nl != 0) ? 1 : 0);
+
+         // Same limit formattedGetLine() has
+      if (end - p >= 256)
+      {
+         FFStreamError err("Line too long");
+         GPSTK_THROW(err);
+      }
+
+      while (end > p && *(end-1) == '\r')
+      {
+         --end;
+      }
+
+      begin = p;
+
+   }  // End of method 'RinexObsStream::mappedGetLine()'
+
+
+
+      // Scan the mapped file once and record every epoch line.
+   size_t RinexObsStream::indexEpochs()
+      throw(FFStreamError)
+   {
+
+      if (indexBuilt)
+      {
+         return epochOffsets.size();
+      }
+
+      if (!isMapped())
+      {
+         FFStreamError e("Epoch index needs a mapped file");
+         GPSTK_THROW(e);
+      }
+
+      startMappedRead();
+
+      unsigned long savePos = mapPos;
+      unsigned int saveLine = lineNumber;
+
+      mapPos = dataStart;
+      lineNumber = dataLine;
+      epochOffsets.clear();
+
+      const int numObs = header.obsTypeList.size();
+      const int obsLines = (numObs + 4) / 5;
+
+      try
+      {
+         while (mapPos < mapSize)
+         {
+            EpochIndexEntry entry;
+            entry.offset = mapPos;
+            entry.lineNumber = lineNumber;
+
+            const char *b, *e;
+            mappedGetLine(b, e);
+
+               // Trailing blank lines end the data section
+            if (b == e)
+            {
+               const char* p = e;
+               const char* last = mapBase + mapSize;
+               while (p < last &&
+                      std::isspace(static_cast<unsigned char>(*p)))
+               {
+                  ++p;
+               }
+               if (p == last)
+               {
+                  break;
+               }
+            }
+
+            std::string::size_type len = e - b;
+            if ( len < RinexObsData::minEpochLineLength || len > 80 ||
+                 b[0] != ' ' || b[3] != ' ' || b[6] != ' ' )
+            {
+               FFStreamError err("Bad epoch line");
+               GPSTK_THROW(err);
+            }
+
+            int epochFlag = StringUtils::asInt(b + 28, 1);
+            int numSvs = StringUtils::asInt(b + 29, 3);
+
+            int skip;
+            if (epochFlag == 0 || epochFlag == 1 || epochFlag == 6)
+            {
+               skip = (numSvs > 0) ? (numSvs - 1) / 12 : 0;
+               skip += numSvs * obsLines;
+            }
+            else
+            {
+               skip = numSvs;
+            }
+
+            for (int i = 0; i < skip; i++)
+            {
+               mappedGetLine(b, e);
+            }
+
+            epochOffsets.push_back(entry);
+         }
+      }
+      catch (FFStreamError& e)
+      {
+         e.addText( std::string("Near file line ") +
+                    StringUtils::asString(lineNumber) );
+         epochOffsets.clear();
+         mapPos = savePos;
+         lineNumber = saveLine;
+         clear();
+         GPSTK_RETHROW(e);
+      }
+
+      mapPos = savePos;
+      lineNumber = saveLine;
+      indexBuilt = true;
+
+      return epochOffsets.size();
+
+   }  // End of method 'RinexObsStream::indexEpochs()'
+
+
+
+      // Position the stream at the epoch with index n.
+   void RinexObsStream::seekEpoch(size_t n)
+      throw(FFStreamError)
+   {
+
+      indexEpochs();
+
+      if (n >= epochOffsets.size())
+      {
+         FFStreamError e("Epoch index out of range: " +
+                         StringUtils::asString(n));
+         GPSTK_THROW(e);
+      }
+
+      mapPos = epochOffsets[n].offset;
+      lineNumber = epochOffsets[n].lineNumber;
+      recordNumber = n;
+      clear();
+
+   }  // End of method 'RinexObsStream::seekEpoch()'
+
+
+}  // End of namespace gpstk
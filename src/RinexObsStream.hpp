@@ -71,9 +71,18 @@ namespace gpstk
    public:
 
 
+         /// One entry of the epoch index built by indexEpochs().
+      struct EpochIndexEntry
+      {
+         unsigned long offset;      ///< byte offset of the epoch line
+         unsigned int lineNumber;   ///< lineNumber before the epoch line
+      };
+
+
          /// Default constructor
       RinexObsStream()
-         : headerRead(false) {};
+         : headerRead(false), mapBase(0), mapSize(0), mapPos(0),
+           mapStarted(false), dataStart(0), dataLine(0), indexBuilt(false) {};
 
 
          /** Common constructor.
@@ -83,7 +92,9 @@ namespace gpstk
           */
       RinexObsStream( const char* fn,
                       std::ios::openmode mode=std::ios::in )
-         : FFTextStream(fn, mode), headerRead(false) {};
+         : FFTextStream(fn, mode), headerRead(false), mapBase(0), mapSize(0),
+           mapPos(0), mapStarted(false), dataStart(0), dataLine(0),
+           indexBuilt(false) {};
 
 
          /** Common constructor.
@@ -93,11 +104,14 @@ namespace gpstk
           */
       RinexObsStream( const std::string fn,
                       std::ios::openmode mode=std::ios::in )
-         : FFTextStream(fn.c_str(), mode), headerRead(false) {};
+         : FFTextStream(fn.c_str(), mode), headerRead(false), mapBase(0),
+           mapSize(0), mapPos(0), mapStarted(false), dataStart(0),
+           dataLine(0), indexBuilt(false) {};
 
 
          /// Destructor
-      virtual ~RinexObsStream() {};
+      virtual ~RinexObsStream()
+      { unmapFile(); };
 
 
          /** Overrides open to reset the header
@@ -108,6 +122,7 @@ namespace gpstk
       virtual void open( const char* fn,
                          std::ios::openmode mode )
       {
+         unmapFile();
          FFTextStream::open(fn, mode);
          headerRead = false;
          header = RinexObsHeader();
@@ -124,6 +139,79 @@ namespace gpstk
       { open(fn.c_str(), mode); };
 
 
+         /**
+          * Switch this stream to memory-mapped reading. The whole file
+          * is mapped read-only and RinexObsData records are then parsed
+          * in place from the mapped bytes, instead of going through
+          * formattedGetLine() and temporary strings. The header is still
+          * read through the ordinary stream path.
+          *
+          * Call this right after opening the file for input, before any
+          * data records are read. If the file cannot be mapped (it was
+          * opened for output, the platform has no mmap, or the call
+          * fails) the stream is left in its normal mode.
+          *
+          * @return true if the file is now mapped.
+          */
+      bool mapFile();
+
+
+         /// Release the file mapping, if any.
+      void unmapFile();
+
+
+         /// Whether or not this stream reads from a file mapping.
+      bool isMapped() const
+      { return (mapBase != 0); };
+
+
+         /**
+          * Scan the mapped file once and record the position of every
+          * epoch line. Only the epoch lines are decoded; the records
+          * themselves are parsed when they are read. The header is read
+          * first if that hasn't been done yet.
+          *
+          * @return the number of epochs in the file.
+          * @throw FFStreamError if the stream is not mapped or an epoch
+          *        line is malformed.
+          */
+      size_t indexEpochs()
+         throw(FFStreamError);
+
+
+         /// The epoch index, empty until indexEpochs() is called.
+      const std::vector<EpochIndexEntry>& epochIndex() const
+      { return epochOffsets; };
+
+
+         /**
+          * Position the stream so that the next RinexObsData read
+          * returns the epoch with index \a n. The index is built if
+          * needed.
+          *
+          * @throw FFStreamError if \a n is out of range.
+          */
+      void seekEpoch(size_t n)
+         throw(FFStreamError);
+
+
+         /**
+          * Get the next line from the file mapping, without copying.
+          * Behaves like formattedGetLine(): lineNumber is incremented,
+          * a trailing '\r' is removed, and EOF is reported with
+          * EndOfFile or FFStreamError depending on \a expectEOF.
+          *
+          * @param begin set to the first character of the line.
+          * @param end set one past the last character of the line.
+          * @param expectEOF set true if finding EOF on this read is
+          *        acceptable.
+          */
+      void mappedGetLine( const char*& begin,
+                          const char*& end,
+                          const bool expectEOF = false )
+         throw(EndOfFile, FFStreamError);
+
+
          /// Whether or not the RinexObsHeader has been read
       bool headerRead;
 
@@ -132,6 +220,62 @@ namespace gpstk
       RinexObsHeader header;
 
 
+   protected:
+
+
+         /// The mapped read position when the stream is mapped, since
+         /// mapped reads don't move the file position.
+      virtual std::streampos readPosition()
+      {
+         return isMapped() ? std::streampos(std::streamoff(mapPos))
+                           : FFTextStream::readPosition();
+      };
+
+
+   private:
+
+
+         /// Set the mapped read position to the end of the header, the
+         /// first time a data record is read from the mapping.
+      void startMappedRead();
+
+
+         /// Start of the file mapping, or 0 when not mapped.
+      const char* mapBase;
+
+
+         /// Size of the file mapping in bytes.
+      unsigned long mapSize;
+
+
+         /// Byte offset of the next unread character in the mapping.
+      unsigned long mapPos;
+
+
+         /// Whether mapPos has been set to the end of the header.
+      bool mapStarted;
+
+
+         /// Byte offset of the first data record in the mapping.
+      unsigned long dataStart;
+
+
+         /// lineNumber at the first data record.
+      unsigned int dataLine;
+
+
+         /// Whether epochOffsets holds the complete index.
+      bool indexBuilt;
+
+
+         /// Positions of the epoch lines, see indexEpochs().
+      std::vector<EpochIndexEntry> epochOffsets;
+
+
+         /// RinexObsData parses straight from the mapping.
+      friend class RinexObsData;
+
+
    }; // End of class 'RinexObsStream'
 
       //@}
@@ -47,12 +47,16 @@
 #include "SP3Data.hpp"
 #include "StringUtils.hpp"
 #include "DayTime.hpp"
+#include "DayTimeFormat.hpp"
 
 using namespace gpstk::StringUtils;
 using namespace std;
 
 namespace gpstk
 {
+      // Layout of an epoch header record
+   static const DayTimeFormat epochFormat("*  %4Y %2m %2d %2H %2M %11.8f");
+
    void SP3Data::reallyPutRecord(FFStream& ffs) const 
       throw(std::exception, FFStreamError, StringException)
    {
@@ -60,9 +64,7 @@ namespace gpstk
       
       string line;
       if(flag == '*') {// output Epoch Header Record
-         line = "* ";
-         line += time.printf(" %4Y %2m %2d %2H %2M");
-         line += " " + rightJustify(time.printf("%.8f"),11);
+         line = epochFormat.print(time);
       }
       else {           // output Position and Clock OR Velocity and Clock Rate Record
          line = flag;
@@ -197,15 +199,9 @@ namespace gpstk
             }
 
             // parse the epoch line
-            int year = asInt(strm.buffer.substr(3,4));
-            int month = asInt(strm.buffer.substr(8,2));
-            int dom = asInt(strm.buffer.substr(11,2));
-            int hour = asInt(strm.buffer.substr(14,2));
-            int minute = asInt(strm.buffer.substr(17,2));
-            double second = asInt(strm.buffer.substr(20,10));
-            DayTime t;
+            DayTime t(DayTime::BEGINNING_OF_TIME);
             try {
-               t = DayTime(year, month, dom, hour, minute, second);
+               t = epochFormat.scan(strm.buffer);
             } catch (DayTime::DayTimeException& e) {
                FFStreamError fe("Invalid time in:" + strm.buffer);
                GPSTK_THROW(fe);
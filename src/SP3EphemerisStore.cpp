@@ -46,6 +46,7 @@
 
 
 #include "SP3EphemerisStore.hpp"
+#include "ThreadPool.hpp"
 #include "MiscMath.hpp"
 #include "ECEF.hpp"
 #include "icd_200_constants.hpp"
@@ -86,20 +87,8 @@ namespace gpstk
          while(strm >> rec)
          {
 
-               // If there is a bad or absent clock value, and
-               // corresponding flag is set, then continue
-            if( (rec.clk == 999999.999999) &&
-                ( rejectBadClockFlag ) )
-            {
-               continue;
-            }
-
-               // If there are bad or absent positional values, and
-               // corresponding flag is set, then continue
-            if( ( (rec.x[0] == 0.0)    ||
-                  (rec.x[1] == 0.0)    ||
-                  (rec.x[2] == 0.0) )  &&
-                ( rejectBadPosFlag ) )
+               // Skip records with bad or absent values, if requested
+            if( !acceptRecord(rec) )
             {
                continue;
             }
@@ -120,6 +109,130 @@ namespace gpstk
 
 
 
+      // Whether a record passes the bad position / clock filters
+   bool SP3EphemerisStore::acceptRecord(const SP3Data& rec) const
+      throw()
+   {
+
+         // If there is a bad or absent clock value, and
+         // corresponding flag is set, then reject it
+      if( (rec.clk == 999999.999999) &&
+          ( rejectBadClockFlag ) )
+      {
+         return false;
+      }
+
+         // If there are bad or absent positional values, and
+         // corresponding flag is set, then reject it
+      if( ( (rec.x[0] == 0.0)    ||
+            (rec.x[1] == 0.0)    ||
+            (rec.x[2] == 0.0) )  &&
+          ( rejectBadPosFlag ) )
+      {
+         return false;
+      }
+
+      return true;
+
+   }  // End of method 'SP3EphemerisStore::acceptRecord()'
+
+
+
+      // Reads SP3 files into per-file tables; one file per item.
+   class SP3FileReader : public ThreadPoolTask
+   {
+   public:
+
+      SP3FileReader( const std::vector<std::string>& names,
+                     const SP3EphemerisStore& store )
+         : fileNames(names), sp3Store(store), opened(names.size(), 0),
+           headers(names.size()), records(names.size())
+      {};
+
+      virtual void process(size_t i)
+      {
+         SP3Stream strm(fileNames[i].c_str());
+         if (!strm)
+         {
+            return;
+         }
+         opened[i] = 1;
+
+         strm >> headers[i];
+
+         SP3Data rec;
+         while(strm >> rec)
+         {
+            if( sp3Store.acceptRecord(rec) )
+            {
+               rec.version = headers[i].version;
+               records[i].push_back(rec);
+            }
+         }
+      };
+
+      const std::vector<std::string>& fileNames;
+      const SP3EphemerisStore& sp3Store;
+      std::vector<int> opened;   // not vector<bool>: written concurrently
+      std::vector<SP3Header> headers;
+      std::vector< std::vector<SP3Data> > records;
+   };
+
+
+
+      // Load the given SP3 files, parsing them concurrently.
+   void SP3EphemerisStore::loadFiles( const std::vector<std::string>& fileNames,
+                                      unsigned int numThreads )
+      throw(FileMissingException)
+   {
+
+      if (fileNames.empty())
+      {
+         return;
+      }
+
+      SP3FileReader reader(fileNames, *this);
+
+      try
+      {
+         ThreadPool pool( std::min<size_t>( numThreads == 0 ?
+                                            ThreadPool::hardwareThreads() :
+                                            numThreads,
+                                            fileNames.size() ) );
+         pool.run(reader, fileNames.size());
+      }
+      catch (gpstk::Exception& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+
+         // Merge in the given order, exactly as loadFile() would
+      for (size_t i = 0; i < fileNames.size(); i++)
+      {
+         if (!reader.opened[i])
+         {
+            FileMissingException e( "File " + fileNames[i] +
+                                    " could not be opened." );
+            GPSTK_THROW(e);
+         }
+
+         addFile(fileNames[i], reader.headers[i]);
+
+         if (tolower(reader.headers[i].pvFlag) != 'v')
+         {
+            haveVelocity = false;
+         }
+
+         addEphemeris(reader.records[i]);
+
+            // Release each table once it is merged
+         std::vector<SP3Data>().swap(reader.records[i]);
+      }
+
+   }  // End of method 'SP3EphemerisStore::loadFiles()'
+
+
+
       /* Dump the store to cout.
        * @param detail determines how much detail to include in the output
        *   0 list of filenames with their start, stop times.
@@ -57,6 +57,8 @@
 namespace gpstk
 {
 
+   class SP3FileReader;
+
       /** @addtogroup ephemstore */
       //@{
 
@@ -96,6 +98,29 @@ namespace gpstk
          throw(FileMissingException);
 
 
+         /// Load the given SP3 files, one after the other.
+      using FileStore<SP3Header>::loadFiles;
+
+
+         /** Load the given SP3 files, parsing them concurrently.
+          *
+          * The files are read in parallel into per-file record tables,
+          * which are then merged into the store in the order given. The
+          * result is the same as calling loadFile() on each file in turn,
+          * including which files are loaded when one of them is missing.
+          *
+          * @param fileNames the SP3 files to load.
+          * @param numThreads number of threads to use; 0 means one per
+          *        processor.
+          *
+          * @throw FileMissingException if one of the files could not be
+          *        opened; the files before it are loaded.
+          */
+      virtual void loadFiles( const std::vector<std::string>& fileNames,
+                              unsigned int numThreads )
+         throw(FileMissingException);
+
+
          /// Set if satellites with bad or absent positional values will be
          /// rejected. It is false by default when object is constructed.
       virtual SP3EphemerisStore& rejectBadPositions(const bool flag)
@@ -123,6 +148,16 @@ namespace gpstk
    private:
 
 
+         /// Whether a record passes the rejectBadPositions() and
+         /// rejectBadClocks() filters.
+      bool acceptRecord(const SP3Data& rec) const
+         throw();
+
+
+         /// Reads the files for loadFiles() with acceptRecord()
+      friend class SP3FileReader;
+
+
          /// Flag to reject satellites with bad or absent positional values
       bool rejectBadPosFlag;
 
@@ -45,6 +45,7 @@
 #define GPSTK_STRINGUTILS_HPP
 
 #include <string>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
@@ -727,6 +728,26 @@ namespace gpstk
       inline unsigned long asUnsigned(const std::string& s)
       { return strtoul(s.c_str(), 0, 10); }
      
+         /**
+          * Convert a fixed-width field to a double precision floating
+          * point number without constructing a string.  The result is
+          * the same as asDouble() on the \a n characters at \a s.
+          * @param s first character of the field.
+          * @param n width of the field.
+          * @return double representation of the field.
+          */
+      inline double asDouble(const char* s, std::string::size_type n);
+
+         /**
+          * Convert a fixed-width field to an integer without
+          * constructing a string.  The result is the same as asInt()
+          * on the \a n characters at \a s.
+          * @param s first character of the field.
+          * @param n width of the field.
+          * @return long integer representation of the field.
+          */
+      inline long asInt(const char* s, std::string::size_type n);
+     
          /**
           * Convert a string to a single precision floating point number.
           * @param s string containing a number.
@@ -1631,6 +1652,90 @@ namespace gpstk
       } 
 
 
+      inline double asDouble(const char* s, std::string::size_type n)
+      {
+            // Decimal fields of up to 15 significant digits are
+            // accumulated exactly and scaled with a single division by
+            // an exact power of ten, which rounds the same way strtod()
+            // does.  Anything else (exponents, long mantissas) is handed
+            // to strtod().
+         static const double pow10[] =
+            { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+              1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18 };
+
+         std::string::size_type i = 0;
+         while (i < n && isspace(static_cast<unsigned char>(s[i])))
+            i++;
+
+         bool neg = false;
+         if (i < n && (s[i] == '-' || s[i] == '+'))
+         {
+            neg = (s[i] == '-');
+            i++;
+         }
+
+         double m = 0.0;
+         int digits = 0, frac = 0;
+         bool point = false, simple = true;
+         for ( ; i < n; i++)
+         {
+            char c = s[i];
+            if (c >= '0' && c <= '9')
+            {
+               m = m * 10.0 + (c - '0');
+               digits++;
+               if (point)
+                  frac++;
+            }
+            else if (c == '.' && !point)
+               point = true;
+            else
+            {
+               if (c == 'e' || c == 'E' || c == 'x' || c == 'X' ||
+                   (digits == 0 && !isspace(static_cast<unsigned char>(c))))
+                  simple = false;
+               break;
+            }
+         }
+
+         if (simple && digits <= 15 && frac <= 18)
+         {
+            if (digits == 0)
+               return 0.0;
+            m /= pow10[frac];
+            return (neg ? -m : m);
+         }
+
+         if (n < 64)
+         {
+            char buf[64];
+            std::copy(s, s + n, buf);
+            buf[n] = 0;
+            return strtod(buf, 0);
+         }
+         return asDouble(std::string(s, n));
+      }
+
+      inline long asInt(const char* s, std::string::size_type n)
+      {
+         std::string::size_type i = 0;
+         while (i < n && isspace(static_cast<unsigned char>(s[i])))
+            i++;
+
+         bool neg = false;
+         if (i < n && (s[i] == '-' || s[i] == '+'))
+         {
+            neg = (s[i] == '-');
+            i++;
+         }
+
+         long v = 0;
+         for ( ; i < n && s[i] >= '0' && s[i] <= '9'; i++)
+            v = v * 10 + (s[i] - '0');
+
+         return (neg ? -v : v);
+      }
+
       inline float asFloat(const std::string& s)
          throw(StringException)
       {
@@ -44,6 +44,9 @@
  * sufficient data.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "TabularEphemerisStore.hpp"
 #include "MiscMath.hpp"
 #include "ECEF.hpp"
@@ -54,6 +57,32 @@ using namespace gpstk::StringUtils;
 namespace gpstk
 {
 
+   namespace
+   {
+         // Convert an Xvt from the table units (km, microsec, dm/s and
+         // 1.e-4 microsec/sec) to meters and seconds, and add the
+         // relativity correction to dtime.
+      void convertUnits(Xvt& sv)
+      {
+         sv.x[0] *= 1.e3;     // m
+         sv.x[1] *= 1.e3;     // m
+         sv.x[2] *= 1.e3;     // m
+         sv.dtime *= 1.e-6;   // sec
+         sv.v[0] *= 1.e-1;    // m/sec
+         sv.v[1] *= 1.e-1;    // m/sec
+         sv.v[2] *= 1.e-1;    // m/sec
+         sv.ddtime *= 1.e-10; // sec/sec
+
+         // add relativity correction to dtime
+         // this only for consistency with GPSEphemerisStore::getSatXvt ....
+         // dtr = -2*dot(R,V)/(c*c) = -4.4428e-10 * ecc * sqrt(A(m))*sinE
+         // (do it this way for numerical reasons)
+         sv.dtime += -2*(sv.x[0]/C_GPS_M)*(sv.v[0]/C_GPS_M)
+            -2*(sv.x[1]/C_GPS_M)*(sv.v[1]/C_GPS_M)
+            -2*(sv.x[2]/C_GPS_M)*(sv.v[2]/C_GPS_M);
+      }
+   }
+
 
       /* A debugging function that outputs in human readable form,
        * all data stored in this object.
@@ -123,6 +152,7 @@ namespace gpstk
    {
 
       EphMap::iterator kt;
+      const TimeKey kmin(tmin), kmax(tmax);
 
       for(kt=pe.begin(); kt!=pe.end(); kt++)
       {
@@ -132,7 +162,7 @@ namespace gpstk
          while(jt != (kt->second).rend())
          {
 
-            if(jt->first < tmin || jt->first > tmax)
+            if(jt->first < kmin || jt->first > kmax)
             {
                (kt->second).erase(jt->first);
             }
@@ -145,6 +175,7 @@ namespace gpstk
 
       initialTime = tmin;
       finalTime = tmax;
+      tables.clear();
 
    }  // End of method 'TabularEphemerisStore::edit()'
 
@@ -156,6 +187,7 @@ namespace gpstk
    {
 
       pe.clear();
+      tables.clear();
       initialTime = DayTime::END_OF_TIME;
       finalTime = DayTime::BEGINNING_OF_TIME;
 
@@ -180,31 +212,132 @@ namespace gpstk
       const throw(InvalidRequest)
    {
 
-      EphMap::const_iterator svmap = pe.find(sat);
-      if (svmap==pe.end()) {
-         InvalidRequest e("Ephemeris for satellite  " + asString(sat)
-                            + " not found.");
+      Xvt sv;
+      LookupStatus status(noEphemeris);
+
+      std::map<SatID, SvTable>::const_iterator tab = tables.find(sat);
+      if (tab != tables.end())
+      {
+         status = tableXvt(tab->second, t, sv);
+      }
+      else
+      {
+         EphMap::const_iterator svmap = pe.find(sat);
+         if (svmap != pe.end())
+            status = mapXvt(svmap->second, t, sv);
+      }
+
+      if (status != lookupOK)
+      {
+         InvalidRequest e(lookupMessage(status, sat));
          GPSTK_THROW(e);
       }
 
-      const SvEphMap& sem=svmap->second;
+      return sv;
+
+   }  // End of method 'TabularEphemerisStore::getXvt()'
+
+
+
+      /* Compute the Xvt of many satellites at once, flagging failed
+       * requests in 'valid' instead of throwing. Consecutive requests for
+       * the same satellite share one table lookup.
+       */
+   size_t TabularEphemerisStore::getXvtBatch( const SatID* ids,
+                                              const DayTime* times,
+                                              size_t n,
+                                              Xvt* xvt,
+                                              bool* valid )
+      const throw()
+   {
+
+      size_t good(0);
+      const SvTable* tab(0);
+      const SvEphMap* sem(0);
+
+      for (size_t k=0; k<n; k++)
+      {
+         if (k == 0 || ids[k] != ids[k-1])
+         {
+            tab = 0;
+            sem = 0;
+
+            std::map<SatID, SvTable>::const_iterator ti = tables.find(ids[k]);
+            if (ti != tables.end())
+            {
+               tab = &ti->second;
+            }
+            else
+            {
+               EphMap::const_iterator svmap = pe.find(ids[k]);
+               if (svmap != pe.end())
+                  sem = &svmap->second;
+            }
+         }
+
+         LookupStatus status(noEphemeris);
+         if (tab)
+            status = tableXvt(*tab, times[k], xvt[k]);
+         else if (sem)
+            status = mapXvt(*sem, times[k], xvt[k]);
+
+         valid[k] = (status == lookupOK);
+         if (valid[k])
+            good++;
+      }
+
+      return good;
+
+   }  // End of method 'TabularEphemerisStore::getXvtBatch()'
+
+
+
+      /* The text of the InvalidRequest thrown by getXvt() for a failed
+       * lookup.
+       */
+   std::string TabularEphemerisStore::lookupMessage( LookupStatus status,
+                                                     const SatID& sat )
+      throw()
+   {
+
+      switch (status)
+      {
+         case dataBefore:
+            return "Inadequate data before requested time, satellite "
+                   + asString(sat);
+         case dataAfter:
+            return "Inadequate data after requested time, satellite "
+                   + asString(sat);
+         case dataGap:
+            return "Data gap too wide detected for satellite "
+                   + asString(sat);
+         case wideInterval:
+            return "Interpolation interval too wide detected for SV "
+                   + asString(sat);
+         default:
+            return "Ephemeris for satellite  " + asString(sat)
+                   + " not found.";
+      }
+
+   }  // End of method 'TabularEphemerisStore::lookupMessage()'
+
+
+
+      /* Interpolate the Xvt at time 't' from the time map of one
+       * satellite.
+       */
+   TabularEphemerisStore::LookupStatus
+   TabularEphemerisStore::mapXvt( const SvEphMap& sem,
+                                  const TimeKey& t,
+                                  Xvt& sv )
+      const throw()
+   {
+
       SvEphMap::const_iterator i=sem.find(t);
-      Xvt sv;
       if (i!= sem.end() && haveVelocity) {      // exact match of t
          sv = i->second;
-         sv.x[0] *= 1.e3;     // m
-         sv.x[1] *= 1.e3;     // m
-         sv.x[2] *= 1.e3;     // m
-         sv.dtime *= 1.e-6;   // sec
-         sv.v[0] *= 1.e-1;    // m/sec
-         sv.v[1] *= 1.e-1;    // m/sec
-         sv.v[2] *= 1.e-1;    // m/sec
-         sv.ddtime *= 1.e-10; // sec/sec
-
-         sv.dtime += -2*(sv.x[0]/C_GPS_M)*(sv.v[0]/C_GPS_M)
-            -2*(sv.x[1]/C_GPS_M)*(sv.v[1]/C_GPS_M)
-            -2*(sv.x[2]/C_GPS_M)*(sv.v[2]/C_GPS_M);
-         return sv;
+         convertUnits(sv);
+         return lookupOK;
       }
 
          // Note that the order of the Lagrange interpolation
@@ -217,14 +350,10 @@ namespace gpstk
       SvEphMap::const_iterator j=i;
 
       if(i == sem.begin() || --i == sem.begin()) {
-         InvalidRequest e("Inadequate data before requested time, satellite "
-                          + asString(sat));
-         GPSTK_THROW(e);
+         return dataBefore;
       }
       if(j == sem.end()) {
-         InvalidRequest e("Inadequate data after requested time, satellite "
-                          + asString(sat));
-         GPSTK_THROW(e);
+         return dataAfter;
       }
 
          // "t" is now just between "i" and "j"; therefore, it is time to check
@@ -234,9 +363,7 @@ namespace gpstk
            ( std::abs( j->first - t ) > gapInterval ) )
       {
             // There was a data gap
-         InvalidRequest e( "Data gap too wide detected for satellite "
-                           + asString(sat) );
-         GPSTK_THROW(e);
+         return dataGap;
       }
 
       for(int k=0; k<half-1; k++)
@@ -247,15 +374,11 @@ namespace gpstk
             // if k==half-2, this is last iteration
          if(i == sem.begin() && k<half-2)
          {
-            InvalidRequest e("Inadequate data before requested time, satellite "
-                             + asString(sat));
-            GPSTK_THROW(e);
+            return dataBefore;
          }
          j++;
          if(j == sem.end() && k<half-2) {
-            InvalidRequest e("Inadequate data after requested time, satellite "
-                               + asString(sat));
-            GPSTK_THROW(e);
+            return dataAfter;
          }
       }
 
@@ -266,15 +389,13 @@ namespace gpstk
            ( std::abs( j->first - i->first ) > maxInterval ) )
       {
             // There was a data gap
-         InvalidRequest e( "Interpolation interval too wide detected for SV "
-                           + asString(sat) );
-         GPSTK_THROW(e);
+         return wideInterval;
       }
 
 
          // pull data and interpolate
       SvEphMap::const_iterator itr;
-      DayTime t0=i->first;
+      TimeKey t0=i->first;
       double dt=t-t0,err;
       std::vector<double> times,X,Y,Z,T,VX,VY,VZ,F;
 
@@ -314,26 +435,118 @@ namespace gpstk
          sv.ddtime *= 1.e4;            // 1.e-4 microsec/sec
       }
 
-      sv.x[0] *= 1.e3;     // m
-      sv.x[1] *= 1.e3;     // m
-      sv.x[2] *= 1.e3;     // m
-      sv.dtime *= 1.e-6;   // sec
-      sv.v[0] *= 1.e-1;    // m/sec
-      sv.v[1] *= 1.e-1;    // m/sec
-      sv.v[2] *= 1.e-1;    // m/sec
-      sv.ddtime *= 1.e-10; // sec/sec
+      convertUnits(sv);
 
-      // add relativity correction to dtime
-      // this only for consistency with GPSEphemerisStore::getSatXvt ....
-      // dtr = -2*dot(R,V)/(c*c) = -4.4428e-10 * ecc * sqrt(A(m))*sinE
-      // (do it this way for numerical reasons)
-      sv.dtime += -2*(sv.x[0]/C_GPS_M)*(sv.v[0]/C_GPS_M)
-         -2*(sv.x[1]/C_GPS_M)*(sv.v[1]/C_GPS_M)
-         -2*(sv.x[2]/C_GPS_M)*(sv.v[2]/C_GPS_M);
+      return lookupOK;
 
-      return sv;
+   }  // End of method 'TabularEphemerisStore::mapXvt()'
 
-   }  // end Xvt TabularEphemerisStore::getSatXvt
+
+
+      /* mapXvt() working on a compacted table. The checks and the
+       * interpolation window are the same as those of the walk over the
+       * time map, expressed with array indices.
+       */
+   TabularEphemerisStore::LookupStatus
+   TabularEphemerisStore::tableXvt( const SvTable& tab,
+                                    const TimeKey& t,
+                                    Xvt& sv )
+      const throw()
+   {
+
+      const size_t n = tab.epochs.size();
+      const size_t lb = tab.lowerBound(t);
+
+      if (lb < n && haveVelocity && !(t < tab.epochs[lb])) { // exact match
+         sv.x = ECEF(tab.X[lb], tab.Y[lb], tab.Z[lb]);
+         sv.dtime = tab.T[lb];
+         sv.v = Triple(tab.VX[lb], tab.VY[lb], tab.VZ[lb]);
+         sv.ddtime = tab.F[lb];
+         convertUnits(sv);
+         return lookupOK;
+      }
+
+         // Note that the order of the Lagrange interpolation
+         // is twice this value
+      const size_t half=5;
+
+         // t lies between epochs lb-1 and lb
+      if(lb < 2) {
+         return dataBefore;
+      }
+      if(lb == n) {
+         return dataAfter;
+      }
+
+      if ( checkDataGap                                      &&
+           ( std::abs( t - tab.epochs[lb-1] ) > gapInterval ) &&
+           ( std::abs( tab.epochs[lb] - t ) > gapInterval ) )
+      {
+            // There was a data gap
+         return dataGap;
+      }
+
+         // Widen the window one epoch on each side at a time, so the
+         // first edge reached decides which failure is reported
+      for(size_t k=0; k<half-2; k++)
+      {
+         if(lb == k+2) {
+            return dataBefore;
+         }
+         if(lb+k+1 == n) {
+            return dataAfter;
+         }
+      }
+
+         // The window is lb-half .. lb+half-1, cut short by one at the
+         // end of the table; the interval check then uses the last epoch
+         // of the window (the map walk would read its end() iterator)
+      const size_t i = lb-half;
+      const size_t j = std::min(lb+half-1, n-1);
+
+      if ( checkInterval                                          &&
+           ( std::abs( tab.epochs[j] - tab.epochs[i] ) > maxInterval ) )
+      {
+            // There was a data gap
+         return wideInterval;
+      }
+
+         // interpolate straight from the table columns
+      const size_t m = j-i+1;
+      const TimeKey& t0 = tab.epochs[i];
+      double dt=t-t0,err;
+      double times[2*half];
+
+      for (size_t k=0; k<m; k++)
+         times[k] = tab.epochs[i+k] - t0;      // sec
+
+      if (haveVelocity)
+      {
+         sv.x[0] = LagrangeInterpolation(times,&tab.X[i],m,dt,err);
+         sv.x[1] = LagrangeInterpolation(times,&tab.Y[i],m,dt,err);
+         sv.x[2] = LagrangeInterpolation(times,&tab.Z[i],m,dt,err);
+         sv.dtime = LagrangeInterpolation(times,&tab.T[i],m,dt,err);
+         sv.v[0] = LagrangeInterpolation(times,&tab.VX[i],m,dt,err);
+         sv.v[1] = LagrangeInterpolation(times,&tab.VY[i],m,dt,err);
+         sv.v[2] = LagrangeInterpolation(times,&tab.VZ[i],m,dt,err);
+         sv.ddtime = LagrangeInterpolation(times,&tab.F[i],m,dt,err);
+      }
+      else {
+         LagrangeInterpolation(times,&tab.X[i],m,dt,sv.x[0],sv.v[0]);
+         LagrangeInterpolation(times,&tab.Y[i],m,dt,sv.x[1],sv.v[1]);
+         LagrangeInterpolation(times,&tab.Z[i],m,dt,sv.x[2],sv.v[2]);
+         LagrangeInterpolation(times,&tab.T[i],m,dt,sv.dtime,sv.ddtime);
+         sv.v[0] *= 1.e4;              // decimeters/sec
+         sv.v[1] *= 1.e4;              // decimeters/sec
+         sv.v[2] *= 1.e4;              // decimeters/sec
+         sv.ddtime *= 1.e4;            // 1.e-4 microsec/sec
+      }
+
+      convertUnits(sv);
+
+      return lookupOK;
+
+   }  // End of method 'TabularEphemerisStore::tableXvt()'
 
 
 
@@ -363,15 +576,16 @@ namespace gpstk
       }
 
       const SvEphMap& sem=svmap->second;
+      const TimeKey key(t);
 
-      SvEphMap::const_iterator i=sem.find(t);
+      SvEphMap::const_iterator i;
 
          // Note that the order of the Lagrange interpolation
          // is twice this value
       const int half=5;
 
          //  i will be the lower bound, j the upper (in time).
-      i = sem.lower_bound(t); // i points to first element with key >= t
+      i = sem.lower_bound(key); // i points to first element with key >= t
 
       SvEphMap::const_iterator j=i;
 
@@ -389,8 +603,8 @@ namespace gpstk
          // "t" is now just between "i" and "j"; therefore, it is time to check
          // for data gaps ("checkDataGap" must be enabled for this).
       if ( checkDataGap                               &&
-           ( std::abs( t - i->first ) > gapInterval ) &&
-           ( std::abs( j->first - t ) > gapInterval ) )
+           ( std::abs( key - i->first ) > gapInterval ) &&
+           ( std::abs( j->first - key ) > gapInterval ) )
       {
             // There was a data gap
          InvalidRequest e( "Data gap too wide detected for satellite "
@@ -433,8 +647,8 @@ namespace gpstk
 
          // pull data and interpolate
       SvEphMap::const_iterator itr;
-      DayTime t0(i->first);
-      double dt(t-t0);
+      TimeKey t0(i->first);
+      double dt(key-t0);
       std::vector<double> times,X,Y,Z;
 
       for (itr=i; itr!=sem.end(); itr++)
@@ -470,9 +684,124 @@ namespace gpstk
    void TabularEphemerisStore::addEphemeris(const SP3Data& data)
       throw()
    {
-      DayTime t = data.time;
-      SatID sat = data.sat;
-      Xvt&  xvt = pe[sat][t];
+      tables.clear();
+      storeRecord(pe[data.sat][data.time], data);
+   }
+
+
+
+   //-----------------------------------------------------------------------------
+   //-----------------------------------------------------------------------------
+   void TabularEphemerisStore::addEphemeris(const std::vector<SP3Data>& data)
+      throw()
+   {
+      EphMap::iterator svmap = pe.end();
+
+      tables.clear();
+
+      for (size_t n=0; n<data.size(); n++)
+      {
+         const SP3Data& rec = data[n];
+
+         if (svmap == pe.end() || svmap->first != rec.sat)
+            svmap = pe.insert(EphMap::value_type(rec.sat, SvEphMap())).first;
+
+         SvEphMap& sem = svmap->second;
+         SvEphMap::iterator it;
+         const TimeKey key(rec.time);
+
+            // Appending at the end is constant time with a hint
+         if (sem.empty() || sem.rbegin()->first < key)
+            it = sem.insert(sem.end(), SvEphMap::value_type(key, Xvt()));
+         else
+            it = sem.insert(SvEphMap::value_type(key, Xvt())).first;
+
+         storeRecord(it->second, rec);
+      }
+   }
+
+
+
+   //-----------------------------------------------------------------------------
+   //-----------------------------------------------------------------------------
+   void TabularEphemerisStore::compact()
+      throw()
+   {
+      tables.clear();
+
+      for (EphMap::const_iterator it=pe.begin(); it!=pe.end(); it++)
+      {
+         const SvEphMap& sem = it->second;
+         if (sem.empty())
+            continue;
+
+         SvTable& tab = tables[it->first];
+         const size_t n = sem.size();
+
+         tab.epochs.reserve(n);
+         tab.X.reserve(n);  tab.Y.reserve(n);  tab.Z.reserve(n);
+         tab.T.reserve(n);  tab.VX.reserve(n); tab.VY.reserve(n);
+         tab.VZ.reserve(n); tab.F.reserve(n);
+
+         for (SvEphMap::const_iterator jt=sem.begin(); jt!=sem.end(); jt++)
+         {
+            tab.epochs.push_back(jt->first);
+            tab.X.push_back(jt->second.x[0]);
+            tab.Y.push_back(jt->second.x[1]);
+            tab.Z.push_back(jt->second.x[2]);
+            tab.T.push_back(jt->second.dtime);
+            tab.VX.push_back(jt->second.v[0]);
+            tab.VY.push_back(jt->second.v[1]);
+            tab.VZ.push_back(jt->second.v[2]);
+            tab.F.push_back(jt->second.ddtime);
+         }
+
+            // The epoch index is constant time for uniform spacing
+         tab.step = (n > 1) ? tab.epochs[1] - tab.epochs[0] : 0.0;
+         for (size_t k=2; k<n && tab.step>0.0; k++)
+         {
+            if (tab.epochs[k] - tab.epochs[k-1] != tab.step)
+               tab.step = 0.0;
+         }
+         if (tab.step < 0.0)
+            tab.step = 0.0;
+      }
+   }
+
+
+
+   //-----------------------------------------------------------------------------
+   //-----------------------------------------------------------------------------
+   size_t TabularEphemerisStore::SvTable::lowerBound(const TimeKey& t) const
+      throw()
+   {
+      const size_t n = epochs.size();
+
+      if (step <= 0.0)
+         return std::lower_bound(epochs.begin(), epochs.end(), t)
+                - epochs.begin();
+
+         // Guess from the spacing, then settle the index with the same
+         // comparison the time map uses
+      double guess = std::ceil((t - epochs[0]) / step);
+      size_t k = (guess <= 0.0) ? 0 : (guess >= double(n) ? n : size_t(guess));
+
+      while (k > 0 && !(epochs[k-1] < t))
+         k--;
+      while (k < n && epochs[k] < t)
+         k++;
+
+      return k;
+   }
+
+
+
+   //-----------------------------------------------------------------------------
+   //-----------------------------------------------------------------------------
+   void TabularEphemerisStore::storeRecord(Xvt& xvt, const SP3Data& data)
+      throw()
+   {
+      const DayTime& t = data.time;
 
       if (data.flag=='P')
       {
@@ -48,9 +48,11 @@
 #define GPSTK_TABULAR_EPHEMERIS_STORE_HPP
 
 #include <iostream>
+#include <vector>
 
 #include "SatID.hpp"
 #include "DayTime.hpp"
+#include "TimeKey.hpp"
 #include "XvtStore.hpp"
 #include "SP3Data.hpp"
 
@@ -98,6 +100,26 @@ namespace gpstk
          const throw(InvalidRequest);
 
 
+         /** Compute the Xvt of many satellites at once, without throwing.
+          *  Requests are best grouped by satellite: consecutive requests
+          *  for the same satellite share one table lookup.
+          *
+          * @param[in] ids the satellites' identifiers (n of them)
+          * @param[in] times the times to look up (n of them)
+          * @param[in] n the number of requests
+          * @param[out] xvt the Xvt results (room for n)
+          * @param[out] valid set false where getXvt() would throw
+          *
+          * @return the number of valid results
+          */
+      virtual size_t getXvtBatch( const SatID* ids,
+                                  const DayTime* times,
+                                  size_t n,
+                                  Xvt* xvt,
+                                  bool* valid )
+         const throw();
+
+
          /** Returns the acceleration of the indicated object in ECEF
           *  coordinates (meters) at the indicated time.
           *
@@ -198,10 +220,36 @@ namespace gpstk
          throw();
 
 
+         /** Insert a sequence of SP3Data objects into the store. The
+          *  result is the same as calling addEphemeris() on each of them
+          *  in turn, but records that arrive in time order for their
+          *  satellite are appended without searching the time map.
+          */
+      void addEphemeris(const std::vector<SP3Data>& data)
+         throw();
+
+
          /// Remove all data
       void clear() throw();
 
 
+         /** Build contiguous per-satellite copies of the tables, used by
+          *  getXvt() in place of the time maps. Intended for stores that
+          *  are read many times once loaded: results are identical, but
+          *  the interpolation window is read straight from arrays and,
+          *  for uniformly spaced tables, the epoch is found in constant
+          *  time. Any later change to the store (addEphemeris(), edit(),
+          *  clear()) discards the compacted tables; call this again
+          *  after loading more data.
+          */
+      void compact() throw();
+
+
+         /// Check if the compacted tables built by compact() are in use.
+      bool isCompact() const throw()
+      { return !tables.empty(); };
+
+
          /// Enable checking of data gaps.
       void enableDataGapCheck(void)
       { checkDataGap = true; };
@@ -252,8 +300,9 @@ namespace gpstk
    protected:
 
 
-         /// The key to this map is the time
-      typedef std::map<DayTime, Xvt> SvEphMap;
+         /// The key to this map is the time, as a TimeKey so that lookups
+         /// are integer comparisons
+      typedef std::map<TimeKey, Xvt> SvEphMap;
 
 
          /// The key to this map is the svid of the satellite (usually the prn)
@@ -318,6 +367,71 @@ namespace gpstk
           */
       double maxInterval;
 
+
+   private:
+
+
+         /// Outcome of an Xvt lookup; each failure has its own message
+      enum LookupStatus
+      {
+         lookupOK,
+         noEphemeris,
+         dataBefore,
+         dataAfter,
+         dataGap,
+         wideInterval
+      };
+
+
+         /// Text of the InvalidRequest thrown by getXvt() for a failure
+      static std::string lookupMessage( LookupStatus status,
+                                        const SatID& sat )
+         throw();
+
+
+         /** Contiguous copy of one satellite's SvEphMap, see compact().
+          *  Each column holds one Xvt component, in the units of the
+          *  maps, for every epoch.
+          */
+      struct SvTable
+      {
+            /// Table epochs, in increasing order
+         std::vector<TimeKey> epochs;
+
+            /// Epoch spacing in seconds if uniform, otherwise zero
+         double step;
+
+            /// Position (km), clock (microsec), velocity (dm/s) and
+            /// clock drift (1.e-4 microsec/sec) columns
+         std::vector<double> X, Y, Z, T, VX, VY, VZ, F;
+
+            /// Index of the first epoch not before t, as map::lower_bound
+         size_t lowerBound(const TimeKey& t) const throw();
+      };
+
+
+         /// Compacted tables, empty unless compact() has been called
+      std::map<SatID, SvTable> tables;
+
+
+         /// Compute the Xvt at time t from the time map of one satellite
+      LookupStatus mapXvt( const SvEphMap& sem,
+                           const TimeKey& t,
+                           Xvt& sv )
+         const throw();
+
+
+         /// mapXvt() working on a compacted table
+      LookupStatus tableXvt( const SvTable& tab,
+                             const TimeKey& t,
+                             Xvt& sv )
+         const throw();
+
+
+         /// Copy the contents of an SP3Data record into its Xvt entry.
+      void storeRecord(Xvt& xvt, const SP3Data& data)
+         throw();
+
    };
 
 
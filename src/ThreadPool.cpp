@@ -0,0 +1,307 @@
+#pragma ident "$Id$"
+
+/**
+ * @file ThreadPool.cpp
+ * A fixed set of worker threads that split indexed jobs between them.
+ */
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "StringUtils.hpp"
+#include "ThreadPool.hpp"
+
+namespace gpstk
+{
+
+      // Number of processors available, at least 1.
+   unsigned int ThreadPool::hardwareThreads()
+   {
+
+#if !defined(_WIN32) && defined(_SC_NPROCESSORS_ONLN)
+      long n = sysconf(_SC_NPROCESSORS_ONLN);
+      if (n > 0)
+      {
+         return n;
+      }
+#endif
+
+      return 1;
+
+   }  // End of method 'ThreadPool::hardwareThreads()'
+
+
+
+      // Common constructor.
+   ThreadPool::ThreadPool(unsigned int nThreads)
+      throw(Exception)
+      : numThreads(nThreads), task(0), numItems(0), nextItem(0),
+        doneItems(0), jobNumber(0), quit(false), haveError(false),
+        errorItem(0)
+   {
+
+      if (numThreads == 0)
+      {
+         numThreads = hardwareThreads();
+      }
+
+#ifndef _WIN32
+      pthread_mutex_init(&mutex, 0);
+      pthread_cond_init(&jobPosted, 0);
+      pthread_cond_init(&jobDone, 0);
+
+         // The calling thread is the first worker
+      for (unsigned int i = 1; i < numThreads; i++)
+      {
+         pthread_t thread;
+         if (pthread_create(&thread, 0, threadMain, this) != 0)
+         {
+            numThreads = i;
+            break;
+         }
+         threads.push_back(thread);
+      }
+#else
+      numThreads = 1;
+#endif
+
+   }  // End of constructor 'ThreadPool::ThreadPool()'
+
+
+
+      // Destructor. Stops and joins the worker threads.
+   ThreadPool::~ThreadPool()
+   {
+
+#ifndef _WIN32
+      pthread_mutex_lock(&mutex);
+      quit = true;
+      pthread_cond_broadcast(&jobPosted);
+      pthread_mutex_unlock(&mutex);
+
+      for (size_t i = 0; i < threads.size(); i++)
+      {
+         pthread_join(threads[i], 0);
+      }
+
+      pthread_cond_destroy(&jobDone);
+      pthread_cond_destroy(&jobPosted);
+      pthread_mutex_destroy(&mutex);
+#endif
+
+   }  // End of destructor 'ThreadPool::~ThreadPool()'
+
+
+
+      // Process items 0 to numItems-1 of task.
+   void ThreadPool::run( ThreadPoolTask& t,
+                         size_t n )
+      throw(Exception)
+   {
+
+      if (n == 0)
+      {
+         return;
+      }
+
+#ifndef _WIN32
+      pthread_mutex_lock(&mutex);
+#endif
+
+      task = &t;
+      numItems = n;
+      nextItem = 0;
+      doneItems = 0;
+      haveError = false;
+      jobNumber++;
+
+#ifndef _WIN32
+      pthread_cond_broadcast(&jobPosted);
+      pthread_mutex_unlock(&mutex);
+#endif
+
+      work();
+
+#ifndef _WIN32
+      pthread_mutex_lock(&mutex);
+      while (doneItems < numItems)
+      {
+         pthread_cond_wait(&jobDone, &mutex);
+      }
+      task = 0;
+      pthread_mutex_unlock(&mutex);
+#else
+      task = 0;
+#endif
+
+      if (haveError)
+      {
+         GPSTK_RETHROW(error);
+      }
+
+   }  // End of method 'ThreadPool::run()'
+
+
+
+      // Take and process items of the current job until none is left.
+   void ThreadPool::work()
+   {
+
+      while (true)
+      {
+
+#ifndef _WIN32
+         pthread_mutex_lock(&mutex);
+#endif
+         if (task == 0 || nextItem >= numItems)
+         {
+#ifndef _WIN32
+            pthread_mutex_unlock(&mutex);
+#endif
+            return;
+         }
+         size_t i = nextItem++;
+         ThreadPoolTask* current = task;
+#ifndef _WIN32
+         pthread_mutex_unlock(&mutex);
+#endif
+
+         try
+         {
+            current->process(i);
+         }
+         catch (Exception& e)
+         {
+            setError(i, e);
+         }
+         catch (std::exception& e)
+         {
+            setError(i, Exception(std::string("std::exception thrown: ")
+                                  + e.what()));
+         }
+         catch (...)
+         {
+            setError(i, Exception("Unknown exception thrown"));
+         }
+
+#ifndef _WIN32
+         pthread_mutex_lock(&mutex);
+         if (++doneItems == numItems)
+         {
+            pthread_cond_signal(&jobDone);
+         }
+         pthread_mutex_unlock(&mutex);
+#else
+         ++doneItems;
+#endif
+
+      }  // End of 'while (true)'
+
+   }  // End of method 'ThreadPool::work()'
+
+
+
+      // Record the exception thrown while processing item i.
+   void ThreadPool::setError(size_t i, const Exception& e)
+   {
+
+#ifndef _WIN32
+      pthread_mutex_lock(&mutex);
+#endif
+
+      if (!haveError || i < errorItem)
+      {
+         haveError = true;
+         errorItem = i;
+         error = e;
+         error.addText("In item " + StringUtils::asString(i) +
+                       " of a ThreadPool job");
+      }
+
+#ifndef _WIN32
+      pthread_mutex_unlock(&mutex);
+#endif
+
+   }  // End of method 'ThreadPool::setError()'
+
+
+
+#ifndef _WIN32
+      // Entry point of the worker threads
+   void* ThreadPool::threadMain(void* arg)
+   {
+
+      ThreadPool* pool = static_cast<ThreadPool*>(arg);
+      unsigned long lastJob = 0;
+
+      pthread_mutex_lock(&pool->mutex);
+
+      while (true)
+      {
+
+         while (!pool->quit && pool->jobNumber == lastJob)
+         {
+            pthread_cond_wait(&pool->jobPosted, &pool->mutex);
+         }
+
+         if (pool->quit)
+         {
+            break;
+         }
+
+         lastJob = pool->jobNumber;
+
+         pthread_mutex_unlock(&pool->mutex);
+         pool->work();
+         pthread_mutex_lock(&pool->mutex);
+
+      }
+
+      pthread_mutex_unlock(&pool->mutex);
+
+      return 0;
+
+   }  // End of method 'ThreadPool::threadMain()'
+#endif
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,221 @@
+#pragma ident "$Id$"
+
+/**
+ * @file ThreadPool.hpp
+ * A fixed set of worker threads that split indexed jobs between them.
+ */
+
+#ifndef GPSTK_THREADPOOL_HPP
+#define GPSTK_THREADPOOL_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#include <vector>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+#include "Exception.hpp"
+
+namespace gpstk
+{
+
+      /** @addtogroup appframegroup */
+      //@{
+
+      /**
+       * A job for a ThreadPool.  The job is made of a number of
+       * independent items, numbered from 0; process() is called exactly
+       * once for each of them, from any of the pool's threads.
+       * Implementations must make sure that process() calls for different
+       * items don't touch the same data.
+       */
+   class ThreadPoolTask
+   {
+   public:
+
+         /// Destructor
+      virtual ~ThreadPoolTask() {};
+
+
+         /// Process item \a i of the job.
+      virtual void process(size_t i) = 0;
+
+   }; // End of class 'ThreadPoolTask'
+
+
+
+      /**
+       * A fixed set of worker threads.  The threads are started once, in
+       * the constructor, and then share the items of every job given to
+       * run().  The calling thread works on the job too, so a pool of
+       * size N starts N-1 threads.  A pool of size 1 simply runs the
+       * items in order in the calling thread.
+       *
+       * @code
+       * ThreadPool pool;           // one thread per processor
+       * MyTask task(inputs, outputs);
+       * pool.run(task, inputs.size());
+       * @endcode
+       *
+       * On platforms without POSIX threads every pool has size 1.
+       */
+   class ThreadPool
+   {
+   public:
+
+         /** Common constructor.
+          *
+          * @param numThreads number of threads that work on each job,
+          *        including the calling one; 0 means one per processor.
+          *
+          * @throw Exception if the threads could not be started.
+          */
+      ThreadPool(unsigned int numThreads = 0)
+         throw(Exception);
+
+
+         /// Destructor. Stops and joins the worker threads.
+      virtual ~ThreadPool();
+
+
+         /// Number of threads that work on each job.
+      unsigned int size() const
+      { return numThreads; };
+
+
+         /** Process items 0 to \a numItems-1 of \a task, and return
+          *  when all of them are done. Only one job runs at a time.
+          *
+          * If process() throws, the remaining items are still processed,
+          * then the exception from the lowest-numbered failing item is
+          * rethrown here (as a gpstk::Exception).
+          */
+      void run( ThreadPoolTask& task,
+                size_t numItems )
+         throw(Exception);
+
+
+         /// Number of processors available, at least 1.
+      static unsigned int hardwareThreads();
+
+
+   private:
+
+         /// Copying a pool makes no sense
+      ThreadPool(const ThreadPool&);
+      ThreadPool& operator=(const ThreadPool&);
+
+
+         /// Take and process items of the current job until none is left.
+      void work();
+
+
+         /// Record the exception thrown while processing item \a i.
+      void setError(size_t i, const Exception& e);
+
+
+         /// Number of threads working on each job
+      unsigned int numThreads;
+
+
+         /// Current job
+      ThreadPoolTask* task;
+
+
+         /// Number of items in the current job
+      size_t numItems;
+
+
+         /// Next item to hand out
+      size_t nextItem;
+
+
+         /// Number of items completed
+      size_t doneItems;
+
+
+         /// Incremented for every job, so workers notice new ones
+      unsigned long jobNumber;
+
+
+         /// Set to stop the workers
+      bool quit;
+
+
+         /// Whether an item of the current job failed
+      bool haveError;
+
+
+         /// Lowest failing item of the current job
+      size_t errorItem;
+
+
+         /// Exception thrown by errorItem
+      Exception error;
+
+
+#ifndef _WIN32
+         /// Entry point of the worker threads
+      static void* threadMain(void* pool);
+
+
+         /// Worker threads
+      std::vector<pthread_t> threads;
+
+
+         /// Protects all the members above
+      pthread_mutex_t mutex;
+
+
+         /// Signaled when a new job is posted, or on quit
+      pthread_cond_t jobPosted;
+
+
+         /// Signaled when the last item of a job is done
+      pthread_cond_t jobDone;
+#endif
+
+   }; // End of class 'ThreadPool'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_THREADPOOL_HPP
@@ -0,0 +1,175 @@
+#pragma ident "$Id$"
+
+
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file TimeKey.cpp
+ * gpstk::TimeKey - integer time tag for keys of time-indexed containers
+ */
+
+#include <cmath>
+
+#include "TimeKey.hpp"
+
+namespace gpstk
+{
+   namespace
+   {
+         /// Range of the count; the ends stand for every time beyond them
+      const long long MIN_TICKS = -9223372036854775807LL - 1;
+      const long long MAX_TICKS =  9223372036854775807LL;
+
+         /// Range of whole days from the GPS epoch that fit in the count
+         /// with any time of day
+      const long MIN_DAYS = -106751;
+      const long MAX_DAYS =  106750;
+
+         /// Days and time of day (ms and fractional ticks) to a count,
+         /// clamped
+      inline long long toTicks(long days, long msod, long long frac)
+      {
+         if (days < MIN_DAYS)
+            return MIN_TICKS;
+         if (days > MAX_DAYS)
+            return MAX_TICKS;
+         return days * TimeKey::TICKS_PER_DAY
+            + msod * TimeKey::TICKS_PER_MSEC + frac;
+      }
+
+         /// Count to days and ticks of the day (0 <= tod < TICKS_PER_DAY)
+      inline void fromTicks(long long ticks, long& days, long long& tod)
+      {
+         days = long(ticks / TimeKey::TICKS_PER_DAY);
+         tod = ticks % TimeKey::TICKS_PER_DAY;
+         if (tod < 0)
+         {
+            tod += TimeKey::TICKS_PER_DAY;
+            days--;
+         }
+      }
+   }
+
+   const TimeKey TimeKey::BEGINNING_OF_TIME(MIN_TICKS);
+   const TimeKey TimeKey::END_OF_TIME(MAX_TICKS);
+
+   TimeKey::TimeKey(const DayTime& t)
+      throw()
+   {
+         // mSec is in milliseconds
+      long long frac = (long long)std::floor(t.mSec * TICKS_PER_MSEC + 0.5);
+      ticks = toTicks(t.jday - DayTime::GPS_EPOCH_JDAY, t.mSod, frac);
+   }
+
+   TimeKey::TimeKey(const CommonTime& t)
+      throw()
+   {
+      long day, msod;
+      double fsod;
+      t.getInternal(day, msod, fsod);
+
+         // fsod is in seconds
+      long long frac = (long long)std::floor(fsod * TICKS_PER_SEC + 0.5);
+      ticks = toTicks(day - DayTime::GPS_EPOCH_JDAY, msod, frac);
+   }
+
+   DayTime TimeKey::getDayTime() const
+      throw()
+   {
+      if (ticks == MIN_TICKS)
+         return DayTime::BEGINNING_OF_TIME;
+      if (ticks == MAX_TICKS)
+         return DayTime::END_OF_TIME;
+
+      long days;
+      long long tod;
+      fromTicks(ticks, days, tod);
+      return DayTime(DayTime::GPS_EPOCH_JDAY + days,
+                     long(tod / TICKS_PER_MSEC),
+                     double(tod % TICKS_PER_MSEC) / TICKS_PER_MSEC,
+                     DayTime::DAYTIME_TOLERANCE);
+   }
+
+   CommonTime TimeKey::getCommonTime() const
+      throw()
+   {
+      if (ticks == MIN_TICKS)
+         return CommonTime::BEGINNING_OF_TIME;
+      if (ticks == MAX_TICKS)
+         return CommonTime::END_OF_TIME;
+
+      long days;
+      long long tod;
+      fromTicks(ticks, days, tod);
+      return CommonTime().setInternal(DayTime::GPS_EPOCH_JDAY + days,
+                                      long(tod / TICKS_PER_MSEC),
+                                      double(tod % TICKS_PER_MSEC)
+                                         / TICKS_PER_SEC);
+   }
+
+   double TimeKey::operator-(const TimeKey& right) const
+      throw()
+   {
+         // Whole seconds and the rest separately, so that neither overflows
+         // and the result is as exact as a double allows
+      return double(ticks / TICKS_PER_SEC - right.ticks / TICKS_PER_SEC)
+         + double(ticks % TICKS_PER_SEC - right.ticks % TICKS_PER_SEC)
+            / TICKS_PER_SEC;
+   }
+
+   TimeKey TimeKey::operator+(double seconds) const
+      throw()
+   {
+      if (ticks == MIN_TICKS || ticks == MAX_TICKS)
+         return *this;
+
+      double dt = std::floor(seconds * TICKS_PER_SEC + 0.5);
+      if (dt >= double(MAX_TICKS) - double(ticks))
+         return END_OF_TIME;
+      if (dt <= double(MIN_TICKS) - double(ticks))
+         return BEGINNING_OF_TIME;
+      return TimeKey(ticks + (long long)dt);
+   }
+
+   std::size_t TimeKey::hash() const
+      throw()
+   {
+         // Finalizer of the MurmurHash3 64 bit hash: every bit of the count
+         // affects every bit of the result
+      unsigned long long h = (unsigned long long)ticks;
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      h *= 0xc4ceb9fe1a85ec53ULL;
+      h ^= h >> 33;
+      return std::size_t(h);
+   }
+
+   std::ostream& operator<<(std::ostream& s, const TimeKey& t)
+   {
+      s << t.getDayTime();
+      return s;
+   }
+
+} // namespace gpstk
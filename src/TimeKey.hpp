@@ -0,0 +1,174 @@
+#pragma ident "$Id$"
+
+
+
+#ifndef GPSTK_TIMEKEY_HPP
+#define GPSTK_TIMEKEY_HPP
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+/**
+ * @file TimeKey.hpp
+ * gpstk::TimeKey - integer time tag for keys of time-indexed containers
+ */
+
+#include <cstddef>
+#include <iostream>
+
+#include "DayTime.hpp"
+#include "CommonTime.hpp"
+
+namespace gpstk
+{
+      /** @addtogroup timegroup */
+      //@{
+
+      /**
+       * A time as a single 64 bit count of nanoseconds since the GPS epoch
+       * (1980/01/06 00:00:00).
+       *
+       * DayTime compares with a tolerance, by taking a floating point
+       * difference, so every lookup in a std::map<DayTime,...> pays for the
+       * arithmetic and the ordering is not strictly transitive (a==b and
+       * b==c does not give a==c).  A TimeKey compares as an integer: the
+       * ordering is strict, equal keys hash the same, and a lookup costs one
+       * integer comparison per node.  Converting from and to DayTime or
+       * CommonTime is a few integer operations.
+       *
+       * Times are rounded to the nearest nanosecond.  The count covers about
+       * 292 years either side of the GPS epoch (1688 to 2271); times outside
+       * that are clamped to the first or last key, which are the keys of
+       * DayTime::BEGINNING_OF_TIME and DayTime::END_OF_TIME.  Clamped keys
+       * still sort correctly against every key in range, so they work as
+       * the bounds of a search, but distinct times beyond the range share
+       * one key.
+       *
+       * \code
+       * std::map<TimeKey, Xvt> m;
+       * m[DayTime(2009,3,1,0,15,0.0)] = xvt;
+       * std::map<TimeKey, Xvt>::const_iterator i = m.lower_bound(t);
+       * DayTime when = i->first.getDayTime();
+       * \endcode
+       */
+   class TimeKey
+   {
+   public:
+         /// Ticks (nanoseconds) in one second, millisecond and day
+      static const long long TICKS_PER_SEC = 1000000000LL;
+      static const long long TICKS_PER_MSEC = 1000000LL;
+      static const long long TICKS_PER_DAY = 86400000000000LL;
+
+         /// Keys of the earliest and latest times; every time before or
+         /// after the range of a TimeKey gets these
+      static const TimeKey BEGINNING_OF_TIME;
+      static const TimeKey END_OF_TIME;
+
+         /// Default constructor, the GPS epoch
+      TimeKey()
+         throw()
+            : ticks(0)
+      {}
+
+         /// Constructor from a count of nanoseconds since the GPS epoch
+      explicit TimeKey(long long t)
+         throw()
+            : ticks(t)
+      {}
+
+         /// Constructor from a DayTime, rounded to the nanosecond
+      TimeKey(const DayTime& t)
+         throw();
+
+         /// Constructor from a CommonTime, rounded to the nanosecond
+      TimeKey(const CommonTime& t)
+         throw();
+
+         /// This time as a DayTime, with the default tolerance
+      DayTime getDayTime() const
+         throw();
+
+         /// This time as a CommonTime
+      CommonTime getCommonTime() const
+         throw();
+
+         /// Nanoseconds since the GPS epoch
+      long long getTicks() const
+         throw()
+      { return ticks; }
+
+         /// Difference of two times in seconds, exact to the nanosecond
+      double operator-(const TimeKey& right) const
+         throw();
+
+         /// Add seconds to this time (rounded to the nanosecond)
+      TimeKey operator+(double seconds) const
+         throw();
+
+         /// Subtract seconds from this time (rounded to the nanosecond)
+      TimeKey operator-(double seconds) const
+         throw()
+      { return operator+(-seconds); }
+
+         /** @name Comparison operators
+          * Exact, with no tolerance.
+          */
+         //@{
+      bool operator==(const TimeKey& right) const throw()
+      { return ticks == right.ticks; }
+      bool operator!=(const TimeKey& right) const throw()
+      { return ticks != right.ticks; }
+      bool operator<(const TimeKey& right) const throw()
+      { return ticks < right.ticks; }
+      bool operator>(const TimeKey& right) const throw()
+      { return ticks > right.ticks; }
+      bool operator<=(const TimeKey& right) const throw()
+      { return ticks <= right.ticks; }
+      bool operator>=(const TimeKey& right) const throw()
+      { return ticks >= right.ticks; }
+         //@}
+
+         /// Hash of the key, with all the bits of the count mixed in
+      std::size_t hash() const
+         throw();
+
+         /// Function object giving TimeKey::hash(), for hashed containers
+      struct Hash
+      {
+         std::size_t operator()(const TimeKey& k) const throw()
+         { return k.hash(); }
+      };
+
+   private:
+         /// Nanoseconds since the GPS epoch
+      long long ticks;
+
+   }; // end class TimeKey
+
+      /// Write the time as a DayTime would be written
+   std::ostream& operator<<(std::ostream& s, const TimeKey& t);
+
+      //@}
+
+} // namespace gpstk
+
+#endif // GPSTK_TIMEKEY_HPP
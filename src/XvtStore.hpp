@@ -81,7 +81,42 @@ namespace gpstk
       virtual Xvt getXvt(const IndexType id, const DayTime& t)
          const throw(InvalidRequest)
          = 0;
-      
+
+
+      /// Compute the Xvt of many objects at once: xvt[i] is set to the
+      /// Xvt of ids[i] at times[i], for i = 0 to n-1. Requests for which
+      /// getXvt() would throw an InvalidRequest do not throw here; their
+      /// entry in the validity mask is set false instead.
+      /// @param[in] ids the objects' identifiers (n of them)
+      /// @param[in] times the times to look up (n of them)
+      /// @param[in] n the number of requests
+      /// @param[out] xvt the Xvt results (room for n)
+      /// @param[out] valid the validity mask (room for n)
+      /// @return the number of valid results
+      virtual size_t getXvtBatch(const IndexType* ids,
+                                 const DayTime* times,
+                                 size_t n,
+                                 Xvt* xvt,
+                                 bool* valid)
+         const throw()
+      {
+         size_t good = 0;
+         for (size_t i = 0; i < n; i++)
+         {
+            try
+            {
+               xvt[i] = getXvt(ids[i], times[i]);
+               valid[i] = true;
+               good++;
+            }
+            catch (InvalidRequest&)
+            {
+               valid[i] = false;
+            }
+         }
+         return good;
+      }
+
 
       /// A debugging function that outputs in human readable form,
       /// all data stored in this object.